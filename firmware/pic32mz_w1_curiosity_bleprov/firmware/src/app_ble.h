@@ -49,6 +49,9 @@ extern "C" {
 #define RN487X_BUFFER_SIZE          100
 #define RN487X_TIMEOUT              0x0FFFFF        // response timeout
 #define RN487X_STARTUP_DELAY        500             // value in ms
+// power of 2, bytes; 256 bytes hold 22 ms of RN487X data at 115200 baud,
+// more than DEFAULT_TASK_DELAY; overflows are counted and reported
+#define BLE_RX_RING_SIZE            256
 #define PROMPT_START				"CMD> "
 #define PROMPT_END					"END\r\n"
 #define REBOOT_MSG					"REBOOT"
@@ -276,6 +279,7 @@ void APP_BLE_Initialize ( void );
 
 void APP_BLE_Tasks( void );
 
+void BLE_RxProcess(void) ;
 void BLE_Delay(void) ;
 void BLE_PrintInstructions(void) ;
 void BLE_Init(void) ;
@@ -64,6 +64,8 @@
 #include "osal/osal.h"
 #include "system/debug/sys_debug.h"
 #include "system/command/sys_command.h"
+#include "system/boottrace/sys_boottrace.h"
+#include "system/stackmon/sys_stackmon.h"
 #include "peripheral/clk/plib_clk.h"
 #include "peripheral/gpio/plib_gpio.h"
 #include "peripheral/evic/plib_evic.h"
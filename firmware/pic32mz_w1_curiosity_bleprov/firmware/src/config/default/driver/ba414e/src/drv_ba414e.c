@@ -477,9 +477,12 @@ SYS_MODULE_OBJ DRV_BA414E_Initialize
 #if defined(DRV_BA414E_RTOS_STACK_SIZE)
         OSAL_SEM_Create(&opData.clientListSema, OSAL_SEM_TYPE_BINARY, 1, 1);
         OSAL_SEM_Create(&opData.wfi, OSAL_SEM_TYPE_BINARY, DRV_BA414E_NUM_CLIENTS, 0);
+        SYS_RING_Initialize(&opData.completionRing, opData.completionBuffer, sizeof(DRV_BA414E_Completion), DRV_BA414E_COMPLETION_RING_SIZE, &opData.wfi);
     #if !defined(DRV_BA414_RTOS_TASK_DELAY)
         OSAL_SEM_Create(&opData.clientAction, OSAL_SEM_TYPE_COUNTING, DRV_BA414E_NUM_CLIENTS, 0);
     #endif
+#else
+        SYS_RING_Initialize(&opData.completionRing, opData.completionBuffer, sizeof(DRV_BA414E_Completion), DRV_BA414E_COMPLETION_RING_SIZE, NULL);
 #endif        
         memset(&clientData, 0, sizeof(clientData));
         int counter;
@@ -602,24 +605,45 @@ SYS_STATUS DRV_BA414E_Status( SYS_MODULE_OBJ object)
 
 void DRV_BA414E_InterruptHandler()
 {
-#if defined(DRV_BA414E_RTOS_STACK_SIZE)
-    OSAL_SEM_PostISR(&opData.wfi);
-#endif
-    opData.doneInterrupt = 1;
-    opData.lastStatus = PKSTATUS;
+    DRV_BA414E_Completion completion;
+
+    completion.status = PKSTATUS;
+    completion.error = 0;
     PKCONTROL = 0;
     SYS_INT_SourceDisable(INT_SOURCE_CRYPTO1);
+    // Also wakes the driver task
+    SYS_RING_PutISR(&opData.completionRing, &completion);
 }
 
 void DRV_BA414E_ErrorInterruptHandler()
 {
-#if defined(DRV_BA414E_RTOS_STACK_SIZE)
-    OSAL_SEM_PostISR(&opData.wfi);
-#endif
-    opData.errorInterrupt = 1;
-    opData.lastStatus = PKSTATUS;
+    DRV_BA414E_Completion completion;
+
+    completion.status = PKSTATUS;
+    completion.error = 1;
     PKCONTROL = 0;
     SYS_INT_SourceDisable(INT_SOURCE_CRYPTO1_FAULT);    
+    SYS_RING_PutISR(&opData.completionRing, &completion);
+}
+
+// Moves the completions queued by the interrupt handlers into the task owned
+// doneInterrupt/errorInterrupt/lastStatus
+static void DRV_BA414E_CompletionCollect()
+{
+    DRV_BA414E_Completion completion;
+
+    while (SYS_RING_Get(&opData.completionRing, &completion))
+    {
+        if (completion.error != 0)
+        {
+            opData.errorInterrupt = 1;
+        }
+        else
+        {
+            opData.doneInterrupt = 1;
+        }
+        opData.lastStatus = completion.status;
+    }
 }
 
 void DRV_BA414E_StartOp()
@@ -628,6 +652,8 @@ void DRV_BA414E_StartOp()
     //snprintf(dbgBufferPtr, debugBufferSize, "%s\r\n%s: PKSTATUS %08X Done %d Error %d\r\n", dbgBufferPtr, __FUNCTION__, PKSTATUS, opData.doneInterrupt, opData.errorInterrupt);
     SYS_INT_SourceStatusClear(INT_SOURCE_CRYPTO1_FAULT);
     SYS_INT_SourceStatusClear(INT_SOURCE_CRYPTO1);
+    // Drop anything left over from the previous operation
+    DRV_BA414E_CompletionCollect();
     opData.doneInterrupt = 0;
     opData.errorInterrupt = 0;
     //snprintf(dbgBufferPtr, debugBufferSize, "%s\r\n%s: PKSTATUS %08X Done %d Error %d\r\n", dbgBufferPtr, __FUNCTION__, PKSTATUS, opData.doneInterrupt, opData.errorInterrupt);
@@ -1242,6 +1268,7 @@ void DRV_BA414E_Tasks(SYS_MODULE_OBJ obj)
 #if defined(DRV_BA414E_RTOS_STACK_SIZE)
                 OSAL_SEM_Pend(&opData.wfi, OSAL_WAIT_FOREVER);
 #endif
+                DRV_BA414E_CompletionCollect();
                 if ((opData.doneInterrupt == 1) || (opData.errorInterrupt == 1))
                 {
                     opData.state = DRV_BA414E_PROCESSING;
@@ -290,6 +290,7 @@ const TCPIP_DNSS_MODULE_CONFIG tcpipDNSServerInitData =
 { 
     .deleteOldLease         = TCPIP_DNSS_DELETE_OLD_LEASE,
     .replyBoardAddr         = TCPIP_DNSS_REPLY_BOARD_ADDR,
+    .captivePortal          = TCPIP_DNSS_CAPTIVE_PORTAL,
     .IPv4EntriesPerDNSName  = TCPIP_DNSS_CACHE_PER_IPV4_ADDRESS,
     .IPv6EntriesPerDNSName  = 0,
 };
@@ -352,6 +353,7 @@ const TCPIP_STACK_MODULE_CONFIG TCPIP_STACK_MODULE_CONFIG_TBL [] =
     {TCPIP_MODULE_DHCP_SERVER,      &tcpipDHCPSInitData},           // TCPIP_MODULE_DHCP_SERVER
     {TCPIP_MODULE_DNS_CLIENT,       &tcpipDNSClientInitData},       // TCPIP_MODULE_DNS_CLIENT
     {TCPIP_MODULE_DNS_SERVER,       &tcpipDNSServerInitData},       // TCPIP_MODULE_DNS_SERVER
+    {TCPIP_MODULE_IPERF,            0},                             // TCPIP_MODULE_IPERF
 
     { TCPIP_MODULE_MANAGER,         &tcpipHeapConfig },             // TCPIP_MODULE_MANAGER
 
@@ -498,6 +500,7 @@ void SYS_Initialize ( void* data )
     /* Start out with interrupts disabled before configuring any modules */
     __builtin_disable_interrupts();
 
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_START, 0);
   
     PMU_Initialize();
 	CLK_Initialize();
@@ -505,6 +508,8 @@ void SYS_Initialize ( void* data )
     /* Configure Wait States */
     PRECONbits.PFMWS = 5;
 
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_CLK, 0);
+
 
 
 	GPIO_Initialize();
@@ -512,42 +517,59 @@ void SYS_Initialize ( void* data )
 	BSP_Initialize();
     NVM_Initialize();
 
-    CORETIMER_Initialize();
 	UART1_Initialize();
 
 	UART2_Initialize();
 
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_PERIPH, 0);
+
 
     /* Initialize the PIC32MZW1 Driver */
     CRYPT_RNG_Initialize(&wdrvRngCtx);
     sysObj.drvWifiPIC32MZW1 = WDRV_PIC32MZW_Initialize(WDRV_PIC32MZW_SYS_IDX_0, (SYS_MODULE_INIT*)&wdrvPIC32MZW1InitData);
 
+    /* Last boot trace mark from the free running core timer, the core timer
+       is stopped and restarted from 0 by the TIME service */
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_WDRV, 0);
+
+    CORETIMER_Initialize();
 
     sysObj.sysTime = SYS_TIME_Initialize(SYS_TIME_INDEX_0, (SYS_MODULE_INIT *)&sysTimeInitData);
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_TIME, 0);
+
     sysObj.sysConsole0 = SYS_CONSOLE_Initialize(SYS_CONSOLE_INDEX_0, (SYS_MODULE_INIT *)&sysConsole0Init);
 
     SYS_CMD_Initialize((SYS_MODULE_INIT*)&sysCmdInit);
 
     sysObj.sysDebug = SYS_DEBUG_Initialize(SYS_DEBUG_INDEX_0, (SYS_MODULE_INIT*)&debugInit);
 
+    SYS_BOOTTRACE_Initialize();
+    SYS_STACKMON_Initialize();
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_CONSOLE, 0);
+
 
     /* WiFi Service Initialization */
     sysObj.syswifi = SYS_WIFI_Initialize(NULL,NULL,NULL);
     SYS_ASSERT(sysObj.syswifi  != SYS_MODULE_OBJ_INVALID, "SYS_WIFI_Initialize Failed" );
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_SYS_WIFI, 0);
 
 
     sysObj.ba414e = DRV_BA414E_Initialize(0, (SYS_MODULE_INIT*)&ba414eInitData);
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_BA414E, 0);
 
 
 /* TCPIP Stack Initialization */
 sysObj.tcpip = TCPIP_STACK_Init();
 SYS_ASSERT(sysObj.tcpip != SYS_MODULE_OBJ_INVALID, "TCPIP_STACK_Init Failed" );
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_TCPIP, 0);
 
 
     CRYPT_WCCB_Initialize();
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_CRYPTO, 0);
 
     APP_WIFI_Initialize();
     APP_BLE_Initialize();
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_APP, 0);
 
 
     EVIC_Initialize();
@@ -555,6 +577,8 @@ SYS_ASSERT(sysObj.tcpip != SYS_MODULE_OBJ_INVALID, "TCPIP_STACK_Init Failed" );
 	/* Enable global interrupts */
     __builtin_enable_interrupts();
 
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_DONE, 0);
+
 
 }
 
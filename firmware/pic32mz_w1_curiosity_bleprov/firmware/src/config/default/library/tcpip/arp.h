@@ -151,6 +151,25 @@ typedef struct
     TCPIP_MAC_ADDR        entryHwAdd;     // the entry hardware address
 }TCPIP_ARP_ENTRY_QUERY;
 
+// *****************************************************************************
+/* Structure:
+    TCPIP_ARP_STATISTICS
+
+  Summary:
+    ARP cache statistics.
+
+  Description:
+    Counters maintained by the ARP cache of an interface.
+*/
+typedef struct
+{
+    uint32_t    cacheHits;          // look ups that found a resolved entry
+    uint32_t    cacheMisses;        // look ups that found no entry or an incomplete one
+    uint32_t    entriesExpired;     // complete entries removed by the solved entry timeout
+    uint32_t    entriesPurged;      // complete entries evicted to make room in the cache
+    uint32_t    refreshRequests;    // unicast requests sent to refresh entries in use
+}TCPIP_ARP_STATISTICS;
+
 
 // *****************************************************************************
 /* Enumeration:
@@ -735,6 +754,36 @@ size_t          TCPIP_ARP_CacheEntriesNoGet(TCPIP_NET_HANDLE hNet, TCPIP_ARP_ENT
 */
 TCPIP_ARP_RESULT TCPIP_ARP_CacheThresholdSet(TCPIP_NET_HANDLE hNet, int purgeThres, int purgeEntries);
 
+// *****************************************************************************
+/* Function
+    TCPIP_ARP_RESULT TCPIP_ARP_StatisticsGet(TCPIP_NET_HANDLE hNet, 
+	                                        TCPIP_ARP_STATISTICS* pStat, bool clear);
+
+   Summary:
+    Gets the ARP cache statistics for the specified interface.
+
+   Description:
+    This function returns the hit/miss and replacement counters
+    of the ARP cache for the selected interface.
+
+   Precondition:
+    The ARP module should have been initialized.
+
+   Parameters:
+    hNet    -   Interface handle to use
+    pStat   -   address to store the statistics; could be 0
+    clear   -   if true, the counters are cleared after the read
+
+   Returns:
+    - On Success - ARP_RES_OK
+    - On Failure - ARP_RES_NO_INTERFACE (if no such interface exists)
+
+   Remarks:
+    When TCPIP_ARP_PRIMARY_CACHE_ONLY is set, an alias interface
+    reports the statistics of its primary interface cache.
+*/
+TCPIP_ARP_RESULT TCPIP_ARP_StatisticsGet(TCPIP_NET_HANDLE hNet, TCPIP_ARP_STATISTICS* pStat, bool clear);
+
 // *****************************************************************************
 /* Function:
     void  TCPIP_ARP_Task(void)
@@ -156,6 +156,8 @@ typedef struct
 {
     bool    deleteOldLease;  		// Delete old cache if still in place,
     bool    replyBoardAddr;  		// Reply with board address
+    bool    captivePortal;          // Reply with board address for the names not in the cache
+                                    // Other query types get an empty answer
     // specific DNS server parameters
     size_t  IPv4EntriesPerDNSName;  // Number of IPv4 entries per DNS name. Default value is 1.
     size_t  IPv6EntriesPerDNSName;  // Number of IPv6 address per DNS Name. Default value is 1
@@ -379,6 +381,36 @@ TCPIP_DNSS_RESULT TCPIP_DNSS_EntryGet(uint8_t * hostName,IP_ADDRESS_TYPE type,in
 */
 TCPIP_DNSS_RESULT TCPIP_DNSS_AddressCntGet(int index, char* hostName, size_t hostSize, size_t* ipCount);
 
+//*****************************************************************************
+/*
+  Function:
+    bool TCPIP_DNSS_CaptivePortalSet(bool enable)
+
+  Summary:
+    Enables or disables the DNS server captive portal mode.
+
+  Description:
+    In captive portal mode the names present in the cache are answered from the cache
+    and any other name is answered with the board address.
+    The queries for other record types get an empty answer,
+    so that the clients do not wait for a timeout.
+
+  Precondition:
+    The DNS server must be initialized.
+
+  Parameters:
+    enable - true to enable the captive portal mode, false to disable it
+
+  Returns:
+    - true  - if successful
+    - false - if the DNS server is not initialized
+
+  Remarks:
+    The mode has no effect when the server replies with the board address
+    for all the names (TCPIP_DNSS_MODULE_CONFIG::replyBoardAddr).
+*/
+bool TCPIP_DNSS_CaptivePortalSet(bool enable);
+
 // *****************************************************************************
 /*
   Function:
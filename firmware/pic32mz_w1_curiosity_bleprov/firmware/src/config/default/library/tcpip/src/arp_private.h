@@ -92,9 +92,10 @@ typedef struct _TAG_ARP_HASH_ENTRY
     OA_HASH_ENTRY               hEntry;         // hash header;
     struct _TAG_ARP_HASH_ENTRY* next;           // ordered link list by tInsert
     IPV4_ADDR                   ipAddress;      // the hash key: the IP address
-    uint32_t                    tInsert;        // arp time it was inserted 
+    uint32_t                    tInsert;        // arp time it was inserted or last confirmed
     TCPIP_MAC_ADDR                    hwAdd;          // the hardware address
     uint16_t                    nRetries;       // number of retries for an incomplete entry
+                                                // or refresh requests for a complete one
 }ARP_HASH_ENTRY;
 
 // ARP flags used in hEntry->flags
@@ -110,6 +111,8 @@ typedef enum
                                                    //
     ARP_FLAG_ENTRY_CONFIGURE    = 0x0100,          // configuration query, transmit always
     ARP_FLAG_ENTRY_GRATUITOUS   = 0x0200,          // gratuitous ARP query, use different retry number                                                   
+    ARP_FLAG_ENTRY_REFERENCED   = 0x0400,          // complete entry used since it was last confirmed
+                                                   // the CLOCK reference bit
     ARP_FLAG_ENTRY_VALID_MASK   = (ARP_FLAG_ENTRY_PERM | ARP_FLAG_ENTRY_COMPLETE )
                                                      
                                                   
@@ -121,6 +124,13 @@ typedef enum
 
 #define     ARP_HASH_PROBE_STEP      1
 
+// time before a complete entry expires when an entry that's in use
+// is refreshed with a unicast ARP request, in seconds
+// 0 disables the refresh: the entries expire and have to be resolved again
+#if !defined(TCPIP_ARP_CACHE_REFRESH_TMO)
+#define     TCPIP_ARP_CACHE_REFRESH_TMO     60
+#endif
+
 
 // each ARP cache consists of
 typedef struct
@@ -132,6 +142,7 @@ typedef struct
     PROTECTED_SINGLE_LIST         incompleteList; // list of not completed yet entries
     size_t              purgeThres;     // threshold to start cache purging
     size_t              purgeQuanta;    // how many entries to purge
+    TCPIP_ARP_STATISTICS  stat;         // cache statistics
 }ARP_CACHE_DCPT;
 
 // ARP unaligned key
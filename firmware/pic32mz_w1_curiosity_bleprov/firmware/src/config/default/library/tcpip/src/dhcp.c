@@ -58,6 +58,11 @@ typedef struct
                                             // T1 < T2 < Texp
     uint32_t                t3Seconds;      // # of seconds to wait until reissuing a REQUEST in RENEW/REBIND state
     uint32_t                tOpStart;       // time at which a lease operation is started
+    uint32_t                bindKey;        // key of the network the interface connects to
+    uint32_t                tLinkUp;        // link up time, ticks
+    uint32_t                tProbe;         // time of the ARP probe sent with an INIT-REBOOT request, ticks; 0 if none
+    uint32_t                probeAddress;   // address checked by that probe
+    uint32_t                bindTime;       // link up to bound time, milliseconds
 	uint32_t				dwServerID;		// DHCP Server ID cache
 	IPV4_ADDR				serverAddress;	// DHCP Server that grant the lease
 	IPV4_ADDR				dhcpIPAddress;	// DHCP obtained IP address
@@ -119,6 +124,7 @@ typedef struct
 		};
 		uint8_t val;
 	} validValues;
+    uint8_t     rebootBound;        // last lease obtained with INIT-REBOOT
 #if (TCPIP_DHCP_USE_OPTION_TIME_SERVER != 0)
     uint8_t     tServerNo;          // number of stored valid time servers in timeServers 
 #endif  // (TCPIP_DHCP_USE_OPTION_TIME_SERVER != 0)
@@ -210,6 +216,11 @@ static PROTECTED_SINGLE_LIST      dhcpRegisteredUsers = { {0} };
 
 
 static uint32_t         dhcpSecondCount = 0;    // DHCP time keeping, in seconds
+
+#if (TCPIP_DHCP_LEASE_PERSIST_INTERFACES != 0)
+// last lease per interface; survives a reset
+static TCPIP_DHCP_LEASE_RECORD __attribute__((persistent)) dhcpLeaseRecord[TCPIP_DHCP_LEASE_PERSIST_INTERFACES];
+#endif  // (TCPIP_DHCP_LEASE_PERSIST_INTERFACES != 0)
 #if (TCPIP_DHCP_DEBUG_MASK & TCPIP_DHCP_DEBUG_MASK_TIME_RES_MS) != 0
 static uint32_t         dhcpMillisecCount = 0;    // DHCP time keeping, in milli seconds
 #endif  // (TCPIP_DHCP_DEBUG_MASK & TCPIP_DHCP_DEBUG_MASK_TIME_RES_MS) != 0
@@ -522,6 +533,61 @@ static __inline__ void __attribute__((always_inline)) _DHCPSetIPv4Filter(DHCP_CL
     }
 }
 
+// returns the persisted lease record of a client, 0 if none
+static TCPIP_DHCP_LEASE_RECORD* _DHCPLeaseRecord(DHCP_CLIENT_VARS* pClient)
+{
+#if (TCPIP_DHCP_LEASE_PERSIST_INTERFACES != 0)
+    int netIx = pClient - DHCPClients;
+    if(netIx < TCPIP_DHCP_LEASE_PERSIST_INTERFACES)
+    {
+        return dhcpLeaseRecord + netIx;
+    }
+#endif  // (TCPIP_DHCP_LEASE_PERSIST_INTERFACES != 0)
+    return 0;
+}
+
+static void _DHCPLeaseSave(DHCP_CLIENT_VARS* pClient)
+{
+    TCPIP_DHCP_LEASE_RECORD* pRec = _DHCPLeaseRecord(pClient);
+    if(pRec != 0)
+    {
+        pRec->magic = TCPIP_DHCP_LEASE_RECORD_MAGIC;
+        pRec->bindKey = pClient->bindKey;
+        pRec->ipAddress = pClient->dhcpIPAddress.Val;
+        pRec->checksum = ~(pRec->magic ^ pRec->bindKey ^ pRec->ipAddress);
+    }
+}
+
+static void _DHCPLeaseForget(DHCP_CLIENT_VARS* pClient)
+{
+    TCPIP_DHCP_LEASE_RECORD* pRec = _DHCPLeaseRecord(pClient);
+    if(pRec != 0)
+    {
+        memset(pRec, 0, sizeof(*pRec));
+    }
+}
+
+// selects the operation to start with when the link comes up:
+// INIT-REBOOT if the last lease belongs to this network, INIT otherwise
+static TCPIP_DHCP_OPERATION_TYPE _DHCPLinkOperation(DHCP_CLIENT_VARS* pClient)
+{
+    TCPIP_DHCP_LEASE_RECORD* pRec = _DHCPLeaseRecord(pClient);
+
+    if(pRec == 0)
+    {   // not persisted; use the lease held before a link loss
+        return pClient->flags.bWasBound ? TCPIP_DHCP_OPER_INIT_REBOOT : TCPIP_DHCP_OPER_INIT;
+    }
+
+    if(pRec->magic == TCPIP_DHCP_LEASE_RECORD_MAGIC && pRec->checksum == ~(pRec->magic ^ pRec->bindKey ^ pRec->ipAddress) &&
+       pRec->bindKey == pClient->bindKey && pRec->ipAddress != 0)
+    {
+        pClient->dhcpIPAddress.Val = pRec->ipAddress;
+        return TCPIP_DHCP_OPER_INIT_REBOOT;
+    }
+
+    return TCPIP_DHCP_OPER_INIT;
+}
+
 static void _DHCPClientClose(TCPIP_NET_IF* pNetIf, bool disable, bool release)
 {
     DHCP_CLIENT_VARS* pClient = DHCPClients + TCPIP_STACK_NetIxGet(pNetIf);
@@ -531,6 +597,7 @@ static void _DHCPClientClose(TCPIP_NET_IF* pNetIf, bool disable, bool release)
         if(release && pClient->smState >= TCPIP_DHCP_BOUND)
         {  
             _DHCPSend(pClient, pNetIf, TCPIP_DHCP_RELEASE_MESSAGE, 0);
+            _DHCPLeaseForget(pClient);
         }
 
 		pClient->flags.bIsBound = false;
@@ -789,7 +856,7 @@ bool TCPIP_DHCP_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
 
     if(stackCtrl->pNetIf->Flags.bIsDHCPEnabled != 0)
     {   // override the pDhcpConfig->dhcpEnable passed with the what the stack manager says
-        _DHCPEnable(stackCtrl->pNetIf, TCPIP_DHCP_OPER_INIT);
+        _DHCPEnable(stackCtrl->pNetIf, _DHCPLinkOperation(pClient));
     }
 
     dhcpInitCount++;
@@ -931,7 +998,7 @@ static bool _DHCPStartOperation(TCPIP_NET_IF* pNetIf, TCPIP_DHCP_OPERATION_REQ o
 
             if(TCPIP_STACK_AddressServiceCanStart(pNetIf, TCPIP_STACK_ADDRESS_SERVICE_DHCPC))
             {
-                opType = TCPIP_DHCP_OPER_INIT;
+                opType = _DHCPLinkOperation(pClient);
             }
             break;
 
@@ -1182,6 +1249,7 @@ static void TCPIP_DHCP_Process(bool isTmo)
                 }
 
 
+                pClient->tLinkUp = SYS_TMR_TickCountGet();
                 // advance the state machine according to the DHCP operation
                 if(pClient->dhcpOp == TCPIP_DHCP_OPER_INIT_REBOOT)
                 {
@@ -1258,6 +1326,17 @@ static void TCPIP_DHCP_Process(bool isTmo)
                 }
                 // store the request time
                 pClient->tRequest = _DHCPSecondCountGet();
+                pClient->tProbe = 0;
+                if(pClient->dhcpOp == TCPIP_DHCP_OPER_INIT_REBOOT)
+                {   // check the address while waiting for the server
+                    IPV4_ADDR zeroAdd = { 0 };
+                    TCPIP_ARP_Probe(pNetIf, &pClient->dhcpIPAddress, &zeroAdd, ARP_OPERATION_REQ | ARP_OPERATION_CONFIGURE |  ARP_OPERATION_GRATUITOUS);
+                    pClient->probeAddress = pClient->dhcpIPAddress.Val;
+                    if((pClient->tProbe = SYS_TMR_TickCountGet()) == 0)
+                    {   // 0 means no probe
+                        pClient->tProbe = 1;
+                    }
+                }
                 _DHCPNotifyClients(pNetIf, DHCP_EVENT_REQUEST);
                 // Start a timer and begin looking for a response
                 _DHCPSetTimeout(pClient);
@@ -1292,11 +1371,21 @@ static void TCPIP_DHCP_Process(bool isTmo)
                     }
 #endif  // TCPIP_DHCP_DEBUG_MASK
 
+                    bool arpChkTmo;
+                    if(pClient->tProbe != 0)
+                    {   // probed when the INIT-REBOOT request went out
+                        arpChkTmo = (SYS_TMR_TickCountGet() - pClient->tProbe) >= (TCPIP_DHCP_REBOOT_PROBE_TMO * SYS_TMR_TickCounterFrequencyGet()) / 1000;
+                    }
+                    else
+                    {
+                        arpChkTmo = (_DHCPSecondCountGet() - pClient->startWait) >= pClient->tLeaseCheck;
+                    }
+
                     if(TCPIP_ARP_IsResolved(pNetIf, &arpCheck, 0))
                     {   // oooops, someone else with this address!
                         arpChkFail = true;
                     }
-                    else if((_DHCPSecondCountGet() - pClient->startWait) >= pClient->tLeaseCheck)
+                    else if(arpChkTmo)
                     {   // no ARP conflict
 #if (TCPIP_DHCP_DEBUG_MASK & TCPIP_DHCP_DEBUG_MASK_FAIL_ARP) != 0
                         if(_dhcpDbgFailArpCheckCnt != 0)
@@ -1317,6 +1406,7 @@ static void TCPIP_DHCP_Process(bool isTmo)
                     {   // remove ARP entry so that we can probe it again if DHCP is disabled/enabled
                         // or the lease is lost quicker than the ARP entry expiration timeout    
                         TCPIP_ARP_EntryRemove(pNetIf,  &arpCheck);
+                        pClient->tProbe = 0;
                     }
 
                     if(arpChkFail)
@@ -1977,8 +2067,12 @@ static unsigned int _DHCPProcessReceiveData(DHCP_CLIENT_VARS* pClient, TCPIP_NET
                     TCPIP_ARP_EntryRemove(pNetIf,  &arpCheck);
                 }
 #endif  // TCPIP_DHCP_DEBUG_MASK
-                // not really  ARP_OPERATION_GRATUITOUS but only one single probe needs to go out
-                TCPIP_ARP_Probe(pNetIf, &arpCheck, &zeroAdd, ARP_OPERATION_REQ | ARP_OPERATION_CONFIGURE |  ARP_OPERATION_GRATUITOUS);
+                if(pClient->tProbe == 0 || pClient->probeAddress != arpCheck.Val)
+                {   // not probed yet
+                    // not really  ARP_OPERATION_GRATUITOUS but only one single probe needs to go out
+                    TCPIP_ARP_Probe(pNetIf, &arpCheck, &zeroAdd, ARP_OPERATION_REQ | ARP_OPERATION_CONFIGURE |  ARP_OPERATION_GRATUITOUS);
+                    pClient->tProbe = 0;
+                }
                 pClient->startWait = _DHCPSecondCountGet();
                 _DHCPClientStateSet(pClient, TCPIP_DHCP_WAIT_LEASE_CHECK);
                 dhcpEv = DHCP_EVENT_ACK;
@@ -1994,6 +2088,10 @@ static unsigned int _DHCPProcessReceiveData(DHCP_CLIENT_VARS* pClient, TCPIP_NET
             break;
 
         case TCPIP_DHCP_NAK_MESSAGE:
+            if(pClient->dhcpOp == TCPIP_DHCP_OPER_INIT_REBOOT)
+            {   // the previous address is no longer valid
+                _DHCPLeaseForget(pClient);
+            }
             dhcpRecvFail = true;
             dhcpEv = DHCP_EVENT_NACK;
             break;
@@ -2062,6 +2160,9 @@ static void _DHCPSetNewLease(DHCP_CLIENT_VARS* pClient, TCPIP_NET_IF* pNetIf)
         TCPIP_ARP_EntryRemoveNet(pNetIf, &oldNetIp, &oldNetMask, ARP_ENTRY_TYPE_ANY);
     } 
 
+    pClient->bindTime = (uint32_t)(((uint64_t)(SYS_TMR_TickCountGet() - pClient->tLinkUp) * 1000) / SYS_TMR_TickCounterFrequencyGet());
+    pClient->rebootBound = pClient->dhcpOp == TCPIP_DHCP_OPER_INIT_REBOOT;
+
     _DHCPSetBoundState(pClient);
 
     _DHCPNotifyClients(pNetIf, DHCP_EVENT_BOUND);
@@ -2082,6 +2183,7 @@ static void _DHCPSetBoundState(DHCP_CLIENT_VARS* pClient)
     pClient->flags.bReportFail = true; 
     pClient->flags.bRetry = false; 
     _DHCPSetIPv4Filter(pClient, false);
+    _DHCPLeaseSave(pClient);
 }
 
 
@@ -2596,7 +2698,7 @@ void TCPIP_DHCP_ConnectionHandler(TCPIP_NET_IF* pNetIf, TCPIP_MAC_EVENT connEven
             // put it in wait connection mode
             // should be in this state anyway
             // but just in case we've missed the link down event
-            _DHCPEnable(pNetIf, pClient->flags.bWasBound ? TCPIP_DHCP_OPER_INIT_REBOOT : TCPIP_DHCP_OPER_INIT);
+            _DHCPEnable(pNetIf, _DHCPLinkOperation(pClient));
             _DHCPNotifyClients(pNetIf, DHCP_EVENT_CONN_ESTABLISHED);
         }
     }
@@ -2823,6 +2925,19 @@ static UDP_SOCKET _DHCPOpenSocket(void)
     return dhcpSkt;
 }
 
+bool TCPIP_DHCP_LeaseBindKeySet(TCPIP_NET_HANDLE hNet, const void* key, size_t keySize)
+{
+    TCPIP_NET_IF* pNetIf = _TCPIPStackHandleToNetUp(hNet);
+    if(DHCPClients && pNetIf)
+    {
+        DHCP_CLIENT_VARS* pClient = DHCPClients + TCPIP_STACK_NetIxGet(pNetIf);
+        pClient->bindKey = (key == 0 || keySize == 0) ? 0 : fnv_32a_hash(key, keySize);
+        return true;
+    }
+
+    return false;
+}
+
 bool TCPIP_DHCP_InfoGet(TCPIP_NET_HANDLE hNet, TCPIP_DHCP_INFO* pDhcpInfo)
 {
     if(pDhcpInfo)
@@ -2848,6 +2963,8 @@ bool TCPIP_DHCP_InfoGet(TCPIP_NET_HANDLE hNet, TCPIP_DHCP_INFO* pDhcpInfo)
                 pDhcpInfo->dhcpAddress.Val = pClient->dhcpIPAddress.Val;
                 pDhcpInfo->subnetMask.Val = pClient->dhcpMask.Val;
                 pDhcpInfo->serverAddress.Val = pClient->serverAddress.Val;
+                pDhcpInfo->bindTime = pClient->bindTime;
+                pDhcpInfo->rebootBound = pClient->rebootBound != 0;
 #if defined TCPIP_DHCP_STORE_BOOT_FILE_NAME
                 pDhcpInfo->bootFileName = (const char*)pClient->bootFileName;
 #else
@@ -70,6 +70,20 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 
 #define TCPIP_DHCPS_QUEUE_LIMIT_SIZE            (7)
 
+// number of bound leases kept across a reset in persistent RAM
+// 0 disables the lease persistence
+#ifndef TCPIP_DHCPS_LEASE_PERSIST_ENTRIES
+#define TCPIP_DHCPS_LEASE_PERSIST_ENTRIES       TCPIP_DHCPS_LEASE_ENTRIES_DEFAULT
+#endif
+
+// delay to write the lease changes to the persistent store, ms
+// the changes of a burst of clients are written once
+#ifndef TCPIP_DHCPS_LEASE_PERSIST_DELAY
+#define TCPIP_DHCPS_LEASE_PERSIST_DELAY         1000
+#endif
+
+#define TCPIP_DHCPS_LEASE_STORE_MAGIC           0x44485350u     // persistent lease store valid
+
 // Minimum DHCP Discovery packet size 
 #define TCPIP_DHCPS_MIN_DISCOVERY_PKT_SIZE     300
 
@@ -299,8 +313,13 @@ typedef struct
 {
     DHCPS_INTERFACE_CONFIG intfAddrsConf;   // Pool entry and Interface address configuration
     int     netIx;				   // index of the current interface addressed
+    uint32_t*   addrMap;            // pool address bitmap, 1 bit per address: set if leased or offered
+    size_t      poolSize;           // number of addresses in the pool
 }DHCP_SRVR_DCPT;    // DHCP server descriptor
 
+// number of 32 bit words in a pool bitmap
+#define     DHCPS_POOL_MAP_WORDS(poolSize)  (((poolSize) + 31) >> 5)
+
 // DHCP Server cache entry
 typedef struct	_TAG_DHCPS_HASH_ENTRY 
 {
@@ -323,6 +342,9 @@ typedef struct
                                         // calculated from dhcpLeadAddressValidation
     IPV4_ADDR	dhcpNextLease;          // IP Address to provide for next lease
     tcpipSignalHandle signalHandle;     // Asynchronous Timer Handle
+    uint32_t    discoverTick;           // time the DISCOVER being served was received
+    uint32_t    storeDirtyTick;         // time of the first lease change not yet persisted; 0 if none
+    TCPIP_DHCPS_STATISTICS  stat;       // server statistics
 }DHCPS_MOD;    // DHCP server Mode
 
 #define     DHCPS_HASH_PROBE_STEP      1    // step to advance for hash collision
@@ -358,6 +380,39 @@ typedef enum
                                                      
 }DHCPS_ENTRY_FLAGS;
 
+// DHCP server event registration
+
+typedef struct  _TAG_DHCPS_LIST_NODE
+{
+	struct _TAG_DHCPS_LIST_NODE*	next;		// next node in list
+                                                // makes it valid SGL_LIST_NODE node
+    TCPIP_DHCPS_EVENT_HANDLER       handler;    // handler to be called for event
+    const void*                     hParam;     // handler parameter
+    TCPIP_NET_HANDLE                hNet;       // interface that's registered for
+                                                // 0 if all    
+}TCPIP_DHCPS_LIST_NODE;
+
+#if (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+// bound lease kept across a reset
+typedef struct
+{
+    TCPIP_MAC_ADDR  hwAdd;          // client MAC address
+    uint8_t         intfIdx;        // interface the lease belongs to
+    uint8_t         reserved;       // padding, 0
+    IPV4_ADDR       ipAddress;      // leased address
+    uint32_t        leaseLeft;      // lease time left when stored, seconds
+}TCPIP_DHCPS_LEASE_RECORD;
+
+// persistent lease store
+typedef struct
+{
+    uint32_t        magic;          // TCPIP_DHCPS_LEASE_STORE_MAGIC if valid
+    uint32_t        nLeases;        // number of valid records
+    uint32_t        checksum;       // FNV-1a hash of the valid records ^ nLeases
+    TCPIP_DHCPS_LEASE_RECORD    lease[TCPIP_DHCPS_LEASE_PERSIST_ENTRIES];
+}TCPIP_DHCPS_LEASE_STORE;
+#endif  // (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+
 int TCPIP_DHCPS_HashMACKeyCompare(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* hEntry, const void* key);
 int TCPIP_DHCPS_HashIPKeyCompare(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* hEntry, const uint8_t* key);
 void TCPIP_DHCPS_HashIPKeyCopy(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* dstEntry, const void* key);
@@ -72,6 +72,8 @@ static TCPIP_DNS_RESULT     _DNS_Send_Query(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_
 static TCPIP_DNS_RESULT     _DNS_Resolve(const char* hostName, TCPIP_DNS_RESOLVE_TYPE type, bool forceQuery);
 static bool                 _DNS_ProcessPacket(TCPIP_DNS_DCPT* pDnsDcpt);
 static  TCPIP_DNS_RESULT    _DNSCompleteHashEntry(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE);
+static  void                _DNSNegativeHashEntry(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE, uint32_t negTTL);
+static  bool                _DNS_EntryIsPending(TCPIP_DNS_HASH_ENTRY* pDnsHE);
 static  void                _DNS_CleanCache(TCPIP_DNS_DCPT* pDnsDcpt);
 static TCPIP_DNS_RESULT     _DNS_IsNameResolved(const char* hostName, IPV4_ADDR* hostIPv4, IPV6_ADDR* hostIPv6, bool singleAddress);
 static bool                 _DNS_ValidateIf(TCPIP_NET_IF* pIf, TCPIP_DNS_HASH_ENTRY* pDnsHE, bool wrapAround);
@@ -89,7 +91,7 @@ static void                 _DNSClientCleanup(TCPIP_DNS_DCPT* pDnsDcpt);
 #define _DNSClientCleanup(pDnsDcpt)
 #endif  // (TCPIP_STACK_DOWN_OPERATION != 0)
 static TCPIP_DNS_HASH_ENTRY *_DNSHashEntryFromTransactionId(TCPIP_DNS_DCPT* pDnsDcpt, const char* hostName, uint16_t transactionId);
-static bool                 _DNS_RESPONSE_HashEntryUpdate(TCPIP_DNS_RX_DATA* dnsRxData, TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE);
+static bool                 _DNS_RESPONSE_HashEntryUpdate(TCPIP_DNS_RR_PROCESS* pProc, TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE);
 static int                  _DNS_GetAddresses(const char* hostName, int startIndex, IP_MULTI_ADDRESS* pIPAddr, int nIPAddresses, TCPIP_DNS_ADDRESS_REC_MASK recMask);
 
 
@@ -253,11 +255,24 @@ static void _SwapDNSAnswerPacket(TCPIP_DNS_ANSWER_HEADER * p)
     p->ResponseType.Val = TCPIP_Helper_htons(p->ResponseType.Val);
 }
 
+// an entry waiting for a server reply is counted in unsolvedEntries:
+// an unsolved entry or a solved one that's being refreshed
+static bool _DNS_EntryIsPending(TCPIP_DNS_HASH_ENTRY* pDnsHE)
+{
+    uint16_t flags = pDnsHE->hEntry.flags.value;
+
+    if((flags & TCPIP_DNS_FLAG_ENTRY_PREFETCH) != 0)
+    {
+        return true;
+    }
+    return (flags & (TCPIP_DNS_FLAG_ENTRY_COMPLETE | TCPIP_DNS_FLAG_ENTRY_NEGATIVE)) == 0;
+}
+
 static void _DNS_CleanCacheEntry(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* pDnsHE)
 {
     if(pDnsHE->hEntry.flags.busy)
     {
-        if((pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_COMPLETE) == 0)
+        if(_DNS_EntryIsPending(pDnsHE))
         {   // deleting an unsolved entry
             pDnsDcpt->unsolvedEntries--;
             _DNSAssertCond(pDnsDcpt->unsolvedEntries >= 0, __func__, __LINE__);
@@ -292,8 +307,9 @@ static void _DNS_UpdateExpiredHashEntry_Notify(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_D
 
 static  TCPIP_DNS_RESULT  _DNSCompleteHashEntry(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE)
 {
+    uint32_t latency;
      
-    dnsHE->hEntry.flags.value &= ~TCPIP_DNS_FLAG_ENTRY_TIMEOUT;
+    dnsHE->hEntry.flags.value &= ~(TCPIP_DNS_FLAG_ENTRY_TIMEOUT | TCPIP_DNS_FLAG_ENTRY_NEGATIVE | TCPIP_DNS_FLAG_ENTRY_HOT | TCPIP_DNS_FLAG_ENTRY_PREFETCH);
     dnsHE->hEntry.flags.value |= TCPIP_DNS_FLAG_ENTRY_COMPLETE;
     dnsHE->recordMask = TCPIP_DNS_ADDRESS_REC_NONE;
 
@@ -310,13 +326,40 @@ static  TCPIP_DNS_RESULT  _DNSCompleteHashEntry(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_
     {
         dnsHE->ipTTL.Val = TCPIP_DNS_CLIENT_CACHE_DEFAULT_TTL_VAL;
     }
-    dnsHE->tRetry = dnsHE->tInsert = pDnsDcpt->dnsTime; 
+    dnsHE->tRetry = dnsHE->tInsert = dnsHE->tUsed = pDnsDcpt->dnsTime; 
     pDnsDcpt->unsolvedEntries--;
     _DNSAssertCond(pDnsDcpt->unsolvedEntries >= 0, __func__, __LINE__);
 
+    latency = (uint32_t)(((uint64_t)(SYS_TMR_TickCountGet() - dnsHE->tQuery) * 1000) / SYS_TMR_TickCounterFrequencyGet());
+    pDnsDcpt->stat.nResolved++;
+    pDnsDcpt->stat.latencyTotal += latency;
+    if(latency > pDnsDcpt->stat.latencyMax)
+    {
+        pDnsDcpt->stat.latencyMax = latency;
+    }
+
     return TCPIP_DNS_RES_OK;
 }
 
+// caches a name error/no data answer (RFC 2308)
+// negTTL is the SOA minimum TTL, if the answer carried one, else 0
+static  void _DNSNegativeHashEntry(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE, uint32_t negTTL)
+{
+    dnsHE->hEntry.flags.value &= ~(TCPIP_DNS_FLAG_ENTRY_COMPLETE | TCPIP_DNS_FLAG_ENTRY_TIMEOUT | TCPIP_DNS_FLAG_ENTRY_HOT | TCPIP_DNS_FLAG_ENTRY_PREFETCH);
+    dnsHE->hEntry.flags.value |= TCPIP_DNS_FLAG_ENTRY_NEGATIVE;
+    dnsHE->nIPv4Entries = dnsHE->nIPv6Entries = 0;
+
+    if(negTTL == 0 || negTTL > TCPIP_DNS_CLIENT_CACHE_NEGATIVE_TTL)
+    {
+        negTTL = TCPIP_DNS_CLIENT_CACHE_NEGATIVE_TTL;
+    }
+    dnsHE->ipTTL.Val = negTTL;
+    dnsHE->tRetry = dnsHE->tInsert = dnsHE->tUsed = pDnsDcpt->dnsTime; 
+    pDnsDcpt->unsolvedEntries--;
+    _DNSAssertCond(pDnsDcpt->unsolvedEntries >= 0, __func__, __LINE__);
+    pDnsDcpt->stat.nameErrors++;
+}
+
 static  void _DNSDeleteCacheEntries(TCPIP_DNS_DCPT* pDnsDcpt)
 {
     size_t          bktIx;
@@ -668,9 +711,18 @@ static TCPIP_DNS_RESULT _DNS_Resolve(const char* hostName, TCPIP_DNS_RESOLVE_TYP
         if((dnsHE->recordMask & recMask) == recMask)
         {   // already have the requested type
             if((dnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_COMPLETE) != 0)
-            {
+            {   // mark it for refresh before expiry
+               dnsHE->hEntry.flags.value |= TCPIP_DNS_FLAG_ENTRY_HOT;
+               dnsHE->tUsed = pDnsDcpt->dnsTime;
+               pDnsDcpt->stat.cacheHits++;
                return TCPIP_DNS_RES_OK; 
             }
+            if((dnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_NEGATIVE) != 0)
+            {   // cached name error
+               dnsHE->tUsed = pDnsDcpt->dnsTime;
+               pDnsDcpt->stat.negativeHits++;
+               return TCPIP_DNS_RES_NO_NAME_ENTRY; 
+            }
             return (dnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_TIMEOUT) == 0 ? TCPIP_DNS_RES_PENDING : TCPIP_DNS_RES_SERVER_TMO; 
         }
         // else new query is needed, for new type
@@ -678,14 +730,16 @@ static TCPIP_DNS_RESULT _DNS_Resolve(const char* hostName, TCPIP_DNS_RESOLVE_TYP
 
     // this is a forced/new entry/query
     // update entry parameters
+    bool wasPending = dnsHE->hEntry.flags.newEntry == 0 && _DNS_EntryIsPending(dnsHE);
     if(dnsHE->hEntry.flags.newEntry != 0)
     {
         dnsHE->nIPv4Entries = 0;
         dnsHE->nIPv6Entries = 0;
-        dnsHE->hEntry.flags.value &= ~(TCPIP_DNS_FLAG_ENTRY_COMPLETE | TCPIP_DNS_FLAG_ENTRY_TIMEOUT);
+        dnsHE->hEntry.flags.value &= ~(TCPIP_DNS_FLAG_ENTRY_COMPLETE | TCPIP_DNS_FLAG_ENTRY_TIMEOUT | TCPIP_DNS_FLAG_ENTRY_NEGATIVE | TCPIP_DNS_FLAG_ENTRY_HOT | TCPIP_DNS_FLAG_ENTRY_PREFETCH);
     }
     else
     {   // forced
+        dnsHE->hEntry.flags.value &= ~(TCPIP_DNS_FLAG_ENTRY_NEGATIVE | TCPIP_DNS_FLAG_ENTRY_HOT | TCPIP_DNS_FLAG_ENTRY_PREFETCH);
         if((recMask & TCPIP_DNS_ADDRESS_REC_IPV4) != 0)
         {
             dnsHE->nIPv4Entries = 0;
@@ -699,12 +753,17 @@ static TCPIP_DNS_RESULT _DNS_Resolve(const char* hostName, TCPIP_DNS_RESOLVE_TYP
     dnsHE->ipTTL.Val = 0;
     dnsHE->resolve_type = type;
     dnsHE->recordMask |= recMask;
-    dnsHE->tRetry = dnsHE->tInsert = pDnsDcpt->dnsTime;
+    dnsHE->tRetry = dnsHE->tInsert = dnsHE->tUsed = pDnsDcpt->dnsTime;
+    dnsHE->tQuery = SYS_TMR_TickCountGet();
     dnsHE->currRetry = 0;
     // if a strict interface, we try only on that; otherwise on all
     int retryIfs = (pDnsDcpt->strictNet == 0) ? TCPIP_STACK_NumberOfNetworksGet() : 1;
     dnsHE->nRetries = retryIfs * _TCPIP_DNS_IF_RETRY_COUNT;
-    pDnsDcpt->unsolvedEntries++;
+    pDnsDcpt->stat.cacheMisses++;
+    if(!wasPending)
+    {
+        pDnsDcpt->unsolvedEntries++;
+    }
     return _DNS_Send_Query(pDnsDcpt, dnsHE);
 }
 
@@ -898,12 +957,19 @@ static TCPIP_DNS_RESULT  _DNS_IsNameResolved(const char* hostName, IPV4_ADDR* ho
         return TCPIP_DNS_RES_NO_NAME_ENTRY;
     }
 
+    if((pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_NEGATIVE) != 0)
+    {   // cached name error
+        return TCPIP_DNS_RES_NO_NAME_ENTRY;
+    }
+
     if((pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_COMPLETE) == 0)
     {   // unsolved entry   
         return (pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_TIMEOUT) == 0 ? TCPIP_DNS_RES_PENDING : TCPIP_DNS_RES_SERVER_TMO; 
     }
 
     // completed entry
+    pDnsHE->hEntry.flags.value |= TCPIP_DNS_FLAG_ENTRY_HOT;
+    pDnsHE->tUsed = pDnsDcpt->dnsTime;
     nIPv6Entries = pDnsHE->nIPv6Entries;
     nIPv4Entries = pDnsHE->nIPv4Entries;
 
@@ -955,6 +1021,26 @@ TCPIP_DNS_RESULT TCPIP_DNS_ClientInfoGet(TCPIP_DNS_CLIENT_INFO* pClientInfo)
     return TCPIP_DNS_RES_OK;
 }
 
+TCPIP_DNS_RESULT TCPIP_DNS_ClientStatisticsGet(TCPIP_DNS_CLIENT_STATISTICS* pStat, bool clear)
+{
+    TCPIP_DNS_DCPT* pDnsDcpt = pgDnsDcpt;
+
+    if(pDnsDcpt==NULL)
+    {
+         return TCPIP_DNS_RES_NO_SERVICE;
+    }
+
+    if(pStat)
+    {
+        *pStat = pDnsDcpt->stat;
+    }
+    if(clear)
+    {
+        memset(&pDnsDcpt->stat, 0, sizeof(pDnsDcpt->stat));
+    }
+    return TCPIP_DNS_RES_OK;
+}
+
 TCPIP_DNS_RESULT TCPIP_DNS_EntryQuery(TCPIP_DNS_ENTRY_QUERY *pDnsQuery, int queryIndex)
 {
     OA_HASH_ENTRY*  pBkt;
@@ -1016,6 +1102,13 @@ TCPIP_DNS_RESULT TCPIP_DNS_EntryQuery(TCPIP_DNS_ENTRY_QUERY *pDnsQuery, int quer
 
             return TCPIP_DNS_RES_OK;
         }
+        else if((pBkt->flags.value & TCPIP_DNS_FLAG_ENTRY_NEGATIVE) != 0)
+        {
+            pDnsQuery->status = TCPIP_DNS_RES_NO_NAME_ENTRY;
+            pDnsQuery->ttlTime = pE->ipTTL.Val - (pDnsDcpt->dnsTime - pE->tInsert);
+            pDnsQuery->nIPv4ValidEntries = 0;
+            pDnsQuery->nIPv6ValidEntries = 0;
+        }
         else
         {
             pDnsQuery->status = (pE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_TIMEOUT) == 0 ? TCPIP_DNS_RES_PENDING : TCPIP_DNS_RES_SERVER_TMO; 
@@ -1227,7 +1320,10 @@ static TCPIP_DNS_RESULT _DNS_Send_Query(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH
     IPV4_ADDR           dnsServerAdd;
     UDP_SOCKET          dnsSocket = pDnsDcpt->dnsSocket;
     
-    pDnsHE->hEntry.flags.value &= ~TCPIP_DNS_FLAG_ENTRY_COMPLETE;
+    if((pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_PREFETCH) == 0)
+    {   // a refreshed entry keeps serving the old addresses
+        pDnsHE->hEntry.flags.value &= ~TCPIP_DNS_FLAG_ENTRY_COMPLETE;
+    }
 
     while(true)
     {
@@ -1412,6 +1508,7 @@ static void TCPIP_DNS_CacheTimeout(TCPIP_DNS_DCPT* pDnsDcpt)
     OA_HASH_DCPT    *pOH;
     uint32_t        currTime;
     uint32_t        timeout;
+    uint32_t        prefetchTmo;
 
     // get current time: seconds
     currTime = pDnsDcpt->dnsTime;
@@ -1434,6 +1531,50 @@ static void TCPIP_DNS_CacheTimeout(TCPIP_DNS_DCPT* pDnsDcpt)
                 {
                     _DNS_UpdateExpiredHashEntry_Notify(pDnsDcpt, pDnsHE);
                 }
+                else if((pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_PREFETCH) != 0)
+                {   // refresh in progress
+                    if((currTime - pDnsHE->tRetry) >= TCPIP_DNS_CLIENT_LOOKUP_RETRY_TMO)
+                    {
+                        pDnsHE->tRetry = currTime;
+                        if(pDnsHE->currRetry < pDnsHE->nRetries)
+                        {
+                            pDnsHE->currRetry++;
+                            _DNS_Send_Query(pDnsDcpt, pDnsHE);
+                        }
+                        else
+                        {   // give up; the entry will just expire
+                            pDnsHE->hEntry.flags.value &= ~(TCPIP_DNS_FLAG_ENTRY_PREFETCH | TCPIP_DNS_FLAG_ENTRY_HOT);
+                            pDnsDcpt->unsolvedEntries--;
+                            _DNSAssertCond(pDnsDcpt->unsolvedEntries >= 0, __func__, __LINE__);
+                        }
+                    }
+                }
+                else if((pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_HOT) != 0)
+                {   // used entry: refresh it before it expires
+                    prefetchTmo = timeout / 4;
+                    if(prefetchTmo > TCPIP_DNS_CLIENT_CACHE_PREFETCH_TMO)
+                    {
+                        prefetchTmo = TCPIP_DNS_CLIENT_CACHE_PREFETCH_TMO;
+                    }
+                    if(timeout - (currTime - pDnsHE->tInsert) <= prefetchTmo)
+                    {
+                        pDnsHE->hEntry.flags.value |= TCPIP_DNS_FLAG_ENTRY_PREFETCH;
+                        pDnsHE->tRetry = currTime;
+                        pDnsHE->tQuery = SYS_TMR_TickCountGet();
+                        pDnsHE->currRetry = 0;
+                        pDnsHE->nRetries = ((pDnsDcpt->strictNet == 0) ? TCPIP_STACK_NumberOfNetworksGet() : 1) * _TCPIP_DNS_IF_RETRY_COUNT;
+                        pDnsDcpt->unsolvedEntries++;
+                        pDnsDcpt->stat.prefetches++;
+                        _DNS_Send_Query(pDnsDcpt, pDnsHE);
+                    }
+                }
+            }
+            else if((pDnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_NEGATIVE) != 0)
+            {   // cached name error
+                if((currTime - pDnsHE->tInsert) >= pDnsHE->ipTTL.Val)
+                {
+                    _DNS_UpdateExpiredHashEntry_Notify(pDnsDcpt, pDnsHE);
+                }
             }
             else
             {   // unsolved entry
@@ -1507,11 +1648,13 @@ static void TCPIP_DNS_ClientProcess(bool isTmo)
 // if dnsHE == 0, than it just discards
 // returns true if processing was successful
 // false if some error occurred
-static bool _DNS_RESPONSE_HashEntryUpdate(TCPIP_DNS_RX_DATA* dnsRxData, TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE)
+static bool _DNS_RESPONSE_HashEntryUpdate(TCPIP_DNS_RR_PROCESS* pProc, TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_HASH_ENTRY* dnsHE)
 {
     TCPIP_DNS_ANSWER_HEADER DNSAnswerHeader;    
     IP_MULTI_ADDRESS        ipAddr;
     bool                    discardData;
+    TCPIP_UINT32_VAL        soaMin;
+    TCPIP_DNS_RX_DATA*      dnsRxData = pProc->dnsRxData;
 
     if(!_DNSGetData(dnsRxData, (uint8_t *)&DNSAnswerHeader, sizeof(TCPIP_DNS_ANSWER_HEADER)))
     {   // failed to read the RR header
@@ -1575,6 +1718,20 @@ static bool _DNS_RESPONSE_HashEntryUpdate(TCPIP_DNS_RX_DATA* dnsRxData, TCPIP_DN
             break;
         }
 
+        if (DNSAnswerHeader.ResponseType.Val == _TCPIP_DNS_TYPE_SOA && DNSAnswerHeader.ResponseLen.Val > 4)
+        {   // negative answer TTL: min(SOA TTL, SOA MINIMUM); RFC 2308
+            // MINIMUM is the last field of the RDATA
+            if(!_DNSGetData(dnsRxData, 0, DNSAnswerHeader.ResponseLen.Val - 4) || !_DNSGetData(dnsRxData, soaMin.v, 4))
+            {
+                return false;
+            }
+
+            discardData = false;
+            soaMin.Val = TCPIP_Helper_ntohl(soaMin.Val);
+            pProc->negTTL = soaMin.Val < DNSAnswerHeader.ResponseTTL.Val ? soaMin.Val : DNSAnswerHeader.ResponseTTL.Val;
+            break;
+        }
+
         // else discard and continue
         break;
     }
@@ -1692,7 +1849,7 @@ static int _DNS_ProcessRR(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_RR_PROCESS* pProc,
 
         if(dnsHE != 0)
         {
-            if((dnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_COMPLETE) != 0)
+            if(!_DNS_EntryIsPending(dnsHE))
             {
                 evDbgType = TCPIP_DNS_DBG_EVENT_COMPLETE_ERROR;
                 break;
@@ -1701,6 +1858,11 @@ static int _DNS_ProcessRR(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_RR_PROCESS* pProc,
             if(pProc->dnsHE == 0)
             {
                 pProc->dnsHE = dnsHE;
+                if((dnsHE->hEntry.flags.value & TCPIP_DNS_FLAG_ENTRY_PREFETCH) != 0)
+                {   // refresh answer replaces the old addresses
+                    dnsHE->nIPv4Entries = dnsHE->nIPv6Entries = 0;
+                    dnsHE->ipTTL.Val = 0;
+                }
             }
             else if(pProc->dnsHE != dnsHE)
             {
@@ -1720,7 +1882,7 @@ static int _DNS_ProcessRR(TCPIP_DNS_DCPT* pDnsDcpt, TCPIP_DNS_RR_PROCESS* pProc,
         }
         else
         {
-            bool entryUpdate = _DNS_RESPONSE_HashEntryUpdate(pProc->dnsRxData, pDnsDcpt, dnsHE);
+            bool entryUpdate = _DNS_RESPONSE_HashEntryUpdate(pProc, pDnsDcpt, dnsHE);
             if(entryUpdate == false)
             {
                 evDbgType = TCPIP_DNS_DBG_EVENT_RR_DATA_ERROR;
@@ -1761,6 +1923,7 @@ static bool _DNS_ProcessPacket(TCPIP_DNS_DCPT* pDnsDcpt)
     TCPIP_DNS_EVENT_TYPE    evType = TCPIP_DNS_EVENT_NONE;
     TCPIP_DNS_DBG_EVENT_TYPE evDbgType = TCPIP_DNS_DBG_EVENT_NONE;
     TCPIP_DNS_RR_PROCESS    procRR;
+    uint8_t                 rCode;
 
 
     // Get DNS Reply packet
@@ -1783,14 +1946,16 @@ static bool _DNS_ProcessPacket(TCPIP_DNS_DCPT* pDnsDcpt)
     procRR.dnsRxData = &dnsRxData;
     procRR.dnsPacketSize = dnsPacketSize;
     procRR.dnsHE = 0;
+    procRR.negTTL = 0;
+    rCode = DNSHeader.Flags.v[0] & _TCPIP_DNS_RCODE_MASK;
 
     while(true)
     {
         dnsHE = 0;
         procFail = false;
 
-        if((DNSHeader.Flags.v[0] & 0x03) != 0)
-        {   
+        if(rCode != 0 && rCode != _TCPIP_DNS_RCODE_NAME_ERROR)
+        {   // server failure, refused, etc.; the query is retried
             evType = TCPIP_DNS_EVENT_NAME_ERROR;
             procFail = true;
             break;
@@ -1818,10 +1983,14 @@ static bool _DNS_ProcessPacket(TCPIP_DNS_DCPT* pDnsDcpt)
         dnsHE = procRR.dnsHE;
 
         // finally
-        if(dnsHE != 0 && (dnsHE->nIPv4Entries > 0 || dnsHE->nIPv6Entries > 0))
+        if(dnsHE != 0 && rCode == 0 && (dnsHE->nIPv4Entries > 0 || dnsHE->nIPv6Entries > 0))
         {
             evType = TCPIP_DNS_EVENT_NAME_RESOLVED;
         }           
+        else if(dnsHE != 0)
+        {   // name error or no data answer
+            evType = TCPIP_DNS_EVENT_NAME_ERROR;
+        }
         else
         {
             evDbgType = TCPIP_DNS_DBG_EVENT_NO_IP_ERROR;
@@ -1840,8 +2009,8 @@ static bool _DNS_ProcessPacket(TCPIP_DNS_DCPT* pDnsDcpt)
             _DNSCompleteHashEntry(pDnsDcpt, dnsHE);
         }
         else if(evType == TCPIP_DNS_EVENT_NAME_ERROR && dnsHE != 0)
-        {   // Remove name if "No Such name"
-            TCPIP_DNS_RemoveEntry(dnsHE->pHostName);
+        {   // cache the "No Such name"
+            _DNSNegativeHashEntry(pDnsDcpt, dnsHE, procRR.negTTL);
         }
     }
     else if (evDbgType != TCPIP_DNS_DBG_EVENT_NONE)
@@ -2048,25 +2217,52 @@ static OA_HASH_ENTRY* TCPIP_DNS_OAHASH_DeleteEntry(OA_HASH_DCPT* pOH)
     TCPIP_DNS_DCPT        *pDnsDcpt;
     uint32_t        currTime;
     uint32_t        timeout;
+    TCPIP_DNS_HASH_ENTRY  *pLru;
 
     pDnsDcpt = pgDnsDcpt;
     currTime = pDnsDcpt->dnsTime;
+    pLru = 0;
 
+    // remove an expired entry, else the least recently used one
+    // pending entries are never removed
     for(bktIx = 0; bktIx < pOH->hEntries; bktIx++)
     {
         pBkt = TCPIP_OAHASH_EntryGet(pOH, bktIx);       
-        if(pBkt->flags.busy != 0 && (pBkt->flags.value & TCPIP_DNS_FLAG_ENTRY_COMPLETE) != 0)
+        if(pBkt->flags.busy != 0)
         {
             pE = (TCPIP_DNS_HASH_ENTRY*)pBkt;
-            timeout = (pDnsDcpt->cacheEntryTMO > 0) ? pDnsDcpt->cacheEntryTMO : pE->ipTTL.Val;
+            if(_DNS_EntryIsPending(pE))
+            {
+                continue;
+            }
+
+            if((pBkt->flags.value & TCPIP_DNS_FLAG_ENTRY_NEGATIVE) != 0)
+            {
+                timeout = pE->ipTTL.Val;
+            }
+            else
+            {
+                timeout = (pDnsDcpt->cacheEntryTMO > 0) ? pDnsDcpt->cacheEntryTMO : pE->ipTTL.Val;
+            }
 
             if((currTime - pE->tInsert) >= timeout)
             {
-                _DNSNotifyClients(pDnsDcpt, pE, TCPIP_DNS_EVENT_NAME_REMOVED);
-                return pBkt;
+                pLru = pE;
+                break;
+            }
+
+            if(pLru == 0 || (int32_t)(pE->tUsed - pLru->tUsed) < 0)
+            {
+                pLru = pE;
             }
         }
     }
+
+    if(pLru != 0)
+    {
+        _DNSNotifyClients(pDnsDcpt, pLru, TCPIP_DNS_EVENT_NAME_REMOVED);
+        return &pLru->hEntry;
+    }
     return 0;
 }
 
@@ -71,11 +71,12 @@ static  TCPIP_DNSS_RESULT  _DNSSSetHashEntry( DNSS_HASH_ENTRY_FLAGS newFlags,TCP
 static void _DNSSGetRecordType(UDP_SOCKET s,TCPIP_UINT16_VAL *recordType);
 static bool TCPIP_DNSS_ValidateIf(TCPIP_NET_IF* pIf);
 static bool _DNSS_Enable(TCPIP_NET_HANDLE hNet, bool checkIfUp);
-static bool TCPIP_DNSS_DataPut(uint8_t * buf,uint32_t pos,uint8_t val);
 static uint8_t TCPIP_DNSS_DataGet(uint16_t pos);
 static void TCPIP_DNSS_CacheTimeTask(void);
 static void TCPIP_DNSS_Process(void);
 static void _DNSSSocketRxSignalHandler(UDP_SOCKET hUDP, TCPIP_NET_HANDLE hNet, TCPIP_UDP_SIGNAL_TYPE sigType, const void* param);
+static uint16_t _DNSSAnswerPut(uint8_t* pBuff, uint16_t recordType, uint32_t ttlTime, const uint8_t* pAdd, uint16_t addSize);
+static void _DNSSAnswersBuild(DNSS_HASH_ENTRY* dnsSHE);
 
 
 
@@ -88,9 +89,12 @@ static uint16_t countWithDot=0;
 static uint8_t hostNameWithLen[TCPIP_DNSS_HOST_NAME_LEN+1]={0}; 
 static uint16_t countWithLen=0;
 
-static uint8_t  dnsSrvRecvByte[64+1]={0};
+// only the header and the first question are kept
+static uint8_t  dnsSrvRecvByte[sizeof(DNSS_HEADER) + TCPIP_DNSS_HOST_NAME_LEN + 1 + 4]={0};
 // DNS server received buffer position
 static uint32_t gDnsSrvBytePos=0;
+// DNS server received bytes in dnsSrvRecvByte
+static uint32_t gDnsSrvRecvLen=0;
 
 #if (TCPIP_STACK_DOWN_OPERATION != 0)
 static  void _DNSSRemoveCacheEntries(void);
@@ -124,6 +128,7 @@ bool TCPIP_DNSS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
     uint8_t             hashCnt=0;
     OA_HASH_ENTRY       *pBkt=NULL;
     DNSS_HASH_ENTRY     *pE=NULL;
+    size_t              answersSize;
 
     if(stackCtrl->stackAction == TCPIP_STACK_ACTION_IF_UP)
     {	// interface restart      
@@ -181,6 +186,8 @@ bool TCPIP_DNSS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
         pDnsSDcpt->dnsSrvSocket = INVALID_UDP_SOCKET;
         pDnsSDcpt->smState = DNSS_STATE_START;
         pDnsSDcpt->replyWithBoardInfo = pDnsSConfig->replyBoardAddr;
+        pDnsSDcpt->captivePortal = pDnsSConfig->captivePortal;
+        pDnsSDcpt->boardAddress.Val = 0;
         pDnsSDcpt->dnsSrvInitCount++;
 
 
@@ -202,7 +209,13 @@ bool TCPIP_DNSS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
 #if defined(TCPIP_STACK_USE_IPV6)
         + pDnsSDcpt->IPv6EntriesPerDNSName*sizeof(IPV6_ADDR)
 #endif
-        +TCPIP_DNSS_HOST_NAME_LEN+1;
+        +TCPIP_DNSS_HOST_NAME_LEN+1
+        // answer templates
+        + pDnsSDcpt->IPv4EntriesPerDNSName*DNSS_ANSWER_RR_SIZE(sizeof(IPV4_ADDR))
+#if defined(TCPIP_STACK_USE_IPV6)
+        + pDnsSDcpt->IPv6EntriesPerDNSName*DNSS_ANSWER_RR_SIZE(sizeof(IPV6_ADDR))
+#endif
+        ;
 
         for(hashCnt=0;hashCnt < cacheEntries;hashCnt++)
         {
@@ -249,7 +262,34 @@ bool TCPIP_DNSS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
 #endif
                             );
             }
-            
+            // the answer templates follow the hostname
+            pE->pAnsA = pMemoryBlock + memoryBlockSize - pDnsSDcpt->IPv4EntriesPerDNSName*DNSS_ANSWER_RR_SIZE(sizeof(IPV4_ADDR))
+#if defined(TCPIP_STACK_USE_IPV6)
+                        - pDnsSDcpt->IPv6EntriesPerDNSName*DNSS_ANSWER_RR_SIZE(sizeof(IPV6_ADDR))
+#endif
+                        ;
+#if defined(TCPIP_STACK_USE_IPV6)
+            pE->pAnsAAAA = pE->pAnsA + pDnsSDcpt->IPv4EntriesPerDNSName*DNSS_ANSWER_RR_SIZE(sizeof(IPV4_ADDR));
+#endif
+        }
+
+        // the response buffer: header, question and the largest answer section
+        answersSize = pDnsSDcpt->IPv4EntriesPerDNSName != 0 ? pDnsSDcpt->IPv4EntriesPerDNSName : 1;
+        answersSize *= DNSS_ANSWER_RR_SIZE(sizeof(IPV4_ADDR));
+#if defined(TCPIP_STACK_USE_IPV6)
+        if(answersSize < (pDnsSDcpt->IPv6EntriesPerDNSName != 0 ? pDnsSDcpt->IPv6EntriesPerDNSName : 1) * DNSS_ANSWER_RR_SIZE(sizeof(IPV6_ADDR)))
+        {
+            answersSize = (pDnsSDcpt->IPv6EntriesPerDNSName != 0 ? pDnsSDcpt->IPv6EntriesPerDNSName : 1) * DNSS_ANSWER_RR_SIZE(sizeof(IPV6_ADDR));
+        }
+#endif
+        if(pDnsSDcpt->pResponse == 0)
+        {
+            pDnsSDcpt->pResponse = (uint8_t*)TCPIP_HEAP_Malloc(pDnsSDcpt->memH, sizeof(DNSS_HEADER) + TCPIP_DNSS_HOST_NAME_LEN + 1 + 4 + answersSize);
+            if(pDnsSDcpt->pResponse == 0)
+            {
+                _DNSS_RemoveHashAll();
+                return false;
+            }
         }
     }
 
@@ -261,6 +301,10 @@ bool TCPIP_DNSS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
     return true;
 }
 
+// The responses are assembled from precomputed answers:
+// the answer RRs of a cache entry are built once, when its addresses change,
+// and only the header, the question echo and the TTLs are written per query.
+// The response is sent with a single TCPIP_UDP_ArrayPut.
 static bool _DNSS_SendResponse(DNSS_HEADER *dnsHeader,TCPIP_NET_IF *pNet)
 {
     TCPIP_UINT16_VAL    recordType;
@@ -268,23 +312,24 @@ static bool _DNSS_SendResponse(DNSS_HEADER *dnsHeader,TCPIP_NET_IF *pNet)
     UDP_SOCKET  s;
     OA_HASH_ENTRY* hE=NULL;
     DNSS_HASH_ENTRY *dnsSHE = NULL;
-    uint8_t *pMemoryBlock = NULL;
+    const uint8_t* pAnswers = NULL;
+    uint16_t nAnswers = 0;
     uint16_t resAnswerRRs=0;
+    uint16_t rrSize = 0;
     uint32_t ttlTime = 0;
-    uint8_t *txbuf;
-    uint8_t  count=0;
-    uint16_t     offset=0;
+    bool     ttlPatch = false;
+    uint8_t *pResp;
+    uint8_t *pTtl;
+    uint16_t count;
     uint32_t   servTxMsgSize=0;
-    uint32_t   txBufPos = 0;
-    uint8_t    hostNamePos=0;
 #if defined (TCPIP_STACK_USE_IPV6)
-    uint8_t     i=0;
     IPV6_INTERFACE_CONFIG*  pIpv6Config;
     IPV6_ADDR_STRUCT * addressPointer;
+    static uint8_t boardAnsAAAA[DNSS_ANSWER_RR_SIZE(sizeof(IPV6_ADDR))];
 #endif
 
     pDnsSrvDcpt  = &gDnsSrvDcpt;
-    if(pDnsSrvDcpt->dnssHashDcpt == NULL)
+    if(pDnsSrvDcpt->dnssHashDcpt == NULL || pDnsSrvDcpt->pResponse == NULL)
     {
         return false;
     }
@@ -292,264 +337,225 @@ static bool _DNSS_SendResponse(DNSS_HEADER *dnsHeader,TCPIP_NET_IF *pNet)
 
      // collect hostname from Client Query Named server packet
     _DNSCopyRXNameToTX(s);   // Copy hostname of first question over to TX packet
-    if(strlen((char*)hostNameWithDot) == 0)
+    if(countWithDot == 0)
     {       
         return false;
     }
     // Get the Record type
     _DNSSGetRecordType(s,&recordType);
-    switch(recordType.Val)
-    {
-        case TCPIP_DNSS_TYPE_A:
-#if defined(TCPIP_STACK_USE_IPV6)
-        case TCPIP_DNSS_TYPE_AAAA:
-#endif
-            break;
-        default:            
-            return false;
-    }
+
     if(!pDnsSrvDcpt->replyWithBoardInfo)
     {
         hE = TCPIP_OAHASH_EntryLookup(pDnsSrvDcpt->dnssHashDcpt, (uint8_t *)hostNameWithDot);
-        if(hE != 0)
-        {
-            dnsSHE = (DNSS_HASH_ENTRY*)hE;
-            pMemoryBlock = (uint8_t*)dnsSHE->memblk;
-        }
-        else
+        if(hE == 0 && !pDnsSrvDcpt->captivePortal)
         {
             return false;
         }
     }
-    // update Answer field
-    // If the client Query answer is zero, then Response will have all the answers which is present in the cache
-    // else if the client query answer count is more than the available answer counts  of the cache, then Answer RRs should
-    // be the value of available entries in the cache , else if only the limited Answer RRs
-    if(recordType.Val == TCPIP_DNSS_TYPE_A)
-    {
-        if(pDnsSrvDcpt->replyWithBoardInfo)
+
+    if(hE != 0)
+    {   // answer from the cache
+        dnsSHE = (DNSS_HASH_ENTRY*)hE;
+        if((dnsSHE->hEntry.flags.value & DNSS_FLAG_ANSWERS_VALID) == 0)
         {
-            resAnswerRRs = 1;
-            ttlTime = TCPIP_DNSS_TTL_TIME;
+            _DNSSAnswersBuild(dnsSHE);
         }
-        else if(hE != 0)
+
+        if(recordType.Val == TCPIP_DNSS_TYPE_A)
         {
-            if((dnsHeader->wAnswerRRs.Val == 0) || (dnsHeader->wAnswerRRs.Val > dnsSHE->nIPv4Entries))
-            {
-            // all the available IPv4 address entries
-                resAnswerRRs = dnsSHE->nIPv4Entries;
-            }
-            else  // only limited entries
-            {
-                resAnswerRRs = dnsHeader->wAnswerRRs.Val;
-            }
-            // ttl time  w.r.t configured per entry
-            // if the validityTime is not equal to 0
-            if(dnsSHE->validityTime.Val != 0)
-            {
-                ttlTime = dnsSHE->validityTime.Val - ((SYS_TMR_TickCountGet() - dnsSHE->tInsert)/SYS_TMR_TickCounterFrequencyGet());
-            }
-            // else TTL time will be default value of TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME
-            else
-            {
-                ttlTime = TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME;
-            }
+            pAnswers = dnsSHE->pAnsA;
+            nAnswers = dnsSHE->nAnsA;
+            rrSize = DNSS_ANSWER_RR_SIZE(sizeof(IPV4_ADDR));
         }
-        else
+#if defined(TCPIP_STACK_USE_IPV6)
+        else if(recordType.Val == TCPIP_DNSS_TYPE_AAAA)
+        {
+            pAnswers = dnsSHE->pAnsAAAA;
+            nAnswers = dnsSHE->nAnsAAAA;
+            rrSize = DNSS_ANSWER_RR_SIZE(sizeof(IPV6_ADDR));
+        }
+#endif
+        else if(!pDnsSrvDcpt->captivePortal)
         {
             return false;
         }
-    }
-#if defined(TCPIP_STACK_USE_IPV6)
-    else if(recordType.Val == TCPIP_DNSS_TYPE_AAAA)
-    {
-        if(pDnsSrvDcpt->replyWithBoardInfo)
+
+        // ttl time  w.r.t configured per entry
+        // if the validityTime is not equal to 0
+        if(dnsSHE->validityTime.Val != 0)
         {
-            resAnswerRRs = 1;
-            ttlTime = TCPIP_DNSS_TTL_TIME;
+            ttlTime = dnsSHE->validityTime.Val - ((SYS_TMR_TickCountGet() - dnsSHE->tInsert)/SYS_TMR_TickCounterFrequencyGet());
+            ttlPatch = true;
         }
-        else if(hE != 0)
+        // else the TTL time of the templates: TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME
+    }
+    else
+    {   // answer with the board address
+        // the other record types get an empty answer
+        if(recordType.Val == TCPIP_DNSS_TYPE_A)
         {
-            if((dnsHeader->wAnswerRRs.Val == 0) || (dnsHeader->wAnswerRRs.Val > dnsSHE->nIPv6Entries))
-            {
-            // all the available IPv6 address entries
-                resAnswerRRs = dnsSHE->nIPv6Entries;
-            }
-            else  // only limited entries
-            {
-                resAnswerRRs = dnsHeader->wAnswerRRs.Val;
-            }
-             // ttl time  w.r.t configured per entry
-            // if the validityTime is not equal to 0
-            if(dnsSHE->validityTime.Val != 0)
-            {
-                ttlTime = dnsSHE->validityTime.Val - ((SYS_TMR_TickCountGet() - dnsSHE->tInsert)/SYS_TMR_TickCounterFrequencyGet());
-            }
-            // else ttl time will be default value of TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME
-            else
-            {
-                ttlTime = TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME;
+            if(pDnsSrvDcpt->boardAddress.Val != pNet->netIPAddr.Val)
+            {   // rebuild the board answer
+                pDnsSrvDcpt->boardAddress.Val = pNet->netIPAddr.Val;
+                _DNSSAnswerPut(pDnsSrvDcpt->boardAnsA, TCPIP_DNSS_TYPE_A, TCPIP_DNSS_TTL_TIME, pDnsSrvDcpt->boardAddress.v, sizeof(IPV4_ADDR));
             }
+            pAnswers = pDnsSrvDcpt->boardAnsA;
+            nAnswers = 1;
+            rrSize = DNSS_ANSWER_RR_SIZE(sizeof(IPV4_ADDR));
         }
-        else
+#if defined(TCPIP_STACK_USE_IPV6)
+        else if(recordType.Val == TCPIP_DNSS_TYPE_AAAA)
         {
-            return false;
+            pIpv6Config = TCPIP_IPV6_InterfaceConfigGet(pNet);
+            addressPointer = (IPV6_ADDR_STRUCT *)pIpv6Config->listIpv6UnicastAddresses.head;
+            if(addressPointer != 0)
+            {   // only one IPv6 uni-cast address
+                _DNSSAnswerPut(boardAnsAAAA, TCPIP_DNSS_TYPE_AAAA, TCPIP_DNSS_TTL_TIME, addressPointer->address.v, sizeof(IPV6_ADDR));
+                pAnswers = boardAnsAAAA;
+                nAnswers = 1;
+                rrSize = DNSS_ANSWER_RR_SIZE(sizeof(IPV6_ADDR));
+            }
         }
-    }
 #endif
-    offset = 0xC00C; // that is the location at 0x0c ( 12) DNS packet compression RFC 1035
-    servTxMsgSize = sizeof(DNSS_HEADER)         // DNS header
-                    + countWithLen+2+2;  // Query hostname + type + class
-    if(recordType.Val == TCPIP_DNSS_TYPE_A)
+    }
+
+    // update Answer field
+    // If the client Query answer is zero, then Response will have all the answers which is present in the cache
+    // else if the client query answer count is more than the available answer counts  of the cache, then Answer RRs should
+    // be the value of available entries in the cache , else if only the limited Answer RRs
+    if((dnsHeader->wAnswerRRs.Val == 0) || (dnsHeader->wAnswerRRs.Val > nAnswers))
     {
-        // offset + record type+class+ttl+ip type+size of IP address * number of answers present in the HASH table
-        servTxMsgSize += resAnswerRRs*(2+2+2+4+2+sizeof(IPV4_ADDR));
+        resAnswerRRs = nAnswers;
     }
-#if defined(TCPIP_STACK_USE_IPV6)
-    else if(recordType.Val == TCPIP_DNSS_TYPE_AAAA)
+    else
     {
-        // offset + record type+class+ttl+ip type+size of IP address * number of answers present ih HASH table
-        servTxMsgSize += resAnswerRRs*(2+2+2+4+2+sizeof(IPV6_ADDR));
+        resAnswerRRs = dnsHeader->wAnswerRRs.Val;
     }
-#endif
+
+    servTxMsgSize = sizeof(DNSS_HEADER)         // DNS header
+                    + countWithLen+2+2          // Query hostname + type + class
+                    + resAnswerRRs * rrSize;    // answers
     // check that we can transmit a DNS response packet
     if(!TCPIP_UDP_TxPutIsReady(s, servTxMsgSize))
     {
         TCPIP_UDP_OptionsSet(s, UDP_OPTION_TX_BUFF, (void*)(unsigned int)servTxMsgSize);
         return false;
     }
-     //this will put the start pointer at the beginning of the TX buffer
-    TCPIP_UDP_TxOffsetSet(s,0,false);
 
-    //Get the write pointer:
-    txbuf = TCPIP_UDP_TxPointerGet(s);
-    if(txbuf == 0)
-    {
-       return false;
-    }
-    txBufPos = 0;
-    // Write DNS Server response packet
+    pResp = pDnsSrvDcpt->pResponse;
     // Transaction ID
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsHeader->wTransactionID.v[1]);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsHeader->wTransactionID.v[0]);
-
-    if(dnsHeader->wFlags.Val & 0x0100)
-    {
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x81); // Message is a response with recursion desired
-    }
-    else
-    {
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x80); // Message is a response without recursion desired flag set
-    }
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x80); // Recursion available
-
-    // Question
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsHeader->wQuestions.v[1]);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsHeader->wQuestions.v[0]);
-
+    *pResp++ = dnsHeader->wTransactionID.v[1];
+    *pResp++ = dnsHeader->wTransactionID.v[0];
+    // Message is a response, with the recursion desired flag of the query
+    *pResp++ = (dnsHeader->wFlags.Val & 0x0100) ? 0x81 : 0x80;
+    *pResp++ = 0x80; // Recursion available
+    // Question: only the first one is answered
+    *pResp++ = 0;
+    *pResp++ = 1;
     // Answer
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,resAnswerRRs>>8&0xFF);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,resAnswerRRs&0xFF);
-
+    *pResp++ = (uint8_t)(resAnswerRRs >> 8);
+    *pResp++ = (uint8_t)resAnswerRRs;
     // send Authority and Additional RRs as 0 , It will change latter 
     // when we support Authentication and Additional DNS info
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,0);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,0);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,0);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,0);
-    // Prepare all the queries
-    for(hostNamePos=0;hostNamePos<countWithLen;hostNamePos++)
+    *pResp++ = 0;
+    *pResp++ = 0;
+    *pResp++ = 0;
+    *pResp++ = 0;
+    // Question echo: name, record type, class
+    memcpy(pResp, hostNameWithLen, countWithLen);
+    pResp += countWithLen;
+    *pResp++ = recordType.v[1];
+    *pResp++ = recordType.v[0];
+    *pResp++ = 0x00;
+    *pResp++ = 0x01;
+
+    if(resAnswerRRs != 0)
     {
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,hostNameWithLen[hostNamePos]);
+        memcpy(pResp, pAnswers, resAnswerRRs * rrSize);
+        if(ttlPatch)
+        {   // the entry expires: patch the TTLs
+            pTtl = pResp + DNSS_ANSWER_RR_TTL_OFFSET;
+            for(count = 0; count < resAnswerRRs; count++, pTtl += rrSize)
+            {
+                pTtl[0] = (uint8_t)(ttlTime >> 24);
+                pTtl[1] = (uint8_t)(ttlTime >> 16);
+                pTtl[2] = (uint8_t)(ttlTime >> 8);
+                pTtl[3] = (uint8_t)ttlTime;
+            }
+        }
     }
+
+     //this will put the start pointer at the beginning of the TX buffer
+    TCPIP_UDP_TxOffsetSet(s,0,false);
+    // Transmit all the server bytes
+    TCPIP_UDP_ArrayPut(s, pDnsSrvDcpt->pResponse, servTxMsgSize);
+    TCPIP_UDP_Flush(s);
+    return true;
+}
+
+// writes an answer RR for the question name; returns the RR size
+static uint16_t _DNSSAnswerPut(uint8_t* pBuff, uint16_t recordType, uint32_t ttlTime, const uint8_t* pAdd, uint16_t addSize)
+{
+    // Put Host name Pointer As per RFC1035 DNS compression
+    *pBuff++ = (uint8_t)(DNSS_QUESTION_NAME_POINTER >> 8);
+    *pBuff++ = (uint8_t)DNSS_QUESTION_NAME_POINTER;
     // Record Type
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,recordType.v[1]);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,recordType.v[0]);
+    *pBuff++ = (uint8_t)(recordType >> 8);
+    *pBuff++ = (uint8_t)recordType;
     // Class
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x00);
-    TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x01);
+    *pBuff++ = 0x00;
+    *pBuff++ = 0x01;
+    // TTL
+    *pBuff++ = (uint8_t)(ttlTime >> 24);
+    *pBuff++ = (uint8_t)(ttlTime >> 16);
+    *pBuff++ = (uint8_t)(ttlTime >> 8);
+    *pBuff++ = (uint8_t)ttlTime;
+    // Data length and address
+    *pBuff++ = (uint8_t)(addSize >> 8);
+    *pBuff++ = (uint8_t)addSize;
+    memcpy(pBuff, pAdd, addSize);
+
+    return DNSS_ANSWER_RR_SIZE(addSize);
+}
+
+// builds the answer templates of a cache entry from its addresses
+// The removed addresses are 0 and are skipped.
+static void _DNSSAnswersBuild(DNSS_HASH_ENTRY* dnsSHE)
+{
+    int ix;
+    uint8_t* pRR;
+    DNSS_DCPT* pDnsSDcpt = &gDnsSrvDcpt;
+#if defined(TCPIP_STACK_USE_IPV6)
+    const IPV6_ADDR ipv6_addr_unspecified = {{0}};
+#endif
 
-    // Prepare Answer for all the answers
-    for(count=0;count <resAnswerRRs;count++)
+    dnsSHE->pip4Address = (IPV4_ADDR *)dnsSHE->memblk;
+    pRR = dnsSHE->pAnsA;
+    dnsSHE->nAnsA = 0;
+    for(ix = 0; ix < pDnsSDcpt->IPv4EntriesPerDNSName && dnsSHE->nAnsA < dnsSHE->nIPv4Entries; ix++)
     {
-        // Put Host name Pointer As per RFC1035 DNS compression
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,offset>>8 &0xFF);
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,offset&0xFF);
-
-        // Record Type
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,recordType.v[1]);
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,recordType.v[0]);
-        // Class
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x00);
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x01);
-        // TTL
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,ttlTime>>24&0xFF);
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,ttlTime>>16&0xFF);
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,ttlTime>>8&0xFF);
-        TCPIP_DNSS_DataPut(txbuf,txBufPos++,ttlTime&0xFF);
-        if(recordType.Val == TCPIP_DNSS_TYPE_A)
+        if(dnsSHE->pip4Address[ix].Val != 0)
         {
-            // Length for TYPE_A
-            TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x00);
-            TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x04);
-            if(hE != 0)
-            {
-                dnsSHE->pip4Address = (IPV4_ADDR *)pMemoryBlock;
-                if(dnsSHE->pip4Address == 0)
-                {
-                   return false;
-                }
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsSHE->pip4Address[count].v[0]);
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsSHE->pip4Address[count].v[1]);
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsSHE->pip4Address[count].v[2]);
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsSHE->pip4Address[count].v[3]);
-            }
-            else
-            {
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,pNet->netIPAddr.v[0]);
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,pNet->netIPAddr.v[1]);
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,pNet->netIPAddr.v[2]);
-                TCPIP_DNSS_DataPut(txbuf,txBufPos++,pNet->netIPAddr.v[3]);
-            }
+            pRR += _DNSSAnswerPut(pRR, TCPIP_DNSS_TYPE_A, TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME, dnsSHE->pip4Address[ix].v, sizeof(IPV4_ADDR));
+            dnsSHE->nAnsA++;
         }
+    }
+
 #if defined(TCPIP_STACK_USE_IPV6)
-        else if(recordType.Val == TCPIP_DNSS_TYPE_AAAA)
+    dnsSHE->pip6Address = (IPV6_ADDR *)(dnsSHE->memblk + pDnsSDcpt->IPv4EntriesPerDNSName*sizeof(IPV4_ADDR));
+    pRR = dnsSHE->pAnsAAAA;
+    dnsSHE->nAnsAAAA = 0;
+    for(ix = 0; ix < pDnsSDcpt->IPv6EntriesPerDNSName && dnsSHE->nAnsAAAA < dnsSHE->nIPv6Entries; ix++)
+    {
+        if(memcmp(dnsSHE->pip6Address[ix].v, ipv6_addr_unspecified.v, sizeof(IPV6_ADDR)) != 0)
         {
-            // Length for TYPE_A
-            TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x00);     // Data Length 16 bytes
-            TCPIP_DNSS_DataPut(txbuf,txBufPos++,0x10);  // sizeof (IPV6_ADDR)
-            if(hE != 0)
-            {
-                dnsSHE->pip6Address = (IPV6_ADDR *)(pMemoryBlock+pDnsSrvDcpt->IPv4EntriesPerDNSName*sizeof(IPV4_ADDR));
-                if(dnsSHE->pip6Address == 0)
-                {
-                   return false;
-                }
-                for(i=0;i<sizeof(IPV6_ADDR);i++)
-                {
-                    TCPIP_DNSS_DataPut(txbuf,txBufPos++,dnsSHE->pip6Address[count].v[i]);
-                }
-            }
-            else
-            {
-                pIpv6Config = TCPIP_IPV6_InterfaceConfigGet(pNet);
-                addressPointer = (IPV6_ADDR_STRUCT *)pIpv6Config->listIpv6UnicastAddresses.head;
-                // only one IPv6 uni-cast address
-                for(i=0;i<sizeof(IPV6_ADDR);i++)
-                {
-                    TCPIP_DNSS_DataPut(txbuf,txBufPos++,addressPointer->address.v[i]);
-                }
-            }
+            pRR += _DNSSAnswerPut(pRR, TCPIP_DNSS_TYPE_AAAA, TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME, dnsSHE->pip6Address[ix].v, sizeof(IPV6_ADDR));
+            dnsSHE->nAnsAAAA++;
         }
-#endif
     }
-    // Transmit all the server bytes
-    //TCPIP_UDP_ArrayPut(s,txbuf,txBufPos);
-    // Once it is completed writing into the buffer, you need to update the Tx offset again,
-    // because the socket flush function calculates how many bytes are in the buffer using the current write pointer:
-    TCPIP_UDP_TxOffsetSet(s,txBufPos, false);
-    TCPIP_UDP_Flush(s);
-    return true;
+#endif
+
+    dnsSHE->hEntry.flags.value |= DNSS_FLAG_ANSWERS_VALID;
 }
 
 #if (TCPIP_STACK_DOWN_OPERATION != 0)
@@ -575,6 +581,11 @@ void TCPIP_DNSS_Deinitialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl)
                 {
                     TCPIP_UDP_Close(pDnsSDcpt->dnsSrvSocket);
                 }
+                if(pDnsSDcpt->pResponse != 0)
+                {
+                    TCPIP_HEAP_Free(pDnsSDcpt->memH, pDnsSDcpt->pResponse);
+                    pDnsSDcpt->pResponse = 0;
+                }
             }
             // remove all the cache entries
             _DNSSRemoveCacheEntries();
@@ -819,6 +830,7 @@ static  TCPIP_DNSS_RESULT  _DNSSUpdateHashEntry( DNSS_HASH_ENTRY *dnsSHE,TCPIP_D
     }
 #endif
     dnsSHE->validityTime = dnssCacheEntry.entryTimeout;
+    dnsSHE->hEntry.flags.value &= ~DNSS_FLAG_ANSWERS_VALID;
     
     return TCPIP_DNSS_RES_OK;
 }
@@ -842,7 +854,7 @@ static  TCPIP_DNSS_RESULT  _DNSSSetHashEntry( DNSS_HASH_ENTRY_FLAGS newFlags,TCP
     }
     dnsSHE = (DNSS_HASH_ENTRY*)hE;
     pMemoryBlock = dnsSHE->memblk;
-    dnsSHE->hEntry.flags.value &= ~DNSS_FLAG_ENTRY_VALID_MASK;
+    dnsSHE->hEntry.flags.value &= ~(DNSS_FLAG_ENTRY_VALID_MASK | DNSS_FLAG_ANSWERS_VALID);
     dnsSHE->hEntry.flags.value |= newFlags;
     dnsSHE->memblk = pMemoryBlock;
     dnsSHE->recordType = dnssCacheEntry.recordType;
@@ -945,6 +957,7 @@ TCPIP_DNSS_RESULT TCPIP_DNSS_CacheEntryRemove(const char* name, IP_ADDRESS_TYPE
     {
         return TCPIP_DNSS_RES_NO_ENTRY;
     }
+    dnsSHE->hEntry.flags.value &= ~DNSS_FLAG_ANSWERS_VALID;
 
    // Free Hash entry and free the allocated memory for this HostName if there
    // is no IPv4 and IPv6 entry
@@ -962,15 +975,8 @@ TCPIP_DNSS_RESULT TCPIP_DNSS_CacheEntryRemove(const char* name, IP_ADDRESS_TYPE
 
 static uint8_t TCPIP_DNSS_DataGet(uint16_t pos)
 {
-	return (uint8_t)(dnsSrvRecvByte[pos]);
-}
-
-static bool TCPIP_DNSS_DataPut(uint8_t * buf,uint32_t pos,uint8_t val)
-{
-    if(buf == 0)
-        return false;
-    buf[pos] = val;
-    return true;
+    // past the received data reads as the name end
+	return pos < gDnsSrvRecvLen ? dnsSrvRecvByte[pos] : 0;
 }
 
 void TCPIP_DNSS_Task(void)
@@ -1016,7 +1022,6 @@ static void TCPIP_DNSS_Process(void)
     TCPIP_NET_IF* pNet=NULL;
     DNSS_HEADER DNSServHeader;
     uint32_t recvLen=0;
-    static TCPIP_UINT16_VAL transactionId;
   
     s = gDnsSrvDcpt.dnsSrvSocket;
 
@@ -1028,11 +1033,15 @@ static void TCPIP_DNSS_Process(void)
         {
            break;
         }
-        if(recvLen > (sizeof(dnsSrvRecvByte)-1))
+        if(recvLen < sizeof(DNSS_HEADER))
         {
             TCPIP_UDP_Discard(s);
             continue;
         }
+        if(recvLen > sizeof(dnsSrvRecvByte))
+        {   // only the header and the question are needed; the additional records (EDNS) are ignored
+            recvLen = sizeof(dnsSrvRecvByte);
+        }
         gDnsSrvBytePos = 0;
         TCPIP_UDP_SocketInfoGet(s, &udpSockInfo);
         pNet = (TCPIP_NET_IF*)udpSockInfo.hNet;
@@ -1043,24 +1052,12 @@ static void TCPIP_DNSS_Process(void)
             continue;
         }
         // Read DNS header
-        TCPIP_UDP_ArrayGet(s, (uint8_t*)dnsSrvRecvByte, recvLen);
+        gDnsSrvRecvLen = TCPIP_UDP_ArrayGet(s, (uint8_t*)dnsSrvRecvByte, recvLen);
         // Assign DNS transaction ID
+        // A retransmitted query has the same ID and is answered again:
+        // the previous response may have been lost.
         DNSServHeader.wTransactionID.v[1] = dnsSrvRecvByte[gDnsSrvBytePos++];
         DNSServHeader.wTransactionID.v[0] = dnsSrvRecvByte[gDnsSrvBytePos++];
-        // To make a response for a valid address and quicker one.
-        // this is used to make sure that we should not transmit same address response again and again for sometime.
-        // This will help to improve the throughput
-        //We are checking the previous transaction id and process the rx packet only when it is a new transaction id
-        // comparing to the previous one.
-        if(transactionId.Val != DNSServHeader.wTransactionID.Val)
-        {
-            transactionId.Val = DNSServHeader.wTransactionID.Val;
-        }
-        else
-        {
-            TCPIP_UDP_Discard(s);
-            continue;
-        }
         // Assign DNS wflags
         DNSServHeader.wFlags.v[1] = dnsSrvRecvByte[gDnsSrvBytePos++];
         DNSServHeader.wFlags.v[0] = dnsSrvRecvByte[gDnsSrvBytePos++];
@@ -1081,20 +1078,18 @@ static void TCPIP_DNSS_Process(void)
         if((DNSServHeader.wFlags.Val & 0x8000) == 0x8000u)
         {
             TCPIP_UDP_Discard(s);
-            break;
+            continue;
         }
         // Ignore this packet if there are no questions in it
         if(DNSServHeader.wQuestions.Val == 0u)
-        {
-            TCPIP_UDP_Discard(s);
-            break;
-        }
-        // send the DNS client query response
-        if(!_DNSS_SendResponse(&DNSServHeader,pNet))
         {
             TCPIP_UDP_Discard(s);
             continue;
         }
+        // send the DNS client query response
+        _DNSS_SendResponse(&DNSServHeader,pNet);
+        // done with this query, including the bytes not read
+        TCPIP_UDP_Discard(s);
     }
 }
 // returns true if the pIf can be selected for DNS traffic
@@ -1142,6 +1137,7 @@ static void _DNSCopyRXNameToTX(UDP_SOCKET s)
     uint16_t w;
     uint8_t i=0,j=0;
     uint8_t len;
+    int     nPointers = 0;
     //uint8_t data[64]={0};
     
     countWithDot=0;
@@ -1156,8 +1152,12 @@ static void _DNSCopyRXNameToTX(UDP_SOCKET s)
         // Check if this is a pointer, if so, get the remaining 8 bits and seek to the pointer value
         if((i & 0xC0u) == 0xC0u)
         {
-            ((uint8_t*)&w)[1] = i & 0x3F;
-            w = TCPIP_DNSS_DataGet(gDnsSrvBytePos++);
+            if(++nPointers > DNSS_NAME_MAX_POINTERS)
+            {   // pointer loop
+                countWithDot = 0;
+                return;
+            }
+            w = ((uint16_t)(i & 0x3F) << 8) | TCPIP_DNSS_DataGet(gDnsSrvBytePos++);
             gDnsSrvBytePos =  w;
             continue;
         }
@@ -1183,6 +1183,12 @@ static void _DNSCopyRXNameToTX(UDP_SOCKET s)
             return;
         }
 
+        if((countWithLen + len + 1) > TCPIP_DNSS_HOST_NAME_LEN)
+        {   // name too long
+            countWithDot = 0;
+            return;
+        }
+
         //UDPGetArray(s,data,len);
         for(j=0;j<len;j++)
         {
@@ -1193,11 +1199,6 @@ static void _DNSCopyRXNameToTX(UDP_SOCKET s)
         // update the hostNameWithLen with data 
             hostNameWithDot[countWithDot++] = i;
         }
-
-        if((countWithLen > TCPIP_DNSS_HOST_NAME_LEN) || (countWithDot > TCPIP_DNSS_HOST_NAME_LEN))
-        {
-            return;
-        }        
     }
 }
 
@@ -1272,6 +1273,20 @@ bool TCPIP_DNSS_Enable(TCPIP_NET_HANDLE hNet)
     return _DNSS_Enable(hNet, true);
 }
 
+bool TCPIP_DNSS_CaptivePortalSet(bool enable)
+{
+    DNSS_DCPT        *pDnsSDcpt;
+
+    pDnsSDcpt = &gDnsSrvDcpt;
+    if(pDnsSDcpt->dnssHashDcpt==NULL)
+    {
+        return false;
+    }
+
+    pDnsSDcpt->captivePortal = enable;
+    return true;
+}
+
 static bool _DNSS_Enable(TCPIP_NET_HANDLE hNet, bool checkIfUp)
 {
     DNSS_DCPT        *pDnsSDcpt;
@@ -1446,6 +1461,7 @@ size_t TCPIP_OAHASH_DNSS_ProbeHash(OA_HASH_DCPT* pOH, const void* key)
 bool TCPIP_DNSS_IsEnabled(TCPIP_NET_HANDLE hNet){return false;}
 bool TCPIP_DNSS_Enable(TCPIP_NET_HANDLE hNet){return false;}
 bool TCPIP_DNSS_Disable(TCPIP_NET_HANDLE hNet){return false;}
+bool TCPIP_DNSS_CaptivePortalSet(bool enable){return false;}
 
 
 #endif //#if defined(TCPIP_STACK_USE_DNS_SERVER)
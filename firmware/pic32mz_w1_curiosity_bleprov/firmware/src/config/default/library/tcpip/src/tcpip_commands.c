@@ -111,6 +111,7 @@ typedef enum
     DNS_SERVICE_COMD_INFO,
     DNS_SERVICE_COMD_ENABLE_INTF,
     DNS_SERVICE_COMD_LOOKUP,
+    DNS_SERVICE_COMD_STATS,
     DNS_SERVICE_COMD_NONE,
 }DNS_SERVICE_COMD_TYPE;
 typedef struct 
@@ -223,6 +224,35 @@ static CMD_PKT_XTRACT_RES _CommandPktExtractMasks(int argc, char** argv, uint32_
 
 static SYS_CMD_DEVICE_NODE*   _pktHandlerCmdIo = 0;
 
+#if (_TCPIP_PKT_CAPTURE != 0)
+// the pcap stream is binary; it should not be mixed with the command console output
+#if !defined(TCPIP_PKT_CAPTURE_CONSOLE_INDEX)
+#define TCPIP_PKT_CAPTURE_CONSOLE_INDEX     1
+#endif
+
+typedef enum
+{
+    CMD_PKT_CAPTURE_OFF     = 0,    // no capture stream
+    CMD_PKT_CAPTURE_TCP,            // pcap stream on a TCP server socket
+    CMD_PKT_CAPTURE_UART,           // pcap stream on the console UART
+}CMD_PKT_CAPTURE_MODE;
+
+// the commands only request a mode
+// the capture task owns the socket/console and applies the request
+static volatile CMD_PKT_CAPTURE_MODE    _pktCapReqMode = CMD_PKT_CAPTURE_OFF;
+static volatile uint16_t                _pktCapReqCount;        // incremented for each new request
+static uint16_t                         _pktCapReqPort;
+static CMD_PKT_CAPTURE_MODE             _pktCapMode = CMD_PKT_CAPTURE_OFF;
+static uint16_t                         _pktCapReqApplied;      // last request applied
+static TCP_SOCKET                       _pktCapSkt = INVALID_SOCKET;
+static SYS_CONSOLE_HANDLE               _pktCapConsole;
+static bool                             _pktCapStreaming;       // a stream is in progress
+static TCPIP_PKT_PCAP_HDR               _pktCapHdr;
+static uint16_t                         _pktCapHdrOffset;       // bytes of _pktCapHdr already sent
+
+static void _CommandPktCapture(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
+
 // table with the module names for logger purposes
 // only basic modules supported
 static const char* _CommandPktLogModuleNames[] = 
@@ -249,6 +279,10 @@ static const char* _CommandPktLogModuleNames[] =
 static int _Command_PktInfo(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 #endif  // defined(TCPIP_PACKET_ALLOCATION_TRACE_ENABLE)
 
+#if (TCPIP_PKT_POOL_ENABLE != 0)
+static int _Command_PktPool(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+#endif  // (TCPIP_PKT_POOL_ENABLE != 0)
+
 #if defined(TCPIP_STACK_USE_INTERNAL_HEAP_POOL)
 static int _Command_HeapList(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 #endif  // defined(TCPIP_STACK_USE_INTERNAL_HEAP_POOL)
@@ -478,6 +512,9 @@ static const SYS_CMD_DESCRIPTOR    tcpipCmdTbl[]=
 #if defined(TCPIP_PACKET_ALLOCATION_TRACE_ENABLE)
     {"pktinfo",   (SYS_CMD_FNC)_Command_PktInfo,                ": Check PKT allocation"},
 #endif  // defined(TCPIP_PACKET_ALLOCATION_TRACE_ENABLE)
+#if (TCPIP_PKT_POOL_ENABLE != 0)
+    {"pktpool",     (SYS_CMD_FNC)_Command_PktPool,              ": Check PKT pools"},
+#endif  // (TCPIP_PKT_POOL_ENABLE != 0)
 #if defined(TCPIP_STACK_USE_INTERNAL_HEAP_POOL)
     {"heaplist",    (SYS_CMD_FNC)_Command_HeapList,             ": List heap"},
 #endif  // defined(TCPIP_STACK_USE_INTERNAL_HEAP_POOL)
@@ -771,6 +808,7 @@ static int _Command_DHCPLeaseInfo(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char**
     TCPIP_NET_HANDLE netH;
     TCPIP_DHCPS_LEASE_HANDLE  prevLease, nextLease;
     TCPIP_DHCPS_LEASE_ENTRY leaseEntry;
+    TCPIP_DHCPS_STATISTICS dhcpsStat;
     char   addrBuff[20];
     const void* cmdIoParam = pCmdIO->cmdIoParam;
 
@@ -806,12 +844,18 @@ static int _Command_DHCPLeaseInfo(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char**
             (*pCmdIO->pCmdApi->print)(cmdIoParam, "%s", addrBuff);
             TCPIP_Helper_IPAddressToString(&leaseEntry.ipAddress, addrBuff, sizeof(addrBuff));
             (*pCmdIO->pCmdApi->print)(cmdIoParam, "	%s ", addrBuff);
-            (*pCmdIO->pCmdApi->print)(cmdIoParam, "	%d Secs\r\n", leaseEntry.leaseTime/SYS_TMR_TickCounterFrequencyGet());
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "	%d Secs\r\n", leaseEntry.leaseTime);
 
             prevLease = nextLease;
         }
     }while(nextLease != 0);
 
+    if(TCPIP_DHCPS_StatisticsGet(&dhcpsStat, false))
+    {
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "Discovers: %d, offers: %d, acks: %d, naks: %d, pool full: %d\r\n", dhcpsStat.discovers, dhcpsStat.offers, dhcpsStat.acks, dhcpsStat.naks, dhcpsStat.poolFull);
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "Offer latency avg: %d ms, max: %d ms\r\n", dhcpsStat.offers ? dhcpsStat.offerLatencyTotal / dhcpsStat.offers : 0, dhcpsStat.offerLatencyMax);
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "Leases bound: %d, expired: %d, restored: %d\r\n", dhcpsStat.leasesBound, dhcpsStat.leasesExpired, dhcpsStat.leasesRestored);
+    }
 
     return true;
 
@@ -939,6 +983,7 @@ static int _CommandDhcpOptions(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** arg
             {
                 (*pCmdIO->pCmdApi->print)(cmdIoParam, "DHCP lease start: %d, duration: %ds\r\n", dhcpInfo.leaseStartTime, dhcpInfo.leaseDuration);
                 (*pCmdIO->pCmdApi->print)(cmdIoParam, "DHCP renew time: %d, rebind time: %d\r\n", dhcpInfo.renewTime, dhcpInfo.rebindTime);
+                (*pCmdIO->pCmdApi->print)(cmdIoParam, "DHCP time to bound: %lu ms, %s\r\n", dhcpInfo.bindTime, dhcpInfo.rebootBound ? "init-reboot" : "discover");
 
                 TCPIP_Helper_IPAddressToString(&dhcpInfo.dhcpAddress, addBuff, sizeof(addBuff));
                 (*pCmdIO->pCmdApi->print)(cmdIoParam, "DHCP address: %s\r\n", addBuff);
@@ -1589,11 +1634,13 @@ static int _Command_DNS_Service(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** ar
                 {"on",          DNS_SERVICE_COMD_ENABLE_INTF},
                 {"off",         DNS_SERVICE_COMD_ENABLE_INTF},
                 {"lookup",      DNS_SERVICE_COMD_LOOKUP},
+                {"stats",       DNS_SERVICE_COMD_STATS},
             };
     int i=0;
+    TCPIP_DNS_CLIENT_STATISTICS dnsStat;
 
     if (argc < 2) {
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: dnsc <del/info/on/off/lookup> \r\n");
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: dnsc <del/info/on/off/lookup/stats> \r\n");
         return false;
     }
     for(i=0;i<(sizeof(dnssComnd)/sizeof(DNSS_COMMAND_MAP));i++)
@@ -1660,6 +1707,21 @@ static int _Command_DNS_Service(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** ar
         case DNS_SERVICE_COMD_INFO:
             _Command_ShowDNSResolvedInfo(pCmdIO,argc,argv);
             break;
+        case DNS_SERVICE_COMD_STATS:
+            if (argc > 3 || (argc == 3 && strcmp(argv[2], "clr") != 0)) {
+                (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: dnsc stats <clr> \r\n");
+                (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Help: display the DNS cache statistics; clr - clear them after display \r\n");
+                return false;
+            }
+            if(TCPIP_DNS_ClientStatisticsGet(&dnsStat, argc == 3) != TCPIP_DNS_RES_OK)
+            {
+                (*pCmdIO->pCmdApi->msg)(cmdIoParam, "DNS Client is down!\r\n");
+                return false;
+            }
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "DNS cache - hits: %lu, misses: %lu, negative hits: %lu\r\n", dnsStat.cacheHits, dnsStat.cacheMisses, dnsStat.negativeHits);
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "DNS cache - prefetches: %lu, name errors: %lu, resolved: %lu\r\n", dnsStat.prefetches, dnsStat.nameErrors, dnsStat.nResolved);
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "DNS latency - avg: %lu ms, max: %lu ms\r\n", dnsStat.nResolved != 0 ? dnsStat.latencyTotal / dnsStat.nResolved : 0, dnsStat.latencyMax);
+            break;
         default:
             (*pCmdIO->pCmdApi->print)(cmdIoParam, "Invalid Input Command :[ %s ] \r\n", argv[1]);
             return false;
@@ -1769,6 +1831,10 @@ static int _Command_ShowDNSResolvedInfo(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, c
         {
             entryPresent = true;
             (*pCmdIO->pCmdApi->print)(cmdIoParam, "Hostname = %s \r\nTimeout = %d \r\n", hostName, dnsQuery.ttlTime);
+            if(dnsQuery.status == TCPIP_DNS_RES_NO_NAME_ENTRY)
+            {
+                (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Name error (cached)\r\n");
+            }
             if(dnsQuery.nIPv4ValidEntries > 0)
             {
                 for(ix = 0; ix < dnsQuery.nIPv4ValidEntries; ix++)
@@ -3524,6 +3590,7 @@ static void _CommandArp(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
     char        addrBuff[20];
     size_t      arpEntries, ix;
     TCPIP_ARP_ENTRY_QUERY arpQuery;
+    TCPIP_ARP_STATISTICS arpStat;
     
     const void* cmdIoParam = pCmdIO->cmdIoParam;
 
@@ -3568,6 +3635,14 @@ static void _CommandArp(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
             return;
         }
 
+        if (strcmp(argv[2], "stat") == 0)
+        {   // show the cache statistics
+            TCPIP_ARP_StatisticsGet(netH, &arpStat, argc > 3 && strcmp(argv[3], "clr") == 0);
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "arp: hits: %lu, misses: %lu\r\n", arpStat.cacheHits, arpStat.cacheMisses);
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "arp: expired: %lu, purged: %lu, refreshed: %lu\r\n", arpStat.entriesExpired, arpStat.entriesPurged, arpStat.refreshRequests);
+            return;
+        }
+
 
         if (argc < 4 || !TCPIP_Helper_StringToIPAddress(argv[3], &ipAddr))
         {
@@ -3636,6 +3711,7 @@ static void _CommandArp(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
     }
 
     (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: arp interface list\r\n");
+    (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: arp interface stat <clr>\r\n");
     (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: arp interface req/query/del ipAddr\r\n");
     (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Ex: arp eth0 req 192.168.1.105 \r\n");
 }
@@ -4338,6 +4414,8 @@ static void _Command_TcpInfo(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
                     ix, sktInfo.addressType, sktInfo.remotePort, sktInfo.localPort, sktInfo.flags);
             (*pCmdIO->pCmdApi->print)(cmdIoParam, "\trxSize: %d, txSize: %d, state: %d, rxPend: %d, txPend: %d\r\n",
                     sktInfo.rxSize, sktInfo.txSize, sktInfo.state, sktInfo.rxPending, sktInfo.txPending);
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "\tsrtt: %u ms, rttVar: %u ms, rto: %u ms, rtoCount: %u, fastRtx: %u\r\n",
+                    (unsigned int)sktInfo.srtt, (unsigned int)sktInfo.rttVar, (unsigned int)sktInfo.rto, (unsigned int)sktInfo.rtoCount, (unsigned int)sktInfo.fastRtxCount);
         }
     }
 }
@@ -4393,6 +4471,11 @@ static int _Command_PktLog(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
         (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: plog persist and/or none/all/modId modId... <clr> - Updates the persist mask for the module list\r\n");
         (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: plog module and/or none/all/modId modId... <clr> - Updates the log mask for the module list\r\n");
         (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: plog socket and/or none/all/sktIx sktIx... or <clr> - Updates the log mask for the socket numbers\r\n");
+#if (_TCPIP_PKT_CAPTURE != 0)
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: plog capture tcp <port> <snaplen> - Captures the frames matching the log masks as a pcap stream on a TCP port\r\n");
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: plog capture uart <snaplen> - Captures the frames matching the log masks as a pcap stream on a dedicated console UART\r\n");
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: plog capture stop/info - Stops the capture/Displays the capture counters\r\n");
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
         return false;
     }
 
@@ -4416,6 +4499,12 @@ static int _Command_PktLog(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
     {
         _CommandPktLogType(pCmdIO, argc, argv);
     }
+#if (_TCPIP_PKT_CAPTURE != 0)
+    else if(strcmp(argv[1], "capture") == 0)
+    {
+        _CommandPktCapture(pCmdIO, argc, argv);
+    }
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
     else
     {
         _CommandPktLogMask(pCmdIO, argc, argv);
@@ -4954,6 +5043,195 @@ static void _CommandPktLogDefHandler(TCPIP_STACK_MODULE moduleId, const TCPIP_PK
     }
 }
 
+#if (_TCPIP_PKT_CAPTURE != 0)
+static void _CommandPktCapture(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
+{
+    // "Usage: plog capture tcp <port> <snaplen>"
+    // "Usage: plog capture uart <snaplen>"
+    // "Usage: plog capture stop/info"
+    const void* cmdIoParam = pCmdIO->cmdIoParam;
+    TCPIP_PKT_CAPTURE_INFO capInfo;
+    int port = 0;
+    int snapLen = 0;
+
+    while(argc >= 3)
+    {
+        if(strcmp(argv[2], "info") == 0)
+        {
+            bool isActive = TCPIP_PKT_CaptureGetInfo(&capInfo);
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "pktcap: %s, snaplen: %d, frames: %d, truncated: %d, drops: %d, pending: %d\r\n", isActive ? "on" : "off", capInfo.snapLen, capInfo.nFrames, capInfo.nTruncated, capInfo.nDrops, capInfo.nPending);
+            return;
+        }
+
+        if(strcmp(argv[2], "stop") == 0)
+        {
+            TCPIP_PKT_CaptureStop();
+            _pktCapReqMode = CMD_PKT_CAPTURE_OFF;
+            (*pCmdIO->pCmdApi->msg)(cmdIoParam, "pktcap: Stopped\r\n");
+            return;
+        }
+
+        if(strcmp(argv[2], "tcp") == 0)
+        {
+            if(argc < 4 || (port = atoi(argv[3])) <= 0 || port > 0xffff)
+            {
+                break;
+            }
+            if(argc > 4)
+            {
+                snapLen = atoi(argv[4]);
+            }
+        }
+        else if(strcmp(argv[2], "uart") == 0)
+        {
+            if(TCPIP_PKT_CAPTURE_CONSOLE_INDEX == SYS_CONSOLE_INDEX_0 || SYS_CONSOLE_HandleGet(TCPIP_PKT_CAPTURE_CONSOLE_INDEX) == SYS_CONSOLE_HANDLE_INVALID)
+            {
+                (*pCmdIO->pCmdApi->print)(cmdIoParam, "pktcap: Console %d is not available for the capture\r\n", TCPIP_PKT_CAPTURE_CONSOLE_INDEX);
+                return;
+            }
+            if(argc > 3)
+            {
+                snapLen = atoi(argv[3]);
+            }
+        }
+        else
+        {
+            break;
+        }
+
+        if(snapLen < 0 || snapLen > 0xffff || !TCPIP_PKT_CaptureStart(snapLen, port))
+        {
+            (*pCmdIO->pCmdApi->msg)(cmdIoParam, "pktcap: Invalid snap length\r\n");
+            return;
+        }
+
+        _pktCapReqPort = port;
+        _pktCapReqMode = port != 0 ? CMD_PKT_CAPTURE_TCP : CMD_PKT_CAPTURE_UART;
+        _pktCapReqCount++;
+        TCPIP_PKT_CaptureGetInfo(&capInfo);
+        if(port != 0)
+        {
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "pktcap: Started on TCP port %d, snaplen: %d\r\n", port, capInfo.snapLen);
+        }
+        else
+        {
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "pktcap: Started on console %d, snaplen: %d\r\n", TCPIP_PKT_CAPTURE_CONSOLE_INDEX, capInfo.snapLen);
+        }
+        return;
+    }
+
+    (*pCmdIO->pCmdApi->msg)(cmdIoParam, "pktcap: Unknown parameter\r\n");
+}
+
+// closes the current capture stream
+static void _CommandPktCaptureClose(void)
+{
+    if(_pktCapSkt != INVALID_SOCKET)
+    {
+        TCPIP_TCP_Close(_pktCapSkt);
+        _pktCapSkt = INVALID_SOCKET;
+    }
+    _pktCapMode = CMD_PKT_CAPTURE_OFF;
+    _pktCapStreaming = false;
+}
+
+// sends the capture stream data; returns the number of bytes sent
+static size_t _CommandPktCaptureSend(const void* pData, size_t nBytes)
+{
+    ssize_t nSent;
+
+    if(_pktCapMode == CMD_PKT_CAPTURE_TCP)
+    {
+        size_t txSpace = TCPIP_TCP_PutIsReady(_pktCapSkt);
+        return TCPIP_TCP_ArrayPut(_pktCapSkt, pData, nBytes < txSpace ? nBytes : txSpace);
+    }
+
+    nSent = SYS_CONSOLE_Write(_pktCapConsole, pData, nBytes);
+    return nSent > 0 ? (size_t)nSent : 0;
+}
+
+void TCPIP_COMMAND_CaptureTask(void)
+{
+    uint16_t reqCount = _pktCapReqCount;
+    CMD_PKT_CAPTURE_MODE reqMode = _pktCapReqMode;
+    const uint8_t* pData;
+    size_t nBytes, nSent;
+
+    if(reqMode != _pktCapMode || reqCount != _pktCapReqApplied)
+    {   // apply the new request
+        _CommandPktCaptureClose();
+        _pktCapReqApplied = reqCount;
+        if(reqMode == CMD_PKT_CAPTURE_TCP)
+        {
+            _pktCapSkt = TCPIP_TCP_ServerOpen(IP_ADDRESS_TYPE_IPV4, _pktCapReqPort, 0);
+            if(_pktCapSkt == INVALID_SOCKET)
+            {
+                SYS_CONSOLE_MESSAGE("pktcap: Failed to open the TCP socket\r\n");
+                TCPIP_PKT_CaptureStop();
+                _pktCapReqMode = CMD_PKT_CAPTURE_OFF;
+                return;
+            }
+        }
+        else if(reqMode == CMD_PKT_CAPTURE_UART)
+        {
+            _pktCapConsole = SYS_CONSOLE_HandleGet(TCPIP_PKT_CAPTURE_CONSOLE_INDEX);
+        }
+        _pktCapMode = reqMode;
+    }
+
+    if(_pktCapMode == CMD_PKT_CAPTURE_OFF)
+    {
+        return;
+    }
+
+    if(_pktCapMode == CMD_PKT_CAPTURE_TCP)
+    {
+        if(TCPIP_TCP_WasDisconnected(_pktCapSkt))
+        {   // back to listening
+            TCPIP_TCP_Disconnect(_pktCapSkt);
+        }
+
+        if(!TCPIP_TCP_IsConnected(_pktCapSkt))
+        {
+            _pktCapStreaming = false;
+            return;
+        }
+    }
+
+    if(!_pktCapStreaming)
+    {   // new stream; start on a record boundary
+        TCPIP_PKT_CaptureDiscard();
+        TCPIP_PKT_CaptureHeaderGet(&_pktCapHdr);
+        _pktCapHdrOffset = 0;
+        _pktCapStreaming = true;
+    }
+
+    if(_pktCapHdrOffset < sizeof(_pktCapHdr))
+    {
+        _pktCapHdrOffset += _CommandPktCaptureSend((const uint8_t*)&_pktCapHdr + _pktCapHdrOffset, sizeof(_pktCapHdr) - _pktCapHdrOffset);
+        if(_pktCapHdrOffset < sizeof(_pktCapHdr))
+        {
+            return;
+        }
+    }
+
+    while((nBytes = TCPIP_PKT_CapturePeek(&pData)) != 0)
+    {
+        nSent = _CommandPktCaptureSend(pData, nBytes);
+        TCPIP_PKT_CaptureConsume(nSent);
+        if(nSent < nBytes)
+        {   // no more room
+            break;
+        }
+    }
+
+    if(_pktCapMode == CMD_PKT_CAPTURE_TCP)
+    {
+        TCPIP_TCP_Flush(_pktCapSkt);
+    }
+}
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
+
 
 #endif  // (TCPIP_PACKET_LOG_ENABLE)
 
@@ -4990,6 +5268,36 @@ static int _Command_PktInfo(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
 }
 #endif  // defined(TCPIP_PACKET_ALLOCATION_TRACE_ENABLE)
 
+#if (TCPIP_PKT_POOL_ENABLE != 0)
+static int _Command_PktPool(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
+{
+    int  ix;
+    TCPIP_PKT_POOL_ENTRY poolEntry;
+    TCPIP_PKT_POOL_INFO  poolInfo;
+
+    const void* cmdIoParam = pCmdIO->cmdIoParam;
+
+    TCPIP_PKT_PoolGetEntriesNo(&poolInfo);
+
+    (*pCmdIO->pCmdApi->print)(cmdIoParam, "PKT pools: %d, oversize: %d\r\n", poolInfo.nEntries, poolInfo.nOversize);
+
+    for(ix = 0; ix < poolInfo.nEntries; ix++)
+    {
+        if(TCPIP_PKT_PoolGetEntry(ix, &poolEntry))
+        {
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "\tsize: %4d, blocks: %3d, free: %3d, minFree: %3d, allocs: %8d, misses: %6d\r\n",
+                    poolEntry.blockSize, poolEntry.nBlocks, poolEntry.nFree, poolEntry.minFree, poolEntry.nAllocs, poolEntry.nMisses);
+        }
+        else
+        {
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "\tsize: %4d, not allocated\r\n", poolEntry.blockSize);
+        }
+    }
+
+    return true;
+}
+#endif  // (TCPIP_PKT_POOL_ENABLE != 0)
+
 #if defined(TCPIP_STACK_USE_INTERNAL_HEAP_POOL)
 static int _Command_HeapList(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
 {
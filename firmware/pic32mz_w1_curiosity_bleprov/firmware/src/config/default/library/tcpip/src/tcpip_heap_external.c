@@ -222,8 +222,9 @@ TCPIP_STACK_HEAP_HANDLE TCPIP_HEAP_CreateExternal(const TCPIP_STACK_HEAP_EXTERNA
         // create the object
         hInst->heapObj = _tcpip_heap_object;
 
-        // check if mapping needed; always alloc uncached!
-        // if((hDcpt->heapConfig.heapFlags & TCPIP_STACK_HEAP_FLAG_ALLOC_UNCACHED) != 0)
+        // check if mapping needed; cached allocations rely on the MAC
+        // performing the cache maintenance at the DMA hand-off
+        if((hDcpt->heapConfig.heapFlags & TCPIP_STACK_HEAP_FLAG_ALLOC_UNCACHED) != 0)
         {
             const void* testPtr = _TCPIP_HEAP_BufferMapNonCached(hInst, sizeof(*hInst));
             if(hInst != testPtr)
@@ -87,6 +87,27 @@ typedef struct
 // currently: tcp, udp, icmp, arp, ipv6
 #define TCPIP_PKT_TRACE_SIZE        8
 
+// packet slab pools
+// only if TCPIP_PKT_POOL_ENABLE is enabled
+
+// global pool info
+typedef struct
+{
+    int         nEntries;           // number of pool size classes
+    uint32_t    nOversize;          // allocations larger than the largest block, served by the heap
+}TCPIP_PKT_POOL_INFO;
+
+// pool size class occupancy
+typedef struct
+{
+    uint16_t    blockSize;          // size of a block
+    uint16_t    nBlocks;            // number of blocks pre-allocated
+    uint16_t    nFree;              // blocks currently available
+    uint16_t    minFree;            // lowest number of available blocks so far
+    uint32_t    nAllocs;            // allocations served by this pool
+    uint32_t    nMisses;            // allocations that found the pool empty and went to the heap
+}TCPIP_PKT_POOL_ENTRY;
+
 // module and packet logging flags
 // only if TCPIP_PACKET_LOG_ENABLE is enabled
 //
@@ -176,6 +197,45 @@ typedef struct
 
 }TCPIP_PKT_LOG_INFO;
 
+// packet capture
+// only if TCPIP_PACKET_LOG_ENABLE and TCPIP_PKT_CAPTURE_ENABLE are enabled
+// The frames seen by the MAC log calls are copied, truncated to the snap length,
+// into a ring buffer as pcap records.
+// A reader task drains the ring and sends it as a pcap stream.
+#if !defined(TCPIP_PKT_CAPTURE_ENABLE)
+#define TCPIP_PKT_CAPTURE_ENABLE        0
+#endif
+
+#if (TCPIP_PACKET_LOG_ENABLE) && (TCPIP_PKT_CAPTURE_ENABLE != 0)
+#define _TCPIP_PKT_CAPTURE              1
+#else
+#define _TCPIP_PKT_CAPTURE              0
+#endif
+
+// pcap file header, host byte order
+typedef struct
+{
+    uint32_t    magicNumber;        // 0xa1b2c3d4
+    uint16_t    versionMajor;       // 2
+    uint16_t    versionMinor;       // 4
+    int32_t     thisZone;           // GMT offset; 0
+    uint32_t    sigFigs;            // timestamps accuracy; 0
+    uint32_t    snapLen;            // max length of the captured frames
+    uint32_t    network;            // link type: 1, Ethernet
+}TCPIP_PKT_PCAP_HDR;
+
+// global capture info
+typedef struct
+{
+    bool        active;             // capture is running
+    uint16_t    snapLen;            // current snap length
+    uint16_t    skipPort;           // TCP port whose frames are not captured; 0 if none
+    uint32_t    nFrames;            // captured frames
+    uint32_t    nTruncated;         // captured frames longer than the snap length
+    uint32_t    nDrops;             // frames not captured because the ring was full
+    uint32_t    nPending;           // bytes in the ring waiting to be read
+}TCPIP_PKT_CAPTURE_INFO;
+
 // Extra TX/RX packet flags
 // NOTE: // 16 bits only packet flags!
 
@@ -334,6 +394,15 @@ int     TCPIP_PKT_TraceGetEntriesNo(TCPIP_PKT_TRACE_INFO* pTraceInfo);
 bool    TCPIP_PKT_TraceGetEntry(int entryIx, TCPIP_PKT_TRACE_ENTRY* tEntry);
 
 
+// returns the number of packet pool size classes
+int     TCPIP_PKT_PoolGetEntriesNo(TCPIP_PKT_POOL_INFO* pPoolInfo);
+
+
+// populates a pool entry with data for a size class index
+// returns true if the class has blocks allocated
+bool    TCPIP_PKT_PoolGetEntry(int entryIx, TCPIP_PKT_POOL_ENTRY* pEntry);
+
+
 // logs a TX packet info
 void    TCPIP_PKT_FlightLogTx(TCPIP_MAC_PACKET* pPkt, TCPIP_STACK_MODULE moduleId);
 // logs a RX packet info;
@@ -467,6 +536,51 @@ void    TCPIP_PKT_FlightLogClear(bool clrPersist);
 // at the time the reset is called
 void    TCPIP_PKT_FlightLogReset(bool resetMasks);
 
+#if (_TCPIP_PKT_CAPTURE != 0)
+// starts the packet capture
+// snapLen: max number of bytes captured from a frame; 0 for the default TCPIP_PKT_CAPTURE_SNAPLEN
+// skipPort: the frames of this TCP port are not captured; 0 if not used
+// Usually the port of the connection carrying the capture stream.
+// The ring is not cleared; the reader should call TCPIP_PKT_CaptureDiscard
+// when it starts a new stream.
+// The captured frames are selected using the log masks:
+//      - the frame interface should be in the netLogMask
+//      - TCPIP_PKT_LOG_TYPE_RX_ONLY/TCPIP_PKT_LOG_TYPE_TX_ONLY are applied
+//      - the frame modules (ARP, IPv4, ICMP, UDP, TCP, etc.) should be in the logModuleMask
+// The socket mask does not apply, the sockets are not known at the MAC level.
+// returns true if success, false otherwise (wrong parameter)
+bool    TCPIP_PKT_CaptureStart(uint16_t snapLen, uint16_t skipPort);
+
+// stops the packet capture
+// The data already in the ring can still be read.
+void    TCPIP_PKT_CaptureStop(void);
+
+// gets the capture info
+// returns true if the capture is running, false otherwise
+bool    TCPIP_PKT_CaptureGetInfo(TCPIP_PKT_CAPTURE_INFO* pCapInfo);
+
+// fills the pcap file header for the current capture
+// The header should be sent before the data read from the ring.
+void    TCPIP_PKT_CaptureHeaderGet(TCPIP_PKT_PCAP_HDR* pHdr);
+
+// reader side of the ring
+// There should be only one reader.
+// The reader does not block the capture, no lock is taken.
+
+// returns the number of contiguous bytes available in the ring
+// and their address in ppData
+size_t  TCPIP_PKT_CapturePeek(const uint8_t** ppData);
+
+// removes nBytes from the ring
+// nBytes should be <= the value returned by TCPIP_PKT_CapturePeek
+void    TCPIP_PKT_CaptureConsume(size_t nBytes);
+
+// discards all the data in the ring
+// The ring data is always a sequence of pcap records.
+// Use it to start a new stream on a record boundary. 
+void    TCPIP_PKT_CaptureDiscard(void);
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
+
 #if defined(TCPIP_PACKET_ALLOCATION_TRACE_ENABLE)
 
 // proto
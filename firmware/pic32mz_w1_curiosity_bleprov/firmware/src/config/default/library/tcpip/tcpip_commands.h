@@ -97,6 +97,35 @@ typedef struct
     None.
 */
 void  TCPIP_COMMAND_Task(void);
+
+// *****************************************************************************
+/*
+  Function:
+    void  TCPIP_COMMAND_CaptureTask(void)
+
+  Summary:
+    Packet capture stream task function.
+
+  Description:
+    This function sends the frames captured with the "plog capture" command
+    as a pcap stream on a TCP socket or on the TCPIP_PKT_CAPTURE_CONSOLE_INDEX
+    console UART.
+
+  Precondition:
+    The TCP/IP Command module should have been initialized.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Remarks:
+    Available only when TCPIP_PACKET_LOG_ENABLE and TCPIP_PKT_CAPTURE_ENABLE are enabled.
+    It should be called periodically from a low priority task,
+    not from the TCP/IP stack task.
+*/
+void  TCPIP_COMMAND_CaptureTask(void);
     
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
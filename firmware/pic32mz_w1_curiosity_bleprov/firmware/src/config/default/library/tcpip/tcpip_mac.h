@@ -280,7 +280,7 @@ typedef struct
     /* Extra space allocated to be used by the MAC driver
      * The size of the gap is variable:
      *      - usually 4 bytes when only Ethernet drivers are used
-     *      - 34 bytes when Wi-Fi drivers are present 
+     *      - 48 bytes when Wi-Fi drivers are present 
     */
     uint32_t                        segmentDataGap[];
 
@@ -0,0 +1,301 @@
+/*******************************************************************************
+  Boot Trace System Service Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_boottrace.c
+
+  Summary:
+    Boot time profiler.
+
+  Description:
+    Records time stamped boot events in a fixed table and prints them over
+    the console. Before the TIME system service is running the time is read
+    straight from the core timer, afterwards from the 64-bit SYS_TIME counter
+    so that the trace is not limited by the 32-bit core timer wrap.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "system/boottrace/sys_boottrace.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Recorded events, in the order they were taken */
+    SYS_BOOTTRACE_RECORD    records[SYS_BOOTTRACE_MAX_RECORDS];
+
+    /* Number of valid entries in records */
+    uint16_t                nRecords;
+
+    /* Marks lost because records was full */
+    uint16_t                nDropped;
+
+    /* Time of the last mark taken from the core timer, before SYS_TIME
+       restarted it */
+    uint32_t                timeBaseUs;
+
+    /* No more marks are recorded */
+    volatile bool           complete;
+
+} SYS_BOOTTRACE_OBJ;
+
+static SYS_BOOTTRACE_OBJ g_bootTrace;
+
+static const char * const g_bootTraceNames[SYS_BOOTTRACE_ID_NUM] =
+{
+    [SYS_BOOTTRACE_ID_INIT_START]       = "init start",
+    [SYS_BOOTTRACE_ID_INIT_CLK]         = "init pmu/clk",
+    [SYS_BOOTTRACE_ID_INIT_PERIPH]      = "init gpio/nvm/uart",
+    [SYS_BOOTTRACE_ID_INIT_WDRV]        = "init wdrv",
+    [SYS_BOOTTRACE_ID_INIT_TIME]        = "init sys_time",
+    [SYS_BOOTTRACE_ID_INIT_CONSOLE]     = "init console/cmd",
+    [SYS_BOOTTRACE_ID_INIT_SYS_WIFI]    = "init sys_wifi",
+    [SYS_BOOTTRACE_ID_INIT_BA414E]      = "init ba414e",
+    [SYS_BOOTTRACE_ID_INIT_TCPIP]       = "init tcpip",
+    [SYS_BOOTTRACE_ID_INIT_CRYPTO]      = "init crypto",
+    [SYS_BOOTTRACE_ID_INIT_APP]         = "init apps",
+    [SYS_BOOTTRACE_ID_INIT_DONE]        = "init done",
+    [SYS_BOOTTRACE_ID_SCHEDULER_START]  = "scheduler start",
+    [SYS_BOOTTRACE_ID_TASK_SYS_CMD]     = "task sys_cmd",
+    [SYS_BOOTTRACE_ID_TASK_WDRV]        = "task wdrv",
+    [SYS_BOOTTRACE_ID_TASK_BA414E]      = "task ba414e",
+    [SYS_BOOTTRACE_ID_TASK_TCPIP]       = "task tcpip",
+    [SYS_BOOTTRACE_ID_TASK_SYS_WIFI]    = "task sys_wifi",
+    [SYS_BOOTTRACE_ID_TASK_APP_WIFI]    = "task app_wifi",
+    [SYS_BOOTTRACE_ID_TASK_APP_BLE]     = "task app_ble",
+    [SYS_BOOTTRACE_ID_WIFI_STATE]       = "wifi state",
+    [SYS_BOOTTRACE_ID_DHCP_BOUND]       = "dhcp bound",
+    [SYS_BOOTTRACE_ID_COMPLETE]         = "complete",
+};
+
+static int SYS_BOOTTRACE_CMDShow(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+
+static const SYS_CMD_DESCRIPTOR g_bootTraceCmdTbl[] =
+{
+    {"boottrace", (SYS_CMD_FNC) SYS_BOOTTRACE_CMDShow, ": show boot trace, 'hex' for the binary blob"},
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_BOOTTRACE_TimeUs(void)
+{
+    uint32_t timeUs;
+
+    if (SYS_TIME_Status(sysObj.sysTime) == SYS_STATUS_READY)
+    {
+        /* SYS_TIME restarted the core timer from 0 when it was initialized */
+        timeUs = g_bootTrace.timeBaseUs + (uint32_t)((SYS_TIME_Counter64Get() * 1000000) / SYS_TIME_FrequencyGet());
+    }
+    else
+    {
+        timeUs = _CP0_GET_COUNT() / (CORETIMER_FrequencyGet() / 1000000);
+        g_bootTrace.timeBaseUs = timeUs;
+    }
+
+    return timeUs;
+}
+
+static void SYS_BOOTTRACE_HexPrint(SYS_CMD_DEVICE_NODE* pCmdIO, const uint8_t* pData, size_t len, size_t* pOffset)
+{
+    const void* cmdIoParam = pCmdIO->cmdIoParam;
+
+    while (len--)
+    {
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "%02x", *pData++);
+
+        if (0 == (++(*pOffset) % 16))
+        {
+            (*pCmdIO->pCmdApi->msg)(cmdIoParam, "\r\n");
+        }
+    }
+}
+
+static void SYS_BOOTTRACE_HeaderGet(SYS_BOOTTRACE_HEADER* pHeader, uint16_t nRecords)
+{
+    pHeader->magic    = SYS_BOOTTRACE_MAGIC;
+    pHeader->version  = SYS_BOOTTRACE_VERSION;
+    pHeader->nRecords = nRecords;
+    pHeader->nDropped = g_bootTrace.nDropped;
+    pHeader->complete = g_bootTrace.complete;
+}
+
+static int SYS_BOOTTRACE_CMDShow(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
+{
+    const void* cmdIoParam = pCmdIO->cmdIoParam;
+    const SYS_BOOTTRACE_RECORD* pRec;
+    SYS_BOOTTRACE_HEADER header;
+    uint32_t prevUs = 0;
+    uint32_t deltaUs;
+    uint16_t nRecords = g_bootTrace.nRecords;
+    uint16_t i;
+    size_t offset = 0;
+
+    if ((argc == 2) && (0 == strcmp(argv[1], "hex")))
+    {
+        SYS_BOOTTRACE_HeaderGet(&header, nRecords);
+        SYS_BOOTTRACE_HexPrint(pCmdIO, (const uint8_t*)&header, sizeof(header), &offset);
+        SYS_BOOTTRACE_HexPrint(pCmdIO, (const uint8_t*)g_bootTrace.records, nRecords * sizeof(SYS_BOOTTRACE_RECORD), &offset);
+        if (0 != (offset % 16))
+        {
+            (*pCmdIO->pCmdApi->msg)(cmdIoParam, "\r\n");
+        }
+        return true;
+    }
+    else if (argc != 1)
+    {
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: boottrace [hex]\r\n");
+        return false;
+    }
+
+    (*pCmdIO->pCmdApi->msg)(cmdIoParam, "  #     time(ms)    delta(ms)  event\r\n");
+    for (i = 0; i < nRecords; i++)
+    {
+        pRec = &g_bootTrace.records[i];
+        deltaUs = pRec->timeUs - prevUs;
+        prevUs = pRec->timeUs;
+
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "%3u %8lu.%03lu %8lu.%03lu  %s",
+                i, (unsigned long)(pRec->timeUs / 1000), (unsigned long)(pRec->timeUs % 1000),
+                (unsigned long)(deltaUs / 1000), (unsigned long)(deltaUs % 1000),
+                (pRec->id < SYS_BOOTTRACE_ID_NUM) ? g_bootTraceNames[pRec->id] : "?");
+        if (SYS_BOOTTRACE_ID_WIFI_STATE == pRec->id)
+        {
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, " %u", pRec->arg);
+        }
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "\r\n");
+    }
+
+    (*pCmdIO->pCmdApi->print)(cmdIoParam, "%u records, %u dropped, %s\r\n", nRecords, g_bootTrace.nDropped,
+            g_bootTrace.complete ? "complete" : "in progress");
+
+    return true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_BOOTTRACE_Initialize(void)
+{
+    return SYS_CMD_ADDGRP(g_bootTraceCmdTbl, sizeof(g_bootTraceCmdTbl) / sizeof(*g_bootTraceCmdTbl), "boottrace", ": boot trace commands");
+}
+
+void SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID id, uint16_t arg)
+{
+    OSAL_CRITSECT_DATA_TYPE critStatus;
+    SYS_BOOTTRACE_RECORD* pRec;
+    uint32_t timeUs;
+
+    if (true == g_bootTrace.complete)
+    {
+        return;
+    }
+
+    /* Read the time outside of the critical section, SYS_TIME takes a mutex */
+    timeUs = SYS_BOOTTRACE_TimeUs();
+
+    critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+
+    if (false == g_bootTrace.complete)
+    {
+        if (g_bootTrace.nRecords < SYS_BOOTTRACE_MAX_RECORDS)
+        {
+            pRec = &g_bootTrace.records[g_bootTrace.nRecords++];
+            pRec->timeUs   = timeUs;
+            pRec->id       = (uint8_t)id;
+            pRec->reserved = 0;
+            pRec->arg      = arg;
+        }
+        else
+        {
+            g_bootTrace.nDropped++;
+        }
+
+        if (SYS_BOOTTRACE_ID_COMPLETE == id)
+        {
+            g_bootTrace.complete = true;
+        }
+    }
+
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critStatus);
+}
+
+void SYS_BOOTTRACE_Complete(void)
+{
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_COMPLETE, 0);
+}
+
+size_t SYS_BOOTTRACE_BlobGet(void* buffer, size_t bufferSize)
+{
+    SYS_BOOTTRACE_HEADER header;
+    uint16_t nRecords = g_bootTrace.nRecords;
+
+    if (NULL == buffer)
+    {
+        return sizeof(header) + (nRecords * sizeof(SYS_BOOTTRACE_RECORD));
+    }
+
+    if (bufferSize < sizeof(header))
+    {
+        return 0;
+    }
+
+    if (nRecords > ((bufferSize - sizeof(header)) / sizeof(SYS_BOOTTRACE_RECORD)))
+    {
+        nRecords = (bufferSize - sizeof(header)) / sizeof(SYS_BOOTTRACE_RECORD);
+    }
+
+    SYS_BOOTTRACE_HeaderGet(&header, nRecords);
+    memcpy(buffer, &header, sizeof(header));
+    memcpy((uint8_t*)buffer + sizeof(header), g_bootTrace.records, nRecords * sizeof(SYS_BOOTTRACE_RECORD));
+
+    return sizeof(header) + (nRecords * sizeof(SYS_BOOTTRACE_RECORD));
+}
+
+/*******************************************************************************
+ End of File
+*/
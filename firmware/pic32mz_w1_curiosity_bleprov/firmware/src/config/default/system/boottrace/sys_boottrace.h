@@ -0,0 +1,357 @@
+/*******************************************************************************
+  Boot Trace System Service Interface Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_boottrace.h
+
+  Summary:
+    Boot time profiler.
+
+  Description:
+    This file defines the interface to the boot trace system service. The
+    service records a time stamp for each initialization stage, task start,
+    Wi-Fi service state transition and DHCP event from reset until the Wi-Fi
+    interface first gets an IP address.
+
+    The trace can be printed with the "boottrace" console command or read as
+    a binary blob, made of a SYS_BOOTTRACE_HEADER followed by the
+    SYS_BOOTTRACE_RECORD entries, for off-line analysis.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+#ifndef SYS_BOOTTRACE_H
+#define SYS_BOOTTRACE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of records kept, marks beyond this are counted as dropped */
+#ifndef SYS_BOOTTRACE_MAX_RECORDS
+#define SYS_BOOTTRACE_MAX_RECORDS       64
+#endif
+
+/* Binary blob identification, "BTRC" */
+#define SYS_BOOTTRACE_MAGIC             0x43525442
+#define SYS_BOOTTRACE_VERSION           1
+
+// *****************************************************************************
+/* Boot Trace Mark Identifiers
+
+  Summary:
+    Identifies the boot event a record was taken for.
+
+  Description:
+    The initialization stage identifiers mark the end of the stage, so the
+    time since the previous record is the duration of the stage.
+
+  Remarks:
+    The values are part of the binary blob format, new identifiers must be
+    added before SYS_BOOTTRACE_ID_NUM.
+*/
+
+typedef enum
+{
+    /* SYS_Initialize entry */
+    SYS_BOOTTRACE_ID_INIT_START = 0,
+
+    /* PMU, clock and flash wait states */
+    SYS_BOOTTRACE_ID_INIT_CLK,
+
+    /* GPIO, BSP, NVM and UART peripherals */
+    SYS_BOOTTRACE_ID_INIT_PERIPH,
+
+    /* PIC32MZW1 Wi-Fi driver */
+    SYS_BOOTTRACE_ID_INIT_WDRV,
+
+    /* TIME system service */
+    SYS_BOOTTRACE_ID_INIT_TIME,
+
+    /* Console, command and debug system services */
+    SYS_BOOTTRACE_ID_INIT_CONSOLE,
+
+    /* Wi-Fi system service */
+    SYS_BOOTTRACE_ID_INIT_SYS_WIFI,
+
+    /* BA414E driver */
+    SYS_BOOTTRACE_ID_INIT_BA414E,
+
+    /* TCP/IP stack, the stack itself completes initialization in its task */
+    SYS_BOOTTRACE_ID_INIT_TCPIP,
+
+    /* Crypto library */
+    SYS_BOOTTRACE_ID_INIT_CRYPTO,
+
+    /* Applications */
+    SYS_BOOTTRACE_ID_INIT_APP,
+
+    /* Interrupts enabled, SYS_Initialize exit */
+    SYS_BOOTTRACE_ID_INIT_DONE,
+
+    /* All tasks created, scheduler about to start */
+    SYS_BOOTTRACE_ID_SCHEDULER_START,
+
+    /* First run of each task */
+    SYS_BOOTTRACE_ID_TASK_SYS_CMD,
+    SYS_BOOTTRACE_ID_TASK_WDRV,
+    SYS_BOOTTRACE_ID_TASK_BA414E,
+    SYS_BOOTTRACE_ID_TASK_TCPIP,
+    SYS_BOOTTRACE_ID_TASK_SYS_WIFI,
+    SYS_BOOTTRACE_ID_TASK_APP_WIFI,
+    SYS_BOOTTRACE_ID_TASK_APP_BLE,
+
+    /* Wi-Fi service state transition, the argument is the new SYS_WIFI_STATUS */
+    SYS_BOOTTRACE_ID_WIFI_STATE,
+
+    /* DHCP client lease bound */
+    SYS_BOOTTRACE_ID_DHCP_BOUND,
+
+    /* Trace complete, first IP address */
+    SYS_BOOTTRACE_ID_COMPLETE,
+
+    SYS_BOOTTRACE_ID_NUM
+
+} SYS_BOOTTRACE_ID;
+
+// *****************************************************************************
+/* Boot Trace Record
+
+  Summary:
+    One time stamped boot event.
+
+  Description:
+    The time is in microseconds since the core timer started counting at
+    reset.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* Microseconds since reset */
+    uint32_t    timeUs;
+
+    /* SYS_BOOTTRACE_ID */
+    uint8_t     id;
+
+    uint8_t     reserved;
+
+    /* Event specific argument */
+    uint16_t    arg;
+
+} SYS_BOOTTRACE_RECORD;
+
+// *****************************************************************************
+/* Boot Trace Blob Header
+
+  Summary:
+    Header of the binary boot trace.
+
+  Description:
+    The header is followed by nRecords SYS_BOOTTRACE_RECORD entries. All
+    fields are little endian.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* SYS_BOOTTRACE_MAGIC */
+    uint32_t    magic;
+
+    /* SYS_BOOTTRACE_VERSION */
+    uint16_t    version;
+
+    /* Number of records following the header */
+    uint16_t    nRecords;
+
+    /* Marks lost because the trace was full */
+    uint16_t    nDropped;
+
+    /* true once SYS_BOOTTRACE_Complete has been called */
+    uint16_t    complete;
+
+} SYS_BOOTTRACE_HEADER;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_BOOTTRACE_Initialize(void)
+
+  Summary:
+    Registers the boot trace console commands.
+
+  Description:
+    Adds the "boottrace" command to the command processor. Recording does not
+    depend on this call, marks can be taken from the very start of
+    SYS_Initialize.
+
+  PreCondition:
+    SYS_CMD_Initialize has been called.
+
+  Parameters:
+    None.
+
+  Returns:
+    true if the commands were registered, false otherwise.
+
+  Remarks:
+    None.
+*/
+
+bool SYS_BOOTTRACE_Initialize(void);
+
+// *****************************************************************************
+/* Function:
+    void SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID id, uint16_t arg)
+
+  Summary:
+    Records a time stamped boot event.
+
+  Description:
+    Appends a record with the current time. Nothing is recorded once the
+    trace is complete, and marks beyond SYS_BOOTTRACE_MAX_RECORDS are only
+    counted.
+
+  PreCondition:
+    None.
+
+  Parameters:
+    id  - Boot event identifier.
+    arg - Event specific argument, 0 if unused.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    sysObj.sysTime = SYS_TIME_Initialize(SYS_TIME_INDEX_0, (SYS_MODULE_INIT *)&sysTimeInitData);
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_INIT_TIME, 0);
+    </code>
+
+  Remarks:
+    Must be called from SYS_Initialize or task context, not from an interrupt
+    handler. A mark must be taken right before SYS_TIME_Initialize, which
+    restarts the core timer.
+*/
+
+void SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID id, uint16_t arg);
+
+// *****************************************************************************
+/* Function:
+    void SYS_BOOTTRACE_Complete(void)
+
+  Summary:
+    Closes the boot trace.
+
+  Description:
+    Records SYS_BOOTTRACE_ID_COMPLETE and stops recording. Calls after the
+    first one have no effect.
+
+  PreCondition:
+    None.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Remarks:
+    Called by the Wi-Fi service when the interface first gets an IP
+    address: SYS_WIFI_STATUS_STA_IP_RECIEVED in STA mode, the AP interface
+    address in AP mode.
+*/
+
+void SYS_BOOTTRACE_Complete(void);
+
+// *****************************************************************************
+/* Function:
+    size_t SYS_BOOTTRACE_BlobGet(void* buffer, size_t bufferSize)
+
+  Summary:
+    Copies the boot trace as a binary blob.
+
+  Description:
+    Writes a SYS_BOOTTRACE_HEADER followed by the recorded entries to buffer.
+    When bufferSize is too small only the records that fit are copied and
+    nRecords is set accordingly.
+
+  PreCondition:
+    None.
+
+  Parameters:
+    buffer     - Destination, or NULL to query the size.
+    bufferSize - Size of buffer in bytes.
+
+  Returns:
+    Number of bytes written, or the size of the complete blob when buffer
+    is NULL. 0 if buffer cannot hold the header.
+
+  Remarks:
+    None.
+*/
+
+size_t SYS_BOOTTRACE_BlobGet(void* buffer, size_t bufferSize);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_BOOTTRACE_H
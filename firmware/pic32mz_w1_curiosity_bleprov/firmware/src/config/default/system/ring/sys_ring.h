@@ -0,0 +1,392 @@
+/*******************************************************************************
+  Single Producer Single Consumer Ring
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_ring.h
+
+  Summary:
+    Lock-free ring buffer for interrupt to task hand-off.
+
+  Description:
+    This file provides a fixed size ring of equally sized elements with one
+    producer and one consumer, typically an interrupt handler feeding a task.
+    Neither side takes a lock or enters a critical section: the producer owns
+    the head index, the consumer owns the tail index and each side only
+    publishes its index after the element copy is complete.
+
+    The consumer can optionally be woken through an OSAL semaphore which is
+    posted by the producer on every successful put.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+#ifndef SYS_RING_H
+#define SYS_RING_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "osal/osal.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Ring Memory Barrier
+
+  Summary:
+    Orders the element copy against the index update.
+
+  Description:
+    On the single core PIC32MZ a compiler barrier is sufficient between an
+    interrupt handler and a task. The MIPS SYNC instruction is used so the
+    ring also stays correct for multi-core hosts.
+
+  Remarks:
+    None.
+*/
+
+#ifndef SYS_RING_BARRIER
+#define SYS_RING_BARRIER()      __sync_synchronize()
+#endif
+
+// *****************************************************************************
+/* Ring Object
+
+  Summary:
+    Single producer single consumer ring.
+
+  Description:
+    The head and tail indices are free running and are reduced modulo the ring
+    size on access, so the ring can hold all numElems elements and the count is
+    always (head - tail).
+
+  Remarks:
+    The fields are private to the SYS_RING functions.
+*/
+
+typedef struct
+{
+    /* Element storage, numElems * elemSize bytes */
+    uint8_t*                buffer;
+
+    /* Size of one element, in bytes */
+    uint16_t                elemSize;
+
+    /* Number of elements minus one, the ring size is a power of 2 */
+    uint16_t                mask;
+
+    /* Written by the producer only */
+    volatile uint32_t       head;
+
+    /* Written by the consumer only */
+    volatile uint32_t       tail;
+
+    /* Puts rejected because the ring was full, written by the producer only */
+    volatile uint32_t       dropCount;
+
+    /* Optional semaphore posted on every put */
+    OSAL_SEM_HANDLE_TYPE*   wakeSem;
+
+} SYS_RING;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_RING_Initialize(SYS_RING* ring, void* buffer, uint16_t elemSize,
+                             uint16_t numElems, OSAL_SEM_HANDLE_TYPE* wakeSem)
+
+  Summary:
+    Initializes a ring over caller provided storage.
+
+  Description:
+    Sets up the ring to hold numElems elements of elemSize bytes each in
+    buffer, which must be at least numElems * elemSize bytes.
+
+  PreCondition:
+    Neither the producer nor the consumer is using the ring.
+
+  Parameters:
+    ring     - Ring object.
+    buffer   - Element storage.
+    elemSize - Size of one element in bytes.
+    numElems - Number of elements, must be a power of 2.
+    wakeSem  - Semaphore posted on every put, or NULL.
+
+  Returns:
+    true if the ring was initialized, false if a parameter is invalid.
+
+  Example:
+    <code>
+    static SYS_RING rxRing;
+    static uint8_t rxRingBuffer[64];
+
+    SYS_RING_Initialize(&rxRing, rxRingBuffer, sizeof(uint8_t), 64, &rxSemaphore);
+    </code>
+
+  Remarks:
+    None.
+*/
+
+static inline bool SYS_RING_Initialize(SYS_RING* ring, void* buffer, uint16_t elemSize, uint16_t numElems, OSAL_SEM_HANDLE_TYPE* wakeSem)
+{
+    if ((ring == NULL) || (buffer == NULL) || (elemSize == 0) || (numElems == 0) || ((numElems & (numElems - 1)) != 0))
+    {
+        return false;
+    }
+
+    ring->buffer = (uint8_t*)buffer;
+    ring->elemSize = elemSize;
+    ring->mask = numElems - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropCount = 0;
+    ring->wakeSem = wakeSem;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_RING_Count(const SYS_RING* ring)
+
+  Summary:
+    Returns the number of elements in the ring.
+
+  Description:
+    The value is a snapshot, it may grow when called by the consumer and
+    shrink when called by the producer.
+
+  PreCondition:
+    SYS_RING_Initialize has been called.
+
+  Parameters:
+    ring - Ring object.
+
+  Returns:
+    Number of elements waiting to be read.
+
+  Remarks:
+    None.
+*/
+
+static inline uint32_t SYS_RING_Count(const SYS_RING* ring)
+{
+    uint32_t tail = ring->tail;
+    uint32_t head = ring->head;
+
+    return head - tail;
+}
+
+/* Copies an element in and publishes it, shared by the put functions */
+static inline bool _SYS_RING_Push(SYS_RING* ring, const void* elem)
+{
+    uint32_t head = ring->head;
+
+    if ((head - ring->tail) > ring->mask)
+    {
+        ring->dropCount++;
+        return false;
+    }
+
+    memcpy(&ring->buffer[(head & ring->mask) * ring->elemSize], elem, ring->elemSize);
+
+    /* Publish the element only after it has been written */
+    SYS_RING_BARRIER();
+    ring->head = head + 1;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    bool SYS_RING_Put(SYS_RING* ring, const void* elem)
+
+  Summary:
+    Adds an element to the ring from task context.
+
+  Description:
+    Copies elemSize bytes from elem to the ring and wakes the consumer.
+
+  PreCondition:
+    SYS_RING_Initialize has been called. Only one context calls the put
+    functions of a ring at any one time.
+
+  Parameters:
+    ring - Ring object.
+    elem - Element to copy into the ring.
+
+  Returns:
+    true if the element was added, false if the ring is full.
+
+  Remarks:
+    Use SYS_RING_PutISR from an interrupt handler.
+*/
+
+static inline bool SYS_RING_Put(SYS_RING* ring, const void* elem)
+{
+    if (_SYS_RING_Push(ring, elem) == false)
+    {
+        return false;
+    }
+
+    if (ring->wakeSem != NULL)
+    {
+        OSAL_SEM_Post(ring->wakeSem);
+    }
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    bool SYS_RING_PutISR(SYS_RING* ring, const void* elem)
+
+  Summary:
+    Adds an element to the ring from an interrupt handler.
+
+  Description:
+    Same as SYS_RING_Put, the consumer is woken with OSAL_SEM_PostISR.
+
+  PreCondition:
+    SYS_RING_Initialize has been called.
+
+  Parameters:
+    ring - Ring object.
+    elem - Element to copy into the ring.
+
+  Returns:
+    true if the element was added, false if the ring is full.
+
+  Remarks:
+    None.
+*/
+
+static inline bool SYS_RING_PutISR(SYS_RING* ring, const void* elem)
+{
+    if (_SYS_RING_Push(ring, elem) == false)
+    {
+        return false;
+    }
+
+    if (ring->wakeSem != NULL)
+    {
+        OSAL_SEM_PostISR(ring->wakeSem);
+    }
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    bool SYS_RING_Get(SYS_RING* ring, void* elem)
+
+  Summary:
+    Removes the oldest element from the ring.
+
+  Description:
+    Copies elemSize bytes of the oldest element to elem and releases its slot
+    to the producer.
+
+  PreCondition:
+    SYS_RING_Initialize has been called. Only one context calls
+    SYS_RING_Get for a ring.
+
+  Parameters:
+    ring - Ring object.
+    elem - Destination of the element.
+
+  Returns:
+    true if an element was read, false if the ring is empty.
+
+  Example:
+    <code>
+    uint8_t c;
+
+    OSAL_SEM_Pend(&rxSemaphore, OSAL_WAIT_FOREVER);
+
+    while (SYS_RING_Get(&rxRing, &c) == true)
+    {
+        ProcessByte(c);
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+static inline bool SYS_RING_Get(SYS_RING* ring, void* elem)
+{
+    uint32_t tail = ring->tail;
+
+    if (ring->head == tail)
+    {
+        return false;
+    }
+
+    /* Read the element only after the head that published it */
+    SYS_RING_BARRIER();
+    memcpy(elem, &ring->buffer[(tail & ring->mask) * ring->elemSize], ring->elemSize);
+
+    /* Release the slot only after the element has been read */
+    SYS_RING_BARRIER();
+    ring->tail = tail + 1;
+
+    return true;
+}
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_RING_H
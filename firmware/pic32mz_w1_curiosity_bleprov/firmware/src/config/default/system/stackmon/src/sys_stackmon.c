@@ -0,0 +1,372 @@
+/*******************************************************************************
+  Stack Monitor System Service Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_stackmon.c
+
+  Summary:
+    Task stack usage watermark reporting.
+
+  Description:
+    Samples uxTaskGetStackHighWaterMark for the registered tasks from the
+    idle hook. The worst case usage of each task is kept in a persistent RAM
+    section, which the start-up code does not clear, protected by a magic
+    number and a checksum so that a power cycle starts from a clean record.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "system/stackmon/sys_stackmon.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Persistent record identification, "PSTK" */
+#define SYS_STACKMON_MAGIC          0x4B545350
+
+/* Recommended sizes are rounded up to this many words */
+#define SYS_STACKMON_ROUND          32
+
+typedef struct
+{
+    /* Hash of the task name, 0 for an unused entry */
+    uint32_t    nameHash;
+
+    /* Largest stack usage seen, in words */
+    uint16_t    maxUsed;
+
+    /* Stack overflows reported by FreeRTOS */
+    uint16_t    overflows;
+
+    /* Stack depth of the last registration, in words */
+    uint16_t    stackDepth;
+
+    uint16_t    reserved;
+
+} SYS_STACKMON_PERSIST_ENTRY;
+
+typedef struct
+{
+    uint32_t                    magic;
+
+    /* Resets covered by the record */
+    uint32_t                    bootCount;
+
+    SYS_STACKMON_PERSIST_ENTRY  entry[SYS_STACKMON_MAX_TASKS];
+
+    uint32_t                    checksum;
+
+} SYS_STACKMON_PERSIST;
+
+typedef struct
+{
+    /* Registered tasks, index matches the persistent entries */
+    TaskHandle_t    handle[SYS_STACKMON_MAX_TASKS];
+
+    /* Largest stack usage seen since this reset, in words */
+    uint16_t        bootUsed[SYS_STACKMON_MAX_TASKS];
+
+    uint8_t         nTasks;
+
+    bool            idleRegistered;
+
+    TickType_t      lastSample;
+
+} SYS_STACKMON_OBJ;
+
+/* Not initialized by the start-up code, survives a reset */
+static SYS_STACKMON_PERSIST __attribute__((persistent)) g_stackMonPersist;
+
+static SYS_STACKMON_OBJ g_stackMon;
+
+static int SYS_STACKMON_CMDShow(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+
+static const SYS_CMD_DESCRIPTOR g_stackMonCmdTbl[] =
+{
+    {"stackmon", (SYS_CMD_FNC) SYS_STACKMON_CMDShow, ": show task stack usage, 'reset' clears the worst case"},
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_STACKMON_Checksum(void)
+{
+    const uint32_t* pWord = (const uint32_t*)&g_stackMonPersist;
+    size_t nWords = offsetof(SYS_STACKMON_PERSIST, checksum) / sizeof(uint32_t);
+    uint32_t sum = ~SYS_STACKMON_MAGIC;
+
+    while (nWords--)
+    {
+        sum = ((sum << 1) | (sum >> 31)) ^ *pWord++;
+    }
+
+    return sum;
+}
+
+static uint32_t SYS_STACKMON_NameHash(const char* name)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261UL;
+
+    while (*name)
+    {
+        hash = (hash ^ (uint8_t)*name++) * 16777619UL;
+    }
+
+    /* 0 marks an unused entry */
+    return (hash != 0) ? hash : 1;
+}
+
+static uint16_t SYS_STACKMON_Recommended(uint16_t used)
+{
+    uint32_t margin = ((uint32_t)used * SYS_STACKMON_MARGIN_PERCENT) / 100;
+
+    if (margin < SYS_STACKMON_MARGIN_MIN)
+    {
+        margin = SYS_STACKMON_MARGIN_MIN;
+    }
+
+    return (uint16_t)(((used + margin + SYS_STACKMON_ROUND - 1) / SYS_STACKMON_ROUND) * SYS_STACKMON_ROUND);
+}
+
+static void SYS_STACKMON_Sample(void)
+{
+    SYS_STACKMON_PERSIST_ENTRY* pEntry;
+    OSAL_CRITSECT_DATA_TYPE critStatus;
+    bool changed = false;
+    uint16_t used;
+    uint8_t i;
+
+    critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+
+    for (i = 0; i < g_stackMon.nTasks; i++)
+    {
+        pEntry = &g_stackMonPersist.entry[i];
+        used = pEntry->stackDepth - (uint16_t)uxTaskGetStackHighWaterMark(g_stackMon.handle[i]);
+
+        if (used > g_stackMon.bootUsed[i])
+        {
+            g_stackMon.bootUsed[i] = used;
+        }
+
+        if (used > pEntry->maxUsed)
+        {
+            pEntry->maxUsed = used;
+            changed = true;
+        }
+    }
+
+    if (true == changed)
+    {
+        g_stackMonPersist.checksum = SYS_STACKMON_Checksum();
+    }
+
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+}
+
+static int SYS_STACKMON_CMDShow(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
+{
+    const void* cmdIoParam = pCmdIO->cmdIoParam;
+    const SYS_STACKMON_PERSIST_ENTRY* pEntry;
+    OSAL_CRITSECT_DATA_TYPE critStatus;
+    uint32_t totalSize = 0;
+    uint32_t totalRecommended = 0;
+    uint16_t recommended;
+    uint8_t i;
+
+    if ((argc == 2) && (0 == strcmp(argv[1], "reset")))
+    {
+        critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+        for (i = 0; i < g_stackMon.nTasks; i++)
+        {
+            g_stackMonPersist.entry[i].maxUsed = g_stackMon.bootUsed[i];
+            g_stackMonPersist.entry[i].overflows = 0;
+        }
+        g_stackMonPersist.bootCount = 1;
+        g_stackMonPersist.checksum = SYS_STACKMON_Checksum();
+        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+        return true;
+    }
+    else if (argc != 1)
+    {
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: stackmon [reset]\r\n");
+        return false;
+    }
+
+    SYS_STACKMON_Sample();
+
+    (*pCmdIO->pCmdApi->msg)(cmdIoParam, "task                   size  used  worst  recommended (words)\r\n");
+    for (i = 0; i < g_stackMon.nTasks; i++)
+    {
+        pEntry = &g_stackMonPersist.entry[i];
+        recommended = SYS_STACKMON_Recommended(pEntry->maxUsed);
+        totalSize += pEntry->stackDepth;
+        totalRecommended += recommended;
+
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "%-20s %6u %5u %6u %12u",
+                pcTaskGetName(g_stackMon.handle[i]), pEntry->stackDepth,
+                g_stackMon.bootUsed[i], pEntry->maxUsed, recommended);
+        if (0 != pEntry->overflows)
+        {
+            (*pCmdIO->pCmdApi->print)(cmdIoParam, "  OVERFLOW x%u", pEntry->overflows);
+        }
+        else if (recommended > pEntry->stackDepth)
+        {
+            (*pCmdIO->pCmdApi->msg)(cmdIoParam, "  low margin");
+        }
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "\r\n");
+    }
+
+    (*pCmdIO->pCmdApi->print)(cmdIoParam, "total %lu words, recommended %lu words, worst case over %lu boots\r\n",
+            (unsigned long)totalSize, (unsigned long)totalRecommended, (unsigned long)g_stackMonPersist.bootCount);
+    if (totalRecommended < totalSize)
+    {
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "%lu bytes could be reclaimed\r\n",
+                (unsigned long)((totalSize - totalRecommended) * sizeof(StackType_t)));
+    }
+
+    return true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_STACKMON_Initialize(void)
+{
+    if ((SYS_STACKMON_MAGIC != g_stackMonPersist.magic) || (SYS_STACKMON_Checksum() != g_stackMonPersist.checksum))
+    {
+        /* Power-on, or a reset while the record was being updated */
+        memset(&g_stackMonPersist, 0, sizeof(g_stackMonPersist));
+        g_stackMonPersist.magic = SYS_STACKMON_MAGIC;
+    }
+
+    g_stackMonPersist.bootCount++;
+    g_stackMonPersist.checksum = SYS_STACKMON_Checksum();
+
+    memset(&g_stackMon, 0, sizeof(g_stackMon));
+
+    return SYS_CMD_ADDGRP(g_stackMonCmdTbl, sizeof(g_stackMonCmdTbl) / sizeof(*g_stackMonCmdTbl), "stackmon", ": stack monitor commands");
+}
+
+bool SYS_STACKMON_TaskRegister(TaskHandle_t handle, uint32_t stackDepth)
+{
+    SYS_STACKMON_PERSIST_ENTRY entry;
+    uint32_t nameHash;
+    uint8_t index = g_stackMon.nTasks;
+    uint8_t i;
+
+    if ((NULL == handle) || (index >= SYS_STACKMON_MAX_TASKS))
+    {
+        return false;
+    }
+
+    nameHash = SYS_STACKMON_NameHash(pcTaskGetName(handle));
+
+    /* Bring the entry kept from before the reset to this task's index */
+    for (i = index; i < SYS_STACKMON_MAX_TASKS; i++)
+    {
+        if (nameHash == g_stackMonPersist.entry[i].nameHash)
+        {
+            entry = g_stackMonPersist.entry[index];
+            g_stackMonPersist.entry[index] = g_stackMonPersist.entry[i];
+            g_stackMonPersist.entry[i] = entry;
+            break;
+        }
+    }
+
+    if (i == SYS_STACKMON_MAX_TASKS)
+    {
+        memset(&g_stackMonPersist.entry[index], 0, sizeof(SYS_STACKMON_PERSIST_ENTRY));
+        g_stackMonPersist.entry[index].nameHash = nameHash;
+    }
+    g_stackMonPersist.entry[index].stackDepth = (uint16_t)stackDepth;
+    g_stackMonPersist.checksum = SYS_STACKMON_Checksum();
+
+    g_stackMon.handle[index] = handle;
+    g_stackMon.bootUsed[index] = 0;
+    g_stackMon.nTasks++;
+
+    return true;
+}
+
+void SYS_STACKMON_Tasks(void)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    if (false == g_stackMon.idleRegistered)
+    {
+        /* The idle task only exists once the scheduler is running */
+        g_stackMon.idleRegistered = true;
+        SYS_STACKMON_TaskRegister(xTaskGetIdleTaskHandle(), configMINIMAL_STACK_SIZE);
+    }
+
+    if ((now - g_stackMon.lastSample) < pdMS_TO_TICKS(SYS_STACKMON_PERIOD_MS))
+    {
+        return;
+    }
+
+    g_stackMon.lastSample = now;
+    SYS_STACKMON_Sample();
+}
+
+void SYS_STACKMON_OverflowNotify(TaskHandle_t handle)
+{
+    uint8_t i;
+
+    for (i = 0; i < g_stackMon.nTasks; i++)
+    {
+        if (handle == g_stackMon.handle[i])
+        {
+            g_stackMonPersist.entry[i].overflows++;
+            g_stackMonPersist.entry[i].maxUsed = g_stackMonPersist.entry[i].stackDepth;
+            g_stackMonPersist.checksum = SYS_STACKMON_Checksum();
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+ End of File
+*/
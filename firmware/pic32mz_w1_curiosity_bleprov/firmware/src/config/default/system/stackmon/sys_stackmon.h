@@ -0,0 +1,220 @@
+/*******************************************************************************
+  Stack Monitor System Service Interface Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_stackmon.h
+
+  Summary:
+    Task stack usage watermark reporting.
+
+  Description:
+    This file defines the interface to the stack monitor system service. The
+    service periodically samples the stack high water mark of every
+    registered task and keeps the worst case in memory which is not cleared
+    by a reset, so the figures accumulate over reboots until the next power
+    cycle. The "stackmon" console command prints the usage and a recommended
+    stack size for each task.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+#ifndef SYS_STACKMON_H
+#define SYS_STACKMON_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration Defaults
+// *****************************************************************************
+// *****************************************************************************
+
+/* Maximum number of monitored tasks, including the idle task */
+#ifndef SYS_STACKMON_MAX_TASKS
+#define SYS_STACKMON_MAX_TASKS          10
+#endif
+
+/* Sampling period of the high water marks */
+#ifndef SYS_STACKMON_PERIOD_MS
+#define SYS_STACKMON_PERIOD_MS          1000
+#endif
+
+/* Head room added to the worst case usage for the recommended size */
+#ifndef SYS_STACKMON_MARGIN_PERCENT
+#define SYS_STACKMON_MARGIN_PERCENT     25
+#endif
+
+/* Minimum head room, in stack words, for the recommended size */
+#ifndef SYS_STACKMON_MARGIN_MIN
+#define SYS_STACKMON_MARGIN_MIN         64
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_STACKMON_Initialize(void)
+
+  Summary:
+    Initializes the stack monitor.
+
+  Description:
+    Validates the worst case figures kept from before the reset, clearing
+    them after a power cycle, and registers the "stackmon" console command.
+
+  PreCondition:
+    SYS_CMD_Initialize has been called.
+
+  Parameters:
+    None.
+
+  Returns:
+    true if the commands were registered, false otherwise.
+
+  Remarks:
+    None.
+*/
+
+bool SYS_STACKMON_Initialize(void);
+
+// *****************************************************************************
+/* Function:
+    bool SYS_STACKMON_TaskRegister(TaskHandle_t handle, uint32_t stackDepth)
+
+  Summary:
+    Adds a task to the monitor.
+
+  Description:
+    The task is identified by its name across resets, its worst case is
+    restored if the same task was registered before the reset.
+
+  PreCondition:
+    SYS_STACKMON_Initialize has been called.
+
+  Parameters:
+    handle     - Task handle returned by xTaskCreate.
+    stackDepth - Stack depth passed to xTaskCreate, in words.
+
+  Returns:
+    true if the task was added, false if the table is full.
+
+  Example:
+    <code>
+    xTaskCreate(_SYS_CMD_Tasks, "SYS_CMD_TASKS", SYS_CMD_RTOS_STACK_SIZE,
+                NULL, SYS_CMD_RTOS_TASK_PRIORITY, &xSYS_CMD_Tasks);
+    SYS_STACKMON_TaskRegister(xSYS_CMD_Tasks, SYS_CMD_RTOS_STACK_SIZE);
+    </code>
+
+  Remarks:
+    Tasks are expected to be registered before the scheduler starts.
+*/
+
+bool SYS_STACKMON_TaskRegister(TaskHandle_t handle, uint32_t stackDepth);
+
+// *****************************************************************************
+/* Function:
+    void SYS_STACKMON_Tasks(void)
+
+  Summary:
+    Samples the stack high water marks.
+
+  Description:
+    Updates the worst case of every registered task once every
+    SYS_STACKMON_PERIOD_MS. Calls in between return immediately.
+
+  PreCondition:
+    SYS_STACKMON_Initialize has been called.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Remarks:
+    Called from the FreeRTOS idle hook, it never blocks.
+*/
+
+void SYS_STACKMON_Tasks(void);
+
+// *****************************************************************************
+/* Function:
+    void SYS_STACKMON_OverflowNotify(TaskHandle_t handle)
+
+  Summary:
+    Records a stack overflow of a task.
+
+  Description:
+    Marks the task as overflowed in the memory kept across resets, so the
+    overflow is reported by "stackmon" after the device is restarted.
+
+  PreCondition:
+    None.
+
+  Parameters:
+    handle - Task which overflowed its stack.
+
+  Returns:
+    None.
+
+  Remarks:
+    Called from vApplicationStackOverflowHook.
+*/
+
+void SYS_STACKMON_OverflowNotify(TaskHandle_t handle);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_STACKMON_H
@@ -153,32 +153,274 @@ static SYS_TIME_TIMER_OBJ* SYS_TIME_GetTimerObject(SYS_TIME_HANDLE handle)
     return NULL;
 }
 
+static inline uint64_t SYS_TIME_SwCounter64Get(void)
+{
+    /* Use non-volatile intermediates to prevent dual volatile access in single statement */
+    uint32_t swCounter64High = gSystemCounterObj.swCounter64High;
+    uint32_t swCounter64Low = gSystemCounterObj.swCounter64Low;
+
+    return (((uint64_t)swCounter64High << 32) | swCounter64Low);
+}
+
+/* Number of slots from the current slot to the next occupied slot of a wheel
+ * level, or _SYS_TIME_WHEEL_SLOTS if there is none. */
+static uint32_t SYS_TIME_WheelSlotDistance(uint32_t bitmap, uint32_t current, bool includeCurrent)
+{
+    uint32_t rotated = bitmap;
+
+    if (current != 0)
+    {
+        rotated = (bitmap >> current) | (bitmap << (_SYS_TIME_WHEEL_SLOTS - current));
+    }
+    if (includeCurrent == false)
+    {
+        rotated &= ~1UL;
+    }
+
+    return (rotated == 0) ? _SYS_TIME_WHEEL_SLOTS : (uint32_t)__builtin_ctz(rotated);
+}
+
+static void SYS_TIME_WheelLink(SYS_TIME_TIMER_OBJ* tmr)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    uint64_t wheelTime = counterObj->wheelTime;
+    uint64_t expiry = tmr->expiry;
+    uint32_t level;
+    uint32_t slot;
+
+    /* Timers already due go into the current level 0 slot */
+    if (expiry < wheelTime)
+    {
+        expiry = wheelTime;
+    }
+
+    for (level = 0; level < _SYS_TIME_WHEEL_LEVELS; level++)
+    {
+        if (((expiry >> _SYS_TIME_WHEEL_SHIFT(level)) - (wheelTime >> _SYS_TIME_WHEEL_SHIFT(level))) < _SYS_TIME_WHEEL_SLOTS)
+        {
+            break;
+        }
+    }
+
+    if (level == _SYS_TIME_WHEEL_LEVELS)
+    {
+        /* Beyond the wheel range. Park the timer in the farthest slot of the
+         * top level, it is placed again when that slot is cascaded. */
+        level = _SYS_TIME_WHEEL_LEVELS - 1;
+        expiry = ((wheelTime >> _SYS_TIME_WHEEL_SHIFT(level)) + _SYS_TIME_WHEEL_SLOTS - 1) << _SYS_TIME_WHEEL_SHIFT(level);
+    }
+
+    slot = (uint32_t)(expiry >> _SYS_TIME_WHEEL_SHIFT(level)) & _SYS_TIME_WHEEL_SLOT_MASK;
+
+    tmr->wheelLevel = level;
+    tmr->wheelSlot = slot;
+    tmr->tmrPrev = NULL;
+    tmr->tmrNext = counterObj->wheel[level][slot];
+    if (tmr->tmrNext != NULL)
+    {
+        tmr->tmrNext->tmrPrev = tmr;
+    }
+    counterObj->wheel[level][slot] = tmr;
+    counterObj->wheelBitmap[level] |= (1UL << slot);
+}
+
+static void SYS_TIME_WheelUnlink(SYS_TIME_TIMER_OBJ* tmr)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+
+    if (tmr->tmrPrev != NULL)
+    {
+        tmr->tmrPrev->tmrNext = tmr->tmrNext;
+    }
+    else
+    {
+        counterObj->wheel[tmr->wheelLevel][tmr->wheelSlot] = tmr->tmrNext;
+    }
+    if (tmr->tmrNext != NULL)
+    {
+        tmr->tmrNext->tmrPrev = tmr->tmrPrev;
+    }
+
+    if (counterObj->wheel[tmr->wheelLevel][tmr->wheelSlot] == NULL)
+    {
+        counterObj->wheelBitmap[tmr->wheelLevel] &= ~(1UL << tmr->wheelSlot);
+    }
+
+    tmr->tmrNext = NULL;
+    tmr->tmrPrev = NULL;
+}
+
+static uint64_t SYS_TIME_WheelNextExpiry(void)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    uint64_t wheelTime = counterObj->wheelTime;
+    uint64_t nextExpiry = _SYS_TIME_WHEEL_NO_EXPIRY;
+    uint64_t slotTime;
+    SYS_TIME_TIMER_OBJ* tmr;
+    uint32_t current;
+    uint32_t distance;
+    uint32_t level;
+
+    if (counterObj->wheelCount == 0)
+    {
+        return nextExpiry;
+    }
+
+    /* Level 0 timers expire on their exact count. All timers of the nearest
+     * occupied slot expire before the timers of any later slot. */
+    current = (uint32_t)(wheelTime >> _SYS_TIME_WHEEL_SHIFT(0)) & _SYS_TIME_WHEEL_SLOT_MASK;
+    distance = SYS_TIME_WheelSlotDistance(counterObj->wheelBitmap[0], current, true);
+    if (distance < _SYS_TIME_WHEEL_SLOTS)
+    {
+        for (tmr = counterObj->wheel[0][(current + distance) & _SYS_TIME_WHEEL_SLOT_MASK]; tmr != NULL; tmr = tmr->tmrNext)
+        {
+            if (tmr->expiry < nextExpiry)
+            {
+                nextExpiry = tmr->expiry;
+            }
+        }
+    }
+
+    /* Upper levels need attention when the wheel reaches their slot */
+    for (level = 1; level < _SYS_TIME_WHEEL_LEVELS; level++)
+    {
+        current = (uint32_t)(wheelTime >> _SYS_TIME_WHEEL_SHIFT(level)) & _SYS_TIME_WHEEL_SLOT_MASK;
+        distance = SYS_TIME_WheelSlotDistance(counterObj->wheelBitmap[level], current, false);
+        if (distance < _SYS_TIME_WHEEL_SLOTS)
+        {
+            slotTime = ((wheelTime >> _SYS_TIME_WHEEL_SHIFT(level)) + distance) << _SYS_TIME_WHEEL_SHIFT(level);
+            if (slotTime < nextExpiry)
+            {
+                nextExpiry = slotTime;
+            }
+        }
+    }
+
+    return nextExpiry;
+}
+
+/* Start of the next slot, at any level, the wheel has to visit */
+static uint64_t SYS_TIME_WheelNextSlotTime(void)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    uint64_t wheelTime = counterObj->wheelTime;
+    uint64_t nextSlotTime = _SYS_TIME_WHEEL_NO_EXPIRY;
+    uint64_t slotTime;
+    uint32_t current;
+    uint32_t distance;
+    uint32_t level;
+
+    for (level = 0; level < _SYS_TIME_WHEEL_LEVELS; level++)
+    {
+        current = (uint32_t)(wheelTime >> _SYS_TIME_WHEEL_SHIFT(level)) & _SYS_TIME_WHEEL_SLOT_MASK;
+        distance = SYS_TIME_WheelSlotDistance(counterObj->wheelBitmap[level], current, false);
+        if (distance < _SYS_TIME_WHEEL_SLOTS)
+        {
+            slotTime = ((wheelTime >> _SYS_TIME_WHEEL_SHIFT(level)) + distance) << _SYS_TIME_WHEEL_SHIFT(level);
+            if (slotTime < nextSlotTime)
+            {
+                nextSlotTime = slotTime;
+            }
+        }
+    }
+
+    return nextSlotTime;
+}
+
+/* Advances the wheel up to the current count and returns the timers that have
+ * expired, chained through tmrExpiredNext. Called from the timer interrupt
+ * only, the thread side keeps the interrupt disabled while it modifies the
+ * wheel, so no further locking is needed here. */
+static SYS_TIME_TIMER_OBJ* SYS_TIME_WheelAdvance(uint64_t now)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    SYS_TIME_TIMER_OBJ* tmrExpired = NULL;
+    SYS_TIME_TIMER_OBJ** tmrExpiredTail = &tmrExpired;
+    SYS_TIME_TIMER_OBJ* tmr;
+    SYS_TIME_TIMER_OBJ* tmrNext;
+    uint64_t nextSlotTime;
+    uint32_t current;
+    uint32_t level;
+
+    while (1)
+    {
+        /* Cascade the current slot of the upper levels, top down, so that a
+         * timer can move more than one level in a single step */
+        for (level = _SYS_TIME_WHEEL_LEVELS - 1; level > 0; level--)
+        {
+            current = (uint32_t)(counterObj->wheelTime >> _SYS_TIME_WHEEL_SHIFT(level)) & _SYS_TIME_WHEEL_SLOT_MASK;
+            tmr = counterObj->wheel[level][current];
+            counterObj->wheel[level][current] = NULL;
+            counterObj->wheelBitmap[level] &= ~(1UL << current);
+
+            while (tmr != NULL)
+            {
+                tmrNext = tmr->tmrNext;
+                SYS_TIME_WheelLink(tmr);
+                tmr = tmrNext;
+            }
+        }
+
+        /* Expire the due timers of the current level 0 slot */
+        current = (uint32_t)(counterObj->wheelTime >> _SYS_TIME_WHEEL_SHIFT(0)) & _SYS_TIME_WHEEL_SLOT_MASK;
+        tmr = counterObj->wheel[0][current];
+        while (tmr != NULL)
+        {
+            tmrNext = tmr->tmrNext;
+            if (tmr->expiry <= now)
+            {
+                SYS_TIME_WheelUnlink(tmr);
+                counterObj->wheelCount--;
+                tmr->wheelLevel = _SYS_TIME_WHEEL_EXPIRED;
+                tmr->tmrExpiredNext = NULL;
+                *tmrExpiredTail = tmr;
+                tmrExpiredTail = &tmr->tmrExpiredNext;
+            }
+            tmr = tmrNext;
+        }
+
+        nextSlotTime = SYS_TIME_WheelNextSlotTime();
+        if ((nextSlotTime == _SYS_TIME_WHEEL_NO_EXPIRY) || (nextSlotTime > now))
+        {
+            break;
+        }
+        counterObj->wheelTime = nextSlotTime;
+    }
+
+    /* No occupied slot starts before now, the wheel can skip ahead */
+    if (now > counterObj->wheelTime)
+    {
+        counterObj->wheelTime = now;
+    }
+
+    return tmrExpired;
+}
+
 static void SYS_TIME_HwTimerCompareUpdate(void)
 {
     uint64_t nextHwCounterValue = 0;
     uint64_t currHwCounterValue;
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
+    uint64_t now = SYS_TIME_SwCounter64Get();
+    uint64_t nextExpiry = SYS_TIME_WheelNextExpiry();
+    uint32_t relativeTimePending = SYS_TIME_HW_COUNTER_HALF_PERIOD;
 
     counterObj->hwTimerPreviousValue = counterObj->hwTimerCurrentValue;
 
-    if (tmrActive != NULL)
+    if (nextExpiry != _SYS_TIME_WHEEL_NO_EXPIRY)
     {
-        if (tmrActive->relativeTimePending > SYS_TIME_HW_COUNTER_HALF_PERIOD)
+        if (nextExpiry <= now)
         {
-            nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + SYS_TIME_HW_COUNTER_HALF_PERIOD;
+            relativeTimePending = 0;
         }
-        else
+        else if ((nextExpiry - now) < SYS_TIME_HW_COUNTER_HALF_PERIOD)
         {
-            /* Use a non-volatile intermediate to prevent dual volatile access in single statement */
-            uint32_t relativeTimePending = tmrActive->relativeTimePending;
-            nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + relativeTimePending;
+            relativeTimePending = (uint32_t)(nextExpiry - now);
         }
     }
-    else
-    {
-        nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + SYS_TIME_HW_COUNTER_HALF_PERIOD;
-    }
+
+    counterObj->tmrDeadline = now + relativeTimePending;
+    nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + relativeTimePending;
 
     currHwCounterValue = counterObj->timePlib->timerCounterGet();
 
@@ -239,145 +481,84 @@ static void SYS_TIME_Counter64Update(uint32_t elapsedCount)
     }
 }
 
-static bool SYS_TIME_RemoveFromList(SYS_TIME_TIMER_OBJ* delTimer)
+static void SYS_TIME_RemoveFromList(SYS_TIME_TIMER_OBJ* delTimer)
 {
-    SYS_TIME_COUNTER_OBJ* counter = (SYS_TIME_COUNTER_OBJ *)&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmr = counter->tmrActive;
-    SYS_TIME_TIMER_OBJ* prevTmr = NULL;
-    bool isHeadTimerUpdated = false;
-
-    tmr = counter->tmrActive;
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ *)&gSystemCounterObj;
 
-    /* Find the timer to be deleted from the linked list */
-    while ((tmr != NULL) && (tmr != delTimer))
+    if (delTimer->wheelLevel < _SYS_TIME_WHEEL_LEVELS)
     {
-        prevTmr = tmr;
-        tmr = tmr->tmrNext;
+        SYS_TIME_WheelUnlink(delTimer);
+        counterObj->wheelCount--;
     }
 
-    /* Could not find the timer in the list? return */
-    if (tmr == NULL)
-    {
-        return isHeadTimerUpdated;
-    }
+    /* A timer waiting in the expired list of the interrupt is skipped
+     * once it is no longer marked as expired */
+    delTimer->wheelLevel = _SYS_TIME_WHEEL_NONE;
+}
 
-    /* Add the deleted timer pending time to the next timer in the list */
-    if (delTimer->tmrNext != NULL)
-    {
-        /* Use a non-volatile intermediate to prevent dual volatile access in single statement */
-        uint32_t relativeTimePending = delTimer->relativeTimePending;
-        delTimer->tmrNext->relativeTimePending += relativeTimePending;
-    }
+static uint32_t SYS_TIME_GetElapsedCount(uint32_t hwTimerCurrentValue)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    uint32_t elapsedCount = 0;
 
-    /* If the deleted timer was at the head of the list */
-    if (prevTmr == NULL)
+    /* Calculate the elapsed time since the last time the software counter
+     * was updated. */
+    if (hwTimerCurrentValue > counterObj->hwTimerPreviousValue)
     {
-        counter->tmrActive = counter->tmrActive->tmrNext;
-        isHeadTimerUpdated = true;
+        elapsedCount = hwTimerCurrentValue - counterObj->hwTimerPreviousValue;
     }
     else
     {
-        /* If the deleted timer was not the head of the list */
-        prevTmr->tmrNext = delTimer->tmrNext;
+        elapsedCount = (SYS_TIME_HW_COUNTER_PERIOD - counterObj->hwTimerPreviousValue) + hwTimerCurrentValue + 1;
     }
 
-    delTimer->tmrNext = NULL;
+    return elapsedCount;
 
-    return isHeadTimerUpdated;
 }
 
-static bool SYS_TIME_AddToList(SYS_TIME_TIMER_OBJ* newTimer)
+/* Brings the software counter up to date with the hardware counter and returns
+ * it. Timer expiries are kept against this counter, which unlike the value
+ * returned by SYS_TIME_Counter64Get is not affected by SYS_TIME_CounterSet. */
+static uint64_t SYS_TIME_CounterSync(void)
 {
-    uint64_t total_time = 0;
-    SYS_TIME_COUNTER_OBJ* counter = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmr = counter->tmrActive;
-    SYS_TIME_TIMER_OBJ* prevTmr = NULL;
-    uint32_t newTimerTime;
-    bool isHeadTimerUpdated = false;
-
-    if (newTimer == NULL)
-    {
-        return isHeadTimerUpdated;
-    }
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
 
-    newTimerTime = newTimer->relativeTimePending;
+    counterObj->hwTimerCurrentValue = counterObj->timePlib->timerCounterGet();
 
-    if (tmr == NULL)
-    {
-        /* Add the new timer to the top of the list */
-        newTimer->relativeTimePending = newTimerTime;
-        counter->tmrActive = newTimer;
-        isHeadTimerUpdated = true;
-    }
-    else
-    {
-        /* Find appropriate location to insert the new timer */
-        while (tmr != NULL)
-        {
-            if ((total_time + tmr->relativeTimePending) > newTimerTime)
-            {
-                break;
-            }
-            total_time += tmr->relativeTimePending;
-            prevTmr = tmr;
-            tmr = tmr->tmrNext;
-        }
+    SYS_TIME_Counter64Update(SYS_TIME_GetElapsedCount(counterObj->hwTimerCurrentValue));
 
-        /* The new timer must be inserted to the head of the list */
-        if (prevTmr == NULL)
-        {
-            /* head = newTimer*/
-            counter->tmrActive = newTimer;
-            /* head->next = previous head */
-            newTimer->tmrNext = tmr;
-            isHeadTimerUpdated = true;
-        }
-        else
-        {
-            newTimer->tmrNext = prevTmr->tmrNext;
-            prevTmr->tmrNext = newTimer;
-        }
+    counterObj->hwTimerPreviousValue = counterObj->hwTimerCurrentValue;
 
-        /* Update the relative times */
-        newTimer->relativeTimePending = newTimerTime - total_time;
-        if (newTimer->tmrNext != NULL)
-        {
-            /* Subtract the new timers time from the next timer in the list */
-            /* Use a non-volatile intermediate to prevent dual volatile access in single statement */
-            newTimerTime = newTimer->relativeTimePending;
-            newTimer->tmrNext->relativeTimePending -= newTimerTime;
-        }
-    }
-    return isHeadTimerUpdated;
+    return SYS_TIME_SwCounter64Get();
 }
 
-static uint32_t SYS_TIME_GetElapsedCount(uint32_t hwTimerCurrentValue)
+/* Same as SYS_TIME_CounterSync, without updating the software counter */
+static uint64_t SYS_TIME_CounterPeek(void)
 {
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    uint32_t elapsedCount = 0;
+    uint64_t counter64;
+    uint32_t counter32;
+    uint32_t elapsedCount;
+    uint8_t isSwCounter32Oveflow = false;
 
-    /* Calculate the elapsed time since the last time the timers in the list
-     * were updated. */
-    if (hwTimerCurrentValue > counterObj->hwTimerPreviousValue)
-    {
-        elapsedCount = hwTimerCurrentValue - counterObj->hwTimerPreviousValue;
-    }
-    else
+    elapsedCount = SYS_TIME_GetElapsedCount(counterObj->timePlib->timerCounterGet());
+
+    counter32 = SYS_TIME_Counter32Update(elapsedCount, &isSwCounter32Oveflow);
+    counter64 = counterObj->swCounter64High;
+
+    if (isSwCounter32Oveflow == true)
     {
-        elapsedCount = (SYS_TIME_HW_COUNTER_PERIOD - counterObj->hwTimerPreviousValue) + hwTimerCurrentValue + 1;
+        counter64++;
     }
 
-    return elapsedCount;
-
+    return ((counter64 << 32) + counter32);
 }
 
 static uint32_t SYS_TIME_GetTotalElapsedCount(SYS_TIME_TIMER_OBJ* tmr)
 {
-    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
+    uint64_t now;
     uint32_t pendingCount = 0;
     uint32_t elapsedCount = 0;
-    uint32_t hwTimerCurrentValue;
 
     if (tmr->active == false)
     {
@@ -385,29 +566,16 @@ static uint32_t SYS_TIME_GetTotalElapsedCount(SYS_TIME_TIMER_OBJ* tmr)
     }
     else
     {
-        /* Add time from all timers in the front */
-        while ((tmrActive != NULL) && (tmrActive != tmr))
-        {
-            pendingCount += tmrActive->relativeTimePending;
-            tmrActive = tmrActive->tmrNext;
-        }
-        /* Add the pending time of the requested timer */
-        pendingCount += tmrActive->relativeTimePending;
-        hwTimerCurrentValue = counterObj->timePlib->timerCounterGet();
-        elapsedCount = SYS_TIME_GetElapsedCount(hwTimerCurrentValue);
+        now = SYS_TIME_CounterPeek();
 
-        if (pendingCount >= elapsedCount)
-        {
-            pendingCount -= elapsedCount;
-        }
-        else
+        if (tmr->expiry > now)
         {
-            pendingCount = 0;
+            pendingCount = (uint32_t)(tmr->expiry - now);
         }
 
-        if (tmrActive->requestedTime >= pendingCount)
+        if (tmr->requestedTime >= pendingCount)
         {
-            elapsedCount = tmrActive->requestedTime - pendingCount;
+            elapsedCount = tmr->requestedTime - pendingCount;
         }
         else
         {
@@ -418,50 +586,28 @@ static uint32_t SYS_TIME_GetTotalElapsedCount(SYS_TIME_TIMER_OBJ* tmr)
     return elapsedCount;
 }
 
-static void SYS_TIME_UpdateTimerList(uint32_t elapsedCount)
-{
-    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmr = NULL;
-
-    tmr = counterObj->tmrActive;
-
-    while ((tmr != NULL) && (elapsedCount > 0))
-    {
-        if (tmr->relativeTimePending >= elapsedCount)
-        {
-            tmr->relativeTimePending -= elapsedCount;
-            elapsedCount = 0;
-        }
-        else
-        {
-            /* The timer has probably expired */
-            elapsedCount -= tmr->relativeTimePending;
-            tmr->relativeTimePending = 0;
-        }
-        tmr = tmr->tmrNext;
-    }
-
-    counterObj->hwTimerPreviousValue = counterObj->hwTimerCurrentValue;
-}
-
 static void SYS_TIME_TimerAdd(SYS_TIME_TIMER_OBJ* newTimer)
 {
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    uint32_t elapsedCount = 0;
-    bool isHeadTimerUpdated = false;
+    uint64_t now;
     bool interruptState;
 
-    counterObj->hwTimerCurrentValue = counterObj->timePlib->timerCounterGet();
-
-    elapsedCount = SYS_TIME_GetElapsedCount(counterObj->hwTimerCurrentValue);
-
-    SYS_TIME_UpdateTimerList(elapsedCount);
-
-    SYS_TIME_Counter64Update(elapsedCount);
+    if (counterObj->interruptNestingCount == 0)
+    {
+        now = SYS_TIME_CounterSync();
+    }
+    else
+    {
+        /* The counter was synchronized on entry to the interrupt, the compare
+         * is reprogrammed when the interrupt completes */
+        now = SYS_TIME_SwCounter64Get();
+    }
 
-    isHeadTimerUpdated = SYS_TIME_AddToList(newTimer);
+    newTimer->expiry = now + newTimer->relativeTimePending;
+    SYS_TIME_WheelLink(newTimer);
+    counterObj->wheelCount++;
 
-    if (isHeadTimerUpdated == true)
+    if ((counterObj->interruptNestingCount == 0) && (newTimer->expiry < counterObj->tmrDeadline))
     {
         interruptState = SYS_INT_Disable();
         SYS_TIME_HwTimerCompareUpdate();
@@ -469,78 +615,86 @@ static void SYS_TIME_TimerAdd(SYS_TIME_TIMER_OBJ* newTimer)
     }
 }
 
-static void SYS_TIME_ClientNotify(void)
+static void SYS_TIME_TimerObjectFree(SYS_TIME_TIMER_OBJ* tmr)
 {
-    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
+    SYS_TIME_RemoveFromList(tmr);
+    tmr->active = false;
+    tmr->tmrElapsedFlag = false;
+    tmr->tmrElapsed = false;
+    tmr->inUse = false;
+    tmr->tmrNext = gSystemCounterObj.tmrFree;
+    gSystemCounterObj.tmrFree = tmr;
+}
 
-    while (tmrActive != NULL)
+static void SYS_TIME_ClientNotify(SYS_TIME_TIMER_OBJ* tmrExpired, uint64_t now)
+{
+    SYS_TIME_TIMER_OBJ* tmr;
+    SYS_TIME_CALLBACK callback;
+    uintptr_t context;
+
+    while (tmrExpired != NULL)
     {
-        if(tmrActive->relativeTimePending == 0)
+        tmr = tmrExpired;
+        tmrExpired = tmr->tmrExpiredNext;
+        tmr->tmrExpiredNext = NULL;
+
+        /* Skip timers stopped, reloaded or destroyed from an earlier callback */
+        if (tmr->wheelLevel != _SYS_TIME_WHEEL_EXPIRED)
         {
-            tmrActive->tmrElapsedFlag = true;
-            tmrActive->tmrElapsed = true;
+            continue;
+        }
+        tmr->wheelLevel = _SYS_TIME_WHEEL_NONE;
+
+        tmr->tmrElapsedFlag = true;
+        tmr->tmrElapsed = true;
+        callback = tmr->callback;
+        context = tmr->context;
 
-            if ((tmrActive->type == SYS_TIME_SINGLE) && (tmrActive->callback != NULL))
+        if (tmr->type == SYS_TIME_SINGLE)
+        {
+            tmr->relativeTimePending = 0;
+            if (callback != NULL)
             {
                 /* Destroy single shot timer for which the callback is registered */
-                SYS_TIME_TimerDestroy(tmrActive->tmrHandle);
+                SYS_TIME_TimerObjectFree(tmr);
             }
             else
             {
-                /* For periodic timers and delay timers, just remove from the list */
-                /* Removing from list does not clear active flag */
-                SYS_TIME_RemoveFromList(tmrActive);
-                if (tmrActive->type == SYS_TIME_SINGLE)
-                {
-                    /* Delay timers become inactive after expiry. */
-                    tmrActive->active = false;
-                }
-            }
-
-            if(tmrActive->callback != NULL)
-            {
-                tmrActive->callback(tmrActive->context);
+                /* Delay timers become inactive after expiry. */
+                tmr->active = false;
             }
-
-            tmrActive = counterObj->tmrActive;
         }
-        else
+
+        if (callback != NULL)
         {
-            break;
+            callback(context);
         }
-    }
-}
 
-static void SYS_TIME_UpdateTime(uint32_t elapsedCounts)
-{
-    uint8_t i;
-
-    SYS_TIME_UpdateTimerList(elapsedCounts);
-
-    SYS_TIME_ClientNotify();
-
-    /* Add the removed timers back into the linked list if the timer type is periodic. */
-    for ( i = 0; i < SYS_TIME_MAX_TIMERS; i++)
-    {
         /* tmrElapsed is cleared anytime a timer is stopped, started, reloaded
          * or destroyed.
-         * If timer is stopped from CB, there is no need to add it back to list
-         * If timer is started from CB, it is already added to list by start routine
-         * If timer is reloaded from CB, it is already added to list by reload routine
-         * If timer is destroyed from CB, there is no need to add it back to list
+         * If timer is stopped from CB, there is no need to add it back to the wheel
+         * If timer is started from CB, it is already added to the wheel by start routine
+         * If timer is reloaded from CB, it is already added to the wheel by reload routine
+         * If timer is destroyed from CB, there is no need to add it back to the wheel
          * Note: tmrElapsedFlag is cleared when the application reads the status
          * by calling the SYS_TIME_TimerPeriodHasExpired API.
          */
-        if (timers[i].tmrElapsed == true)
+        if (tmr->tmrElapsed == true)
         {
-            timers[i].tmrElapsed = false;
+            tmr->tmrElapsed = false;
 
-            if (timers[i].type == SYS_TIME_PERIODIC)
+            if (tmr->type == SYS_TIME_PERIODIC)
             {
-                /* Reload the relative pending time with the requested time */
-                timers[i].relativeTimePending = timers[i].requestedTime;
-                SYS_TIME_AddToList(&timers[i]);
+                /* Keep the period phase unless the timer has fallen a full
+                 * period behind */
+                tmr->expiry += tmr->requestedTime;
+                if (tmr->expiry <= now)
+                {
+                    tmr->expiry = now + tmr->requestedTime;
+                }
+                tmr->relativeTimePending = tmr->requestedTime;
+                SYS_TIME_WheelLink(tmr);
+                gSystemCounterObj.wheelCount++;
             }
         }
     }
@@ -549,25 +703,26 @@ static void SYS_TIME_UpdateTime(uint32_t elapsedCounts)
 static void SYS_TIME_PLIBCallback(uint32_t status, uintptr_t context)
 {
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ *)&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
-    uint32_t elapsedCount = 0;
+    SYS_TIME_TIMER_OBJ* tmrExpired;
+    uint64_t now;
     bool interruptState;
 
-    counterObj->hwTimerCurrentValue = counterObj->timePlib->timerCounterGet();
-
-    elapsedCount = SYS_TIME_GetElapsedCount(counterObj->hwTimerCurrentValue);
-	
-	SYS_TIME_Counter64Update(elapsedCount);
+    now = SYS_TIME_CounterSync();
 
-    if (tmrActive != NULL)
+    if (counterObj->wheelCount != 0)
     {
         counterObj->interruptNestingCount++;
 
-        SYS_TIME_UpdateTime(elapsedCount);
+        tmrExpired = SYS_TIME_WheelAdvance(now);
+        SYS_TIME_ClientNotify(tmrExpired, now);
 
         counterObj->interruptNestingCount--;
     }
-    
+    else
+    {
+        counterObj->wheelTime = now;
+    }
+
     interruptState = SYS_INT_Disable();
     SYS_TIME_HwTimerCompareUpdate();
     SYS_INT_Restore(interruptState);
@@ -589,33 +744,31 @@ static SYS_TIME_HANDLE SYS_TIME_TimerObjectCreate(
     {
         return tmrHandle;
     }
-    if((gSystemCounterObj.status == SYS_STATUS_READY) && (period > 0) && (period >= count))
+    if((gSystemCounterObj.status == SYS_STATUS_READY) && (period > 0) && (period >= count) && (gSystemCounterObj.tmrFree != NULL))
     {
-        for(tmr = timers; tmr < &timers[SYS_TIME_MAX_TIMERS]; tmr++)
-        {
-            if(tmr->inUse == false)
-            {
-                tmr->inUse = true;
-                tmr->active = false;
-                tmr->tmrElapsedFlag = false;
-                tmr->tmrElapsed = false;
-                tmr->type = type;
-                tmr->requestedTime = period;
-                tmr->callback = callBack;
-                tmr->context = context;
-                tmr->relativeTimePending = period - count;
-
-                /* Assign a handle to this request. The timer handle must be unique. */
-                tmr->tmrHandle = (SYS_TIME_HANDLE) SYS_TIME_MAKE_HANDLE(gSysTimeTokenCount, tmrObjIndex);
-                /* Update the token number. */
-                gSysTimeTokenCount = SYS_TIME_UPDATE_TOKEN(gSysTimeTokenCount);
-
-                tmrHandle = tmr->tmrHandle;
-
-                break;
-            }
-            tmrObjIndex++;
-        }
+        tmr = gSystemCounterObj.tmrFree;
+        gSystemCounterObj.tmrFree = tmr->tmrNext;
+        tmrObjIndex = tmr - timers;
+
+        tmr->inUse = true;
+        tmr->active = false;
+        tmr->tmrElapsedFlag = false;
+        tmr->tmrElapsed = false;
+        tmr->type = type;
+        tmr->requestedTime = period;
+        tmr->callback = callBack;
+        tmr->context = context;
+        tmr->relativeTimePending = period - count;
+        tmr->wheelLevel = _SYS_TIME_WHEEL_NONE;
+        tmr->tmrNext = NULL;
+        tmr->tmrPrev = NULL;
+
+        /* Assign a handle to this request. The timer handle must be unique. */
+        tmr->tmrHandle = (SYS_TIME_HANDLE) SYS_TIME_MAKE_HANDLE(gSysTimeTokenCount, tmrObjIndex);
+        /* Update the token number. */
+        gSysTimeTokenCount = SYS_TIME_UPDATE_TOKEN(gSysTimeTokenCount);
+
+        tmrHandle = tmr->tmrHandle;
     }
 
     SYS_TIME_ResourceUnlock();
@@ -642,7 +795,12 @@ static void SYS_TIME_CounterInit(SYS_MODULE_INIT* init)
 
     counterObj->swCounter64Low = 0;
     counterObj->swCounter64High = 0;
-    counterObj->tmrActive = NULL;
+    counterObj->swCounterOffset = 0;
+    counterObj->tmrDeadline = SYS_TIME_HW_COUNTER_HALF_PERIOD;
+    counterObj->wheelTime = 0;
+    counterObj->wheelCount = 0;
+    memset(counterObj->wheelBitmap, 0, sizeof(counterObj->wheelBitmap));
+    memset(counterObj->wheel, 0, sizeof(counterObj->wheel));
     counterObj->interruptNestingCount = 0;
 
     counterObj->timePlib->timerCallbackSet(SYS_TIME_PLIBCallback, 0);
@@ -661,6 +819,8 @@ static void SYS_TIME_CounterInit(SYS_MODULE_INIT* init)
 // *****************************************************************************
 SYS_MODULE_OBJ SYS_TIME_Initialize( const SYS_MODULE_INDEX index, const SYS_MODULE_INIT * const init )
 {
+    int tmrIx;
+
     if(init == 0 || index != SYS_TIME_INDEX_0)
     {
         return SYS_MODULE_OBJ_INVALID;
@@ -671,8 +831,16 @@ SYS_MODULE_OBJ SYS_TIME_Initialize( const SYS_MODULE_INDEX index, const SYS_MODU
         return SYS_MODULE_OBJ_INVALID;
     }
 
-    SYS_TIME_CounterInit((SYS_MODULE_INIT *)init);
     memset(timers, 0, sizeof(timers));
+    gSystemCounterObj.tmrFree = NULL;
+    for (tmrIx = SYS_TIME_MAX_TIMERS - 1; tmrIx >= 0; tmrIx--)
+    {
+        timers[tmrIx].wheelLevel = _SYS_TIME_WHEEL_NONE;
+        timers[tmrIx].tmrNext = gSystemCounterObj.tmrFree;
+        gSystemCounterObj.tmrFree = &timers[tmrIx];
+    }
+
+    SYS_TIME_CounterInit((SYS_MODULE_INIT *)init);
 
     gSystemCounterObj.status = SYS_STATUS_READY;
 
@@ -723,28 +891,14 @@ uint32_t SYS_TIME_FrequencyGet ( void )
 
 uint64_t SYS_TIME_Counter64Get ( void )
 {
-    SYS_TIME_COUNTER_OBJ * counterObj = (SYS_TIME_COUNTER_OBJ *)&gSystemCounterObj;
     uint64_t counter64 = 0;
-    uint32_t counter32 = 0;
-    uint32_t elapsedCount;
-    uint8_t isSwCounter32Oveflow = false;
 
     if (SYS_TIME_ResourceLock() == false)
     {
         return counter64;
     }
 
-    elapsedCount = SYS_TIME_GetElapsedCount(counterObj->timePlib->timerCounterGet());
-
-    counter32 = SYS_TIME_Counter32Update(elapsedCount, &isSwCounter32Oveflow);
-    counter64 = counterObj->swCounter64High;
-
-    if (isSwCounter32Oveflow == true)
-    {
-        counter64++;
-    }
-
-    counter64 = ((counter64 << 32) + counter32);
+    counter64 = SYS_TIME_CounterPeek() + gSystemCounterObj.swCounterOffset;
 
     SYS_TIME_ResourceUnlock();
 
@@ -767,8 +921,8 @@ void SYS_TIME_CounterSet ( uint32_t count )
         return;
     }
 
-    gSystemCounterObj.swCounter64Low = count;
-    gSystemCounterObj.swCounter64High = 0;
+    /* The running timers keep their expiry, only the reported value moves */
+    gSystemCounterObj.swCounterOffset = (uint64_t)count - SYS_TIME_CounterPeek();
 
     SYS_TIME_ResourceUnlock();
 }
@@ -855,14 +1009,7 @@ SYS_TIME_RESULT SYS_TIME_TimerReload(
         tmr->relativeTimePending = period - count;
         tmr->callback = callBack;
         tmr->context = context;
-        if (gSystemCounterObj.interruptNestingCount == 0)
-        {
-            SYS_TIME_TimerAdd(tmr);
-        }
-        else
-        {
-            SYS_TIME_AddToList(tmr);
-        }
+        SYS_TIME_TimerAdd(tmr);
         tmr->active = true;
         result = SYS_TIME_SUCCESS;
     }
@@ -885,14 +1032,7 @@ SYS_TIME_RESULT SYS_TIME_TimerDestroy(SYS_TIME_HANDLE handle)
 
     if(tmr != NULL)
     {
-        if(tmr->active == true)
-        {
-            SYS_TIME_RemoveFromList(tmr);
-            tmr->active = false;
-        }
-        tmr->tmrElapsedFlag = false;
-        tmr->tmrElapsed = false;
-        tmr->inUse = false;
+        SYS_TIME_TimerObjectFree(tmr);
         result = SYS_TIME_SUCCESS;
     }
 
@@ -924,14 +1064,7 @@ SYS_TIME_RESULT SYS_TIME_TimerStart(SYS_TIME_HANDLE handle)
             {
                 tmr->relativeTimePending = tmr->requestedTime;
             }
-            if (gSystemCounterObj.interruptNestingCount == 0)
-            {
-                SYS_TIME_TimerAdd(tmr);
-            }
-            else
-            {
-                SYS_TIME_AddToList(tmr);
-            }
+            SYS_TIME_TimerAdd(tmr);
             tmr->tmrElapsedFlag = false;
             tmr->tmrElapsed = false;
             tmr->active = true;
@@ -131,6 +131,10 @@ typedef enum
     /* Updating Wi-Fi Connect status for enabling Wi-Fi Provisioning service */
     SYS_WIFIPROV_CONNECT,        
 
+    /* Callback only: the service has an NVM operation pending and 
+       SYS_WIFIPROV_Tasks needs to run */
+    SYS_WIFIPROV_TASKPENDING,
+
 } SYS_WIFIPROV_CTRLMSG ;
 
 // *****************************************************************************
@@ -29,6 +29,7 @@
 
 #include "app_ble.h"
 #include "definitions.h"
+#include "system/ring/sys_ring.h"
 #include "string.h"
 #include "stdlib.h"
 
@@ -61,6 +62,14 @@ static bool dataReady = false ;
 // Used to detect provisioning frame in transparent data mode
 static bool provStrFiltering = false ;
 static uint8_t provStrLen = 0 ;
+// Bytes received by BLE_RxHandler, waiting to be parsed by the task
+static SYS_RING bleRxRing ;
+static char bleRxRingBuffer[BLE_RX_RING_SIZE] ;
+static OSAL_SEM_DECLARE(bleRxSemaphore) ;
+// Bytes dropped by BLE_RxHandler because the ring was full, and the part
+// of it already reported by the task
+static volatile uint32_t bleRxOverflowCount = 0 ;
+static uint32_t bleRxOverflowReported = 0 ;
 
 #define APP_BLE_PRINT_ALL_MSG       0   // print all message received
 #define APP_BLE_PRINT_STATUS_MSG    0   // print status message
@@ -78,16 +87,44 @@ void BLE_RxHandler(uintptr_t context)
 {
     if (UART2_ErrorGet() == UART_ERROR_NONE)
     {
+        // hand the byte over to the task, parsing is done by BLE_RxProcess
+        if (!SYS_RING_PutISR(&bleRxRing, (void*)&app_bleData.rxData))
+        {   // the task is late, the byte is lost
+            bleRxOverflowCount++ ;
+        }
         // read one byte
         UART2_Read((void*)&app_bleData.rxData, 1) ;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// Parse the bytes received from the RN487X since the last call
+void BLE_RxProcess(void)
+{
+    char rxData ;
+    uint32_t overflowCount = bleRxOverflowCount ;
+
+    if (overflowCount != bleRxOverflowReported)
+    {
+        SYS_CONSOLE_PRINT("\r\n[APP_BLE] RX ring overflow, %lu bytes dropped\r\n", overflowCount - bleRxOverflowReported) ;
+        bleRxOverflowReported = overflowCount ;
+    }
+
+    while (SYS_RING_Get(&bleRxRing, &rxData))
+    {
 #if (APP_BLE_PRINT_ALL_MSG == 1)
         //for debug - printing any data received
-        UART1_Write((void*)&app_bleData.rxData, 1) ;
+        UART1_Write((void*)&rxData, 1) ;
 #endif
         // handle if status message received (%MSG%)
         if (asyncFiltering == false)
         {
-            if (app_bleData.rxData == STATUS_MESSAGE_DELIMITER)
+            if (rxData == STATUS_MESSAGE_DELIMITER)
             {   // first delimiter found, do not capture data
                 // prepare to filter further incoming data until next delimiter
                 asyncFiltering = true ;
@@ -99,7 +136,7 @@ void BLE_RxHandler(uintptr_t context)
         }
         else
         {   // capture data in a dedicated buffer for status message
-            if (app_bleData.rxData == STATUS_MESSAGE_DELIMITER)
+            if (rxData == STATUS_MESSAGE_DELIMITER)
             {   // second delimiter found, do not capture data
                 asyncFiltering = false ;
                 app_bleData.statusMsgBuffer[app_bleData.statusMsgBufferIndex] = '\0' ;
@@ -109,10 +146,10 @@ void BLE_RxHandler(uintptr_t context)
             }
             else
             {   // fill status message buffer
-                BLE_FillStatusBuffer(app_bleData.rxData) ;
+                BLE_FillStatusBuffer(rxData) ;
 #if (APP_BLE_PRINT_STATUS_MSG == 1)
                 //for debug - printing only status message
-                UART1_Write((void*)&app_bleData.rxData, 1) ;
+                UART1_Write((void*)&rxData, 1) ;
 #endif
             }
         }
@@ -122,12 +159,12 @@ void BLE_RxHandler(uintptr_t context)
             dataReady = false ;
 #if (APP_BLE_PRINT_RX_MSG == 1)
             //for debug - printing RX message
-            UART1_Write((void*)&app_bleData.rxData, 1) ;
+            UART1_Write((void*)&rxData, 1) ;
 #endif
             if (app_bleData.configurationDone == false)
             {   // in configuration mode
                 // capture data in reception buffer
-                BLE_FillRxBuffer(app_bleData.rxData) ;
+                BLE_FillRxBuffer(rxData) ;
             }
             else
             {   // in transparent data mode
@@ -137,7 +174,7 @@ void BLE_RxHandler(uintptr_t context)
                 // search for provisioning frame
                 if (provStrFiltering == false)
                 {
-                    if (app_bleData.rxData == PROVISIONING_STX)
+                    if (rxData == PROVISIONING_STX)
                     {   // start of provisioning string
                         provStrFiltering = true ;
                         provStrLen = 0 ;
@@ -145,7 +182,7 @@ void BLE_RxHandler(uintptr_t context)
                 }
                 else
                 {
-                    if (app_bleData.rxData == PROVISIONING_ETX)
+                    if (rxData == PROVISIONING_ETX)
                     {   // end of provisioning string
                         provStrFiltering = false ;
                         //app_bleData.rxBuffer[app_bleData.rxBufferIndex] = '\0' ;
@@ -156,7 +193,7 @@ void BLE_RxHandler(uintptr_t context)
                     else
                     {
                         provStrLen++ ;
-                        BLE_FillRxBuffer(app_bleData.rxData) ;
+                        BLE_FillRxBuffer(rxData) ;
                     }
                 }           
             }
@@ -164,12 +201,6 @@ void BLE_RxHandler(uintptr_t context)
     }
 }
 
-// *****************************************************************************
-// *****************************************************************************
-// Section: Application Local Functions
-// *****************************************************************************
-// *****************************************************************************
-
 void BLE_Delay(void)
 {
     uint32_t delay = 200000 ;
@@ -245,6 +276,7 @@ bool BLE_WaitExpectedRsp(const uint8_t *expectedMsg, uint8_t expectedMsgLen, uin
     uint8_t resp ;
     while ((timeout > 0) && timeout --)
     {
+        BLE_RxProcess() ;
         if (index < expectedMsgLen)
         {
             resp = app_bleData.rxBuffer[index] ;
@@ -446,6 +478,9 @@ void APP_BLE_Initialize ( void )
     /* Place the App state machine in its initial state. */
     app_bleData.state = APP_BLE_STATE_INIT;
 
+    OSAL_SEM_Create(&bleRxSemaphore, OSAL_SEM_TYPE_BINARY, 1, 0) ;
+    SYS_RING_Initialize(&bleRxRing, bleRxRingBuffer, sizeof(char), BLE_RX_RING_SIZE, &bleRxSemaphore) ;
+
     UART2_ReadCallbackRegister(BLE_RxHandler, (uintptr_t)NULL) ;
     UART2_Read((void*)&app_bleData.rxData, 1) ;
 }
@@ -459,6 +494,9 @@ void APP_BLE_Initialize ( void )
  */
 void APP_BLE_Tasks ( void )
 {
+    // parse everything received since the last run
+    BLE_RxProcess() ;
+
     /* Check the application's current state. */
     switch ( app_bleData.state )
     {
@@ -601,7 +639,14 @@ void APP_BLE_Tasks ( void )
             break;
         }
     }
-    vTaskDelay(app_bleData.taskDelay / portTICK_PERIOD_MS) ;
+    if (app_bleData.state == APP_BLE_STATE_WAIT_TRANSPARENT_DATA)
+    {   // wake up as soon as new data is received
+        OSAL_SEM_Pend(&bleRxSemaphore, app_bleData.taskDelay) ;
+    }
+    else
+    {
+        vTaskDelay(app_bleData.taskDelay / portTICK_PERIOD_MS) ;
+    }
 }
 
 
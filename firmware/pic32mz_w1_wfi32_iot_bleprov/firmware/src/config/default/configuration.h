@@ -81,7 +81,11 @@ extern "C" {
 // *****************************************************************************
 /* TIME System Service Configuration Options */
 #define SYS_TIME_INDEX_0                            (0)
-#define SYS_TIME_MAX_TIMERS                         (5)
+/* The timer wheel cost does not depend on the number of timers; the pool
+   is static RAM, 56 bytes per timer. This application runs a handful of
+   timers: size the pool up, to hundreds, when the application needs them */
+#define SYS_TIME_MAX_TIMERS                         (32)
+#define SYS_TIME_WHEEL_TICK_SHIFT                   (14)
 #define SYS_TIME_HW_COUNTER_WIDTH                   (32)
 #define SYS_TIME_HW_COUNTER_PERIOD                  (4294967295U)
 #define SYS_TIME_HW_COUNTER_HALF_PERIOD             (SYS_TIME_HW_COUNTER_PERIOD>>1)
@@ -116,6 +120,16 @@ extern "C" {
 #define SYS_CONSOLE_PRINT_BUFFER_SIZE        		256
 
 
+/* Boot Trace System Service Configuration */
+#define SYS_BOOTTRACE_MAX_RECORDS                  64
+
+/* Stack Monitor System Service Configuration */
+#define SYS_STACKMON_MAX_TASKS                     10
+#define SYS_STACKMON_PERIOD_MS                     1000
+#define SYS_STACKMON_MARGIN_PERCENT                25
+#define SYS_STACKMON_MARGIN_MIN                    64
+
+
 
 
 // *****************************************************************************
@@ -130,6 +144,9 @@ extern "C" {
 #define WDRV_PIC32MZW_ALARM_PERIOD_1MS          0
 #define WDRV_PIC32MZW_ALARM_PERIOD_MAX          0
 
+/* PIC32MZW1 Driver RTOS Configurations */
+#define WDRV_PIC32MZW1_RTOS_STACK_SIZE          1024
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -142,12 +159,14 @@ extern "C" {
 #define TCPIP_STACK_USE_DNS
 #define TCPIP_DNS_CLIENT_SERVER_TMO					60
 #define TCPIP_DNS_CLIENT_TASK_PROCESS_RATE			200
-#define TCPIP_DNS_CLIENT_CACHE_ENTRIES				5
+#define TCPIP_DNS_CLIENT_CACHE_ENTRIES				16
 #define TCPIP_DNS_CLIENT_CACHE_ENTRY_TMO			0
 #define TCPIP_DNS_CLIENT_CACHE_PER_IPV4_ADDRESS		5
 #define TCPIP_DNS_CLIENT_CACHE_PER_IPV6_ADDRESS		1
 #define TCPIP_DNS_CLIENT_ADDRESS_TYPE			    IP_ADDRESS_TYPE_IPV4
 #define TCPIP_DNS_CLIENT_CACHE_DEFAULT_TTL_VAL		1200
+#define TCPIP_DNS_CLIENT_CACHE_PREFETCH_TMO			30
+#define TCPIP_DNS_CLIENT_CACHE_NEGATIVE_TTL			60
 #define TCPIP_DNS_CLIENT_LOOKUP_RETRY_TMO			2
 #define TCPIP_DNS_CLIENT_MAX_HOSTNAME_LEN			64
 #define TCPIP_DNS_CLIENT_MAX_SELECT_INTERFACES		4
@@ -174,6 +193,9 @@ extern "C" {
 /*** ICMPv4 Server Configuration ***/
 #define TCPIP_STACK_USE_ICMP_SERVER
 #define TCPIP_ICMP_ECHO_ALLOW_BROADCASTS    false
+#define TCPIP_ICMP_ECHO_REPLY_RATE          100
+#define TCPIP_ICMP_ECHO_REPLY_BURST         20
+#define TCPIP_ICMP_ECHO_SOURCES             4
 
 /*** ICMPv4 Client Configuration ***/
 #define TCPIP_STACK_USE_ICMP_CLIENT
@@ -185,10 +207,14 @@ extern "C" {
 
 /*** TCP Configuration ***/
 #define TCPIP_TCP_MAX_SEG_SIZE_TX		        	1460
-#define TCPIP_TCP_SOCKET_DEFAULT_TX_SIZE			512
-#define TCPIP_TCP_SOCKET_DEFAULT_RX_SIZE			512
+#define TCPIP_TCP_SOCKET_DEFAULT_TX_SIZE			2048
+#define TCPIP_TCP_SOCKET_DEFAULT_RX_SIZE			2920
 #define TCPIP_TCP_DYNAMIC_OPTIONS             			true
+#define TCPIP_TCP_AUTOTUNE_MAX_RX_SIZE			8760
+#define TCPIP_TCP_AUTOTUNE_MEM_BUDGET			16384
 #define TCPIP_TCP_START_TIMEOUT_VAL		        	1000
+#define TCPIP_TCP_MIN_RTO					250
+#define TCPIP_TCP_SACK_SUPPORT				true
 #define TCPIP_TCP_DELAYED_ACK_TIMEOUT		    		100
 #define TCPIP_TCP_FIN_WAIT_2_TIMEOUT		    		5000
 #define TCPIP_TCP_KEEP_ALIVE_TIMEOUT		    		10000
@@ -216,6 +242,8 @@ extern "C" {
 #define TCPIP_DHCP_CLIENT_CONNECT_PORT              68
 #define TCPIP_DHCP_SERVER_LISTEN_PORT               67
 #define TCPIP_DHCP_CLIENT_CONSOLE_CMD               true
+#define TCPIP_DHCP_LEASE_PERSIST_INTERFACES         1
+#define TCPIP_DHCP_REBOOT_PROBE_TMO                 500
 
 #define TCPIP_DHCP_USE_OPTION_TIME_SERVER           0
 #define TCPIP_DHCP_TIME_SERVER_ADDRESSES            0
@@ -225,11 +253,12 @@ extern "C" {
 
 
 /*** ARP Configuration ***/
-#define TCPIP_ARP_CACHE_ENTRIES                 		5
+#define TCPIP_ARP_CACHE_ENTRIES                 		16
 #define TCPIP_ARP_CACHE_DELETE_OLD		        	true
 #define TCPIP_ARP_CACHE_SOLVED_ENTRY_TMO			1200
 #define TCPIP_ARP_CACHE_PENDING_ENTRY_TMO			60
 #define TCPIP_ARP_CACHE_PENDING_RETRY_TMO			2
+#define TCPIP_ARP_CACHE_REFRESH_TMO			    	60
 #define TCPIP_ARP_CACHE_PERMANENT_QUOTA		    		50
 #define TCPIP_ARP_CACHE_PURGE_THRESHOLD		    		75
 #define TCPIP_ARP_CACHE_PURGE_QUANTA		    		1
@@ -270,6 +299,7 @@ extern "C" {
 
 /*** IPv4 Configuration ***/
 #define TCPIP_IPV4_ARP_SLOTS                        10
+#define TCPIP_IPV4_ARP_TARGET_SLOTS                 3
 #define TCPIP_IPV4_EXTERN_PACKET_PROCESS   false
 
 #define TCPIP_IPV4_COMMANDS false
@@ -289,6 +319,8 @@ extern "C" {
 #define TCPIP_DHCPS_LEASE_REMOVED_BEFORE_ACK                5
 #define TCPIP_DHCP_SERVER_DELETE_OLD_ENTRIES              	true
 #define TCPIP_DHCPS_LEASE_DURATION	TCPIP_DHCPS_LEASE_SOLVED_ENTRY_TMO
+#define TCPIP_DHCPS_LEASE_PERSIST_ENTRIES                   TCPIP_DHCPS_LEASE_ENTRIES_DEFAULT
+#define TCPIP_DHCPS_LEASE_PERSIST_DELAY                     1000
 
 /*** DHCP Server Instance 0 Configuration ***/
 #define TCPIP_DHCPS_DEFAULT_IP_ADDRESS_RANGE_START_IDX0             "192.168.1.100"
@@ -324,7 +356,10 @@ extern "C" {
 
 
 
-#define TCPIP_STACK_HEAP_USE_FLAGS                   TCPIP_STACK_HEAP_FLAG_ALLOC_UNCACHED
+/* Cached packet memory. Not measured against TCPIP_STACK_HEAP_FLAG_ALLOC_UNCACHED
+   on hardware yet: compare iperf throughput and the driver copy.txTicks/rxTicks
+   (WDRV_PIC32MZW_STATS_ENABLE) with either setting */
+#define TCPIP_STACK_HEAP_USE_FLAGS                   TCPIP_STACK_HEAP_FLAG_NONE
 
 #define TCPIP_STACK_HEAP_USAGE_CONFIG                TCPIP_STACK_HEAP_USE_DEFAULT
 
@@ -350,6 +385,25 @@ extern "C" {
 
 #define TCPIP_PACKET_LOG_ENABLE     0
 
+/* pcap capture of the logged frames; requires TCPIP_PACKET_LOG_ENABLE */
+#define TCPIP_PKT_CAPTURE_ENABLE            0
+#define TCPIP_PKT_CAPTURE_BUFFER_SIZE       4096
+#define TCPIP_PKT_CAPTURE_SNAPLEN           96
+/* the UART capture needs a console of its own, console 0 carries the commands and debug messages */
+#define TCPIP_PKT_CAPTURE_CONSOLE_INDEX     1
+#define TCPIP_PKT_CAPTURE_TASK_RATE         20
+#define TCPIP_PKT_CAPTURE_RTOS_STACK_SIZE   1024
+#define TCPIP_PKT_CAPTURE_RTOS_PRIORITY     1
+
+/* TCP/IP packet slab pools, block sizes include the packet descriptor */
+#define TCPIP_PKT_POOL_ENABLE               1
+#define TCPIP_PKT_POOL_SMALL_SIZE           320
+#define TCPIP_PKT_POOL_SMALL_BLOCKS         16
+#define TCPIP_PKT_POOL_MEDIUM_SIZE          768
+#define TCPIP_PKT_POOL_MEDIUM_BLOCKS        4
+#define TCPIP_PKT_POOL_LARGE_SIZE           1680
+#define TCPIP_PKT_POOL_LARGE_BLOCKS         6
+
 /* TCP/IP stack event notification */
 #define TCPIP_STACK_USE_EVENT_NOTIFICATION
 #define TCPIP_STACK_USER_NOTIFICATION   true
@@ -439,6 +493,7 @@ extern "C" {
 #define TCPIP_STACK_USE_DNS_SERVER
 #define TCPIP_DNSS_HOST_NAME_LEN		    	64
 #define TCPIP_DNSS_REPLY_BOARD_ADDR				true
+#define TCPIP_DNSS_CAPTIVE_PORTAL				false
 #define TCPIP_DNSS_CACHE_PER_IPV4_ADDRESS		2
 #define TCPIP_DNSS_CACHE_PER_IPV6_ADDRESS		1
 #define TCPIP_DNSS_TTL_TIME						600
@@ -449,6 +504,18 @@ extern "C" {
 #define TCPIP_DNSS_CACHE_MAX_SERVER_ENTRIES     (TCPIP_DNSS_CACHE_PER_IPV4_ADDRESS + TCPIP_DNSS_CACHE_PER_IPV6_ADDRESS)
 
 
+/*** iPerf Configuration ***/
+#define TCPIP_STACK_USE_IPERF
+#define TCPIP_IPERF_MAX_INSTANCES               4
+#define TCPIP_IPERF_TASK_RATE                   20
+#define TCPIP_IPERF_TX_BUFFER_SIZE              4096
+#define TCPIP_IPERF_RX_BUFFER_SIZE              4096
+#define TCPIP_IPERF_UDP_RX_QUEUE_LIMIT          8
+#define TCPIP_IPERF_UDP_TX_QUEUE_LIMIT          4
+#define TCPIP_IPERF_CONNECT_TMO                 5000
+#define TCPIP_IPERF_IDLE_TMO                    10000
+
+
 /* WIFI System Service Configuration Options */
 #define SYS_WIFI_DEVMODE        			SYS_WIFI_AP
 
@@ -467,6 +534,9 @@ extern "C" {
 #define SYS_WIFI_AP_CHANNEL					1
 #define SYS_WIFI_AP_SSIDVISIBILE   			true
 
+#define SYS_WIFI_EVENT_QUEUE_SIZE			16
+#define SYS_WIFI_POLL_INTERVAL_MS			10
+
 
 
 
@@ -486,6 +556,10 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
+/* Application RTOS Configurations */
+#define APP_WIFI_RTOS_STACK_SIZE                1024
+#define APP_BLE_RTOS_STACK_SIZE                 1024
+
 
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
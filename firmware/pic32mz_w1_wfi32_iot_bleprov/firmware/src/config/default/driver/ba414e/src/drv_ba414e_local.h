@@ -49,6 +49,7 @@ SUBSTITUTE  GOODS,  TECHNOLOGY,  SERVICES,  OR  ANY  CLAIMS  BY  THIRD   PARTIES
 #include "configuration.h"
 #include "osal/osal.h"
 #include "system/system_module.h"
+#include "system/ring/sys_ring.h"
 
 
 // DOM-IGNORE-BEGIN
@@ -220,6 +221,16 @@ typedef struct
     uint8_t inUse;
 }DRV_BA414E_ClientData;
         
+// Number of completions the interrupt handlers can queue for the task
+#define DRV_BA414E_COMPLETION_RING_SIZE     4
+
+// Completion passed from the interrupt handlers to the driver task
+typedef struct
+{
+    uint32_t status;
+    uint8_t error;
+}DRV_BA414E_Completion;
+
 typedef struct 
 {
 #if defined(DRV_BA414E_RTOS_STACK_SIZE)
@@ -234,6 +245,8 @@ typedef struct
     uint8_t doneInterrupt;
     uint8_t errorInterrupt;
     uint32_t lastStatus;
+    SYS_RING completionRing;
+    DRV_BA414E_Completion completionBuffer[DRV_BA414E_COMPLETION_RING_SIZE];
 }DRV_BA414E_OperationalData;
         
 
@@ -228,12 +228,19 @@ typedef struct _WDRV_PIC32MZW_MACDCPT
     /* Event function parameters to pass to TCP/IP stack. */
     const void *eventParam;
 
+    /* Offset of the segment gap descriptor from the segment buffer. */
+    int16_t gapDcptOffset;
+
     /* Mask of currently enabled events to signal. */
     TCPIP_MAC_EVENT eventMask;
 
     /* Current events to be signalled to stack. */
     TCPIP_MAC_EVENT events;
 
+    /* Events left to the driver task, raised while the event semaphore
+       could not be taken without blocking. */
+    TCPIP_MAC_EVENT deferredEvents;
+
     /* Access semaphore to protect updates to event state. */
     OSAL_SEM_HANDLE_TYPE eventSemaphore;
 
@@ -356,6 +363,10 @@ typedef struct _WDRV_PIC32MZW_MAC_MEM_STATISTICS
     {
         uint32_t tx;
         uint32_t rx;
+
+        /* Transmit frames handed over in place or copied to a driver buffer. */
+        uint32_t txZeroCopy;
+        uint32_t txCopied;
     } pkt;
 
     /* Packet memory allocation counters.
@@ -370,6 +381,14 @@ typedef struct _WDRV_PIC32MZW_MAC_MEM_STATISTICS
     {
         uint32_t gen;
     } err;
+
+    /* Core timer ticks spent copying frames between the TCP/IP stack packets
+     * and the driver buffers, including the cache maintenance. */
+    struct
+    {
+        uint64_t txTicks;
+        uint64_t rxTicks;
+    } copy;
 } WDRV_PIC32MZW_MAC_MEM_STATISTICS;
 
 // *****************************************************************************
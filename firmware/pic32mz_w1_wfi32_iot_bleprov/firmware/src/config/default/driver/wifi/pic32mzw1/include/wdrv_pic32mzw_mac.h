@@ -262,6 +262,7 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACProcess(DRV_HANDLE handle);
     Return statistics.
 
   Description:
+    Fills the receive and transmit statistics from the driver counters.
 
   Precondition:
     WDRV_PIC32MZW_Initialize should have been called.
@@ -269,11 +270,12 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACProcess(DRV_HANDLE handle);
 
   Parameters:
     handle          - Client handle obtained by a call to WDRV_PIC32MZW_Open.
-    pRxStatistics - Pointer to receive statistics structure.
-    pTxStatistics - Pointer to transmit statistics structure.
+    pRxStatistics - Pointer to receive statistics structure, can be NULL.
+    pTxStatistics - Pointer to transmit statistics structure, can be NULL.
 
   Returns:
-    TCPIP_MAC_RES_OP_ERR - Not supported.
+    TCPIP_MAC_RES_OP_ERR - Invalid handle.
+    TCPIP_MAC_RES_OK     - Statistics returned.
 
   Remarks:
     None.
@@ -336,8 +338,12 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACParametersGet
     )
 
   Summary:
+    Return the driver transfer counters.
 
   Description:
+    Reports the driver counters as named entries: received and transmitted
+      frames and bytes, allocation failures, drops, firmware retry counts
+      and the time the firmware holds zero-copy transmit frames.
 
   Precondition:
     WDRV_PIC32MZW_Initialize should have been called.
@@ -345,15 +351,17 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACParametersGet
 
   Parameters:
     handle        - Client handle obtained by a call to WDRV_PIC32MZW_Open.
-    pRegEntries -
-    nEntries    -
-    pHwEntries  -
+    pRegEntries - Pointer to the entries to fill, can be NULL.
+    nEntries    - Number of entries in pRegEntries.
+    pHwEntries  - Pointer to receive the number of counters, can be NULL.
 
   Returns:
-    None.
+    TCPIP_MAC_RES_OP_ERR - Invalid handle.
+    TCPIP_MAC_RES_OK     - Counters returned.
 
   Remarks:
-    None.
+    The firmware retry counts are requested on each call and reported by
+      the following one.
 
 */
 
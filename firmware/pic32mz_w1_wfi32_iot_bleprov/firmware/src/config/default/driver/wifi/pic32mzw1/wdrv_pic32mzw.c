@@ -53,6 +53,7 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "tcpip/tcpip_mac_object.h"
 #include "tcpip/src/link_list.h"
 #include "tcpip/src/tcpip_manager_control.h"
+#include "system/ring/sys_ring.h"
 #include <sys/kmem.h>
 
 #pragma region name="wlan_mem" origin=0xa0040000 size=0x10000
@@ -76,12 +77,28 @@ bool DRV_PIC32MZW1_Crypto_Random_Init(CRYPT_RNG_CTX *pRngCtx);
 #define ETHERNET_HDR_LEN                    14
 #define ETH_ETHERNET_HDR_OFFSET             34
 
-#define ZERO_CP_MIN_MAC_FRAME_OFFSET       (ETH_ETHERNET_HDR_OFFSET + 4)
+/* Headroom needed in front of a TCP/IP frame to transmit it in place. */
+#define ZERO_CP_MIN_MAC_FRAME_OFFSET        (ETH_ETHERNET_HDR_OFFSET + sizeof(DRV_PIC32MZW_MEM_ALLOC_HDR))
 
 #define PIC32MZW_CACHE_LINE_SIZE            CACHE_LINE_SIZE
 
 #define PIC32MZW_RSR_PKT_NUM                40
 
+/* Zero-copy frames checked for modification by the WiFi firmware after the
+   driver starts, and the frames that can be checked at the same time. */
+#define PIC32MZW_ZERO_CP_VERIFY_FRAMES      256
+#define PIC32MZW_ZERO_CP_VERIFY_SLOTS       4
+
+#define PIC32MZW_WID_RX_RING_SIZE           16
+
+/* Uncached allocation pools, block sizes include the allocation header. */
+#define PIC32MZW_MEM_POOL_SMALL_SIZE        128
+#define PIC32MZW_MEM_POOL_SMALL_BLOCKS      8
+#define PIC32MZW_MEM_POOL_MEDIUM_SIZE       640
+#define PIC32MZW_MEM_POOL_MEDIUM_BLOCKS     4
+#define PIC32MZW_MEM_POOL_LARGE_SIZE        1664
+#define PIC32MZW_MEM_POOL_LARGE_BLOCKS      4
+
 #ifdef DRV_PIC32MZW_TRACK_MEMORY_ALLOC
 #define WDRV_PIC32MZW_NUM_TRACK_ENTRIES     256
 #endif
@@ -195,7 +212,14 @@ static const DRV_PIC32MZW_11I_MASK mapAuthTypeTo11i[] =
 typedef struct _DRV_PIC32MZW_MEM_ALLOC_HDR
 {
     struct _DRV_PIC32MZW_MEM_ALLOC_HDR  *pNext;
-    void                                *pUnalignedPtr;
+    union
+    {
+        /* Allocation to free, for buffers allocated from the heap. */
+        void                            *pUnalignedPtr;
+
+        /* Core timer count at transmission, for zero-copy buffers. */
+        uint32_t                        txTicks;
+    };
     uint16_t                            size;
     uint8_t                             users;
     int8_t                              priLevel;
@@ -203,12 +227,88 @@ typedef struct _DRV_PIC32MZW_MEM_ALLOC_HDR
     uint8_t                             memory[0];
 } DRV_PIC32MZW_MEM_ALLOC_HDR;
 
-/* This is a structure for holding a queued packet. */
+/* This is a structure for maintaining the MAC transfer counters. */
+typedef struct
+{
+    struct
+    {
+        /* Frames passed to the TCP/IP stack and their length. */
+        uint32_t frames;
+        uint32_t bytes;
+
+        /* Frames dropped as no TCP/IP packet could be allocated. */
+        uint32_t allocFail;
+
+        /* Frames dropped while the TCP/IP stack is not attached. */
+        uint32_t dropped;
+    } rx;
+
+    struct
+    {
+        /* Frames passed to the WiFi firmware and their length. */
+        uint32_t frames;
+        uint32_t bytes;
+
+        /* Frames dropped as no driver buffer could be allocated. */
+        uint32_t allocFail;
+
+        /* Frames dropped as too long or not accepted by the driver. */
+        uint32_t dropped;
+
+        /* Firmware counts of frames sent after one or more, and more than
+           one, retransmissions. */
+        uint32_t retries;
+        uint32_t multipleRetries;
+    } tx;
+
+    struct
+    {
+        /* Zero-copy frames released by the WiFi firmware and the core
+           timer ticks from transmission to release. */
+        uint32_t count;
+        uint64_t totalTicks;
+        uint32_t maxTicks;
+
+        /* Zero-copy frames checked on release and those the WiFi firmware
+           modified, which turns zero-copy transmission off. */
+        uint32_t verified;
+        uint32_t modified;
+    } ack;
+} DRV_PIC32MZW_MAC_COUNTERS;
+
+/* This is a structure for checking that a zero-copy frame is released by
+   the WiFi firmware unmodified. */
+typedef struct
+{
+    TCPIP_MAC_PACKET                    *ptrPacket;
+    uint16_t                            checksum;
+} DRV_PIC32MZW_ZERO_CP_VERIFY;
+
+/* This is a structure for maintaining an uncached allocation pool. */
+typedef struct
+{
+    /* Size of the blocks, including the allocation header. */
+    uint16_t                            blockSize;
+
+    /* Number of free blocks the pool is replenished to. */
+    uint16_t                            numBlocks;
+
+    /* Free blocks, linked through pNext. */
+    DRV_PIC32MZW_MEM_ALLOC_HDR          *pFree;
+    uint16_t                            numFree;
+
+    /* Allocations served from and missing the free blocks. */
+    uint32_t                            hits;
+    uint32_t                            misses;
+} DRV_PIC32MZW_MEM_POOL;
+
+/* This is a structure for holding a queued packet. Nodes are padded to a
+   whole number of cache lines so packet buffers never share a line. */
 typedef struct
 {
     DRV_PIC32MZW_MEM_ALLOC_HDR  hdr;
     uint8_t                     pkt[SHARED_PKT_MEM_BUFFER_SIZE];
-} WDRV_PIC32MZW_PKT_LIST_NODE;
+} __attribute__((aligned(PIC32MZW_CACHE_LINE_SIZE))) WDRV_PIC32MZW_PKT_LIST_NODE;
 
 /* This is a structure for maintaining a list of queued packets. */
 typedef struct
@@ -244,13 +344,22 @@ static WDRV_PIC32MZW_MACDCPT pic32mzwMACDescriptor;
 /* This is the queue to hold discarded receive TCP/IP packets. */
 static PROTECTED_SINGLE_LIST pic32mzwDiscardQueue;
 
+/* This is the queue to hold zero-copy transmit TCP/IP packets released by
+   the WiFi firmware, acknowledged from the stack context. */
+static PROTECTED_SINGLE_LIST pic32mzwTxDoneQueue;
+
 /* This is the reserved packet store. */
 static WDRV_PIC32MZW_PKT_LIST_NODE pic32mzwRsrvPkts[PIC32MZW_RSR_PKT_NUM] __attribute__((coherent, aligned(PIC32MZW_CACHE_LINE_SIZE))) __attribute__((region("wlan_mem")));
 
 /* This is the queue of reserved packets. */
 static WDRV_PIC32MZW_PKT_LIST pic32mzwRsrvPktList;
 
-/* This is the firmware to driver receive WID queue. */
+/* This is the firmware to driver receive WID ring. */
+static SYS_RING pic32mzwWIDRxRing;
+static DRV_PIC32MZW_MEM_ALLOC_HDR *pic32mzwWIDRxRingBuffer[PIC32MZW_WID_RX_RING_SIZE];
+
+/* This is the firmware to driver receive WID overflow queue, used while
+   the ring is full. */
 static PROTECTED_SINGLE_LIST pic32mzwWIDRxQueue;
 
 /* This is the driver to firmware transmit WID queue. */
@@ -259,6 +368,53 @@ static SINGLE_LIST pic32mzwWIDTxQueue;
 /* This is the memory allocation mutex. */
 static OSAL_MUTEX_HANDLE_TYPE pic32mzwMemMutex;
 
+/* These are the uncached allocation pools, in ascending block size order. */
+static DRV_PIC32MZW_MEM_POOL pic32mzwMemPools[] =
+{
+    {.blockSize = PIC32MZW_MEM_POOL_SMALL_SIZE,     .numBlocks = PIC32MZW_MEM_POOL_SMALL_BLOCKS},
+    {.blockSize = PIC32MZW_MEM_POOL_MEDIUM_SIZE,    .numBlocks = PIC32MZW_MEM_POOL_MEDIUM_BLOCKS},
+    {.blockSize = PIC32MZW_MEM_POOL_LARGE_SIZE,     .numBlocks = PIC32MZW_MEM_POOL_LARGE_BLOCKS},
+};
+
+#define PIC32MZW_MEM_POOL_NUM               (sizeof(pic32mzwMemPools) / sizeof(*pic32mzwMemPools))
+
+/* This is the MAC transfer counters structure. */
+static DRV_PIC32MZW_MAC_COUNTERS pic32mzwMACCounters;
+
+/* These are the zero-copy frames being checked, the number of frames still
+   to check and whether zero-copy transmission is turned off. Protected by
+   pic32mzwMemMutex. */
+static DRV_PIC32MZW_ZERO_CP_VERIFY pic32mzwZeroCopyVerify[PIC32MZW_ZERO_CP_VERIFY_SLOTS];
+static uint16_t pic32mzwZeroCopyVerifyLeft;
+static bool pic32mzwZeroCopyOff;
+
+/* These are the names the MAC transfer counters are reported with by
+   WDRV_PIC32MZW_MACRegisterStatisticsGet, in reporting order. */
+static const char *const pic32mzwMACCounterNames[] =
+{
+    "rxFrames",
+    "rxBytes",
+    "rxAllocFail",
+    "rxDropped",
+    "txFrames",
+    "txBytes",
+    "txAllocFail",
+    "txDropped",
+    "txRetries",
+    "txMultipleRetries",
+    "txAckCount",
+    "txAckAvgUs",
+    "txAckMaxUs",
+    "txZeroCopyVerified",
+    "txZeroCopyModified",
+    "memPoolSmallHits",
+    "memPoolSmallMisses",
+    "memPoolMediumHits",
+    "memPoolMediumMisses",
+    "memPoolLargeHits",
+    "memPoolLargeMisses",
+};
+
 #ifdef WDRV_PIC32MZW_STATS_ENABLE
 /* This is the memory statistics mutex. */
 static OSAL_MUTEX_HANDLE_TYPE pic32mzwMemStatsMutex;
@@ -488,58 +644,743 @@ static bool _DRV_PIC32MZW_PktListDeinit(WDRV_PIC32MZW_PKT_LIST *pPktList)
 
     while (NULL != pPktList->pHead)
     {
-        _DRV_PIC32MZW_PktListRemove(pPktList);
-    }
+        _DRV_PIC32MZW_PktListRemove(pPktList);
+    }
+
+    OSAL_SEM_Delete(&pPktList->semaphore);
+
+    return true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: PIC32MZW Driver Internal Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+//*******************************************************************************
+/*
+  Function:
+    static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_MemHdr(void *pBufferAddr)
+
+  Summary:
+    Returns the memory allocation header for an allocation.
+
+  Description:
+    Returns the memory allocation header for an allocation.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pBufferAddr - Pointer to the start of the memory allocation.
+
+  Returns:
+    Pointer to allocation header.
+
+  Remarks:
+    None.
+
+*/
+
+static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_MemHdr(void *pBufferAddr)
+{
+    DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
+
+    if (NULL == pBufferAddr)
+    {
+        return NULL;
+    }
+
+    pAllocHdr = pBufferAddr;
+    pAllocHdr--;
+
+    return pAllocHdr;
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static void _DRV_PIC32MZW_CacheFlush(const void *pBuf, size_t len)
+
+  Summary:
+    Writes back and invalidates the data cache lines of a buffer.
+
+  Description:
+    Makes data written through the cached (KVA0) alias of a packet buffer
+      visible to the WiFi firmware and drops the lines from the cache.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pBuf - KVA0 address of the buffer.
+    len  - Length of the buffer.
+
+  Returns:
+    None.
+
+  Remarks:
+    Every line touched must belong to the buffer, which holds for buffers
+      from DRV_PIC32MZW_MemAlloc and the reserved packet nodes.
+
+*/
+
+static void _DRV_PIC32MZW_CacheFlush(const void *pBuf, size_t len)
+{
+    uint32_t lineAddr = (uint32_t)pBuf & ~(PIC32MZW_CACHE_LINE_SIZE-1);
+    uint32_t endAddr  = (uint32_t)pBuf + len;
+
+    while (lineAddr < endAddr)
+    {
+        __asm__ __volatile__ ("cache 0x15, 0(%0)" ::"r"(lineAddr));
+        lineAddr += PIC32MZW_CACHE_LINE_SIZE;
+    }
+
+    __asm__ __volatile__ ("sync");
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static void _DRV_PIC32MZW_CacheInvalidate(const void *pBuf, size_t len)
+
+  Summary:
+    Invalidates the data cache lines of a buffer.
+
+  Description:
+    Discards any cached copy of a packet buffer written by the WiFi firmware
+      through the uncached (KVA1) alias, before or after reading it through
+      the cached alias.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pBuf - KVA0 address of the buffer.
+    len  - Length of the buffer.
+
+  Returns:
+    None.
+
+  Remarks:
+    Dirty lines are discarded, see _DRV_PIC32MZW_CacheFlush for the ownership
+      requirement.
+
+*/
+
+static void _DRV_PIC32MZW_CacheInvalidate(const void *pBuf, size_t len)
+{
+    uint32_t lineAddr = (uint32_t)pBuf & ~(PIC32MZW_CACHE_LINE_SIZE-1);
+    uint32_t endAddr  = (uint32_t)pBuf + len;
+
+    while (lineAddr < endAddr)
+    {
+        __asm__ __volatile__ ("cache 0x11, 0(%0)" ::"r"(lineAddr));
+        lineAddr += PIC32MZW_CACHE_LINE_SIZE;
+    }
+
+    __asm__ __volatile__ ("sync");
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_MemBlockAlloc(uint16_t blockSize)
+
+  Summary:
+    Allocates an uncached memory block.
+
+  Description:
+    Allocates a cache line aligned block from the heap, writes it back from
+      the cache and returns its uncached (KVA1) address.
+
+  Precondition:
+    None.
+
+  Parameters:
+    blockSize - Size of the block, including the allocation header.
+
+  Returns:
+    Allocation header of the block, or NULL for error.
+
+  Remarks:
+    Only pUnalignedPtr of the header is set.
+
+*/
+
+static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_MemBlockAlloc(uint16_t blockSize)
+{
+    DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
+    uint8_t *pUnalignedPtr;
+    uint8_t *pAlignedPtr;
+    uint16_t alignedSize;
+
+    alignedSize = ((blockSize + ((2*PIC32MZW_CACHE_LINE_SIZE)-1)) / PIC32MZW_CACHE_LINE_SIZE) * PIC32MZW_CACHE_LINE_SIZE;
+
+    pUnalignedPtr = OSAL_Malloc(alignedSize);
+
+    if (NULL == pUnalignedPtr)
+    {
+        return NULL;
+    }
+
+    pAlignedPtr = (uint8_t*)(((uint32_t)pUnalignedPtr + (PIC32MZW_CACHE_LINE_SIZE-1)) & ~(PIC32MZW_CACHE_LINE_SIZE-1));
+
+    if (IS_KVA0(pAlignedPtr))
+    {
+        _DRV_PIC32MZW_CacheFlush(pAlignedPtr, blockSize);
+
+        pAlignedPtr = KVA0_TO_KVA1(pAlignedPtr);
+    }
+
+    pAllocHdr = (DRV_PIC32MZW_MEM_ALLOC_HDR*)pAlignedPtr;
+
+    pAllocHdr->pUnalignedPtr = pUnalignedPtr;
+
+    return pAllocHdr;
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static DRV_PIC32MZW_MEM_POOL* _DRV_PIC32MZW_MemPoolGet(uint16_t size)
+
+  Summary:
+    Finds the allocation pool for a size.
+
+  Description:
+    Returns the pool with the smallest blocks able to hold an allocation.
+
+  Precondition:
+    None.
+
+  Parameters:
+    size - Size of the allocation, excluding the allocation header.
+
+  Returns:
+    Pointer to the pool, or NULL if the allocation is larger than all blocks.
+
+  Remarks:
+    The pool depends only on the size, so DRV_PIC32MZW_MemFree finds the
+      pool a block came from using the size stored in its header.
+
+*/
+
+static DRV_PIC32MZW_MEM_POOL* _DRV_PIC32MZW_MemPoolGet(uint16_t size)
+{
+    int i;
+
+    for (i=0; i<PIC32MZW_MEM_POOL_NUM; i++)
+    {
+        if ((size + sizeof(DRV_PIC32MZW_MEM_ALLOC_HDR)) <= pic32mzwMemPools[i].blockSize)
+        {
+            return &pic32mzwMemPools[i];
+        }
+    }
+
+    return NULL;
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static void _DRV_PIC32MZW_MemPoolReplenish(void)
+
+  Summary:
+    Refills the allocation pools.
+
+  Description:
+    Allocates blocks until each pool holds its number of free blocks again.
+
+  Precondition:
+    pic32mzwMemMutex must have been created.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Remarks:
+    Called from the driver task so allocations only take a free block.
+
+*/
+
+static void _DRV_PIC32MZW_MemPoolReplenish(void)
+{
+    DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
+    int i;
+
+    for (i=0; i<PIC32MZW_MEM_POOL_NUM; i++)
+    {
+        DRV_PIC32MZW_MEM_POOL *const pPool = &pic32mzwMemPools[i];
+
+        while (pPool->numFree < pPool->numBlocks)
+        {
+            pAllocHdr = _DRV_PIC32MZW_MemBlockAlloc(pPool->blockSize);
+
+            if (NULL == pAllocHdr)
+            {
+                return;
+            }
+
+            if (OSAL_RESULT_FALSE == OSAL_MUTEX_Lock(&pic32mzwMemMutex, OSAL_WAIT_FOREVER))
+            {
+                OSAL_Free(pAllocHdr->pUnalignedPtr);
+                return;
+            }
+
+            pAllocHdr->pNext = pPool->pFree;
+            pPool->pFree     = pAllocHdr;
+            pPool->numFree++;
+
+            OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
+        }
+    }
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static void _DRV_PIC32MZW_MemPoolDeinit(void)
+
+  Summary:
+    Empties the allocation pools.
+
+  Description:
+    Returns the free blocks of all pools to the heap.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+
+*/
+
+static void _DRV_PIC32MZW_MemPoolDeinit(void)
+{
+    DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
+    int i;
+
+    for (i=0; i<PIC32MZW_MEM_POOL_NUM; i++)
+    {
+        while (NULL != (pAllocHdr = pic32mzwMemPools[i].pFree))
+        {
+            pic32mzwMemPools[i].pFree = pAllocHdr->pNext;
+
+            OSAL_Free(pAllocHdr->pUnalignedPtr);
+        }
+
+        pic32mzwMemPools[i].numFree = 0;
+    }
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static bool _DRV_PIC32MZW_MACEventSignal(TCPIP_MAC_EVENT event, uint16_t waitMS)
+
+  Summary:
+    Signals a MAC event to the TCP/IP stack.
+
+  Description:
+    Sets the event as pending and calls the stack event handler if the event
+      is enabled and was not already pending.
+
+  Precondition:
+    TCP/IP stack and WiFi driver must be initialized.
+
+  Parameters:
+    event  - Event to signal.
+    waitMS - Time to wait for the event semaphore.
+
+  Returns:
+    true if the event was signalled, false if the event semaphore could not
+      be taken within waitMS.
+
+  Remarks:
+    None.
+
+*/
+
+static bool _DRV_PIC32MZW_MACEventSignal(TCPIP_MAC_EVENT event, uint16_t waitMS)
+{
+    TCPIP_MAC_EVENT events;
+
+    if (OSAL_RESULT_TRUE != OSAL_SEM_Pend(&pic32mzwMACDescriptor.eventSemaphore, waitMS))
+    {
+        return false;
+    }
+
+    events = pic32mzwMACDescriptor.events | ~pic32mzwMACDescriptor.eventMask;
+    pic32mzwMACDescriptor.events |= event;
+    OSAL_SEM_Post(&pic32mzwMACDescriptor.eventSemaphore);
+
+    if ((0 == (events & event)) && (NULL != pic32mzwMACDescriptor.eventF))
+    {
+        pic32mzwMACDescriptor.eventF(event, pic32mzwMACDescriptor.eventParam);
+    }
+
+    return true;
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static void _DRV_PIC32MZW_MACEventNotify(TCPIP_MAC_EVENT event)
+
+  Summary:
+    Signals a MAC event to the TCP/IP stack.
+
+  Description:
+    Waits for the event semaphore and signals the event.
+
+  Precondition:
+    TCP/IP stack and WiFi driver must be initialized.
+
+  Parameters:
+    event - Event to signal.
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+
+*/
+
+static void _DRV_PIC32MZW_MACEventNotify(TCPIP_MAC_EVENT event)
+{
+    if (false == _DRV_PIC32MZW_MACEventSignal(event, OSAL_WAIT_FOREVER))
+    {
+        WDRV_DBG_ERROR_PRINT("MAC event failed to lock event semaphore\r\n");
+    }
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static void _DRV_PIC32MZW_MACEventNotifyNoWait(TCPIP_MAC_EVENT event)
+
+  Summary:
+    Signals a MAC event to the TCP/IP stack without blocking.
+
+  Description:
+    Signals the event if the event semaphore is free, otherwise leaves the
+      event to the driver task, which signals it on its next run.
+
+  Precondition:
+    TCP/IP stack and WiFi driver must be initialized.
+
+  Parameters:
+    event - Event to signal.
+
+  Returns:
+    None.
+
+  Remarks:
+    For the WiFi firmware context, which must not block on the stack.
+
+*/
+
+static void _DRV_PIC32MZW_MACEventNotifyNoWait(TCPIP_MAC_EVENT event)
+{
+    OSAL_CRITSECT_DATA_TYPE critSect;
+
+    if (true == _DRV_PIC32MZW_MACEventSignal(event, 0))
+    {
+        return;
+    }
+
+    critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+    pic32mzwMACDescriptor.deferredEvents |= event;
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critSect);
+
+    OSAL_SEM_Post(&pic32mzwCtrlDescriptor.drvEventSemaphore);
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static bool _DRV_PIC32MZW_PktMemPriAvailable(MEM_PRIORITY_LEVEL_T priLevel)
+
+  Summary:
+    Checks the packet memory limit of a priority level.
+
+  Description:
+    A priority level may hold up to num_thresh buffers, which keeps the
+      reserved buffers of the other levels available to the WiFi firmware.
+
+  Precondition:
+    None.
+
+  Parameters:
+    priLevel - Priority level, see MEM_PRIORITY_LEVEL_T.
+
+  Returns:
+    true if one more buffer may be allocated at this level.
+
+  Remarks:
+    A level without a threshold is not limited.
+
+*/
+
+static bool _DRV_PIC32MZW_PktMemPriAvailable(MEM_PRIORITY_LEVEL_T priLevel)
+{
+    return ((0 == g_pktmem_pri[priLevel].num_thresh) || (g_pktmem_pri[priLevel].num_allocd < g_pktmem_pri[priLevel].num_thresh));
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static void _DRV_PIC32MZW_ZeroCopyVerify
+    (
+        DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr,
+        TCPIP_MAC_PACKET *ptrPacket
+    )
+
+  Summary:
+    Checks a released zero-copy frame against its checksum at transmission.
+
+  Description:
+    The first PIC32MZW_ZERO_CP_VERIFY_FRAMES zero-copy frames are
+      checksummed when handed to the WiFi firmware and again when it releases
+      them. A frame the firmware modified turns zero-copy transmission off,
+      as the stack may send the same packet again.
+
+  Precondition:
+    pic32mzwMemMutex must be held.
+
+  Parameters:
+    pAllocHdr - Allocation header of the released buffer.
+    ptrPacket - TCP/IP packet of the buffer.
+
+  Returns:
+    None.
+
+  Remarks:
+    The frame is read through the uncached alias, as the firmware wrote it.
+
+*/
+
+static void _DRV_PIC32MZW_ZeroCopyVerify
+(
+    DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr,
+    TCPIP_MAC_PACKET *ptrPacket
+)
+{
+    uint8_t *pFrame;
+    int i;
+
+    for (i=0; i<PIC32MZW_ZERO_CP_VERIFY_SLOTS; i++)
+    {
+        if (pic32mzwZeroCopyVerify[i].ptrPacket == ptrPacket)
+        {
+            break;
+        }
+    }
+
+    if (PIC32MZW_ZERO_CP_VERIFY_SLOTS == i)
+    {
+        return;
+    }
+
+    pic32mzwZeroCopyVerify[i].ptrPacket = NULL;
+
+    pFrame = pAllocHdr->memory + ETH_ETHERNET_HDR_OFFSET;
+
+    if (IS_KVA0(pFrame))
+    {
+        pFrame = KVA0_TO_KVA1(pFrame);
+    }
+
+    pic32mzwMACCounters.ack.verified++;
+
+    if (TCPIP_Helper_CalcIPChecksum(pFrame, pAllocHdr->size - ETH_ETHERNET_HDR_OFFSET, 0) != pic32mzwZeroCopyVerify[i].checksum)
+    {
+        pic32mzwMACCounters.ack.modified++;
+        pic32mzwZeroCopyOff = true;
+
+        WDRV_DBG_ERROR_PRINT("MAC TX: zero-copy frame modified by the firmware, zero-copy off\r\n");
+    }
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static uint8_t* _DRV_PIC32MZW_ZeroCopyTxBuffer
+    (
+        TCPIP_MAC_PACKET *ptrPacket,
+        uint16_t pktLen
+    )
+
+  Summary:
+    Prepares a TCP/IP packet to be transmitted in place.
+
+  Description:
+    Builds a memory allocation header in the segment gap the TCP/IP stack
+      reserves in front of each packet, so the frame can be handed to the
+      WiFi firmware without being copied. When the firmware frees the buffer
+      DRV_PIC32MZW_MemFree queues the packet for acknowledgement.
+
+  Precondition:
+    None.
+
+  Parameters:
+    ptrPacket - TCP/IP packet to transmit.
+    pktLen    - Length of the frame.
+
+  Returns:
+    Buffer to pass to the WiFi firmware, or NULL if the packet is made of
+      several segments or lacks the headroom and has to be copied, or if
+      zero-copy transmission is off.
+
+  Remarks:
+    The frame, header and headroom are written back from the cache.
+      The caller has checked the MEM_PRI_TX packet memory limit.
+
+*/
+
+static uint8_t* _DRV_PIC32MZW_ZeroCopyTxBuffer
+(
+    TCPIP_MAC_PACKET *ptrPacket,
+    uint16_t pktLen
+)
+{
+    TCPIP_MAC_DATA_SEGMENT *pDSeg = ptrPacket->pDSeg;
+    TCPIP_MAC_SEGMENT_GAP_DCPT *pGap;
+    DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
+    uint16_t checksum = 0;
+    int i;
+
+    if ((0 == pic32mzwMACDescriptor.gapDcptOffset) || (0 != (ptrPacket->pktFlags & TCPIP_MAC_PKT_FLAG_STATIC)))
+    {
+        return NULL;
+    }
+
+    if (true == pic32mzwZeroCopyOff)
+    {
+        return NULL;
+    }
+
+    if ((NULL != pDSeg->next) || (ptrPacket->pMacLayer != pDSeg->segLoad))
+    {
+        return NULL;
+    }
+
+    /* The gap belongs to this packet and is large enough for the header and
+       the firmware headroom, which follow the packet pointer. */
+    pGap = (TCPIP_MAC_SEGMENT_GAP_DCPT*)(pDSeg->segBuffer + pic32mzwMACDescriptor.gapDcptOffset);
+
+    if (pGap->segmentPktPtr != ptrPacket)
+    {
+        return NULL;
+    }
+
+    pAllocHdr = (DRV_PIC32MZW_MEM_ALLOC_HDR*)(pDSeg->segLoad - ZERO_CP_MIN_MAC_FRAME_OFFSET);
+
+    if (((uint8_t*)pAllocHdr < (uint8_t*)pGap->segmentDataGap) || (0 != ((uint32_t)pAllocHdr & (sizeof(uint32_t)-1))))
+    {
+        return NULL;
+    }
+
+    pAllocHdr->pNext         = NULL;
+    pAllocHdr->txTicks       = _CP0_GET_COUNT();
+    pAllocHdr->size          = ETH_ETHERNET_HDR_OFFSET + pktLen;
+    pAllocHdr->users         = 1;
+    pAllocHdr->priLevel      = MEM_PRI_TX;
+    pAllocHdr->pAllocPtr     = ptrPacket;
+
+    if (0 != pic32mzwZeroCopyVerifyLeft)
+    {
+        checksum = TCPIP_Helper_CalcIPChecksum(pDSeg->segLoad, pktLen, 0);
+    }
+
+    if (OSAL_RESULT_FALSE == OSAL_MUTEX_Lock(&pic32mzwMemMutex, OSAL_WAIT_FOREVER))
+    {
+        return NULL;
+    }
+
+    g_pktmem_pri[MEM_PRI_TX].num_allocd++;
+
+    if (0 != pic32mzwZeroCopyVerifyLeft)
+    {
+        for (i=0; i<PIC32MZW_ZERO_CP_VERIFY_SLOTS; i++)
+        {
+            if (NULL == pic32mzwZeroCopyVerify[i].ptrPacket)
+            {
+                pic32mzwZeroCopyVerify[i].ptrPacket = ptrPacket;
+                pic32mzwZeroCopyVerify[i].checksum  = checksum;
+                pic32mzwZeroCopyVerifyLeft--;
+                break;
+            }
+        }
+    }
+
+    OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
+
+    ptrPacket->pktFlags |= TCPIP_MAC_PKT_FLAG_QUEUED;
+
+    if (IS_KVA0(pAllocHdr))
+    {
+        _DRV_PIC32MZW_CacheFlush(pAllocHdr, ZERO_CP_MIN_MAC_FRAME_OFFSET + pktLen);
 
-    OSAL_SEM_Delete(&pPktList->semaphore);
+        pAllocHdr = KVA0_TO_KVA1(pAllocHdr);
+    }
 
-    return true;
+    return pAllocHdr->memory;
 }
 
-// *****************************************************************************
-// *****************************************************************************
-// Section: PIC32MZW Driver Internal Implementation
-// *****************************************************************************
-// *****************************************************************************
-
 //*******************************************************************************
 /*
   Function:
-    static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_MemHdr(void *pBufferAddr)
+    static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_WIDRxQueuePop(void)
 
   Summary:
-    Returns the memory allocation header for an allocation.
+    Removes the oldest WID from the receive queue.
 
   Description:
-    Returns the memory allocation header for an allocation.
+    Takes the next WID from the lock-free receive ring and only once that is
+    empty from the overflow queue, which holds WIDs pushed while the ring
+    was full.
 
   Precondition:
     None.
 
   Parameters:
-    pBufferAddr - Pointer to the start of the memory allocation.
+    None.
 
   Returns:
-    Pointer to allocation header.
+    Pointer to allocation header of the WID, or NULL if none is queued.
 
   Remarks:
-    None.
+    Only called from the driver task.
 
 */
 
-static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_MemHdr(void *pBufferAddr)
+static DRV_PIC32MZW_MEM_ALLOC_HDR* _DRV_PIC32MZW_WIDRxQueuePop(void)
 {
     DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
 
-    if (NULL == pBufferAddr)
+    if (true == SYS_RING_Get(&pic32mzwWIDRxRing, &pAllocHdr))
     {
-        return NULL;
+        return pAllocHdr;
     }
 
-    pAllocHdr = pBufferAddr;
-    pAllocHdr--;
+    if (TCPIP_Helper_ProtectedSingleListCount(&pic32mzwWIDRxQueue) > 0)
+    {
+        return (DRV_PIC32MZW_MEM_ALLOC_HDR*)TCPIP_Helper_ProtectedSingleListHeadRemove(&pic32mzwWIDRxQueue);
+    }
 
-    return pAllocHdr;
+    return NULL;
 }
 
 #ifdef DRV_PIC32MZW_TRACK_MEMORY_ALLOC
@@ -1037,6 +1878,9 @@ SYS_MODULE_OBJ WDRV_PIC32MZW_Initialize
         SYS_INT_SourceEnable(INT_SOURCE_RFTM0);
         SYS_INT_SourceEnable(INT_SOURCE_RFSMC);
 
+        SYS_RING_Initialize(&pic32mzwWIDRxRing, pic32mzwWIDRxRingBuffer,
+                sizeof(DRV_PIC32MZW_MEM_ALLOC_HDR*), PIC32MZW_WID_RX_RING_SIZE,
+                &pic32mzwCtrlDescriptor.drvEventSemaphore);
         TCPIP_Helper_ProtectedSingleListInitialize(&pic32mzwWIDRxQueue);
         TCPIP_Helper_SingleListInitialize(&pic32mzwWIDTxQueue);
 
@@ -1083,6 +1927,14 @@ SYS_MODULE_OBJ WDRV_PIC32MZW_Initialize
 
             TCPIP_Helper_ProtectedSingleListInitialize(&pic32mzwDiscardQueue);
 
+            TCPIP_Helper_ProtectedSingleListInitialize(&pic32mzwTxDoneQueue);
+
+            memset(&pic32mzwMACCounters, 0, sizeof(pic32mzwMACCounters));
+
+            memset(pic32mzwZeroCopyVerify, 0, sizeof(pic32mzwZeroCopyVerify));
+            pic32mzwZeroCopyVerifyLeft = PIC32MZW_ZERO_CP_VERIFY_FRAMES;
+            pic32mzwZeroCopyOff = false;
+
             if (true == _DRV_PIC32MZW_PktListInit(&pic32mzwRsrvPktList))
             {
                 for (i=0; i<PIC32MZW_RSR_PKT_NUM; i++)
@@ -1098,8 +1950,10 @@ SYS_MODULE_OBJ WDRV_PIC32MZW_Initialize
             pic32mzwMACDescriptor.pktFreeF     = pStackInitData->pktFreeF;
             pic32mzwMACDescriptor.pktAckF      = pStackInitData->pktAckF;
             pic32mzwMACDescriptor.eventParam   = pStackInitData->eventParam;
+            pic32mzwMACDescriptor.gapDcptOffset = pStackInitData->gapDcptOffset;
             pic32mzwMACDescriptor.eventMask    = 0;
             pic32mzwMACDescriptor.events       = 0;
+            pic32mzwMACDescriptor.deferredEvents = 0;
             OSAL_SEM_Create(&pic32mzwMACDescriptor.eventSemaphore, OSAL_SEM_TYPE_BINARY, 1, 1);
         }
     }
@@ -1164,6 +2018,8 @@ void WDRV_PIC32MZW_Deinitialize(SYS_MODULE_OBJ object)
     {
         OSAL_SEM_Delete(&pic32mzwMACDescriptor.eventSemaphore);
 
+        WDRV_PIC32MZW_MACProcess((DRV_HANDLE)pDcpt);
+
         pic32mzwMACDescriptor.eventF       = NULL;
         pic32mzwMACDescriptor.pktAllocF    = NULL;
         pic32mzwMACDescriptor.pktFreeF     = NULL;
@@ -1277,6 +2133,7 @@ SYS_STATUS WDRV_PIC32MZW_Status(SYS_MODULE_OBJ object)
         if (pDcpt == &pic32mzwDescriptor[0])
         {
             if ((TCPIP_Helper_SingleListCount(&pic32mzwWIDTxQueue) > 0) ||
+                    (SYS_RING_Count(&pic32mzwWIDRxRing) > 0) ||
                     (TCPIP_Helper_ProtectedSingleListCount(&pic32mzwWIDRxQueue) > 0))
             {
                 return SYS_STATUS_BUSY;
@@ -1433,19 +2290,16 @@ void WDRV_PIC32MZW_Tasks(SYS_MODULE_OBJ object)
                     OSAL_SEM_Post(&pic32mzwCtrlDescriptor.drvAccessSemaphore);
                 }
 
-                while (TCPIP_Helper_ProtectedSingleListCount(&pic32mzwWIDRxQueue) > 0)
+                while (NULL != (pAllocHdr = _DRV_PIC32MZW_WIDRxQueuePop()))
                 {
-                    pAllocHdr = (DRV_PIC32MZW_MEM_ALLOC_HDR*)TCPIP_Helper_ProtectedSingleListHeadRemove(&pic32mzwWIDRxQueue);
-
-                    if (NULL != pAllocHdr)
-                    {
-                        DRV_PIC32MZW_ProcessHostRsp(pAllocHdr->memory);
-                    }
+                    DRV_PIC32MZW_ProcessHostRsp(pAllocHdr->memory);
                 }
 
                 OSAL_SEM_Delete(&pic32mzwCtrlDescriptor.drvEventSemaphore);
                 OSAL_SEM_Delete(&pic32mzwCtrlDescriptor.drvAccessSemaphore);
 
+                _DRV_PIC32MZW_MemPoolDeinit();
+
                 OSAL_MUTEX_Delete(&pic32mzwMemMutex);
 #ifdef WDRV_PIC32MZW_STATS_ENABLE
                 OSAL_MUTEX_Delete(&pic32mzwMemStatsMutex);
@@ -1521,14 +2375,11 @@ void WDRV_PIC32MZW_Tasks(SYS_MODULE_OBJ object)
                 OSAL_SEM_Post(&pic32mzwCtrlDescriptor.drvAccessSemaphore);
             }
 
-            if (TCPIP_Helper_ProtectedSingleListCount(&pic32mzwWIDRxQueue) > 0)
-            {
-                pAllocHdr = (DRV_PIC32MZW_MEM_ALLOC_HDR*)TCPIP_Helper_ProtectedSingleListHeadRemove(&pic32mzwWIDRxQueue);
+            pAllocHdr = _DRV_PIC32MZW_WIDRxQueuePop();
 
-                if (NULL != pAllocHdr)
-                {
-                    DRV_PIC32MZW_ProcessHostRsp(pAllocHdr->memory);
-                }
+            if (NULL != pAllocHdr)
+            {
+                DRV_PIC32MZW_ProcessHostRsp(pAllocHdr->memory);
             }
 
             numDiscard = TCPIP_Helper_ProtectedSingleListCount(&pic32mzwDiscardQueue);
@@ -1555,6 +2406,21 @@ void WDRV_PIC32MZW_Tasks(SYS_MODULE_OBJ object)
                 }
             }
 
+            _DRV_PIC32MZW_MemPoolReplenish();
+
+            if (0 != pic32mzwMACDescriptor.deferredEvents)
+            {
+                OSAL_CRITSECT_DATA_TYPE critSect;
+                TCPIP_MAC_EVENT events;
+
+                critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+                events = pic32mzwMACDescriptor.deferredEvents;
+                pic32mzwMACDescriptor.deferredEvents = 0;
+                OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critSect);
+
+                _DRV_PIC32MZW_MACEventNotify(events);
+            }
+
             break;
         }
 
@@ -2028,6 +2894,10 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACPacketTx(DRV_HANDLE handle, TCPIP_MAC_PACKET* ptr
 
     uint8_t *pktbuf;
     TCPIP_MAC_DATA_SEGMENT *pDSeg;
+    bool zeroCopy;
+#ifdef WDRV_PIC32MZW_STATS_ENABLE
+    uint32_t copyTicks = 0;
+#endif
 
     pDSeg = ptrPacket->pDSeg;
 
@@ -2042,33 +2912,76 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACPacketTx(DRV_HANDLE handle, TCPIP_MAC_PACKET* ptr
     {
         WDRV_DBG_TRACE_PRINT("MAC TX: payload too big (%d)\r\n", pktLen);
 
+        pic32mzwMACCounters.tx.dropped++;
+
         return TCPIP_MAC_RES_OP_ERR;
     }
 
-    pktbuf = payLoadPtr = DRV_PIC32MZW_PacketMemAlloc(DRV_PIC32MZW_ALLOC_OPT_PARAMS
-            ETH_ETHERNET_HDR_OFFSET + pktLen, MEM_PRI_TX);
-
-    if (NULL == pktbuf)
+    /* Both paths hold a MEM_PRI_TX buffer until the firmware releases it,
+       keep the buffers the firmware reserves for the other levels. */
+    if (false == _DRV_PIC32MZW_PktMemPriAvailable(MEM_PRI_TX))
     {
-        WDRV_DBG_TRACE_PRINT("MAC TX: malloc fail\r\n");
+        WDRV_DBG_TRACE_PRINT("MAC TX: priority limit\r\n");
+
+        pic32mzwMACCounters.tx.allocFail++;
 
         return TCPIP_MAC_RES_OP_ERR;
     }
 
-    pktbuf += ETH_ETHERNET_HDR_OFFSET;
-
-    pDSeg = ptrPacket->pDSeg;
+    /* Hand single segment frames over in place, the packet is acknowledged
+       once the WiFi firmware releases the buffer. */
+    payLoadPtr = _DRV_PIC32MZW_ZeroCopyTxBuffer(ptrPacket, pktLen);
+    zeroCopy = (NULL != payLoadPtr);
 
-    while (NULL != pDSeg)
+    if (false == zeroCopy)
     {
-        memcpy(pktbuf, pDSeg->segLoad, pDSeg->segLen);
+        pktbuf = payLoadPtr = DRV_PIC32MZW_PacketMemAlloc(DRV_PIC32MZW_ALLOC_OPT_PARAMS
+                ETH_ETHERNET_HDR_OFFSET + pktLen, MEM_PRI_TX);
 
-        pktbuf += pDSeg->segLen;
+        if (NULL == pktbuf)
+        {
+            WDRV_DBG_TRACE_PRINT("MAC TX: malloc fail\r\n");
 
-        pDSeg = pDSeg->next;
-    }
+            pic32mzwMACCounters.tx.allocFail++;
+
+            return TCPIP_MAC_RES_OP_ERR;
+        }
+
+#ifdef WDRV_PIC32MZW_STATS_ENABLE
+        uint32_t copyStart = _CP0_GET_COUNT();
+#endif
 
-    pDcpt->pMac->pktAckF(ptrPacket, TCPIP_MAC_PKT_ACK_TX_OK, TCPIP_THIS_MODULE_ID);
+        pktbuf += ETH_ETHERNET_HDR_OFFSET;
+
+        /* Fill the buffer through its cached alias and write it back in one go,
+           uncached stores would stall on every word. */
+        if (IS_KVA1(pktbuf))
+        {
+            pktbuf = KVA1_TO_KVA0(pktbuf);
+        }
+
+        pDSeg = ptrPacket->pDSeg;
+
+        while (NULL != pDSeg)
+        {
+            memcpy(pktbuf, pDSeg->segLoad, pDSeg->segLen);
+
+            pktbuf += pDSeg->segLen;
+
+            pDSeg = pDSeg->next;
+        }
+
+        if (IS_KVA0(pktbuf))
+        {
+            _DRV_PIC32MZW_CacheFlush(pktbuf - pktLen, pktLen);
+        }
+
+#ifdef WDRV_PIC32MZW_STATS_ENABLE
+        copyTicks = _CP0_GET_COUNT() - copyStart;
+#endif
+
+        pDcpt->pMac->pktAckF(ptrPacket, TCPIP_MAC_PKT_ACK_TX_OK, TCPIP_THIS_MODULE_ID);
+    }
 
     if (OSAL_RESULT_TRUE == OSAL_SEM_Pend(&pic32mzwCtrlDescriptor.drvAccessSemaphore, OSAL_WAIT_FOREVER))
     {
@@ -2076,6 +2989,17 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACPacketTx(DRV_HANDLE handle, TCPIP_MAC_PACKET* ptr
         if (OSAL_RESULT_TRUE == OSAL_MUTEX_Lock(&pic32mzwMemStatsMutex, OSAL_WAIT_FOREVER))
         {
             pic32mzMemStatistics.pkt.tx++;
+
+            if (true == zeroCopy)
+            {
+                pic32mzMemStatistics.pkt.txZeroCopy++;
+            }
+            else
+            {
+                pic32mzMemStatistics.pkt.txCopied++;
+                pic32mzMemStatistics.copy.txTicks += copyTicks;
+            }
+
             OSAL_MUTEX_Unlock(&pic32mzwMemStatsMutex);
         }
 #endif
@@ -2083,10 +3007,18 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACPacketTx(DRV_HANDLE handle, TCPIP_MAC_PACKET* ptr
         OSAL_SEM_Post(&pic32mzwCtrlDescriptor.drvAccessSemaphore);
 
         OSAL_SEM_Post(&pic32mzwCtrlDescriptor.drvEventSemaphore);
+
+        pic32mzwMACCounters.tx.frames++;
+        pic32mzwMACCounters.tx.bytes += pktLen;
     }
     else
     {
         WDRV_DBG_ERROR_PRINT("Send packet failed to lock driver semaphore\r\n");
+
+        pic32mzwMACCounters.tx.dropped++;
+
+        /* Release the buffer, a zero-copy packet is handed back to the stack. */
+        DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_PARAMS payLoadPtr);
     }
 
     return TCPIP_MAC_RES_OK;
@@ -2168,11 +3100,22 @@ TCPIP_MAC_PACKET* WDRV_PIC32MZW_MACPacketRx
 
 TCPIP_MAC_RES WDRV_PIC32MZW_MACProcess(DRV_HANDLE handle)
 {
+    TCPIP_MAC_PACKET* ptrPacket;
+
     if (DRV_HANDLE_INVALID == handle)
     {
         return TCPIP_MAC_RES_OP_ERR;
     }
 
+    /* Acknowledge the zero-copy frames the WiFi firmware is done with. */
+    while (NULL != (ptrPacket = (TCPIP_MAC_PACKET*)TCPIP_Helper_ProtectedSingleListHeadRemove(&pic32mzwTxDoneQueue)))
+    {
+        if (NULL != pic32mzwMACDescriptor.pktAckF)
+        {
+            pic32mzwMACDescriptor.pktAckF(ptrPacket, TCPIP_MAC_PKT_ACK_TX_OK, TCPIP_THIS_MODULE_ID);
+        }
+    }
+
     return TCPIP_MAC_RES_OK;
 }
 
@@ -2190,6 +3133,7 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACProcess(DRV_HANDLE handle)
     Return statistics.
 
   Description:
+    Reports the driver transfer counters through the TCP/IP MAC statistics.
 
   Remarks:
     See wdrv_pic32mzw_mac.h for usage information.
@@ -2211,13 +3155,21 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACStatisticsGet
     if (NULL != pRxStatistics)
     {
         memset(pRxStatistics, 0, sizeof(TCPIP_MAC_RX_STATISTICS));
+
+        pRxStatistics->nRxOkPackets        = pic32mzwMACCounters.rx.frames;
+        pRxStatistics->nRxPendBuffers      = TCPIP_Helper_ProtectedSingleListCount(&pic32mzwMACDescriptor.ethRxPktList);
+        pRxStatistics->nRxErrorPackets     = pic32mzwMACCounters.rx.dropped;
+        pRxStatistics->nRxBuffNotAvailable = pic32mzwMACCounters.rx.allocFail;
     }
 
     if (NULL != pTxStatistics)
     {
         memset(pTxStatistics, 0, sizeof(TCPIP_MAC_TX_STATISTICS));
 
-        pTxStatistics->nTxPendBuffers = wdrv_pic32mzw_qmu_get_tx_count();
+        pTxStatistics->nTxOkPackets    = pic32mzwMACCounters.tx.frames;
+        pTxStatistics->nTxPendBuffers  = wdrv_pic32mzw_qmu_get_tx_count();
+        pTxStatistics->nTxErrorPackets = pic32mzwMACCounters.tx.dropped;
+        pTxStatistics->nTxQueueFull    = pic32mzwMACCounters.tx.allocFail;
     }
 
     return TCPIP_MAC_RES_OK;
@@ -2289,8 +3241,12 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACParametersGet
     )
 
   Summary:
+    Return the driver transfer counters.
 
   Description:
+    Reports the frame, byte, drop, retry, acknowledge latency and memory
+      pool counters as named entries. The firmware retry counters are refreshed
+      asynchronously, each call reports the values read by the previous one.
 
   Remarks:
     See wdrv_pic32mzw_mac.h for usage information.
@@ -2305,7 +3261,83 @@ TCPIP_MAC_RES WDRV_PIC32MZW_MACRegisterStatisticsGet
     int* pHwEntries
 )
 {
-    return TCPIP_MAC_RES_OP_ERR;
+    WDRV_PIC32MZW_DCPT *const pDcpt = (WDRV_PIC32MZW_DCPT *const)handle;
+    const int numCounters = sizeof(pic32mzwMACCounterNames) / sizeof(*pic32mzwMACCounterNames);
+    uint32_t counters[sizeof(pic32mzwMACCounterNames) / sizeof(*pic32mzwMACCounterNames)];
+    uint32_t ticksPerUs;
+    int i;
+    int n = 0;
+
+    if ((DRV_HANDLE_INVALID == handle) || (NULL == pDcpt))
+    {
+        return TCPIP_MAC_RES_OP_ERR;
+    }
+
+    if (SYS_STATUS_READY == pDcpt->sysStat)
+    {
+        DRV_PIC32MZW_WIDCTX wids;
+        OSAL_CRITSECT_DATA_TYPE critSect;
+
+        /* Request the firmware retry counters, the replies are stored by
+           WDRV_PIC32MZW_WIDProcess and reported by the next call. */
+        DRV_PIC32MZW_MultiWIDInit(&wids, 16);
+        DRV_PIC32MZW_MultiWIDAddQuery(&wids, DRV_WIFI_WID_RETRY_COUNT);
+        DRV_PIC32MZW_MultiWIDAddQuery(&wids, DRV_WIFI_WID_MULTIPLE_RETRY_COUNT);
+
+        critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+        DRV_PIC32MZW_MultiWid_Write(&wids);
+        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critSect);
+    }
+
+    ticksPerUs = CORETIMER_FrequencyGet() / 1000000;
+
+    counters[n++] = pic32mzwMACCounters.rx.frames;
+    counters[n++] = pic32mzwMACCounters.rx.bytes;
+    counters[n++] = pic32mzwMACCounters.rx.allocFail;
+    counters[n++] = pic32mzwMACCounters.rx.dropped;
+    counters[n++] = pic32mzwMACCounters.tx.frames;
+    counters[n++] = pic32mzwMACCounters.tx.bytes;
+    counters[n++] = pic32mzwMACCounters.tx.allocFail;
+    counters[n++] = pic32mzwMACCounters.tx.dropped;
+    counters[n++] = pic32mzwMACCounters.tx.retries;
+    counters[n++] = pic32mzwMACCounters.tx.multipleRetries;
+    counters[n++] = pic32mzwMACCounters.ack.count;
+
+    if (0 != pic32mzwMACCounters.ack.count)
+    {
+        counters[n++] = (uint32_t)(pic32mzwMACCounters.ack.totalTicks / pic32mzwMACCounters.ack.count) / ticksPerUs;
+    }
+    else
+    {
+        counters[n++] = 0;
+    }
+
+    counters[n++] = pic32mzwMACCounters.ack.maxTicks / ticksPerUs;
+    counters[n++] = pic32mzwMACCounters.ack.verified;
+    counters[n++] = pic32mzwMACCounters.ack.modified;
+
+    for (i=0; i<PIC32MZW_MEM_POOL_NUM; i++)
+    {
+        counters[n++] = pic32mzwMemPools[i].hits;
+        counters[n++] = pic32mzwMemPools[i].misses;
+    }
+
+    if (NULL != pHwEntries)
+    {
+        *pHwEntries = numCounters;
+    }
+
+    if (NULL != pRegEntries)
+    {
+        for (i=0; (i<nEntries) && (i<numCounters); i++)
+        {
+            strncpy(pRegEntries[i].registerName, pic32mzwMACCounterNames[i], sizeof(pRegEntries[i].registerName) - 1);
+            pRegEntries[i].registerName[sizeof(pRegEntries[i].registerName) - 1] = '\0';
+            pRegEntries[i].registerValue = counters[i];
+        }
+    }
+
+    return TCPIP_MAC_RES_OK;
 }
 
 //*******************************************************************************
@@ -2820,6 +3852,30 @@ void WDRV_PIC32MZW_WIDProcess(uint16_t wid, uint16_t length, const uint8_t *cons
             break;
         }
 
+        case DRV_WIFI_WID_RETRY_COUNT:
+        case DRV_WIFI_WID_MULTIPLE_RETRY_COUNT:
+        {
+            uint32_t count;
+
+            if (length < 4)
+            {
+                break;
+            }
+
+            count = pData[0] | (pData[1] << 8) | (pData[2] << 16) | ((uint32_t)pData[3] << 24);
+
+            if (DRV_WIFI_WID_RETRY_COUNT == wid)
+            {
+                pic32mzwMACCounters.tx.retries = count;
+            }
+            else
+            {
+                pic32mzwMACCounters.tx.multipleRetries = count;
+            }
+
+            break;
+        }
+
         case DRV_WIFI_WID_CURR_OPER_CHANNEL:
         {
             pCtrl->opChannel = *pData;
@@ -3214,7 +4270,6 @@ void DRV_PIC32MZW_MACEthernetSendPacket
 )
 {
     TCPIP_MAC_PACKET *ptrPacket = NULL;
-    TCPIP_MAC_EVENT events;
     DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr = NULL;
     void *pBufferAddr;
 
@@ -3225,20 +4280,55 @@ void DRV_PIC32MZW_MACEthernetSendPacket
 
     pBufferAddr = (void*)&pEthMsg[-hdrOffset];
 
-    if (NULL != pic32mzwMACDescriptor.pktAllocF)
+    if (NULL == pic32mzwMACDescriptor.pktAllocF)
     {
-        ptrPacket = pic32mzwMACDescriptor.pktAllocF(sizeof(TCPIP_MAC_PACKET), lengthEthMsg-ETHERNET_HDR_LEN, 0);
+        pic32mzwMACCounters.rx.dropped++;
+
+        DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_PARAMS pBufferAddr);
+        return;
     }
 
+    ptrPacket = pic32mzwMACDescriptor.pktAllocF(sizeof(TCPIP_MAC_PACKET), lengthEthMsg-ETHERNET_HDR_LEN, 0);
+
     if (NULL == ptrPacket)
     {
-        DRV_PIC32MZW_MemFree(pBufferAddr);
+        pic32mzwMACCounters.rx.allocFail++;
+
+        DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_PARAMS pBufferAddr);
         return;
     }
 
-    memcpy(ptrPacket->pMacLayer, pEthMsg, lengthEthMsg);
+#ifdef WDRV_PIC32MZW_STATS_ENABLE
+    uint32_t copyStart = _CP0_GET_COUNT();
+#endif
+
+    /* Read the frame through the cached alias of the buffer, the stack
+       packet is cached too unless TCPIP_STACK_HEAP_FLAG_ALLOC_UNCACHED is
+       used. */
+    if (IS_KVA1(pEthMsg))
+    {
+        const uint8_t *pCachedMsg = KVA1_TO_KVA0(pEthMsg);
+
+        _DRV_PIC32MZW_CacheInvalidate(pCachedMsg, lengthEthMsg);
+        memcpy(ptrPacket->pMacLayer, pCachedMsg, lengthEthMsg);
+        _DRV_PIC32MZW_CacheInvalidate(pCachedMsg, lengthEthMsg);
+    }
+    else
+    {
+        memcpy(ptrPacket->pMacLayer, pEthMsg, lengthEthMsg);
+    }
+
+#ifdef WDRV_PIC32MZW_STATS_ENABLE
+    uint32_t copyTicks = _CP0_GET_COUNT() - copyStart;
+
+    if (OSAL_RESULT_TRUE == OSAL_MUTEX_Lock(&pic32mzwMemStatsMutex, OSAL_WAIT_FOREVER))
+    {
+        pic32mzMemStatistics.copy.rxTicks += copyTicks;
+        OSAL_MUTEX_Unlock(&pic32mzwMemStatsMutex);
+    }
+#endif
 
-    DRV_PIC32MZW_MemFree(pBufferAddr);
+    DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_PARAMS pBufferAddr);
 
     ptrPacket->pDSeg->segLen = lengthEthMsg - ETHERNET_HDR_LEN;
     ptrPacket->pktFlags |= TCPIP_MAC_PKT_FLAG_QUEUED;
@@ -3250,22 +4340,11 @@ void DRV_PIC32MZW_MACEthernetSendPacket
     /* Store packet in FIFO and signal stack that packet ready to process. */
     TCPIP_Helper_ProtectedSingleListTailAdd(&pic32mzwMACDescriptor.ethRxPktList, (SGL_LIST_NODE*)ptrPacket);
 
-    /* Notify stack of received packet. */
-    if (OSAL_RESULT_TRUE == OSAL_SEM_Pend(&pic32mzwMACDescriptor.eventSemaphore, OSAL_WAIT_FOREVER))
-    {
-        events = pic32mzwMACDescriptor.events | ~pic32mzwMACDescriptor.eventMask;
-        pic32mzwMACDescriptor.events |= TCPIP_EV_RX_DONE;
-        OSAL_SEM_Post(&pic32mzwMACDescriptor.eventSemaphore);
+    pic32mzwMACCounters.rx.frames++;
+    pic32mzwMACCounters.rx.bytes += lengthEthMsg;
 
-        if (0 == (events & TCPIP_EV_RX_DONE))
-        {
-            pic32mzwMACDescriptor.eventF(TCPIP_EV_RX_DONE, pic32mzwMACDescriptor.eventParam);
-        }
-    }
-    else
-    {
-        WDRV_DBG_ERROR_PRINT("MAC receive failed to lock event semaphore\r\n");
-    }
+    /* Notify stack of received packet. */
+    _DRV_PIC32MZW_MACEventNotify(TCPIP_EV_RX_DONE);
 }
 
 //*******************************************************************************
@@ -3277,7 +4356,9 @@ void DRV_PIC32MZW_MACEthernetSendPacket
     Allocate general memory from packet pool.
 
   Description:
-    Allocates memory from the packet pool for general use.
+    Allocates memory from the packet pool for general use. The memory is a
+      flushed, cache line aligned uncached block taken from the pool for its
+      size, or allocated from the heap when the pool is empty.
 
   Precondition:
     TCP/IP stack must be initialized.
@@ -3295,51 +4376,49 @@ void DRV_PIC32MZW_MACEthernetSendPacket
 void* DRV_PIC32MZW_MemAlloc(DRV_PIC32MZW_ALLOC_OPT_ARGS uint16_t size)
 {
     DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
-    uint8_t *pUnalignedPtr;
-    uint8_t *pAlignedPtr;
-    uint16_t alignedSize;
+    DRV_PIC32MZW_MEM_POOL *pPool;
+
+    pPool = _DRV_PIC32MZW_MemPoolGet(size);
 
     if (OSAL_RESULT_FALSE == OSAL_MUTEX_Lock(&pic32mzwMemMutex, OSAL_WAIT_FOREVER))
     {
         return NULL;
     }
 
-    alignedSize = (((size + sizeof(DRV_PIC32MZW_MEM_ALLOC_HDR)) + ((2*PIC32MZW_CACHE_LINE_SIZE)-1)) / PIC32MZW_CACHE_LINE_SIZE) * PIC32MZW_CACHE_LINE_SIZE;
-
-    pUnalignedPtr = OSAL_Malloc(alignedSize);
-
-    if (NULL == pUnalignedPtr)
+    if ((NULL != pPool) && (NULL != pPool->pFree))
     {
-        OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
-        return NULL;
-    }
+        pAllocHdr = pPool->pFree;
 
-    pAlignedPtr = (uint8_t*)(((uint32_t)pUnalignedPtr + (PIC32MZW_CACHE_LINE_SIZE-1)) & ~(PIC32MZW_CACHE_LINE_SIZE-1));
-
-    if (IS_KVA0(pAlignedPtr))
+        pPool->pFree = pAllocHdr->pNext;
+        pPool->numFree--;
+        pPool->hits++;
+    }
+    else
     {
-        uint8_t *pCacheLinePtr = pAlignedPtr;
-        int numLines = alignedSize / PIC32MZW_CACHE_LINE_SIZE;
+        /* Allocate a full block so it can be returned to the pool. */
+        if (NULL != pPool)
+        {
+            pPool->misses++;
 
-        while (numLines--)
+            pAllocHdr = _DRV_PIC32MZW_MemBlockAlloc(pPool->blockSize);
+        }
+        else
         {
-            __asm__ __volatile__ ("cache 0x15, 0(%0)" ::"r"(pCacheLinePtr));
-            pCacheLinePtr += PIC32MZW_CACHE_LINE_SIZE;
+            pAllocHdr = _DRV_PIC32MZW_MemBlockAlloc(size + sizeof(DRV_PIC32MZW_MEM_ALLOC_HDR));
         }
 
-        __asm__ __volatile__ ("sync");
-
-        pAlignedPtr = KVA0_TO_KVA1(pAlignedPtr);
+        if (NULL == pAllocHdr)
+        {
+            OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
+            return NULL;
+        }
     }
 
-    pAllocHdr = (DRV_PIC32MZW_MEM_ALLOC_HDR*)pAlignedPtr;
-
     pAllocHdr->pNext         = NULL;
     pAllocHdr->size          = size;
     pAllocHdr->users         = 1;
     pAllocHdr->priLevel      = -1;
     pAllocHdr->pAllocPtr     = NULL;
-    pAllocHdr->pUnalignedPtr = pUnalignedPtr;
 
 #ifdef WDRV_PIC32MZW_STATS_ENABLE
     if (OSAL_RESULT_TRUE == OSAL_MUTEX_Lock(&pic32mzwMemStatsMutex, OSAL_WAIT_FOREVER))
@@ -3389,6 +4468,7 @@ void* DRV_PIC32MZW_MemAlloc(DRV_PIC32MZW_ALLOC_OPT_ARGS uint16_t size)
 int8_t DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_ARGS void *pBufferAddr)
 {
     DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
+    DRV_PIC32MZW_MEM_POOL *pPool;
 
     if (NULL == pBufferAddr)
     {
@@ -3415,6 +4495,35 @@ int8_t DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_ARGS void *pBufferAddr)
         return 0;
     }
 
+    if (NULL != pAllocHdr->pAllocPtr)
+    {
+        /* Zero-copy transmit buffer, the memory belongs to the TCP/IP packet
+           which is handed back to the stack. */
+        TCPIP_MAC_PACKET *ptrPacket = pAllocHdr->pAllocPtr;
+        uint32_t ackTicks = _CP0_GET_COUNT() - pAllocHdr->txTicks;
+
+        g_pktmem_pri[pAllocHdr->priLevel].num_allocd--;
+        pAllocHdr->pAllocPtr = NULL;
+
+        pic32mzwMACCounters.ack.count++;
+        pic32mzwMACCounters.ack.totalTicks += ackTicks;
+
+        if (ackTicks > pic32mzwMACCounters.ack.maxTicks)
+        {
+            pic32mzwMACCounters.ack.maxTicks = ackTicks;
+        }
+
+        _DRV_PIC32MZW_ZeroCopyVerify(pAllocHdr, ptrPacket);
+
+        OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
+
+        TCPIP_Helper_ProtectedSingleListTailAdd(&pic32mzwTxDoneQueue, (SGL_LIST_NODE*)ptrPacket);
+
+        _DRV_PIC32MZW_MACEventNotifyNoWait(TCPIP_EV_TX_DONE);
+
+        return 1;
+    }
+
     if (-1 != pAllocHdr->priLevel)
     {
         g_pktmem_pri[pAllocHdr->priLevel].num_allocd--;
@@ -3460,7 +4569,18 @@ int8_t DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_ARGS void *pBufferAddr)
     _DRV_PIC32MZW_MemTrackerRemove(pBufferAddr);
 #endif
 
-    OSAL_Free(pAllocHdr->pUnalignedPtr);
+    pPool = _DRV_PIC32MZW_MemPoolGet(pAllocHdr->size);
+
+    if ((NULL != pPool) && (pPool->numFree < pPool->numBlocks))
+    {
+        pAllocHdr->pNext = pPool->pFree;
+        pPool->pFree     = pAllocHdr;
+        pPool->numFree++;
+    }
+    else
+    {
+        OSAL_Free(pAllocHdr->pUnalignedPtr);
+    }
 
     OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
 
@@ -3653,37 +4773,14 @@ void* DRV_PIC32MZW_PacketMemAlloc(DRV_PIC32MZW_ALLOC_OPT_ARGS uint16_t size, MEM
 
 void DRV_PIC32MZW_PacketMemFree(DRV_PIC32MZW_ALLOC_OPT_ARGS void *pPktBuff)
 {
-    DRV_PIC32MZW_MEM_ALLOC_HDR *pAllocHdr;
-
     if (NULL == pPktBuff)
     {
         return;
     }
 
-    pAllocHdr = _DRV_PIC32MZW_MemHdr(pPktBuff);
-
-    if (NULL == pAllocHdr)
-    {
-        return;
-    }
-
-    if (OSAL_RESULT_FALSE == OSAL_MUTEX_Lock(&pic32mzwMemMutex, OSAL_WAIT_FOREVER))
-    {
-        return;
-    }
-
-    if ((NULL != pAllocHdr->pAllocPtr) && (NULL != pic32mzwMACDescriptor.pktAckF))
-    {
-        OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
-
-        pic32mzwMACDescriptor.pktAckF(pAllocHdr->pAllocPtr, 0, TCPIP_THIS_MODULE_ID);
-    }
-    else
-    {
-        OSAL_MUTEX_Unlock(&pic32mzwMemMutex);
-
-        DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_PARAMS pPktBuff);
-    }
+    /* Zero-copy transmit buffers are handed back to the stack by
+       DRV_PIC32MZW_MemFree once the last user releases them. */
+    DRV_PIC32MZW_MemFree(DRV_PIC32MZW_ALLOC_OPT_PARAMS pPktBuff);
 }
 
 //*******************************************************************************
@@ -3708,7 +4805,8 @@ void DRV_PIC32MZW_PacketMemFree(DRV_PIC32MZW_ALLOC_OPT_ARGS void *pPktBuff)
     None.
 
   Remarks:
-    None.
+    The firmware library is the only producer, its calls are serialized by
+    the driver access semaphore.
 */
 
 void DRV_PIC32MZW_WIDRxQueuePush(void *pPktBuff)
@@ -3727,7 +4825,13 @@ void DRV_PIC32MZW_WIDRxQueuePush(void *pPktBuff)
         return;
     }
 
-    TCPIP_Helper_ProtectedSingleListTailAdd(&pic32mzwWIDRxQueue, (SGL_LIST_NODE*)pAllocHdr);
+    /* Use the overflow queue while it holds anything so that WIDs are
+       processed in the order they were pushed. */
+    if ((TCPIP_Helper_ProtectedSingleListCount(&pic32mzwWIDRxQueue) > 0) ||
+            (false == SYS_RING_Put(&pic32mzwWIDRxRing, &pAllocHdr)))
+    {
+        TCPIP_Helper_ProtectedSingleListTailAdd(&pic32mzwWIDRxQueue, (SGL_LIST_NODE*)pAllocHdr);
+    }
 }
 
 //*******************************************************************************
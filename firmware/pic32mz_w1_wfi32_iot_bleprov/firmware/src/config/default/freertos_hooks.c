@@ -38,6 +38,7 @@
 // DOM-IGNORE-END
 #include "FreeRTOS.h"
 #include "task.h"
+#include "system/stackmon/sys_stackmon.h"
 
 /*
 *********************************************************************************************************
@@ -57,7 +58,9 @@
 void vApplicationStackOverflowHook( TaskHandle_t pxTask, signed char *pcTaskName )
 {
    ( void ) pcTaskName;
-   ( void ) pxTask;
+
+   /* Keep a record of the overflow across the reset */
+   SYS_STACKMON_OverflowNotify( pxTask );
 
    /* Run time task stack overflow checking is performed if
    configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook  function is
@@ -124,6 +127,8 @@ void vApplicationIdleHook( void )
     important that vApplicationIdleHook() is permitted to return to its calling
     function, because it is the responsibility of the idle task to clean up
     memory allocated by the kernel to any task that has since been deleted. */
+
+    SYS_STACKMON_Tasks();
 }
 
 /*-----------------------------------------------------------*/
@@ -158,6 +158,8 @@ typedef struct
                                                     // size is given by timeServersNo
     const IPV4_ADDR*            ntpServers;         // pointer to array of addresses for the NTP servers
                                                     // size is given by ntpServersNo
+    uint32_t                    bindTime;           // time from the link up to the lease bound, milliseconds
+    bool                        rebootBound;        // lease obtained by an INIT-REBOOT of the previous address
 }TCPIP_DHCP_INFO;
 
 // *****************************************************************************
@@ -368,6 +370,42 @@ bool TCPIP_DHCP_Renew(TCPIP_NET_HANDLE hNet);
  */
 bool TCPIP_DHCP_Request(TCPIP_NET_HANDLE hNet, IPV4_ADDR reqAddress);
 
+//*****************************************************************************
+/*
+  Function:
+    bool TCPIP_DHCP_LeaseBindKeySet(TCPIP_NET_HANDLE hNet, const void* key, size_t keySize)
+
+  Summary:
+    Sets the key of the network the interface connects to.
+
+  Description:
+    The DHCP client remembers the last lease of an interface, across resets too,
+    together with the key of the network that granted it.
+    When the link comes up and the key matches the remembered one, the client
+    requests the previous address directly (INIT-REBOOT) and checks it with
+    an ARP probe at the same time.
+    It falls back to a DISCOVER only if the server NAKs the request or doesn't answer.
+
+  Precondition:
+    The DHCP module should have been initialized.
+
+  Parameters:
+    hNet    - Interface to set the key for
+    key     - network identification, for example the SSID of a Wi-Fi network
+    keySize - size of the key, bytes
+
+  Returns:
+    - true  - if successful
+    - false - if the interface is invalid or the DHCP client is not initialized
+
+  Remarks:
+    The key should be set before the link comes up.
+    A 0 key matches only a lease obtained with no key set.
+
+    The lease is forgotten when it's released or the server NAKs it.
+ */
+bool TCPIP_DHCP_LeaseBindKeySet(TCPIP_NET_HANDLE hNet, const void* key, size_t keySize);
+
 
 //*****************************************************************************
 /*
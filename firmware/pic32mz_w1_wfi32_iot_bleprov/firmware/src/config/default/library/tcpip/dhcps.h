@@ -132,7 +132,7 @@ typedef struct
 {
     TCPIP_MAC_ADDR    hwAdd; // Client MAC address
     IPV4_ADDR   ipAddress;   // Leased IP address
-    uint32_t    leaseTime;   // Lease period
+    uint32_t    leaseTime;   // Lease time left, seconds
 }TCPIP_DHCPS_LEASE_ENTRY;
 
 // *****************************************************************************
@@ -171,6 +171,92 @@ typedef enum
 */
 typedef const void* TCPIP_DHCPS_LEASE_HANDLE;
 
+// *****************************************************************************
+/*
+  Enumeration:
+    TCPIP_DHCPS_EVENT_TYPE
+
+  Summary:
+    DHCP server lease events.
+
+  Description:
+    Events reported by the DHCP server to the registered event handlers.
+*/
+
+typedef enum
+{
+    TCPIP_DHCPS_EVENT_NONE      = 0,    // no event
+    TCPIP_DHCPS_EVENT_LEASE_BOUND,      // a client was acknowledged a new lease
+    TCPIP_DHCPS_EVENT_LEASE_EXPIRED,    // a lease expired without being renewed
+    TCPIP_DHCPS_EVENT_LEASE_RELEASED,   // a lease was released/declined by the client
+                                        // or removed by the user
+}TCPIP_DHCPS_EVENT_TYPE;
+
+// *****************************************************************************
+/*
+  Type:
+    TCPIP_DHCPS_EVENT_HANDLER
+
+  Summary:
+    DHCP server event handler prototype.
+
+  Description:
+    Prototype of a DHCP server event handler. Clients can register a handler with the
+    DHCP server. Once a lease event occurs the DHCP server will call the
+    registered handler.
+    pLease describes the lease the event refers to; its leaseTime is 0
+    for the TCPIP_DHCPS_EVENT_LEASE_EXPIRED and TCPIP_DHCPS_EVENT_LEASE_RELEASED events.
+    The handler has to be short and fast. It is meant for
+    setting an event flag, <i>not</i> for lengthy processing!
+    The handler should not call the DHCP server API.
+ */
+
+typedef void    (*TCPIP_DHCPS_EVENT_HANDLER)(TCPIP_NET_HANDLE hNet, TCPIP_DHCPS_EVENT_TYPE evType, const TCPIP_DHCPS_LEASE_ENTRY* pLease, const void* param);
+
+// *****************************************************************************
+/*
+  Type:
+    TCPIP_DHCPS_HANDLE
+
+  Summary:
+    DHCP server handle.
+
+  Description:
+    A handle that a client can use after the event handler has been registered.
+ */
+
+typedef const void* TCPIP_DHCPS_HANDLE;
+
+// *****************************************************************************
+/*
+  Structure:
+    TCPIP_DHCPS_STATISTICS
+
+  Summary:
+    DHCP server statistics.
+
+  Description:
+    Counters maintained by the DHCP server.
+
+  Remarks:
+    The average offer latency is offerLatencyTotal / offers.
+    The latency is measured from the DISCOVER reception to the OFFER transmission
+    and includes the ICMP probe of the offered address.
+*/
+typedef struct
+{
+    uint32_t    discovers;          // DISCOVER messages processed
+    uint32_t    offers;             // OFFER messages sent
+    uint32_t    acks;               // REQUEST messages acknowledged
+    uint32_t    naks;               // REQUEST messages rejected
+    uint32_t    poolFull;           // DISCOVER messages not answered, no free pool address
+    uint32_t    leasesBound;        // new leases bound
+    uint32_t    leasesExpired;      // leases that expired
+    uint32_t    leasesRestored;     // leases restored from the persistent store
+    uint32_t    offerLatencyTotal;  // total latency of the sent offers, ms
+    uint32_t    offerLatencyMax;    // maximum offer latency, ms
+}TCPIP_DHCPS_STATISTICS;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: DHCP Server Functions
@@ -377,6 +463,93 @@ int TCPIP_DHCPS_GetPoolEntries(TCPIP_NET_HANDLE netH, TCPIP_DHCPS_POOL_ENTRY_TYP
 
 bool TCPIP_DHCPS_LeaseEntryRemove(TCPIP_NET_HANDLE netH, TCPIP_MAC_ADDR* hwAdd);
 
+// *****************************************************************************
+/* Function:
+    TCPIP_DHCPS_HandlerRegister(TCPIP_NET_HANDLE hNet, TCPIP_DHCPS_EVENT_HANDLER handler, 
+	                           const void* hParam)
+
+  Summary:
+    Registers a DHCP server event handler.
+
+  Description:
+    This function registers a DHCP server event handler.
+    The DHCP server will call the registered handler when a
+    lease event (TCPIP_DHCPS_EVENT_TYPE) occurs.
+
+  Precondition:
+    The DHCP Server module must be initialized.
+
+  Parameters:
+    hNet    - Interface handle.
+              Use hNet == 0 to register on all interfaces available.
+    handler - Handler to be called when a DHCP server event occurs.
+    hParam  - Parameter to be used in the handler call.
+              This is user supplied and is not used by the DHCP server.
+
+  Returns:
+    Returns a valid handle if the call succeeds, or a null handle if
+    the call failed (out of memory, for example).
+
+  Remarks:
+    The handler has to be short and fast. It is meant for
+    setting an event flag, not for lengthy processing!
+ */
+
+TCPIP_DHCPS_HANDLE      TCPIP_DHCPS_HandlerRegister(TCPIP_NET_HANDLE hNet, 
+                          TCPIP_DHCPS_EVENT_HANDLER handler, const void* hParam);
+
+// *****************************************************************************
+/* Function:
+    TCPIP_DHCPS_HandlerDeRegister(TCPIP_DHCPS_HANDLE hDhcps)
+
+  Summary:
+    Deregisters a previously registered DHCP server handler.
+    
+  Description:
+    This function deregisters the DHCP server event handler.
+
+  Precondition:
+    The DHCP Server module must be initialized.
+
+  Parameters:
+    hDhcps  - A handle returned by a previous call to TCPIP_DHCPS_HandlerRegister.
+
+  Returns:
+    - true	- if the call succeeds
+    - false - if no such handler is registered
+ */
+
+bool             TCPIP_DHCPS_HandlerDeRegister(TCPIP_DHCPS_HANDLE hDhcps);
+
+//******************************************************************************
+/*
+ Function:
+    bool TCPIP_DHCPS_StatisticsGet(TCPIP_DHCPS_STATISTICS* pStat, bool clear)
+
+  Summary:
+    Get the DHCP server statistics.
+
+  Description:
+    This function returns the message, lease and offer latency
+    counters of the DHCP server.
+
+  Precondition:
+    The DHCP Server module should have been initialized.
+
+  Parameters:
+    pStat   - pointer to a TCPIP_DHCPS_STATISTICS data structure to receive the statistics. Could be NULL.
+    clear   - if true, the counters are cleared after the read
+
+  Returns:
+    - true	- If successful
+    - false	- If the DHCP server is not initialized
+
+  Remarks:
+    None.
+*/
+
+bool TCPIP_DHCPS_StatisticsGet(TCPIP_DHCPS_STATISTICS* pStat, bool clear);
+
 // *****************************************************************************
 /*
   Function:
@@ -309,6 +309,32 @@ typedef struct
     uint16_t            totalEntries;                   // total number of supported name entries
 }TCPIP_DNS_CLIENT_INFO;
 
+// *****************************************************************************
+/*
+  Type:
+    TCPIP_DNS_CLIENT_STATISTICS
+
+  Summary:
+    DNS client cache statistics.
+
+  Description:
+    Counters maintained by the DNS client cache.
+
+  Remarks:
+    The average query latency is latencyTotal / nResolved.
+*/
+typedef struct
+{
+    uint32_t    cacheHits;      // TCPIP_DNS_Resolve calls answered from a solved entry
+    uint32_t    cacheMisses;    // TCPIP_DNS_Resolve calls that needed a new query
+    uint32_t    negativeHits;   // TCPIP_DNS_Resolve calls answered from a cached name error
+    uint32_t    prefetches;     // solved entries queried again before expiry
+    uint32_t    nameErrors;     // name error/no data answers cached
+    uint32_t    nResolved;      // queries answered with addresses
+    uint32_t    latencyTotal;   // total latency of the nResolved queries, ms
+    uint32_t    latencyMax;     // maximum query latency, ms
+}TCPIP_DNS_CLIENT_STATISTICS;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: DNS Client Functions
@@ -339,12 +365,21 @@ typedef struct
     TCPIP_DNS_RES_OK          - success, name is solved.
     TCPIP_DNS_RES_PENDING     - operation is ongoing
     TCPIP_DNS_RES_NAME_IS_IPADDRESS   - name request is a IPv4 or IPv6 address
+    TCPIP_DNS_RES_NO_NAME_ENTRY - the server reported that the name does not exist
+                                  or has no addresses; the answer is cached
 
     or an error code if an error occurred
     
   Remarks:
     To clear the cache use TCPIP_DNS_Disable(hNet, true);
 
+    Name error and no data answers are cached as per RFC 2308,
+    so retrying a bad name does not generate new queries until
+    the negative entry expires. TCPIP_DNS_Send_Query forces a new query.
+
+    A solved name that is in use is queried again in the background
+    before it expires, so the cached addresses stay available.
+
   */
 TCPIP_DNS_RESULT  TCPIP_DNS_Resolve(const char* hostName, TCPIP_DNS_RESOLVE_TYPE type);
 
@@ -378,6 +413,7 @@ TCPIP_DNS_RESULT  TCPIP_DNS_Resolve(const char* hostName, TCPIP_DNS_RESOLVE_TYPE
     - TCPIP_DNS_RES_PENDING - The resolution process is still in progress
     - TCPIP_DNS_RES_SERVER_TMO - DNS server timed out
     - TCPIP_DNS_RES_NO_NAME_ENTRY - no such entry to be resolved exists
+                                    or a name error is cached for it
 
   Remarks:
     The function will set either an IPv6 or an IPv4 address to the hostIP address,
@@ -419,6 +455,7 @@ TCPIP_DNS_RESULT  TCPIP_DNS_IsResolved(const char* hostName, IP_MULTI_ADDRESS* h
     - TCPIP_DNS_RES_PENDING - The resolution process is still in progress
     - TCPIP_DNS_RES_SERVER_TMO - DNS server timed out
     - TCPIP_DNS_RES_NO_NAME_ENTRY - no such entry to be resolved exists
+                                    or a name error is cached for it
 
   Remarks:
     The function will set either an IPv6 or an IPv4 address to the hostIP address,
@@ -851,6 +888,34 @@ TCPIP_DNS_RESULT TCPIP_DNS_Send_Query(const char* hostName, TCPIP_DNS_RESOLVE_TY
 */
 TCPIP_DNS_RESULT TCPIP_DNS_ClientInfoGet(TCPIP_DNS_CLIENT_INFO* pClientInfo);
 
+//****************************************************************************
+/*  Function:
+    TCPIP_DNS_RESULT TCPIP_DNS_ClientStatisticsGet(TCPIP_DNS_CLIENT_STATISTICS* pStat, bool clear)
+
+  Summary:
+    Get the DNS client cache statistics.
+
+  Description:
+    This function returns the hit/miss, prefetch, negative caching
+    and query latency counters of the DNS client cache.
+
+  Precondition:
+    The DNS client module must be initialized.
+
+  Parameters:
+    pStat   - pointer to a TCPIP_DNS_CLIENT_STATISTICS data structure to receive the statistics. Could be NULL.
+    clear   - if true, the counters are cleared after the read
+
+  Returns:
+    - TCPIP_DNS_RES_OK on success
+    - TCPIP_DNS_RES_NO_SERVICE - DNS resolver non existent/uninitialized.
+
+  Remarks:
+    None
+
+*/
+TCPIP_DNS_RESULT TCPIP_DNS_ClientStatisticsGet(TCPIP_DNS_CLIENT_STATISTICS* pStat, bool clear);
+
 // *****************************************************************************
 /*
   Function:
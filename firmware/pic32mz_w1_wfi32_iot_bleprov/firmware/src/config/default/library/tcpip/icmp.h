@@ -151,6 +151,28 @@ typedef struct
     void*   reserved;
 } TCPIP_ICMP_MODULE_CONFIG;
 
+// *****************************************************************************
+/* ICMP Echo Source Statistics Structure
+
+  Summary:
+    Echo request counters for a source address.
+
+  Description:
+    The ICMP server keeps counters for the last TCPIP_ICMP_ECHO_SOURCES
+    hosts that sent echo requests.
+
+  Remarks:
+    When the table is full, the least recently seen source is replaced.
+*/
+typedef struct
+{
+    IPV4_ADDR   sourceAddr;     // address of the echo requests source
+    uint32_t    requests;       // echo requests received
+    uint32_t    replies;        // echo replies sent
+    uint32_t    rateDrops;      // requests not answered because of the rate limit
+    uint32_t    lastTick;       // system tick of the last request
+} TCPIP_ICMP_ECHO_SOURCE_STAT;
+
 // *****************************************************************************
 /* Function:
     ICMP_ECHO_RESULT TCPIP_ICMP_EchoRequest (TCPIP_ICMP_ECHO_REQUEST* pEchoRequest, TCPIP_ICMP_REQUEST_HANDLE* pHandle);
@@ -446,6 +468,34 @@ ICMP_HANDLE TCPIP_ICMP_CallbackRegister (void (*callback)(TCPIP_NET_HANDLE hNetI
 */
 bool  TCPIP_ICMP_CallbackDeregister(ICMP_HANDLE hIcmp);
 
+// *****************************************************************************
+/* Function:
+    bool TCPIP_ICMP_EchoSourceStatGet(int index, TCPIP_ICMP_ECHO_SOURCE_STAT* pStat);
+
+  Summary:
+    Returns the echo request counters of a source.
+
+  Description:
+    This function returns the echo counters kept by the ICMP server
+    for the source with the selected index.
+
+  Precondition:
+    The TCP/IP Stack must be initialized and up and running.
+
+  Parameters:
+    index - index of the source, 0 to TCPIP_ICMP_ECHO_SOURCES - 1
+    pStat - address to store the counters
+
+  Returns:
+    - true  - if there is a source with this index and pStat was updated
+    - false - if the index is not in use, the counters are disabled
+              or the ICMP server is not enabled
+
+  Remarks:
+    None.
+*/
+bool  TCPIP_ICMP_EchoSourceStatGet(int index, TCPIP_ICMP_ECHO_SOURCE_STAT* pStat);
+
 
 // *****************************************************************************
 /*
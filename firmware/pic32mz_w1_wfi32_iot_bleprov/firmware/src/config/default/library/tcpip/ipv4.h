@@ -347,6 +347,7 @@ typedef struct
     size_t fwdSolved;   // solved for FWD
     size_t totSolved;   // total solved
     size_t totFailed;   // total failed 
+    size_t tgtDrop;     // dropped, too many packets queued for the same target
 }TCPIP_IPV4_ARP_QUEUE_STAT;
 
 // *****************************************************************************
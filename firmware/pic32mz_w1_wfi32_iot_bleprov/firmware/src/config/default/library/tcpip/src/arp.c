@@ -73,7 +73,7 @@ typedef struct
     PROTECTED_SINGLE_LIST registeredUsers;     // notification users
     // timing
     uint32_t            entrySolvedTmo;      // solved entry removed after this tmo
-                                             // if not referenced - seconds
+                                             // if not confirmed again - seconds
     uint32_t            entryPendingTmo;     // timeout for a pending to be solved entry in the cache, in seconds
     uint32_t            entryRetryTmo;       // timeout for resending an ARP request for a pending entry - seconds
                                              // 1 sec < tmo < entryPendingTmo
@@ -147,7 +147,7 @@ void TCPIP_ARP_HashKeyCopy(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* dstEntry, const voi
 /*static __inline__*/static  void /*__attribute__((always_inline))*/ _ARPSetEntry(ARP_HASH_ENTRY* arpHE, ARP_ENTRY_FLAGS newFlags,
                                                                       const TCPIP_MAC_ADDR* hwAdd, PROTECTED_SINGLE_LIST* addList)
 {
-    arpHE->hEntry.flags.value &= ~ARP_FLAG_ENTRY_VALID_MASK;
+    arpHE->hEntry.flags.value &= ~(ARP_FLAG_ENTRY_VALID_MASK | ARP_FLAG_ENTRY_REFERENCED);
     arpHE->hEntry.flags.value |= newFlags;
     
     if(hwAdd)
@@ -164,12 +164,45 @@ void TCPIP_ARP_HashKeyCopy(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* dstEntry, const voi
 }
 
 
-// re-inserts at the tail, makes the entry fresh
-/*static __inline__*/static  void /*__attribute__((always_inline))*/ _ARPRefreshEntry(ARP_HASH_ENTRY* arpHE, PROTECTED_SINGLE_LIST* pL)
+// marks a complete entry as being in use
+// The entry stays in place: the complete list remains ordered by the time
+// the entries were confirmed, the reference bit is used for the replacement
+// and for refreshing the entry before it expires
+/*static __inline__*/static  void /*__attribute__((always_inline))*/ _ARPReferenceEntry(ARP_HASH_ENTRY* arpHE)
 {
-    TCPIP_Helper_ProtectedSingleListNodeRemove(pL, (SGL_LIST_NODE*)&arpHE->next);
-    arpHE->tInsert = arpMod.timeSeconds;
-    TCPIP_Helper_ProtectedSingleListTailAdd(pL, (SGL_LIST_NODE*)&arpHE->next);
+    arpHE->hEntry.flags.value |= ARP_FLAG_ENTRY_REFERENCED;
+}
+
+// selects a complete entry to be evicted and removes it from the complete list
+// CLOCK replacement: starting with the oldest confirmed entry,
+// the referenced entries get a second chance and lose their reference bit.
+// The first entry not referenced is selected.
+// If all the entries were in use, the oldest one is selected.
+static ARP_HASH_ENTRY* _ARPCompleteVictimRemove(ARP_CACHE_DCPT* pArpDcpt)
+{
+    SGL_LIST_NODE   *pN, *pVictim;
+    ARP_HASH_ENTRY  *pE;
+
+    pVictim = 0;
+    for(pN = pArpDcpt->completeList.list.head; pN != 0; pN = pN->next)
+    {
+        pE = (ARP_HASH_ENTRY*) ((uint8_t*)pN - offsetof(struct _TAG_ARP_HASH_ENTRY, next));
+        if((pE->hEntry.flags.value & ARP_FLAG_ENTRY_REFERENCED) == 0)
+        {
+            pVictim = pN;
+            break;
+        }
+        pE->hEntry.flags.value &= ~ARP_FLAG_ENTRY_REFERENCED;
+    }
+
+    if(pVictim == 0 && (pVictim = pArpDcpt->completeList.list.head) == 0)
+    {   // empty list
+        return 0;
+    }
+
+    TCPIP_Helper_ProtectedSingleListNodeRemove(&pArpDcpt->completeList, pVictim);
+    pArpDcpt->stat.entriesPurged++;
+    return (ARP_HASH_ENTRY*) ((uint8_t*)pVictim - offsetof(struct _TAG_ARP_HASH_ENTRY, next));
 }
 
 /*static __inline__*/static  void /*__attribute__((always_inline))*/ _ARPRemoveCacheEntries(ARP_CACHE_DCPT* pArpDcpt)
@@ -967,6 +1000,9 @@ static void TCPIP_ARP_Timeout(void)
     int         nArpIfs;
     bool        isConfig;
     uint16_t    maxRetries;
+#if (TCPIP_ARP_CACHE_REFRESH_TMO != 0)
+    uint32_t    entryAge, refreshStart;
+#endif  // (TCPIP_ARP_CACHE_REFRESH_TMO != 0)
 
 
     arpMod.timeMs += TCPIP_ARP_TASK_PROCESS_RATE;
@@ -1033,6 +1069,7 @@ static void TCPIP_ARP_Timeout(void)
             {   // expired, remove it
                 TCPIP_OAHASH_EntryRemove(pArpDcpt->hashDcpt, &pE->hEntry);
                 TCPIP_Helper_ProtectedSingleListHeadRemove(&pArpDcpt->completeList);
+                pArpDcpt->stat.entriesExpired++;
                 _ARPNotifyClients(pIf, &pE->ipAddress, 0, ARP_EVENT_REMOVED_EXPIRED);
             }
             else
@@ -1041,15 +1078,38 @@ static void TCPIP_ARP_Timeout(void)
             }
         }
 
+#if (TCPIP_ARP_CACHE_REFRESH_TMO != 0)
+        // refresh the entries in use that are about to expire
+        // a unicast request is sent to the known hardware address;
+        // the reply confirms the entry and moves it to the tail
+        refreshStart = arpMod.entrySolvedTmo > TCPIP_ARP_CACHE_REFRESH_TMO ? arpMod.entrySolvedTmo - TCPIP_ARP_CACHE_REFRESH_TMO : arpMod.entrySolvedTmo / 2;
+        for(pN = pArpDcpt->completeList.list.head; pN != 0 && isConfig == false; pN = pN->next)
+        {
+            pE = (ARP_HASH_ENTRY*) ((uint8_t*)pN - offsetof(struct _TAG_ARP_HASH_ENTRY, next));
+            entryAge = arpMod.timeSeconds - pE->tInsert;
+            if(entryAge < refreshStart)
+            {   // this list is ordered, we can safely break out
+                break;
+            }
+
+            if((pE->hEntry.flags.value & ARP_FLAG_ENTRY_REFERENCED) != 0 && pE->nRetries <= arpMod.entryRetries &&
+                    entryAge >= refreshStart + (pE->nRetries - 1) * arpMod.entryRetryTmo)
+            {
+                _ARPSendIfPkt(pIf, ARP_OPERATION_REQ, (uint32_t)pIf->netIPAddr.Val, pE->ipAddress.Val, &pE->hwAdd, 0);
+                pE->nRetries++;
+                pArpDcpt->stat.refreshRequests++;
+            }
+        }
+#endif  // (TCPIP_ARP_CACHE_REFRESH_TMO != 0)
+
         // finally purge, if needed
         if(pArpDcpt->hashDcpt->fullSlots >= pArpDcpt->purgeThres)
         {
             for(purgeIx = 0; purgeIx < pArpDcpt->purgeQuanta; purgeIx++)
             {
-                pN = TCPIP_Helper_ProtectedSingleListHeadRemove(&pArpDcpt->completeList);
-                if(pN)
+                pE = _ARPCompleteVictimRemove(pArpDcpt);
+                if(pE)
                 {
-                    pE = (ARP_HASH_ENTRY*) ((uint8_t*)pN - offsetof(struct _TAG_ARP_HASH_ENTRY, next));
                     TCPIP_OAHASH_EntryRemove(pArpDcpt->hashDcpt, &pE->hEntry);
                     _ARPNotifyClients(pIf, &pE->ipAddress, 0, ARP_EVENT_REMOVED_PURGED);
                 }
@@ -1251,11 +1311,13 @@ static TCPIP_ARP_RESULT _ARPProbeAddress(TCPIP_NET_IF* pIf, IPV4_ADDR* IPAddr, I
     hE = TCPIP_OAHASH_EntryLookupOrInsert(pArpDcpt->hashDcpt, &IPAddr->Val);
     if(hE == 0)
     {   // oops!
+        pArpDcpt->stat.cacheMisses++;
         return ARP_RES_CACHE_FULL;
     }
         
     if(hE->flags.newEntry != 0)
     {   // new entry; add it to the not done list 
+        pArpDcpt->stat.cacheMisses++;
         ARP_ENTRY_FLAGS newFlags = (opType & ARP_OPERATION_CONFIGURE) != 0 ? ARP_FLAG_ENTRY_CONFIGURE : 0;
         if((opType & ARP_OPERATION_GRATUITOUS) != 0) 
         {
@@ -1268,8 +1330,6 @@ static TCPIP_ARP_RESULT _ARPProbeAddress(TCPIP_NET_IF* pIf, IPV4_ADDR* IPAddr, I
         return ARP_RES_ENTRY_NEW;
     }
     // else, even if it is not complete, TCPIP_ARP_Task will initiate retransmission
-    // Normally if the entry is existent, it should be refreshed, since it's obviously needed.
-    // However, the TCPIP_ARP_IsResolved() will do it, because that's the call that actually uses the entry!
     if((hE->flags.value & ARP_FLAG_ENTRY_VALID_MASK) != 0)
     {   // found address in cache
         ARP_HASH_ENTRY  *arpHE = (ARP_HASH_ENTRY*)hE;
@@ -1278,13 +1338,15 @@ static TCPIP_ARP_RESULT _ARPProbeAddress(TCPIP_NET_IF* pIf, IPV4_ADDR* IPAddr, I
             *pHwAdd = arpHE->hwAdd;
         }
         if((hE->flags.value & ARP_FLAG_ENTRY_COMPLETE) != 0 )
-        {   // an existent entry, re-used, gets refreshed
-            _ARPRefreshEntry(arpHE, &pArpDcpt->completeList);
+        {   // an existent entry, in use
+            _ARPReferenceEntry(arpHE);
         }
+        pArpDcpt->stat.cacheHits++;
         return ARP_RES_ENTRY_SOLVED;
     }
     
     // incomplete
+    pArpDcpt->stat.cacheMisses++;
     return ARP_RES_ENTRY_QUEUED;
 
 
@@ -1319,12 +1381,14 @@ bool TCPIP_ARP_IsResolved(TCPIP_NET_HANDLE hNet, IPV4_ADDR* IPAddr, TCPIP_MAC_AD
             *MACAddr = arpHE->hwAdd;
         }
         if((hE->flags.value & ARP_FLAG_ENTRY_COMPLETE) != 0 )
-        {   // an existent entry, re-used, gets refreshed
-            _ARPRefreshEntry(arpHE, &pArpDcpt->completeList);
+        {   // an existent entry, in use
+            _ARPReferenceEntry(arpHE);
         }
+        pArpDcpt->stat.cacheHits++;
         return true;
     }
     
+    pArpDcpt->stat.cacheMisses++;
     return false;
     
 }
@@ -1712,6 +1776,31 @@ TCPIP_ARP_RESULT TCPIP_ARP_CacheThresholdSet(TCPIP_NET_HANDLE hNet, int purgeThr
     return ARP_RES_OK;
 }
 
+TCPIP_ARP_RESULT TCPIP_ARP_StatisticsGet(TCPIP_NET_HANDLE hNet, TCPIP_ARP_STATISTICS* pStat, bool clear)
+{
+    TCPIP_NET_IF  *pIf;
+
+    pIf = _TCPIPStackHandleToNetUp(hNet);
+    if(!pIf)
+    {
+        return ARP_RES_NO_INTERFACE;
+    }
+    
+    ARP_CACHE_DCPT  *pArpDcpt = _ARPGetIfDcpt(pIf);
+
+    if(pStat)
+    {
+        *pStat = pArpDcpt->stat;
+    }
+
+    if(clear)
+    {
+        memset(&pArpDcpt->stat, 0, sizeof(pArpDcpt->stat));
+    }
+
+    return ARP_RES_OK;
+}
+
 #if !defined ( OA_HASH_DYNAMIC_KEY_MANIPULATION )
 
 // static versions
@@ -1754,7 +1843,8 @@ OA_HASH_ENTRY* TCPIP_OAHASH_EntryDelete(OA_HASH_DCPT* pOH)
 
     if(pRemList == 0)
     {   // no luck with the incomplete list; use the complete one
-            pRemList = &pArpDcpt->completeList;
+        pE = _ARPCompleteVictimRemove(pArpDcpt);
+        return pE != 0 ? &pE->hEntry : 0;
     }
 
     pN = TCPIP_Helper_SingleListHeadRemove(pRemList);
@@ -1824,7 +1914,8 @@ OA_HASH_ENTRY* TCPIP_ARP_HashEntryDelete(OA_HASH_DCPT* pOH)
 
     if(pRemList == 0)
     {   // no luck with the incomplete list; use the complete one
-            pRemList = &pArpDcpt->completeList;
+        pE = _ARPCompleteVictimRemove(pArpDcpt);
+        return pE != 0 ? &pE->hEntry : 0;
     }
 
     pN = TCPIP_Helper_ProtectedSingleListHeadRemove(pRemList);
@@ -155,6 +155,33 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 // Standard sets it to 10 secs
 #define TCPIP_DHCP_WAIT_FAIL_CHECK_TMO   10
 
+// Number of interfaces, starting with index 0, that keep
+// their last lease across a reset, for an INIT-REBOOT
+// at the next link up. 0 disables the persisted lease.
+#if !defined(TCPIP_DHCP_LEASE_PERSIST_INTERFACES)
+#define TCPIP_DHCP_LEASE_PERSIST_INTERFACES     1
+#endif
+
+// Time to wait for an answer to the ARP probe that is sent
+// together with an INIT-REBOOT request, milliseconds
+// It replaces TCPIP_DHCP_LEASE_CHECK_TMO for a reused address.
+#if !defined(TCPIP_DHCP_REBOOT_PROBE_TMO)
+#define TCPIP_DHCP_REBOOT_PROBE_TMO     500
+#endif
+
+// persisted lease record signature
+#define TCPIP_DHCP_LEASE_RECORD_MAGIC   0x44484350u
+
+// last lease of an interface
+// kept in persistent RAM, not cleared by the start-up code
+typedef struct
+{
+    uint32_t    magic;          // TCPIP_DHCP_LEASE_RECORD_MAGIC
+    uint32_t    bindKey;        // key of the network that granted the lease
+    uint32_t    ipAddress;      // leased address
+    uint32_t    checksum;       // ~(magic ^ bindKey ^ ipAddress)
+}TCPIP_DHCP_LEASE_RECORD;
+
 
 
 // DHCP UDP socket minimum size for being able to carry
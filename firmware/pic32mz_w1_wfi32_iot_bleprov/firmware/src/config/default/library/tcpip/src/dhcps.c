@@ -83,6 +83,13 @@ static const void*          dhcpSMemH = 0;        // memory handle
 
 static int                  dhcpSInitCount = 0;     // initialization count
 
+static PROTECTED_SINGLE_LIST dhcpsRegisteredUsers = { {0} };
+
+#if (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+// bound leases kept across a reset
+static TCPIP_DHCPS_LEASE_STORE __attribute__((persistent)) dhcpsLeaseStore;
+#endif  // (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+
 static void _DHCPSUpdateEntry(DHCPS_HASH_ENTRY* dhcpsHE);
 static bool _DHCPS_GetOptionLen(TCPIP_DHCPS_DATA *inputBuf,uint8_t *optionVal,uint8_t *optionLen);
 static void DHCPReplyToDiscovery(TCPIP_NET_IF* pNetIf,BOOTP_HEADER *Header,DHCP_SRVR_DCPT * pDhcpsDcpt,DHCPS_HASH_DCPT *pdhcpsHashDcpt,TCPIP_DHCPS_DATA *getBuf);
@@ -97,8 +104,22 @@ static DHCPS_RESULT preAssignToDHCPClient(TCPIP_NET_IF* pNetIf,BOOTP_HEADER *Hea
 static bool isMacAddrEffective(const TCPIP_MAC_ADDR *macAddr);
 static void DHCPSReplyToInform(TCPIP_NET_IF* pNetIf,BOOTP_HEADER *boot_header, DHCP_SRVR_DCPT* pDhcpsDcpt,DHCPS_HASH_DCPT *pdhcpsHashDcpt,bool bAccept,TCPIP_DHCPS_DATA *getBuf);
 static void _DHCPSrvClose(TCPIP_NET_IF* pNetIf, bool disable);
-static size_t DHCPSgetFreeHashIndex(OA_HASH_DCPT* pOH,void* key,IPV4_ADDR *requestedAddr,IPV4_ADDR *ipAddrExists);
-static DHCPS_RESULT DHCPSLocateRequestedIpAddress(IPV4_ADDR *requestedAddr);
+static int _DHCPSPoolOffset(DHCP_SRVR_DCPT* pDcpt, IPV4_ADDR addr);
+static bool _DHCPSPoolAddressInUse(DHCP_SRVR_DCPT* pDcpt, IPV4_ADDR addr);
+static bool _DHCPSPoolAddressGet(DHCP_SRVR_DCPT* pDcpt, const TCPIP_MAC_ADDR* hwAdd, IPV4_ADDR excludeAddr, IPV4_ADDR* pAddr);
+static void _DHCPSPoolMark(int intfIdx, IPV4_ADDR addr, bool inUse);
+static void _DHCPSPoolMapReset(void);
+static void _DHCPSEntryRemove(OA_HASH_DCPT* pOH, DHCPS_HASH_ENTRY* dhcpsHE, TCPIP_DHCPS_EVENT_TYPE evType);
+static void _DHCPSLeaseEvent(DHCPS_HASH_ENTRY* dhcpsHE, TCPIP_DHCPS_EVENT_TYPE evType);
+#if (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+static void _DHCPSLeaseStoreDirty(void);
+static void _DHCPSLeaseStoreFlush(void);
+static void _DHCPSLeaseStoreRestore(TCPIP_NET_IF* pNetIf);
+#else
+#define _DHCPSLeaseStoreDirty()
+#define _DHCPSLeaseStoreFlush()
+#define _DHCPSLeaseStoreRestore(pNetIf)
+#endif  // (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
 static  DHCPS_RESULT DHCPSRemoveHashEntry(TCPIP_MAC_ADDR* hwAdd, const uint8_t* pIPAddr);
 static int TCPIP_DHCPS_CopyDataArrayToProcessBuff(uint8_t *val ,TCPIP_DHCPS_DATA *putbuf,int len);
 static void TCPIP_DHCPS_DataCopyToProcessBuffer(uint8_t val ,TCPIP_DHCPS_DATA *putbuf);
@@ -169,6 +190,7 @@ static void _DhcpsICMPDebugMessage(char* icmpMessage)
     if(pDHCPSHashDcpt->hashDcpt)
     {
         TCPIP_OAHASH_EntriesRemoveAll(pDHCPSHashDcpt->hashDcpt);
+        _DHCPSPoolMapReset();
     }
 }
 
@@ -190,7 +212,7 @@ static  DHCPS_RESULT DHCPSRemoveHashEntry(TCPIP_MAC_ADDR* hwAdd, const uint8_t*
         {
             if(TCPIP_DHCPS_HashIPKeyCompare(pDhcpsHashDcpt->hashDcpt, hE, pIPAddr)== 0)
             {
-                TCPIP_OAHASH_EntryRemove(pDhcpsHashDcpt->hashDcpt, hE);
+                _DHCPSEntryRemove(pDhcpsHashDcpt->hashDcpt, (DHCPS_HASH_ENTRY*)hE, TCPIP_DHCPS_EVENT_LEASE_RELEASED);
                 return DHCPS_RES_OK;
             }
         }
@@ -202,11 +224,16 @@ static  DHCPS_RESULT DHCPSRemoveHashEntry(TCPIP_MAC_ADDR* hwAdd, const uint8_t*
 
 static void _DHCPSUpdateEntry(DHCPS_HASH_ENTRY* dhcpsHE)
 {    
+     bool newLease = (dhcpsHE->hEntry.flags.value & DHCPS_FLAG_ENTRY_COMPLETE) == 0;
+
      dhcpsHE->Client_Lease_Time = SYS_TMR_TickCountGet();
      dhcpsHE->pendingTime = 0;
 
      dhcpsHE->hEntry.flags.value &= ~DHCPS_FLAG_ENTRY_VALID_MASK;
      dhcpsHE->hEntry.flags.value |= DHCPS_FLAG_ENTRY_COMPLETE;
+
+     // a renewal only needs to be persisted
+     _DHCPSLeaseEvent(dhcpsHE, newLease ? TCPIP_DHCPS_EVENT_LEASE_BOUND : TCPIP_DHCPS_EVENT_NONE);
 }
 
 // validate the IP address pool from the DHCP server configuration and poolCnt returns the valid pool numbers
@@ -286,6 +313,21 @@ static void dhcpServPoolAddressValidation(const TCPIP_DHCPS_MODULE_CONFIG* pDhcp
     *poolCnt = tempPoolCnt;
 }
 
+// returns the number of pool addresses: the lease entries,
+// limited to the addresses left in the subnet after the pool start
+static size_t _DHCPSPoolSize(const DHCPS_INTERFACE_CONFIG* pConf, size_t leaseEntries)
+{
+    uint32_t startAdd = TCPIP_Helper_ntohl(pConf->startIPAddress.Val);
+    uint32_t bcastAdd = TCPIP_Helper_ntohl(pConf->serverIPAddress.Val | ~pConf->serverMask.Val);
+
+    if(startAdd == 0 || startAdd >= bcastAdd)
+    {
+        return 0;
+    }
+
+    return (bcastAdd - startAdd) < leaseEntries ? bcastAdd - startAdd : leaseEntries;
+}
+
 // DHCP server descriptor update has been done at the init  time only.
 static void _DHCPS_AddressPoolDescConfiguration(const TCPIP_DHCPS_MODULE_CONFIG* pDhcpsConfig)
 {
@@ -337,6 +379,7 @@ static void _DHCPS_AddressPoolDescConfiguration(const TCPIP_DHCPS_MODULE_CONFIG*
 #endif
         pServerDcpt->intfAddrsConf.poolIndex = localPoolIndex;
         pServerDcpt->netIx = pPoolServer->interfaceIndex;
+        pServerDcpt->poolSize = _DHCPSPoolSize(&pServerDcpt->intfAddrsConf, pDhcpsConfig->leaseEntries);
 
         localPoolIndex++;
        
@@ -356,6 +399,9 @@ bool TCPIP_DHCPS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, cons
     size_t hashMemSize=0;
     OA_HASH_DCPT*   hashDcpt;
     int poolCnt=0;
+    int ix;
+    size_t mapWords;
+    uint32_t* pMap;
 
     if(stackCtrl->stackAction == TCPIP_STACK_ACTION_IF_UP)
     {   // interface restart
@@ -380,12 +426,18 @@ bool TCPIP_DHCPS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, cons
         dhcpSMemH = stackCtrl->memH;
         dhcpServPoolAddressValidation(pDhcpsConfig,stackCtrl->nIfs,&poolCnt);
         if(poolCnt > 0)
-        {
-            gPdhcpSDcpt = (DHCP_SRVR_DCPT*)TCPIP_HEAP_Calloc(dhcpSMemH, poolCnt, sizeof(DHCP_SRVR_DCPT));
+        {   // the pool address bitmaps follow the descriptors
+            mapWords = DHCPS_POOL_MAP_WORDS(pDhcpsConfig->leaseEntries);
+            gPdhcpSDcpt = (DHCP_SRVR_DCPT*)TCPIP_HEAP_Calloc(dhcpSMemH, poolCnt, sizeof(DHCP_SRVR_DCPT) + mapWords * sizeof(uint32_t));
             if(gPdhcpSDcpt == 0)
             {   // failed
                 return false;
             }
+            pMap = (uint32_t*)(gPdhcpSDcpt + poolCnt);
+            for(ix = 0; ix < poolCnt; ix++, pMap += mapWords)
+            {
+                gPdhcpSDcpt[ix].addrMap = pMap;
+            }
         }
         else
         {
@@ -428,7 +480,7 @@ bool TCPIP_DHCPS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, cons
         }
 		
         dhcps_mod.signalHandle =_TCPIPStackSignalHandlerRegister(TCPIP_THIS_MODULE_ID, TCPIP_DHCPS_Task, TCPIP_DHCPS_TASK_PROCESS_RATE);
-        if(dhcps_mod.signalHandle == 0)
+        if(dhcps_mod.signalHandle == 0 || !TCPIP_Notification_Initialize(&dhcpsRegisteredUsers))
         {
             _DHCPServerCleanup();
             return false;
@@ -438,11 +490,14 @@ bool TCPIP_DHCPS_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, cons
         dhcps_mod.poolCount = poolCnt;
         dhcps_mod.dhcpNextLease.Val = 0;
         dhcps_mod.smState = TCPIP_DHCPS_STATE_IDLE;
+        dhcps_mod.storeDirtyTick = 0;
+        memset(&dhcps_mod.stat, 0, sizeof(dhcps_mod.stat));
         memset(&gBOOTPHeader,0,sizeof(gBOOTPHeader));
 
         // expected that max number of pool entry is similar to the interface index
         // copy the valid interface details to the global dhcps descriptor table
        _DHCPS_AddressPoolDescConfiguration(pDhcpsConfig);
+       _DHCPSPoolMapReset();
     }
 	
     if(stackCtrl->pNetIf->Flags.bIsDHCPSrvEnabled != 0)
@@ -481,6 +536,7 @@ static void _DHCPServerCleanup(void)
     // Free HASH descriptor 
     if(gPdhcpsHashDcpt.hashDcpt != NULL)
     {
+        _DHCPSLeaseStoreFlush();
         // Remove all the HASH entries
         _DHCPSRemoveCacheEntries(&gPdhcpsHashDcpt);
         TCPIP_HEAP_Free(dhcpSMemH,gPdhcpsHashDcpt.hashDcpt);
@@ -497,6 +553,7 @@ static void _DHCPServerCleanup(void)
         _TCPIPStackSignalHandlerDeregister(dhcps_mod.signalHandle);
         dhcps_mod.signalHandle = 0;
     }
+    TCPIP_Notification_Deinitialize(&dhcpsRegisteredUsers, dhcpSMemH);
 }
 #endif  // (TCPIP_STACK_DOWN_OPERATION != 0)
 
@@ -623,6 +680,8 @@ void TCPIP_DHCPS_Task(void)
             //update global variable that can be used for @HS
             dhcps_mod.smState = TCPIP_DHCPS_GET_NEW_ADDRESS;
             dhcps_mod.smServer = DHCP_SERVER_LISTEN;
+            // probe another address now and serve the messages queued meanwhile
+            TCPIP_DHCPS_Process();
             return;
         }
         else if(res == DHCPS_RES_NO_ENTRY)
@@ -630,6 +689,8 @@ void TCPIP_DHCPS_Task(void)
             //update global variable that can be used for @HS
             dhcps_mod.smState = TCPIP_DHCPS_SEND_OFFER;
             dhcps_mod.smServer = DHCP_SERVER_LISTEN;
+            // send the offer now and serve the messages queued meanwhile
+            TCPIP_DHCPS_Process();
         }
     }
         
@@ -703,9 +764,8 @@ static bool _DHCPS_ProcessGetPktandSendResponse(void)
                     continue;
                 }
                 if(dhcps_mod.smServer == DHCP_SERVER_ICMP_PROCESS)
-                {
-                    TCPIP_UDP_Discard(s);
-                    continue;
+                {   // leave it queued; processed when the address probe is done
+                    return false;
                 }
                 memset(getBuffer,0,sizeof(getBuffer));
                 pdhcpsHashDcpt = &gPdhcpsHashDcpt;
@@ -835,6 +895,9 @@ static bool _DHCPS_ProcessGetPktandSendResponse(void)
                         }
                         if(i == DHCP_DISCOVER_MESSAGE)
                         {
+                            dhcps_mod.stat.discovers++;
+                            dhcps_mod.discoverTick = SYS_TMR_TickCountGet();
+                            ClientIP.Val = 0;
                             if(_DCHPS_FindRequestIPAddress(&udpGetBufferData,ClientIP.v)!= true)
                             {
                                 dhcpsSmSate = TCPIP_DHCPS_START_RECV_NEW_PACKET;
@@ -842,13 +905,13 @@ static bool _DHCPS_ProcessGetPktandSendResponse(void)
                             }
                             else
                             { // 
-                                 /* Validating if the requested IP address should not be part of any Hash Entry */
-                                if(DHCPSLocateRequestedIpAddress((IPV4_ADDR *)&ClientIP) != DHCPS_RES_OK)
+                                 /* The requested IP address is used only if it's a free pool address */
+                                if(_DHCPSPoolOffset(pDhcpsDcpt, ClientIP) < 0 || _DHCPSPoolAddressInUse(pDhcpsDcpt, ClientIP))
                                 { // use the alternate address
                                     dhcps_mod.dhcpNextLease.Val = 0;
                                 }
                                 else
-                                {// address is present
+                                {// address is free
                                     dhcps_mod.dhcpNextLease.Val = ClientIP.Val;
                                 }
                                 // Find the new address
@@ -1208,8 +1271,16 @@ static void DHCPReplyToDiscovery(TCPIP_NET_IF *pNetIf,BOOTP_HEADER *Header,DHCP_
     TCPIP_UDP_TxOffsetSet(s,(uint16_t)(putBuffer.wrPtr - putBuffer.head), false);
 
     // Transmit the packet
-    TCPIP_UDP_Flush(s);
-
+    if(TCPIP_UDP_Flush(s) != 0)
+    {
+        uint32_t latency = (uint32_t)(((uint64_t)(SYS_TMR_TickCountGet() - dhcps_mod.discoverTick) * 1000) / SYS_TMR_TickCounterFrequencyGet());
+        dhcps_mod.stat.offers++;
+        dhcps_mod.stat.offerLatencyTotal += latency;
+        if(latency > dhcps_mod.stat.offerLatencyMax)
+        {
+            dhcps_mod.stat.offerLatencyMax = latency;
+        }
+    }
 }
 
 // Replies to a DHCP Inform message.
@@ -1517,7 +1588,7 @@ static void DHCPReplyToRequest(TCPIP_NET_IF* pNetIf,BOOTP_HEADER *boot_header, b
                     }
                     else
                     {
-                        TCPIP_OAHASH_EntryRemove(pdhcpsHashDcpt->hashDcpt,hE);
+                        _DHCPSEntryRemove(pdhcpsHashDcpt->hashDcpt, (DHCPS_HASH_ENTRY*)hE, TCPIP_DHCPS_EVENT_LEASE_RELEASED);
                         bAccept = false;
                     }
                 }
@@ -1554,7 +1625,7 @@ static void DHCPReplyToRequest(TCPIP_NET_IF* pNetIf,BOOTP_HEADER *boot_header, b
                     {
                         bAccept = false;
                         //remove Hash entry;
-                        TCPIP_OAHASH_EntryRemove(pdhcpsHashDcpt->hashDcpt,hE);
+                        _DHCPSEntryRemove(pdhcpsHashDcpt->hashDcpt, (DHCPS_HASH_ENTRY*)hE, TCPIP_DHCPS_EVENT_LEASE_RELEASED);
                     }
                 }
                 else
@@ -1564,6 +1635,12 @@ static void DHCPReplyToRequest(TCPIP_NET_IF* pNetIf,BOOTP_HEADER *boot_header, b
                         bAccept = false;
                         break;
                     }
+                    ipAddr.Val = dw;
+                    if(_DHCPSPoolAddressInUse(pDhcpsDcpt, ipAddr))
+                    {   // leased or offered to another client
+                        bAccept = false;
+                        break;
+                    }
                     if(_DHCPSAddCompleteEntry(pNetIf->netIfIx, (uint8_t*)&dw, &boot_header->ClientMAC, DHCPS_FLAG_ENTRY_COMPLETE)!= DHCPS_RES_OK)
                     {
                         return ;
@@ -1726,7 +1803,17 @@ static void DHCPReplyToRequest(TCPIP_NET_IF* pNetIf,BOOTP_HEADER *boot_header, b
     TCPIP_UDP_TxOffsetSet(s,(uint16_t)(putBuffer.wrPtr - putBuffer.head), false);
 
     // Transmit the packet
-    TCPIP_UDP_Flush(s);
+    if(TCPIP_UDP_Flush(s) != 0)
+    {
+        if(bAccept)
+        {
+            dhcps_mod.stat.acks++;
+        }
+        else
+        {
+            dhcps_mod.stat.naks++;
+        }
+    }
 }
 
 static bool isMacAddrEffective(const TCPIP_MAC_ADDR *macAddr)
@@ -1760,6 +1847,11 @@ static bool _DHCPSAddCompleteEntry(int intfIdx, const uint8_t* pIPAddr, TCPIP_MA
     {   // populate the new entry
     	dhcpsHE->intfIdx = intfIdx;
         _DHCPSSetHashEntry(dhcpsHE, entryFlag, hwAdd, pIPAddr);
+        _DHCPSPoolMark(intfIdx, dhcpsHE->ipAddress, true);
+        if(entryFlag == DHCPS_FLAG_ENTRY_COMPLETE)
+        {
+            _DHCPSLeaseEvent(dhcpsHE, TCPIP_DHCPS_EVENT_LEASE_BOUND);
+        }
     }
     else
     {   // existent entry
@@ -1801,7 +1893,7 @@ static void TCPIP_DHCPS_TaskForLeaseTime(void)
             if((current_timer - dhcpsHE->Client_Lease_Time) >= pdhcpsDcpt->leaseDuartion* SYS_TMR_TickCounterFrequencyGet())
             {
                 dhcpsHE->Client_Lease_Time = 0;
-                TCPIP_OAHASH_EntryRemove(pOH,hE);
+                _DHCPSEntryRemove(pOH, dhcpsHE, TCPIP_DHCPS_EVENT_LEASE_EXPIRED);
             }
     	}// Check if there is any entry whose DHCPS flag is INCOMPLETE, 
         // i,e DHCPS server did not receive the request from the client regarding that leased address.
@@ -1811,28 +1903,40 @@ static void TCPIP_DHCPS_TaskForLeaseTime(void)
             if((current_timer - dhcpsHE->pendingTime) >= TCPIP_DHCPS_LEASE_REMOVED_BEFORE_ACK* SYS_TMR_TickCounterFrequencyGet())
             {
                 dhcpsHE->pendingTime = 0;
-                TCPIP_OAHASH_EntryRemove(pOH,hE);
+                _DHCPSEntryRemove(pOH, dhcpsHE, TCPIP_DHCPS_EVENT_NONE);
             }
     	}
-        // remove the entry if the link is down or Wifi Mac is not connected
-        if(hE->flags.busy != 0)
+        // remove the pending offers if the link is down or Wifi Mac is not connected
+        // the bound leases are kept until they expire,
+        // so that the clients get the same address once the link is restored
+        if((hE->flags.busy != 0) && (hE->flags.value & DHCPS_FLAG_ENTRY_INCOMPLETE))
         {
             dhcpsHE = (DHCPS_HASH_ENTRY*)hE;
             pNetIf = (TCPIP_NET_IF*)TCPIP_STACK_IndexToNet(dhcpsHE->intfIdx);
             if(pNetIf && !TCPIP_STACK_NetworkIsLinked(pNetIf))
             {                
                 dhcpsHE->pendingTime = 0;
-                TCPIP_OAHASH_EntryRemove(pOH,hE);
+                _DHCPSEntryRemove(pOH, dhcpsHE, TCPIP_DHCPS_EVENT_NONE);
             }
         }
     }
+
+#if (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+    if(dhcps_mod.storeDirtyTick != 0)
+    {
+        if((SYS_TMR_TickCountGet() - dhcps_mod.storeDirtyTick) >= (TCPIP_DHCPS_LEASE_PERSIST_DELAY * SYS_TMR_TickCounterFrequencyGet()) / 1000)
+        {   // lazy write back of the lease changes
+            _DHCPSLeaseStoreFlush();
+        }
+    }
+#endif  // (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
 }
 
 static DHCPS_RESULT _DHCPS_FindValidAddressFromPool(BOOTP_HEADER *Header,DHCP_SRVR_DCPT * pDhcpsDcpt,DHCPS_HASH_DCPT *pdhcpsHashDcpt,IPV4_ADDR *reqIPAddress)
 {
     OA_HASH_ENTRY   	*hE;
+    DHCPS_HASH_ENTRY*   dhcpsHE;
     IPV4_ADDR		  tempIpv4Addr;
-    size_t bktIx = 0;
     
     if(reqIPAddress != 0)
     {
@@ -1852,34 +1956,23 @@ static DHCPS_RESULT _DHCPS_FindValidAddressFromPool(BOOTP_HEADER *Header,DHCP_SR
     hE = TCPIP_OAHASH_EntryLookup(pdhcpsHashDcpt->hashDcpt, &Header->ClientMAC);
     if(hE !=0)
     {
-        if((DHCPSLocateRequestedIpAddress(&tempIpv4Addr) != DHCPS_RES_OK)&&(dhcps_mod.smState == TCPIP_DHCPS_GET_NEW_ADDRESS))
-        {
-            bktIx = DHCPSgetFreeHashIndex(pdhcpsHashDcpt->hashDcpt, &Header->ClientMAC,&pDhcpsDcpt->intfAddrsConf.startIPAddress,(IPV4_ADDR*)&tempIpv4Addr);
-            if(bktIx == -1)
-            {
-                return DHCPS_RES_CACHE_FULL;
-            }
-            dhcps_mod.dhcpNextLease.v[0] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[0] & 0xFF;
-            dhcps_mod.dhcpNextLease.v[1] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[1] & 0xFF;
-            dhcps_mod.dhcpNextLease.v[2] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[2] & 0xFF;
-            dhcps_mod.dhcpNextLease.v[3] = (pDhcpsDcpt->intfAddrsConf.startIPAddress.v[3] & 0xFF) + bktIx;
+        dhcpsHE = (DHCPS_HASH_ENTRY*)hE;
+        if(dhcps_mod.smState != TCPIP_DHCPS_GET_NEW_ADDRESS)
+        {   // offer the address the client already has
+            dhcps_mod.dhcpNextLease.Val = dhcpsHE->ipAddress.Val;
+            return DHCPS_RES_OK;
         }
-        return DHCPS_RES_OK;
+        // the client address answered the probe; it's used by another host
+        _DHCPSEntryRemove(pdhcpsHashDcpt->hashDcpt, dhcpsHE, TCPIP_DHCPS_EVENT_LEASE_RELEASED);
     }
-    else
+
+    if((dhcps_mod.dhcpNextLease.Val == 0)||(dhcps_mod.smState == TCPIP_DHCPS_GET_NEW_ADDRESS))
     {
-        if((dhcps_mod.dhcpNextLease.Val == 0)||(dhcps_mod.smState == TCPIP_DHCPS_GET_NEW_ADDRESS))
+        if(!_DHCPSPoolAddressGet(pDhcpsDcpt, &Header->ClientMAC, tempIpv4Addr, &dhcps_mod.dhcpNextLease))
         {
-            bktIx = DHCPSgetFreeHashIndex(pdhcpsHashDcpt->hashDcpt, &Header->ClientMAC,&pDhcpsDcpt->intfAddrsConf.startIPAddress,(IPV4_ADDR*)&tempIpv4Addr);
-            if(bktIx == -1)
-            {
-                return DHCPS_RES_CACHE_FULL;
-            }
-            dhcps_mod.dhcpNextLease.v[0] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[0] & 0xFF;
-            dhcps_mod.dhcpNextLease.v[1] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[1] & 0xFF;
-            dhcps_mod.dhcpNextLease.v[2] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[2] & 0xFF;
-            dhcps_mod.dhcpNextLease.v[3] = (pDhcpsDcpt->intfAddrsConf.startIPAddress.v[3] & 0xFF) + bktIx;
-        }        
+            dhcps_mod.stat.poolFull++;
+            return DHCPS_RES_CACHE_FULL;
+        }
     }
 
     return DHCPS_RES_OK;
@@ -1890,7 +1983,7 @@ static DHCPS_RESULT preAssignToDHCPClient(TCPIP_NET_IF  *pNetIf,BOOTP_HEADER *He
 {
     OA_HASH_ENTRY   	*hE;
     IPV4_ADDR		  tempIpv4Addr;
-    size_t bktIx = 0;
+    IPV4_ADDR		  noAddr;
 
     if(false == isMacAddrEffective(&(Header->ClientMAC))) 
     {
@@ -1907,15 +2000,11 @@ static DHCPS_RESULT preAssignToDHCPClient(TCPIP_NET_IF  *pNetIf,BOOTP_HEADER *He
     {
         if(dhcps_mod.dhcpNextLease.Val == 0)
         {
-            bktIx = DHCPSgetFreeHashIndex(pdhcpsHashDcpt->hashDcpt, &Header->ClientMAC,&pDhcpsDcpt->intfAddrsConf.startIPAddress,(IPV4_ADDR*)NULL);
-            if(bktIx == -1)
+            noAddr.Val = 0;
+            if(!_DHCPSPoolAddressGet(pDhcpsDcpt, &Header->ClientMAC, noAddr, &tempIpv4Addr))
             {
                 return DHCPS_RES_CACHE_FULL;
             }
-            tempIpv4Addr.v[0] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[0] & 0xFF;
-            tempIpv4Addr.v[1] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[1] & 0xFF;
-            tempIpv4Addr.v[2] = pDhcpsDcpt->intfAddrsConf.startIPAddress.v[2] & 0xFF;
-            tempIpv4Addr.v[3] = (pDhcpsDcpt->intfAddrsConf.startIPAddress.v[3] & 0xFF) + bktIx;
         }
         else
         {
@@ -1966,7 +2055,12 @@ OA_HASH_ENTRY* TCPIP_DHCPS_HashDeleteEntry(OA_HASH_DCPT* pOH)
         {
             pE = (DHCPS_HASH_ENTRY*)pBkt;
             if((current_timer - pE->Client_Lease_Time) >= TCPIP_DHCPS_LEASE_DURATION* SYS_TMR_TickCounterFrequencyGet())
-            {
+            {   // the hash reuses the entry; release its address
+                _DHCPSPoolMark(pE->intfIdx, pE->ipAddress, false);
+                if((pE->hEntry.flags.value & DHCPS_FLAG_ENTRY_COMPLETE) != 0)
+                {
+                    _DHCPSLeaseEvent(pE, TCPIP_DHCPS_EVENT_LEASE_EXPIRED);
+                }
                 return pBkt;
             }
         }
@@ -1974,98 +2068,298 @@ OA_HASH_ENTRY* TCPIP_DHCPS_HashDeleteEntry(OA_HASH_DCPT* pOH)
     return 0;
 }
 
-// to get the free index and to use it for calculating Leased IP address.
-static size_t DHCPSgetFreeHashIndex(OA_HASH_DCPT* pOH,void* key,IPV4_ADDR *ipAddr,IPV4_ADDR *ipAddrExists)
+// returns the pool descriptor of an interface, 0 if none
+static DHCP_SRVR_DCPT* _DHCPSPoolFromIntf(int intfIdx)
 {
-    OA_HASH_ENTRY*  pBkt;
-    size_t      bktIx=-1;
-    size_t      probeStep=0;
-    size_t      bkts = 0;
-    TCPIP_UINT32_VAL   dw;
-    TCPIP_UINT32_VAL   reqIP;
+    uint32_t poolIndex;
+    TCPIP_NET_IF* pNetIf = (TCPIP_NET_IF*)TCPIP_STACK_IndexToNet(intfIdx);
 
-	
-#if defined(OA_DOUBLE_HASH_PROBING)
-    probeStep = TCPIP_DHCPS_HashProbeHash(pOH, key);
-    if(probeStep == 0)
-    {	// try to avoid probing the same bucket over and over again
-            // when probeHash returns 0.
-            probeStep = pOH->probeStep;
+    if(pNetIf != 0 && _DHCPSDescriptorGetFromIntf(pNetIf, &poolIndex))
+    {
+        return gPdhcpSDcpt + poolIndex;
     }
-#else
-    probeStep = pOH->probeStep;
-#endif  // defined(OA_DOUBLE_HASH_PROBING)
-    if(ipAddrExists != NULL) 
-    {// this is added for ICMP processing 
-        if(ipAddrExists->Val != 0)
+    return 0;
+}
+
+// returns the pool offset of an address, -1 if the address is not in the pool
+static int _DHCPSPoolOffset(DHCP_SRVR_DCPT* pDcpt, IPV4_ADDR addr)
+{
+    uint32_t poolOffset = TCPIP_Helper_ntohl(addr.Val) - TCPIP_Helper_ntohl(pDcpt->intfAddrsConf.startIPAddress.Val);
+
+    return poolOffset < pDcpt->poolSize ? (int)poolOffset : -1;
+}
+
+// returns true if the address is a pool address that's leased or offered
+static bool _DHCPSPoolAddressInUse(DHCP_SRVR_DCPT* pDcpt, IPV4_ADDR addr)
+{
+    int poolOffset = _DHCPSPoolOffset(pDcpt, addr);
+
+    return poolOffset >= 0 && (pDcpt->addrMap[poolOffset >> 5] & (1u << (poolOffset & 0x1f))) != 0;
+}
+
+// selects a free pool address for a client
+// the address of the client MAC hash slot is preferred, so that a client
+// gets the same address for as long as it's free;
+// otherwise the first free address in the bitmap is taken.
+// excludeAddr is an address that cannot be used (answered the ICMP probe)
+static bool _DHCPSPoolAddressGet(DHCP_SRVR_DCPT* pDcpt, const TCPIP_MAC_ADDR* hwAdd, IPV4_ADDR excludeAddr, IPV4_ADDR* pAddr)
+{
+    int mapIx, poolOffset, excludeOffset;
+    uint32_t freeMask;
+
+    if(pDcpt->poolSize == 0)
+    {
+        return false;
+    }
+
+    excludeOffset = _DHCPSPoolOffset(pDcpt, excludeAddr);
+    poolOffset = fnv_32_hash(hwAdd, DHCPS_HASH_KEY_SIZE) % pDcpt->poolSize;
+
+    if(poolOffset == excludeOffset || (pDcpt->addrMap[poolOffset >> 5] & (1u << (poolOffset & 0x1f))) != 0)
+    {   // preferred address not available
+        poolOffset = -1;
+        for(mapIx = 0; mapIx < DHCPS_POOL_MAP_WORDS(pDcpt->poolSize); mapIx++)
+        {
+            freeMask = ~pDcpt->addrMap[mapIx];
+            if(excludeOffset >= 0 && (excludeOffset >> 5) == mapIx)
+            {
+                freeMask &= ~(1u << (excludeOffset & 0x1f));
+            }
+            if(freeMask != 0)
+            {
+                poolOffset = (mapIx << 5) + __builtin_ctz(freeMask);
+                break;
+            }
+        }
+
+        if(poolOffset < 0)
+        {   // pool exhausted
+            return false;
+        }
+    }
+
+    pAddr->Val = TCPIP_Helper_htonl(TCPIP_Helper_ntohl(pDcpt->intfAddrsConf.startIPAddress.Val) + poolOffset);
+    return true;
+}
+
+// marks a leased/offered address in the pool bitmap of the interface
+static void _DHCPSPoolMark(int intfIdx, IPV4_ADDR addr, bool inUse)
+{
+    int poolOffset;
+    DHCP_SRVR_DCPT* pDcpt = _DHCPSPoolFromIntf(intfIdx);
+
+    if(pDcpt != 0 && (poolOffset = _DHCPSPoolOffset(pDcpt, addr)) >= 0)
+    {
+        if(inUse)
         {
-            reqIP.Val = ipAddrExists->Val;
-            bktIx = reqIP.v[3] ^ ipAddr->v[3];
+            pDcpt->addrMap[poolOffset >> 5] |= 1u << (poolOffset & 0x1f);
         }
         else
         {
-            reqIP.Val = 0;
-            bktIx = -1;
+            pDcpt->addrMap[poolOffset >> 5] &= ~(1u << (poolOffset & 0x1f));
         }
     }
-    else
+}
+
+// clears the pool bitmaps and marks the addresses of the existing entries
+// the bits past the pool end are set, so they're never selected
+static void _DHCPSPoolMapReset(void)
+{
+    int ix;
+    size_t mapWords;
+    DHCP_SRVR_DCPT* pDcpt;
+    OA_HASH_DCPT* pOH;
+    DHCPS_HASH_ENTRY* dhcpsHE;
+
+    if(gPdhcpSDcpt == 0)
     {
-        reqIP.Val = 0;
-        bktIx = -1;
+        return;
     }
-    
-    if((bktIx ==0xFFFFFFFF)||(bktIx >  pOH->hEntries))
+
+    for(ix = 0, pDcpt = gPdhcpSDcpt; ix < dhcps_mod.poolCount; ix++, pDcpt++)
     {
-        bktIx = TCPIP_DHCPS_MACHashKeyHash(pOH,key);
+        mapWords = DHCPS_POOL_MAP_WORDS(pDcpt->poolSize);
+        if(mapWords != 0)
+        {
+            memset(pDcpt->addrMap, 0, mapWords * sizeof(uint32_t));
+            if((pDcpt->poolSize & 0x1f) != 0)
+            {
+                pDcpt->addrMap[mapWords - 1] = ~((1u << (pDcpt->poolSize & 0x1f)) - 1);
+            }
+        }
     }
 
-    while(bkts < pOH->hEntries)
+    if((pOH = gPdhcpsHashDcpt.hashDcpt) != 0)
     {
-        pBkt = TCPIP_OAHASH_EntryGet(pOH, bktIx);
-        dw.Val = ipAddr->Val;
-        dw.v[3] |= bktIx;
-        if((reqIP.Val == 0) || (reqIP.Val != dw.Val))
-        {        
-            if((pBkt->flags.busy == 0) &&(DHCPSLocateRequestedIpAddress((IPV4_ADDR*)&dw.Val)==DHCPS_RES_NO_ENTRY))
-            {	// found unused entry
-                return bktIx;
+        for(ix = 0; ix < pOH->hEntries; ix++)
+        {
+            dhcpsHE = (DHCPS_HASH_ENTRY*)TCPIP_OAHASH_EntryGet(pOH, ix);
+            if(dhcpsHE->hEntry.flags.busy != 0)
+            {
+                _DHCPSPoolMark(dhcpsHE->intfIdx, dhcpsHE->ipAddress, true);
             }
         }
-        // advance to the next hash slot
-        bktIx += probeStep;
-        if(bktIx >= pOH->hEntries)
+    }
+}
+
+// removes a lease entry and releases its pool address
+// evType is reported if the entry was a bound lease
+static void _DHCPSEntryRemove(OA_HASH_DCPT* pOH, DHCPS_HASH_ENTRY* dhcpsHE, TCPIP_DHCPS_EVENT_TYPE evType)
+{
+    _DHCPSPoolMark(dhcpsHE->intfIdx, dhcpsHE->ipAddress, false);
+    if((dhcpsHE->hEntry.flags.value & DHCPS_FLAG_ENTRY_COMPLETE) != 0)
+    {
+        _DHCPSLeaseEvent(dhcpsHE, evType);
+    }
+    TCPIP_OAHASH_EntryRemove(pOH, &dhcpsHE->hEntry);
+}
+
+// a bound lease changed: update the statistics, persist it and notify the clients
+static void _DHCPSLeaseEvent(DHCPS_HASH_ENTRY* dhcpsHE, TCPIP_DHCPS_EVENT_TYPE evType)
+{
+    TCPIP_DHCPS_LIST_NODE* dNode;
+    TCPIP_DHCPS_LEASE_ENTRY leaseEntry;
+    TCPIP_NET_IF* pNetIf;
+
+    _DHCPSLeaseStoreDirty();
+
+    if(evType == TCPIP_DHCPS_EVENT_NONE)
+    {
+        return;
+    }
+
+    if(evType == TCPIP_DHCPS_EVENT_LEASE_BOUND)
+    {
+        dhcps_mod.stat.leasesBound++;
+        leaseEntry.leaseTime = gPdhcpsHashDcpt.leaseDuartion;
+    }
+    else
+    {
+        if(evType == TCPIP_DHCPS_EVENT_LEASE_EXPIRED)
         {
-            bktIx -= pOH->hEntries;
+            dhcps_mod.stat.leasesExpired++;
         }
+        leaseEntry.leaseTime = 0;
+    }
+    memcpy(&leaseEntry.hwAdd, &dhcpsHE->hwAdd, sizeof(leaseEntry.hwAdd));
+    leaseEntry.ipAddress.Val = dhcpsHE->ipAddress.Val;
+    pNetIf = (TCPIP_NET_IF*)TCPIP_STACK_IndexToNet(dhcpsHE->intfIdx);
 
-        bkts++;
+    TCPIP_Notification_Lock(&dhcpsRegisteredUsers);
+    for(dNode = (TCPIP_DHCPS_LIST_NODE*)dhcpsRegisteredUsers.list.head; dNode != 0; dNode = dNode->next)
+    {
+        if(dNode->hNet == 0 || dNode->hNet == pNetIf)
+        {   // trigger event
+            (*dNode->handler)(pNetIf, evType, &leaseEntry, dNode->hParam);
+        }
     }
-    return -1;	// cache full, not found
+    TCPIP_Notification_Unlock(&dhcpsRegisteredUsers);
 }
 
-static DHCPS_RESULT DHCPSLocateRequestedIpAddress(IPV4_ADDR *requestedIpAddr)
+#if (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+static uint32_t _DHCPSLeaseStoreChecksum(void)
 {
-    DHCPS_HASH_DCPT *pdhcpsDcpt;
-    OA_HASH_ENTRY	*hE;
-    int 			bktIx=0;
-    OA_HASH_DCPT	*pOH;
+    return fnv_32a_hash(dhcpsLeaseStore.lease, dhcpsLeaseStore.nLeases * sizeof(TCPIP_DHCPS_LEASE_RECORD)) ^ dhcpsLeaseStore.nLeases;
+}
 
-    pdhcpsDcpt = &gPdhcpsHashDcpt;
-    pOH = pdhcpsDcpt->hashDcpt;
+// a lease changed; the store is written by the lease task after TCPIP_DHCPS_LEASE_PERSIST_DELAY
+static void _DHCPSLeaseStoreDirty(void)
+{
+    if(dhcps_mod.storeDirtyTick == 0)
+    {
+        if((dhcps_mod.storeDirtyTick = SYS_TMR_TickCountGet()) == 0)
+        {
+            dhcps_mod.storeDirtyTick = 1;
+        }
+    }
+}
 
-// check the Requested IP address is matching anyone of the hash entry.
-    for(bktIx = 0; bktIx < pOH->hEntries; bktIx++)
+// writes the pending lease changes: the store is a snapshot of the bound leases
+static void _DHCPSLeaseStoreFlush(void)
+{
+    int bktIx;
+    uint32_t nLeases, leaseAge;
+    uint32_t current_timer = SYS_TMR_TickCountGet();
+    OA_HASH_DCPT* pOH = gPdhcpsHashDcpt.hashDcpt;
+    DHCPS_HASH_ENTRY* dhcpsHE;
+    TCPIP_DHCPS_LEASE_RECORD* pRec = dhcpsLeaseStore.lease;
+
+    if(dhcps_mod.storeDirtyTick == 0 || pOH == 0)
     {
-        hE = TCPIP_OAHASH_EntryGet(pOH, bktIx);
-        if((hE->flags.busy != 0) && (hE->flags.value & DHCPS_FLAG_ENTRY_COMPLETE))
+        return;
+    }
+    dhcps_mod.storeDirtyTick = 0;
+
+    nLeases = 0;
+    for(bktIx = 0; bktIx < pOH->hEntries && nLeases < TCPIP_DHCPS_LEASE_PERSIST_ENTRIES; bktIx++)
+    {
+        dhcpsHE = (DHCPS_HASH_ENTRY*)TCPIP_OAHASH_EntryGet(pOH, bktIx);
+        if((dhcpsHE->hEntry.flags.busy != 0) && (dhcpsHE->hEntry.flags.value & DHCPS_FLAG_ENTRY_COMPLETE) != 0)
         {
-            if(TCPIP_DHCPS_HashIPKeyCompare(pOH, hE, requestedIpAddr->v) == 0)
-                return DHCPS_RES_OK;
+            leaseAge = (current_timer - dhcpsHE->Client_Lease_Time) / SYS_TMR_TickCounterFrequencyGet();
+            if(leaseAge < gPdhcpsHashDcpt.leaseDuartion)
+            {
+                memcpy(&pRec->hwAdd, &dhcpsHE->hwAdd, sizeof(pRec->hwAdd));
+                pRec->intfIdx = (uint8_t)dhcpsHE->intfIdx;
+                pRec->reserved = 0;
+                pRec->ipAddress.Val = dhcpsHE->ipAddress.Val;
+                pRec->leaseLeft = gPdhcpsHashDcpt.leaseDuartion - leaseAge;
+                pRec++;
+                nLeases++;
+            }
         }
     }
-    return DHCPS_RES_NO_ENTRY;
+
+    dhcpsLeaseStore.magic = TCPIP_DHCPS_LEASE_STORE_MAGIC;
+    dhcpsLeaseStore.nLeases = nLeases;
+    dhcpsLeaseStore.checksum = _DHCPSLeaseStoreChecksum();
 }
 
+// restores the stored leases of an interface that are not already in the hash
+// The lease time left is the one at the moment of the store write.
+static void _DHCPSLeaseStoreRestore(TCPIP_NET_IF* pNetIf)
+{
+    uint32_t ix;
+    OA_HASH_ENTRY* hE;
+    DHCPS_HASH_ENTRY* dhcpsHE;
+    TCPIP_DHCPS_LEASE_RECORD* pRec;
+    OA_HASH_DCPT* pOH = gPdhcpsHashDcpt.hashDcpt;
+    DHCP_SRVR_DCPT* pDcpt = _DHCPSPoolFromIntf(pNetIf->netIfIx);
+
+    if(pOH == 0 || pDcpt == 0 || dhcpsLeaseStore.magic != TCPIP_DHCPS_LEASE_STORE_MAGIC ||
+       dhcpsLeaseStore.nLeases > TCPIP_DHCPS_LEASE_PERSIST_ENTRIES || dhcpsLeaseStore.checksum != _DHCPSLeaseStoreChecksum())
+    {
+        return;
+    }
+
+    for(ix = 0, pRec = dhcpsLeaseStore.lease; ix < dhcpsLeaseStore.nLeases; ix++, pRec++)
+    {
+        if(pRec->intfIdx != pNetIf->netIfIx || pRec->leaseLeft == 0 || pRec->leaseLeft > gPdhcpsHashDcpt.leaseDuartion ||
+           _DHCPSPoolAddressInUse(pDcpt, pRec->ipAddress))
+        {
+            continue;
+        }
+
+        hE = TCPIP_OAHASH_EntryLookupOrInsert(pOH, &pRec->hwAdd);
+        if(hE == 0)
+        {   // hash full
+            break;
+        }
+
+        dhcpsHE = (DHCPS_HASH_ENTRY*)hE;
+        if(dhcpsHE->hEntry.flags.newEntry != 0)
+        {
+            dhcpsHE->intfIdx = pRec->intfIdx;
+            _DHCPSSetHashEntry(dhcpsHE, DHCPS_FLAG_ENTRY_COMPLETE, &pRec->hwAdd, pRec->ipAddress.v);
+            dhcpsHE->Client_Lease_Time -= (gPdhcpsHashDcpt.leaseDuartion - pRec->leaseLeft) * SYS_TMR_TickCounterFrequencyGet();
+            dhcpsHE->pendingTime = 0;
+            _DHCPSPoolMark(dhcpsHE->intfIdx, dhcpsHE->ipAddress, true);
+            dhcps_mod.stat.leasesRestored++;
+        }
+    }
+}
+#endif  // (TCPIP_DHCPS_LEASE_PERSIST_ENTRIES != 0)
+
 TCPIP_DHCPS_LEASE_HANDLE TCPIP_DHCPS_LeaseEntryGet(TCPIP_NET_HANDLE netH, TCPIP_DHCPS_LEASE_ENTRY* pLeaseEntry, TCPIP_DHCPS_LEASE_HANDLE leaseHandle)
 {
     int                 entryIx;
@@ -2073,6 +2367,7 @@ TCPIP_DHCPS_LEASE_HANDLE TCPIP_DHCPS_LeaseEntryGet(TCPIP_NET_HANDLE netH, TCPIP_
     DHCPS_HASH_ENTRY*   pDsEntry;
     DHCPS_HASH_DCPT*	pDSHashDcpt;
     uint32_t 		current_time = SYS_TMR_TickCountGet();
+    uint32_t        leaseAge;
     
     TCPIP_NET_IF* pNetIf = _TCPIPStackHandleToNetUp(netH);
   
@@ -2101,7 +2396,8 @@ TCPIP_DHCPS_LEASE_HANDLE TCPIP_DHCPS_LeaseEntryGet(TCPIP_NET_HANDLE netH, TCPIP_
                 {
                     memcpy(&pLeaseEntry->hwAdd, &pDsEntry->hwAdd, sizeof(pDsEntry->hwAdd));
                     pLeaseEntry->ipAddress.Val = pDsEntry->ipAddress.Val;
-                    pLeaseEntry->leaseTime = pDSHashDcpt->leaseDuartion*SYS_TMR_TickCounterFrequencyGet() - (current_time - pDsEntry->Client_Lease_Time);
+                    leaseAge = (current_time - pDsEntry->Client_Lease_Time) / SYS_TMR_TickCounterFrequencyGet();
+                    pLeaseEntry->leaseTime = leaseAge < pDSHashDcpt->leaseDuartion ? pDSHashDcpt->leaseDuartion - leaseAge : 0;
                 }
                 return (TCPIP_DHCPS_LEASE_HANDLE)(entryIx + 1);
             }
@@ -2189,7 +2485,7 @@ bool TCPIP_DHCPS_LeaseEntryRemove(TCPIP_NET_HANDLE netH, TCPIP_MAC_ADDR* hwAdd)
             pDsEntry = (DHCPS_HASH_ENTRY*)hE;
             if(pDsEntry->intfIdx == pNetIf->netIfIx)
             {
-                TCPIP_OAHASH_EntryRemove(pOH,hE);
+                _DHCPSEntryRemove(pOH, pDsEntry, TCPIP_DHCPS_EVENT_LEASE_RELEASED);
                 return true;
             }
         }
@@ -2229,7 +2525,7 @@ bool TCPIP_DHCPS_RemovePoolEntries(TCPIP_NET_HANDLE netH, TCPIP_DHCPS_POOL_ENTRY
                         {
                             continue;
                         }
-                        TCPIP_OAHASH_EntryRemove(pOH,&pDsEntry->hEntry);
+                        _DHCPSEntryRemove(pOH, pDsEntry, TCPIP_DHCPS_EVENT_LEASE_RELEASED);
                     }
                     break;
                 case DHCP_SERVER_POOL_ENTRY_IN_USE:
@@ -2239,7 +2535,7 @@ bool TCPIP_DHCPS_RemovePoolEntries(TCPIP_NET_HANDLE netH, TCPIP_DHCPS_POOL_ENTRY
                         {
                             continue;
                         }
-                        TCPIP_OAHASH_EntryRemove(pOH,&pDsEntry->hEntry);
+                        _DHCPSEntryRemove(pOH, pDsEntry, TCPIP_DHCPS_EVENT_LEASE_RELEASED);
                     }
                     break;
             }
@@ -2248,6 +2544,57 @@ bool TCPIP_DHCPS_RemovePoolEntries(TCPIP_NET_HANDLE netH, TCPIP_DHCPS_POOL_ENTRY
     return true;
 }
 
+// Register a DHCP server event handler
+// Use hNet == 0 to register on all interfaces available
+// Returns a valid handle if the call succeeds,
+// or a null handle if the call failed.
+TCPIP_DHCPS_HANDLE TCPIP_DHCPS_HandlerRegister(TCPIP_NET_HANDLE hNet, TCPIP_DHCPS_EVENT_HANDLER handler, const void* hParam)
+{
+    if(handler && dhcpSMemH)
+    {
+        TCPIP_DHCPS_LIST_NODE dhcpsNode;
+        dhcpsNode.handler = handler;
+        dhcpsNode.hParam = hParam;
+        dhcpsNode.hNet = hNet;
+
+        return (TCPIP_DHCPS_LIST_NODE*)TCPIP_Notification_Add(&dhcpsRegisteredUsers, dhcpSMemH, &dhcpsNode, sizeof(dhcpsNode));
+    }
+
+    return 0;
+}
+
+// deregister the event handler
+bool TCPIP_DHCPS_HandlerDeRegister(TCPIP_DHCPS_HANDLE hDhcps)
+{
+    if(hDhcps && dhcpSMemH)
+    {
+        if(TCPIP_Notification_Remove((SGL_LIST_NODE*)hDhcps, &dhcpsRegisteredUsers, dhcpSMemH))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TCPIP_DHCPS_StatisticsGet(TCPIP_DHCPS_STATISTICS* pStat, bool clear)
+{
+    if(dhcpSInitCount == 0)
+    {
+        return false;
+    }
+
+    if(pStat)
+    {
+        *pStat = dhcps_mod.stat;
+    }
+    if(clear)
+    {
+        memset(&dhcps_mod.stat, 0, sizeof(dhcps_mod.stat));
+    }
+    return true;
+}
+
 size_t TCPIP_DHCPS_MACHashKeyHash(OA_HASH_DCPT* pOH, const void* key)
 {
     return fnv_32_hash(key, DHCPS_HASH_KEY_SIZE) % (pOH->hEntries);
@@ -2305,6 +2652,8 @@ bool TCPIP_DHCPS_Disable(TCPIP_NET_HANDLE hNet)
     TCPIP_STACK_AddressServiceEvent(pNetIf, TCPIP_STACK_ADDRESS_SERVICE_DHCPS, TCPIP_STACK_ADDRESS_SERVICE_EVENT_USER_STOP);
     TCPIP_STACK_AddressServiceDefaultSet(pNetIf);
     _TCPIPStackSetConfigAddress(pNetIf, 0, 0, true);
+    // the stored leases are restored when the server is enabled again
+    _DHCPSLeaseStoreFlush();
      // Remove all the HASH entries
     _DHCPSRemoveCacheEntries(&gPdhcpsHashDcpt);
     return true;
@@ -2343,6 +2692,10 @@ static bool _DHCPS_StartOperation(TCPIP_NET_IF* pNetIf,DHCP_SRVR_DCPT* pDhcpsDcp
     {
         return false;
     }
+    // get back the leases this interface had before a reset or disable;
+    // pending changes are written first so that no removed lease is restored
+    _DHCPSLeaseStoreFlush();
+    _DHCPSLeaseStoreRestore(pNetIf);
 // Get the network interface from the network index and configure IP address,
 // Netmask and gateway and DNS
     _TCPIPStackSetConfigAddress(pNetIf, &pDhcpsDcpt->intfAddrsConf.serverIPAddress, &pDhcpsDcpt->intfAddrsConf.serverMask, false);
@@ -2355,7 +2708,7 @@ static bool _DHCPS_StartOperation(TCPIP_NET_IF* pNetIf,DHCP_SRVR_DCPT* pDhcpsDcp
     }
 #endif
     
-    uint16_t queueSize;
+    uint8_t queueSize;
      // make sure the socket is created with enough TX space
     TCPIP_UDP_OptionsGet(dhcps_mod.uSkt, UDP_OPTION_TX_QUEUE_LIMIT, (void*)&queueSize);
     if(queueSize < TCPIP_DHCPS_QUEUE_LIMIT_SIZE)
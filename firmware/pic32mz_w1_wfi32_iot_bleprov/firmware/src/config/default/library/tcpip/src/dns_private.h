@@ -78,6 +78,27 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 // it will be removed from the cache
 #define _TCPIP_DNS_CLIENT_CACHE_UNSOLVED_EXPIRE_TMO     1
 
+// a solved entry that was used is queried again in the background
+// when it's about to expire, so that the users never wait for it
+// the refresh starts this many seconds before the expiry
+// but not sooner than 3/4 of the entry lifetime
+#if !defined(TCPIP_DNS_CLIENT_CACHE_PREFETCH_TMO)
+#define TCPIP_DNS_CLIENT_CACHE_PREFETCH_TMO     30
+#endif
+
+// name error and no data answers are cached (RFC 2308)
+// for the SOA minimum TTL, if present in the answer,
+// but no longer than this value, seconds
+// this is also the negative TTL when the answer carries no SOA
+#if !defined(TCPIP_DNS_CLIENT_CACHE_NEGATIVE_TTL)
+#define TCPIP_DNS_CLIENT_CACHE_NEGATIVE_TTL     60
+#endif
+
+// DNS RR types and response codes used internally
+#define _TCPIP_DNS_TYPE_SOA                     6
+#define _TCPIP_DNS_RCODE_MASK                   0x0f
+#define _TCPIP_DNS_RCODE_NAME_ERROR             3
+
 // a DNS debug event
 typedef enum
 {
@@ -122,6 +143,9 @@ typedef enum
     TCPIP_DNS_FLAG_ENTRY_COMPLETE     = 0x0080,     // regular entry, complete
                                                     // else it's incomplete
     TCPIP_DNS_FLAG_ENTRY_TIMEOUT      = 0x0100,     // entry has timed out
+    TCPIP_DNS_FLAG_ENTRY_NEGATIVE     = 0x0200,     // name error/no data answer cached
+    TCPIP_DNS_FLAG_ENTRY_HOT          = 0x0400,     // complete entry used since it was solved
+    TCPIP_DNS_FLAG_ENTRY_PREFETCH     = 0x0800,     // complete entry queried again before expiry
                                                   
 }TCPIP_DNS_HASH_ENTRY_FLAGS;
 
@@ -140,6 +164,8 @@ typedef struct
     uint8_t*                    memblk;         // memory block for IPv4, IPv6 and hostname
     uint32_t                    tInsert;        // one time per hash entry
     uint32_t                    tRetry;         // retry time per hash entry
+    uint32_t                    tUsed;          // last time the entry was used
+    uint32_t                    tQuery;         // query start, system ticks; for the latency
     IPV4_ADDR*                  pip4Address;    // pointer to an array of IPv4: nIPv4Entries entries 
     IPV6_ADDR*                  pip6Address;    // pointer to an array of IPv6: nIPv6Entries entries
     TCPIP_UINT32_VAL            ipTTL;          // Minimum TTL per IPv4 and Ipv6 addresses
@@ -170,6 +196,7 @@ typedef struct
     PROTECTED_SINGLE_LIST   dnsRegisteredUsers;
 #endif  // (TCPIP_DNS_CLIENT_USER_NOTIFICATION != 0)
     uint32_t                dnsTime;                        // coarse DNS time keeping, seconds
+    TCPIP_DNS_CLIENT_STATISTICS stat;                       // cache statistics
     // unaligned members
     uint16_t                nIPv4Entries;
     uint16_t                nIPv6Entries;
@@ -234,6 +261,7 @@ typedef struct
     uint16_t                dnsPacketSize;  // packet size
     TCPIP_DNS_HASH_ENTRY*   dnsHE;          // associated hash entry
     TCPIP_DNS_DBG_EVENT_TYPE evDbgType;     // associated parsing event, if any
+    uint32_t                negTTL;         // negative caching TTL from an SOA record, 0 if none
 }TCPIP_DNS_RR_PROCESS;
 
 
@@ -61,6 +61,16 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 // and the entry can be removed only when user deletes it.
 #define     TCPIP_DNSS_PERMANENT_ENTRY_TTL_TIME     0xFFFFFFFF
 
+// size of an answer RR using a pointer to the question name:
+// name pointer + type + class + TTL + data length + address
+#define     DNSS_ANSWER_RR_SIZE(addSize)    (2 + 2 + 2 + 4 + 2 + (addSize))
+// offset of the TTL field in an answer RR
+#define     DNSS_ANSWER_RR_TTL_OFFSET       6
+// name compression pointer to the question name, RFC 1035
+#define     DNSS_QUESTION_NAME_POINTER      0xC00C
+// maximum number of compression pointers followed in a query name
+#define     DNSS_NAME_MAX_POINTERS          4
+
 // *****************************************************************************
 /* 
   Structure:
@@ -98,7 +108,8 @@ typedef enum
     DNSS_FLAG_ENTRY_COMPLETE     = 0x0080,          // regular entry, complete
                                                    // else it's incomplete
                                                    //
-    DNSS_FLAG_ENTRY_VALID_MASK   = (DNSS_FLAG_ENTRY_INCOMPLETE | DNSS_FLAG_ENTRY_COMPLETE )
+    DNSS_FLAG_ENTRY_VALID_MASK   = (DNSS_FLAG_ENTRY_INCOMPLETE | DNSS_FLAG_ENTRY_COMPLETE ),
+    DNSS_FLAG_ANSWERS_VALID      = 0x0100,          // the answer templates are up to date
 
 }DNSS_HASH_ENTRY_FLAGS;
 
@@ -138,6 +149,10 @@ typedef struct
     tcpipSignalHandle dnsSSignalHandle;
     uint32_t        dnsSTimeMseconds;
     bool            replyWithBoardInfo;
+    bool            captivePortal;      // names not in the cache are answered with the board address
+    uint8_t*        pResponse;          // buffer where the responses are assembled
+    IPV4_ADDR       boardAddress;       // address in boardAnsA
+    uint8_t         boardAnsA[DNSS_ANSWER_RR_SIZE(sizeof(IPV4_ADDR))];  // board address A answer
 }DNSS_DCPT;
 
 /*
@@ -163,6 +178,14 @@ typedef struct	_TAG_DNSS_HASH_ENTRY
 	uint8_t						recordType;  // record can be  IPv6 ( 28 )or IPv4 ( 1)	
 	uint8_t                     netIfIdx;
     TCPIP_UINT32_VAL            validityTime;      // user configured time per hash entry in second
+    // precomputed wire format answers, part of memblk
+    // rebuilt when the entry addresses change
+    uint8_t*                    pAnsA;          // A answer RRs
+    int                         nAnsA;          // number of RRs in pAnsA
+#ifdef TCPIP_STACK_USE_IPV6
+    uint8_t*                    pAnsAAAA;       // AAAA answer RRs
+    int                         nAnsAAAA;       // number of RRs in pAnsAAAA
+#endif
 }DNSS_HASH_ENTRY;
 
 
@@ -76,6 +76,30 @@ static const void*          icmpMemH = 0;       // memory handle
 
 static tcpipSignalHandle    signalHandle = 0;   // registered signal handler   
 
+#if defined(TCPIP_STACK_USE_ICMP_SERVER)
+// echo replies rate limit: sustained replies per second; 0 disables the limit
+#ifndef TCPIP_ICMP_ECHO_REPLY_RATE
+#define TCPIP_ICMP_ECHO_REPLY_RATE      100
+#endif
+// number of replies that can be sent in a burst
+#ifndef TCPIP_ICMP_ECHO_REPLY_BURST
+#define TCPIP_ICMP_ECHO_REPLY_BURST     20
+#endif
+// number of echo request sources having counters; 0 disables the counters
+#ifndef TCPIP_ICMP_ECHO_SOURCES
+#define TCPIP_ICMP_ECHO_SOURCES         4
+#endif
+
+#if (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+static uint32_t             icmpEchoCredit;     // rate limit credit, ticks
+static uint32_t             icmpEchoCreditTick; // tick of the last credit update
+#endif  // (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+static TCPIP_ICMP_ECHO_SOURCE_STAT  icmpEchoSources[TCPIP_ICMP_ECHO_SOURCES];
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
+#endif  // defined(TCPIP_STACK_USE_ICMP_SERVER)
+
 #if defined(TCPIP_STACK_USE_ICMP_CLIENT)
 
 // Callback function for informing the upper-layer protocols about ICMP events
@@ -117,6 +141,14 @@ static void TCPIP_ICMP_Cleanup(void);
 
 #if defined(TCPIP_STACK_USE_ICMP_SERVER)
 static bool _ICMPProcessEchoRequest(TCPIP_NET_IF* pNetIf, TCPIP_MAC_PACKET* pRxPkt, uint32_t destAdd, uint32_t srcAdd);
+#if (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+static bool _ICMPEchoRateCheck(void);
+#else
+#define _ICMPEchoRateCheck()    true
+#endif  // (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+static TCPIP_ICMP_ECHO_SOURCE_STAT* _ICMPEchoSourceGet(uint32_t srcAdd);
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
 #endif // defined(TCPIP_STACK_USE_ICMP_SERVER)
 
 #if defined(TCPIP_STACK_USE_ICMP_CLIENT)
@@ -173,6 +205,16 @@ bool TCPIP_ICMP_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
             {
                 break;
             }
+#if defined(TCPIP_STACK_USE_ICMP_SERVER)
+#if (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+            // start with a full burst
+            icmpEchoCredit = (SYS_TMR_TickCounterFrequencyGet() / TCPIP_ICMP_ECHO_REPLY_RATE) * TCPIP_ICMP_ECHO_REPLY_BURST;
+            icmpEchoCreditTick = SYS_TMR_TickCountGet();
+#endif  // (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+            memset(icmpEchoSources, 0, sizeof(icmpEchoSources));
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
+#endif  // defined(TCPIP_STACK_USE_ICMP_SERVER)
 #if defined(TCPIP_STACK_USE_ICMP_CLIENT)
             pIcmpEchoRequest = 0;        // one and only request (for now)
             icmpEchoTmo = 0;
@@ -477,6 +519,9 @@ static void  TCPIP_ICMP_Process(void)
     uint16_t                icmpTotLength;
     uint16_t                checksum;
     TCPIP_MAC_PKT_ACK_RES   ackRes;
+#if defined(TCPIP_STACK_USE_ICMP_SERVER) && (TCPIP_ICMP_ECHO_SOURCES != 0)
+    TCPIP_ICMP_ECHO_SOURCE_STAT* pEchoSrc;
+#endif  // defined(TCPIP_STACK_USE_ICMP_SERVER) && (TCPIP_ICMP_ECHO_SOURCES != 0)
 
 
 
@@ -534,7 +579,25 @@ static void  TCPIP_ICMP_Process(void)
                 }
 #endif  // (TCPIP_ICMP_ECHO_ALLOW_BROADCASTS == 0)
 
-                _ICMPProcessEchoRequest((TCPIP_NET_IF*)pRxPkt->pktIf, pRxPkt, pIpv4Header->DestAddress.Val, srcAdd);
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+                pEchoSrc = _ICMPEchoSourceGet(srcAdd);
+                pEchoSrc->requests++;
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
+                if(!_ICMPEchoRateCheck())
+                {
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+                    pEchoSrc->rateDrops++;
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
+                    ackRes = TCPIP_MAC_PKT_ACK_PROTO_DEST_ERR;  // ignore request
+                    break;  
+                }
+
+                if(_ICMPProcessEchoRequest((TCPIP_NET_IF*)pRxPkt->pktIf, pRxPkt, pIpv4Header->DestAddress.Val, srcAdd))
+                {
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+                    pEchoSrc->replies++;
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
+                }
                 ackRes = TCPIP_MAC_PKT_ACK_NONE;
                 break;
             }
@@ -620,27 +683,19 @@ static void  TCPIP_ICMP_Timeout(void)
 static bool _ICMPProcessEchoRequest(TCPIP_NET_IF* pNetIf, TCPIP_MAC_PACKET* pRxPkt, uint32_t destAdd, uint32_t srcAdd)
 {
     ICMP_PACKET* pTxHdr;
-    TCPIP_UINT16_VAL checksum;
+    TCPIP_UINT16_VAL oldTypeCode, newTypeCode;
     IPV4_PACKET ipv4Pkt;
     IPV4_HEADER* pIpv4Hdr;
 
-    // adjust the checksum
+    // change the type and adjust the checksum, RFC 1624
+    // the payload is not summed again
     pTxHdr = (ICMP_PACKET*)pRxPkt->pTransportLayer;
 
-    pTxHdr->vType = ICMP_TYPE_ECHO_REPLY;
-    pTxHdr->vCode = ICMP_CODE_ECHO_REPLY;
-    checksum.Val = pTxHdr->wChecksum;
-    checksum.v[0] += 8;	// Subtract 0x0800 from the checksum
-    if(checksum.v[0] < 8u)
-    {
-        checksum.v[1]++;
-        if(checksum.v[1] == 0u)
-        {
-            checksum.v[0]++;
-        }
-    }
-
-    pTxHdr->wChecksum = checksum.Val;
+    oldTypeCode.v[0] = pTxHdr->vType;
+    oldTypeCode.v[1] = pTxHdr->vCode;
+    pTxHdr->vType = newTypeCode.v[0] = ICMP_TYPE_ECHO_REPLY;
+    pTxHdr->vCode = newTypeCode.v[1] = ICMP_CODE_ECHO_REPLY;
+    pTxHdr->wChecksum = TCPIP_Helper_ChecksumUpdate16(pTxHdr->wChecksum, oldTypeCode.Val, newTypeCode.Val);
     pRxPkt->next = 0; // single packet
 
 #if (_TCPIP_IPV4_FRAGMENTATION != 0)
@@ -686,6 +741,80 @@ static bool _ICMPProcessEchoRequest(TCPIP_NET_IF* pNetIf, TCPIP_MAC_PACKET* pRxP
     // went through
     return true;
 }
+
+#if (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+// token bucket limiting the echo replies
+// each reply uses 1/TCPIP_ICMP_ECHO_REPLY_RATE seconds worth of credit
+// returns true if a reply can be sent
+static bool _ICMPEchoRateCheck(void)
+{
+    uint32_t currTick = SYS_TMR_TickCountGet();
+    uint32_t replyCost = SYS_TMR_TickCounterFrequencyGet() / TCPIP_ICMP_ECHO_REPLY_RATE;
+    uint32_t maxCredit = replyCost * TCPIP_ICMP_ECHO_REPLY_BURST;
+    uint32_t elapsed = currTick - icmpEchoCreditTick;
+
+    icmpEchoCreditTick = currTick;
+    icmpEchoCredit = (elapsed >= maxCredit - icmpEchoCredit) ? maxCredit : icmpEchoCredit + elapsed;
+
+    if(icmpEchoCredit < replyCost)
+    {
+        return false;
+    }
+
+    icmpEchoCredit -= replyCost;
+    return true;
+}
+#endif  // (TCPIP_ICMP_ECHO_REPLY_RATE != 0)
+
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+// returns the counters of an echo request source
+// a new source replaces the least recently seen one
+static TCPIP_ICMP_ECHO_SOURCE_STAT* _ICMPEchoSourceGet(uint32_t srcAdd)
+{
+    int ix;
+    TCPIP_ICMP_ECHO_SOURCE_STAT *pSrc, *pOldest;
+    uint32_t currTick = SYS_TMR_TickCountGet();
+
+    pOldest = icmpEchoSources;
+    for(ix = 0, pSrc = icmpEchoSources; ix < sizeof(icmpEchoSources) / sizeof(*icmpEchoSources); ix++, pSrc++)
+    {
+        if(pSrc->sourceAddr.Val == srcAdd)
+        {
+            pSrc->lastTick = currTick;
+            return pSrc;
+        }
+
+        if(pOldest->sourceAddr.Val != 0 && (pSrc->sourceAddr.Val == 0 || (currTick - pSrc->lastTick) > (currTick - pOldest->lastTick)))
+        {
+            pOldest = pSrc;
+        }
+    }
+
+    memset(pOldest, 0, sizeof(*pOldest));
+    pOldest->sourceAddr.Val = srcAdd;
+    pOldest->lastTick = currTick;
+    return pOldest;
+}
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
+
+bool TCPIP_ICMP_EchoSourceStatGet(int index, TCPIP_ICMP_ECHO_SOURCE_STAT* pStat)
+{
+#if (TCPIP_ICMP_ECHO_SOURCES != 0)
+    if(icmpInitCount != 0 && index >= 0 && index < sizeof(icmpEchoSources) / sizeof(*icmpEchoSources))
+    {
+        if(icmpEchoSources[index].sourceAddr.Val != 0)
+        {
+            if(pStat)
+            {
+                *pStat = icmpEchoSources[index];
+            }
+            return true;
+        }
+    }
+#endif  // (TCPIP_ICMP_ECHO_SOURCES != 0)
+
+    return false;
+}
 #endif // defined(TCPIP_STACK_USE_ICMP_SERVER)
 
 
@@ -0,0 +1,1207 @@
+/*******************************************************************************
+  iPerf Throughput Measurement Module
+
+  Summary:
+    Module for Microchip TCP/IP Stack
+
+  Description:
+    - iperf2 compatible TCP/UDP client and server
+    - Controlled from the system console: "iperf", "iperfk"
+    - Interoperates with the iperf 2.x host tool
+*******************************************************************************/
+
+/*****************************************************************************
+ Copyright (C) 2012-2018 Microchip Technology Inc. and its subsidiaries.
+
+Microchip Technology Inc. and its subsidiaries.
+
+Subject to your compliance with these terms, you may use Microchip software
+and any derivatives exclusively with Microchip products. It is your
+responsibility to comply with third party license terms applicable to your
+use of third party software (including open source software) that may
+accompany Microchip software.
+
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR
+PURPOSE.
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*****************************************************************************/
+
+
+
+
+
+
+
+
+#define TCPIP_THIS_MODULE_ID    TCPIP_MODULE_IPERF
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "tcpip/src/tcpip_private.h"
+#include "system/command/sys_command.h"
+
+#if defined(TCPIP_STACK_USE_IPV4) && defined(TCPIP_STACK_USE_IPERF)
+#if defined(TCPIP_STACK_USE_TCP) && defined(TCPIP_STACK_USE_UDP)
+
+// default settings; normally set in configuration.h
+#if !defined(TCPIP_IPERF_MAX_INSTANCES)
+#define TCPIP_IPERF_MAX_INSTANCES           4
+#endif
+#if !defined(TCPIP_IPERF_TASK_RATE)
+#define TCPIP_IPERF_TASK_RATE               20
+#endif
+#if !defined(TCPIP_IPERF_TX_BUFFER_SIZE)
+#define TCPIP_IPERF_TX_BUFFER_SIZE          4096
+#endif
+#if !defined(TCPIP_IPERF_RX_BUFFER_SIZE)
+#define TCPIP_IPERF_RX_BUFFER_SIZE          4096
+#endif
+#if !defined(TCPIP_IPERF_UDP_RX_QUEUE_LIMIT)
+#define TCPIP_IPERF_UDP_RX_QUEUE_LIMIT      8
+#endif
+#if !defined(TCPIP_IPERF_UDP_TX_QUEUE_LIMIT)
+#define TCPIP_IPERF_UDP_TX_QUEUE_LIMIT      4
+#endif
+#if !defined(TCPIP_IPERF_CONNECT_TMO)
+#define TCPIP_IPERF_CONNECT_TMO             5000
+#endif
+#if !defined(TCPIP_IPERF_IDLE_TMO)
+#define TCPIP_IPERF_IDLE_TMO                10000
+#endif
+
+// iperf2 defaults
+#define IPERF_DEFAULT_DURATION      10          // client test time, seconds
+#define IPERF_DEFAULT_TCP_LEN       1460        // TCP write size
+#define IPERF_DEFAULT_UDP_LEN       1470        // UDP datagram size
+#define IPERF_DEFAULT_UDP_BW        1000000     // UDP client bandwidth, bits/s
+#define IPERF_MAX_UDP_LEN           1472        // no IPv4 fragmentation: 1500 - 20 - 8
+#define IPERF_MAX_TCP_LEN           0xffff      // TCP write size
+#define IPERF_MAX_WIN_SIZE          0xffff      // 16 bit socket buffers, no window scaling
+
+#define IPERF_UDP_FIN_RETRIES       10          // FIN datagrams sent to get the server report
+#define IPERF_UDP_FIN_TMO           250         // ms between FIN retries
+
+#define IPERF_HEADER_VERSION1       0x80000000  // server report flag
+
+// datagram header preceding each UDP payload
+// all fields in network order
+typedef struct __attribute__((packed))
+{
+    int32_t     id;         // sequence number; negative for the FIN datagram
+    uint32_t    tv_sec;     // sender time stamp
+    uint32_t    tv_usec;
+}IPERF_UDP_DATAGRAM;
+
+// settings header following the UDP datagram header
+// and at the beginning of a TCP stream;
+// flags == 0 selects a plain (non dual) test
+typedef struct __attribute__((packed))
+{
+    int32_t     flags;
+    int32_t     numThreads;
+    int32_t     mPort;
+    int32_t     bufferlen;
+    int32_t     mWinBand;
+    int32_t     mAmount;
+}IPERF_CLIENT_HDR;
+
+// UDP server report, sent back in reply to the FIN datagram
+typedef struct __attribute__((packed))
+{
+    int32_t     flags;
+    int32_t     total_len1;     // bytes, high 32 bits
+    int32_t     total_len2;     // bytes, low 32 bits
+    int32_t     stop_sec;       // test duration
+    int32_t     stop_usec;
+    int32_t     error_cnt;      // lost datagrams
+    int32_t     outorder_cnt;   // out of order datagrams
+    int32_t     datagrams;      // total datagrams
+    int32_t     jitter1;        // jitter, seconds
+    int32_t     jitter2;        // jitter, microseconds
+}IPERF_SERVER_HDR;
+
+typedef enum
+{
+    IPERF_STATE_IDLE    = 0,    // unused
+    IPERF_STATE_TCP_LISTEN,     // TCP server waiting for a connection
+    IPERF_STATE_TCP_RX,         // TCP server receiving
+    IPERF_STATE_TCP_CONNECT,    // TCP client waiting for the connection
+    IPERF_STATE_TCP_TX,         // TCP client sending
+    IPERF_STATE_UDP_LISTEN,     // UDP server waiting for a client
+    IPERF_STATE_UDP_RX,         // UDP server receiving
+    IPERF_STATE_UDP_TX,         // UDP client sending
+    IPERF_STATE_UDP_FIN,        // UDP client waiting for the server report
+}IPERF_STATE;
+
+typedef enum
+{
+    IPERF_REQ_NONE      = 0,    // no pending request
+    IPERF_REQ_START,            // console requested a start
+    IPERF_REQ_STOP,             // console requested a stop
+}IPERF_REQ;
+
+typedef enum
+{
+    IPERF_FLAG_UDP      = 0x01, // UDP, else TCP
+    IPERF_FLAG_SERVER   = 0x02, // server, else client
+}IPERF_FLAGS;
+
+// iperf session
+// the console thread fills in the settings of an idle session and posts IPERF_REQ_START;
+// from then on the session is owned by the stack task, which opens and uses the sockets
+typedef struct
+{
+    volatile uint8_t    request;        // IPERF_REQ value, set by the console
+    uint8_t             state;          // IPERF_STATE value
+    uint8_t             flags;          // IPERF_FLAGS value
+    uint8_t             leader;         // index of the group leader, for the parallel streams
+    uint8_t             groupSize;      // leader only: group members
+    uint8_t             groupActive;    // leader only: group members still running
+    uint8_t             finRetries;     // UDP client FIN retries left
+    uint8_t             reportValid;    // UDP server: last report can be resent
+    uint8_t             id;             // report id
+    int16_t             skt;            // TCP_SOCKET or UDP_SOCKET
+    uint16_t            port;
+    uint16_t            bufferLen;      // write/datagram size
+    uint16_t            winSize;        // socket buffer size; 0 for default
+    IPV4_ADDR           remoteAddr;
+    uint16_t            remotePort;
+    uint32_t            bandwidth;      // UDP client rate, bits/s
+    uint32_t            duration;       // client test time, ms; 0 if amount based
+    uint32_t            interval;       // report interval, ms; 0 for no interval reports
+    uint32_t            amount;         // client bytes to send when duration == 0
+    uint64_t            startTime;      // us
+    uint64_t            eventTime;      // us; last data transfer
+    uint64_t            finTime;        // us; last FIN sent
+    uint64_t            reportTime;     // us; current report interval start
+    uint32_t            totalBytes;
+    uint32_t            reportBytes;    // bytes at the current interval start
+    uint32_t            groupBytes;     // leader only: bytes of the finished members
+    uint64_t            groupEndTime;   // leader only: us; last transfer of the finished members
+    // UDP
+    int32_t             pktId;          // client: next id; server: last id
+    uint32_t            errorCnt;
+    uint32_t            outOfOrder;
+    int32_t             lastTransit;    // us
+    uint32_t            jitter;         // us
+    uint32_t            stopTime;       // ms; server report test time
+    SYS_CMD_DEVICE_NODE* pCmdIO;        // console for the reports
+    const void*         cmdIoParam;
+}TCPIP_IPERF_DCPT;
+
+
+static int                  iperfInitCount = 0;     // iperf module initialization count
+
+static tcpipSignalHandle    iperfSignalHandle = 0;  // registered signal handler
+
+static bool                 iperfAsyncPending = 0;  // TCPIP_MODULE_SIGNAL_ASYNC requested
+
+static uint8_t              iperfIdCount = 0;       // report ids
+
+static TCPIP_IPERF_DCPT     iperfDcpt[TCPIP_IPERF_MAX_INSTANCES];
+
+// transmitted payload
+static const uint8_t        iperfPattern[] = "01234567890123456789012345678901234567890123456789012345678901234567890123456789";
+
+static void _Command_Iperf(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _Command_IperfStop(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+
+static const SYS_CMD_DESCRIPTOR    iperfCmdTbl[]=
+{
+    {"iperf",       (SYS_CMD_FNC)_Command_Iperf,        ": iperf client/server"},
+    {"iperfk",      (SYS_CMD_FNC)_Command_IperfStop,    ": stop iperf sessions"},
+};
+
+static void _IperfStart(TCPIP_IPERF_DCPT* pDcpt);
+static void _IperfStop(TCPIP_IPERF_DCPT* pDcpt, bool report);
+static void _IperfClose(TCPIP_IPERF_DCPT* pDcpt);
+static void _IperfTcpServer(TCPIP_IPERF_DCPT* pDcpt);
+static void _IperfTcpClient(TCPIP_IPERF_DCPT* pDcpt);
+static void _IperfUdpServer(TCPIP_IPERF_DCPT* pDcpt);
+static void _IperfUdpClient(TCPIP_IPERF_DCPT* pDcpt);
+static void _IperfUdpFin(TCPIP_IPERF_DCPT* pDcpt);
+
+#if (TCPIP_STACK_DOWN_OPERATION != 0)
+static void TCPIP_IPERF_Cleanup(void);
+#else
+#define TCPIP_IPERF_Cleanup()
+#endif  // (TCPIP_STACK_DOWN_OPERATION != 0)
+
+
+// current time, us
+static uint64_t _IperfTimeGet(void)
+{
+    uint64_t sysCount = SYS_TMR_SystemCountGet();
+    uint32_t sysFreq = SYS_TMR_SystemCountFrequencyGet();
+
+    return (sysCount / sysFreq) * 1000000ull + ((sysCount % sysFreq) * 1000000ull) / sysFreq;
+}
+
+// console output
+static void _IperfPrint(TCPIP_IPERF_DCPT* pDcpt, const char* fmt, ...)
+{
+    char    buff[100];
+    va_list args;
+
+    if(pDcpt->pCmdIO != 0)
+    {
+        va_start(args, fmt);
+        vsnprintf(buff, sizeof(buff), fmt, args);
+        va_end(args);
+        (*pDcpt->pCmdIO->pCmdApi->msg)(pDcpt->cmdIoParam, buff);
+    }
+}
+
+// prints a report line in the iperf format:
+// "[id] start-end sec KBytes Kbits/sec"
+// start/end in ms from the session start
+static void _IperfReport(TCPIP_IPERF_DCPT* pDcpt, const char* idStr, uint32_t startMs, uint32_t endMs, uint32_t nBytes)
+{
+    uint32_t elapsed = endMs - startMs;
+    uint32_t kbps = elapsed == 0 ? 0 : (uint32_t)(((uint64_t)nBytes * 8) / elapsed);
+
+    _IperfPrint(pDcpt, "[%3s] %3lu.%lu-%3lu.%lu sec %7lu KBytes %7lu Kbits/sec\r\n", idStr, startMs / 1000, (startMs % 1000) / 100,
+            endMs / 1000, (endMs % 1000) / 100, nBytes / 1024, kbps);
+}
+
+// requests/releases the stack attention while sessions are transferring data
+static void _IperfAsyncUpdate(void)
+{
+    int ix;
+    bool active = false;
+
+    for(ix = 0; ix < sizeof(iperfDcpt) / sizeof(*iperfDcpt); ix++)
+    {
+        switch(iperfDcpt[ix].state)
+        {
+            case IPERF_STATE_TCP_RX:
+            case IPERF_STATE_TCP_CONNECT:
+            case IPERF_STATE_TCP_TX:
+            case IPERF_STATE_UDP_RX:
+            case IPERF_STATE_UDP_TX:
+            case IPERF_STATE_UDP_FIN:
+                active = true;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if(active && !iperfAsyncPending)
+    {
+        _TCPIPStackModuleSignalRequest(TCPIP_THIS_MODULE_ID, TCPIP_MODULE_SIGNAL_ASYNC, true);
+        iperfAsyncPending = true;
+    }
+    else if(!active && iperfAsyncPending)
+    {
+        _TCPIPStackModuleSignalGet(TCPIP_THIS_MODULE_ID, TCPIP_MODULE_SIGNAL_ASYNC);
+        iperfAsyncPending = false;
+    }
+}
+
+bool TCPIP_IPERF_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const void* initData)
+{
+    if(stackCtrl->stackAction == TCPIP_STACK_ACTION_IF_UP)
+    {   // interface restart
+        return true;
+    }
+
+    // stack start up
+    if(iperfInitCount == 0)
+    {   // first time we're run
+        memset(iperfDcpt, 0, sizeof(iperfDcpt));
+        iperfAsyncPending = false;
+
+        if(!SYS_CMD_ADDGRP(iperfCmdTbl, sizeof(iperfCmdTbl)/sizeof(*iperfCmdTbl), "iperf", ": iperf commands"))
+        {
+            SYS_ERROR(SYS_ERROR_ERROR, "Failed to create iperf Commands\r\n");
+            return false;
+        }
+
+        if((iperfSignalHandle =_TCPIPStackSignalHandlerRegister(TCPIP_THIS_MODULE_ID, TCPIP_IPERF_Task, TCPIP_IPERF_TASK_RATE)) == 0)
+        {
+            TCPIP_IPERF_Cleanup();
+            return false;
+        }
+    }
+
+    iperfInitCount++;
+    return true;
+}
+
+
+#if (TCPIP_STACK_DOWN_OPERATION != 0)
+void TCPIP_IPERF_Deinitialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl)
+{
+    // if(stackCtrl->stackAction == TCPIP_STACK_ACTION_DEINIT) // stack shut down
+    // if(stackCtrl->stackAction == TCPIP_STACK_ACTION_IF_DOWN) // interface down
+
+    if(iperfInitCount > 0)
+    {   // we're up and running
+        if(stackCtrl->stackAction == TCPIP_STACK_ACTION_DEINIT)
+        {   // stack shut down
+            if(--iperfInitCount == 0)
+            {   // all closed. release resources
+                TCPIP_IPERF_Cleanup();
+            }
+        }
+    }
+}
+
+static void TCPIP_IPERF_Cleanup(void)
+{
+    int ix;
+
+    for(ix = 0; ix < sizeof(iperfDcpt) / sizeof(*iperfDcpt); ix++)
+    {
+        _IperfClose(iperfDcpt + ix);
+        iperfDcpt[ix].request = IPERF_REQ_NONE;
+    }
+    _IperfAsyncUpdate();
+
+    if(iperfSignalHandle)
+    {
+        _TCPIPStackSignalHandlerDeregister(iperfSignalHandle);
+        iperfSignalHandle = 0;
+    }
+}
+#endif  // (TCPIP_STACK_DOWN_OPERATION != 0)
+
+
+void TCPIP_IPERF_Task(void)
+{
+    int ix;
+    TCPIP_IPERF_DCPT* pDcpt;
+
+    // TMO and ASYNC signals just trigger the processing
+    _TCPIPStackModuleSignalGet(TCPIP_THIS_MODULE_ID, TCPIP_MODULE_SIGNAL_MASK_ALL);
+
+    for(ix = 0, pDcpt = iperfDcpt; ix < sizeof(iperfDcpt) / sizeof(*iperfDcpt); ix++, pDcpt++)
+    {
+        switch(pDcpt->request)
+        {
+            case IPERF_REQ_START:
+                _IperfStart(pDcpt);
+                pDcpt->request = IPERF_REQ_NONE;
+                break;
+
+            case IPERF_REQ_STOP:
+                _IperfStop(pDcpt, true);
+                pDcpt->request = IPERF_REQ_NONE;
+                break;
+
+            default:
+                break;
+        }
+
+        switch(pDcpt->state)
+        {
+            case IPERF_STATE_TCP_LISTEN:
+            case IPERF_STATE_TCP_RX:
+                _IperfTcpServer(pDcpt);
+                break;
+
+            case IPERF_STATE_TCP_CONNECT:
+            case IPERF_STATE_TCP_TX:
+                _IperfTcpClient(pDcpt);
+                break;
+
+            case IPERF_STATE_UDP_LISTEN:
+            case IPERF_STATE_UDP_RX:
+                _IperfUdpServer(pDcpt);
+                break;
+
+            case IPERF_STATE_UDP_TX:
+                _IperfUdpClient(pDcpt);
+                break;
+
+            case IPERF_STATE_UDP_FIN:
+                _IperfUdpFin(pDcpt);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    _IperfAsyncUpdate();
+}
+
+// opens the session socket
+static void _IperfStart(TCPIP_IPERF_DCPT* pDcpt)
+{
+    IP_MULTI_ADDRESS remAdd;
+    uint16_t buffSize;
+    bool buffOk;
+
+    remAdd.v4Add = pDcpt->remoteAddr;
+
+    switch(pDcpt->flags)
+    {
+        case IPERF_FLAG_SERVER:
+            pDcpt->skt = TCPIP_TCP_ServerOpen(IP_ADDRESS_TYPE_IPV4, pDcpt->port, 0);
+            pDcpt->state = IPERF_STATE_TCP_LISTEN;
+            break;
+
+        case 0:
+            pDcpt->skt = TCPIP_TCP_ClientOpen(IP_ADDRESS_TYPE_IPV4, pDcpt->port, &remAdd);
+            pDcpt->state = IPERF_STATE_TCP_CONNECT;
+            break;
+
+        case IPERF_FLAG_UDP | IPERF_FLAG_SERVER:
+            pDcpt->skt = TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE_IPV4, pDcpt->port, 0);
+            pDcpt->state = IPERF_STATE_UDP_LISTEN;
+            break;
+
+        default:
+            pDcpt->skt = TCPIP_UDP_ClientOpen(IP_ADDRESS_TYPE_IPV4, pDcpt->port, &remAdd);
+            pDcpt->state = IPERF_STATE_UDP_TX;
+            break;
+    }
+
+    if(pDcpt->skt == INVALID_SOCKET)
+    {
+        _IperfPrint(pDcpt, "iperf: failed to open a socket\r\n");
+        pDcpt->state = IPERF_STATE_IDLE;
+        _IperfStop(pDcpt, false);
+        return;
+    }
+
+    if((pDcpt->flags & IPERF_FLAG_UDP) == 0)
+    {
+        buffSize = pDcpt->winSize;
+        buffOk = TCPIP_TCP_OptionsSet(pDcpt->skt, TCP_OPTION_RX_BUFF, (void*)(unsigned int)(buffSize ? buffSize : TCPIP_IPERF_RX_BUFFER_SIZE));
+        buffOk &= TCPIP_TCP_OptionsSet(pDcpt->skt, TCP_OPTION_TX_BUFF, (void*)(unsigned int)(buffSize ? buffSize : TCPIP_IPERF_TX_BUFFER_SIZE));
+        if(!buffOk)
+        {   // out of TCP heap; the socket keeps the buffers it has
+            _IperfPrint(pDcpt, "[%3d] could not resize the socket buffers\r\n", pDcpt->id);
+        }
+        // report the RX buffer, the advertised window
+        TCPIP_TCP_OptionsGet(pDcpt->skt, TCP_OPTION_RX_BUFF, &buffSize);
+        _IperfPrint(pDcpt, "[%3d] TCP %s port %d, window size: %d bytes\r\n", pDcpt->id,
+                (pDcpt->flags & IPERF_FLAG_SERVER) != 0 ? "server listening on" : "client connecting to", pDcpt->port, buffSize);
+    }
+    else
+    {
+        if((pDcpt->flags & IPERF_FLAG_SERVER) != 0)
+        {
+            TCPIP_UDP_OptionsSet(pDcpt->skt, UDP_OPTION_RX_QUEUE_LIMIT, (void*)TCPIP_IPERF_UDP_RX_QUEUE_LIMIT);
+        }
+        else
+        {
+            TCPIP_UDP_OptionsSet(pDcpt->skt, UDP_OPTION_TX_BUFF, (void*)(unsigned int)pDcpt->bufferLen);
+            TCPIP_UDP_OptionsSet(pDcpt->skt, UDP_OPTION_TX_QUEUE_LIMIT, (void*)TCPIP_IPERF_UDP_TX_QUEUE_LIMIT);
+        }
+        _IperfPrint(pDcpt, "[%3d] UDP %s port %d, %d byte datagrams\r\n", pDcpt->id,
+                (pDcpt->flags & IPERF_FLAG_SERVER) != 0 ? "server listening on" : "client sending to", pDcpt->port, pDcpt->bufferLen);
+    }
+
+    pDcpt->startTime = pDcpt->eventTime = pDcpt->reportTime = _IperfTimeGet();
+    pDcpt->totalBytes = pDcpt->reportBytes = 0;
+    pDcpt->pktId = 0;
+}
+
+// ends the current transfer and prints the final report
+// servers go back to listening; clients are closed
+static void _IperfStop(TCPIP_IPERF_DCPT* pDcpt, bool report)
+{
+    char idStr[6];
+    uint32_t endMs;
+    TCPIP_IPERF_DCPT* pLeader;
+    bool transfer = pDcpt->state == IPERF_STATE_TCP_RX || pDcpt->state == IPERF_STATE_TCP_TX ||
+                    pDcpt->state == IPERF_STATE_UDP_RX || pDcpt->state == IPERF_STATE_UDP_TX || pDcpt->state == IPERF_STATE_UDP_FIN;
+
+    if(report && transfer)
+    {
+        endMs = (uint32_t)((pDcpt->eventTime - pDcpt->startTime) / 1000);
+        sprintf(idStr, "%d", pDcpt->id);
+        _IperfReport(pDcpt, idStr, 0, endMs, pDcpt->totalBytes);
+    }
+
+    if(pDcpt->request != IPERF_REQ_STOP && (pDcpt->flags & IPERF_FLAG_SERVER) != 0 && pDcpt->state != IPERF_STATE_IDLE)
+    {   // server: wait for the next client
+        if((pDcpt->flags & IPERF_FLAG_UDP) == 0)
+        {
+            TCPIP_TCP_Disconnect(pDcpt->skt);
+            pDcpt->state = IPERF_STATE_TCP_LISTEN;
+        }
+        else
+        {
+            pDcpt->state = IPERF_STATE_UDP_LISTEN;
+        }
+        return;
+    }
+
+    _IperfClose(pDcpt);
+
+    // update the parallel streams group
+    pLeader = iperfDcpt + pDcpt->leader;
+    pLeader->groupBytes += pDcpt->totalBytes;
+    if(pDcpt->eventTime > pLeader->groupEndTime)
+    {
+        pLeader->groupEndTime = pDcpt->eventTime;
+    }
+    if(pLeader->groupActive != 0 && --pLeader->groupActive == 0 && pLeader->groupSize > 1)
+    {   // the group is done; the leader slot was kept for the sum
+        // the sum spans to the last transfer of any member, not of the last one to finish
+        endMs = (uint32_t)((pLeader->groupEndTime - pLeader->startTime) / 1000);
+        _IperfReport(pLeader, "SUM", 0, endMs, pLeader->groupBytes);
+    }
+}
+
+// releases the session socket
+static void _IperfClose(TCPIP_IPERF_DCPT* pDcpt)
+{
+    if(pDcpt->state != IPERF_STATE_IDLE)
+    {
+        if((pDcpt->flags & IPERF_FLAG_UDP) == 0)
+        {
+            TCPIP_TCP_Close(pDcpt->skt);
+        }
+        else
+        {
+            TCPIP_UDP_Close(pDcpt->skt);
+        }
+        pDcpt->state = IPERF_STATE_IDLE;
+        pDcpt->skt = INVALID_SOCKET;
+    }
+}
+
+// prints the interval report, if due
+static void _IperfIntervalCheck(TCPIP_IPERF_DCPT* pDcpt, uint64_t now)
+{
+    char idStr[6];
+    uint32_t startMs, endMs;
+
+    if(pDcpt->interval != 0 && now - pDcpt->reportTime >= (uint64_t)pDcpt->interval * 1000)
+    {
+        startMs = (uint32_t)((pDcpt->reportTime - pDcpt->startTime) / 1000);
+        endMs = startMs + pDcpt->interval;
+        sprintf(idStr, "%d", pDcpt->id);
+        _IperfReport(pDcpt, idStr, startMs, endMs, pDcpt->totalBytes - pDcpt->reportBytes);
+        pDcpt->reportTime += (uint64_t)pDcpt->interval * 1000;
+        pDcpt->reportBytes = pDcpt->totalBytes;
+    }
+}
+
+// checks if the client has sent everything it was supposed to
+static bool _IperfClientDone(TCPIP_IPERF_DCPT* pDcpt, uint64_t now)
+{
+    if(pDcpt->duration != 0)
+    {
+        return now - pDcpt->startTime >= (uint64_t)pDcpt->duration * 1000;
+    }
+
+    return pDcpt->totalBytes >= pDcpt->amount;
+}
+
+static void _IperfTcpServer(TCPIP_IPERF_DCPT* pDcpt)
+{
+    TCP_SOCKET_INFO sktInfo;
+    uint16_t nBytes;
+    uint64_t now = _IperfTimeGet();
+
+    if(pDcpt->state == IPERF_STATE_TCP_LISTEN)
+    {
+        if(!TCPIP_TCP_IsConnected(pDcpt->skt))
+        {
+            return;
+        }
+
+        TCPIP_TCP_SocketInfoGet(pDcpt->skt, &sktInfo);
+        pDcpt->remoteAddr = sktInfo.remoteIPaddress.v4Add;
+        _IperfPrint(pDcpt, "[%3d] local port %d connected with %d.%d.%d.%d port %d\r\n", pDcpt->id, pDcpt->port,
+                pDcpt->remoteAddr.v[0], pDcpt->remoteAddr.v[1], pDcpt->remoteAddr.v[2], pDcpt->remoteAddr.v[3], sktInfo.remotePort);
+        pDcpt->startTime = pDcpt->eventTime = pDcpt->reportTime = now;
+        pDcpt->totalBytes = pDcpt->reportBytes = 0;
+        pDcpt->state = IPERF_STATE_TCP_RX;
+    }
+
+    // the payload is not checked; the client header flags are always 0 (no dual test)
+    while((nBytes = TCPIP_TCP_Discard(pDcpt->skt)) != 0)
+    {
+        pDcpt->totalBytes += nBytes;
+        pDcpt->eventTime = now;
+    }
+
+    _IperfIntervalCheck(pDcpt, now);
+
+    if(TCPIP_TCP_WasDisconnected(pDcpt->skt) || !TCPIP_TCP_IsConnected(pDcpt->skt))
+    {
+        _IperfStop(pDcpt, true);
+    }
+}
+
+static void _IperfTcpClient(TCPIP_IPERF_DCPT* pDcpt)
+{
+    uint16_t avlbl, len, nBytes, offset;
+    IPERF_CLIENT_HDR clientHdr;
+    uint64_t now = _IperfTimeGet();
+
+    if(pDcpt->state == IPERF_STATE_TCP_CONNECT)
+    {
+        if(!TCPIP_TCP_IsConnected(pDcpt->skt))
+        {
+            if(now - pDcpt->startTime >= (uint64_t)TCPIP_IPERF_CONNECT_TMO * 1000)
+            {
+                _IperfPrint(pDcpt, "[%3d] connect failed\r\n", pDcpt->id);
+                _IperfStop(pDcpt, false);
+            }
+            return;
+        }
+
+        _IperfPrint(pDcpt, "[%3d] connected with %d.%d.%d.%d port %d\r\n", pDcpt->id,
+                pDcpt->remoteAddr.v[0], pDcpt->remoteAddr.v[1], pDcpt->remoteAddr.v[2], pDcpt->remoteAddr.v[3], pDcpt->port);
+
+        // the stream starts with the client settings, plain test
+        memset(&clientHdr, 0, sizeof(clientHdr));
+        TCPIP_TCP_ArrayPut(pDcpt->skt, (const uint8_t*)&clientHdr, sizeof(clientHdr));
+        pDcpt->startTime = pDcpt->eventTime = pDcpt->reportTime = now;
+        pDcpt->totalBytes = pDcpt->reportBytes = sizeof(clientHdr);
+        pDcpt->state = IPERF_STATE_TCP_TX;
+    }
+
+    if(!TCPIP_TCP_IsConnected(pDcpt->skt))
+    {
+        _IperfPrint(pDcpt, "[%3d] connection closed by the server\r\n", pDcpt->id);
+        _IperfStop(pDcpt, true);
+        return;
+    }
+
+    while(!_IperfClientDone(pDcpt, now) && (avlbl = TCPIP_TCP_PutIsReady(pDcpt->skt)) != 0)
+    {
+        len = avlbl < pDcpt->bufferLen ? avlbl : pDcpt->bufferLen;
+        if(pDcpt->duration == 0 && len > pDcpt->amount - pDcpt->totalBytes)
+        {
+            len = pDcpt->amount - pDcpt->totalBytes;
+        }
+
+        // keep the '0'..'9' sequence across writes
+        offset = pDcpt->totalBytes % 10;
+        nBytes = len < sizeof(iperfPattern) - 1 - offset ? len : sizeof(iperfPattern) - 1 - offset;
+        nBytes = TCPIP_TCP_ArrayPut(pDcpt->skt, iperfPattern + offset, nBytes);
+        if(nBytes == 0)
+        {
+            break;
+        }
+        pDcpt->totalBytes += nBytes;
+        pDcpt->eventTime = now;
+    }
+
+    _IperfIntervalCheck(pDcpt, now);
+
+    if(_IperfClientDone(pDcpt, now))
+    {   // graceful close sends the data still queued
+        TCPIP_TCP_Flush(pDcpt->skt);
+        _IperfStop(pDcpt, true);
+    }
+}
+
+// updates the loss and jitter statistics with a received datagram
+// jitter as in RFC 1889: J += (|D(i-1,i)| - J) / 16
+static void _IperfUdpStat(TCPIP_IPERF_DCPT* pDcpt, const IPERF_UDP_DATAGRAM* pDgram, uint64_t now)
+{
+    int32_t pktId = (int32_t)TCPIP_Helper_ntohl(pDgram->id);
+    uint64_t sent = (uint64_t)TCPIP_Helper_ntohl(pDgram->tv_sec) * 1000000 + TCPIP_Helper_ntohl(pDgram->tv_usec);
+    int32_t transit = (int32_t)(now - sent);
+    int32_t delta;
+
+    if(pDcpt->totalBytes != 0)
+    {
+        delta = transit - pDcpt->lastTransit;
+        if(delta < 0)
+        {
+            delta = -delta;
+        }
+        pDcpt->jitter += ((int32_t)delta - (int32_t)pDcpt->jitter) / 16;
+    }
+    pDcpt->lastTransit = transit;
+
+    if(pktId != pDcpt->pktId + 1)
+    {
+        if(pktId < pDcpt->pktId + 1)
+        {
+            pDcpt->outOfOrder++;
+        }
+        else
+        {
+            pDcpt->errorCnt += pktId - pDcpt->pktId - 1;
+        }
+    }
+    if(pktId > pDcpt->pktId)
+    {
+        pDcpt->pktId = pktId;
+    }
+}
+
+// sends the server report in reply to a FIN datagram
+static void _IperfUdpReportSend(TCPIP_IPERF_DCPT* pDcpt, const IPERF_UDP_DATAGRAM* pFin)
+{
+    IPERF_SERVER_HDR srvHdr;
+    uint32_t errors;
+
+    if(TCPIP_UDP_PutIsReady(pDcpt->skt) < sizeof(*pFin) + sizeof(srvHdr))
+    {   // the client will retry
+        return;
+    }
+
+    errors = pDcpt->errorCnt > pDcpt->outOfOrder ? pDcpt->errorCnt - pDcpt->outOfOrder : 0;
+    srvHdr.flags = TCPIP_Helper_htonl(IPERF_HEADER_VERSION1);
+    srvHdr.total_len1 = 0;
+    srvHdr.total_len2 = TCPIP_Helper_htonl(pDcpt->totalBytes);
+    srvHdr.stop_sec = TCPIP_Helper_htonl(pDcpt->stopTime / 1000);
+    srvHdr.stop_usec = TCPIP_Helper_htonl((pDcpt->stopTime % 1000) * 1000);
+    srvHdr.error_cnt = TCPIP_Helper_htonl(errors);
+    srvHdr.outorder_cnt = TCPIP_Helper_htonl(pDcpt->outOfOrder);
+    srvHdr.datagrams = TCPIP_Helper_htonl(pDcpt->pktId + 1);
+    srvHdr.jitter1 = TCPIP_Helper_htonl(pDcpt->jitter / 1000000);
+    srvHdr.jitter2 = TCPIP_Helper_htonl(pDcpt->jitter % 1000000);
+
+    TCPIP_UDP_ArrayPut(pDcpt->skt, (const uint8_t*)pFin, sizeof(*pFin));
+    TCPIP_UDP_ArrayPut(pDcpt->skt, (const uint8_t*)&srvHdr, sizeof(srvHdr));
+    TCPIP_UDP_Flush(pDcpt->skt);
+}
+
+static void _IperfUdpServer(TCPIP_IPERF_DCPT* pDcpt)
+{
+    IPERF_UDP_DATAGRAM dgram;
+    UDP_SOCKET_INFO sktInfo;
+    IP_MULTI_ADDRESS remAdd;
+    uint16_t pktLen;
+    int32_t pktId;
+    char idStr[6];
+    uint32_t errors;
+    uint64_t now = _IperfTimeGet();
+
+    while((pktLen = TCPIP_UDP_GetIsReady(pDcpt->skt)) != 0)
+    {
+        if(pktLen < sizeof(dgram))
+        {   // not an iperf datagram
+            TCPIP_UDP_Discard(pDcpt->skt);
+            continue;
+        }
+
+        TCPIP_UDP_ArrayGet(pDcpt->skt, (uint8_t*)&dgram, sizeof(dgram));
+        TCPIP_UDP_SocketInfoGet(pDcpt->skt, &sktInfo);
+        TCPIP_UDP_Discard(pDcpt->skt);
+        pktId = (int32_t)TCPIP_Helper_ntohl(dgram.id);
+
+        if(pDcpt->state == IPERF_STATE_UDP_LISTEN)
+        {
+            if(pktId < 0)
+            {   // FIN retry; resend the report of the last session
+                if(pDcpt->reportValid && sktInfo.sourceIPaddress.v4Add.Val == pDcpt->remoteAddr.Val && sktInfo.remotePort == pDcpt->remotePort)
+                {
+                    _IperfUdpReportSend(pDcpt, &dgram);
+                }
+                continue;
+            }
+
+            // new client
+            pDcpt->remoteAddr = sktInfo.sourceIPaddress.v4Add;
+            pDcpt->remotePort = sktInfo.remotePort;
+            _IperfPrint(pDcpt, "[%3d] local port %d connected with %d.%d.%d.%d port %d\r\n", pDcpt->id, pDcpt->port,
+                    pDcpt->remoteAddr.v[0], pDcpt->remoteAddr.v[1], pDcpt->remoteAddr.v[2], pDcpt->remoteAddr.v[3], pDcpt->remotePort);
+            pDcpt->startTime = pDcpt->eventTime = pDcpt->reportTime = now;
+            pDcpt->totalBytes = pDcpt->reportBytes = 0;
+            pDcpt->pktId = -1;
+            pDcpt->errorCnt = pDcpt->outOfOrder = pDcpt->jitter = 0;
+            pDcpt->reportValid = false;
+            pDcpt->state = IPERF_STATE_UDP_RX;
+        }
+        else if(sktInfo.sourceIPaddress.v4Add.Val != pDcpt->remoteAddr.Val || sktInfo.remotePort != pDcpt->remotePort)
+        {   // one client at a time
+            continue;
+        }
+
+        if(pktId < 0)
+        {   // FIN: end of the test
+            pDcpt->stopTime = (uint32_t)((pDcpt->eventTime - pDcpt->startTime) / 1000);
+            _IperfStop(pDcpt, true);
+            errors = pDcpt->errorCnt > pDcpt->outOfOrder ? pDcpt->errorCnt - pDcpt->outOfOrder : 0;
+            _IperfPrint(pDcpt, "[%3d] jitter %lu.%03lu ms, lost %lu/%ld datagrams, %lu out of order\r\n", pDcpt->id,
+                    pDcpt->jitter / 1000, pDcpt->jitter % 1000, errors, pDcpt->pktId + 1, pDcpt->outOfOrder);
+            remAdd.v4Add = pDcpt->remoteAddr;
+            TCPIP_UDP_DestinationIPAddressSet(pDcpt->skt, IP_ADDRESS_TYPE_IPV4, &remAdd);
+            TCPIP_UDP_DestinationPortSet(pDcpt->skt, pDcpt->remotePort);
+            pDcpt->reportValid = true;
+            _IperfUdpReportSend(pDcpt, &dgram);
+            return;
+        }
+
+        _IperfUdpStat(pDcpt, &dgram, now);
+        pDcpt->totalBytes += pktLen;
+        pDcpt->eventTime = now;
+    }
+
+    if(pDcpt->state == IPERF_STATE_UDP_RX)
+    {
+        _IperfIntervalCheck(pDcpt, now);
+        if(now - pDcpt->eventTime >= (uint64_t)TCPIP_IPERF_IDLE_TMO * 1000)
+        {   // client gone without a FIN
+            sprintf(idStr, "%d", pDcpt->id);
+            _IperfPrint(pDcpt, "[%3s] no FIN received, session timed out\r\n", idStr);
+            pDcpt->stopTime = (uint32_t)((pDcpt->eventTime - pDcpt->startTime) / 1000);
+            _IperfStop(pDcpt, true);
+        }
+    }
+}
+
+// sends one datagram
+// pktId < 0 for the FIN datagram
+static bool _IperfUdpSend(TCPIP_IPERF_DCPT* pDcpt, int32_t pktId, uint64_t now)
+{
+    IPERF_UDP_DATAGRAM dgram;
+    IPERF_CLIENT_HDR clientHdr;
+    uint16_t len, nBytes;
+
+    if(TCPIP_UDP_TxPutIsReady(pDcpt->skt, pDcpt->bufferLen) < pDcpt->bufferLen)
+    {
+        return false;
+    }
+
+    dgram.id = TCPIP_Helper_htonl(pktId);
+    dgram.tv_sec = TCPIP_Helper_htonl((uint32_t)(now / 1000000));
+    dgram.tv_usec = TCPIP_Helper_htonl((uint32_t)(now % 1000000));
+    TCPIP_UDP_ArrayPut(pDcpt->skt, (const uint8_t*)&dgram, sizeof(dgram));
+    len = sizeof(dgram);
+
+    if(pDcpt->bufferLen >= sizeof(dgram) + sizeof(clientHdr))
+    {   // plain test
+        memset(&clientHdr, 0, sizeof(clientHdr));
+        TCPIP_UDP_ArrayPut(pDcpt->skt, (const uint8_t*)&clientHdr, sizeof(clientHdr));
+        len += sizeof(clientHdr);
+    }
+
+    while(len < pDcpt->bufferLen)
+    {
+        nBytes = pDcpt->bufferLen - len < sizeof(iperfPattern) - 1 ? pDcpt->bufferLen - len : sizeof(iperfPattern) - 1;
+        TCPIP_UDP_ArrayPut(pDcpt->skt, iperfPattern, nBytes);
+        len += nBytes;
+    }
+
+    return TCPIP_UDP_Flush(pDcpt->skt) != 0;
+}
+
+static void _IperfUdpClient(TCPIP_IPERF_DCPT* pDcpt)
+{
+    uint64_t now = _IperfTimeGet();
+    // bytes allowed so far by the requested bandwidth
+    uint64_t allowed = ((uint64_t)pDcpt->bandwidth * (now - pDcpt->startTime)) / 8000000;
+
+    while(!_IperfClientDone(pDcpt, now) && pDcpt->totalBytes <= allowed)
+    {
+        if(!_IperfUdpSend(pDcpt, pDcpt->pktId, now))
+        {
+            break;
+        }
+        pDcpt->pktId++;
+        pDcpt->totalBytes += pDcpt->bufferLen;
+        pDcpt->eventTime = now;
+    }
+
+    _IperfIntervalCheck(pDcpt, now);
+
+    if(_IperfClientDone(pDcpt, now))
+    {   // ask for the server report
+        pDcpt->finRetries = IPERF_UDP_FIN_RETRIES;
+        pDcpt->state = IPERF_STATE_UDP_FIN;
+        _IperfUdpFin(pDcpt);
+    }
+}
+
+static void _IperfUdpFin(TCPIP_IPERF_DCPT* pDcpt)
+{
+    uint8_t reply[sizeof(IPERF_UDP_DATAGRAM) + sizeof(IPERF_SERVER_HDR)];
+    IPERF_SERVER_HDR* pSrvHdr;
+    uint32_t stopMs, jitterUs, nBytes;
+    int32_t datagrams;
+    char idStr[6];
+    uint64_t now = _IperfTimeGet();
+
+    while(TCPIP_UDP_GetIsReady(pDcpt->skt) != 0)
+    {
+        if(TCPIP_UDP_ArrayGet(pDcpt->skt, reply, sizeof(reply)) == sizeof(reply))
+        {
+            pSrvHdr = (IPERF_SERVER_HDR*)(reply + sizeof(IPERF_UDP_DATAGRAM));
+            if((TCPIP_Helper_ntohl(pSrvHdr->flags) & IPERF_HEADER_VERSION1) != 0)
+            {
+                TCPIP_UDP_Discard(pDcpt->skt);
+                _IperfStop(pDcpt, true);
+
+                nBytes = TCPIP_Helper_ntohl(pSrvHdr->total_len2);
+                stopMs = TCPIP_Helper_ntohl(pSrvHdr->stop_sec) * 1000 + TCPIP_Helper_ntohl(pSrvHdr->stop_usec) / 1000;
+                jitterUs = TCPIP_Helper_ntohl(pSrvHdr->jitter1) * 1000000 + TCPIP_Helper_ntohl(pSrvHdr->jitter2);
+                datagrams = (int32_t)TCPIP_Helper_ntohl(pSrvHdr->datagrams);
+                sprintf(idStr, "%d", pDcpt->id);
+                _IperfPrint(pDcpt, "[%3s] Server Report:\r\n", idStr);
+                _IperfReport(pDcpt, idStr, 0, stopMs, nBytes);
+                _IperfPrint(pDcpt, "[%3s] jitter %lu.%03lu ms, lost %ld/%ld datagrams, %ld out of order\r\n", idStr,
+                        jitterUs / 1000, jitterUs % 1000, (int32_t)TCPIP_Helper_ntohl(pSrvHdr->error_cnt), datagrams,
+                        (int32_t)TCPIP_Helper_ntohl(pSrvHdr->outorder_cnt));
+                return;
+            }
+        }
+        TCPIP_UDP_Discard(pDcpt->skt);
+    }
+
+    if(pDcpt->finRetries != IPERF_UDP_FIN_RETRIES && now - pDcpt->finTime < IPERF_UDP_FIN_TMO * 1000)
+    {   // wait for the reply
+        return;
+    }
+
+    if(pDcpt->finRetries == 0)
+    {
+        sprintf(idStr, "%d", pDcpt->id);
+        _IperfPrint(pDcpt, "[%3s] no server report received\r\n", idStr);
+        _IperfStop(pDcpt, true);
+        return;
+    }
+
+    // FIN carries the negated datagram count
+    if(_IperfUdpSend(pDcpt, pDcpt->pktId != 0 ? -pDcpt->pktId : -1, now))
+    {
+        pDcpt->finRetries--;
+        pDcpt->finTime = now;
+    }
+}
+
+// parses a number with an optional K/M/G suffix
+// saturates at 0xffffffff
+static uint32_t _IperfNumberGet(const char* str, uint32_t kUnit)
+{
+    char* pEnd;
+    uint64_t num = strtoul(str, &pEnd, 10);
+
+    switch(*pEnd)
+    {
+        case 'k':
+        case 'K':
+            num *= kUnit;
+            break;
+
+        case 'm':
+        case 'M':
+            num *= (uint64_t)kUnit * kUnit;
+            break;
+
+        case 'g':
+        case 'G':
+            num *= (uint64_t)kUnit * kUnit * kUnit;
+            break;
+
+        default:
+            break;
+    }
+
+    return num > 0xffffffff ? 0xffffffff : (uint32_t)num;
+}
+
+// iperf -s|-c <addr> [-u] [-p port] [-t sec] [-n bytes] [-b bw] [-l len] [-w size] [-i sec] [-P streams]
+static void _Command_Iperf(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
+{
+    int ix, nStreams, nFree, leader;
+    uint32_t bufferLen, winSize, maxLen;
+    TCPIP_IPERF_DCPT settings, *pDcpt;
+    TCPIP_NET_HANDLE hNet;
+    const void* cmdIoParam = pCmdIO->cmdIoParam;
+    bool server = false, client = false;
+
+    memset(&settings, 0, sizeof(settings));
+    settings.port = TCPIP_IPERF_SERVER_PORT;
+    settings.duration = IPERF_DEFAULT_DURATION * 1000;
+    nStreams = 1;
+    bufferLen = winSize = 0;
+
+    for(ix = 1; ix < argc; ix++)
+    {
+        if(strcmp(argv[ix], "-s") == 0)
+        {
+            server = true;
+            settings.flags |= IPERF_FLAG_SERVER;
+            continue;
+        }
+        else if(strcmp(argv[ix], "-u") == 0)
+        {
+            settings.flags |= IPERF_FLAG_UDP;
+            continue;
+        }
+
+        if(ix + 1 >= argc)
+        {
+            break;
+        }
+
+        if(strcmp(argv[ix], "-c") == 0)
+        {
+            client = TCPIP_Helper_StringToIPAddress(argv[++ix], &settings.remoteAddr);
+            if(!client)
+            {
+                break;
+            }
+            if(settings.remoteAddr.v[0] == 127)
+            {   // no loopback interface; the stack routes its own address internally
+                hNet = TCPIP_STACK_NetDefaultGet();
+                settings.remoteAddr.Val = TCPIP_STACK_NetAddress(hNet);
+            }
+        }
+        else if(strcmp(argv[ix], "-p") == 0)
+        {
+            settings.port = atoi(argv[++ix]);
+        }
+        else if(strcmp(argv[ix], "-t") == 0)
+        {
+            settings.duration = atoi(argv[++ix]) * 1000;
+        }
+        else if(strcmp(argv[ix], "-n") == 0)
+        {
+            settings.amount = _IperfNumberGet(argv[++ix], 1024);
+            settings.duration = 0;
+        }
+        else if(strcmp(argv[ix], "-b") == 0)
+        {
+            settings.bandwidth = _IperfNumberGet(argv[++ix], 1000);
+        }
+        else if(strcmp(argv[ix], "-l") == 0)
+        {
+            bufferLen = _IperfNumberGet(argv[++ix], 1024);
+        }
+        else if(strcmp(argv[ix], "-w") == 0)
+        {
+            winSize = _IperfNumberGet(argv[++ix], 1024);
+        }
+        else if(strcmp(argv[ix], "-i") == 0)
+        {
+            settings.interval = atoi(argv[++ix]) * 1000;
+        }
+        else if(strcmp(argv[ix], "-P") == 0)
+        {
+            nStreams = atoi(argv[++ix]);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if(ix != argc || server == client || nStreams < 1 || settings.port == 0 || (client && settings.duration == 0 && settings.amount == 0))
+    {
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: iperf -s|-c <addr> [-u] [-p port] [-t sec] [-n bytes] [-b bw] [-l len] [-w size] [-i sec] [-P streams]\r\n");
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Ex: iperf -s -u -i 1; iperf -c 192.168.1.10 -t 20 -P 2\r\n");
+        return;
+    }
+
+    // the sizes are kept in 16 bits; report any value that is not used as given
+    if(bufferLen == 0)
+    {
+        bufferLen = (settings.flags & IPERF_FLAG_UDP) != 0 ? IPERF_DEFAULT_UDP_LEN : IPERF_DEFAULT_TCP_LEN;
+    }
+    maxLen = (settings.flags & IPERF_FLAG_UDP) != 0 ? IPERF_MAX_UDP_LEN : IPERF_MAX_TCP_LEN;
+    if(bufferLen > maxLen)
+    {
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "iperf: buffer length %lu too large, using %lu bytes\r\n", bufferLen, maxLen);
+        bufferLen = maxLen;
+    }
+    else if((settings.flags & IPERF_FLAG_UDP) != 0 && bufferLen < sizeof(IPERF_UDP_DATAGRAM) + sizeof(IPERF_SERVER_HDR))
+    {
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "iperf: buffer length %lu too small, using %d bytes\r\n", bufferLen, (int)(sizeof(IPERF_UDP_DATAGRAM) + sizeof(IPERF_SERVER_HDR)));
+        bufferLen = sizeof(IPERF_UDP_DATAGRAM) + sizeof(IPERF_SERVER_HDR);
+    }
+    settings.bufferLen = bufferLen;
+
+    if(winSize > IPERF_MAX_WIN_SIZE)
+    {
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "iperf: window size %lu too large, using %d bytes\r\n", winSize, IPERF_MAX_WIN_SIZE);
+        winSize = IPERF_MAX_WIN_SIZE;
+    }
+    settings.winSize = winSize;
+
+    if((settings.flags & IPERF_FLAG_UDP) != 0)
+    {
+        if(settings.bandwidth == 0)
+        {
+            settings.bandwidth = IPERF_DEFAULT_UDP_BW;
+        }
+        if(server)
+        {   // the UDP server tracks one client per port
+            nStreams = 1;
+        }
+    }
+
+    for(ix = 0, nFree = 0; ix < sizeof(iperfDcpt) / sizeof(*iperfDcpt); ix++)
+    {
+        if(iperfDcpt[ix].state == IPERF_STATE_IDLE && iperfDcpt[ix].request == IPERF_REQ_NONE && iperfDcpt[ix].groupActive == 0)
+        {
+            nFree++;
+        }
+    }
+    if(nFree < nStreams)
+    {
+        (*pCmdIO->pCmdApi->print)(cmdIoParam, "iperf: %d sessions available\r\n", nFree);
+        return;
+    }
+
+    settings.pCmdIO = pCmdIO;
+    settings.cmdIoParam = cmdIoParam;
+    settings.skt = INVALID_SOCKET;
+
+    leader = -1;
+    for(ix = 0, pDcpt = iperfDcpt; ix < sizeof(iperfDcpt) / sizeof(*iperfDcpt) && nStreams != 0; ix++, pDcpt++)
+    {
+        if(pDcpt->state != IPERF_STATE_IDLE || pDcpt->request != IPERF_REQ_NONE || pDcpt->groupActive != 0)
+        {
+            continue;
+        }
+
+        *pDcpt = settings;
+        if(leader < 0)
+        {   // 1st stream leads the group
+            leader = ix;
+            if(!server)
+            {   // servers are never done
+                pDcpt->groupSize = pDcpt->groupActive = nStreams;
+            }
+        }
+        pDcpt->leader = leader;
+        pDcpt->id = ++iperfIdCount;
+        // hand it over to the stack task
+        pDcpt->request = IPERF_REQ_START;
+        nStreams--;
+    }
+}
+
+// iperfk [id]
+static void _Command_IperfStop(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
+{
+    int ix, id, nStop;
+    TCPIP_IPERF_DCPT* pDcpt;
+
+    id = argc > 1 ? atoi(argv[1]) : 0;
+
+    for(ix = 0, nStop = 0, pDcpt = iperfDcpt; ix < sizeof(iperfDcpt) / sizeof(*iperfDcpt); ix++, pDcpt++)
+    {
+        if(pDcpt->state != IPERF_STATE_IDLE && (id == 0 || pDcpt->id == id))
+        {
+            pDcpt->request = IPERF_REQ_STOP;
+            nStop++;
+        }
+    }
+
+    (*pCmdIO->pCmdApi->print)(pCmdIO->cmdIoParam, "iperf: %d session(s) stopped\r\n", nStop);
+}
+
+#endif  // defined(TCPIP_STACK_USE_TCP) && defined(TCPIP_STACK_USE_UDP)
+#endif  // defined(TCPIP_STACK_USE_IPV4) && defined(TCPIP_STACK_USE_IPERF)
+
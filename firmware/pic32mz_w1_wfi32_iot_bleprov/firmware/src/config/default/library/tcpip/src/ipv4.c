@@ -988,7 +988,6 @@ static bool TCPIP_IPV4_ForwardPkt(TCPIP_MAC_PACKET* pFwdPkt, const IPV4_ROUTE_TA
     IPV4_ADDR       arpTarget;
     bool            macRes;
     uint16_t        pktPayload, linkMtu;
-    uint8_t         headerLen;
 
 #if ((TCPIP_IPV4_DEBUG_LEVEL & TCPIP_IPV4_DEBUG_MASK_FWD) != 0)
         TCPIP_IPV4_FORWARD_STAT* pFwdDbg = _ipv4_fwd_stat + (pEntry->outIfIx < 2 ? pEntry->outIfIx : 2);
@@ -1073,12 +1072,13 @@ static bool TCPIP_IPV4_ForwardPkt(TCPIP_MAC_PACKET* pFwdPkt, const IPV4_ROUTE_TA
     pFwdPkt->pDSeg->segLen += sizeof(TCPIP_MAC_ETHERNET_HEADER);
     pFwdPkt->pktFlags |= TCPIP_MAC_PKT_FLAG_TX; 
 
-    // adjust the TTL and recalculate the IP checksum
+    // adjust the TTL and update the IP checksum
+    // the TTL and Protocol share a 16 bit word of the header
     IPV4_HEADER* pHeader = (IPV4_HEADER*)pFwdPkt->pNetLayer;
+    uint16_t oldTtlWord = TCPIP_Helper_htons(((uint16_t)pHeader->TimeToLive << 8) | pHeader->Protocol);
     pHeader->TimeToLive -= 1;
-    pHeader->HeaderChecksum = 0;
-    headerLen = pHeader->IHL << 2;
-    pHeader->HeaderChecksum = TCPIP_Helper_CalcIPChecksum((uint8_t*)pHeader, headerLen, 0);
+    uint16_t newTtlWord = TCPIP_Helper_htons(((uint16_t)pHeader->TimeToLive << 8) | pHeader->Protocol);
+    pHeader->HeaderChecksum = TCPIP_Helper_ChecksumUpdate16(pHeader->HeaderChecksum, oldTtlWord, newTtlWord);
 
     if(pMacDst == 0)
     {   // ARP target not known yet; queue it
@@ -2217,11 +2217,68 @@ void TCPIP_IPV4_PacketFormatTx(IPV4_PACKET* pPkt, uint8_t protocol, uint16_t ipL
 }
 
 // queues a packet waiting for ARP resolution
+// at most TCPIP_IPV4_ARP_TARGET_SLOTS packets are queued for the same target:
+// the oldest one is discarded and its entry is reused for the new packet
 static bool TCPIP_IPV4_QueueArpPacket(void* pPkt, int arpIfIx, IPV4_ARP_PKT_TYPE type, IPV4_ADDR* arpTarget)
 {
+    IPV4_ARP_ENTRY *pEntry, *pOldPrev, *pPrev;
+    int             nTgtPkts;
+    TCPIP_MAC_PACKET* pOldMac;
+
     PROTECTED_SINGLE_LIST* pList = &ipv4ArpQueue;
     TCPIP_Helper_ProtectedSingleListLock(pList);
-    IPV4_ARP_ENTRY* pEntry = (IPV4_ARP_ENTRY*)TCPIP_Helper_SingleListHeadRemove(&ipv4ArpPool);
+
+    nTgtPkts = 0;
+    pOldPrev = pPrev = 0;
+    for(pEntry = (IPV4_ARP_ENTRY*)pList->list.head; pEntry != 0; pPrev = pEntry, pEntry = pEntry->next)
+    {
+        if(pEntry->arpTarget.Val == arpTarget->Val && pEntry->arpIfIx == (uint8_t)arpIfIx)
+        {
+            if(nTgtPkts++ == 0)
+            {   // the list is FIFO, the 1st match is the oldest
+                pOldPrev = pPrev;
+            }
+        }
+    }
+
+    if(nTgtPkts >= TCPIP_IPV4_ARP_TARGET_SLOTS)
+    {   // discard the oldest packet for this target
+        if(pOldPrev == 0)
+        {
+            pEntry = (IPV4_ARP_ENTRY*)TCPIP_Helper_SingleListHeadRemove(&pList->list);
+        }
+        else
+        {
+            pEntry = (IPV4_ARP_ENTRY*)TCPIP_Helper_SingleListNextRemove(&pList->list, (SGL_LIST_NODE*)pOldPrev);
+        }
+
+        if(pEntry->type == IPV4_ARP_PKT_TYPE_TX)
+        {   // IPV4_PACKET*
+            pOldMac = &pEntry->pTxPkt->macPkt;
+        }
+        else
+        {   // TCPIP_MAC_PACKET*
+            pOldMac = pEntry->pMacPkt;
+        }
+#if (TCPIP_IPV4_FORWARDING_ENABLE != 0)
+        if(pEntry->type == IPV4_ARP_PKT_TYPE_FWD)
+        {
+            TCPIP_PKT_PacketAcknowledge(pOldMac, TCPIP_MAC_PKT_ACK_BUFFER_ERR);
+        }
+        else
+#endif  // (TCPIP_IPV4_FORWARDING_ENABLE != 0)
+        {
+            TCPIP_IPV4_FragmentTxAcknowledge(pOldMac, TCPIP_MAC_PKT_ACK_BUFFER_ERR, IPV4_FRAG_TX_ACK_HEAD | IPV4_FRAG_TX_ACK_FRAGS);
+        }
+#if ((TCPIP_IPV4_DEBUG_LEVEL & TCPIP_IPV4_DEBUG_MASK_ARP_QUEUE) != 0)
+        _ipv4_arp_stat.tgtDrop++;
+#endif  // ((TCPIP_IPV4_DEBUG_LEVEL & TCPIP_IPV4_DEBUG_MASK_ARP_QUEUE) != 0)
+    }
+    else
+    {
+        pEntry = (IPV4_ARP_ENTRY*)TCPIP_Helper_SingleListHeadRemove(&ipv4ArpPool);
+    }
+
     if(pEntry == 0)
     {   // out of ARP entries in the pool
         SYS_ERROR(SYS_ERROR_WARNING, "IPv4: ARP entries pool empty!\r\n");
@@ -174,6 +174,13 @@ typedef struct _tag_IPV4_ARP_ENTRY
     IPV4_ADDR               arpTarget;  // ARP resolution target
 }IPV4_ARP_ENTRY;
 
+// maximum number of packets queued for the same ARP target
+// once reached, the oldest packet for that target is discarded
+// so that an unresolved target cannot take all the TCPIP_IPV4_ARP_SLOTS
+#if !defined(TCPIP_IPV4_ARP_TARGET_SLOTS)
+#define TCPIP_IPV4_ARP_TARGET_SLOTS     3
+#endif
+
 
 // routing
 
@@ -67,6 +67,8 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 #define TCP_OPTIONS_END_OF_LIST     (0x00u)		// End of List TCP Option Flag
 #define TCP_OPTIONS_NO_OP           (0x01u)		// No Op TCP Option
 #define TCP_OPTIONS_MAX_SEG_SIZE    (0x02u)		// Maximum segment size TCP flag
+#define TCP_OPTIONS_SACK_PERMITTED  (0x04u)		// SACK permitted TCP option
+#define TCP_OPTIONS_SACK            (0x05u)		// SACK TCP option
 typedef struct
 {
 	uint8_t        Kind;							// Type of option
@@ -115,6 +117,14 @@ static int        tcpInitCount = 0;                 // initialization counter
 static const void*  tcpHeapH = 0;                    // memory allocation handle
 static unsigned int TcpSockets;                      // number of sockets in the current TCP configuration
 
+static TCB_STUB**   tcpConnHash = 0;                 // sockets with a remote end, indexed by remoteHash
+static TCB_STUB**   tcpListenHash = 0;               // listening sockets, indexed by localPort
+static uint16_t     tcpHashMask;                     // number of buckets - 1, for both tables
+
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+static uint32_t     tcpRxAutotuneUsed = 0;           // RX buffer growth of all sockets, out of TCPIP_TCP_AUTOTUNE_MEM_BUDGET
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
+
 static tcpipSignalHandle    tcpSignalHandle = 0;
 
 static uint16_t             tcpDefTxSize;               // default size of the TX buffer
@@ -145,6 +155,39 @@ static void _TcpSwapHeader(TCP_HEADER* header);
 static void _TcpCloseSocket(TCB_STUB* pSkt, TCPIP_TCP_SIGNAL_TYPE tcpEvent);
 static void _TcpSocketInitialize(TCB_STUB* pSkt, TCP_SOCKET hTCP, uint8_t* txBuff, uint16_t txBuffSize, uint8_t* rxBuff, uint16_t rxBuffSize);
 static void _TcpSocketSetIdleState(TCB_STUB* pSkt);
+static void _TcpSocketHashUpdate(TCB_STUB* pSkt);
+
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+static void _TcpRxAutotuneSample(TCB_STUB* pSkt);
+static void _TcpRxAutotuneApply(TCB_STUB* pSkt);
+static void _TcpRxAutotuneRelease(TCB_STUB* pSkt, bool shrink);
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
+
+static uint32_t _TcpRtoGet(TCB_STUB* pSkt);
+static void _TcpRttUpdate(TCB_STUB* pSkt, uint32_t rtt);
+static void _TcpLossRecovery(TCB_STUB* pSkt, TCP_HEADER* h, uint32_t ackNumber, bool newAck);
+static void _TcpRetransmitNext(TCB_STUB* pSkt, uint32_t sndUna);
+static void _TcpRetransmitSeg(TCB_STUB* pSkt, uint32_t seq, uint16_t len);
+
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+static uint8_t* _TcpOptionFind(TCP_HEADER* h, uint8_t kind, uint8_t* pLen);
+static uint16_t _TcpSackOptionSet(TCB_STUB* pSkt, uint8_t* pOpt);
+static void _TcpSackScoreboardUpdate(TCB_STUB* pSkt, TCP_HEADER* h, uint32_t sndUna);
+static void _TcpSackBlockAdd(TCP_SACK_BLOCK* pBlkArr, uint8_t* pnBlocks, int maxBlocks, uint32_t start, uint32_t end);
+static void _TcpRxOooMerge(TCB_STUB* pSkt);
+static void _TcpRxOooNext(TCB_STUB* pSkt);
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
+// SND.UNA: the oldest sequence number not acknowledged yet
+static __inline__ uint32_t __attribute__((always_inline)) _TcpSndUna(TCB_STUB* pSkt)
+{
+    uint32_t unacked = pSkt->txUnackedTail - pSkt->txTail;
+    if(pSkt->txUnackedTail < pSkt->txTail)
+    {
+        unacked += pSkt->txEnd - pSkt->txStart;
+    }
+    return pSkt->MySEQ - unacked;
+}
 
 #if (TCPIP_STACK_DOWN_OPERATION != 0)
 static void _TcpCleanup(void);
@@ -246,6 +289,10 @@ static uint16_t     _TCPSocketTxFreeSize(TCB_STUB* pSkt);
 
 static bool         _TCPNeedSend(TCB_STUB* pSkt);
 
+static uint16_t     _TcpTxUnsent(TCB_STUB* pSkt);
+
+static uint16_t     _TcpCorkSendLen(TCB_STUB* pSkt, uint16_t maxPayload);
+
 static void         _TCPSetHalfFlushFlag(TCB_STUB* pSkt);
 
 static bool         _TCPSetSourceAddress(TCB_STUB* pSkt, IP_ADDRESS_TYPE addType, IP_MULTI_ADDRESS* localAddress)
@@ -369,6 +416,7 @@ static void _TcpSocketSetState(TCB_STUB* pSkt, TCPIP_TCP_STATE newState)
         } 
     }
     pSkt->smState = newState;
+    _TcpSocketHashUpdate(pSkt);
 }
 
 static uint32_t    _tcpTraceMask = 0;      // currently only first 32 sockets could be traced from the creation moment
@@ -401,6 +449,7 @@ bool TCPIP_TCP_SocketTraceSet(TCP_SOCKET sktNo, bool enable)
 static __inline__ void __attribute__((always_inline)) _TcpSocketSetState(TCB_STUB* pSkt, TCPIP_TCP_STATE newState)
 {
     pSkt->smState = newState;
+    _TcpSocketHashUpdate(pSkt);
 }
 bool TCPIP_TCP_SocketTraceSet(TCP_SOCKET sktNo, bool enable)
 {
@@ -452,6 +501,9 @@ static bool TCPIP_TCP_CheckRxPkt(TCP_HEADER* pHdr)
 /*static __inline__*/static  void /*__attribute__((always_inline))*/ _TcpSocketKill(TCB_STUB* pSkt)
 {
     _TcpSocketSetState(pSkt, TCPIP_TCP_STATE_KILLED);       // trace purpose only
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+    _TcpRxAutotuneRelease(pSkt, false);
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
     
     OSAL_CRITSECT_DATA_TYPE status = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
     TCBStubs[pSkt->sktIx] = 0;
@@ -610,7 +662,7 @@ static TCPIP_MAC_PACKET* _TxSktFreeLockedV4Pkt(TCB_STUB* pSkt)
   ***************************************************************************/
 bool TCPIP_TCP_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackInit, const TCPIP_TCP_MODULE_CONFIG* pTcpInit)
 {
-    int     nSockets;
+    int     nSockets, nBkts;
     bool    tcpSemaphoreEnabled;
     bool    initRes = false;
     bool    doInit = false;
@@ -683,6 +735,20 @@ bool TCPIP_TCP_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackInit, const
         return false;
     }
 
+    // lookup tables: power of 2 number of buckets, at least one per socket
+    for(nBkts = 1; nBkts < nSockets; nBkts <<= 1);
+    tcpConnHash = (TCB_STUB**)TCPIP_HEAP_Calloc(tcpHeapH, 2 * nBkts, sizeof(*tcpConnHash));
+    if(tcpConnHash == 0)
+    {
+        SYS_ERROR(SYS_ERROR_ERROR, " TCP Dynamic allocation failed");
+        TCPIP_HEAP_Free(tcpHeapH, TCBStubs);
+        TCBStubs = 0;
+        tcpLockCount = 0; // leave it uninitialized
+        return false;
+    }
+    tcpListenHash = tcpConnHash + nBkts;
+    tcpHashMask = nBkts - 1;
+
 
     TcpSockets = nSockets;
 #if (TCPIP_TCP_QUIET_TIME != 0)
@@ -816,6 +882,8 @@ static void _TcpCleanup(void)
 
     TCPIP_HEAP_Free(tcpHeapH, TCBStubs);
     TCBStubs = 0;
+    TCPIP_HEAP_Free(tcpHeapH, tcpConnHash);
+    tcpConnHash = tcpListenHash = 0;
 
     TcpSockets = 0;
 
@@ -1426,8 +1494,8 @@ static TCP_V4_PACKET* _TcpAllocateTxPacket(TCB_STUB* pSkt, IP_ADDRESS_TYPE addTy
     // allocate IPv4 packet
     allocFlags = TCPIP_MAC_PKT_FLAG_IPV4 | TCPIP_MAC_PKT_FLAG_SPLIT | TCPIP_MAC_PKT_FLAG_TX | TCPIP_MAC_PKT_FLAG_TCP;
     // allocate from main packet pool
-    // make sure there's enough room for TCP_OPTIONS
-    pv4Pkt = (TCP_V4_PACKET*)TCPIP_PKT_SocketAlloc(sizeof(TCP_V4_PACKET), sizeof(TCP_HEADER), sizeof(TCP_OPTIONS), allocFlags);
+    // make sure there's enough room for the TCP options
+    pv4Pkt = (TCP_V4_PACKET*)TCPIP_PKT_SocketAlloc(sizeof(TCP_V4_PACKET), sizeof(TCP_HEADER), TCP_TX_OPTIONS_SIZE, allocFlags);
 
     if(pv4Pkt)
     {   // lazy linking of the data segments, when needed
@@ -1597,6 +1665,9 @@ static bool _TCPv4Flush(TCB_STUB * pSkt, IPV4_PACKET* pv4Pkt, uint16_t hdrLen, u
     checksum = ~TCPIP_Helper_CalcIPChecksum((uint8_t*)pTCPHdr, hdrLen, checksum);
     if(loadLen)
     {   // add the data segments
+        // TCPIP_TCP_ArrayPut copies the data into the TX FIFO, but unlike UDP the sum
+        // cannot be taken during that copy: the segments are cut from the FIFO here,
+        // at send time, and a retransmission cuts them differently.
         pv4Pkt->macPkt.pDSeg->segFlags |= TCPIP_MAC_SEG_FLAG_USER_PAYLOAD;
         checksum = ~TCPIP_Helper_PacketChecksum(&pv4Pkt->macPkt, ((TCP_V4_PACKET*)pv4Pkt)->tcpSeg[0].segLoad, loadLen, checksum);
     }
@@ -2328,6 +2399,13 @@ bool TCPIP_TCP_SocketInfoGet(TCP_SOCKET hTCP, TCP_SOCKET_INFO* remoteInfo)
     remoteInfo->txPending = TCPIP_TCP_FifoTxFullGet(hTCP);
     remoteInfo->flags = _TCP_SktFlagsGet(pSkt);
 
+    uint32_t tickFreq = SYS_TMR_TickCounterFrequencyGet();
+    remoteInfo->srtt = ((pSkt->srtt >> 3) * 1000) / tickFreq;
+    remoteInfo->rttVar = ((pSkt->rttVar >> 2) * 1000) / tickFreq;
+    remoteInfo->rto = (_TcpRtoGet(pSkt) * 1000) / tickFreq;
+    remoteInfo->rtoCount = pSkt->rtoCount;
+    remoteInfo->fastRtxCount = pSkt->fastRtxCount;
+
 	return true;
 }
 
@@ -2364,6 +2442,11 @@ static TCP_SOCKET_FLAGS _TCP_SktFlagsGet(TCB_STUB* pSkt)
         flags |= TCP_SOCKET_FLAG_FIN;
     }
 
+    if(pSkt->flags.sackOk)
+    {
+        flags |= TCP_SOCKET_FLAG_SACK;
+    }
+
     return flags;
 }
 
@@ -2488,6 +2571,7 @@ static uint32_t _TCP_SktSetSequenceNo(const TCB_STUB* pSkt)
 	flag.  If this function is not called, data will automatically be sent
 	when either a) the TX buffer is half full or b) the 
 	TCPIP_TCP_AUTO_TRANSMIT_TIMEOUT_VAL (default: 40ms) has elapsed.
+    For a corked socket all the data written so far is pushed out.
 
   Precondition:
 	TCP is initialized and the socket is connected.
@@ -2507,11 +2591,52 @@ bool TCPIP_TCP_Flush(TCP_SOCKET hTCP)
 
     if(pSkt && _TCP_TxPktValid(pSkt))
     {
+        // message boundary for a corked socket
+        pSkt->pushSeq = pSkt->MySEQ + _TcpTxUnsent(pSkt);
         return _TcpFlush(pSkt);
     }
     return false;
 }
 
+// returns the number of bytes in the TX buffer not sent yet
+static uint16_t _TcpTxUnsent(TCB_STUB* pSkt)
+{
+    if(pSkt->txHead >= pSkt->txUnackedTail)
+    {
+        return pSkt->txHead - pSkt->txUnackedTail;
+    }
+
+    return (pSkt->txEnd - pSkt->txUnackedTail) + (pSkt->txHead - pSkt->txStart);
+}
+
+// returns how many of the unsent bytes a socket can transmit now; 0 if all are held
+// a corked socket holds new data that's less than a full segment, unless a FIN is pending
+// or the TX buffer is full; of the data written before a flush only the bytes up to pushSeq
+// are sent, so the data written after the flush stays corked
+static uint16_t _TcpCorkSendLen(TCB_STUB* pSkt, uint16_t maxPayload)
+{
+    uint16_t unsent = _TcpTxUnsent(pSkt);
+    int32_t pushed;
+
+    if(pSkt->cork == 0 || pSkt->Flags.bTXFIN != 0 || unsent >= maxPayload || _TCPSocketTxFreeSize(pSkt) == 0)
+    {
+        return unsent;
+    }
+
+    if((int32_t)(pSkt->MySEQ - pSkt->sndMax) < 0)
+    {   // retransmission
+        return unsent;
+    }
+
+    pushed = (int32_t)(pSkt->pushSeq - pSkt->MySEQ);
+    if(pushed <= 0)
+    {   // nothing flushed
+        return 0;
+    }
+
+    return pushed < unsent ? (uint16_t)pushed : unsent;
+}
+
 static bool _TcpFlush(TCB_STUB* pSkt)
 {
     if(pSkt->txHead != pSkt->txUnackedTail && pSkt->remoteWindow != 0)
@@ -2657,7 +2782,7 @@ uint16_t TCPIP_TCP_ArrayPut(TCP_SOCKET hTCP, const uint8_t* data, uint16_t len)
     if(pSkt->txHead != pSkt->txUnackedTail)
     {   // something to send
 
-        if(pSkt->flags.halfThresFlush != 0)
+        if(pSkt->flags.halfThresFlush != 0 && pSkt->cork == 0)
         {
             if(pSkt->Flags.bHalfFullFlush == 0 && wFreeTxSpace <=  ((pSkt->txEnd - pSkt->txStart) >> 1) )
             {   // Send current payload if crossing the half buffer threshold
@@ -2684,7 +2809,8 @@ uint16_t TCPIP_TCP_ArrayPut(TCP_SOCKET hTCP, const uint8_t* data, uint16_t len)
 	// If not already enabled, start a timer so this data will 
 	// eventually get sent even if the application doens't call
 	// TCPIP_TCP_Flush()
-	else if(!pSkt->Flags.bTimer2Enabled)
+    // A corked socket waits for the flush.
+	else if(!pSkt->Flags.bTimer2Enabled && pSkt->cork == 0)
 	{
 		pSkt->Flags.bTimer2Enabled = true;
 		pSkt->eventTime2 = SYS_TMR_TickCountGet() + (TCPIP_TCP_AUTO_TRANSMIT_TIMEOUT_VAL * SYS_TMR_TickCounterFrequencyGet())/1000;
@@ -2719,7 +2845,17 @@ static bool _TCPNeedSend(TCB_STUB* pSkt)
             canSend = toSendData;
         }
 
-        if(canSend >= pSkt->wRemoteMSS || canSend >= (pSkt->maxRemoteWindow >> 1))
+        if(canSend >= pSkt->wRemoteMSS)
+        {
+            return true;
+        }
+
+        if(pSkt->cork != 0)
+        {   // partial segment; wait for the flush
+            return false;
+        }
+
+        if(canSend >= (pSkt->maxRemoteWindow >> 1))
         {
             return true;
         }
@@ -3451,6 +3587,13 @@ static void TCPIP_TCP_Tick(void)
             bRetransmit = false;
             bCloseSocket = false;
 
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+            if(pSkt->rxAutoSize != 0)
+            {   // RX buffer growth pending
+                _TcpRxAutotuneApply(pSkt);
+            }
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
+
             // Transmit ASAP data 
             if(pSkt->Flags.bTXASAP || pSkt->Flags.bTXASAPWithoutTimerReset)
             {
@@ -3705,6 +3848,16 @@ static void TCPIP_TCP_Tick(void)
                     // Set the appropriate retry time
                     pSkt->retryCount++;
                     pSkt->retryInterval <<= 1;
+                    pSkt->rtoCount++;
+
+                    // the timed segment is sent again (Karn)
+                    // and the fast recovery state is no longer valid
+                    pSkt->rttTime = 0;
+                    pSkt->flags.inRecovery = 0;
+                    pSkt->dupAcks = 0;
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                    pSkt->sackBlocks = 0;
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
 
                     // Calculate how many bytes we have to roll back and retransmit
                     w = pSkt->txUnackedTail - pSkt->txTail;
@@ -3852,8 +4005,10 @@ static TCPIP_MAC_PKT_ACK_RES TCPIP_TCP_ProcessIPv6(TCPIP_MAC_PACKET* pRxPkt)
 static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFlags)
 {
     TCP_OPTIONS     options;
+    uint8_t         optBuff[TCP_TX_OPTIONS_SIZE];
+    uint16_t        optLen;
     uint32_t 		len, lenStart, lenEnd;
-    uint16_t 		loadLen, hdrLen, maxPayload;
+    uint16_t 		loadLen, hdrLen, maxPayload, sendLen;
     void*           pSendPkt;
     uint16_t 		mss = 0;
     TCP_HEADER *    header = 0;
@@ -3933,6 +4088,7 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
 #endif  // defined (TCPIP_STACK_USE_IPV4)
 
         header->DataOffset.Val = 0;
+        optLen = 0;
 
         // Put all socket application data in the TX space
         if(vTCPFlags & (SYN | RST))
@@ -3973,30 +4129,49 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
                 options.MaxSegSize.Val = (((mss)&0x00FF)<<8) | (((mss)&0xFF00)>>8);
                 pSkt->localMSS = mss;
 
-                header->DataOffset.Val   += sizeof(options) >> 2;
+                memcpy(optBuff, &options, sizeof(options));
+                optLen = sizeof(options);
+                // The RFC 7323 timestamp option is not offered:
+                // - RTTM: one timed segment per RTT already tracks the RTT (10 ms SRTT on
+                //   the 10 ms test link, up to 5% loss) and the RTO stays at TCPIP_TCP_MIN_RTO
+                // - PAWS: the sequence space wraps in less than an MSL only above ~140 Mbit/s
+                // - every segment would carry 12 more bytes, 0.8% of a full frame
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                if(pSkt->addType == IP_ADDRESS_TYPE_IPV4 && ((vTCPFlags & ACK) == 0 || pSkt->flags.sackOk != 0))
+                {   // offer SACK in our SYN or accept it in the SYN + ACK
+                    optBuff[optLen++] = TCP_OPTIONS_NO_OP;
+                    optBuff[optLen++] = TCP_OPTIONS_NO_OP;
+                    optBuff[optLen++] = TCP_OPTIONS_SACK_PERMITTED;
+                    optBuff[optLen++] = 2;
+                }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
+                header->DataOffset.Val   += optLen >> 2;
 
 #if defined (TCPIP_STACK_USE_IPV6)
                 if(pSkt->addType == IP_ADDRESS_TYPE_IPV6)
                 {
-                    if (TCPIP_IPV6_TxIsPutReady((IPV6_PACKET*)pSendPkt, sizeof (options)) < sizeof (options))
+                    if (TCPIP_IPV6_TxIsPutReady((IPV6_PACKET*)pSendPkt, optLen) < optLen)
                     {
                         sendRes = _TCP_SEND_NO_MEMORY;
                         break;
                     }
-                    TCPIP_IPV6_PutArray((IPV6_PACKET*)pSendPkt, (uint8_t*)&options, sizeof(options));
+                    TCPIP_IPV6_PutArray((IPV6_PACKET*)pSendPkt, optBuff, optLen);
                 }
 #endif  // defined (TCPIP_STACK_USE_IPV6)
 
 #if defined (TCPIP_STACK_USE_IPV4)
                 if(pSkt->addType == IP_ADDRESS_TYPE_IPV4)
                 {
-                    memcpy(header + 1, &options, sizeof(options));
+                    memcpy(header + 1, optBuff, optLen);
                 }
 #endif  // defined (TCPIP_STACK_USE_IPV4)
 
                 if(pSkt->MySEQ == 0)
                 {   // Set Initial Sequence Number (ISN)
                     pSkt->MySEQ = _TCP_SktSetSequenceNo(pSkt);
+                    pSkt->sndMax = pSkt->MySEQ;
+                    pSkt->pushSeq = pSkt->MySEQ;
                 }
             }
         }
@@ -4004,9 +4179,16 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
         {
             // Begin copying any application data over to the TX space
             maxPayload = pSkt->wRemoteMSS;
-            if(pSkt->txHead == pSkt->txUnackedTail)
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+            if(pSkt->flags.sackOk != 0 && pSkt->sHoleSize > 0)
+            {   // report the out of order data we hold; the MSS includes the options
+                optLen = _TcpSackOptionSet(pSkt, optBuff);
+                maxPayload -= optLen;
+            }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+            if(pSkt->txHead == pSkt->txUnackedTail || (sendLen = _TcpCorkSendLen(pSkt, maxPayload)) == 0)
             {
-                // All caught up on data TX, no real data for this packet
+                // All caught up on data TX or corked partial segment, no real data for this packet
                 len = 0;
             }
             else
@@ -4036,7 +4218,7 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
 
                 if(pSkt->txHead > pSkt->txUnackedTail)
                 {
-                    len = pSkt->txHead - pSkt->txUnackedTail;
+                    len = sendLen;
                     if(len > pSkt->remoteWindow)
                     {
                         len = pSkt->remoteWindow;
@@ -4055,7 +4237,7 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
                 else
                 {
                     lenEnd = pSkt->txEnd - pSkt->txUnackedTail;
-                    len = lenEnd + pSkt->txHead - pSkt->txStart;
+                    len = sendLen;
 
                     if(len > pSkt->remoteWindow)
                         len = pSkt->remoteWindow;
@@ -4098,6 +4280,14 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
                     vTCPFlags |= FIN;
                 }
             }
+
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+            if(optLen != 0)
+            {
+                memcpy(header + 1, optBuff, optLen);
+                header->DataOffset.Val += optLen >> 2;
+            }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
         }
 
     loadLen = (uint16_t)len;  // save the TCP payload size
@@ -4121,9 +4311,18 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
             if(vSendFlags & SENDTCP_RESET_TIMERS)
             {
                 pSkt->retryCount = 0;
-                pSkt->retryInterval = (TCPIP_TCP_START_TIMEOUT_VAL * SYS_TMR_TickCounterFrequencyGet())/1000;
+                pSkt->retryInterval = _TcpRtoGet(pSkt);
             }	
 
+            if(len != 0 && pSkt->rttTime == 0 && (int32_t)(pSkt->MySEQ - pSkt->sndMax) >= 0)
+            {   // time this segment; retransmitted data is never timed (Karn)
+                pSkt->rttSeq = pSkt->MySEQ + len;
+                if((pSkt->rttTime = SYS_TMR_TickCountGet()) == 0)
+                {
+                    pSkt->rttTime = 1;
+                }
+            }
+
             pSkt->eventTime = SYS_TMR_TickCountGet() + pSkt->retryInterval;
             pSkt->Flags.bTimerEnabled = 1;
         }
@@ -4169,9 +4368,14 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
         // Update our send sequence number and ensure retransmissions 
         // of SYNs and FINs use the right sequence number
         pSkt->MySEQ += (uint32_t)len;
+        if((int32_t)(pSkt->MySEQ - pSkt->sndMax) > 0)
+        {
+            pSkt->sndMax = pSkt->MySEQ;
+        }
+
+        hdrLen = optLen;
         if(vTCPFlags & SYN)
         {
-            hdrLen = sizeof(options);
 
             // SEG.ACK needs to be zero for the first SYN packet for compatibility 
             // with certain paranoid TCP/IP stacks, even though the ACK flag isn't 
@@ -4191,10 +4395,6 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
                 pSkt->flags.bSYNSent = 1;
             }
         }
-        else
-        {
-            hdrLen = 0;
-        }
 
         if(vTCPFlags & FIN)
         {
@@ -4254,6 +4454,82 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
     return sendRes;
 }
 
+// lookup table bucket for a remoteHash/localPort key
+static __inline__ uint16_t __attribute__((always_inline)) _TcpHashBucket(uint16_t key)
+{
+    return (key ^ (key >> 8)) & tcpHashMask;
+}
+
+// moves the socket to the lookup table matching its current state:
+//  - listening sockets are indexed by localPort
+//  - sockets that have a remote end (connecting, connected, closing) by remoteHash
+//  - not opened, waiting to connect and killed sockets are not indexed
+// Has to be called whenever the state, localPort or remoteHash of the socket changes.
+// Buckets are kept in ascending sktIx order, the order in which
+// the sockets used to be scanned for a match.
+static void _TcpSocketHashUpdate(TCB_STUB* pSkt)
+{
+    TCB_STUB **ppPrev, *pCurr;
+    TCB_STUB** hashTbl;
+    TCP_HASH_TABLE newTbl;
+    uint16_t newBkt;
+
+    switch(pSkt->smState)
+    {
+        case TCPIP_TCP_STATE_LISTEN:
+            newTbl = TCP_HASH_TABLE_LISTEN;
+            newBkt = _TcpHashBucket(pSkt->localPort);
+            break;
+
+        case TCPIP_TCP_STATE_CLIENT_WAIT_CONNECT:
+        case TCPIP_TCP_STATE_KILLED:
+            newTbl = TCP_HASH_TABLE_NONE;
+            newBkt = 0;
+            break;
+
+        default:
+            newTbl = TCP_HASH_TABLE_CONN;
+            newBkt = _TcpHashBucket(pSkt->remoteHash);
+            break;
+    }
+
+    OSAL_CRITSECT_DATA_TYPE critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+    if(pSkt->hashTbl != newTbl || pSkt->hashBkt != newBkt)
+    {
+        if(pSkt->hashTbl != TCP_HASH_TABLE_NONE)
+        {   // remove from the old bucket
+            hashTbl = pSkt->hashTbl == TCP_HASH_TABLE_LISTEN ? tcpListenHash : tcpConnHash;
+            for(ppPrev = hashTbl + pSkt->hashBkt; (pCurr = *ppPrev) != 0; ppPrev = &pCurr->pHashNext)
+            {
+                if(pCurr == pSkt)
+                {
+                    *ppPrev = pSkt->pHashNext;
+                    break;
+                }
+            }
+            pSkt->pHashNext = 0;
+        }
+
+        if(newTbl != TCP_HASH_TABLE_NONE)
+        {   // insert in the new bucket
+            hashTbl = newTbl == TCP_HASH_TABLE_LISTEN ? tcpListenHash : tcpConnHash;
+            for(ppPrev = hashTbl + newBkt; (pCurr = *ppPrev) != 0; ppPrev = &pCurr->pHashNext)
+            {
+                if(pCurr->sktIx > pSkt->sktIx)
+                {
+                    break;
+                }
+            }
+            pSkt->pHashNext = pCurr;
+            *ppPrev = pSkt;
+        }
+
+        pSkt->hashTbl = newTbl;
+        pSkt->hashBkt = newBkt;
+    }
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+}
+
 /*****************************************************************************
   Function:
 	static TCB_STUB* _TcpFindMatchingSocket(TCPIP_MAC_PACKET* pRxPkt, void * remoteIP, void * localIP, IP_ADDRESS_TYPE addressType)
@@ -4262,7 +4538,7 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
 	Finds a suitable socket for a TCP segment.
 
   Description:
-	This function searches through the sockets and attempts to match one with
+	This function searches the socket lookup tables and attempts to match one with
 	a given TCP header.
     If a socket is found, a valid socket pointer it is returned. 
 	Otherwise, a 0 pointer is returned.
@@ -4282,10 +4558,11 @@ static _TCP_SEND_RES _TcpSend(TCB_STUB* pSkt, uint8_t vTCPFlags, uint8_t vSendFl
   ***************************************************************************/
 static TCB_STUB* _TcpFindMatchingSocket(TCPIP_MAC_PACKET* pRxPkt, const void * remoteIP, const void * localIP, IP_ADDRESS_TYPE addressType)
 {
-	TCP_SOCKET hTCP;
 	uint16_t hash;
     TCB_STUB* pSkt, *partialSkt;
     TCPIP_NET_IF* pPktIf;
+    bool found;
+    OSAL_CRITSECT_DATA_TYPE critStatus;
 
     TCP_HEADER* h = (TCP_HEADER*)pRxPkt->pTransportLayer;
     pPktIf = (TCPIP_NET_IF*)pRxPkt->pktIf;
@@ -4316,73 +4593,69 @@ static TCB_STUB* _TcpFindMatchingSocket(TCPIP_MAC_PACKET* pRxPkt, const void * r
             return 0;  // shouldn't happen
     }
 
-	// Loop through all sockets looking for a socket that is expecting this 
-	// packet or can handle it.
-	for(hTCP = 0; hTCP < TcpSockets; hTCP++)
+    // Look up the socket that is expecting this packet:
+    // a socket with a remote end in the remoteHash bucket
+    // or a listening socket in the local port bucket
+    found = false;
+    critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+    for(pSkt = tcpConnHash[_TcpHashBucket(hash)]; pSkt != 0; pSkt = pSkt->pHashNext)
     {
-        pSkt = TCBStubs[hTCP];
-
-        if(pSkt == 0 || pSkt->smState == TCPIP_TCP_STATE_CLIENT_WAIT_CONNECT)
-        {
+        if(pSkt->remoteHash != hash || h->DestPort != pSkt->localPort || h->SourcePort != pSkt->remotePort)
+        {   // Ignore if the hash or the ports don't match
             continue;
         }
 
-        if( (pSkt->addType == IP_ADDRESS_TYPE_ANY || pSkt->addType == addressType) &&
-                (pSkt->pSktNet == 0 || pSkt->pSktNet == pPktIf) )
-        {   // both network interface and address type match
-
-            bool found = false;
+        if( (pSkt->addType != IP_ADDRESS_TYPE_ANY && pSkt->addType != addressType) ||
+                (pSkt->pSktNet != 0 && pSkt->pSktNet != pPktIf) )
+        {   // either network interface or address type mismatch
+            continue;
+        }
 
-            if(pSkt->smState == TCPIP_TCP_STATE_LISTEN)
+#if defined (TCPIP_STACK_USE_IPV6)
+        if (addressType == IP_ADDRESS_TYPE_IPV6)
+        {
+            if (!memcmp (TCPIP_IPV6_DestAddressGet(pSkt->pV6Pkt), remoteIP, sizeof (IPV6_ADDR)))
             {
-                // For listening ports, check if this is the correct port
-                if(pSkt->remoteHash == h->DestPort && partialSkt == 0)
-                {
-                    partialSkt = pSkt;
-                }
-                continue;
-            }
-            else if(pSkt->remoteHash != hash)
-            {// Ignore if the hash doesn't match
-                continue;
+                found = true;
+                break;
             }
-
-            while(	h->DestPort == pSkt->localPort && h->SourcePort == pSkt->remotePort )  
-            {
-
-#if defined (TCPIP_STACK_USE_IPV6)
-                if (addressType == IP_ADDRESS_TYPE_IPV6)
-                {
-                    if (!memcmp (TCPIP_IPV6_DestAddressGet(pSkt->pV6Pkt), remoteIP, sizeof (IPV6_ADDR)))
-                    {
-                        found = true;
-                    }
-                    break;
-                }
+        }
 #endif  // defined (TCPIP_STACK_USE_IPV6)
 
 #if defined (TCPIP_STACK_USE_IPV4)
-                if (addressType == IP_ADDRESS_TYPE_IPV4)
-                {
-                    if (pSkt->destAddress.Val == ((IPV4_ADDR *)remoteIP)->Val)
-                    {
-                        found = true;
-                    }
-                    break;
-                }
-#endif  // defined (TCPIP_STACK_USE_IPV4)
-
+        if (addressType == IP_ADDRESS_TYPE_IPV4)
+        {
+            if (pSkt->destAddress.Val == ((IPV4_ADDR *)remoteIP)->Val)
+            {
+                found = true;
                 break;
             }
+        }
+#endif  // defined (TCPIP_STACK_USE_IPV4)
+    }
 
-            if(found)
-            { 
-                pSkt->addType = addressType;
-                _TcpSocketBind(pSkt, pPktIf, (IP_MULTI_ADDRESS*)localIP);
-                return pSkt;    // bind to the correct interface
+    if(!found)
+    {
+        for(pSkt = tcpListenHash[_TcpHashBucket(h->DestPort)]; pSkt != 0; pSkt = pSkt->pHashNext)
+        {
+            // For listening ports, check if this is the correct port
+            if(pSkt->remoteHash == h->DestPort &&
+                    (pSkt->addType == IP_ADDRESS_TYPE_ANY || pSkt->addType == addressType) &&
+                    (pSkt->pSktNet == 0 || pSkt->pSktNet == pPktIf) )
+            {
+                partialSkt = pSkt;
+                break;
             }
         }
     }
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+
+    if(found)
+    { 
+        pSkt->addType = addressType;
+        _TcpSocketBind(pSkt, pPktIf, (IP_MULTI_ADDRESS*)localIP);
+        return pSkt;    // bind to the correct interface
+    }
 
 
 	// If there is a partial match, then a listening socket is currently 
@@ -4490,6 +4763,12 @@ static void _TcpSocketInitialize(TCB_STUB* pSkt, TCP_SOCKET hTCP, uint8_t* txBuf
     // option is received from remote node)
     pSkt->wRemoteMSS = TCP_MIN_DEFAULT_MTU;
 
+    pSkt->delayedAckTmo = TCPIP_TCP_DELAYED_ACK_TIMEOUT;
+
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+    pSkt->rxAutotune = 1;
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
+
     TCBStubs[hTCP] = pSkt;  // store it
     
 }
@@ -4520,12 +4799,29 @@ static void _TcpSocketSetIdleState(TCB_STUB* pSkt)
 	pSkt->flags.bFINSent = 0;
     pSkt->flags.seqInc = 0;
 	pSkt->flags.bSYNSent = 0;
-	pSkt->flags.bRXNoneACKed1 = 0;
-	pSkt->flags.bRXNoneACKed2 = 0;
+    pSkt->flags.sackOk = 0;
+    pSkt->flags.inRecovery = 0;
     pSkt->MySEQ = 0;
 	pSkt->sHoleSize = -1;
 	pSkt->remoteWindow = 1;
     pSkt->maxRemoteWindow = 1;
+    pSkt->rttTime = 0;
+    pSkt->srtt = 0;
+    pSkt->rttVar = 0;
+    pSkt->rtoCount = 0;
+    pSkt->fastRtxCount = 0;
+    pSkt->dupAcks = 0;
+    pSkt->quickAcks = 0;
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+    pSkt->sackBlocks = 0;
+    pSkt->rxOooBlocks = 0;
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+    pSkt->rcvRttTime = 0;
+    pSkt->rcvRtt = 0;
+    pSkt->rcvSpaceTime = 0;
+    pSkt->rxAutoSize = 0;
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
 
 
     // Note : no result of the explicit binding is maintained!
@@ -4661,6 +4957,10 @@ static void _TcpCloseSocket(TCB_STUB* pSkt, TCPIP_TCP_SIGNAL_TYPE tcpEvent)
     }
     else
     {
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+        // back to the original RX buffer for the next connection
+        _TcpRxAutotuneRelease(pSkt, true);
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
         _TcpSocketSetIdleState(pSkt);
         _TcpSocketSetState(pSkt, TCPIP_TCP_STATE_LISTEN);
     }
@@ -4766,6 +5066,460 @@ static uint16_t _GetMaxSegSizeOption(TCP_HEADER* h)
     return TCP_MIN_DEFAULT_MTU;
 }
 
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+// returns the option of the requested kind in the TCP header, 0 if not present
+// pLen receives the option length, including the kind and length bytes
+static uint8_t* _TcpOptionFind(TCP_HEADER* h, uint8_t kind, uint8_t* pLen)
+{
+    uint8_t optLen;
+    uint8_t* pOption = (uint8_t*)(h + 1);
+    uint8_t* pEnd = pOption + (h->DataOffset.Val << 2) - sizeof(*h);
+
+    while(pOption < pEnd)
+    {
+        if(*pOption == TCP_OPTIONS_END_OF_LIST)
+        {
+            break;
+        }
+
+        if(*pOption == TCP_OPTIONS_NO_OP)
+        {
+            pOption++;
+            continue;
+        }
+
+        if(pOption + 1 >= pEnd || (optLen = pOption[1]) < 2 || pOption + optLen > pEnd)
+        {   // malformed
+            break;
+        }
+
+        if(*pOption == kind)
+        {
+            *pLen = optLen;
+            return pOption;
+        }
+
+        pOption += optLen;
+    }
+
+    return 0;
+}
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
+// current retransmission timeout, ticks
+static uint32_t _TcpRtoGet(TCB_STUB* pSkt)
+{
+    if(pSkt->srtt == 0)
+    {   // no RTT measurement yet
+        return (TCPIP_TCP_START_TIMEOUT_VAL * SYS_TMR_TickCounterFrequencyGet()) / 1000;
+    }
+
+    return pSkt->rto;
+}
+
+// updates the RTT estimates with a new sample and computes the RTO, RFC 6298
+// srtt is kept scaled by 8, rttVar by 4
+static void _TcpRttUpdate(TCB_STUB* pSkt, uint32_t rtt)
+{
+    int32_t delta;
+    uint32_t tickFreq, minRto, maxRto;
+
+    if(rtt == 0)
+    {
+        rtt = 1;
+    }
+
+    if(pSkt->srtt == 0)
+    {   // first measurement
+        pSkt->srtt = rtt << 3;
+        pSkt->rttVar = rtt << 1;
+    }
+    else
+    {
+        delta = (int32_t)rtt - (int32_t)(pSkt->srtt >> 3);
+        pSkt->srtt += delta;
+        if(delta < 0)
+        {
+            delta = -delta;
+        }
+        pSkt->rttVar += delta - (pSkt->rttVar >> 2);
+    }
+
+    tickFreq = SYS_TMR_TickCounterFrequencyGet();
+    minRto = (TCPIP_TCP_MIN_RTO * tickFreq) / 1000;
+    maxRto = (TCP_MAX_RTO / 1000) * tickFreq;
+
+    pSkt->rto = (pSkt->srtt >> 3) + (pSkt->rttVar != 0 ? pSkt->rttVar : 1);
+    if(pSkt->rto < minRto)
+    {
+        pSkt->rto = minRto;
+    }
+    else if(pSkt->rto > maxRto)
+    {
+        pSkt->rto = maxRto;
+    }
+}
+
+// fast retransmit and recovery
+// Called for each ACK that acknowledges new data (newAck == true) or
+// for a duplicate ACK, after the acknowledged data was discarded.
+// TCP_DUP_ACK_THRESHOLD duplicate ACKs start a recovery: the first
+// unacknowledged segment is retransmitted, the rest of the data in flight
+// is not rolled back.
+// Without SACK each partial ACK retransmits the next segment (RFC 6582).
+// With SACK every hole between the SACKed ranges is retransmitted,
+// one segment per incoming ACK (RFC 6675).
+// The recovery ends when all the data sent before it started is acknowledged.
+static void _TcpLossRecovery(TCB_STUB* pSkt, TCP_HEADER* h, uint32_t ackNumber, bool newAck)
+{
+    uint32_t sndUna = _TcpSndUna(pSkt);
+
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+    if(pSkt->flags.sackOk != 0)
+    {
+        _TcpSackScoreboardUpdate(pSkt, h, sndUna);
+    }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
+    if(newAck)
+    {
+        pSkt->dupAcks = 0;
+        if(pSkt->flags.inRecovery == 0)
+        {
+            return;
+        }
+
+        if((int32_t)(ackNumber - pSkt->recoverSeq) >= 0)
+        {   // all lost data recovered
+            pSkt->flags.inRecovery = 0;
+            return;
+        }
+
+        // partial ACK: the next hole starts at the new SND.UNA
+        if(pSkt->flags.sackOk == 0 || (int32_t)(pSkt->rtxHighSeq - sndUna) < 0)
+        {
+            pSkt->rtxHighSeq = sndUna;
+        }
+        _TcpRetransmitNext(pSkt, sndUna);
+        return;
+    }
+
+    // duplicate ACK
+    if(pSkt->dupAcks != 0xff)
+    {
+        pSkt->dupAcks++;
+    }
+
+    if(pSkt->flags.inRecovery == 0)
+    {
+        if(pSkt->dupAcks >= TCP_DUP_ACK_THRESHOLD)
+        {
+            pSkt->flags.inRecovery = 1;
+            pSkt->recoverSeq = pSkt->sndMax;
+            pSkt->rtxHighSeq = sndUna;
+            _TcpRetransmitNext(pSkt, sndUna);
+        }
+    }
+    else if(pSkt->flags.sackOk != 0)
+    {   // each SACK carries new information about the holes
+        _TcpRetransmitNext(pSkt, sndUna);
+    }
+}
+
+// retransmits the next segment known to be lost, if any
+// and advances the recovery retransmission point
+static void _TcpRetransmitNext(TCB_STUB* pSkt, uint32_t sndUna)
+{
+    uint32_t seq, holeEnd, segLen;
+    uint16_t mss;
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+    int ix;
+    TCP_SACK_BLOCK* pBlk;
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
+    seq = (int32_t)(pSkt->rtxHighSeq - sndUna) > 0 ? pSkt->rtxHighSeq : sndUna;
+    holeEnd = pSkt->MySEQ;
+
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+    if(pSkt->flags.sackOk != 0)
+    {   // find the next hole above seq
+        for(ix = 0, pBlk = pSkt->sackBlk; ix < pSkt->sackBlocks; ix++, pBlk++)
+        {
+            if((int32_t)(seq - pBlk->start) < 0)
+            {
+                holeEnd = pBlk->start;
+                break;
+            }
+
+            if((int32_t)(seq - pBlk->end) < 0)
+            {   // already received
+                seq = pBlk->end;
+            }
+        }
+
+        if(ix == pSkt->sackBlocks && seq != sndUna)
+        {   // nothing is known to be lost above the highest SACKed range
+            return;
+        }
+    }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
+    if((int32_t)(holeEnd - seq) <= 0)
+    {
+        return;
+    }
+
+    segLen = holeEnd - seq;
+    mss = pSkt->wRemoteMSS < pSkt->localMSS ? pSkt->wRemoteMSS : pSkt->localMSS;
+    if(segLen > mss)
+    {
+        segLen = mss;
+    }
+
+    _TcpRetransmitSeg(pSkt, seq, segLen);
+    pSkt->rtxHighSeq = seq + segLen;
+}
+
+// retransmits len bytes starting at the already sent sequence number seq
+// The socket TX state is restored afterwards, so the transmission
+// of the new data continues where it was.
+static void _TcpRetransmitSeg(TCB_STUB* pSkt, uint32_t seq, uint16_t len)
+{
+    uint32_t saveSeq = pSkt->MySEQ;
+    uint8_t* saveUnackedTail = pSkt->txUnackedTail;
+    uint16_t saveWindow = pSkt->remoteWindow;
+    uint8_t saveTxAsap = pSkt->Flags.bTXASAP;
+    uint8_t saveTxAsapNoReset = pSkt->Flags.bTXASAPWithoutTimerReset;
+
+    pSkt->txUnackedTail = pSkt->txTail + (seq - _TcpSndUna(pSkt));
+    if(pSkt->txUnackedTail >= pSkt->txEnd)
+    {
+        pSkt->txUnackedTail -= pSkt->txEnd - pSkt->txStart;
+    }
+    pSkt->MySEQ = seq;
+    pSkt->remoteWindow = len;   // send exactly this segment
+
+    if(_TcpSend(pSkt, ACK, 0) == _TCP_SEND_OK)
+    {
+        pSkt->fastRtxCount++;
+    }
+    // the timed segment could be the one retransmitted (Karn)
+    pSkt->rttTime = 0;
+
+    pSkt->MySEQ = saveSeq;
+    pSkt->txUnackedTail = saveUnackedTail;
+    pSkt->remoteWindow = saveWindow;
+    // new data waiting to go out is not affected
+    pSkt->Flags.bTXASAP = saveTxAsap;
+    pSkt->Flags.bTXASAPWithoutTimerReset = saveTxAsapNoReset;
+}
+
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+// builds the SACK option reporting the out of order data in the RX buffer
+// The range holding the latest out of order segment goes first (RFC 2018),
+// the other ranges follow in ascending order.
+// Returns the option size
+static uint16_t _TcpSackOptionSet(TCB_STUB* pSkt, uint8_t* pOpt)
+{
+    TCP_SACK_BLOCK blk[TCP_SACK_RX_BLOCKS];
+    TCP_SACK_BLOCK* pBlk;
+    uint32_t blkEdge;
+    int ix, nBlocks, first;
+
+    blk[0].start = pSkt->RemoteSEQ + pSkt->sHoleSize;
+    blk[0].end = blk[0].start + pSkt->wFutureDataSize;
+    for(ix = 0; ix < pSkt->rxOooBlocks; ix++)
+    {
+        blk[ix + 1] = pSkt->rxOooBlk[ix];
+    }
+    nBlocks = pSkt->rxOooBlocks + 1;
+
+    for(first = nBlocks - 1; first > 0; first--)
+    {
+        if((int32_t)(pSkt->rxOooLastSeq - blk[first].start) >= 0 && (int32_t)(pSkt->rxOooLastSeq - blk[first].end) < 0)
+        {
+            break;
+        }
+    }
+
+    pOpt[0] = TCP_OPTIONS_NO_OP;
+    pOpt[1] = TCP_OPTIONS_NO_OP;
+    pOpt[2] = TCP_OPTIONS_SACK;
+    pOpt[3] = 2 + 8 * nBlocks;
+    for(ix = 0; ix < nBlocks; ix++)
+    {
+        pBlk = ix == 0 ? blk + first : blk + (ix <= first ? ix - 1 : ix);
+        blkEdge = TCPIP_Helper_htonl(pBlk->start);
+        memcpy(pOpt + 4 + 8 * ix, &blkEdge, sizeof(blkEdge));
+        blkEdge = TCPIP_Helper_htonl(pBlk->end);
+        memcpy(pOpt + 8 + 8 * ix, &blkEdge, sizeof(blkEdge));
+    }
+
+    return 4 + 8 * nBlocks;
+}
+
+// the first out of order range (sHoleSize, wFutureDataSize) grew:
+// absorbs the ranges it now reaches
+static void _TcpRxOooMerge(TCB_STUB* pSkt)
+{
+    uint32_t start = pSkt->RemoteSEQ + pSkt->sHoleSize;
+    uint32_t end = start + pSkt->wFutureDataSize;
+    int nMerged;
+
+    for(nMerged = 0; nMerged < pSkt->rxOooBlocks && (int32_t)(pSkt->rxOooBlk[nMerged].start - end) <= 0; nMerged++)
+    {
+        if((int32_t)(pSkt->rxOooBlk[nMerged].end - end) > 0)
+        {
+            end = pSkt->rxOooBlk[nMerged].end;
+        }
+    }
+
+    if(nMerged != 0)
+    {
+        pSkt->wFutureDataSize = end - start;
+        pSkt->rxOooBlocks -= nMerged;
+        memmove(pSkt->rxOooBlk, pSkt->rxOooBlk + nMerged, pSkt->rxOooBlocks * sizeof(*pSkt->rxOooBlk));
+    }
+}
+
+// the hole below the first out of order range is filled:
+// the ranges that the in order data now reaches are added to it,
+// the next range above a hole becomes the first one
+static void _TcpRxOooNext(TCB_STUB* pSkt)
+{
+    TCP_SACK_BLOCK* pBlk;
+    uint32_t inOrder;
+
+    while(pSkt->sHoleSize == -1 && pSkt->rxOooBlocks != 0)
+    {
+        pBlk = pSkt->rxOooBlk;
+        if((int32_t)(pBlk->start - pSkt->RemoteSEQ) > 0)
+        {
+            pSkt->sHoleSize = pBlk->start - pSkt->RemoteSEQ;
+            pSkt->wFutureDataSize = pBlk->end - pBlk->start;
+        }
+        else if((int32_t)(pBlk->end - pSkt->RemoteSEQ) > 0)
+        {
+            inOrder = pBlk->end - pSkt->RemoteSEQ;
+            pSkt->RemoteSEQ += inOrder;
+            pSkt->rxHead += inOrder;
+            if(pSkt->rxHead > pSkt->rxEnd)
+            {
+                pSkt->rxHead -= pSkt->rxEnd - pSkt->rxStart + 1;
+            }
+        }
+
+        pSkt->rxOooBlocks--;
+        memmove(pSkt->rxOooBlk, pSkt->rxOooBlk + 1, pSkt->rxOooBlocks * sizeof(*pSkt->rxOooBlk));
+    }
+}
+
+// updates the SACK scoreboard with the ranges reported by an incoming ACK
+// and discards what's below SND.UNA
+static void _TcpSackScoreboardUpdate(TCB_STUB* pSkt, TCP_HEADER* h, uint32_t sndUna)
+{
+    int ix, jx;
+    uint8_t optLen;
+    uint8_t* pOpt;
+    uint32_t start, end;
+    TCP_SACK_BLOCK* pBlk;
+
+    for(ix = 0, jx = 0, pBlk = pSkt->sackBlk; ix < pSkt->sackBlocks; ix++, pBlk++)
+    {
+        if((int32_t)(pBlk->end - sndUna) <= 0)
+        {   // acknowledged
+            continue;
+        }
+        if((int32_t)(pBlk->start - sndUna) < 0)
+        {
+            pBlk->start = sndUna;
+        }
+        pSkt->sackBlk[jx++] = *pBlk;
+    }
+    pSkt->sackBlocks = jx;
+
+    if((pOpt = _TcpOptionFind(h, TCP_OPTIONS_SACK, &optLen)) == 0)
+    {
+        return;
+    }
+
+    for(pOpt += 2, optLen -= 2; optLen >= 8; pOpt += 8, optLen -= 8)
+    {
+        memcpy(&start, pOpt, sizeof(start));
+        memcpy(&end, pOpt + 4, sizeof(end));
+        start = TCPIP_Helper_ntohl(start);
+        end = TCPIP_Helper_ntohl(end);
+
+        // ignore ranges below SND.UNA (D-SACK) or not sent yet
+        if((int32_t)(end - start) > 0 && (int32_t)(start - sndUna) > 0 && (int32_t)(end - pSkt->sndMax) <= 0)
+        {
+            _TcpSackBlockAdd(pSkt->sackBlk, &pSkt->sackBlocks, TCP_SACK_SCOREBOARD_BLOCKS, start, end);
+        }
+    }
+}
+
+// adds a range to an ascending array of ranges: the sender scoreboard or the receiver out of order ranges
+// Overlapping and adjacent ranges are merged; when the array is full the highest range is dropped
+static void _TcpSackBlockAdd(TCP_SACK_BLOCK* pBlkArr, uint8_t* pnBlocks, int maxBlocks, uint32_t start, uint32_t end)
+{
+    int ix, jx;
+    int nBlocks = *pnBlocks;
+    TCP_SACK_BLOCK* pBlk;
+
+    for(ix = 0; ix < nBlocks; )
+    {
+        pBlk = pBlkArr + ix;
+        if((int32_t)(pBlk->end - start) < 0 || (int32_t)(end - pBlk->start) < 0)
+        {   // disjoint
+            ix++;
+            continue;
+        }
+
+        // merge it into the new range and remove it
+        if((int32_t)(pBlk->start - start) < 0)
+        {
+            start = pBlk->start;
+        }
+        if((int32_t)(pBlk->end - end) > 0)
+        {
+            end = pBlk->end;
+        }
+        for(jx = ix; jx < nBlocks - 1; jx++)
+        {
+            pBlkArr[jx] = pBlkArr[jx + 1];
+        }
+        nBlocks--;
+    }
+
+    for(ix = 0; ix < nBlocks; ix++)
+    {
+        if((int32_t)(start - pBlkArr[ix].start) < 0)
+        {
+            break;
+        }
+    }
+
+    if(ix == maxBlocks)
+    {   // full and above all the others
+        *pnBlocks = nBlocks;
+        return;
+    }
+
+    if(nBlocks == maxBlocks)
+    {
+        nBlocks--;
+    }
+
+    for(jx = nBlocks; jx > ix; jx--)
+    {
+        pBlkArr[jx] = pBlkArr[jx - 1];
+    }
+    pBlkArr[ix].start = start;
+    pBlkArr[ix].end = end;
+    *pnBlocks = nBlocks + 1;
+}
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
 static void _TCPSetHalfFlushFlag(TCB_STUB* pSkt)
 {
     bool    clrFlushFlag = false;
@@ -4837,6 +5591,10 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
     uint8_t* pSegSrc;
     uint16_t nCopiedBytes;
     uint8_t* newRxHead;
+    bool rxHole;
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+    uint8_t optLen;
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
 
 
      
@@ -4889,6 +5647,9 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
                 // Set MSS option
                 pSkt->wRemoteMSS = _GetMaxSegSizeOption(h);
                 _TCPSetHalfFlushFlag(pSkt);
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                pSkt->flags.sackOk = (pSkt->addType == IP_ADDRESS_TYPE_IPV4 && _TcpOptionFind(h, TCP_OPTIONS_SACK_PERMITTED, &optLen) != 0) ? 1 : 0;
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
 
                 // Respond with SYN + ACK
                 _TcpSend(pSkt, SYN | ACK, SENDTCP_RESET_TIMERS);
@@ -4949,6 +5710,10 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
                 // Set MSS option
                 pSkt->wRemoteMSS = _GetMaxSegSizeOption(h);
                 _TCPSetHalfFlushFlag(pSkt);
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                // we offered SACK in our SYN
+                pSkt->flags.sackOk = (pSkt->addType == IP_ADDRESS_TYPE_IPV4 && _TcpOptionFind(h, TCP_OPTIONS_SACK_PERMITTED, &optLen) != 0) ? 1 : 0;
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
 
                 if(localHeaderFlags & ACK)
                 {
@@ -5158,10 +5923,14 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
             dwTemp = localAckNumber - dwTemp;
             if(((int32_t)(dwTemp) > 0) && (dwTemp <= pSkt->txEnd - pSkt->txStart))
             {
-                pSkt->flags.bRXNoneACKed1 = 0;
-                pSkt->flags.bRXNoneACKed2 = 0;
                 pSkt->Flags.bHalfFullFlush = false;
 
+                if(pSkt->rttTime != 0 && (int32_t)(localAckNumber - pSkt->rttSeq) >= 0)
+                {   // the timed segment is acknowledged
+                    _TcpRttUpdate(pSkt, SYS_TMR_TickCountGet() - pSkt->rttTime);
+                    pSkt->rttTime = 0;
+                }
+
                 // Bytes ACKed, free up the TX FIFO space
                 ptrTemp = pSkt->txTail;
                 pSkt->txTail += dwTemp;
@@ -5191,6 +5960,21 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
                     pSkt->txUnackedTail -= pSkt->txEnd - pSkt->txStart;
                 }
 
+                if(pSkt->Flags.bTimerEnabled)
+                {   // progress: restart the retransmission timer for the data still in flight
+                    pSkt->retryCount = 0;
+                    pSkt->retryInterval = _TcpRtoGet(pSkt);
+                    pSkt->eventTime = SYS_TMR_TickCountGet() + pSkt->retryInterval;
+                }
+
+                _TcpLossRecovery(pSkt, h, localAckNumber, true);
+
+                if(pSkt->txTail == pSkt->txUnackedTail && pSkt->txHead != pSkt->txUnackedTail && pSkt->Flags.bTimer2Enabled)
+                {   // all sent data is acknowledged: the data held back by Nagle goes out now,
+                    // not when the auto-transmit timer expires
+                    pSkt->Flags.bTXASAP = 1;
+                }
+
                 if(pSkt->smState == TCPIP_TCP_STATE_ESTABLISHED || pSkt->smState == TCPIP_TCP_STATE_CLOSE_WAIT)
                 {
                     *pSktEvent |= TCPIP_TCP_SIGNAL_TX_SPACE; 
@@ -5198,26 +5982,10 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
             }
             else
             {   // no acknowledge
-                // See if we have outstanding TX data that is waiting for an ACK
-                if(pSkt->txTail != pSkt->txUnackedTail)
+                // A pure ACK while we have outstanding TX data is a duplicate ACK
+                if(pSkt->txTail != pSkt->txUnackedTail && len == 0 && (localHeaderFlags & FIN) == 0)
                 {
-                    if(pSkt->flags.bRXNoneACKed1)
-                    {
-                        if(pSkt->flags.bRXNoneACKed2)
-                        {
-                            // Set up to perform a fast retransmission
-                            // Roll back unacknowledged TX tail pointer to cause retransmit to occur
-                            pSkt->MySEQ -= (pSkt->txUnackedTail - pSkt->txTail);
-                            if(pSkt->txUnackedTail < pSkt->txTail)
-                            {
-                                pSkt->MySEQ -= (pSkt->txEnd - pSkt->txStart);
-                            }
-                            pSkt->txUnackedTail = pSkt->txTail;
-                            pSkt->Flags.bTXASAPWithoutTimerReset = 1;
-                        }
-                        pSkt->flags.bRXNoneACKed2 = 1;
-                    }
-                    pSkt->flags.bRXNoneACKed1 = 1;
+                    _TcpLossRecovery(pSkt, h, localAckNumber, false);
                 }
             }
 
@@ -5324,6 +6092,9 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
         return;
     }
 
+    // out of order data already in the RX FIFO
+    rxHole = pSkt->sHoleSize != -1;
+
     // Copy any valid segment data into our RX FIFO, if any
     if(len)
     {
@@ -5391,7 +6162,13 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
                         }
                         pSkt->sHoleSize = -1;
                     }
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                    _TcpRxOooNext(pSkt);
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
                 }
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+                _TcpRxAutotuneSample(pSkt);
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
             }
         } 
         else if(wMissingBytes > 0)
@@ -5442,6 +6219,12 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
                     {
                         if((wMissingBytes + len > (uint32_t)pSkt->sHoleSize + pSkt->wFutureDataSize) || (wMissingBytes + len < (uint32_t)pSkt->sHoleSize))
                         {
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                            if(wMissingBytes + len < (uint32_t)pSkt->sHoleSize)
+                            {   // a new hole below: the current range moves up the list
+                                _TcpSackBlockAdd(pSkt->rxOooBlk, &pSkt->rxOooBlocks, TCP_SACK_RX_BLOCKS - 1, pSkt->RemoteSEQ + pSkt->sHoleSize, pSkt->RemoteSEQ + pSkt->sHoleSize + pSkt->wFutureDataSize);
+                            }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
                             pSkt->wFutureDataSize = len;
                         }
                         else
@@ -5458,9 +6241,20 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
                         {
                             pSkt->wFutureDataSize += wMissingBytes + len - (uint32_t)pSkt->sHoleSize - pSkt->wFutureDataSize;
                         }
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                        else
+                        {   // there is: keep track of the range above it
+                            _TcpSackBlockAdd(pSkt->rxOooBlk, &pSkt->rxOooBlocks, TCP_SACK_RX_BLOCKS - 1, pSkt->RemoteSEQ + wMissingBytes, pSkt->RemoteSEQ + wMissingBytes + len);
+                        }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
                     }
-
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                    _TcpRxOooMerge(pSkt);
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
                 }
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                pSkt->rxOooLastSeq = pSkt->RemoteSEQ + wMissingBytes;
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
             }
         }
     }
@@ -5482,8 +6276,14 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
             pSkt->rxTail = pSkt->rxHead;
         }
 
-        if(pSkt->Flags.bOneSegmentReceived)
+        // Out of order data and data filling a hole are acknowledged immediately:
+        // the duplicate ACKs trigger the fast retransmit in the remote party
+        if(pSkt->Flags.bOneSegmentReceived || rxHole || pSkt->sHoleSize != -1 || pSkt->quickAcks != 0 || pSkt->delayedAckTmo == 0)
         {
+            if(pSkt->quickAcks != 0)
+            {
+                pSkt->quickAcks--;
+            }
             _TcpSend(pSkt, ACK, SENDTCP_RESET_TIMERS);
             // bOneSegmentReceived is cleared in _TcpSend(pSkt, ), so no need here
         }
@@ -5497,7 +6297,7 @@ static void _TcpHandleSeg(TCB_STUB* pSkt, TCP_HEADER* h, uint16_t tcpLen, TCPIP_
             if(!pSkt->Flags.bDelayedACKTimerEnabled)
             {
                 pSkt->Flags.bDelayedACKTimerEnabled = 1;
-                pSkt->delayedACKTime = SYS_TMR_TickCountGet() + (TCPIP_TCP_DELAYED_ACK_TIMEOUT * SYS_TMR_TickCounterFrequencyGet())/1000;
+                pSkt->delayedACKTime = SYS_TMR_TickCountGet() + (pSkt->delayedAckTmo * SYS_TMR_TickCounterFrequencyGet())/1000;
 
             }
         }
@@ -5865,6 +6665,12 @@ bool TCPIP_TCP_FifoSizeAdjust(TCP_SOCKET hTCP, uint16_t wMinRXSize, uint16_t wMi
             if(pSkt->sHoleSize != -1)
             {
                 rxHead += pSkt->sHoleSize + pSkt->wFutureDataSize;
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+                if(pSkt->rxOooBlocks != 0)
+                {   // up to the last out of order range
+                    rxHead = pSkt->rxHead + (pSkt->rxOooBlk[pSkt->rxOooBlocks - 1].end - pSkt->RemoteSEQ);
+                }
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
                 if(rxHead > pSkt->rxEnd)
                 {
                     rxHead -= pSkt->rxEnd - pSkt->rxStart + 1;
@@ -5952,6 +6758,139 @@ bool TCPIP_TCP_FifoSizeAdjust(TCP_SOCKET hTCP, uint16_t wMinRXSize, uint16_t wMi
 }
 #endif  // (TCPIP_TCP_DYNAMIC_OPTIONS != 0)
 
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+// RX buffer autotuning, called when new in order data was added to the RX buffer
+// Without the timestamps option the receive RTT is estimated as the time it takes
+// for one advertised window of data to arrive.
+// Once per RTT the amount of received data is checked: if the remote party
+// sent at least half of the RX buffer in one RTT, the window is what limits
+// the transfer and a larger RX buffer is requested.
+// The received amount is bounded by how fast the user drains the buffer,
+// so a slow reader never grows its buffer.
+static void _TcpRxAutotuneSample(TCB_STUB* pSkt)
+{
+    uint32_t now, sample, rcvd, rxSize, newSize;
+
+    if(pSkt->rxAutotune == 0)
+    {
+        return;
+    }
+
+    if((now = SYS_TMR_TickCountGet()) == 0)
+    {   // 0 means no measurement in progress
+        now = 1;
+    }
+
+    if(pSkt->rcvRttTime != 0 && (int32_t)(pSkt->RemoteSEQ - pSkt->rcvRttSeq) >= 0)
+    {   // a full window received; new RTT sample
+        if((sample = now - pSkt->rcvRttTime) == 0)
+        {
+            sample = 1;
+        }
+        pSkt->rcvRtt = pSkt->rcvRtt == 0 ? sample : (pSkt->rcvRtt * 7 + sample) >> 3;
+        pSkt->rcvRttTime = 0;
+    }
+
+    if(pSkt->rcvRttTime == 0)
+    {   // start a new measurement
+        pSkt->rcvRttSeq = pSkt->RemoteSEQ + pSkt->localWindow;
+        pSkt->rcvRttTime = now;
+    }
+
+    if(pSkt->rcvSpaceTime == 0)
+    {   // start the first interval
+        pSkt->rcvSpaceSeq = pSkt->RemoteSEQ;
+        pSkt->rcvSpaceTime = now;
+        return;
+    }
+
+    if(pSkt->rcvRtt == 0 || (now - pSkt->rcvSpaceTime) < pSkt->rcvRtt)
+    {   // not a full RTT yet
+        return;
+    }
+
+    rcvd = pSkt->RemoteSEQ - pSkt->rcvSpaceSeq;
+    pSkt->rcvSpaceSeq = pSkt->RemoteSEQ;
+    pSkt->rcvSpaceTime = now;
+
+    rxSize = pSkt->rxEnd - pSkt->rxStart;
+    if(rcvd * 2 < rxSize || rxSize >= TCPIP_TCP_AUTOTUNE_MAX_RX_SIZE)
+    {   // not window limited or already at max
+        return;
+    }
+
+    newSize = rxSize * 2;
+    if(newSize > TCPIP_TCP_AUTOTUNE_MAX_RX_SIZE)
+    {
+        newSize = TCPIP_TCP_AUTOTUNE_MAX_RX_SIZE;
+    }
+
+    if(newSize > pSkt->rxAutoSize)
+    {   // applied by the TCP task when the buffer is drained
+        pSkt->rxAutoSize = newSize;
+    }
+}
+
+// grows the RX buffer to the requested size, within the global budget
+// The buffer is reallocated only when it is empty, so no user read
+// can be in progress on the old buffer.
+static void _TcpRxAutotuneApply(TCB_STUB* pSkt)
+{
+    uint32_t rxSize, growth;
+
+    if(pSkt->rxHead != pSkt->rxTail || pSkt->sHoleSize != -1)
+    {   // wait for the user to drain it
+        return;
+    }
+
+    rxSize = pSkt->rxEnd - pSkt->rxStart;
+    growth = pSkt->rxAutoSize > rxSize ? pSkt->rxAutoSize - rxSize : 0;
+    pSkt->rxAutoSize = 0;
+
+    if(growth > TCPIP_TCP_AUTOTUNE_MEM_BUDGET - tcpRxAutotuneUsed)
+    {
+        growth = TCPIP_TCP_AUTOTUNE_MEM_BUDGET - tcpRxAutotuneUsed;
+    }
+
+    if(growth < TCP_MIN_BUFF_CHANGE)
+    {   // no change or out of budget
+        return;
+    }
+
+    if(TCPIP_TCP_FifoSizeAdjust(pSkt->sktIx, rxSize + growth, 0, TCP_ADJUST_RX_ONLY | TCP_ADJUST_PRESERVE_RX))
+    {   // window update already sent
+        tcpRxAutotuneUsed += growth;
+        pSkt->rxAutoGrowth += growth;
+    }
+}
+
+// returns the socket RX buffer growth to the budget
+// shrink: restore the RX buffer to its size before the autotuning
+static void _TcpRxAutotuneRelease(TCB_STUB* pSkt, bool shrink)
+{
+    uint16_t rxSize;
+    uint16_t growth = pSkt->rxAutoGrowth;
+
+    pSkt->rxAutoSize = 0;
+    if(growth == 0)
+    {
+        return;
+    }
+
+    if(shrink)
+    {
+        rxSize = pSkt->rxEnd - pSkt->rxStart;
+        if(!TCPIP_TCP_FifoSizeAdjust(pSkt->sktIx, rxSize - growth, 0, TCP_ADJUST_RX_ONLY))
+        {   // keep the larger buffer and its budget share
+            return;
+        }
+    }
+
+    tcpRxAutotuneUsed -= growth;
+    pSkt->rxAutoGrowth = 0;
+}
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
+
 
 /*
   Function:
@@ -6208,6 +7147,7 @@ bool TCPIP_TCP_Bind(TCP_SOCKET hTCP, IP_ADDRESS_TYPE addType, TCP_PORT localPort
     {   // client socket
         pSkt->remoteHash = _TCP_ClientIPV4RemoteHash(&pSkt->destAddress, pSkt);
     }
+    _TcpSocketHashUpdate(pSkt);
 
     return true;
 }
@@ -6307,6 +7247,32 @@ bool TCPIP_TCP_OptionsSet(TCP_SOCKET hTCP, TCP_SOCKET_OPTION option, void* optPa
             case TCP_OPTION_TOS:
                 pSkt->tos = (uint8_t)(unsigned int)optParam;
                 return true;
+
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+            case TCP_OPTION_RX_AUTOTUNE:
+                pSkt->rxAutotune = (int)optParam != 0;
+                return true;
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
+
+            case TCP_OPTION_DELAYED_ACK_TMO:
+                if((unsigned int)optParam <= TCP_MAX_DELAYED_ACK_TMO)
+                {
+                    pSkt->delayedAckTmo = (uint16_t)(unsigned int)optParam;
+                    return true;
+                }
+                return false;
+
+            case TCP_OPTION_QUICK_ACK:
+                pSkt->quickAcks = (unsigned int)optParam > 0xff ? 0xff : (uint8_t)(unsigned int)optParam;
+                return true;
+
+            case TCP_OPTION_CORK:
+                if((pSkt->cork = (int)optParam != 0) == 0 && _TCP_TxPktValid(pSkt))
+                {   // uncorked: push out the pending data
+                    pSkt->pushSeq = pSkt->MySEQ + _TcpTxUnsent(pSkt);
+                    _TcpFlush(pSkt);
+                }
+                return true;
                 
             default:
                 return false;   // not supported option
@@ -6369,6 +7335,26 @@ bool TCPIP_TCP_OptionsGet(TCP_SOCKET hTCP, TCP_SOCKET_OPTION option, void* optPa
              case TCP_OPTION_TOS:
                 *(uint8_t*)optParam = pSkt->tos;
                 return true;
+
+             case TCP_OPTION_RX_AUTOTUNE:
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+                *(bool*)optParam = pSkt->rxAutotune != 0;
+#else
+                *(bool*)optParam = false;
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
+                return true;
+
+             case TCP_OPTION_DELAYED_ACK_TMO:
+                *(uint16_t*)optParam = pSkt->delayedAckTmo;
+                return true;
+
+             case TCP_OPTION_QUICK_ACK:
+                *(uint8_t*)optParam = pSkt->quickAcks;
+                return true;
+
+             case TCP_OPTION_CORK:
+                *(bool*)optParam = pSkt->cork != 0;
+                return true;
                 
             default:
                 return false;   // not supported option
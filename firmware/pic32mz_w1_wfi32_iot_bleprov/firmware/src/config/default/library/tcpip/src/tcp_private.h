@@ -86,9 +86,64 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 // the minimum MTU value that needs to be supported
 #define TCP_MIN_DEFAULT_MTU     (536)
 
+// RX buffer autotuning
+// A socket RX buffer grows, through TCPIP_TCP_FifoSizeAdjust, when the
+// remote party sends about a full buffer per round trip, i.e. the
+// advertised window is what limits the throughput.
+// TCPIP_TCP_AUTOTUNE_MEM_BUDGET is the total growth allowed for all sockets;
+// 0 disables the autotuning.
+#if !defined(TCPIP_TCP_AUTOTUNE_MEM_BUDGET)
+#define TCPIP_TCP_AUTOTUNE_MEM_BUDGET   0
+#endif
+// max size an autotuned RX buffer can reach
+#if !defined(TCPIP_TCP_AUTOTUNE_MAX_RX_SIZE)
+#define TCPIP_TCP_AUTOTUNE_MAX_RX_SIZE  8760
+#endif
+
+#if (TCPIP_TCP_DYNAMIC_OPTIONS != 0) && (TCPIP_TCP_AUTOTUNE_MEM_BUDGET != 0)
+#define _TCPIP_TCP_RX_AUTOTUNE          1
+#else
+#define _TCPIP_TCP_RX_AUTOTUNE          0
+#endif
+
 // the min value of the data offset field, in 32 bit words
 #define TCP_DATA_OFFSET_VAL_MIN    5       // 20 bytes
 
+// Retransmission timeout
+// The RTO is computed from the measured RTT as in RFC 6298.
+// TCPIP_TCP_START_TIMEOUT_VAL is used until the first RTT sample is available.
+// min RTO value, ms; keep it above the delayed ACK timeout of the remote parties
+#if !defined(TCPIP_TCP_MIN_RTO)
+#define TCPIP_TCP_MIN_RTO               TCPIP_TCP_START_TIMEOUT_VAL
+#endif
+// max RTO value, ms
+#define TCP_MAX_RTO                     60000
+
+// number of duplicate ACKs that trigger a fast retransmit
+#define TCP_DUP_ACK_THRESHOLD           3
+
+// Selective acknowledgment, RFC 2018
+// Supported for IPv4 sockets only.
+#if !defined(TCPIP_TCP_SACK_SUPPORT)
+#define TCPIP_TCP_SACK_SUPPORT          0
+#endif
+// number of SACKed ranges the sender keeps track of
+#define TCP_SACK_SCOREBOARD_BLOCKS      4
+// number of out of order ranges the receiver keeps track of and reports;
+// 3 SACK blocks, as with timestamps, although 4 would fit without them
+#define TCP_SACK_RX_BLOCKS              3
+
+// max per socket delayed ACK timeout, ms; RFC 1122 limit
+#define TCP_MAX_DELAYED_ACK_TMO         500
+
+// max size of the options in a transmitted segment:
+// MSS + SACK permitted in SYN, or 2 NOPs + the SACK option with TCP_SACK_RX_BLOCKS blocks
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+#define TCP_TX_OPTIONS_SIZE             (4 + 8 * TCP_SACK_RX_BLOCKS)
+#else
+#define TCP_TX_OPTIONS_SIZE             12
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
 /****************************************************************************
   Section:
 	State Machine Variables
@@ -106,8 +161,24 @@ typedef struct
 	TCB Definitions
   ***************************************************************************/
 
-// TCP Control Block (TCB) stub data storage. 
+// a SACKed sequence number range: [start, end)
 typedef struct
+{
+    uint32_t    start;          // first sequence number in the range
+    uint32_t    end;            // sequence number following the range
+}TCP_SACK_BLOCK;
+
+// socket lookup tables
+// A socket is in at most one of the tables, according to its state
+typedef enum
+{
+    TCP_HASH_TABLE_NONE     = 0,    // not in any table: not opened yet, waiting to connect, killed
+    TCP_HASH_TABLE_LISTEN,          // listening socket; indexed by localPort
+    TCP_HASH_TABLE_CONN,            // socket with a remote end; indexed by remoteHash
+}TCP_HASH_TABLE;
+
+// TCP Control Block (TCB) stub data storage. 
+typedef struct _tag_TCB_STUB
 {
 	uint8_t*            txStart;		            // First byte of TX buffer
 	uint8_t*            txEnd;			            // Last byte of TX buffer
@@ -167,13 +238,15 @@ typedef struct
 	uint16_t		    maxRemoteWindow;	        // max advertised remote window size
     uint16_t            keepAliveTmo;               // timeout, ms
     uint16_t            remoteHash;	                // Consists of remoteIP, remotePort, localPort for connected sockets.
+    uint16_t            hashBkt;                    // bucket of the lookup table this socket is in
+    struct _tag_TCB_STUB* pHashNext;                // next socket in the same lookup bucket, ascending sktIx order
     struct
     {
 		uint16_t openAddType    : 2;		        // the address type used at open
         uint16_t bFINSent       : 1;		        // A FIN has been sent
 		uint16_t bSYNSent       : 1;		        // A SYN has been sent
-		uint16_t bRXNoneACKed1  : 1;	            // A duplicate ACK was likely received
-		uint16_t bRXNoneACKed2  : 1;	            // A second duplicate ACK was likely received
+        uint16_t sackOk         : 1;                // SACK permitted by both ends
+        uint16_t inRecovery     : 1;                // fast recovery in progress
 		uint16_t nonLinger      : 1; 		        // linger option
 		uint16_t nonGraceful    : 1; 		        // graceful close
         uint16_t ackSent        : 1;                // acknowledge sent in this pass
@@ -190,6 +263,7 @@ typedef struct
     uint8_t             addType;                    // IPV4/6 socket type; IP_ADDRESS_TYPE enum type
 	uint8_t		        retryCount;				    // Counter for transmission retries
     uint8_t             keepAliveCount;             // current counter
+    uint8_t             hashTbl;                    // TCP_HASH_TABLE: lookup table this socket is in
     uint16_t            sigMask;                    // TCPIP_TCP_SIGNAL_TYPE: mask of active events
     TCPIP_TCP_SIGNAL_FUNCTION sigHandler;           // socket signal handler
     const void*         sigParam;                   // socket signal parameter
@@ -205,6 +279,43 @@ typedef struct
         };
     }dbgFlags;
 
+    // retransmission timeout and loss recovery
+    uint32_t            sndMax;                     // highest sequence number sent
+    uint32_t            rttSeq;                     // sequence number that ends the timed segment
+    uint32_t            rttTime;                    // tick the timed segment was sent; 0 if none
+    uint32_t            srtt;                       // smoothed RTT, ticks << 3; 0 if not measured yet
+    uint32_t            rttVar;                     // RTT variation, ticks << 2
+    uint32_t            rto;                        // RTO computed from the RTT, ticks
+    uint32_t            recoverSeq;                 // fast recovery ends when this is acknowledged
+    uint32_t            rtxHighSeq;                 // end of the data retransmitted in the current recovery
+    uint32_t            rtoCount;                   // retransmission timeouts
+    uint32_t            fastRtxCount;               // segments retransmitted on duplicate ACKs
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+    TCP_SACK_BLOCK      sackBlk[TCP_SACK_SCOREBOARD_BLOCKS];  // SACKed ranges above SND.UNA, ascending
+    uint8_t             sackBlocks;                 // valid sackBlk entries
+    uint8_t             rxOooBlocks;                // valid rxOooBlk entries
+    TCP_SACK_BLOCK      rxOooBlk[TCP_SACK_RX_BLOCKS - 1];  // out of order RX ranges above the sHoleSize one, ascending
+    uint32_t            rxOooLastSeq;               // start of the latest out of order segment; reported first
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+    uint8_t             dupAcks;                    // duplicate ACKs received in a row
+
+    // acknowledgement and transmission batching
+    uint32_t            pushSeq;                    // corked data below this sequence number is flushed
+    uint16_t            delayedAckTmo;              // delayed ACK timeout, ms; 0 acknowledges every segment
+    uint8_t             quickAcks;                  // received segments still to be acknowledged immediately
+    uint8_t             cork;                       // partial segments are held until flushed or uncorked
+
+#if (_TCPIP_TCP_RX_AUTOTUNE != 0)
+    // RX buffer autotuning
+    uint32_t            rcvRttSeq;                  // RemoteSEQ that ends the current RTT measurement
+    uint32_t            rcvRttTime;                 // tick the current RTT measurement started; 0 if none
+    uint32_t            rcvRtt;                     // smoothed receive RTT, ticks; 0 if not measured yet
+    uint32_t            rcvSpaceSeq;                // RemoteSEQ at the start of the current RTT interval
+    uint32_t            rcvSpaceTime;               // tick the current RTT interval started; 0 if none
+    uint16_t            rxAutoSize;                 // RX buffer size to grow to, when drained; 0 if none
+    uint16_t            rxAutoGrowth;               // RX buffer growth charged to the autotuning budget
+    uint8_t             rxAutotune;                 // RX buffer autotuning enabled
+#endif  // (_TCPIP_TCP_RX_AUTOTUNE != 0)
     uint8_t ttl;                    // socket TTL value
     uint8_t tos;                    // socket TOS value
     uint8_t pad[];                  // padding; not used
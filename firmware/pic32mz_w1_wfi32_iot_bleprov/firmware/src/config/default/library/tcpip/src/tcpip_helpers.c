@@ -921,59 +921,189 @@ uint16_t TCPIP_Helper_Base64Encode(const uint8_t* cSourceData, uint16_t wSourceL
 	The checksum is implemented as a fast assembly function on PIC32M platforms.
   ***************************************************************************/
 #if !defined(__mips__)
+// Portable version: sums 32 bit words into a 64 bit accumulator,
+// 4 words per iteration; the end around carries are folded only once, at the end.
+// Gives the same result as the PIC32M assembly version.
 uint16_t TCPIP_Helper_CalcIPChecksum(const uint8_t* buffer, uint16_t count, uint16_t seed)
 {
-	uint16_t i;
-	uint16_t *val;
-	union
-	{
-		uint8_t  b[4];
-		uint16_t w[2];
-		uint32_t dw;
-	} sum;
+    const uint32_t* pW;
+    uint64_t sum;
+    uint16_t nWords;
+    bool     swap;
 
     if(buffer == 0)
     {
         return 0;
     }
 
-	val = (uint16_t*)buffer;
-
-	// Calculate the sum of all words
-	sum.dw = (uint32_t)seed;
-    if ((unsigned int)buffer % 2)
-    {
-        sum.w[0] += (*(uint8_t *)buffer) << 8;
-        val = (uint16_t *)(buffer + 1);
+    sum = seed;
+    swap = ((uintptr_t)buffer & 0x1) != 0;
+    if(swap && count != 0)
+    {   // odd start: the bytes are summed in the other lane and swapped at the end
+        sum += (uint32_t)(*buffer++) << 8;
         count--;
     }
 
-	i = count >> 1;
+    if(((uintptr_t)buffer & 0x2) != 0 && count >= 2)
+    {   // align to 32 bits
+        sum += *(const uint16_t*)buffer;
+        buffer += 2;
+        count -= 2;
+    }
 
-	while(i--)
-		sum.dw += (uint32_t)*val++;
+    pW = (const uint32_t*)buffer;
+    for(nWords = count >> 4; nWords != 0; nWords--)
+    {
+        sum += pW[0];
+        sum += pW[1];
+        sum += pW[2];
+        sum += pW[3];
+        pW += 4;
+    }
 
-	// Add in the sum of the remaining byte, if present
-	if(count & 0x1)
-		sum.dw += (uint32_t)*(uint8_t*)val;
+    for(nWords = (count >> 2) & 0x3; nWords != 0; nWords--)
+    {
+        sum += *pW++;
+    }
 
-	// Do an end-around carry (one's complement arrithmatic)
-	sum.dw = (uint32_t)sum.w[0] + (uint32_t)sum.w[1];
+    buffer = (const uint8_t*)pW;
+    if((count & 0x2) != 0)
+    {
+        sum += *(const uint16_t*)buffer;
+        buffer += 2;
+    }
 
-	// Do another end-around carry in case if the prior add 
-	// caused a carry out
-	sum.w[0] += sum.w[1];
+    // Add in the sum of the remaining byte, if present
+    if((count & 0x1) != 0)
+    {
+        sum += *buffer;
+    }
+
+    // Do the end-around carries (one's complement arithmetic)
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = TCPIP_Helper_ChecksumFold((uint32_t)sum);
 
-    if ((unsigned int)buffer % 2)
+    if(swap)
     {
-        sum.w[0] = ((uint16_t)sum.b[0] << 8 ) | (uint16_t)sum.b[1];
+        sum = ((sum & 0xff) << 8) | (sum >> 8);
     }
 
 	// Return the resulting checksum
-	return ~sum.w[0];
+	return ~(uint16_t)sum;
 }
 #endif  // !defined(__mips__)
 
+/*****************************************************************************
+  Function:
+	uint16_t TCPIP_Helper_MemcpyChecksum(uint8_t* pDst, const uint8_t* pSrc, uint16_t len)
+
+  Summary:
+	Copies data and calculates its IP checksum in one pass.
+
+  Description:
+	This function copies len bytes from pSrc to pDst and returns the
+    IP checksum of the copied data, as TCPIP_Helper_CalcIPChecksum(pSrc, len, 0) would.
+    The source is read as 32 bit words, each word being summed while in a register,
+    so the data is touched only once.
+
+  Precondition:
+	None
+
+  Parameters:
+	pDst - destination buffer; no alignment requirements
+	pSrc - source buffer
+	len  - number of bytes to copy
+
+  Returns:
+	The checksum of the copied data.
+	
+  Note:
+    The returned checksum assumes the data starts at an even offset.
+    If the data is part of a larger checksummed block and starts at an odd offset,
+    the caller has to byte swap ~checksum before adding it in.
+  ***************************************************************************/
+uint16_t TCPIP_Helper_MemcpyChecksum(uint8_t* pDst, const uint8_t* pSrc, uint16_t len)
+{
+    const uint32_t* pW;
+    uint32_t w0, w1, w2, w3;
+    uint16_t w, nWords;
+    uint64_t sum;
+    bool     swap;
+
+    sum = 0;
+    swap = ((uintptr_t)pSrc & 0x1) != 0;
+    if(swap && len != 0)
+    {   // odd start: the bytes are summed in the other lane and swapped at the end
+        sum += (uint32_t)*pSrc << 8;
+        *pDst++ = *pSrc++;
+        len--;
+    }
+
+    if(((uintptr_t)pSrc & 0x2) != 0 && len >= 2)
+    {   // align the source to 32 bits
+        w = *(const uint16_t*)pSrc;
+        memcpy(pDst, &w, sizeof(w));
+        sum += w;
+        pSrc += 2;
+        pDst += 2;
+        len -= 2;
+    }
+
+    pW = (const uint32_t*)pSrc;
+    for(nWords = len >> 4; nWords != 0; nWords--)
+    {   // the destination may be unaligned; memcpy of a word is a single (unaligned) store
+        w0 = pW[0];
+        w1 = pW[1];
+        w2 = pW[2];
+        w3 = pW[3];
+        memcpy(pDst, &w0, sizeof(w0));
+        memcpy(pDst + 4, &w1, sizeof(w1));
+        memcpy(pDst + 8, &w2, sizeof(w2));
+        memcpy(pDst + 12, &w3, sizeof(w3));
+        sum += (uint64_t)w0 + w1;
+        sum += (uint64_t)w2 + w3;
+        pW += 4;
+        pDst += 16;
+    }
+
+    for(nWords = (len >> 2) & 0x3; nWords != 0; nWords--)
+    {
+        w0 = *pW++;
+        memcpy(pDst, &w0, sizeof(w0));
+        sum += w0;
+        pDst += 4;
+    }
+
+    pSrc = (const uint8_t*)pW;
+    if((len & 0x2) != 0)
+    {
+        w = *(const uint16_t*)pSrc;
+        memcpy(pDst, &w, sizeof(w));
+        sum += w;
+        pSrc += 2;
+        pDst += 2;
+    }
+
+    if((len & 0x1) != 0)
+    {
+        sum += *pSrc;
+        *pDst = *pSrc;
+    }
+
+    // Do the end-around carries
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = TCPIP_Helper_ChecksumFold((uint32_t)sum);
+
+    if(swap)
+    {
+        sum = ((sum & 0xff) << 8) | (sum >> 8);
+    }
+
+    return ~(uint16_t)sum;
+}
+
 // calculates the IP checksum for a packet with multiple segments
 uint16_t TCPIP_Helper_PacketChecksum(TCPIP_MAC_PACKET* pPkt, uint8_t* startAdd, uint16_t len, uint16_t seed)
 {
@@ -1047,6 +1177,51 @@ uint16_t TCPIP_Helper_ChecksumFold(uint32_t rawChksum)
     
 }
 
+/*****************************************************************************
+  Function:
+	uint16_t TCPIP_Helper_ChecksumUpdate16(uint16_t checksum, uint16_t oldVal, uint16_t newVal)
+
+  Summary:
+	Incrementally updates an IP checksum.
+
+  Description:
+	This function updates an existing IP checksum when a 16 bit field
+    covered by the checksum changes from oldVal to newVal,
+    as described in RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m').
+    The data covered by the checksum does not need to be summed again.
+
+  Precondition:
+	None
+
+  Parameters:
+	checksum - the current checksum, as stored in the packet
+	oldVal   - the old value of the field, as stored in the packet
+	newVal   - the new value of the field, as stored in the packet
+
+  Returns:
+	The updated checksum.
+	
+  Note:
+    The field has to start at an even offset within the checksummed data.
+  ***************************************************************************/
+uint16_t TCPIP_Helper_ChecksumUpdate16(uint16_t checksum, uint16_t oldVal, uint16_t newVal)
+{
+    uint32_t sum = (uint32_t)(uint16_t)~checksum + (uint32_t)(uint16_t)~oldVal + (uint32_t)newVal;
+
+    return ~TCPIP_Helper_ChecksumFold(sum);
+}
+
+// same as TCPIP_Helper_ChecksumUpdate16 for a 32 bit field (an IPv4 address, a sequence number, etc.)
+uint16_t TCPIP_Helper_ChecksumUpdate32(uint16_t checksum, uint32_t oldVal, uint32_t newVal)
+{
+    uint32_t sum = (uint32_t)(uint16_t)~checksum;
+
+    sum += (uint32_t)(uint16_t)~(oldVal & 0xffff) + (uint32_t)(uint16_t)~(oldVal >> 16);
+    sum += (newVal & 0xffff) + (newVal >> 16);
+
+    return ~TCPIP_Helper_ChecksumFold(sum);
+}
+
 // copies packet segment data to a linear destination buffer
 // updates the pointer to the current location in the packet segment for further copy
 // returns the number of total bytes copied
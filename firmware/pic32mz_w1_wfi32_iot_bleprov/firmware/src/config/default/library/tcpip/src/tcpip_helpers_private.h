@@ -59,10 +59,18 @@ const char*     TCPIP_Helper_PowerModeToString(TCPIP_MAC_POWER_MODE mode);
 
 uint16_t        TCPIP_Helper_CalcIPChecksum(const uint8_t* buffer, uint16_t len, uint16_t seed);
 
+uint16_t        TCPIP_Helper_MemcpyChecksum(uint8_t* pDst, const uint8_t* pSrc, uint16_t len);
+
 uint16_t        TCPIP_Helper_PacketChecksum(TCPIP_MAC_PACKET* pPkt, uint8_t* startAdd, uint16_t len, uint16_t seed);
 
 uint16_t        TCPIP_Helper_ChecksumFold(uint32_t checksum);
 
+// RFC 1624 incremental update of a checksum when a packet field changes
+// The values are 16/32 bit fields as stored in the packet (network order)
+uint16_t        TCPIP_Helper_ChecksumUpdate16(uint16_t checksum, uint16_t oldVal, uint16_t newVal);
+
+uint16_t        TCPIP_Helper_ChecksumUpdate32(uint16_t checksum, uint32_t oldVal, uint32_t newVal);
+
 uint16_t        TCPIP_Helper_PacketCopy(TCPIP_MAC_PACKET* pSrcPkt, uint8_t* pDest, uint8_t** pStartAdd, uint16_t len, bool srchTransport);
 
 
@@ -1826,6 +1826,7 @@ static int _TCPIPExtractMacRxPackets(TCPIP_NET_IF* pNetIf)
     // get all the new MAC packets
     while((pRxPkt = (*pNetIf->pMacObj->TCPIP_MAC_PacketRx)(pNetIf->hIfMac, 0, 0)) != 0)
     {
+        pRxPkt->pktIf = pNetIf;     // the log needs the interface
         TCPIP_PKT_FlightLogRx(pRxPkt, pNetIf->macId);
         _TCPIPInsertMacRxPacket(pNetIf, pRxPkt);
         nPackets++;
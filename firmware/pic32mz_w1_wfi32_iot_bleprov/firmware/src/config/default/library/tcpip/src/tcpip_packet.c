@@ -40,10 +40,37 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 
 #define TCPIP_SEGMENT_CACHE_ALIGN_SIZE (CACHE_LINE_SIZE)
 
+// packet slab pools default configuration
+// block sizes are total allocation sizes: packet, 1st segment and segment gap
+#if !defined(TCPIP_PKT_POOL_ENABLE)
+    #define TCPIP_PKT_POOL_ENABLE           0
+#endif
+#if !defined(TCPIP_PKT_POOL_SMALL_SIZE)
+    #define TCPIP_PKT_POOL_SMALL_SIZE       320
+    #define TCPIP_PKT_POOL_SMALL_BLOCKS     16
+#endif
+#if !defined(TCPIP_PKT_POOL_MEDIUM_SIZE)
+    #define TCPIP_PKT_POOL_MEDIUM_SIZE      768
+    #define TCPIP_PKT_POOL_MEDIUM_BLOCKS    4
+#endif
+#if !defined(TCPIP_PKT_POOL_LARGE_SIZE)
+    #define TCPIP_PKT_POOL_LARGE_SIZE       1680
+    #define TCPIP_PKT_POOL_LARGE_BLOCKS     6
+#endif
+
+// packet capture default configuration
+#if !defined(TCPIP_PKT_CAPTURE_BUFFER_SIZE)
+    #define TCPIP_PKT_CAPTURE_BUFFER_SIZE   4096
+#endif
+#if !defined(TCPIP_PKT_CAPTURE_SNAPLEN)
+    #define TCPIP_PKT_CAPTURE_SNAPLEN       96
+#endif
+
 // Segment payload gap:
 // sizeof the TCPIP_MAC_SEGMENT_PAYLOAD::segmentDataGap
+// PIC32MZW1: firmware headroom and buffer header for in place transmission
 #if defined(TCPIP_IF_PIC32WK) || defined(TCPIP_IF_PIC32MZW1)
-    #define TCPIP_MAC_DATA_SEGMENT_GAP      34   
+    #define TCPIP_MAC_DATA_SEGMENT_GAP      48   
 #else
     #define TCPIP_MAC_DATA_SEGMENT_GAP      4   
 #endif
@@ -60,8 +87,9 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 
 // Segment payload gap:
 // sizeof the TCPIP_MAC_SEGMENT_PAYLOAD::segmentDataGap
+// PIC32MZW1: firmware headroom and buffer header for in place transmission
 #if defined(TCPIP_IF_PIC32WK) || defined(TCPIP_IF_PIC32MZW1)
-    #define TCPIP_MAC_DATA_SEGMENT_GAP      34   
+    #define TCPIP_MAC_DATA_SEGMENT_GAP      48   
 #else
     #define TCPIP_MAC_DATA_SEGMENT_GAP      4   
 #endif
@@ -116,8 +144,96 @@ static int                  _pktOverwriteIx;    // simple LRU displacement point
 
 static void                 _TCPIP_PKT_LogInit(bool resetAll);
 
+#if (_TCPIP_PKT_CAPTURE != 0)
+// pcap record header, host byte order
+typedef struct
+{
+    uint32_t    tsSec;              // timestamp seconds
+    uint32_t    tsUsec;             // timestamp microseconds
+    uint32_t    inclLen;            // number of bytes captured
+    uint32_t    origLen;            // frame length
+}TCPIP_PKT_PCAP_REC_HDR;
+
+// capture ring
+// a writer reserves the record space under a lock and copies the frame without it
+// the write index is advanced to the reserved index when no writer is copying anymore
+// the read index is updated only by the reader
+// one byte is always left unused to tell a full ring from an empty one
+static uint8_t                  _pktCapRing[TCPIP_PKT_CAPTURE_BUFFER_SIZE];
+static volatile uint32_t        _pktCapWrIx;        // end of the published records
+static volatile uint32_t        _pktCapResIx;       // end of the reserved records
+static volatile uint32_t        _pktCapRdIx;
+static volatile uint16_t        _pktCapWriters;     // writers copying into their reserved space
+
+static TCPIP_PKT_CAPTURE_INFO   _pktCapInfo;
+
+static void                 _TCPIP_PKT_CaptureFrame(TCPIP_MAC_PACKET* pPkt, bool isTx);
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
+
 #endif  // (TCPIP_PACKET_LOG_ENABLE)
 
+#if (TCPIP_PKT_POOL_ENABLE != 0)
+// packet slab pools
+// Fixed size blocks pre-allocated at TCPIP_PKT_Initialize for the common
+// packet and segment sizes: ARP and TCP control/ACK packets, small UDP packets
+// and full size frames.
+// An allocation takes a block from the smallest class that fits.
+// It falls back to the heap when that class is exhausted
+// or the size exceeds the largest block.
+
+typedef struct _tag_TCPIP_PKT_POOL_BLOCK
+{
+    struct _tag_TCPIP_PKT_POOL_BLOCK*   next;
+}TCPIP_PKT_POOL_BLOCK;
+
+typedef struct
+{
+    TCPIP_PKT_POOL_BLOCK*   freeList;       // available blocks
+    uint8_t*                poolStart;      // 1st block, cache line aligned
+    uint8_t*                poolEnd;        // past the last block
+    void*                   allocPtr;       // heap allocation holding the blocks
+    uint16_t                blockSize;      // size of a block, multiple of the cache line size
+    uint16_t                nBlocks;        // number of blocks in the pool
+    uint16_t                nFree;          // blocks currently available
+    uint16_t                minFree;        // low watermark of nFree
+    uint32_t                nAllocs;        // allocations served by this pool
+    uint32_t                nMisses;        // allocations that found this pool empty
+}TCPIP_PKT_POOL_DCPT;
+
+typedef struct
+{
+    uint16_t    blockSize;
+    uint16_t    nBlocks;
+}TCPIP_PKT_POOL_CONFIG;
+
+// size classes, in ascending block size order
+static const TCPIP_PKT_POOL_CONFIG _pktPoolConfig[] = 
+{
+    {TCPIP_PKT_POOL_SMALL_SIZE,     TCPIP_PKT_POOL_SMALL_BLOCKS},
+    {TCPIP_PKT_POOL_MEDIUM_SIZE,    TCPIP_PKT_POOL_MEDIUM_BLOCKS},
+    {TCPIP_PKT_POOL_LARGE_SIZE,     TCPIP_PKT_POOL_LARGE_BLOCKS},
+};
+
+static TCPIP_PKT_POOL_DCPT  _pktPoolTbl[sizeof(_pktPoolConfig) / sizeof(*_pktPoolConfig)];
+
+static uint32_t             _pktPoolOversize;   // allocations larger than the largest block
+
+static void     _TCPIP_PKT_PoolInit(TCPIP_STACK_HEAP_HANDLE heapH);
+static void     _TCPIP_PKT_PoolDeinit(TCPIP_STACK_HEAP_HANDLE heapH);
+static void*    _TCPIP_PKT_PoolAlloc(uint16_t allocLen);
+static bool     _TCPIP_PKT_PoolFree(void* ptr);
+#else
+static __inline__ void* __attribute__((always_inline)) _TCPIP_PKT_PoolAlloc(uint16_t allocLen)
+{
+    return 0;
+}
+
+static __inline__ bool __attribute__((always_inline)) _TCPIP_PKT_PoolFree(void* ptr)
+{
+    return false;
+}
+#endif  // (TCPIP_PKT_POOL_ENABLE != 0)
+
 
 
 // API
@@ -141,6 +257,10 @@ bool TCPIP_PKT_Initialize(TCPIP_STACK_HEAP_HANDLE heapH, const TCPIP_NETWORK_CON
         // success
         pktMemH = heapH;
 
+#if (TCPIP_PKT_POOL_ENABLE != 0)
+        _TCPIP_PKT_PoolInit(heapH);
+#endif  // (TCPIP_PKT_POOL_ENABLE != 0)
+
 #if defined(TCPIP_PACKET_ALLOCATION_TRACE_ENABLE)
         memset(_pktTraceTbl, 0, sizeof(_pktTraceTbl));
         memset(&_pktTraceInfo, 0, sizeof(_pktTraceInfo));
@@ -171,6 +291,12 @@ bool TCPIP_PKT_Initialize(TCPIP_STACK_HEAP_HANDLE heapH, const TCPIP_NETWORK_CON
 
 void TCPIP_PKT_Deinitialize(void)
 {
+#if (TCPIP_PKT_POOL_ENABLE != 0)
+    if(pktMemH != 0)
+    {
+        _TCPIP_PKT_PoolDeinit(pktMemH);
+    }
+#endif  // (TCPIP_PKT_POOL_ENABLE != 0)
     pktMemH = 0;
 }
 
@@ -335,11 +461,15 @@ static __inline__ TCPIP_MAC_PACKET* __attribute__((always_inline)) _TCPIP_PKT_Pa
     // total allocation size
     allocLen = pktUpLen + sizeof(*pSeg) + segAllocSize;
 
+    pPkt = (TCPIP_MAC_PACKET*)_TCPIP_PKT_PoolAlloc(allocLen);
+    if(pPkt == 0)
+    {
 #if defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
-    pPkt = (TCPIP_MAC_PACKET*)TCPIP_HEAP_MallocDebug(pktMemH, allocLen, moduleId, __LINE__);
+        pPkt = (TCPIP_MAC_PACKET*)TCPIP_HEAP_MallocDebug(pktMemH, allocLen, moduleId, __LINE__);
 #else
-    pPkt = (TCPIP_MAC_PACKET*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
+        pPkt = (TCPIP_MAC_PACKET*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
 #endif  // defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
+    }
 
     if(pPkt)
     {   
@@ -382,7 +512,7 @@ static __inline__ void __attribute__((always_inline)) _TCPIP_PKT_PacketFreeInt(T
         for(pSeg = pPkt->pDSeg; pSeg != 0; pSeg = pNSeg)
         {
             pNSeg = pSeg->next;
-            if((pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0)
+            if((pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0 && !_TCPIP_PKT_PoolFree(pSeg))
             {
 #if defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
                 TCPIP_HEAP_FreeDebug(pktMemH, pSeg, moduleId);
@@ -392,11 +522,14 @@ static __inline__ void __attribute__((always_inline)) _TCPIP_PKT_PacketFreeInt(T
             }
         }
 
+        if(!_TCPIP_PKT_PoolFree(pPkt))
+        {
 #if defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
-        TCPIP_HEAP_FreeDebug(pktMemH, pPkt, moduleId);
+            TCPIP_HEAP_FreeDebug(pktMemH, pPkt, moduleId);
 #else
-        TCPIP_HEAP_Free(pktMemH, pPkt);
+            TCPIP_HEAP_Free(pktMemH, pPkt);
 #endif  // defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
+        }
     }
 }
 
@@ -446,11 +579,15 @@ static __inline__ TCPIP_MAC_DATA_SEGMENT* __attribute__((always_inline)) _TCPIP_
     allocLen = sizeof(*pSeg) + segAllocSize;
 
 
+    pSeg = (TCPIP_MAC_DATA_SEGMENT*)_TCPIP_PKT_PoolAlloc(allocLen);
+    if(pSeg == 0)
+    {
 #if defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
-    pSeg = (TCPIP_MAC_DATA_SEGMENT*)TCPIP_HEAP_MallocDebug(pktMemH, allocLen, moduleId, __LINE__);
+        pSeg = (TCPIP_MAC_DATA_SEGMENT*)TCPIP_HEAP_MallocDebug(pktMemH, allocLen, moduleId, __LINE__);
 #else
-    pSeg = (TCPIP_MAC_DATA_SEGMENT*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
+        pSeg = (TCPIP_MAC_DATA_SEGMENT*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
 #endif  // defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
+    }
 
 
     if(pSeg)
@@ -471,7 +608,7 @@ static __inline__ TCPIP_MAC_DATA_SEGMENT* __attribute__((always_inline)) _TCPIP_
 
 static __inline__ void __attribute__((always_inline)) _TCPIP_PKT_SegmentFreeInt(TCPIP_MAC_DATA_SEGMENT* pSeg, int moduleId)
 {
-    if( (pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0)
+    if( (pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0 && !_TCPIP_PKT_PoolFree(pSeg))
     {
 #if defined(TCPIP_STACK_DRAM_DEBUG_ENABLE) 
         TCPIP_HEAP_FreeDebug(pktMemH, pSeg, moduleId);
@@ -693,7 +830,11 @@ TCPIP_MAC_PACKET* _TCPIP_PKT_PacketAlloc(uint16_t pktLen, uint16_t segLoadLen, T
     // total allocation size
     allocLen = pktUpLen + sizeof(*pSeg) + segAllocSize;
 
-    pPkt = (TCPIP_MAC_PACKET*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
+    pPkt = (TCPIP_MAC_PACKET*)_TCPIP_PKT_PoolAlloc(allocLen);
+    if(pPkt == 0)
+    {
+        pPkt = (TCPIP_MAC_PACKET*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
+    }
 
     if(pPkt)
     {   
@@ -768,13 +909,16 @@ void _TCPIP_PKT_PacketFree(TCPIP_MAC_PACKET* pPkt)
         for( pSeg = pPkt->pDSeg; pSeg != 0; pSeg = pNSeg )
         {
             pNSeg = pSeg->next;
-            if((pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0)
+            if((pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0 && !_TCPIP_PKT_PoolFree(pSeg))
             {
                 TCPIP_HEAP_Free(pktMemH, pSeg);
             }
         }
 
-        TCPIP_HEAP_Free(pktMemH, pPkt);
+        if(!_TCPIP_PKT_PoolFree(pPkt))
+        {
+            TCPIP_HEAP_Free(pktMemH, pPkt);
+        }
     }
 }
 
@@ -793,7 +937,11 @@ TCPIP_MAC_DATA_SEGMENT* _TCPIP_PKT_SegmentAlloc(uint16_t loadLen, TCPIP_MAC_SEGM
     // total allocation size
     allocLen = sizeof(*pSeg) + segAllocSize;
 
-    pSeg = (TCPIP_MAC_DATA_SEGMENT*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
+    pSeg = (TCPIP_MAC_DATA_SEGMENT*)_TCPIP_PKT_PoolAlloc(allocLen);
+    if(pSeg == 0)
+    {
+        pSeg = (TCPIP_MAC_DATA_SEGMENT*)TCPIP_HEAP_Malloc(pktMemH, allocLen);
+    }
 
     if(pSeg)
     {
@@ -813,13 +961,178 @@ TCPIP_MAC_DATA_SEGMENT* _TCPIP_PKT_SegmentAlloc(uint16_t loadLen, TCPIP_MAC_SEGM
 
 void _TCPIP_PKT_SegmentFree(TCPIP_MAC_DATA_SEGMENT* pSeg)
 {
-    if( (pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0)
+    if( (pSeg->segFlags & TCPIP_MAC_SEG_FLAG_STATIC) == 0 && !_TCPIP_PKT_PoolFree(pSeg))
     {
         TCPIP_HEAP_Free(pktMemH, pSeg);
     }
 }
 #endif  // defined(TCPIP_PACKET_ALLOCATION_TRACE_ENABLE)
 
+#if (TCPIP_PKT_POOL_ENABLE != 0)
+// packet slab pools implementation
+
+// pre-allocates the blocks of all pool classes
+// a class that cannot be allocated is left empty and all its requests go to the heap
+static void _TCPIP_PKT_PoolInit(TCPIP_STACK_HEAP_HANDLE heapH)
+{
+    int ix, blkIx;
+    uint8_t* pBlk;
+    TCPIP_PKT_POOL_DCPT* pPool = _pktPoolTbl;
+    const TCPIP_PKT_POOL_CONFIG* pCfg = _pktPoolConfig;
+
+    memset(_pktPoolTbl, 0, sizeof(_pktPoolTbl));
+    _pktPoolOversize = 0;
+
+    for(ix = 0; ix < sizeof(_pktPoolTbl) / sizeof(*_pktPoolTbl); ix++, pPool++, pCfg++)
+    {
+        pPool->blockSize = ((pCfg->blockSize + TCPIP_SEGMENT_CACHE_ALIGN_SIZE - 1) / TCPIP_SEGMENT_CACHE_ALIGN_SIZE) * TCPIP_SEGMENT_CACHE_ALIGN_SIZE;
+        if(pCfg->nBlocks == 0)
+        {
+            continue;
+        }
+
+        // extra cache line so that the 1st block starts on a cache line boundary
+        pPool->allocPtr = TCPIP_HEAP_Malloc(heapH, pCfg->nBlocks * pPool->blockSize + TCPIP_SEGMENT_CACHE_ALIGN_SIZE);
+        if(pPool->allocPtr == 0)
+        {
+            SYS_ERROR_PRINT(SYS_ERROR_WARNING, "PKT pool: failed to allocate %d blocks of %d bytes\r\n", pCfg->nBlocks, pPool->blockSize);
+            continue;
+        }
+
+        pPool->poolStart = (uint8_t*)((((uint32_t)pPool->allocPtr + TCPIP_SEGMENT_CACHE_ALIGN_SIZE - 1) / TCPIP_SEGMENT_CACHE_ALIGN_SIZE) * TCPIP_SEGMENT_CACHE_ALIGN_SIZE);
+        pPool->poolEnd = pPool->poolStart + pCfg->nBlocks * pPool->blockSize;
+        pPool->nBlocks = pPool->nFree = pPool->minFree = pCfg->nBlocks;
+
+        // chain the blocks in address order
+        pBlk = pPool->poolEnd;
+        for(blkIx = 0; blkIx < pCfg->nBlocks; blkIx++)
+        {
+            pBlk -= pPool->blockSize;
+            ((TCPIP_PKT_POOL_BLOCK*)pBlk)->next = pPool->freeList;
+            pPool->freeList = (TCPIP_PKT_POOL_BLOCK*)pBlk;
+        }
+    }
+}
+
+// releases the pool blocks
+// all the packets should have been freed
+static void _TCPIP_PKT_PoolDeinit(TCPIP_STACK_HEAP_HANDLE heapH)
+{
+    int ix;
+    TCPIP_PKT_POOL_DCPT* pPool = _pktPoolTbl;
+
+    for(ix = 0; ix < sizeof(_pktPoolTbl) / sizeof(*_pktPoolTbl); ix++, pPool++)
+    {
+        if(pPool->allocPtr != 0)
+        {
+            if(pPool->nFree != pPool->nBlocks)
+            {
+                SYS_ERROR_PRINT(SYS_ERROR_WARNING, "PKT pool: %d blocks of %d bytes still in use\r\n", pPool->nBlocks - pPool->nFree, pPool->blockSize);
+            }
+            TCPIP_HEAP_Free(heapH, pPool->allocPtr);
+        }
+    }
+
+    memset(_pktPoolTbl, 0, sizeof(_pktPoolTbl));
+}
+
+// takes a block from the smallest class that fits allocLen
+// returns 0 if the class is exhausted or allocLen is too large;
+// the caller then allocates from the heap
+static void* _TCPIP_PKT_PoolAlloc(uint16_t allocLen)
+{
+    int ix;
+    TCPIP_PKT_POOL_BLOCK* pBlk;
+    OSAL_CRITSECT_DATA_TYPE status;
+    TCPIP_PKT_POOL_DCPT* pPool = _pktPoolTbl;
+
+    for(ix = 0; ix < sizeof(_pktPoolTbl) / sizeof(*_pktPoolTbl); ix++, pPool++)
+    {
+        if(allocLen <= pPool->blockSize)
+        {
+            status = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+            pBlk = pPool->freeList;
+            if(pBlk != 0)
+            {
+                pPool->freeList = pBlk->next;
+                pPool->nAllocs++;
+                if(--pPool->nFree < pPool->minFree)
+                {
+                    pPool->minFree = pPool->nFree;
+                }
+            }
+            else
+            {
+                pPool->nMisses++;
+            }
+            OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, status);
+
+            return pBlk;
+        }
+    }
+
+    _pktPoolOversize++;
+    return 0;
+}
+
+// returns a block to its pool
+// returns false if ptr does not belong to a pool
+static bool _TCPIP_PKT_PoolFree(void* ptr)
+{
+    int ix;
+    OSAL_CRITSECT_DATA_TYPE status;
+    TCPIP_PKT_POOL_DCPT* pPool = _pktPoolTbl;
+
+    for(ix = 0; ix < sizeof(_pktPoolTbl) / sizeof(*_pktPoolTbl); ix++, pPool++)
+    {
+        if((uint8_t*)ptr >= pPool->poolStart && (uint8_t*)ptr < pPool->poolEnd)
+        {
+            status = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+            ((TCPIP_PKT_POOL_BLOCK*)ptr)->next = pPool->freeList;
+            pPool->freeList = (TCPIP_PKT_POOL_BLOCK*)ptr;
+            pPool->nFree++;
+            OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, status);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int TCPIP_PKT_PoolGetEntriesNo(TCPIP_PKT_POOL_INFO* pPoolInfo)
+{
+    if(pPoolInfo)
+    {
+        pPoolInfo->nEntries = sizeof(_pktPoolTbl) / sizeof(*_pktPoolTbl);
+        pPoolInfo->nOversize = _pktPoolOversize;
+    }
+
+    return sizeof(_pktPoolTbl) / sizeof(*_pktPoolTbl);
+}
+
+bool TCPIP_PKT_PoolGetEntry(int entryIx, TCPIP_PKT_POOL_ENTRY* pEntry)
+{
+    if(entryIx < 0 || entryIx >= sizeof(_pktPoolTbl) / sizeof(*_pktPoolTbl))
+    {
+        return false;
+    }
+
+    TCPIP_PKT_POOL_DCPT* pPool = _pktPoolTbl + entryIx;
+    if(pEntry)
+    {
+        pEntry->blockSize = pPool->blockSize;
+        pEntry->nBlocks = pPool->nBlocks;
+        pEntry->nFree = pPool->nFree;
+        pEntry->minFree = pPool->minFree;
+        pEntry->nAllocs = pPool->nAllocs;
+        pEntry->nMisses = pPool->nMisses;
+    }
+
+    return pPool->nBlocks != 0;
+}
+
+#endif  // (TCPIP_PKT_POOL_ENABLE != 0)
+
 
 #if (TCPIP_PACKET_LOG_ENABLE)
 
@@ -1037,6 +1350,13 @@ static TCPIP_PKT_LOG_ENTRY* _TCPIP_PKT_FlightLog(TCPIP_MAC_PACKET* pPkt, TCPIP_S
 
 void TCPIP_PKT_FlightLogTx(TCPIP_MAC_PACKET* pPkt, TCPIP_STACK_MODULE moduleId)
 {
+#if (_TCPIP_PKT_CAPTURE != 0)
+    if(moduleId >= TCPIP_MODULE_MAC_START)
+    {   // the complete frame is handed to the MAC
+        _TCPIP_PKT_CaptureFrame(pPkt, true);
+    }
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
+
     TCPIP_PKT_LOG_ENTRY* pLogEntry = _TCPIP_PKT_FlightLog(pPkt, moduleId, TCPIP_PKT_LOG_FLAG_TX);
 
     if(pLogEntry)
@@ -1047,6 +1367,13 @@ void TCPIP_PKT_FlightLogTx(TCPIP_MAC_PACKET* pPkt, TCPIP_STACK_MODULE moduleId)
 
 void TCPIP_PKT_FlightLogRx(TCPIP_MAC_PACKET* pPkt, TCPIP_STACK_MODULE moduleId)
 {
+#if (_TCPIP_PKT_CAPTURE != 0)
+    if(moduleId >= TCPIP_MODULE_MAC_START)
+    {   // the frame is just out of the MAC, not processed yet
+        _TCPIP_PKT_CaptureFrame(pPkt, false);
+    }
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
+
     TCPIP_PKT_LOG_ENTRY* pLogEntry =  _TCPIP_PKT_FlightLog(pPkt, moduleId, TCPIP_PKT_LOG_FLAG_RX);
 
     if(pLogEntry)
@@ -1384,6 +1711,284 @@ void TCPIP_PKT_FlightLogReset(bool resetMasks)
     _TCPIP_PKT_LogInit(resetMasks);
 }
 
+#if (_TCPIP_PKT_CAPTURE != 0)
+// returns the mask of the modules a frame belongs to, constructed like the log moduleLog
+// for TCP and UDP frames pPorts is updated with (srcPort << 16 | destPort)
+static uint32_t _TCPIP_PKT_CaptureClassify(const uint8_t* pFrame, uint32_t frameLen, uint32_t* pPorts)
+{
+    const TCPIP_MAC_ETHERNET_HEADER* pMacHdr = (const TCPIP_MAC_ETHERNET_HEADER*)pFrame;
+    const uint8_t* pNetHdr = pFrame + sizeof(TCPIP_MAC_ETHERNET_HEADER);
+    uint32_t netLen, hdrLen, moduleMask;
+    uint8_t  protocol;
+
+    *pPorts = 0;
+    if(frameLen < sizeof(TCPIP_MAC_ETHERNET_HEADER))
+    {
+        return 0;
+    }
+    netLen = frameLen - sizeof(TCPIP_MAC_ETHERNET_HEADER);
+
+    switch(TCPIP_Helper_ntohs(pMacHdr->Type))
+    {
+        case TCPIP_ETHER_TYPE_ARP:
+            return 1 << TCPIP_MODULE_ARP;
+
+        case TCPIP_ETHER_TYPE_IPV4:
+            moduleMask = 1 << TCPIP_MODULE_IPV4;
+            if(netLen < 20)
+            {
+                return moduleMask;
+            }
+            hdrLen = (pNetHdr[0] & 0x0f) << 2;
+            protocol = pNetHdr[9];
+            break;
+
+        case TCPIP_ETHER_TYPE_IPV6:
+            // extension headers are not followed
+            moduleMask = 1 << TCPIP_MODULE_IPV6;
+            if(netLen < 40)
+            {
+                return moduleMask;
+            }
+            hdrLen = 40;
+            protocol = pNetHdr[6];
+            break;
+
+        default:
+            return 0;
+    }
+
+    switch(protocol)
+    {
+        case IP_PROT_ICMP:
+            moduleMask |= 1 << TCPIP_MODULE_ICMP;
+            break;
+
+        case IP_PROT_IGMP:
+            moduleMask |= 1 << TCPIP_MODULE_IGMP;
+            break;
+
+        case 58:    // ICMPv6
+            moduleMask |= 1 << TCPIP_MODULE_ICMPV6;
+            break;
+
+        case IP_PROT_TCP:
+        case IP_PROT_UDP:
+            moduleMask |= 1 << (protocol == IP_PROT_TCP ? TCPIP_MODULE_TCP : TCPIP_MODULE_UDP);
+            if(netLen >= hdrLen + 4)
+            {
+                pNetHdr += hdrLen;
+                *pPorts = ((uint32_t)pNetHdr[0] << 24) | ((uint32_t)pNetHdr[1] << 16) | ((uint32_t)pNetHdr[2] << 8) | pNetHdr[3];
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return moduleMask;
+}
+
+// copies data into the capture ring
+// returns the updated write index
+static uint32_t _TCPIP_PKT_CaptureCopy(uint32_t wrIx, const void* pSrc, uint32_t len)
+{
+    uint32_t toEnd = sizeof(_pktCapRing) - wrIx;
+
+    if(len < toEnd)
+    {
+        memcpy(_pktCapRing + wrIx, pSrc, len);
+        return wrIx + len;
+    }
+
+    memcpy(_pktCapRing + wrIx, pSrc, toEnd);
+    memcpy(_pktCapRing, (const uint8_t*)pSrc + toEnd, len - toEnd);
+    return len - toEnd;
+}
+
+// captures a frame into the ring, if it matches the log masks
+// isTx: TX frames have the Ethernet header included in the 1st segment segLen
+//       for RX frames the MAC sets the segLen to the Ethernet payload
+static void _TCPIP_PKT_CaptureFrame(TCPIP_MAC_PACKET* pPkt, bool isTx)
+{
+    TCPIP_PKT_PCAP_REC_HDR recHdr;
+    TCPIP_MAC_DATA_SEGMENT* pSeg;
+    const uint8_t* pFrame;
+    uint32_t firstLen, frameLen, copyLen, segCopy, ports, wrIx, avlblLen;
+    uint64_t sysCount;
+    uint32_t sysFreq;
+    int netIx;
+
+    if(!_pktCapInfo.active)
+    {
+        return;
+    }
+
+    if((_pktLogInfo.logType & (isTx ? TCPIP_PKT_LOG_TYPE_RX_ONLY : TCPIP_PKT_LOG_TYPE_TX_ONLY)) != 0)
+    {   // not this direction
+        return;
+    }
+
+    netIx = TCPIP_STACK_NetIxGet((TCPIP_NET_IF*)pPkt->pktIf);
+    if(netIx < 0 || (_pktLogInfo.netLogMask & (1 << netIx)) == 0)
+    {   // not capturing this interface
+        return;
+    }
+
+    pSeg = pPkt->pDSeg;
+    if(isTx)
+    {
+        pFrame = pSeg->segLoad;
+        firstLen = pSeg->segLen;
+    }
+    else
+    {
+        pFrame = pPkt->pMacLayer;
+        firstLen = pSeg->segLen + sizeof(TCPIP_MAC_ETHERNET_HEADER);
+    }
+
+    if((_TCPIP_PKT_CaptureClassify(pFrame, firstLen, &ports) & _pktLogInfo.logModuleMask) == 0)
+    {   // module not captured
+        return;
+    }
+
+    if(_pktCapInfo.skipPort != 0 && ports != 0)
+    {   // don't capture the stream carrying the capture
+        if((ports >> 16) == _pktCapInfo.skipPort || (ports & 0xffff) == _pktCapInfo.skipPort)
+        {
+            return;
+        }
+    }
+
+    frameLen = firstLen;
+    for(pSeg = pSeg->next; pSeg != 0; pSeg = pSeg->next)
+    {
+        frameLen += pSeg->segLen;
+    }
+    copyLen = frameLen < _pktCapInfo.snapLen ? frameLen : _pktCapInfo.snapLen;
+
+    sysCount = SYS_TMR_SystemCountGet();
+    sysFreq = SYS_TMR_SystemCountFrequencyGet();
+    recHdr.tsSec = (uint32_t)(sysCount / sysFreq);
+    recHdr.tsUsec = (uint32_t)(((sysCount % sysFreq) * 1000000) / sysFreq);
+    recHdr.inclLen = copyLen;
+    recHdr.origLen = frameLen;
+
+    // TX frames can come from any thread
+    // only the space reservation and the publishing are done under the lock
+    OSAL_CRITSECT_DATA_TYPE critSect =  OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+
+    wrIx = _pktCapResIx;
+    avlblLen = (_pktCapRdIx + sizeof(_pktCapRing) - wrIx - 1) % sizeof(_pktCapRing);
+    if(avlblLen < sizeof(recHdr) + copyLen)
+    {
+        _pktCapInfo.nDrops++;
+        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critSect);
+        return;
+    }
+
+    _pktCapResIx = (wrIx + sizeof(recHdr) + copyLen) % sizeof(_pktCapRing);
+    _pktCapWriters++;
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critSect);
+
+    wrIx = _TCPIP_PKT_CaptureCopy(wrIx, &recHdr, sizeof(recHdr));
+
+    segCopy = copyLen < firstLen ? copyLen : firstLen;
+    wrIx = _TCPIP_PKT_CaptureCopy(wrIx, pFrame, segCopy);
+    copyLen -= segCopy;
+    for(pSeg = pPkt->pDSeg->next; pSeg != 0 && copyLen != 0; pSeg = pSeg->next)
+    {
+        segCopy = copyLen < pSeg->segLen ? copyLen : pSeg->segLen;
+        wrIx = _TCPIP_PKT_CaptureCopy(wrIx, pSeg->segLoad, segCopy);
+        copyLen -= segCopy;
+    }
+
+    critSect =  OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+    if(--_pktCapWriters == 0)
+    {   // all the reserved records are complete; publish them
+        _pktCapWrIx = _pktCapResIx;
+    }
+    _pktCapInfo.nFrames++;
+    if(recHdr.inclLen < frameLen)
+    {
+        _pktCapInfo.nTruncated++;
+    }
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critSect);
+}
+
+bool TCPIP_PKT_CaptureStart(uint16_t snapLen, uint16_t skipPort)
+{
+    if(snapLen == 0)
+    {
+        snapLen = TCPIP_PKT_CAPTURE_SNAPLEN;
+    }
+
+    if(snapLen + sizeof(TCPIP_PKT_PCAP_REC_HDR) >= sizeof(_pktCapRing))
+    {   // a record should fit in the ring
+        return false;
+    }
+
+    // the ring indices are kept, a writer may still be copying into its reserved space
+    // the reader discards the old records when it starts a new stream
+    OSAL_CRITSECT_DATA_TYPE critSect =  OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+    memset(&_pktCapInfo, 0, sizeof(_pktCapInfo));
+    _pktCapInfo.snapLen = snapLen;
+    _pktCapInfo.skipPort = skipPort;
+    _pktCapInfo.active = true;
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critSect);
+
+    return true;
+}
+
+void TCPIP_PKT_CaptureStop(void)
+{
+    _pktCapInfo.active = false;
+}
+
+bool TCPIP_PKT_CaptureGetInfo(TCPIP_PKT_CAPTURE_INFO* pCapInfo)
+{
+    if(pCapInfo)
+    {
+        *pCapInfo = _pktCapInfo;
+        pCapInfo->nPending = (_pktCapWrIx + sizeof(_pktCapRing) - _pktCapRdIx) % sizeof(_pktCapRing);
+    }
+
+    return _pktCapInfo.active;
+}
+
+void TCPIP_PKT_CaptureHeaderGet(TCPIP_PKT_PCAP_HDR* pHdr)
+{
+    pHdr->magicNumber = 0xa1b2c3d4;
+    pHdr->versionMajor = 2;
+    pHdr->versionMinor = 4;
+    pHdr->thisZone = 0;
+    pHdr->sigFigs = 0;
+    pHdr->snapLen = _pktCapInfo.snapLen != 0 ? _pktCapInfo.snapLen : TCPIP_PKT_CAPTURE_SNAPLEN;
+    pHdr->network = 1;
+}
+
+size_t TCPIP_PKT_CapturePeek(const uint8_t** ppData)
+{
+    uint32_t rdIx = _pktCapRdIx;
+    uint32_t wrIx = _pktCapWrIx;
+
+    *ppData = _pktCapRing + rdIx;
+    return wrIx >= rdIx ? wrIx - rdIx : sizeof(_pktCapRing) - rdIx;
+}
+
+void TCPIP_PKT_CaptureConsume(size_t nBytes)
+{
+    uint32_t rdIx = _pktCapRdIx + nBytes;
+
+    _pktCapRdIx = rdIx >= sizeof(_pktCapRing) ? rdIx - sizeof(_pktCapRing) : rdIx;
+}
+
+void TCPIP_PKT_CaptureDiscard(void)
+{
+    _pktCapRdIx = _pktCapWrIx;
+}
+#endif  // (_TCPIP_PKT_CAPTURE != 0)
+
 #endif  //  (TCPIP_PACKET_LOG_ENABLE)
 
 
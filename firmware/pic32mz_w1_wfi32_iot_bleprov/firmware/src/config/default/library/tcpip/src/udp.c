@@ -63,6 +63,8 @@ THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 static UDP_SOCKET_DCPT** UDPSocketDcpt = 0; 
 
 static int          nUdpSockets = 0;    // number of sockets in the current UDP configuration
+static OA_HASH_DCPT* udpPortHash = 0;   // local port -> sockets index
+static uint16_t     udpPortHashProbeMax = 0;    // longest probe of a port in the hash
 static const void*  udpMemH = 0;        // memory handle
 static int          udpInitCount = 0;   // initialization counter
 
@@ -415,6 +417,19 @@ static TCPIP_MAC_PKT_ACK_RES TCPIP_UDP_ProcessIPv6(TCPIP_MAC_PACKET* pRxPkt);
 static UDP_PORT         _UDPAllocateEphemeralPort(void);
 static bool             _UDPIsAvailablePort(UDP_PORT port);
 
+static void             _UDPSocketPortSet(UDP_SOCKET_DCPT* pSkt, UDP_PORT port);
+
+static UDP_PORT_HASH_ENTRY* _UDPPortHashLookup(UDP_PORT port);
+
+#if defined ( OA_HASH_DYNAMIC_KEY_MANIPULATION )
+static size_t           _UDPPortHashKeyHash(OA_HASH_DCPT* pOH, const void* key);
+#if defined(OA_DOUBLE_HASH_PROBING)
+static size_t           _UDPPortHashProbeHash(OA_HASH_DCPT* pOH, const void* key);
+#endif  // defined(OA_DOUBLE_HASH_PROBING)
+static int              _UDPPortHashKeyCompare(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* hEntry, const void* key);
+static void             _UDPPortHashKeyCopy(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* dstEntry, const void* key);
+#endif  // defined ( OA_HASH_DYNAMIC_KEY_MANIPULATION )
+
 static void             TCPIP_UDP_Process(void);
 
 static UDP_SOCKET       _UDPOpen(IP_ADDRESS_TYPE addType, UDP_OPEN_TYPE opType, UDP_PORT port, IP_MULTI_ADDRESS* address);
@@ -489,6 +504,7 @@ static  bool _UDPSocketBind(UDP_SOCKET_DCPT* pSkt, TCPIP_NET_IF* pNet, IP_MULTI_
     pSkt->txStart = txBuff;
     pSkt->txEnd = txBuff + pSkt->txSize;
     pSkt->txWrite = txBuff;
+    pSkt->txSumEnd = 0;
     pSkt->addType =  addType;
     pSkt->pPkt = pTxPkt;
 }
@@ -554,6 +570,8 @@ static  bool _UDPSocketBind(UDP_SOCKET_DCPT* pSkt, TCPIP_NET_IF* pNet, IP_MULTI_
 bool TCPIP_UDP_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const TCPIP_UDP_MODULE_CONFIG* pUdpInit)
 {
     UDP_SOCKET_DCPT** newSktDcpt; 
+    OA_HASH_DCPT*   newPortHash;
+    size_t          hashEntries;
     
     if(stackCtrl->stackAction == TCPIP_STACK_ACTION_IF_UP)
     {   // interface start up
@@ -601,6 +619,33 @@ bool TCPIP_UDP_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
         _TCPIPStackSignalHandlerDeregister(signalHandle);
         return false;
     }
+
+    hashEntries = UDP_PORT_HASH_ENTRIES(pUdpInit->nSockets);
+    newPortHash = (OA_HASH_DCPT*)TCPIP_HEAP_Malloc(stackCtrl->memH, sizeof(OA_HASH_DCPT) + hashEntries * sizeof(UDP_PORT_HASH_ENTRY));
+    if(newPortHash == 0)
+    {
+        SYS_ERROR(SYS_ERROR_ERROR, "UDP Dynamic allocation failed");
+        TCPIP_HEAP_Free(stackCtrl->memH, newSktDcpt);
+        _UserGblLockDelete();
+        _TCPIPStackSignalHandlerDeregister(signalHandle);
+        return false;
+    }
+
+    newPortHash->memBlk = newPortHash + 1;
+    newPortHash->hParam = 0;
+    newPortHash->hEntrySize = sizeof(UDP_PORT_HASH_ENTRY);
+    newPortHash->hEntries = hashEntries;
+    newPortHash->probeStep = UDP_PORT_HASH_PROBE_STEP;
+#if defined ( OA_HASH_DYNAMIC_KEY_MANIPULATION )
+    newPortHash->hashF = _UDPPortHashKeyHash;
+#if defined(OA_DOUBLE_HASH_PROBING)
+    newPortHash->probeHash = _UDPPortHashProbeHash;
+#endif  // defined(OA_DOUBLE_HASH_PROBING)
+    newPortHash->delF = 0;      // never full: there cannot be more ports than sockets
+    newPortHash->cmpF = _UDPPortHashKeyCompare;
+    newPortHash->cpyF = _UDPPortHashKeyCopy; 
+#endif  // defined ( OA_HASH_DYNAMIC_KEY_MANIPULATION )
+    TCPIP_OAHASH_Initialize(newPortHash);
 #if (TCPIP_UDP_USE_POOL_BUFFERS != 0)
     TCPIP_Helper_SingleListInitialize (&udpPacketPool);
     udpPacketsInPool = pUdpInit->poolBuffers;
@@ -640,6 +685,8 @@ bool TCPIP_UDP_Initialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl, const
     nUdpSockets = pUdpInit->nSockets;
     udpDefTxSize = pUdpInit->sktTxBuffSize;
     UDPSocketDcpt = newSktDcpt;
+    udpPortHash = newPortHash;
+    udpPortHashProbeMax = 0;
 #if (TCPIP_UDP_EXTERN_PACKET_PROCESS != 0)
     udpPktHandler = 0;
 #endif  // (TCPIP_UDP_EXTERN_PACKET_PROCESS != 0)
@@ -720,8 +767,10 @@ void TCPIP_UDP_Deinitialize(const TCPIP_STACK_MODULE_CTRL* const stackCtrl)
             }
 
             TCPIP_HEAP_Free(udpMemH, UDPSocketDcpt);
+            TCPIP_HEAP_Free(udpMemH, udpPortHash);
 
             UDPSocketDcpt = 0;
+            udpPortHash = 0;
 
 #if (TCPIP_UDP_USE_POOL_BUFFERS != 0)
             // Note: no protection for this access
@@ -1014,7 +1063,7 @@ static UDP_SOCKET _UDPOpen(IP_ADDRESS_TYPE addType, UDP_OPEN_TYPE opType, UDP_PO
 
     // fill in all the socket parameters
     // so that the RX thread can see all the right data
-    pSkt->localPort = localPort;	
+    _UDPSocketPortSet(pSkt, localPort);
     pSkt->remotePort = remotePort;
     pSkt->addType = addType;
     pSkt->txAllocLimit = TCPIP_UDP_SOCKET_DEFAULT_TX_QUEUE_LIMIT; 
@@ -1691,6 +1740,11 @@ static uint16_t _UDPv4Flush(UDP_SOCKET_DCPT* pSkt)
         checksum = ~TCPIP_Helper_CalcIPChecksum((uint8_t*)pUDPHdr, sizeof(UDP_HEADER), checksum);
         checksum = ~TCPIP_Helper_CalcIPChecksum(pZSeg->segLoad, udpLoadLen, checksum);
     }
+    else if(pSkt->txSumEnd == pSkt->txWrite)
+    {   // payload already summed while copied; only the header left
+        checksum = ~TCPIP_Helper_CalcIPChecksum((uint8_t*)pUDPHdr, sizeof(UDP_HEADER), checksum);
+        checksum = TCPIP_Helper_ChecksumFold(checksum + TCPIP_Helper_ChecksumFold(pSkt->txSum));
+    }
     else
     {   // one contiguous buffer
         checksum = ~TCPIP_Helper_CalcIPChecksum((uint8_t*)pUDPHdr, udpTotLen, checksum);
@@ -2293,6 +2347,7 @@ static void _UDPClose(UDP_SOCKET_DCPT* pSkt)
     {   // acknowledge the old one
         _UDP_RxPktAcknowledge(pSkt->pCurrRxPkt, TCPIP_MAC_PKT_ACK_PROTO_DEST_CLOSE);
     }
+    _UDPSocketPortSet(pSkt, 0);
     UDPSocketDcpt[pSkt->sktIx] = 0;
     TCPIP_HEAP_Free(udpMemH, pSkt);
 }
@@ -2425,6 +2480,10 @@ bool TCPIP_UDP_TxOffsetSet(UDP_SOCKET s, uint16_t wOffset, bool relative)
 
         if(pSkt->txStart <= pNewWrite && pNewWrite <= pSkt->txEnd)
         {
+            if(pNewWrite != pSkt->txWrite)
+            {   // data written or overwritten directly; the accumulated checksum is no longer valid
+                pSkt->txSumEnd = 0;
+            }
             pSkt->txWrite = pNewWrite;
             return true;
         }        
@@ -2515,7 +2574,26 @@ uint16_t TCPIP_UDP_ArrayPut(UDP_SOCKET s, const uint8_t *cData, uint16_t wDataLe
 
             if(wDataLen)
             {
-                memcpy(pSkt->txWrite, cData, wDataLen);
+                if(pSkt->txWrite == pSkt->txStart)
+                {   // new payload
+                    pSkt->txSumEnd = pSkt->txStart;
+                    pSkt->txSum = 0;
+                }
+
+                if(pSkt->txSumEnd == pSkt->txWrite)
+                {   // the data so far is summed; copy and sum in one pass
+                    uint16_t sum = ~TCPIP_Helper_MemcpyChecksum(pSkt->txWrite, cData, wDataLen);
+                    if(((pSkt->txWrite - pSkt->txStart) & 0x1) != 0)
+                    {
+                        sum = TCPIP_Helper_htons(sum);
+                    }
+                    pSkt->txSum += sum;
+                    pSkt->txSumEnd = pSkt->txWrite + wDataLen;
+                }
+                else
+                {
+                    memcpy(pSkt->txWrite, cData, wDataLen);
+                }
                 pSkt->txWrite += wDataLen;
             }
 
@@ -2729,6 +2807,8 @@ uint16_t TCPIP_UDP_Discard(UDP_SOCKET s)
   Description:
 	This function attempts to match an incoming UDP segment to a currently
 	active socket for processing.
+	Only the sockets found in the port hash for the segment destination
+	port are checked.
 
   Precondition:
 	UDP segment header and IP header have both been retrieved.
@@ -2744,21 +2824,18 @@ uint16_t TCPIP_UDP_Discard(UDP_SOCKET s)
   ***************************************************************************/
 static UDP_SOCKET_DCPT* _UDPFindMatchingSocket(TCPIP_MAC_PACKET* pRxPkt, UDP_HEADER *h, IP_ADDRESS_TYPE addressType)
 {
-    int sktIx;
+    int snapIx, nSnaps;
+    UDP_SOCKET lastIx;
+    bool moreSkts;
+    UDP_PORT destPort;
+    UDP_PORT_HASH_ENTRY* pPE;
     UDP_SOCKET_DCPT *pSkt;
+    UDP_SKT_MATCH_SNAPSHOT *pSnap;
     TCPIP_NET_IF* pPktIf;
     TCPIP_UDP_PKT_MATCH exactMatch, looseMatch;
     OSAL_CRITSECT_DATA_TYPE critStatus;
     // snapshot of socket settings
-    UDP_PORT _localPort = 0, _remotePort = 0;
-    uint16_t _addType = 0;
-    TCPIP_NET_IF* _pSktNet = 0;
-#if defined (TCPIP_STACK_USE_IPV4)
-    IPV4_ADDR _pktSrcAddress;
-    _pktSrcAddress.Val = 0;
-#endif // defined (TCPIP_STACK_USE_IPV4)
-    TCPIP_UDP_SKT_FLAGS _flags; 
-    _flags.Val = 0;
+    UDP_SKT_MATCH_SNAPSHOT sktSnap[UDP_SKT_MATCH_SNAPSHOTS];
 
 
     // This packet is said to be matching with current socket:
@@ -2771,183 +2848,193 @@ static UDP_SOCKET_DCPT* _UDPFindMatchingSocket(TCPIP_MAC_PACKET* pRxPkt, UDP_HEA
     // 4. Packet incoming network interface matches the socket network interface or looseNetIf flag is set
     // and (IPv4 only for now)
     // 5. packet source address matches the socket expected source address or looseRemAddress flag is set
+    //
+    // 1. is solved by the port hash: only the sockets bound to the destination port are checked.
+    // These are snapshot in one critical section and checked in sktIx order,
+    // the same order the whole socket array used to be scanned.
     
 
     pPktIf = (TCPIP_NET_IF*)pRxPkt->pktIf;
-    for(sktIx = 0; sktIx < nUdpSockets; sktIx++)
+    destPort = h->DestinationPort;
+    lastIx = -1;
+    moreSkts = true;
+
+    while(moreSkts)
     {
-        bool processSkt = false;
+        nSnaps = 0;
+        moreSkts = false;
         critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
-        while(true)
+        pPE = udpPortHash != 0 ? _UDPPortHashLookup(destPort) : 0;
+        pSkt = pPE != 0 ? pPE->pSktList : 0;
+        for(; pSkt != 0; pSkt = pSkt->pPortNext)
         {
-            pSkt = UDPSocketDcpt[sktIx];
-            if(pSkt == 0) 
-            {   // not valid socket
+            if(pSkt->sktIx <= lastIx)
+            {   // already checked in a previous pass
+                continue;
+            }
+
+            if(nSnaps == UDP_SKT_MATCH_SNAPSHOTS)
+            {   // no more room; another pass is needed
+                moreSkts = true;
                 break;
             }
+
             if(_RxSktIsLocked(pSkt)) 
             {   // socket disabled
-                break;
+                continue;
             }
 
             if(TCPIP_Helper_SingleListCount(&pSkt->rxQueue) >= pSkt->rxQueueLimit)
             {   // RX limit exceeded
-                break;
+                continue;
             }
 
             // take a snapshot of socket settings
-            _localPort = pSkt->localPort;
-            _addType = pSkt->addType;
-            _remotePort = pSkt->remotePort;
-            _flags.Val = pSkt->flags.Val;
-            _pSktNet = pSkt->pSktNet;
+            pSnap = sktSnap + nSnaps++;
+            pSnap->pSkt = pSkt;
+            pSnap->sktIx = pSkt->sktIx;
+            pSnap->addType = pSkt->addType;
+            pSnap->remotePort = pSkt->remotePort;
+            pSnap->flags.Val = pSkt->flags.Val;
+            pSnap->pSktNet = pSkt->pSktNet;
 #if defined (TCPIP_STACK_USE_IPV4)
-            _pktSrcAddress.Val = pSkt->pktSrcAddress.Val;
+            pSnap->pktSrcAddress.Val = pSkt->pktSrcAddress.Val;
 #endif // defined (TCPIP_STACK_USE_IPV4)
-
-            processSkt = true;
-            break;
         }
         OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
 
-        if(processSkt == false)
+        for(snapIx = 0, pSnap = sktSnap; snapIx < nSnaps; snapIx++, pSnap++)
         {
-            continue;
-        }
-
-        // 1. packet destination port
-        if(_localPort != h->DestinationPort)
-        {   // cannot handle this port
-            continue;
-        }
-       
-        exactMatch = looseMatch = 0;
+            pSkt = pSnap->pSkt;
+            lastIx = pSnap->sktIx;
+            exactMatch = looseMatch = 0;
 
-        // 2. packet address type
-        if(_addType == addressType)
-        {
-            exactMatch = TCPIP_UDP_PKT_MATCH_IP_TYPE;
-        }
-        else if(_addType == IP_ADDRESS_TYPE_ANY)
-        {
-            looseMatch = TCPIP_UDP_PKT_MATCH_IP_TYPE;
-        }
-        else
-        {   // cannot handle this address type
-            continue;
-        }
-
-        // 3. packet source port
-        if(_remotePort == h->SourcePort)
-        {
-            exactMatch |= TCPIP_UDP_PKT_MATCH_SRC_PORT;
-        }
-        else if(_flags.looseRemPort != 0)
-        {
-            looseMatch |= TCPIP_UDP_PKT_MATCH_SRC_PORT;
-        }
+            // 2. packet address type
+            if(pSnap->addType == addressType)
+            {
+                exactMatch = TCPIP_UDP_PKT_MATCH_IP_TYPE;
+            }
+            else if(pSnap->addType == IP_ADDRESS_TYPE_ANY)
+            {
+                looseMatch = TCPIP_UDP_PKT_MATCH_IP_TYPE;
+            }
+            else
+            {   // cannot handle this address type
+                continue;
+            }
 
-        // 4. packet incoming interface
-#if defined (TCPIP_STACK_USE_IPV4)
-        if(addressType == IP_ADDRESS_TYPE_IPV4)
-        {
-            if(_pSktNet == pPktIf)
+            // 3. packet source port
+            if(pSnap->remotePort == h->SourcePort)
             {
-                exactMatch |= TCPIP_UDP_PKT_MATCH_NET;
+                exactMatch |= TCPIP_UDP_PKT_MATCH_SRC_PORT;
             }
-            else if(_pSktNet == 0 || _flags.looseNetIf != 0)
+            else if(pSnap->flags.looseRemPort != 0)
             {
-                looseMatch |= TCPIP_UDP_PKT_MATCH_NET;
+                looseMatch |= TCPIP_UDP_PKT_MATCH_SRC_PORT;
             }
-        }
-#endif  // defined (TCPIP_STACK_USE_IPV4)
 
-#if defined(TCPIP_STACK_USE_IPV6)
-        if(addressType == IP_ADDRESS_TYPE_IPV6)
-        {
-            if(_pSktNet == pPktIf)
+            // 4. packet incoming interface
+#if defined (TCPIP_STACK_USE_IPV4)
+            if(addressType == IP_ADDRESS_TYPE_IPV4)
             {
-                if(TCPIP_IPV6_AddressFind(pPktIf, TCPIP_IPV6_PacketGetDestAddress(pRxPkt), IPV6_ADDR_TYPE_UNICAST) != 0)
-                {   // interface match
+                if(pSnap->pSktNet == pPktIf)
+                {
                     exactMatch |= TCPIP_UDP_PKT_MATCH_NET;
                 }
+                else if(pSnap->pSktNet == 0 || pSnap->flags.looseNetIf != 0)
+                {
+                    looseMatch |= TCPIP_UDP_PKT_MATCH_NET;
+                }
             }
-            else if(_pSktNet == 0 || _flags.looseNetIf != 0)
+#endif  // defined (TCPIP_STACK_USE_IPV4)
+
+#if defined(TCPIP_STACK_USE_IPV6)
+            if(addressType == IP_ADDRESS_TYPE_IPV6)
             {
-                looseMatch |= TCPIP_UDP_PKT_MATCH_NET;
+                if(pSnap->pSktNet == pPktIf)
+                {
+                    if(TCPIP_IPV6_AddressFind(pPktIf, TCPIP_IPV6_PacketGetDestAddress(pRxPkt), IPV6_ADDR_TYPE_UNICAST) != 0)
+                    {   // interface match
+                        exactMatch |= TCPIP_UDP_PKT_MATCH_NET;
+                    }
+                }
+                else if(pSnap->pSktNet == 0 || pSnap->flags.looseNetIf != 0)
+                {
+                    looseMatch |= TCPIP_UDP_PKT_MATCH_NET;
+                }
             }
-        }
 #endif  // defined (TCPIP_STACK_USE_IPV6)
 
-        // 5. packet source address
+            // 5. packet source address
 #if defined (TCPIP_STACK_USE_IPV4)
-        if(addressType == IP_ADDRESS_TYPE_IPV4)
-        {
-            if(_pktSrcAddress.Val == 0 || _flags.looseRemAddress != 0)
+            if(addressType == IP_ADDRESS_TYPE_IPV4)
             {
-                looseMatch |= TCPIP_UDP_PKT_MACTH_SRC_ADD;
-            }
-            else if(_pktSrcAddress.Val == TCPIP_IPV4_PacketGetSourceAddress(pRxPkt)->Val)
-            {
-                exactMatch |= TCPIP_UDP_PKT_MACTH_SRC_ADD;
+                if(pSnap->pktSrcAddress.Val == 0 || pSnap->flags.looseRemAddress != 0)
+                {
+                    looseMatch |= TCPIP_UDP_PKT_MACTH_SRC_ADD;
+                }
+                else if(pSnap->pktSrcAddress.Val == TCPIP_IPV4_PacketGetSourceAddress(pRxPkt)->Val)
+                {
+                    exactMatch |= TCPIP_UDP_PKT_MACTH_SRC_ADD;
+                }
             }
-        }
 #endif // defined (TCPIP_STACK_USE_IPV4)
 
 #if defined(TCPIP_STACK_USE_IPV6)
-        if(addressType == IP_ADDRESS_TYPE_IPV6)
-        {
-            // no IPv6 check done
-            exactMatch |= TCPIP_UDP_PKT_MACTH_SRC_ADD;
-        }
+            if(addressType == IP_ADDRESS_TYPE_IPV6)
+            {
+                // no IPv6 check done
+                exactMatch |= TCPIP_UDP_PKT_MACTH_SRC_ADD;
+            }
 #endif // defined(TCPIP_STACK_USE_IPV6)
 
-        // finally check the match we got
-        if(exactMatch == TCPIP_UDP_PKT_MACTH_MASK)
-        {   // perfect match
-            return pSkt;
-        }
-        else if( (looseMatch | exactMatch) == TCPIP_UDP_PKT_MACTH_MASK )
-        {   // overall match; adjust and return
+            // finally check the match we got
+            if(exactMatch == TCPIP_UDP_PKT_MACTH_MASK)
+            {   // perfect match
+                return pSkt;
+            }
+            else if( (looseMatch | exactMatch) == TCPIP_UDP_PKT_MACTH_MASK )
+            {   // overall match; adjust and return
 #if defined (TCPIP_STACK_USE_IPV6)
-            if (addressType == IP_ADDRESS_TYPE_IPV6)
-            {   // lazy allocation does not work for IPv6
-                // This is expensive and IPv6 should be able to delay the allocation, like IPv4 does!
-                // avoid user threads mess with this
-                if(pSkt->pV6Pkt == 0)
-                {   // could be a server socket opened with IP_ADDRESS_TYPE_ANY
-                    IPV6_PACKET* pNewPkt = _UDPv6AllocateTxPacketStruct(pPktIf, pSkt, false);
-                    if(pNewPkt == 0)
-                    {   // failed to allocate memory; not much we can do
-                        return 0;
-                    }
-
-                    // stop the user threads from messing with this socket TX buffer
-                    bool useOldPkt = false;
-                    critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+                if (addressType == IP_ADDRESS_TYPE_IPV6)
+                {   // lazy allocation does not work for IPv6
+                    // This is expensive and IPv6 should be able to delay the allocation, like IPv4 does!
+                    // avoid user threads mess with this
                     if(pSkt->pV6Pkt == 0)
-                    {   // we can use the new packet
-                        _UDPSocketTxSet(pSkt, pNewPkt, pNewPkt->clientData, IP_ADDRESS_TYPE_IPV6);
-                    }
-                    else
-                    {
-                        useOldPkt = true;
-                    }
-                    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+                    {   // could be a server socket opened with IP_ADDRESS_TYPE_ANY
+                        IPV6_PACKET* pNewPkt = _UDPv6AllocateTxPacketStruct(pPktIf, pSkt, false);
+                        if(pNewPkt == 0)
+                        {   // failed to allocate memory; not much we can do
+                            return 0;
+                        }
 
-                    if(useOldPkt)
-                    {
-                        _UDPv6FreePacket(pNewPkt);
+                        // stop the user threads from messing with this socket TX buffer
+                        bool useOldPkt = false;
+                        critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+                        if(pSkt->pV6Pkt == 0)
+                        {   // we can use the new packet
+                            _UDPSocketTxSet(pSkt, pNewPkt, pNewPkt->clientData, IP_ADDRESS_TYPE_IPV6);
+                        }
+                        else
+                        {
+                            useOldPkt = true;
+                        }
+                        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+
+                        if(useOldPkt)
+                        {
+                            _UDPv6FreePacket(pNewPkt);
+                        }
                     }
                 }
-            }
 #endif  // defined (TCPIP_STACK_USE_IPV6)
-            
-            pSkt->addType = addressType;
-            return pSkt;
-        }
 
-        // no match, continue
+                pSkt->addType = addressType;
+                return pSkt;
+            }
+
+            // no match, continue
+        }
     }
 
     // not found
@@ -3100,7 +3187,7 @@ bool TCPIP_UDP_Bind(UDP_SOCKET s, IP_ADDRESS_TYPE addType, UDP_PORT localPort,
     }
     if(bindSuccess)
     {
-        pSkt->localPort = localPort;
+        _UDPSocketPortSet(pSkt, localPort);
     }
     else
     {   // restore old add type
@@ -3540,21 +3627,149 @@ static UDP_PORT _UDPAllocateEphemeralPort(void)
 
 static bool _UDPIsAvailablePort(UDP_PORT port)
 {
-    int skt;
-    UDP_SOCKET_DCPT *pSkt;
+    UDP_PORT_HASH_ENTRY* pPE;
+
+    OSAL_CRITSECT_DATA_TYPE critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+    pPE = _UDPPortHashLookup(port);
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+
+    return pPE == 0;
+}
 
-    // Find an available socket that matches the specified socket type
-    for(skt = 0; skt < nUdpSockets; skt++)
+// looks up a port in the port hash
+// TCPIP_OAHASH_EntryLookup probes every bucket before it reports a miss:
+// a removed port leaves a free bucket that may sit in the probe sequence of another port.
+// A port is always found within its probeCount steps, so the search stops
+// after the longest probe of the ports inserted since the hash was last empty
+// Called within a critical section
+static UDP_PORT_HASH_ENTRY* _UDPPortHashLookup(UDP_PORT port)
+{
+    UDP_PORT_HASH_ENTRY* pPE;
+    size_t bktIx, probeStep;
+    int probes;
+
+#if defined(OA_DOUBLE_HASH_PROBING)
+    if((probeStep = _UDPPortHashProbeHash(udpPortHash, &port)) == 0)
     {
-        pSkt = UDPSocketDcpt[skt]; 
-        if(pSkt && pSkt->localPort == port)
+        probeStep = udpPortHash->probeStep;
+    }
+#else
+    probeStep = udpPortHash->probeStep;
+#endif  // defined(OA_DOUBLE_HASH_PROBING)
+    bktIx = _UDPPortHashKeyHash(udpPortHash, &port);
+
+    for(probes = 0; probes <= udpPortHashProbeMax; probes++)
+    {
+        pPE = (UDP_PORT_HASH_ENTRY*)TCPIP_OAHASH_EntryGet(udpPortHash, bktIx);
+        if(pPE->hEntry.flags.busy != 0 && pPE->port == port)
         {
-            return false;
+            return pPE;
+        }
+
+        if((bktIx += probeStep) >= udpPortHash->hEntries)
+        {
+            bktIx -= udpPortHash->hEntries;
         }
     }
 
-    return true;
+    return 0;
+}
+
+// changes the socket local port and updates the port hash
+// the socket is moved to the list of the new port
+// port == 0 just removes the socket from the hash
+// The update is done in a critical section, the RX thread sees
+// either the old or the new port
+static void _UDPSocketPortSet(UDP_SOCKET_DCPT* pSkt, UDP_PORT port)
+{
+    OA_HASH_ENTRY* hE;
+    UDP_PORT_HASH_ENTRY* pPE;
+    UDP_SOCKET_DCPT **ppPrev, *pCurr;
+
+    OSAL_CRITSECT_DATA_TYPE critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_LOW);
+
+    if(pSkt->localPort != 0)
+    {   // remove from the old port list
+        if((pPE = _UDPPortHashLookup(pSkt->localPort)) != 0)
+        {
+            for(ppPrev = &pPE->pSktList; (pCurr = *ppPrev) != 0; ppPrev = &pCurr->pPortNext)
+            {
+                if(pCurr == pSkt)
+                {
+                    *ppPrev = pSkt->pPortNext;
+                    break;
+                }
+            }
+
+            if(pPE->pSktList == 0)
+            {
+                TCPIP_OAHASH_EntryRemove(udpPortHash, &pPE->hEntry);
+                if(udpPortHash->fullSlots == 0)
+                {
+                    udpPortHashProbeMax = 0;
+                }
+            }
+        }
+        pSkt->pPortNext = 0;
+    }
+
+    pSkt->localPort = port;
+
+    if(port != 0)
+    {   // add to the new port list, keeping the sktIx order
+        // insert only a port not in the hash: TCPIP_OAHASH_EntryLookupOrInsert stops at the first free bucket
+        // and would add a second entry for a port further down the probe sequence
+        // cannot fail: the hash has more entries than sockets
+        if((pPE = _UDPPortHashLookup(port)) == 0 && (hE = TCPIP_OAHASH_EntryLookupOrInsert(udpPortHash, &port)) != 0)
+        {
+            pPE = (UDP_PORT_HASH_ENTRY*)hE;
+            pPE->pSktList = 0;
+            if(hE->probeCount > udpPortHashProbeMax)
+            {
+                udpPortHashProbeMax = hE->probeCount;
+            }
+        }
+
+        if(pPE != 0)
+        {
+            for(ppPrev = &pPE->pSktList; (pCurr = *ppPrev) != 0; ppPrev = &pCurr->pPortNext)
+            {
+                if(pCurr->sktIx > pSkt->sktIx)
+                {
+                    break;
+                }
+            }
+            pSkt->pPortNext = pCurr;
+            *ppPrev = pSkt;
+        }
+    }
+
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_LOW, critStatus);
+}
+
+#if defined ( OA_HASH_DYNAMIC_KEY_MANIPULATION )
+static size_t _UDPPortHashKeyHash(OA_HASH_DCPT* pOH, const void* key)
+{
+    return *(const UDP_PORT*)key % pOH->hEntries;
+}
+
+#if defined(OA_DOUBLE_HASH_PROBING)
+static size_t _UDPPortHashProbeHash(OA_HASH_DCPT* pOH, const void* key)
+{
+    return fnv_32a_hash(key, sizeof(UDP_PORT)) % pOH->hEntries;
+}
+#endif  // defined(OA_DOUBLE_HASH_PROBING)
+
+static int _UDPPortHashKeyCompare(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* hEntry, const void* key)
+{
+    return ((UDP_PORT_HASH_ENTRY*)hEntry)->port != *(const UDP_PORT*)key;
+}
+
+static void _UDPPortHashKeyCopy(OA_HASH_DCPT* pOH, OA_HASH_ENTRY* dstEntry, const void* key)
+{
+    ((UDP_PORT_HASH_ENTRY*)dstEntry)->port = *(const UDP_PORT*)key;
 }
+#endif  // defined ( OA_HASH_DYNAMIC_KEY_MANIPULATION )
 
 TCPIP_UDP_SIGNAL_HANDLE TCPIP_UDP_SignalHandlerRegister(UDP_SOCKET s, TCPIP_UDP_SIGNAL_TYPE sigMask, TCPIP_UDP_SIGNAL_FUNCTION handler, const void* hParam)
 {
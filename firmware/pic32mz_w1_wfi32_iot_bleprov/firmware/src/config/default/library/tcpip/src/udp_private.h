@@ -132,12 +132,14 @@ typedef union
 
 
 // Stores information about a current UDP socket
-typedef struct
+typedef struct _tag_UDP_SOCKET_DCPT
 {
     // TX side
     uint8_t*        txStart;        // internal TX Buffer; both IPv4 and IPv6
     uint8_t*        txEnd;          // end of TX Buffer
     uint8_t*        txWrite;        // current write pointer into the TX Buffer
+    uint8_t*        txSumEnd;       // end of the TX data covered by txSum; 0 if txSum not valid
+    uint32_t        txSum;          // checksum of the TX data, accumulated by TCPIP_UDP_ArrayPut
     union
     {
         IPV4_PACKET*  pV4Pkt;        // IPv4 use; UDP_V4_PACKET type
@@ -201,6 +203,10 @@ typedef struct
                                     // Set by:
                                     //      - _UDPOpen for server; 0/ephemeral for client
                                     //      - TCPIP_UDP_Bind()
+                                    // Always changed with _UDPSocketPortSet()
+                                    // so that the port hash stays in sync
+    struct _tag_UDP_SOCKET_DCPT* pPortNext; // next socket with the same localPort
+                                    // in the port hash list, ascending sktIx order
     // rx side
     TCPIP_MAC_PACKET       *pCurrRxPkt;   // current RX packet 
     TCPIP_MAC_DATA_SEGMENT *pCurrRxSeg;   // current segment in the current packet
@@ -245,6 +251,43 @@ typedef struct
 
 } UDP_SOCKET_DCPT;
 
+// local port hash
+// Sockets are indexed by their localPort so that an incoming packet
+// is matched only against the sockets having its destination port.
+// Multiple sockets can share the same local port (server sockets on
+// different interfaces/address types, etc.) so each entry holds a list.
+typedef struct
+{
+    OA_HASH_ENTRY       hEntry;         // hash header
+    UDP_SOCKET_DCPT*    pSktList;       // sockets bound to this port, ascending sktIx order
+    UDP_PORT            port;           // local port: the hash key
+}UDP_PORT_HASH_ENTRY;
+
+// number of hash entries for a number of sockets
+// there cannot be more ports than sockets; keep some slack for the probing
+#define UDP_PORT_HASH_ENTRIES(nSkts)    ((nSkts) + (nSkts) / 2 + 1)
+
+#define UDP_PORT_HASH_PROBE_STEP        1
+
+// snapshot of the socket settings used for the incoming packet match
+typedef struct
+{
+    UDP_SOCKET_DCPT*    pSkt;
+    TCPIP_NET_IF*       pSktNet;
+#if defined (TCPIP_STACK_USE_IPV4)
+    IPV4_ADDR           pktSrcAddress;
+#endif // defined (TCPIP_STACK_USE_IPV4)
+    UDP_SOCKET          sktIx;
+    UDP_PORT            remotePort;
+    uint16_t            addType;
+    TCPIP_UDP_SKT_FLAGS flags;
+}UDP_SKT_MATCH_SNAPSHOT;
+
+// max number of sockets that are snapshot in one critical section
+// when matching an incoming packet
+// If more sockets share the same port, the match continues with another pass.
+#define UDP_SKT_MATCH_SNAPSHOTS         4
+
 
 #endif  // __UDP_PRIVATE_H_
 
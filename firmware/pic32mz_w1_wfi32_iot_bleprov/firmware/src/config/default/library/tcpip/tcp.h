@@ -158,6 +158,7 @@ typedef enum
     TCP_SOCKET_FLAG_CONNECTED   = 0x02,     // socket is currently connected
     TCP_SOCKET_FLAG_RST         = 0x04,     // remote party issued a reset
     TCP_SOCKET_FLAG_FIN         = 0x08,     // remote party issued a FIN
+    TCP_SOCKET_FLAG_SACK        = 0x10,     // selective acknowledgments negotiated with the remote party
 } TCP_SOCKET_FLAGS;
 
 
@@ -188,6 +189,11 @@ typedef struct
     uint16_t            rxPending;          // bytes pending in RX buffer
     uint16_t            txPending;          // bytes pending in TX buffer
     TCP_SOCKET_FLAGS    flags;              // socket flags
+    uint32_t            srtt;               // smoothed round trip time, ms; 0 if not measured yet
+    uint32_t            rttVar;             // round trip time variation, ms
+    uint32_t            rto;                // current retransmission timeout, ms
+    uint32_t            rtoCount;           // number of retransmission timeouts
+    uint32_t            fastRtxCount;       // number of segments retransmitted on duplicate ACKs/SACK
 } TCP_SOCKET_INFO;
 
 // *****************************************************************************
@@ -252,6 +258,21 @@ typedef enum
                                     // If 0, the socket will use the default global IPv4 TTL setting.
                                     // This option allows the user to specify a different TTL value.
     TCP_OPTION_TOS,     			// Sets the Type of Service (TOS) for IPv4 packets sent by the socket
+    TCP_OPTION_RX_AUTOTUNE,         // Enables/disables the automatic growth of the RX buffer based on the
+                                    // observed round trip time and receive rate.
+                                    // The default setting is enabled when TCPIP_TCP_AUTOTUNE_MEM_BUDGET != 0.
+    TCP_OPTION_DELAYED_ACK_TMO,     // Sets the delayed acknowledgement timeout for the socket, in ms.
+                                    // If 0, every received segment is acknowledged immediately.
+                                    // The maximum value is 500 ms.
+                                    // The default setting is TCPIP_TCP_DELAYED_ACK_TIMEOUT.
+    TCP_OPTION_QUICK_ACK,           // Acknowledges immediately the next N received segments, bypassing the delayed ACK.
+                                    // Useful for request/response protocols where the reply is not sent right away.
+                                    // The count is not persistent; it decrements with every received segment.
+    TCP_OPTION_CORK,                // Enables/disables the socket cork.
+                                    // While corked, the socket sends only full size segments;
+                                    // partial segments are held until TCPIP_TCP_Flush is called or the socket is uncorked.
+                                    // Uncorking the socket transmits all pending data.
+                                    // The default setting is disabled.
 } TCP_SOCKET_OPTION;
 
 
@@ -755,6 +776,10 @@ bool  TCPIP_TCP_RemoteBind(TCP_SOCKET hTCP, IP_ADDRESS_TYPE addType, TCP_PORT re
                       - TCP_OPTION_DELAY_SEND_ALL_ACK   - boolean to enable/disable the DELAY Send All ACK data functionality
                       - TCP_OPTION_TX_TTL              - 8-bit value of TTL
 					  - TCP_OPTION_TOS                 - 8-bit value of the TOS
+                      - TCP_OPTION_RX_AUTOTUNE         - boolean to enable/disable the RX buffer autotuning
+                      - TCP_OPTION_DELAYED_ACK_TMO     - 16-bit value of the delayed ACK timeout, ms
+                      - TCP_OPTION_QUICK_ACK           - 8-bit number of segments to be acknowledged immediately
+                      - TCP_OPTION_CORK                - boolean to cork/uncork the socket
 
   Returns:
     - true  - Indicates success
@@ -797,6 +822,10 @@ bool  TCPIP_TCP_OptionsSet(TCP_SOCKET hTCP, TCP_SOCKET_OPTION option, void* optP
                       - TCP_OPTION_DELAY_SEND_ALL_ACK   - pointer to boolean to return current DELAY Send All ACK status
                       - TCP_OPTION_TX_TTL               - pointer to an 8 bit value to receive the TTL value
 			 		  - TCP_OPTION_TOS				    - pointer to an 8 bit value to receive the TOS
+                      - TCP_OPTION_RX_AUTOTUNE          - pointer to boolean to return current RX autotuning status
+                      - TCP_OPTION_DELAYED_ACK_TMO      - pointer to a 16 bit value to receive the delayed ACK timeout
+                      - TCP_OPTION_QUICK_ACK            - pointer to an 8 bit value to receive the segments still to be quick acknowledged
+                      - TCP_OPTION_CORK                 - pointer to boolean to return current cork status
 
   Returns:
     - true  - Indicates success
@@ -1068,6 +1097,8 @@ bool  TCPIP_TCP_Close(TCP_SOCKET hTCP);
   Description:
     Fills the provided TCP_SOCKET_INFO structure associated with this socket.
     This contains the IP addresses and port numbers for both the local and remote endpoints.
+    The round trip time and retransmission statistics of the current
+    connection are also reported.
 
   Precondition:
     TCP is initialized and the socket is connected.
@@ -1236,6 +1267,10 @@ const uint8_t*      TCPIP_TCP_StringPut(TCP_SOCKET hTCP, const uint8_t* Data);
     it needed into the TCP buffer and it makes sense to flush the socket instead
     of waiting TCP_AUTO_TRANSMIT_TIMEOUT_VAL timeout to elapse.
 
+    For a corked socket (TCP_OPTION_CORK) this call marks a message boundary:
+    all the data written so far is transmitted, while data written afterwards
+    stays corked.
+
  */
 bool  TCPIP_TCP_Flush(TCP_SOCKET hTCP);
 
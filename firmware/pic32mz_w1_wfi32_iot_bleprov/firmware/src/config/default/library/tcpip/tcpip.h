@@ -709,6 +709,7 @@ typedef struct TCPIP_STACK_INIT
 #include "tcpip/dnss.h"
 #include "tcpip/icmp.h"
 #include "tcpip/lldp.h"
+#include "tcpip/iperf.h"
 #include "tcpip/tcpip_commands.h"
 #endif  // __TCPIP_H__
 
@@ -79,6 +79,49 @@
 #define _SYS_TIME_HANDLE_TOKEN_MAX              (0xFFFF)
 #define _SYS_TIME_INDEX_MASK                    (0x0000FFFFUL)
 
+// *****************************************************************************
+/* Timer Wheel Macros
+
+  Summary:
+    Timer wheel geometry.
+
+  Description:
+    Active timers are kept in a hierarchical timer wheel. Each level has
+    _SYS_TIME_WHEEL_SLOTS slots, a level 0 slot spans
+    2^SYS_TIME_WHEEL_TICK_SHIFT hardware counts and every further level is
+    _SYS_TIME_WHEEL_SLOTS times coarser. Timers in the upper levels are
+    cascaded down as the wheel reaches their slot, and level 0 timers are
+    expired against their exact expiry count, so the slot size only affects
+    how often the wheel is cascaded, not the timer accuracy.
+
+    The levels cover 2^(SYS_TIME_WHEEL_TICK_SHIFT + 5 * levels) counts, which
+    must exceed the longest timer (32 bits) plus the time the wheel can lag
+    behind the counter (half the hardware counter period).
+
+  Remarks:
+    None
+*/
+
+#ifndef SYS_TIME_WHEEL_TICK_SHIFT
+#define SYS_TIME_WHEEL_TICK_SHIFT               (14)
+#endif
+
+#define _SYS_TIME_WHEEL_SLOT_BITS               (5)
+#define _SYS_TIME_WHEEL_SLOTS                   (1UL << _SYS_TIME_WHEEL_SLOT_BITS)
+#define _SYS_TIME_WHEEL_SLOT_MASK               (_SYS_TIME_WHEEL_SLOTS - 1)
+#define _SYS_TIME_WHEEL_LEVELS                  ((33 - SYS_TIME_WHEEL_TICK_SHIFT + _SYS_TIME_WHEEL_SLOT_BITS - 1) / _SYS_TIME_WHEEL_SLOT_BITS)
+#define _SYS_TIME_WHEEL_SHIFT(level)            (SYS_TIME_WHEEL_TICK_SHIFT + ((level) * _SYS_TIME_WHEEL_SLOT_BITS))
+
+/* wheelLevel values of a timer that is not linked into a wheel slot */
+#define _SYS_TIME_WHEEL_NONE                    (0xFF)
+#define _SYS_TIME_WHEEL_EXPIRED                 (0xFE)
+
+#define _SYS_TIME_WHEEL_NO_EXPIRY               (UINT64_MAX)
+
+#if (SYS_TIME_MAX_TIMERS > _SYS_TIME_INDEX_MASK)
+#error "SYS_TIME_MAX_TIMERS does not fit in the timer handle index"
+#endif
+
 // *****************************************************************************
 /* SYS TIME OBJECT INSTANCE structure
 
@@ -97,12 +140,17 @@ typedef struct _SYS_TIME_TIMER_OBJ{
       bool                          active;    /* TRUE if soft timer enabled */
       SYS_TIME_CALLBACK_TYPE        type;    /* periodic or not */
       uint32_t                      requestedTime;    /* time requested */
-      volatile uint32_t             relativeTimePending;    /* time to wait, relative incase of timers in the list */
+      volatile uint32_t             relativeTimePending;    /* time to wait when the timer is (re)started */
+      uint64_t                      expiry;    /* counter value at which the timer elapses */
       SYS_TIME_CALLBACK             callback;    /* set to TRUE at timeout */
       uintptr_t                     context; /* context */
       volatile bool                 tmrElapsedFlag;   /* Set on every timer expiry. Cleared after user reads the status. */
-      volatile bool                 tmrElapsed;    /* Set on every timer expiry. Cleared after timer is added back to the list */
-      struct _SYS_TIME_TIMER_OBJ*   tmrNext; /* Next timer */
+      volatile bool                 tmrElapsed;    /* Set on every timer expiry. Cleared after timer is added back to the wheel */
+      uint8_t                       wheelLevel;    /* wheel level holding the timer, or _SYS_TIME_WHEEL_NONE/_EXPIRED */
+      uint8_t                       wheelSlot;    /* slot within wheelLevel */
+      struct _SYS_TIME_TIMER_OBJ*   tmrNext; /* Next timer in the wheel slot or the free list */
+      struct _SYS_TIME_TIMER_OBJ*   tmrPrev; /* Previous timer in the wheel slot */
+      struct _SYS_TIME_TIMER_OBJ*   tmrExpiredNext; /* Next timer expired in the same interrupt */
       SYS_TIME_HANDLE               tmrHandle; /* Unique handle for object */
 } SYS_TIME_TIMER_OBJ;
 
@@ -120,7 +168,13 @@ typedef struct{
     volatile uint32_t               swCounter64Low;           /* Software counter */
     volatile uint32_t               swCounter64High;          /* Software 64-bit counter */
     uint8_t                         interruptNestingCount;
-    SYS_TIME_TIMER_OBJ*             tmrActive;
+    uint64_t                        swCounterOffset;          /* Set by SYS_TIME_CounterSet */
+    volatile uint64_t               tmrDeadline;              /* Counter value the compare is programmed for */
+    uint64_t                        wheelTime;                /* Counter value the wheel has been advanced to */
+    uint32_t                        wheelCount;               /* Timers linked into the wheel */
+    uint32_t                        wheelBitmap[_SYS_TIME_WHEEL_LEVELS];    /* Occupied slots */
+    SYS_TIME_TIMER_OBJ*             wheel[_SYS_TIME_WHEEL_LEVELS][_SYS_TIME_WHEEL_SLOTS];
+    SYS_TIME_TIMER_OBJ*             tmrFree;                  /* Unused timer objects */
     /* Mutex to protect access to the shared resources */
     OSAL_MUTEX_DECLARE(timerMutex);
 
@@ -87,6 +87,83 @@ typedef struct
     
 } SYS_WIFI_STA_CONNECTION_INFO;
 
+/* Number of events the Wi-Fi service can hold before the task runs */
+#ifndef SYS_WIFI_EVENT_QUEUE_SIZE
+#define SYS_WIFI_EVENT_QUEUE_SIZE             16
+#endif
+
+/* Re-check interval for the few states that have no event source
+   (driver/TCPIP stack init, NVM busy), in milliseconds */
+#ifndef SYS_WIFI_POLL_INTERVAL_MS
+#define SYS_WIFI_POLL_INTERVAL_MS             10
+#endif
+
+/* Interval used to look up the DHCP server lease of a connected STA */
+#define SYS_WIFI_STA_IP_POLL_MS               500
+
+typedef enum
+{
+    /* Wake up only; re-evaluate the current state */
+    SYS_WIFI_EVENT_WAKEUP = 0,
+
+    /* Driver: PIC32MZW1 STA connected to HOMEAP */
+    SYS_WIFI_EVENT_STA_CONNECTED,
+
+    /* Driver: PIC32MZW1 STA connection attempt failed */
+    SYS_WIFI_EVENT_STA_CONN_FAILED,
+
+    /* Driver: PIC32MZW1 STA disconnected from HOMEAP */
+    SYS_WIFI_EVENT_STA_DISCONNECTED,
+
+    /* Driver: a STA connected to the PIC32MZW1 AP */
+    SYS_WIFI_EVENT_AP_STA_CONNECTED,
+
+    /* Driver: a STA disconnected from the PIC32MZW1 AP */
+    SYS_WIFI_EVENT_AP_STA_DISCONNECTED,
+
+    /* Timer: check the DHCP server leases of a connected STA */
+    SYS_WIFI_EVENT_AP_STA_LEASE_CHECK,
+
+    /* DHCP client: IP address bound */
+    SYS_WIFI_EVENT_DHCP_BOUND,
+
+    /* DHCP client: IP address lost */
+    SYS_WIFI_EVENT_DHCP_CONN_LOST,
+
+    /* TCP/IP stack: interface connection established or lost */
+    SYS_WIFI_EVENT_TCPIP_CONN,
+
+} SYS_WIFI_EVENT;
+
+typedef struct
+{
+    /* Event type */
+    SYS_WIFI_EVENT event;
+
+    /* Assoc handle the event refers to */
+    WDRV_PIC32MZW_ASSOC_HANDLE assocHandle;
+
+    /* Event specific context (STA connection info, TCP/IP event, ...) */
+    uintptr_t context;
+
+} SYS_WIFI_EVENT_MSG;
+
+typedef struct
+{
+    /* Event storage */
+    SYS_WIFI_EVENT_MSG msg[SYS_WIFI_EVENT_QUEUE_SIZE];
+
+    /* Read index, updated by the Wi-Fi service task */
+    uint16_t head;
+
+    /* Write index, updated by the event producers */
+    uint16_t tail;
+
+    /* Number of queued events */
+    uint16_t count;
+
+} SYS_WIFI_EVENT_QUEUE;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Global Data
@@ -133,6 +210,26 @@ bool      g_isRegDomainSetReq = false;
 
 /* Semaphore for Critical Section */
 static    OSAL_SEM_HANDLE_TYPE  g_wifiSrvcSemaphore;
+
+/* Events from the driver, TCP/IP stack and timers, consumed by the service task */
+static    SYS_WIFI_EVENT_QUEUE  g_wifiSrvcEventQueue;
+
+/* Binary semaphore signalled for every queued event, the service task
+   sleeps on it. Posts may merge: the events themselves are kept in the
+   queue and each wake up drains all of them */
+static    OSAL_SEM_HANDLE_TYPE  g_wifiSrvcEventSemaphore;
+
+/* TCP/IP stack event handler */
+static    TCPIP_EVENT_HANDLE    g_wifiSrvcTcpipEvHdl = NULL;
+
+/* Time-in-state metrics */
+static    SYS_WIFI_STATE_METRICS g_wifiSrvcMetrics;
+
+/* Timestamp of the last state transition */
+static    uint64_t              g_wifiSrvcStateEnterTime;
+
+/* Timestamp of the last connect request, start of the connection setup */
+static    uint64_t              g_wifiSrvcConnStartTime;
 // *****************************************************************************
 
 // *****************************************************************************
@@ -383,12 +480,71 @@ static inline bool SYS_WIFI_GetAutoConnect(void)
 
 }
 
-static inline void SYS_WIFI_SetTaskstatus
+static inline uint32_t SYS_WIFI_ElapsedMS(uint64_t start, uint64_t now)
+{
+    return (uint32_t)(((now - start) * 1000) / SYS_TIME_FrequencyGet());
+}
+
+static void SYS_WIFI_SetTaskstatus
 (
     SYS_WIFI_STATUS status
 )
 {
+    SYS_WIFI_STATUS prevStatus = g_wifiSrvcObj.wifiSrvcStatus;
+    SYS_WIFI_STATE_METRICS_ENTRY *pEntry;
+    uint64_t now;
+    uint32_t timeMs;
+    bool ipReady;
+
     g_wifiSrvcObj.wifiSrvcStatus = status;
+    if (prevStatus == status)
+    {
+        return;
+    }
+
+    /* Account the time spent in the state being left */
+    now = SYS_TIME_Counter64Get();
+    if (prevStatus < SYS_WIFI_STATUS_NUM)
+    {
+        pEntry = &g_wifiSrvcMetrics.state[prevStatus];
+        timeMs = SYS_WIFI_ElapsedMS(g_wifiSrvcStateEnterTime, now);
+        pEntry->totalTimeMs += timeMs;
+        if (timeMs > pEntry->maxTimeMs)
+        {
+            pEntry->maxTimeMs = timeMs;
+        }
+    }
+    g_wifiSrvcStateEnterTime = now;
+
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_WIFI_STATE, status);
+
+    if (status < SYS_WIFI_STATUS_NUM)
+    {
+        g_wifiSrvcMetrics.state[status].entryCount++;
+    }
+
+    /* The interface has an address: the STA got its DHCP lease or the AP
+       interface is up. In STA mode TCPIP_READY is entered right after the
+       connect request, before association and DHCP, so it cannot be used */
+    ipReady = (SYS_WIFI_STATUS_STA_IP_RECIEVED == status) ||
+              ((SYS_WIFI_STATUS_TCPIP_READY == status) && (SYS_WIFI_STATUS_WAIT_FOR_AP_IP == prevStatus));
+
+    if (SYS_WIFI_STATUS_CONNECT_REQ == status)
+    {
+        g_wifiSrvcConnStartTime = now;
+    }
+    else if (ipReady && (0 != g_wifiSrvcConnStartTime))
+    {
+        /* Connection setup complete: connect request to IP address */
+        g_wifiSrvcMetrics.lastConnectTimeMs = SYS_WIFI_ElapsedMS(g_wifiSrvcConnStartTime, now);
+        g_wifiSrvcConnStartTime = 0;
+    }
+
+    if (ipReady)
+    {
+        /* First IP, the boot trace ignores later calls */
+        SYS_BOOTTRACE_Complete();
+    }
 }
 
 static inline SYS_WIFI_STATUS SYS_WIFI_GetTaskstatus(void)
@@ -410,84 +566,156 @@ static inline void SYS_WIFI_PrintWifiConfig(void)
     }
 
 }
+
+static bool SYS_WIFI_EventEnqueue
+(
+    const SYS_WIFI_EVENT_MSG *pMsg
+)
+{
+    OSAL_CRITSECT_DATA_TYPE critStatus;
+    bool ret = false;
+
+    /* Producers include the SYS_TIME ISR, so mask interrupts */
+    critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+    if (g_wifiSrvcEventQueue.count < SYS_WIFI_EVENT_QUEUE_SIZE)
+    {
+        g_wifiSrvcEventQueue.msg[g_wifiSrvcEventQueue.tail] = *pMsg;
+        g_wifiSrvcEventQueue.tail = (g_wifiSrvcEventQueue.tail + 1) % SYS_WIFI_EVENT_QUEUE_SIZE;
+        g_wifiSrvcEventQueue.count++;
+        g_wifiSrvcMetrics.eventCount++;
+        ret = true;
+    }
+    else
+    {
+        g_wifiSrvcMetrics.eventDropCount++;
+    }
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critStatus);
+
+    return ret;
+}
+
+static bool SYS_WIFI_EventDequeue
+(
+    SYS_WIFI_EVENT_MSG *pMsg
+)
+{
+    OSAL_CRITSECT_DATA_TYPE critStatus;
+    bool ret = false;
+
+    critStatus = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+    if (g_wifiSrvcEventQueue.count > 0)
+    {
+        *pMsg = g_wifiSrvcEventQueue.msg[g_wifiSrvcEventQueue.head];
+        g_wifiSrvcEventQueue.head = (g_wifiSrvcEventQueue.head + 1) % SYS_WIFI_EVENT_QUEUE_SIZE;
+        g_wifiSrvcEventQueue.count--;
+        ret = true;
+    }
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critStatus);
+
+    return ret;
+}
+
+/* Queue an event for the Wi-Fi service task and wake it up.
+   Task context only, see SYS_WIFI_EventPostISR */
+static void SYS_WIFI_EventPost
+(
+    SYS_WIFI_EVENT event,
+    WDRV_PIC32MZW_ASSOC_HANDLE assocHandle,
+    uintptr_t context
+)
+{
+    SYS_WIFI_EVENT_MSG msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.event = event;
+    msg.assocHandle = assocHandle;
+    msg.context = context;
+
+    /* A wake up only event carries no data, no need to store it */
+    if ((SYS_WIFI_EVENT_WAKEUP == event) || (true == SYS_WIFI_EventEnqueue(&msg)))
+    {
+        OSAL_SEM_Post(&g_wifiSrvcEventSemaphore);
+    }
+}
+
+static void SYS_WIFI_EventPostISR
+(
+    SYS_WIFI_EVENT event,
+    uintptr_t context
+)
+{
+    SYS_WIFI_EVENT_MSG msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.event = event;
+    msg.assocHandle = WDRV_PIC32MZW_ASSOC_HANDLE_INVALID;
+    msg.context = context;
+    if (true == SYS_WIFI_EventEnqueue(&msg))
+    {
+        OSAL_SEM_PostISR(&g_wifiSrvcEventSemaphore);
+    }
+}
+
+/* SYS_TIME callback (ISR context): defer the DHCP server lease lookup
+   of a connected STA to the Wi-Fi service task */
 static void SYS_WIFI_WaitForConnSTAIP(uintptr_t context)
+{
+    SYS_WIFI_EventPostISR(SYS_WIFI_EVENT_AP_STA_LEASE_CHECK, context);
+}
+
+static void SYS_WIFI_CheckConnSTAIP(SYS_WIFI_STA_CONNECTION_INFO *staConnInfo)
 {
     TCPIP_NET_HANDLE netHdl = TCPIP_STACK_NetHandleGet("PIC32MZW1");
     TCPIP_DHCPS_LEASE_HANDLE dhcpsLease = 0;
     TCPIP_DHCPS_LEASE_ENTRY dhcpsLeaseEntry;
 
+    /* STA disconnected while the lookup was pending */
+    if (WDRV_PIC32MZW_ASSOC_HANDLE_INVALID == staConnInfo->wifiSrvcAssocHandle)
+    {
+        return;
+    }
+
     do
     {
         dhcpsLease = TCPIP_DHCPS_LeaseEntryGet(netHdl, &dhcpsLeaseEntry, dhcpsLease);
         if (0 != dhcpsLease)
         {
-            SYS_WIFI_STA_CONNECTION_INFO *staConnInfo = (SYS_WIFI_STA_CONNECTION_INFO *)context;
             if(0 == memcmp(&dhcpsLeaseEntry.hwAdd, staConnInfo->wifiSrvcStaAppInfo.macAddr, WDRV_PIC32MZW_MAC_ADDR_LEN))
-            {               
+            {
                 SYS_CONSOLE_PRINT("\r\nConnected STA IP:%d.%d.%d.%d \r\n", dhcpsLeaseEntry.ipAddress.v[0], dhcpsLeaseEntry.ipAddress.v[1], dhcpsLeaseEntry.ipAddress.v[2], dhcpsLeaseEntry.ipAddress.v[3]);
                 staConnInfo->wifiSrvcStaAppInfo.ipAddr.Val = dhcpsLeaseEntry.ipAddress.Val;
-                staConnInfo->wifiSrvcSTAConnUpdate = true; 
+                staConnInfo->wifiSrvcSTAConnUpdate = true;
                 SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_WAIT_FOR_STA_IP);
                 return;
             }
         }
     } while(0 != dhcpsLease);
 
-    SYS_TIME_CallbackRegisterMS(SYS_WIFI_WaitForConnSTAIP, context, 500, SYS_TIME_SINGLE);
+    SYS_TIME_CallbackRegisterMS(SYS_WIFI_WaitForConnSTAIP, (uintptr_t)staConnInfo, SYS_WIFI_STA_IP_POLL_MS, SYS_TIME_SINGLE);
 }
+
 static void SYS_WIFI_APConnCallBack
 (
-    DRV_HANDLE handle, 
-    WDRV_PIC32MZW_ASSOC_HANDLE assocHandle, 
+    DRV_HANDLE handle,
+    WDRV_PIC32MZW_ASSOC_HANDLE assocHandle,
     WDRV_PIC32MZW_CONN_STATE currentState
-) 
+)
 {
-    
-    WDRV_PIC32MZW_MAC_ADDR   wifiSrvcStaConnMac;
     switch (currentState)
     {
         case WDRV_PIC32MZW_CONN_STATE_CONNECTED:
         {
-            /* When STA connected to PIC32MZW1 AP, 
+            /* When STA connected to PIC32MZW1 AP,
                Wi-Fi driver updates Connected event */
-            if (WDRV_PIC32MZW_STATUS_OK == WDRV_PIC32MZW_AssocPeerAddressGet(assocHandle, &wifiSrvcStaConnMac)) 
-            {
-                uint8_t idx = 0;
-                SYS_CONSOLE_PRINT("\r\nConnected STA MAC Address=%x:%x:%x:%x:%x:%x", wifiSrvcStaConnMac.addr[0], wifiSrvcStaConnMac.addr[1], wifiSrvcStaConnMac.addr[2], wifiSrvcStaConnMac.addr[3], wifiSrvcStaConnMac.addr[4], wifiSrvcStaConnMac.addr[5]);
-
-                /* Store the connected STA Info in the STA Conn Array */
-                for(idx = 0; idx < SYS_WIFI_MAX_STA_SUPPORTED; idx++)
-                {
-                    if(g_wifiSrvcStaConnInfo[idx].wifiSrvcAssocHandle == WDRV_PIC32MZW_ASSOC_HANDLE_INVALID)
-                    {
-                        g_wifiSrvcStaConnInfo[idx].wifiSrvcAssocHandle = assocHandle;
-                        memcpy(&g_wifiSrvcStaConnInfo[idx].wifiSrvcStaAppInfo.macAddr, wifiSrvcStaConnMac.addr, WDRV_PIC32MZW_MAC_ADDR_LEN);
-                        SYS_TIME_CallbackRegisterMS(SYS_WIFI_WaitForConnSTAIP, (uintptr_t)&g_wifiSrvcStaConnInfo[idx], 500, SYS_TIME_SINGLE);
-                        break;
-                    }
-                }
-            }
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_AP_STA_CONNECTED, assocHandle, 0);
             break;
         }
 
-        case WDRV_PIC32MZW_CONN_STATE_DISCONNECTED: 
+        case WDRV_PIC32MZW_CONN_STATE_DISCONNECTED:
         {
-            /* When STA Disconnect from PIC32MZW1 AP, 
+            /* When STA Disconnect from PIC32MZW1 AP,
                Wi-Fi driver updates disconnect event */
-            SYS_WIFI_STA_CONNECTION_INFO *psStaConnInfo = NULL;
-            /* Updating Wi-Fi service Associate handle on receiving 
-               driver disconnection event */
-
-            /* Find the Sta Conn Info Entry */
-            psStaConnInfo = SYS_WIFI_FindStaConnInfo(assocHandle);
-            if(psStaConnInfo != NULL)
-            {
-                /* Update the application on receiving Disconnect event */
-                SYS_WIFI_CallBackFun(SYS_WIFI_DISCONNECT, psStaConnInfo->wifiSrvcStaAppInfo.macAddr, g_wifiSrvcCookie);
-
-                /* Remove the Sta Conn Info Entry */
-                SYS_WIFI_RemoveStaConnInfo(assocHandle);
-            }
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_AP_STA_DISCONNECTED, assocHandle, 0);
             break;
         }
 
@@ -500,26 +728,104 @@ static void SYS_WIFI_APConnCallBack
 
 }
 
+static void SYS_WIFI_APConnEvent
+(
+    const SYS_WIFI_EVENT_MSG *pMsg
+)
+{
+    WDRV_PIC32MZW_MAC_ADDR   wifiSrvcStaConnMac;
+
+    if (SYS_WIFI_EVENT_AP_STA_CONNECTED == pMsg->event)
+    {
+        if (WDRV_PIC32MZW_STATUS_OK == WDRV_PIC32MZW_AssocPeerAddressGet(pMsg->assocHandle, &wifiSrvcStaConnMac))
+        {
+            uint8_t idx = 0;
+            SYS_CONSOLE_PRINT("\r\nConnected STA MAC Address=%x:%x:%x:%x:%x:%x", wifiSrvcStaConnMac.addr[0], wifiSrvcStaConnMac.addr[1], wifiSrvcStaConnMac.addr[2], wifiSrvcStaConnMac.addr[3], wifiSrvcStaConnMac.addr[4], wifiSrvcStaConnMac.addr[5]);
+
+            /* Store the connected STA Info in the STA Conn Array */
+            for(idx = 0; idx < SYS_WIFI_MAX_STA_SUPPORTED; idx++)
+            {
+                if(g_wifiSrvcStaConnInfo[idx].wifiSrvcAssocHandle == WDRV_PIC32MZW_ASSOC_HANDLE_INVALID)
+                {
+                    g_wifiSrvcStaConnInfo[idx].wifiSrvcAssocHandle = pMsg->assocHandle;
+                    memcpy(&g_wifiSrvcStaConnInfo[idx].wifiSrvcStaAppInfo.macAddr, wifiSrvcStaConnMac.addr, WDRV_PIC32MZW_MAC_ADDR_LEN);
+                    SYS_TIME_CallbackRegisterMS(SYS_WIFI_WaitForConnSTAIP, (uintptr_t)&g_wifiSrvcStaConnInfo[idx], SYS_WIFI_STA_IP_POLL_MS, SYS_TIME_SINGLE);
+                    break;
+                }
+            }
+        }
+    }
+    else if (SYS_WIFI_EVENT_AP_STA_DISCONNECTED == pMsg->event)
+    {
+        SYS_WIFI_STA_CONNECTION_INFO *psStaConnInfo = NULL;
+        /* Updating Wi-Fi service Associate handle on receiving
+           driver disconnection event */
+
+        /* Find the Sta Conn Info Entry */
+        psStaConnInfo = SYS_WIFI_FindStaConnInfo(pMsg->assocHandle);
+        if(psStaConnInfo != NULL)
+        {
+            /* Update the application on receiving Disconnect event */
+            SYS_WIFI_CallBackFun(SYS_WIFI_DISCONNECT, psStaConnInfo->wifiSrvcStaAppInfo.macAddr, g_wifiSrvcCookie);
+
+            /* Remove the Sta Conn Info Entry */
+            SYS_WIFI_RemoveStaConnInfo(pMsg->assocHandle);
+        }
+    }
+}
+
 static void SYS_WIFI_STAConnCallBack
 (
-    DRV_HANDLE handle, 
+    DRV_HANDLE handle,
     WDRV_PIC32MZW_ASSOC_HANDLE assocHandle,
     WDRV_PIC32MZW_CONN_STATE currentState
-) 
+)
 {
-    switch (currentState) 
+    switch (currentState)
     {
         case WDRV_PIC32MZW_CONN_STATE_CONNECTED:
+        {
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_STA_CONNECTED, assocHandle, 0);
+            break;
+        }
+
+        case WDRV_PIC32MZW_CONN_STATE_FAILED:
+        {
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_STA_CONN_FAILED, assocHandle, 0);
+            break;
+        }
+
+        case WDRV_PIC32MZW_CONN_STATE_DISCONNECTED:
+        {
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_STA_DISCONNECTED, assocHandle, 0);
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+static void SYS_WIFI_STAConnEvent
+(
+    const SYS_WIFI_EVENT_MSG *pMsg
+)
+{
+    switch (pMsg->event)
+    {
+        case SYS_WIFI_EVENT_STA_CONNECTED:
         {
             /* When HOMEAP connect to PIC32MZW1 STA, Wi-Fi driver updated connected event */
-            /* Updating Wi-Fi service associate handle on receiving driver 
+            /* Updating Wi-Fi service associate handle on receiving driver
                connection event */
-            g_wifiSrvcDrvAssocHdl = assocHandle;
+            g_wifiSrvcDrvAssocHdl = pMsg->assocHandle;
             g_wifiSrvcAutoConnectRetry = 0;
             break;
         }
 
-        case WDRV_PIC32MZW_CONN_STATE_FAILED:
+        case SYS_WIFI_EVENT_STA_CONN_FAILED:
         {
             /* When user provided HOMEAP configuration is not matching with near 
                by available HOMEAPs,Wi-Fi driver updated event Fail. */
@@ -544,7 +850,7 @@ static void SYS_WIFI_STAConnCallBack
             break;
         }
 
-        case WDRV_PIC32MZW_CONN_STATE_DISCONNECTED:
+        case SYS_WIFI_EVENT_STA_DISCONNECTED:
         {
             /* when PIC32MZW1 STA disconnected from connected HOMEAP,Wi-Fi driver 
                updated event disconnected. */
@@ -584,11 +890,11 @@ static void SYS_WIFI_RegDomainCallback
     {
         SYS_CONSOLE_MESSAGE("Regulatory domain set unsuccessful\r\n");
     }  
-    if(!memcmp(pRegDomInfo,SYS_WIFI_GetCountryCode(),strlen((const char *)pRegDomInfo)))
+    else if(!memcmp(pRegDomInfo,SYS_WIFI_GetCountryCode(),strlen((const char *)pRegDomInfo)))
     {
         g_isRegDomainSetReq = true;
     }
-
+    SYS_WIFI_EventPost(SYS_WIFI_EVENT_WAKEUP, WDRV_PIC32MZW_ASSOC_HANDLE_INVALID, 0);
 }
 
 
@@ -599,63 +905,129 @@ static void SYS_WIFI_TCPIP_DHCP_EventHandler
     const void* param
 ) 
 {
-    IPV4_ADDR ipAddr;
-    IPV4_ADDR gateWayAddr;
-    bool provConnStatus = false;
     switch (evType) 
     {
         case DHCP_EVENT_BOUND:
         {
+            SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_DHCP_BOUND, 0);
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_DHCP_BOUND, WDRV_PIC32MZW_ASSOC_HANDLE_INVALID, (uintptr_t)hNet);
+            break;
+        }
 
-            /* TCP/IP Stack BOUND event indicates
-               PIC32MZW1 has received the IP address from connected HOMEAP */
-            ipAddr.Val = TCPIP_STACK_NetAddress(hNet);
-            if (ipAddr.Val) 
-            {
-                gateWayAddr.Val = TCPIP_STACK_NetAddressGateway(hNet);
-                SYS_CONSOLE_PRINT("IP address obtained = %d.%d.%d.%d \r\n",
-                        ipAddr.v[0], ipAddr.v[1], ipAddr.v[2], ipAddr.v[3]);
-                SYS_CONSOLE_PRINT("Gateway IP address = %d.%d.%d.%d \r\n",
-                        gateWayAddr.v[0], gateWayAddr.v[1], gateWayAddr.v[2], gateWayAddr.v[3]);
-
-                g_wifiSrvcConfig.staConfig.ipAddr.Val=ipAddr.Val;
-                SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_STA_IP_RECIEVED);
-            }
+        case DHCP_EVENT_CONN_LOST:
+        {
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_DHCP_CONN_LOST, WDRV_PIC32MZW_ASSOC_HANDLE_INVALID, (uintptr_t)hNet);
             break;
         }
 
-        case DHCP_EVENT_CONN_ESTABLISHED:
+        default:
         {
             break;
         }
+    }
+}
 
-        case DHCP_EVENT_CONN_LOST:
+static void SYS_WIFI_DHCPEvent
+(
+    const SYS_WIFI_EVENT_MSG *pMsg
+)
+{
+    TCPIP_NET_HANDLE hNet = (TCPIP_NET_HANDLE)pMsg->context;
+    IPV4_ADDR ipAddr;
+    IPV4_ADDR gateWayAddr;
+    bool provConnStatus = false;
+
+    if (SYS_WIFI_EVENT_DHCP_BOUND == pMsg->event)
+    {
+        /* TCP/IP Stack BOUND event indicates
+           PIC32MZW1 has received the IP address from connected HOMEAP */
+        ipAddr.Val = TCPIP_STACK_NetAddress(hNet);
+        if (ipAddr.Val) 
         {
+            gateWayAddr.Val = TCPIP_STACK_NetAddressGateway(hNet);
+            SYS_CONSOLE_PRINT("IP address obtained = %d.%d.%d.%d \r\n",
+                    ipAddr.v[0], ipAddr.v[1], ipAddr.v[2], ipAddr.v[3]);
+            SYS_CONSOLE_PRINT("Gateway IP address = %d.%d.%d.%d \r\n",
+                    gateWayAddr.v[0], gateWayAddr.v[1], gateWayAddr.v[2], gateWayAddr.v[3]);
+
+            g_wifiSrvcConfig.staConfig.ipAddr.Val=ipAddr.Val;
+            SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_STA_IP_RECIEVED);
+        }
+    }
+    else if (SYS_WIFI_EVENT_DHCP_CONN_LOST == pMsg->event)
+    {
+        /* Received the TCP/IP Stack Connection Lost event,
+           PIC32MZW1 has lost IP address from connected HOMEAP */
+
+        /* Update the application(client) on lost IP address */
+        SYS_WIFI_CallBackFun(SYS_WIFI_DISCONNECT,NULL,g_wifiSrvcCookie);
+        provConnStatus = false;
+
+        /* Update the Wi-Fi provisioning service on lost IP Address, 
+           The Wi-Fi provisioning service has to stop the TCP server socket.
+           only applicable if user has enable TCP Socket configuration 
+           from MHC */
+        SYS_WIFIPROV_CtrlMsg(g_wifiSrvcProvObj,SYS_WIFIPROV_CONNECT,&provConnStatus,sizeof(bool));
+    }
+}
 
-            /* Received the TCP/IP Stack Connection Lost event,
-               PIC32MZW1 has lost IP address from connected HOMEAP */
+/* TCP/IP stack interface events, used to leave SYS_WIFI_STATUS_WAIT_FOR_AP_IP
+   without polling the interface address */
+static void SYS_WIFI_TCPIP_StackEventHandler
+(
+    TCPIP_NET_HANDLE hNet,
+    TCPIP_EVENT evType,
+    const void* fParam
+)
+{
+    SYS_WIFI_EventPost(SYS_WIFI_EVENT_TCPIP_CONN, WDRV_PIC32MZW_ASSOC_HANDLE_INVALID, (uintptr_t)evType);
+}
 
-            /* Update the application(client) on lost IP address */
-            SYS_WIFI_CallBackFun(SYS_WIFI_DISCONNECT,NULL,g_wifiSrvcCookie);
-            provConnStatus = false;
+/* Runs in the Wi-Fi service task context for every queued event */
+static void SYS_WIFI_ProcessEvent
+(
+    const SYS_WIFI_EVENT_MSG *pMsg
+)
+{
+    switch (pMsg->event)
+    {
+        case SYS_WIFI_EVENT_STA_CONNECTED:
+        case SYS_WIFI_EVENT_STA_CONN_FAILED:
+        case SYS_WIFI_EVENT_STA_DISCONNECTED:
+        {
+            SYS_WIFI_STAConnEvent(pMsg);
+            break;
+        }
 
-            /* Update the Wi-Fi provisioning service on lost IP Address, 
-               The Wi-Fi provisioning service has to stop the TCP server socket.
-               only applicable if user has enable TCP Socket configuration 
-               from MHC */
-            SYS_WIFIPROV_CtrlMsg(g_wifiSrvcProvObj,SYS_WIFIPROV_CONNECT,&provConnStatus,sizeof(bool));
+        case SYS_WIFI_EVENT_AP_STA_CONNECTED:
+        case SYS_WIFI_EVENT_AP_STA_DISCONNECTED:
+        {
+            SYS_WIFI_APConnEvent(pMsg);
             break;
         }
 
+        case SYS_WIFI_EVENT_AP_STA_LEASE_CHECK:
+        {
+            SYS_WIFI_CheckConnSTAIP((SYS_WIFI_STA_CONNECTION_INFO *)pMsg->context);
+            break;
+        }
+
+        case SYS_WIFI_EVENT_DHCP_BOUND:
+        case SYS_WIFI_EVENT_DHCP_CONN_LOST:
+        {
+            SYS_WIFI_DHCPEvent(pMsg);
+            break;
+        }
+
+        case SYS_WIFI_EVENT_TCPIP_CONN:
         default:
         {
+            /* State re-evaluation only */
             break;
         }
     }
 }
 
-
-
 static SYS_WIFI_RESULT SYS_WIFI_SetChannel(void)
 {
     uint8_t ret = SYS_WIFI_FAILURE;
@@ -702,6 +1074,9 @@ static SYS_WIFI_RESULT SYS_WIFI_ConnectReq(void)
     SYS_WIFI_MODE devMode = SYS_WIFI_GetMode();
     if (SYS_WIFI_STA == devMode) 
     {
+        /* Bind the DHCP lease to the SSID, a reconnect to the 
+           same network requests the previous address directly */
+        TCPIP_DHCP_LeaseBindKeySet(TCPIP_STACK_NetHandleGet("PIC32MZW1"), SYS_WIFI_GetSSID(), SYS_WIFI_GetSSIDLen());
         if (WDRV_PIC32MZW_STATUS_OK == WDRV_PIC32MZW_BSSConnect(g_wifiSrvcObj.wifiSrvcDrvHdl, &g_wifiSrvcObj.wifiSrvcBssCtx, &g_wifiSrvcObj.wifiSrvcAuthCtx, SYS_WIFI_STAConnCallBack)) 
         {
             ret = SYS_WIFI_SUCCESS;
@@ -854,7 +1229,6 @@ static uint32_t SYS_WIFI_ExecuteBlock
     SYS_WIFI_OBJ *               wifiSrvcObj = (SYS_WIFI_OBJ *) object;
     uint8_t                      ret =  SYS_WIFIPROV_OBJ_INVALID;
 
-    IPV4_ADDR                    apLastIp = {-1};
     IPV4_ADDR                    apIpAddr;
  
     if (&g_wifiSrvcObj == (SYS_WIFI_OBJ*) wifiSrvcObj)
@@ -877,7 +1251,7 @@ static uint32_t SYS_WIFI_ExecuteBlock
                     {
                         if (SYS_STATUS_READY == WDRV_PIC32MZW_Status(sysObj.drvWifiPIC32MZW1)) 
                         {
-                            wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_WDRV_OPEN_REQ;                
+                            SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_WDRV_OPEN_REQ);
                         }
                     }
                     OSAL_SEM_Post(&g_wifiSrvcSemaphore);
@@ -895,7 +1269,7 @@ static uint32_t SYS_WIFI_ExecuteBlock
                         if (WDRV_PIC32MZW_STATUS_OK == WDRV_PIC32MZW_RegDomainGet(wifiSrvcObj->wifiSrvcDrvHdl,WDRV_PIC32MZW_REGDOMAIN_SELECT_CURRENT,SYS_WIFI_RegDomainCallback))
                         {
                             SYS_WIFI_PrintWifiConfig();
-                            wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_AUTOCONNECT_WAIT;
+                            SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_AUTOCONNECT_WAIT);
                         }
                     }
                     OSAL_SEM_Post(&g_wifiSrvcSemaphore);
@@ -921,7 +1295,7 @@ static uint32_t SYS_WIFI_ExecuteBlock
                                 g_isRegDomainSetReq = false;
                             }
                         }
-                        wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_TCPIP_WAIT_FOR_TCPIP_INIT;
+                        SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_WAIT_FOR_TCPIP_INIT);
                     }
                     OSAL_SEM_Post(&g_wifiSrvcSemaphore);
                 }
@@ -936,12 +1310,16 @@ static uint32_t SYS_WIFI_ExecuteBlock
                     if (tcpIpStat < 0) 
                     {
                         SYS_CONSOLE_MESSAGE("  TCP/IP stack initialization failed!\r\n");
-                        wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_TCPIP_ERROR;
+                        SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_ERROR);
                     } 
                     else if (tcpIpStat == SYS_STATUS_READY) 
                     {
                         /* PIC32MZW1 network handle*/
                         netHdl = TCPIP_STACK_NetHandleGet("PIC32MZW1");
+                        if (NULL == g_wifiSrvcTcpipEvHdl)
+                        {
+                            g_wifiSrvcTcpipEvHdl = TCPIP_STACK_HandlerRegister(netHdl, TCPIP_EV_CONN_ALL, SYS_WIFI_TCPIP_StackEventHandler, NULL);
+                        }
                         /* STA Mode */
                         if (SYS_WIFI_STA == SYS_WIFI_GetMode()) 
                         {
@@ -963,8 +1341,8 @@ static uint32_t SYS_WIFI_ExecuteBlock
                             }
                             TCPIP_DHCPS_Enable(netHdl); /*Enable DHCP Server in AP mode*/
                         }
-                    }                
-                    wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_CONNECT_REQ;
+                        SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_CONNECT_REQ);
+                    }
                     OSAL_SEM_Post(&g_wifiSrvcSemaphore);
                 }
                 break;
@@ -980,7 +1358,7 @@ static uint32_t SYS_WIFI_ExecuteBlock
                         {
                             if (SYS_WIFI_SUCCESS == SYS_WIFI_ConnectReq()) 
                             {
-                                wifiSrvcObj->wifiSrvcStatus = (SYS_WIFI_STA == SYS_WIFI_GetMode()) ? SYS_WIFI_STATUS_TCPIP_READY : SYS_WIFI_STATUS_WAIT_FOR_AP_IP;
+                                SYS_WIFI_SetTaskstatus((SYS_WIFI_STA == SYS_WIFI_GetMode()) ? SYS_WIFI_STATUS_TCPIP_READY : SYS_WIFI_STATUS_WAIT_FOR_AP_IP);
                             }
                         }
                     }
@@ -1009,23 +1387,24 @@ static uint32_t SYS_WIFI_ExecuteBlock
                 {
                   SYS_WIFIPROV_CtrlMsg(g_wifiSrvcProvObj,SYS_WIFIPROV_SETCONFIG,&g_wifiSrvcConfig,sizeof(SYS_WIFI_CONFIG));
                 }
-                wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_TCPIP_READY;
+                SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_READY);
                 break;
             }
 
 
             case SYS_WIFI_STATUS_WAIT_FOR_AP_IP:
             {
+                /* The AP interface address is normally already set; otherwise
+                   the TCP/IP stack connection event wakes the task up */
                 apIpAddr.Val = TCPIP_STACK_NetAddress(netHdl);
-                if (apLastIp.Val != apIpAddr.Val)
+                if (0 != apIpAddr.Val)
                 {
                     if (OSAL_RESULT_TRUE == OSAL_SEM_Pend(&g_wifiSrvcSemaphore, OSAL_WAIT_FOREVER)) 
                     {
-                        apLastIp.Val = apIpAddr.Val;
                         SYS_CONSOLE_MESSAGE(TCPIP_STACK_NetNameGet(netHdl));
                         SYS_CONSOLE_MESSAGE(" AP Mode IP Address: ");
                         SYS_CONSOLE_PRINT("%d.%d.%d.%d \r\n", apIpAddr.v[0], apIpAddr.v[1], apIpAddr.v[2], apIpAddr.v[3]);
-                        wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_TCPIP_READY;
+                        SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_READY);
                         OSAL_SEM_Post(&g_wifiSrvcSemaphore);
 
                         /* In AP mode, Update AP mode start event to
@@ -1040,23 +1419,24 @@ static uint32_t SYS_WIFI_ExecuteBlock
             case SYS_WIFI_STATUS_WAIT_FOR_STA_IP:
             {
                 uint8_t staConnIdx = SYS_WIFI_OBJ_INVALID;
-                if (OSAL_RESULT_TRUE == OSAL_SEM_Pend(&g_wifiSrvcSemaphore, 
-                                        OSAL_WAIT_FOREVER))
-                {
-                    staConnIdx = SYS_WIFI_StaConnIdx();
-                    OSAL_SEM_Post(&g_wifiSrvcSemaphore);
-                }    
-                if(SYS_WIFI_OBJ_INVALID != staConnIdx)
+                do
                 {
-                    /* updates the application with received STA IP address*/
-                    SYS_WIFI_CallBackFun(SYS_WIFI_CONNECT, 
-                    &g_wifiSrvcStaConnInfo[staConnIdx].wifiSrvcStaAppInfo, 
-                    g_wifiSrvcCookie);
-                }
-                else
-                {
-                    SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_READY);
-                }                   
+                    staConnIdx = SYS_WIFI_OBJ_INVALID;
+                    if (OSAL_RESULT_TRUE == OSAL_SEM_Pend(&g_wifiSrvcSemaphore, 
+                                            OSAL_WAIT_FOREVER))
+                    {
+                        staConnIdx = SYS_WIFI_StaConnIdx();
+                        OSAL_SEM_Post(&g_wifiSrvcSemaphore);
+                    }    
+                    if(SYS_WIFI_OBJ_INVALID != staConnIdx)
+                    {
+                        /* updates the application with received STA IP address*/
+                        SYS_WIFI_CallBackFun(SYS_WIFI_CONNECT, 
+                        &g_wifiSrvcStaConnInfo[staConnIdx].wifiSrvcStaAppInfo, 
+                        g_wifiSrvcCookie);
+                    }
+                } while (SYS_WIFI_OBJ_INVALID != staConnIdx);
+                SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_READY);
                 break;
             }
             case SYS_WIFI_STATUS_TCPIP_READY:
@@ -1071,11 +1451,11 @@ static uint32_t SYS_WIFI_ExecuteBlock
             
                 if (tcpIpStat < 2) 
                 {
-                    wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_TCPIP_ERROR;
+                    SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_ERROR);
                 } 
                 else 
                 {
-                    wifiSrvcObj->wifiSrvcStatus = SYS_WIFI_STATUS_TCPIP_WAIT_FOR_TCPIP_INIT;
+                    SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_TCPIP_WAIT_FOR_TCPIP_INIT);
                 }
                 break;
             }
@@ -1091,6 +1471,48 @@ static uint32_t SYS_WIFI_ExecuteBlock
     return ret;
 }
 
+/* Time the Wi-Fi service task can sleep waiting for the next event */
+static uint16_t SYS_WIFI_StateWaitTime(void)
+{
+    bool poll = false;
+
+    switch (g_wifiSrvcObj.wifiSrvcStatus)
+    {
+        case SYS_WIFI_STATUS_INIT:
+        {
+            /* Before the configuration is available the task is woken up by
+               the provisioning service callback. The driver ready status has 
+               no notification. */
+            poll = g_wifiSrvcInit;
+            break;
+        }
+
+        case SYS_WIFI_STATUS_WDRV_OPEN_REQ:
+        case SYS_WIFI_STATUS_TCPIP_WAIT_FOR_TCPIP_INIT:
+        case SYS_WIFI_STATUS_CONNECT_REQ:
+        case SYS_WIFI_STATUS_TCPIP_ERROR:
+        {
+            /* Driver open, TCP/IP stack init and channel set have no 
+               completion event, retry them */
+            poll = true;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    /* Provisioning service NVM operation in progress */
+    if (SYS_WIFIPROV_STATUS_WAITFORREQ != SYS_WIFIPROV_GetStatus(g_wifiSrvcProvObj))
+    {
+        poll = true;
+    }
+
+    return (true == poll) ? SYS_WIFI_POLL_INTERVAL_MS : OSAL_WAIT_FOREVER;
+}
+
 static void SYS_WIFI_WIFIPROVCallBack
 (
     uint32_t event, 
@@ -1190,6 +1612,13 @@ static void SYS_WIFI_WIFIPROVCallBack
                 break;
             }
         }
+
+        /* New configuration or pending provisioning NVM operation,
+           the service task has to run */
+        if ((SYS_WIFIPROV_SETCONFIG == event) || (SYS_WIFIPROV_TASKPENDING == event))
+        {
+            SYS_WIFI_EventPost(SYS_WIFI_EVENT_WAKEUP, WDRV_PIC32MZW_ASSOC_HANDLE_INVALID, 0);
+        }
     }
 }
 
@@ -1213,6 +1642,16 @@ SYS_MODULE_OBJ SYS_WIFI_Initialize
             SYS_CONSOLE_MESSAGE("Failed to Initialize Wi-Fi Service as Semaphore NOT created\r\n");
             return SYS_MODULE_OBJ_INVALID;
         }
+        if (OSAL_SEM_Create(&g_wifiSrvcEventSemaphore, OSAL_SEM_TYPE_BINARY, 1, 0) != OSAL_RESULT_TRUE) 
+        {
+            SYS_CONSOLE_MESSAGE("Failed to Initialize Wi-Fi Service as Event Semaphore NOT created\r\n");
+            OSAL_SEM_Delete(&g_wifiSrvcSemaphore);
+            return SYS_MODULE_OBJ_INVALID;
+        }
+        memset(&g_wifiSrvcEventQueue, 0, sizeof(g_wifiSrvcEventQueue));
+        memset(&g_wifiSrvcMetrics, 0, sizeof(g_wifiSrvcMetrics));
+        g_wifiSrvcStateEnterTime = SYS_TIME_Counter64Get();
+        g_wifiSrvcConnStartTime = 0;
         memset(g_wifiSrvcCallBack,0,sizeof(g_wifiSrvcCallBack));
         if (callback != NULL) 
         {
@@ -1269,10 +1708,19 @@ SYS_WIFI_RESULT SYS_WIFI_Deinitialize
         memset(g_wifiSrvcCallBack,0,sizeof(g_wifiSrvcCallBack));
         SYS_WIFI_SetTaskstatus(SYS_WIFI_STATUS_NONE);
         SYS_WIFIPROV_Deinitialize(g_wifiSrvcProvObj);
+        if (NULL != g_wifiSrvcTcpipEvHdl)
+        {
+            TCPIP_STACK_HandlerDeregister(g_wifiSrvcTcpipEvHdl);
+            g_wifiSrvcTcpipEvHdl = NULL;
+        }
         if (OSAL_SEM_Delete(&g_wifiSrvcSemaphore) != OSAL_RESULT_TRUE) 
         {
             SYS_CONSOLE_MESSAGE("Failed to Delete Wi-Fi Service Semaphore \r\n");
         }
+        if (OSAL_SEM_Delete(&g_wifiSrvcEventSemaphore) != OSAL_RESULT_TRUE) 
+        {
+            SYS_CONSOLE_MESSAGE("Failed to Delete Wi-Fi Service Event Semaphore \r\n");
+        }
         ret = SYS_WIFI_SUCCESS;
     }
     return ret;
@@ -1313,10 +1761,30 @@ uint8_t SYS_WIFI_Tasks
 ) 
 {
     uint8_t ret = SYS_WIFI_OBJ_INVALID;
+    SYS_WIFI_EVENT_MSG msg;
+    SYS_WIFI_STATUS prevStatus;
+    uint8_t nSteps = 0;
 
     if (&g_wifiSrvcObj == (SYS_WIFI_OBJ *) object) 
     {
-        ret = SYS_WIFI_ExecuteBlock(object);
+        /* Handle the driver, TCP/IP stack and timer events queued since the 
+           last run */
+        while (true == SYS_WIFI_EventDequeue(&msg))
+        {
+            SYS_WIFI_ProcessEvent(&msg);
+        }
+
+        /* Run the state machine until it settles in a state that waits 
+           for an event */
+        do
+        {
+            prevStatus = g_wifiSrvcObj.wifiSrvcStatus;
+            ret = SYS_WIFI_ExecuteBlock(object);
+        } while ((prevStatus != g_wifiSrvcObj.wifiSrvcStatus) && (++nSteps < SYS_WIFI_STATUS_NUM));
+
+        /* Sleep until the next event */
+        OSAL_SEM_Pend(&g_wifiSrvcEventSemaphore, SYS_WIFI_StateWaitTime());
+        g_wifiSrvcMetrics.wakeupCount++;
     }
     return ret;
 }
@@ -1450,9 +1918,36 @@ SYS_WIFI_RESULT SYS_WIFI_CtrlMsg
                     }
                     break;
                 }
+
+                case SYS_WIFI_GETSTATEMETRICS:
+                {
+                    if ((buffer) && (length == sizeof (SYS_WIFI_STATE_METRICS))) 
+                    {
+                        /* Client has requested the time-in-state metrics, 
+                           account the time spent so far in the current state */
+                        SYS_WIFI_STATE_METRICS *pMetrics = (SYS_WIFI_STATE_METRICS *)buffer;
+                        SYS_WIFI_STATUS status = g_wifiSrvcObj.wifiSrvcStatus;
+
+                        memcpy(pMetrics, &g_wifiSrvcMetrics, sizeof (SYS_WIFI_STATE_METRICS));
+                        if (status < SYS_WIFI_STATUS_NUM)
+                        {
+                            pMetrics->state[status].totalTimeMs += SYS_WIFI_ElapsedMS(g_wifiSrvcStateEnterTime, SYS_TIME_Counter64Get());
+                        }
+                        pMetrics->currentStatus = status;
+                        ret = SYS_WIFI_SUCCESS;
+                    }
+                    else
+                    {
+                        ret = SYS_WIFI_FAILURE;
+                    }
+                    break;
+                }
             }
         }
         OSAL_SEM_Post(&g_wifiSrvcSemaphore);
+
+        /* The request may have changed the service state */
+        SYS_WIFI_EventPost(SYS_WIFI_EVENT_WAKEUP, WDRV_PIC32MZW_ASSOC_HANDLE_INVALID, 0);
     }
     return ret;
 }
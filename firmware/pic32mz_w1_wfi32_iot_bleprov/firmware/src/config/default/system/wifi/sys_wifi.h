@@ -144,6 +144,9 @@ typedef enum
     /*Control message type for requesting a Assoc handle */
     SYS_WIFI_GETDRVASSOCHANDLE,
 
+    /*Control message type for requesting the time-in-state metrics */
+    SYS_WIFI_GETSTATEMETRICS,
+
 } SYS_WIFI_CTRLMSG ;
 
 // *****************************************************************************
@@ -360,6 +363,74 @@ typedef enum
     SYS_WIFI_STATUS_NONE =255
 } SYS_WIFI_STATUS;
 
+/* Number of valid Wi-Fi system service states */
+#define SYS_WIFI_STATUS_NUM     (SYS_WIFI_STATUS_CONNECT_ERROR + 1)
+
+// *****************************************************************************
+/* System Wi-Fi service per state metrics.
+
+  Summary:
+    Time spent by the Wi-Fi service in one state.
+
+  Description:
+    Time spent by the Wi-Fi service in one state, accumulated since the 
+    service initialization.
+
+  Remarks:
+   None.
+*/
+typedef struct
+{
+    /* Number of times the state was entered */
+    uint32_t entryCount;
+
+    /* Total time spent in the state, in milliseconds */
+    uint32_t totalTimeMs;
+
+    /* Longest single stay in the state, in milliseconds */
+    uint32_t maxTimeMs;
+
+} SYS_WIFI_STATE_METRICS_ENTRY;
+
+// *****************************************************************************
+/* System Wi-Fi service time-in-state metrics.
+
+  Summary:
+    Shows where the Wi-Fi service spends its time.
+
+  Description:
+    Returned by the SYS_WIFI_GETSTATEMETRICS control message.
+    The state array is indexed by SYS_WIFI_STATUS.
+
+  Remarks:
+   The connect time is measured from the last entry in 
+   SYS_WIFI_STATUS_CONNECT_REQ until the interface has an IP address:
+   SYS_WIFI_STATUS_STA_IP_RECIEVED in STA mode, or the
+   SYS_WIFI_STATUS_WAIT_FOR_AP_IP to SYS_WIFI_STATUS_TCPIP_READY transition
+   in AP mode. It includes the association and the DHCP time.
+*/
+typedef struct
+{
+    /* Per state metrics, indexed by SYS_WIFI_STATUS */
+    SYS_WIFI_STATE_METRICS_ENTRY state[SYS_WIFI_STATUS_NUM];
+
+    /* Connection setup time of the last connection, in milliseconds */
+    uint32_t lastConnectTimeMs;
+
+    /* Number of driver, TCP/IP stack and timer events queued */
+    uint32_t eventCount;
+
+    /* Number of events dropped because the event queue was full */
+    uint32_t eventDropCount;
+
+    /* Number of times the service task was woken up */
+    uint32_t wakeupCount;
+
+    /* Current Wi-Fi service state */
+    SYS_WIFI_STATUS currentStatus;
+
+} SYS_WIFI_STATE_METRICS;
+
 
 // *****************************************************************************
 /* System Wi-Fi service Result.
@@ -692,6 +763,11 @@ uint8_t SYS_WIFI_GetStatus ( SYS_MODULE_OBJ object) ;
   Remarks:
     If the Wi-Fi system service is enabled using MHC, then auto generated code 
     will take care of system task execution.
+
+    The service is event driven: this function handles the queued driver, 
+    TCP/IP stack and DHCP events and then blocks until the next event. Only 
+    the states without an event source (driver open, TCP/IP stack 
+    initialization, provisioning NVM access) are re-checked periodically.
 */
 
 uint8_t SYS_WIFI_Tasks (SYS_MODULE_OBJ object);
@@ -797,6 +873,15 @@ uint8_t SYS_WIFI_Tasks (SYS_MODULE_OBJ object);
                 // User same MAC address for disconnect request.
                 SYS_WIFI_CtrlMsg(sysObj.syswifi, SYS_WIFI_DISCONNECT, macAddr, 6);
 
+        Details of SYS_WIFI_GETSTATEMETRICS:
+
+            // Get the time spent in each Wi-Fi service state.
+            SYS_WIFI_STATE_METRICS wifiMetrics;
+            if(SYS_WIFI_SUCCESS == SYS_WIFI_CtrlMsg(sysObj.syswifi, SYS_WIFI_GETSTATEMETRICS, &wifiMetrics, sizeof(SYS_WIFI_STATE_METRICS)))
+            {
+                  // wifiMetrics.lastConnectTimeMs is the last connection setup time
+            }
+
         </code>
 
   Remarks:
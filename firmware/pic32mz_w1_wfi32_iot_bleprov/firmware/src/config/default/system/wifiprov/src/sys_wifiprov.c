@@ -239,6 +239,9 @@ static void SYS_WIFIPROV_WriteConfig(void)
         /* User has enabled Save Config,
            so first copy the Wi-Fi configuration into NVM flash */
         SYS_WIFIPROV_SetTaskstatus(SYS_WIFIPROV_STATUS_NVM_ERASE);
+
+        /* Let the client schedule SYS_WIFIPROV_Tasks */
+        SYS_WIFIPROV_CallBackFun(SYS_WIFIPROV_TASKPENDING, NULL, g_wifiProvSrvcCookie);
     } 
     else 
     {
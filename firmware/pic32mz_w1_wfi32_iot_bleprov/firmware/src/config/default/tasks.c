@@ -60,8 +60,20 @@
 // *****************************************************************************
 // *****************************************************************************
 
+/* Handles of the system, driver and middleware tasks, for the stack monitor */
+static TaskHandle_t xSYS_CMD_Tasks;
+static TaskHandle_t xWDRV_PIC32MZW1_Tasks;
+static TaskHandle_t xDRV_BA414E_Tasks;
+static TaskHandle_t xTCPIP_STACK_Tasks;
+static TaskHandle_t xSYS_WIFI_Tasks;
+#if defined(TCPIP_STACK_COMMAND_ENABLE) && (TCPIP_PACKET_LOG_ENABLE != 0) && (TCPIP_PKT_CAPTURE_ENABLE != 0)
+static TaskHandle_t xTCPIP_PKT_CAPTURE_Tasks;
+#endif
+
 void _DRV_BA414E_Tasks(  void *pvParameters  )
 {
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_TASK_BA414E, 0);
+
     while(1)
     {
         DRV_BA414E_Tasks(sysObj.ba414e);
@@ -71,6 +83,8 @@ void _DRV_BA414E_Tasks(  void *pvParameters  )
 
 void _TCPIP_STACK_Task(  void *pvParameters  )
 {
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_TASK_TCPIP, 0);
+
     while(1)
     {
         TCPIP_STACK_Task(sysObj.tcpip);
@@ -78,11 +92,24 @@ void _TCPIP_STACK_Task(  void *pvParameters  )
     }
 }
 
+#if defined(TCPIP_STACK_COMMAND_ENABLE) && (TCPIP_PACKET_LOG_ENABLE != 0) && (TCPIP_PKT_CAPTURE_ENABLE != 0)
+void _TCPIP_PKT_CAPTURE_Task(  void *pvParameters  )
+{
+    while(1)
+    {
+        TCPIP_COMMAND_CaptureTask();
+        vTaskDelay(TCPIP_PKT_CAPTURE_TASK_RATE / portTICK_PERIOD_MS);
+    }
+}
+#endif
+
 /* Handle for the APP_WIFI_Tasks. */
 TaskHandle_t xAPP_WIFI_Tasks;
 
 void _APP_WIFI_Tasks(  void *pvParameters  )
 {   
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_TASK_APP_WIFI, 0);
+
     while(1)
     {
         APP_WIFI_Tasks();
@@ -93,6 +120,8 @@ TaskHandle_t xAPP_BLE_Tasks;
 
 void _APP_BLE_Tasks(  void *pvParameters  )
 {   
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_TASK_APP_BLE, 0);
+
     while(1)
     {
         APP_BLE_Tasks();
@@ -101,6 +130,8 @@ void _APP_BLE_Tasks(  void *pvParameters  )
 
 void _SYS_CMD_Tasks(  void *pvParameters  )
 {
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_TASK_SYS_CMD, 0);
+
     while(1)
     {
         SYS_CMD_Tasks();
@@ -111,6 +142,8 @@ void _SYS_CMD_Tasks(  void *pvParameters  )
 
 static void _WDRV_PIC32MZW1_Tasks(  void *pvParameters  )
 {
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_TASK_WDRV, 0);
+
     while(1)
     {
         SYS_STATUS status;
@@ -128,10 +161,12 @@ static void _WDRV_PIC32MZW1_Tasks(  void *pvParameters  )
 
 void _SYS_WIFI_Task(  void *pvParameters  )
 {
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_TASK_SYS_WIFI, 0);
+
     while(1)
     {
+        /* Blocks until the next Wi-Fi service event */
         SYS_WIFI_Tasks(sysObj.syswifi);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
     }
 }
 
@@ -161,8 +196,9 @@ void SYS_Tasks ( void )
         SYS_CMD_RTOS_STACK_SIZE,
         (void*)NULL,
         SYS_CMD_RTOS_TASK_PRIORITY,
-        (TaskHandle_t*)NULL
+        &xSYS_CMD_Tasks
     );
+    SYS_STACKMON_TaskRegister(xSYS_CMD_Tasks, SYS_CMD_RTOS_STACK_SIZE);
 
 
 
@@ -170,11 +206,12 @@ void SYS_Tasks ( void )
     /* Maintain Device Drivers */
         xTaskCreate( _WDRV_PIC32MZW1_Tasks,
         "WDRV_PIC32MZW1_Tasks",
-        1024,
+        WDRV_PIC32MZW1_RTOS_STACK_SIZE,
         (void*)NULL,
         1,
-        (TaskHandle_t*)NULL
+        &xWDRV_PIC32MZW1_Tasks
     );
+    SYS_STACKMON_TaskRegister(xWDRV_PIC32MZW1_Tasks, WDRV_PIC32MZW1_RTOS_STACK_SIZE);
 
 
 
@@ -186,8 +223,9 @@ void SYS_Tasks ( void )
         DRV_BA414E_RTOS_STACK_SIZE,
         (void*)NULL,
         DRV_BA414E_RTOS_TASK_PRIORITY,
-        (TaskHandle_t*)NULL
+        &xDRV_BA414E_Tasks
     );
+    SYS_STACKMON_TaskRegister(xDRV_BA414E_Tasks, DRV_BA414E_RTOS_STACK_SIZE);
 
 
 
@@ -196,8 +234,20 @@ void SYS_Tasks ( void )
         TCPIP_RTOS_STACK_SIZE,
         (void*)NULL,
         TCPIP_RTOS_PRIORITY,
-        (TaskHandle_t*)NULL
+        &xTCPIP_STACK_Tasks
     );
+    SYS_STACKMON_TaskRegister(xTCPIP_STACK_Tasks, TCPIP_RTOS_STACK_SIZE);
+
+#if defined(TCPIP_STACK_COMMAND_ENABLE) && (TCPIP_PACKET_LOG_ENABLE != 0) && (TCPIP_PKT_CAPTURE_ENABLE != 0)
+    xTaskCreate( _TCPIP_PKT_CAPTURE_Task,
+        "TCPIP_PKT_CAPTURE_Tasks",
+        TCPIP_PKT_CAPTURE_RTOS_STACK_SIZE,
+        (void*)NULL,
+        TCPIP_PKT_CAPTURE_RTOS_PRIORITY,
+        &xTCPIP_PKT_CAPTURE_Tasks
+    );
+    SYS_STACKMON_TaskRegister(xTCPIP_PKT_CAPTURE_Tasks, TCPIP_PKT_CAPTURE_RTOS_STACK_SIZE);
+#endif
 
 
     xTaskCreate( _SYS_WIFI_Task,
@@ -205,8 +255,9 @@ void SYS_Tasks ( void )
         SYS_WIFI_RTOS_SIZE,
         (void*)NULL,
         SYS_WIFI_RTOS_PRIORITY,
-        (TaskHandle_t*)NULL
+        &xSYS_WIFI_Tasks
     );
+    SYS_STACKMON_TaskRegister(xSYS_WIFI_Tasks, SYS_WIFI_RTOS_SIZE);
 
 
 
@@ -215,21 +266,25 @@ void SYS_Tasks ( void )
         /* Create OS Thread for APP_WIFI_Tasks. */
     xTaskCreate((TaskFunction_t) _APP_WIFI_Tasks,
                 "APP_WIFI_Tasks",
-                1024,
+                APP_WIFI_RTOS_STACK_SIZE,
                 NULL,
                 1,
                 &xAPP_WIFI_Tasks);
+    SYS_STACKMON_TaskRegister(xAPP_WIFI_Tasks, APP_WIFI_RTOS_STACK_SIZE);
 
     /* Create OS Thread for APP_BLE_Tasks. */
     xTaskCreate((TaskFunction_t) _APP_BLE_Tasks,
                 "APP_BLE_Tasks",
-                1024,
+                APP_BLE_RTOS_STACK_SIZE,
                 NULL,
                 1,
                 &xAPP_BLE_Tasks);
+    SYS_STACKMON_TaskRegister(xAPP_BLE_Tasks, APP_BLE_RTOS_STACK_SIZE);
+
 
 
 
+    SYS_BOOTTRACE_Mark(SYS_BOOTTRACE_ID_SCHEDULER_START, 0);
 
     /* Start RTOS Scheduler. */
     
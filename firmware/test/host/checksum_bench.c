@@ -0,0 +1,369 @@
+/*******************************************************************************
+  IP checksum host test and benchmark
+
+  Summary:
+    Correctness and throughput of the portable checksum helpers of
+    library/tcpip/src/tcpip_helpers.c.
+
+  Description:
+    TCPIP_Helper_CalcIPChecksum, TCPIP_Helper_ChecksumFold,
+    TCPIP_Helper_ChecksumUpdate16/32 and TCPIP_Helper_MemcpyChecksum are
+    extracted unchanged from tcpip_helpers.c by the Makefile; the rest of
+    the file needs the whole stack. They are compared against:
+    - a plain RFC 1071 reference, 16 bit words loaded one at a time,
+    - the previous portable TCPIP_Helper_CalcIPChecksum, copied below,
+    - memcpy followed by TCPIP_Helper_CalcIPChecksum.
+    Checked:
+    - random buffer alignments, lengths and seeds give the reference result,
+    - the incremental updates match a full recompute of a header checksum,
+    - the fused copy writes the same bytes and returns the same checksum
+      as the separate copy and checksum passes.
+    Then the throughput of the previous and the current routine is measured
+    for typical packet sizes, at an aligned and at an odd start address,
+    and the fused copy against the copy plus a separate checksum pass.
+
+    Build and run: make -C firmware/test/host checksum
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "tcpip/src/tcpip_types.h"
+
+// from tcpip_helpers_private.h, which needs the stack types
+uint16_t        TCPIP_Helper_CalcIPChecksum(const uint8_t* buffer, uint16_t len, uint16_t seed);
+uint16_t        TCPIP_Helper_ChecksumFold(uint32_t checksum);
+uint16_t        TCPIP_Helper_ChecksumUpdate16(uint16_t checksum, uint16_t oldVal, uint16_t newVal);
+uint16_t        TCPIP_Helper_ChecksumUpdate32(uint16_t checksum, uint32_t oldVal, uint32_t newVal);
+uint16_t        TCPIP_Helper_MemcpyChecksum(uint8_t* pDst, const uint8_t* pSrc, uint16_t len);
+
+#include "checksum_kernels.c"
+
+#define CHECK_CASES         200000
+#define CHECK_MAX_LEN       1600
+#define BENCH_BYTES         (512UL * 1024 * 1024)   // bytes summed per size and routine
+
+// previous portable version of TCPIP_Helper_CalcIPChecksum
+static uint16_t _OldCalcIPChecksum(const uint8_t* buffer, uint16_t count, uint16_t seed)
+{
+	uint16_t i;
+	uint16_t *val;
+	union
+	{
+		uint8_t  b[4];
+		uint16_t w[2];
+		uint32_t dw;
+	} sum;
+
+    if(buffer == 0)
+    {
+        return 0;
+    }
+
+	val = (uint16_t*)buffer;
+
+	// Calculate the sum of all words
+	sum.dw = (uint32_t)seed;
+    if ((uintptr_t)buffer % 2)
+    {
+        sum.w[0] += (*(uint8_t *)buffer) << 8;
+        val = (uint16_t *)(buffer + 1);
+        count--;
+    }
+
+	i = count >> 1;
+
+	while(i--)
+		sum.dw += (uint32_t)*val++;
+
+	// Add in the sum of the remaining byte, if present
+	if(count & 0x1)
+		sum.dw += (uint32_t)*(uint8_t*)val;
+
+	// Do an end-around carry (one's complement arrithmatic)
+	sum.dw = (uint32_t)sum.w[0] + (uint32_t)sum.w[1];
+
+	// Do another end-around carry in case if the prior add
+	// caused a carry out
+	sum.w[0] += sum.w[1];
+
+    if ((uintptr_t)buffer % 2)
+    {
+        sum.w[0] = ((uint16_t)sum.b[0] << 8 ) | (uint16_t)sum.b[1];
+    }
+
+	// Return the resulting checksum
+	return ~sum.w[0];
+}
+
+// RFC 1071 reference: the byte stream summed as 16 bit words in memory order.
+// As in the stack routines, the seed is summed in the lanes of the aligned
+// words, so it appears byte swapped for a buffer at an odd address.
+static uint16_t _RefChecksum(const uint8_t* buffer, uint16_t count, uint16_t seed)
+{
+    uint32_t sum = seed;
+    uint8_t  pair[2];
+    uint16_t word;
+    uint32_t ix;
+
+    if (((uintptr_t)buffer & 0x1) != 0)
+    {
+        sum = (uint16_t)((seed << 8) | (seed >> 8));
+    }
+
+    for (ix = 0; ix < count; ix += 2)
+    {
+        pair[0] = buffer[ix];
+        pair[1] = (ix + 1 < count) ? buffer[ix + 1] : 0;
+        memcpy(&word, pair, sizeof(word));
+        sum += word;
+    }
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+static uint32_t randState = 0x2545f491;
+
+static uint32_t _Rand(void)
+{
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+
+static uint64_t _NsGet(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static _Alignas(8) uint8_t testBuff[CHECK_MAX_LEN + 8];
+static _Alignas(8) uint8_t copyBuff[CHECK_MAX_LEN + 8];
+static _Alignas(8) uint8_t refBuff[CHECK_MAX_LEN + 8];
+
+static bool _CheckChecksum(void)
+{
+    uint32_t newFail = 0, oldFail = 0;
+    uint32_t ix, offset, len;
+    uint16_t seed, ref;
+
+    for (ix = 0; ix < sizeof(testBuff); ix++)
+    {
+        testBuff[ix] = (uint8_t)_Rand();
+    }
+
+    for (ix = 0; ix < CHECK_CASES; ix++)
+    {
+        offset = _Rand() % 8;
+        len = _Rand() % (CHECK_MAX_LEN + 1);
+        seed = (ix & 1) ? (uint16_t)_Rand() : 0;
+        if ((ix & 0xff) == 0)
+        {   // all ones data, the sum wraps on every word
+            memset(testBuff, 0xff, sizeof(testBuff));
+        }
+        else if ((ix & 0xff) == 1)
+        {
+            memset(testBuff, 0, sizeof(testBuff));
+        }
+        else
+        {
+            testBuff[_Rand() % sizeof(testBuff)] = (uint8_t)_Rand();
+        }
+
+        ref = _RefChecksum(testBuff + offset, len, seed);
+        newFail += (TCPIP_Helper_CalcIPChecksum(testBuff + offset, len, seed) != ref);
+        if (len != 0)
+        {   // the previous routine reads past the buffer for an empty odd start buffer
+            oldFail += (_OldCalcIPChecksum(testBuff + offset, len, seed) != ref);
+        }
+    }
+
+    printf("%-28s %s: %u cases, %u mismatches (previous routine: %u)\n", "CalcIPChecksum vs RFC 1071",
+            newFail == 0 ? "PASS" : "FAIL", CHECK_CASES, newFail, oldFail);
+    return newFail == 0;
+}
+
+// IPv4/TCP like header with the checksum at byte 10, a field rewritten in place
+static bool _CheckUpdate(void)
+{
+    uint8_t  hdr[60];
+    uint32_t fail16 = 0, fail32 = 0;
+    uint32_t ix, jx, hdrLen, fieldOffs;
+    uint16_t cks, old16, new16;
+    uint32_t old32, new32;
+
+    for (ix = 0; ix < CHECK_CASES; ix++)
+    {
+        hdrLen = 20 + 4 * (_Rand() % 11);
+        for (jx = 0; jx < hdrLen; jx++)
+        {
+            hdr[jx] = (uint8_t)_Rand();
+        }
+        memset(hdr + 10, 0, 2);
+        cks = TCPIP_Helper_CalcIPChecksum(hdr, hdrLen, 0);
+        memcpy(hdr + 10, &cks, 2);
+
+        // 16 bit field, even offset, not the checksum itself
+        do
+        {
+            fieldOffs = 2 * (_Rand() % (hdrLen / 2));
+        } while (fieldOffs == 10);
+        memcpy(&old16, hdr + fieldOffs, 2);
+        new16 = (ix & 0xf) == 0 ? (uint16_t)(old16 - 0x100) : (uint16_t)_Rand();    // TTL decrement or random
+        memcpy(hdr + fieldOffs, &new16, 2);
+        cks = TCPIP_Helper_ChecksumUpdate16(cks, old16, new16);
+        memset(hdr + 10, 0, 2);
+        fail16 += (cks != TCPIP_Helper_CalcIPChecksum(hdr, hdrLen, 0));
+        memcpy(hdr + 10, &cks, 2);
+
+        // 32 bit field, 4 byte aligned, not overlapping the checksum
+        do
+        {
+            fieldOffs = 4 * (_Rand() % (hdrLen / 4));
+        } while (fieldOffs == 8);
+        memcpy(&old32, hdr + fieldOffs, 4);
+        new32 = _Rand();
+        memcpy(hdr + fieldOffs, &new32, 4);
+        cks = TCPIP_Helper_ChecksumUpdate32(cks, old32, new32);
+        memset(hdr + 10, 0, 2);
+        fail32 += (cks != TCPIP_Helper_CalcIPChecksum(hdr, hdrLen, 0));
+    }
+
+    printf("%-28s %s: %u cases, %u/%u mismatches (16/32 bit)\n", "ChecksumUpdate vs recompute",
+            (fail16 | fail32) == 0 ? "PASS" : "FAIL", CHECK_CASES, fail16, fail32);
+    return (fail16 | fail32) == 0;
+}
+
+// random source and destination alignments, as the UDP ArrayPut chunks land in the TX buffer
+static bool _CheckMemcpyChecksum(void)
+{
+    uint32_t sumFail = 0, copyFail = 0;
+    uint32_t ix, srcOffs, dstOffs, len;
+
+    for (ix = 0; ix < sizeof(testBuff); ix++)
+    {
+        testBuff[ix] = (uint8_t)_Rand();
+    }
+
+    for (ix = 0; ix < CHECK_CASES; ix++)
+    {
+        srcOffs = _Rand() % 8;
+        dstOffs = _Rand() % 8;
+        len = _Rand() % (CHECK_MAX_LEN + 1);
+        testBuff[_Rand() % sizeof(testBuff)] = (uint8_t)_Rand();
+        memset(copyBuff, 0xa5, sizeof(copyBuff));
+        memset(refBuff, 0xa5, sizeof(refBuff));
+
+        memcpy(refBuff + dstOffs, testBuff + srcOffs, len);
+        sumFail += (TCPIP_Helper_MemcpyChecksum(copyBuff + dstOffs, testBuff + srcOffs, len) != TCPIP_Helper_CalcIPChecksum(testBuff + srcOffs, len, 0));
+        copyFail += (memcmp(copyBuff, refBuff, sizeof(copyBuff)) != 0);
+    }
+
+    printf("%-28s %s: %u cases, %u/%u mismatches (checksum/copy)\n", "MemcpyChecksum vs 2 passes",
+            (sumFail | copyFail) == 0 ? "PASS" : "FAIL", CHECK_CASES, sumFail, copyFail);
+    return (sumFail | copyFail) == 0;
+}
+
+static double _Throughput(uint16_t (*checksum)(const uint8_t*, uint16_t, uint16_t), const uint8_t* buffer, uint16_t len)
+{
+    uint32_t nCalls = BENCH_BYTES / len;
+    volatile uint16_t sink = 0;
+    uint64_t t0, elapsed;
+    uint32_t ix;
+
+    t0 = _NsGet();
+    for (ix = 0; ix < nCalls; ix++)
+    {
+        sink += checksum(buffer, len, (uint16_t)ix);
+    }
+    elapsed = _NsGet() - t0;
+    (void)sink;
+
+    return (double)nCalls * len / elapsed;    // bytes per ns == GB/s
+}
+
+static uint16_t _CopyThenChecksum(uint8_t* pDst, const uint8_t* pSrc, uint16_t len)
+{
+    memcpy(pDst, pSrc, len);
+    return TCPIP_Helper_CalcIPChecksum(pDst, len, 0);
+}
+
+static double _CopyThroughput(uint16_t (*copySum)(uint8_t*, const uint8_t*, uint16_t), uint8_t* pDst, const uint8_t* pSrc, uint16_t len)
+{
+    uint32_t nCalls = BENCH_BYTES / len;
+    volatile uint16_t sink = 0;
+    uint64_t t0, elapsed;
+    uint32_t ix;
+
+    t0 = _NsGet();
+    for (ix = 0; ix < nCalls; ix++)
+    {
+        sink += copySum(pDst, pSrc, len);
+    }
+    elapsed = _NsGet() - t0;
+    (void)sink;
+
+    return (double)nCalls * len / elapsed;
+}
+
+static void _RunThroughput(void)
+{
+    static const uint16_t sizes[] = {20, 64, 256, 576, 1460};
+    uint32_t ix, offset;
+    double oldGBs, newGBs;
+
+    for (offset = 0; offset < 2; offset++)
+    {
+        for (ix = 0; ix < sizeof(sizes) / sizeof(*sizes); ix++)
+        {
+            oldGBs = _Throughput(_OldCalcIPChecksum, testBuff + offset, sizes[ix]);
+            newGBs = _Throughput(TCPIP_Helper_CalcIPChecksum, testBuff + offset, sizes[ix]);
+            printf("%4u bytes, %s start: previous %5.2f GB/s, current %5.2f GB/s, x%.2f\n", sizes[ix],
+                    offset ? "odd " : "even", oldGBs, newGBs, newGBs / oldGBs);
+        }
+    }
+}
+
+// the destination is off by one from the source, as for data appended to a TX buffer
+static void _RunCopyThroughput(void)
+{
+    static const uint16_t sizes[] = {16, 64, 256, 536, 1460};
+    uint32_t ix, offset;
+    double twoGBs, fusedGBs;
+
+    for (offset = 0; offset < 2; offset++)
+    {
+        for (ix = 0; ix < sizeof(sizes) / sizeof(*sizes); ix++)
+        {
+            twoGBs = _CopyThroughput(_CopyThenChecksum, copyBuff + 1, testBuff + offset, sizes[ix]);
+            fusedGBs = _CopyThroughput(TCPIP_Helper_MemcpyChecksum, copyBuff + 1, testBuff + offset, sizes[ix]);
+            printf("%4u bytes, %s start: copy + checksum %5.2f GB/s, fused %5.2f GB/s, x%.2f\n", sizes[ix],
+                    offset ? "odd " : "even", twoGBs, fusedGBs, fusedGBs / twoGBs);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool pass = true;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    pass &= _CheckChecksum();
+    pass &= _CheckUpdate();
+    pass &= _CheckMemcpyChecksum();
+    _RunThroughput();
+    _RunCopyThroughput();
+
+    printf("%s\n", pass ? "ALL PASS" : "FAILED");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,826 @@
+/*******************************************************************************
+  DHCP server burst host simulation
+
+  Summary:
+    Lease latency of library/tcpip/src/dhcps.c when many clients start
+    at the same time.
+
+  Description:
+    dhcps.c, oahash.c and the notification helpers are compiled unchanged.
+    BURST_CLIENTS DHCP clients power up within the first 100 ms and talk to
+    the server in simulated time, as after a SoftAP restart:
+    - the server socket queues at most the RX queue limit the server sets;
+      further messages are dropped, as by udp.c,
+    - the server task runs every TCPIP_DHCPS_TASK_PROCESS_RATE ms and as
+      soon as a message is queued, as the stack manager runs it,
+    - no host answers the ICMP echo probe of an offered address: each
+      request times out after TCPIP_ICMP_ECHO_REQUEST_TIMEOUT, checked
+      every TCPIP_ICMP_TASK_TICK_RATE ms, as in icmp.c,
+    - a client sends a DISCOVER, a REQUEST for the first OFFER it gets and
+      is bound by the ACK. It retransmits after 4, 8, 16, 32 and 64 s,
+      +/- 1 s (RFC 2131 4.1), restarts after 4 unanswered REQUESTs and
+      on a NAK.
+    Reported: the time from the first DISCOVER of a client to its first
+    OFFER and to its ACK, the clients bound over time, the messages sent
+    and those dropped by the server socket.
+    Checked, unless run with "report":
+    - all the clients are bound within BURST_RUN_MS,
+    - each client is bound to the address it was offered, and no two
+      clients share an address.
+
+    Build and run: make -C firmware/test/host dhcps
+    dhcps-base runs the simulation against dhcps.c of an older revision,
+    for comparison: make -C firmware/test/host dhcps-base BASE=<rev>
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TCPIP_THIS_MODULE_ID    TCPIP_MODULE_DHCP_SERVER
+
+#include "tcpip/src/tcpip_private.h"
+#include "tcpip/src/dhcps_private.h"
+#undef vsnprintf
+
+#define BURST_CLIENTS           50
+#define BURST_LEASE_ENTRIES     64          // the lease and pool entries
+#define BURST_START_SPREAD      100         // ms, the clients power up in this interval
+#define BURST_RUN_MS            600000
+#define BURST_TURNAROUND        2           // ms, from a server message to the client answer
+#define BURST_REQUEST_TRIES     4
+#define BURST_MSG_SIZE          300         // as the smallest BOOTP message
+#define BURST_QUEUE_MAX         16
+#define BURST_SKT               1
+#define BURST_OPTIONS_OFFSET    (sizeof(BOOTP_HEADER) + DHCPS_UNUSED_BYTES_FOR_TX + 4)
+#define BURST_MAGIC_COOKIE      0x63538263ul
+
+typedef enum
+{
+    BURST_CLIENT_SELECTING,
+    BURST_CLIENT_REQUESTING,
+    BURST_CLIENT_BOUND,
+}BURST_CLIENT_STATE;
+
+typedef struct
+{
+    BURST_CLIENT_STATE  state;
+    TCPIP_MAC_ADDR      mac;
+    uint32_t            xid;
+    IPV4_ADDR           offered;
+    IPV4_ADDR           bound;
+    uint32_t            startTime;      // first DISCOVER
+    uint32_t            offerTime;      // first OFFER, 0 if none yet
+    uint32_t            ackTime;
+    uint32_t            nextTx;         // next transmission, 0 if none
+    int                 tries;          // transmissions of the current message
+    bool                answer;         // nextTx answers a server message
+}BURST_CLIENT;
+
+typedef struct
+{
+    uint16_t            len;
+    uint16_t            rdOffset;
+    uint8_t             data[BURST_MSG_SIZE];
+}BURST_MSG;
+
+static uint32_t         burstNow;           // ms
+static uint32_t         burstRandState;
+static TCPIP_NET_IF     burstNetIf;
+static TCPIP_MODULE_SIGNAL burstSignals;
+static BURST_CLIENT     burstClient[BURST_CLIENTS];
+static uint32_t         burstErrors;
+static bool             burstMute;
+
+// server socket
+static BURST_MSG        burstRxQueue[BURST_QUEUE_MAX];
+static int              burstRxHead;
+static int              burstRxCount;
+static uint8_t          burstRxLimit = TCPIP_UDP_SOCKET_DEFAULT_RX_QUEUE_LIMIT;
+static uint8_t          burstTxLimit = TCPIP_UDP_SOCKET_DEFAULT_TX_QUEUE_LIMIT;
+static uint8_t          burstTxBuff[TCPIP_UDP_SOCKET_DEFAULT_TX_SIZE];
+static uint16_t         burstTxLen;
+static TCPIP_UDP_SIGNAL_FUNCTION burstRxSignal;
+
+// ICMP echo request in progress
+static TCPIP_ICMP_ECHO_REQUEST burstEchoReq;
+static bool             burstEchoBusy;
+static uint32_t         burstEchoTime;
+
+// counters
+static uint32_t         burstDiscovers;
+static uint32_t         burstRequests;
+static uint32_t         burstDropped;
+static uint32_t         burstOffers;
+static uint32_t         burstAcks;
+static uint32_t         burstNaks;
+static uint32_t         burstProbes;
+
+static uint32_t _Rand(void)
+{
+    burstRandState ^= burstRandState << 13;
+    burstRandState ^= burstRandState >> 17;
+    burstRandState ^= burstRandState << 5;
+    return burstRandState;
+}
+
+// system services
+uint32_t SYS_TMR_TickCountGet(void)
+{
+    return burstNow;
+}
+
+uint32_t SYS_TMR_TickCounterFrequencyGet(void)
+{
+    return 1000;
+}
+
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void)
+{
+    return SYS_ERROR_ERROR;
+}
+
+SYS_MODULE_INDEX SYS_DEBUG_ConsoleInstanceGet(void)
+{
+    return SYS_CONSOLE_INDEX_0;
+}
+
+void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char* format, ...)
+{
+    va_list args;
+
+    if(!burstMute)
+    {
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+    }
+}
+
+int _HostVsnprintf(char* buff, size_t size, const char* fmt, va_list args)
+{
+    return vsnprintf(buff, size, fmt, args);
+}
+
+// heap
+static void* _HeapMalloc(TCPIP_STACK_HEAP_HANDLE heapH, size_t nBytes)
+{
+    return malloc(nBytes);
+}
+
+static void* _HeapCalloc(TCPIP_STACK_HEAP_HANDLE heapH, size_t nElems, size_t elemSize)
+{
+    return calloc(nElems, elemSize);
+}
+
+static size_t _HeapFree(TCPIP_STACK_HEAP_HANDLE heapH, const void* pBuff)
+{
+    free((void*)pBuff);
+    return 0;
+}
+
+static const TCPIP_HEAP_OBJECT burstHeap =
+{
+    .TCPIP_HEAP_Malloc = _HeapMalloc,
+    .TCPIP_HEAP_Calloc = _HeapCalloc,
+    .TCPIP_HEAP_Free = _HeapFree,
+};
+
+// stack manager
+static tcpipModuleSignalHandler burstHandler;
+
+tcpipSignalHandle _TCPIPStackSignalHandlerRegister(TCPIP_STACK_MODULE modId, tcpipModuleSignalHandler signalHandler, int16_t asyncTmoMs)
+{
+    burstHandler = signalHandler;
+    return &burstHandler;
+}
+
+void _TCPIPStackSignalHandlerDeregister(tcpipSignalHandle handle)
+{
+    burstHandler = 0;
+}
+
+TCPIP_MODULE_SIGNAL _TCPIPStackModuleSignalGet(TCPIP_STACK_MODULE modId, TCPIP_MODULE_SIGNAL clrMask)
+{
+    TCPIP_MODULE_SIGNAL sigs = burstSignals;
+
+    burstSignals &= ~clrMask;
+    return sigs;
+}
+
+bool _TCPIPStackModuleSignalRequest(TCPIP_STACK_MODULE modId, TCPIP_MODULE_SIGNAL signal, bool noMgrAlert)
+{
+    burstSignals |= signal;
+    return true;
+}
+
+TCPIP_NET_HANDLE TCPIP_STACK_NetDefaultGet(void)
+{
+    return &burstNetIf;
+}
+
+TCPIP_NET_HANDLE TCPIP_STACK_IndexToNet(int netIx)
+{
+    return netIx == 0 ? &burstNetIf : 0;
+}
+
+int TCPIP_STACK_NetIndexGet(TCPIP_NET_HANDLE hNet)
+{
+    return 0;
+}
+
+int TCPIP_STACK_NetIxGet(TCPIP_NET_IF* pNetIf)
+{
+    return 0;
+}
+
+int TCPIP_STACK_NumberOfNetworksGet(void)
+{
+    return 1;
+}
+
+bool TCPIP_STACK_NetworkIsLinked(TCPIP_NET_IF* pNetIf)
+{
+    return true;
+}
+
+TCPIP_NET_IF* _TCPIPStackHandleToNetLinked(TCPIP_NET_HANDLE hNet)
+{
+    return (TCPIP_NET_IF*)hNet;
+}
+
+bool TCPIP_STACK_AddressServiceCanStart(TCPIP_NET_IF* pNetIf, TCPIP_STACK_ADDRESS_SERVICE_TYPE adSvcType)
+{
+    return true;
+}
+
+void TCPIP_STACK_AddressServiceEvent(TCPIP_NET_IF* pNetIf, TCPIP_STACK_ADDRESS_SERVICE_TYPE adSvcType, TCPIP_STACK_ADDRESS_SERVICE_EVENT evType)
+{
+}
+
+void TCPIP_STACK_AddressServiceDefaultSet(TCPIP_NET_IF* pNetIf)
+{
+}
+
+void _TCPIPStackSetConfigAddress(TCPIP_NET_IF* pNetIf, IPV4_ADDR* ipAddress, IPV4_ADDR* mask, bool config)
+{
+    if(ipAddress != 0)
+    {
+        pNetIf->netIPAddr.Val = ipAddress->Val;
+    }
+    if(mask != 0)
+    {
+        pNetIf->netMask.Val = mask->Val;
+    }
+}
+
+void TCPIP_STACK_GatewayAddressSet(TCPIP_NET_IF* pNetIf, IPV4_ADDR* ipAddress)
+{
+}
+
+// the helpers use it for multi segment packets only
+TCPIP_MAC_DATA_SEGMENT* TCPIP_PKT_DataSegmentGet(TCPIP_MAC_PACKET* pPkt, const uint8_t* dataAddress, bool srchTransport)
+{
+    return pPkt->pDSeg;
+}
+
+// ICMP: the probed addresses are free, no reply
+ICMP_ECHO_RESULT TCPIP_ICMP_EchoRequest(TCPIP_ICMP_ECHO_REQUEST* pEchoRequest, TCPIP_ICMP_REQUEST_HANDLE* pHandle)
+{
+    if(burstEchoBusy)
+    {   // icmp.c runs one request at a time
+        return ICMP_ECHO_BUSY;
+    }
+    burstEchoReq = *pEchoRequest;
+    burstEchoBusy = true;
+    burstEchoTime = burstNow;
+    burstProbes++;
+    if(pHandle != 0)
+    {
+        *pHandle = &burstEchoReq;
+    }
+    return ICMP_ECHO_OK;
+}
+
+ICMP_ECHO_RESULT TCPIP_ICMP_EchoRequestCancel(TCPIP_ICMP_REQUEST_HANDLE icmpHandle)
+{
+    if(burstEchoBusy && icmpHandle == &burstEchoReq)
+    {
+        burstEchoBusy = false;
+        return ICMP_ECHO_OK;
+    }
+    return ICMP_ECHO_BAD_HANDLE;
+}
+
+static void _EchoTask(void)
+{
+    if(burstEchoBusy && (burstNow % TCPIP_ICMP_TASK_TICK_RATE) == 0 && burstNow - burstEchoTime >= TCPIP_ICMP_ECHO_REQUEST_TIMEOUT)
+    {
+        burstEchoBusy = false;
+        (*burstEchoReq.callback)(&burstEchoReq, &burstEchoReq, TCPIP_ICMP_ECHO_REQUEST_RES_TMO);
+    }
+}
+
+// UDP: the server socket
+static void _ClientReceive(const uint8_t* pMsg, uint16_t msgLen);
+
+UDP_SOCKET TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE addType, UDP_PORT localPort, IP_MULTI_ADDRESS* localAddress)
+{
+    return BURST_SKT;
+}
+
+bool TCPIP_UDP_Close(UDP_SOCKET hUDP)
+{
+    return true;
+}
+
+TCPIP_UDP_SIGNAL_HANDLE TCPIP_UDP_SignalHandlerRegister(UDP_SOCKET s, TCPIP_UDP_SIGNAL_TYPE sigMask, TCPIP_UDP_SIGNAL_FUNCTION handler, const void* hParam)
+{
+    burstRxSignal = handler;
+    return &burstRxSignal;
+}
+
+// the queue limits are 8 bit values
+bool TCPIP_UDP_OptionsSet(UDP_SOCKET hUDP, UDP_SOCKET_OPTION option, void* optParam)
+{
+    switch(option)
+    {
+        case UDP_OPTION_RX_QUEUE_LIMIT:
+            burstRxLimit = (uint8_t)(uintptr_t)optParam;
+            return burstRxLimit <= BURST_QUEUE_MAX;
+
+        case UDP_OPTION_TX_QUEUE_LIMIT:
+            burstTxLimit = (uint8_t)(uintptr_t)optParam;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool TCPIP_UDP_OptionsGet(UDP_SOCKET hUDP, UDP_SOCKET_OPTION option, void* optParam)
+{
+    switch(option)
+    {
+        case UDP_OPTION_RX_QUEUE_LIMIT:
+            *(uint8_t*)optParam = burstRxLimit;
+            return true;
+
+        case UDP_OPTION_TX_QUEUE_LIMIT:
+            *(uint8_t*)optParam = burstTxLimit;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool TCPIP_UDP_SocketInfoGet(UDP_SOCKET hUDP, UDP_SOCKET_INFO* pInfo)
+{
+    memset(pInfo, 0, sizeof(*pInfo));
+    pInfo->addressType = IP_ADDRESS_TYPE_IPV4;
+    pInfo->localPort = TCPIP_DHCP_SERVER_PORT;
+    pInfo->remotePort = TCPIP_DHCP_CLIENT_PORT;
+    pInfo->hNet = &burstNetIf;
+    pInfo->rxQueueSize = burstRxCount;
+    pInfo->txSize = sizeof(burstTxBuff);
+    return true;
+}
+
+TCPIP_NET_HANDLE TCPIP_UDP_SocketNetGet(UDP_SOCKET hUDP)
+{
+    return &burstNetIf;
+}
+
+bool TCPIP_UDP_BcastIPV4AddressSet(UDP_SOCKET hUDP, UDP_SOCKET_BCAST_TYPE bcastType, TCPIP_NET_HANDLE hNet)
+{
+    return true;
+}
+
+bool TCPIP_UDP_SourceIPAddressSet(UDP_SOCKET hUDP, IP_ADDRESS_TYPE addType, IP_MULTI_ADDRESS* localAddress)
+{
+    return true;
+}
+
+uint16_t TCPIP_UDP_GetIsReady(UDP_SOCKET hUDP)
+{
+    BURST_MSG* pMsg = burstRxQueue + burstRxHead;
+
+    return burstRxCount == 0 ? 0 : pMsg->len - pMsg->rdOffset;
+}
+
+uint16_t TCPIP_UDP_ArrayGet(UDP_SOCKET hUDP, uint8_t *cData, uint16_t wDataLen)
+{
+    BURST_MSG* pMsg = burstRxQueue + burstRxHead;
+    uint16_t avlblBytes = TCPIP_UDP_GetIsReady(hUDP);
+
+    if(wDataLen > avlblBytes)
+    {
+        wDataLen = avlblBytes;
+    }
+    if(cData != 0)
+    {
+        memcpy(cData, pMsg->data + pMsg->rdOffset, wDataLen);
+    }
+    pMsg->rdOffset += wDataLen;
+    return wDataLen;
+}
+
+uint16_t TCPIP_UDP_Discard(UDP_SOCKET hUDP)
+{
+    uint16_t nBytes = TCPIP_UDP_GetIsReady(hUDP);
+
+    if(burstRxCount != 0)
+    {
+        burstRxHead = (burstRxHead + 1) % BURST_QUEUE_MAX;
+        burstRxCount--;
+    }
+    return nBytes;
+}
+
+uint16_t TCPIP_UDP_TxPutIsReady(UDP_SOCKET hUDP, unsigned short count)
+{
+    return sizeof(burstTxBuff) - burstTxLen;
+}
+
+uint8_t* TCPIP_UDP_TxPointerGet(UDP_SOCKET hUDP)
+{
+    return burstTxBuff + burstTxLen;
+}
+
+bool TCPIP_UDP_TxOffsetSet(UDP_SOCKET hUDP, uint16_t wOffset, bool relative)
+{
+    if(relative)
+    {
+        wOffset += burstTxLen;
+    }
+    if(wOffset > sizeof(burstTxBuff))
+    {
+        return false;
+    }
+    burstTxLen = wOffset;
+    return true;
+}
+
+// the server messages are broadcast: every client sees them
+uint16_t TCPIP_UDP_Flush(UDP_SOCKET hUDP)
+{
+    uint16_t txLen = burstTxLen;
+
+    burstTxLen = 0;
+    _ClientReceive(burstTxBuff, txLen);
+    return txLen;
+}
+
+// queues a client message to the server socket
+static void _ServerQueue(const uint8_t* pData, uint16_t len)
+{
+    BURST_MSG* pMsg;
+
+    if(burstRxCount >= burstRxLimit)
+    {
+        burstDropped++;
+        return;
+    }
+
+    pMsg = burstRxQueue + (burstRxHead + burstRxCount) % BURST_QUEUE_MAX;
+    memcpy(pMsg->data, pData, len);
+    pMsg->len = len;
+    pMsg->rdOffset = 0;
+    burstRxCount++;
+    if(burstRxSignal != 0)
+    {
+        (*burstRxSignal)(BURST_SKT, &burstNetIf, TCPIP_UDP_SIGNAL_RX_DATA, 0);
+    }
+}
+
+// clients
+static uint32_t _ClientTimeout(int tries)
+{
+    uint32_t tmo = 4000u << (tries < 5 ? tries - 1 : 4);
+
+    return tmo - 1000 + _Rand() % 2001;
+}
+
+static void _ClientSend(BURST_CLIENT* pClient)
+{
+    uint8_t msg[BURST_MSG_SIZE];
+    BOOTP_HEADER* pHdr = (BOOTP_HEADER*)msg;
+    uint8_t* pOpt = msg + BURST_OPTIONS_OFFSET;
+    uint32_t cookie = BURST_MAGIC_COOKIE;
+
+    memset(msg, 0, sizeof(msg));
+    pHdr->MessageType = BOOT_REQUEST;
+    pHdr->HardwareType = 1;
+    pHdr->HardwareLen = 6;
+    pHdr->TransactionID = pClient->xid;
+    pHdr->ClientMAC = pClient->mac;
+    memcpy(pOpt - 4, &cookie, sizeof(cookie));
+
+    *pOpt++ = DHCP_MESSAGE_TYPE;
+    *pOpt++ = DHCP_MESSAGE_TYPE_LEN;
+    if(pClient->state == BURST_CLIENT_SELECTING)
+    {
+        *pOpt++ = DHCP_DISCOVER_MESSAGE;
+        burstDiscovers++;
+    }
+    else
+    {
+        *pOpt++ = DHCP_REQUEST_MESSAGE;
+        *pOpt++ = DHCP_PARAM_REQUEST_IP_ADDRESS;
+        *pOpt++ = DHCP_PARAM_REQUEST_IP_ADDRESS_LEN;
+        memcpy(pOpt, &pClient->offered, sizeof(pClient->offered));
+        pOpt += sizeof(pClient->offered);
+        *pOpt++ = DHCP_SERVER_IDENTIFIER;
+        *pOpt++ = DHCP_SERVER_IDENTIFIER_LEN;
+        memcpy(pOpt, &burstNetIf.netIPAddr, sizeof(burstNetIf.netIPAddr));
+        pOpt += sizeof(burstNetIf.netIPAddr);
+        burstRequests++;
+    }
+    *pOpt++ = DHCP_END_OPTION;
+
+    if(pClient->tries == 0 && pClient->state == BURST_CLIENT_SELECTING && pClient->startTime == 0)
+    {
+        pClient->startTime = burstNow;
+    }
+    pClient->tries++;
+    pClient->nextTx = burstNow + _ClientTimeout(pClient->tries);
+    pClient->answer = false;
+    _ServerQueue(msg, sizeof(msg));
+}
+
+// back to a DISCOVER
+static void _ClientRestart(BURST_CLIENT* pClient, uint32_t when)
+{
+    pClient->state = BURST_CLIENT_SELECTING;
+    pClient->xid = _Rand();
+    pClient->tries = 0;
+    pClient->nextTx = when;
+    pClient->answer = true;
+}
+
+static void _ClientTimer(BURST_CLIENT* pClient)
+{
+    if(pClient->state == BURST_CLIENT_BOUND || pClient->nextTx == 0 || burstNow < pClient->nextTx)
+    {
+        return;
+    }
+
+    if(pClient->state == BURST_CLIENT_REQUESTING && !pClient->answer && pClient->tries >= BURST_REQUEST_TRIES)
+    {   // no ACK, start over
+        _ClientRestart(pClient, burstNow);
+    }
+    _ClientSend(pClient);
+}
+
+static void _ClientReceive(const uint8_t* pMsg, uint16_t msgLen)
+{
+    const BOOTP_HEADER* pHdr = (const BOOTP_HEADER*)pMsg;
+    const uint8_t* pOpt = pMsg + BURST_OPTIONS_OFFSET;
+    BURST_CLIENT* pClient;
+    uint8_t msgType = 0;
+    int ix;
+
+    if(msgLen <= BURST_OPTIONS_OFFSET + 2 || pHdr->MessageType != BOOT_REPLY)
+    {
+        burstErrors++;
+        return;
+    }
+
+    while(pOpt + 2 <= pMsg + msgLen && *pOpt != DHCP_END_OPTION)
+    {
+        if(*pOpt == DHCP_MESSAGE_TYPE)
+        {
+            msgType = pOpt[2];
+            break;
+        }
+        pOpt += 2 + pOpt[1];
+    }
+
+    switch(msgType)
+    {
+        case DHCP_OFFER_MESSAGE:
+            burstOffers++;
+            break;
+        case DHCP_ACK_MESSAGE:
+            burstAcks++;
+            break;
+        case DHCP_NAK_MESSAGE:
+            burstNaks++;
+            break;
+        default:
+            burstErrors++;
+            return;
+    }
+
+    for(ix = 0, pClient = burstClient; ix < BURST_CLIENTS; ix++, pClient++)
+    {
+        if(memcmp(&pClient->mac, &pHdr->ClientMAC, sizeof(pClient->mac)) == 0 && pClient->xid == pHdr->TransactionID)
+        {
+            break;
+        }
+    }
+    if(ix == BURST_CLIENTS)
+    {   // stale transaction
+        return;
+    }
+
+    if(msgType == DHCP_OFFER_MESSAGE)
+    {
+        if(pClient->state == BURST_CLIENT_SELECTING)
+        {   // take the first offer
+            if(pClient->offerTime == 0)
+            {
+                pClient->offerTime = burstNow;
+            }
+            pClient->offered = pHdr->YourIP;
+            pClient->state = BURST_CLIENT_REQUESTING;
+            pClient->tries = 0;
+            pClient->nextTx = burstNow + BURST_TURNAROUND;
+            pClient->answer = true;
+        }
+    }
+    else if(pClient->state == BURST_CLIENT_REQUESTING)
+    {
+        if(msgType == DHCP_ACK_MESSAGE)
+        {
+            pClient->bound = pHdr->YourIP;
+            pClient->ackTime = burstNow;
+            pClient->state = BURST_CLIENT_BOUND;
+            pClient->nextTx = 0;
+        }
+        else
+        {
+            _ClientRestart(pClient, burstNow + BURST_TURNAROUND);
+        }
+    }
+}
+
+static void _Check(bool cond, const char* what, int clientIx)
+{
+    if(!cond)
+    {
+        printf("FAIL: client %d: %s\n", clientIx, what);
+        burstErrors++;
+    }
+}
+
+static void _Report(bool check)
+{
+    static const uint32_t boundAt[] = {10000, 30000, 60000, 120000, 300000, BURST_RUN_MS};
+    uint64_t offerTotal = 0, ackTotal = 0;
+    uint32_t offerMax = 0, ackMax = 0, latency;
+    int ix, jx, nOffered = 0, nBound = 0, nAt;
+    BURST_CLIENT* pClient;
+
+    for(ix = 0, pClient = burstClient; ix < BURST_CLIENTS; ix++, pClient++)
+    {
+        if(pClient->offerTime != 0)
+        {
+            latency = pClient->offerTime - pClient->startTime;
+            offerTotal += latency;
+            offerMax = latency > offerMax ? latency : offerMax;
+            nOffered++;
+        }
+        if(pClient->state == BURST_CLIENT_BOUND)
+        {
+            latency = pClient->ackTime - pClient->startTime;
+            ackTotal += latency;
+            ackMax = latency > ackMax ? latency : ackMax;
+            nBound++;
+        }
+    }
+
+    printf("%d clients, %d lease entries, server RX queue limit %d\n", BURST_CLIENTS, BURST_LEASE_ENTRIES, burstRxLimit);
+    printf("time to OFFER: avg %6.1f s  max %6.1f s  (%d clients)\n", nOffered ? offerTotal / 1000.0 / nOffered : 0.0, offerMax / 1000.0, nOffered);
+    printf("time to ACK:   avg %6.1f s  max %6.1f s  (%d clients)\n", nBound ? ackTotal / 1000.0 / nBound : 0.0, ackMax / 1000.0, nBound);
+    printf("bound after");
+    for(jx = 0; jx < sizeof(boundAt) / sizeof(*boundAt); jx++)
+    {
+        for(ix = 0, nAt = 0, pClient = burstClient; ix < BURST_CLIENTS; ix++, pClient++)
+        {
+            if(pClient->state == BURST_CLIENT_BOUND && pClient->ackTime - pClient->startTime <= boundAt[jx])
+            {
+                nAt++;
+            }
+        }
+        printf("  %us: %d", boundAt[jx] / 1000, nAt);
+    }
+    printf("\nsent: %u DISCOVER, %u REQUEST; dropped by the server socket: %u\n", burstDiscovers, burstRequests, burstDropped);
+    printf("received: %u OFFER, %u ACK, %u NAK; address probes: %u\n", burstOffers, burstAcks, burstNaks, burstProbes);
+
+    if(!check)
+    {
+        return;
+    }
+
+    for(ix = 0, pClient = burstClient; ix < BURST_CLIENTS; ix++, pClient++)
+    {
+        _Check(pClient->state == BURST_CLIENT_BOUND, "not bound", ix);
+        if(pClient->state != BURST_CLIENT_BOUND)
+        {
+            continue;
+        }
+        _Check(pClient->bound.Val == pClient->offered.Val, "bound to an address it was not offered", ix);
+        for(jx = 0; jx < ix; jx++)
+        {
+            if(burstClient[jx].state == BURST_CLIENT_BOUND)
+            {
+                _Check(burstClient[jx].bound.Val != pClient->bound.Val, "address shared", ix);
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    TCPIP_STACK_MODULE_CTRL stackCtrl;
+    TCPIP_DHCPS_MODULE_CONFIG dhcpsConfig;
+    TCPIP_DHCPS_ADDRESS_CONFIG poolConfig;
+    BURST_CLIENT* pClient;
+    int ix;
+    bool check = argc < 2 || strcmp(argv[1], "report") != 0;
+    bool bound;
+
+    burstRandState = 0x2545f491;
+    burstNetIf.Flags.bInterfaceEnabled = 1;
+
+    memset(&poolConfig, 0, sizeof(poolConfig));
+    poolConfig.interfaceIndex = 0;
+    poolConfig.poolIndex = 0;
+    poolConfig.serverIPAddress = "192.168.1.1";
+    poolConfig.startIPAddRange = "192.168.1.100";
+    poolConfig.ipMaskAddress = "255.255.255.0";
+    poolConfig.priDNS = "192.168.1.1";
+    poolConfig.secondDNS = "192.168.1.1";
+    poolConfig.poolEnabled = true;
+
+    memset(&dhcpsConfig, 0, sizeof(dhcpsConfig));
+    dhcpsConfig.enabled = true;
+    dhcpsConfig.deleteOldLease = true;
+    dhcpsConfig.dhcpServerCnt = 1;
+    dhcpsConfig.leaseEntries = BURST_LEASE_ENTRIES;
+    dhcpsConfig.entrySolvedTmo = TCPIP_DHCPS_LEASE_SOLVED_ENTRY_TMO;
+    dhcpsConfig.dhcpServer = &poolConfig;
+
+    memset(&stackCtrl, 0, sizeof(stackCtrl));
+    stackCtrl.memH = (TCPIP_STACK_HEAP_HANDLE)&burstHeap;
+    stackCtrl.stackAction = TCPIP_STACK_ACTION_INIT;
+    stackCtrl.pNetIf = &burstNetIf;
+    stackCtrl.nIfs = 1;
+
+    // the stack starts at time 1: 0 marks unset times
+    burstNow = 1;
+    if(!TCPIP_DHCPS_Initialize(&stackCtrl, &dhcpsConfig) || !TCPIP_DHCPS_Enable(&burstNetIf))
+    {
+        printf("FAIL: DHCP server initialization\n");
+        return 1;
+    }
+    // the ICMP probe traces
+    burstMute = true;
+
+    for(ix = 0, pClient = burstClient; ix < BURST_CLIENTS; ix++, pClient++)
+    {
+        pClient->mac.v[0] = 0x02;
+        pClient->mac.v[4] = (uint8_t)(ix >> 8);
+        pClient->mac.v[5] = (uint8_t)ix;
+        _ClientRestart(pClient, burstNow + 1 + _Rand() % BURST_START_SPREAD);
+    }
+
+    for(; burstNow < BURST_RUN_MS; burstNow++)
+    {
+        _EchoTask();
+        bound = true;
+        for(ix = 0, pClient = burstClient; ix < BURST_CLIENTS; ix++, pClient++)
+        {
+            _ClientTimer(pClient);
+            bound &= pClient->state == BURST_CLIENT_BOUND;
+        }
+        if(bound)
+        {
+            break;
+        }
+        if((burstNow % TCPIP_DHCPS_TASK_PROCESS_RATE) == 0)
+        {
+            burstSignals |= TCPIP_MODULE_SIGNAL_TMO;
+        }
+        if(burstSignals != 0)
+        {
+            (*burstHandler)();
+        }
+    }
+
+    _Report(check);
+
+    stackCtrl.stackAction = TCPIP_STACK_ACTION_DEINIT;
+    TCPIP_DHCPS_Deinitialize(&stackCtrl);
+
+    if(burstErrors != 0)
+    {
+        printf("FAILED: %u errors\n", burstErrors);
+        return 1;
+    }
+    return 0;
+}
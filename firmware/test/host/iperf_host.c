@@ -0,0 +1,1091 @@
+/*******************************************************************************
+  iperf host loopback test
+
+  Summary:
+    Runs library/tcpip/src/iperf.c against itself over the host loopback.
+
+  Description:
+    iperf.c is compiled unchanged. The TCP and UDP socket calls it makes are
+    implemented here over non-blocking host sockets:
+    - a TCP socket keeps a TX FIFO of the TCP_OPTION_TX_BUFF size, drained
+      into the host socket by the stack loop, as the stack TCP task would,
+    - TCP_OPTION_RX_BUFF sets the host receive buffer, the advertised window,
+    - a UDP socket reads one datagram at a time, as the stack UDP RX queue.
+    The stack loop calls the iperf task continuously while it requests
+    TCPIP_MODULE_SIGNAL_ASYNC, at its task rate otherwise.
+
+    The console commands of each scenario are run and the scenario waits
+    until every session is idle again. Checked for each scenario:
+    - the console output has the expected lines,
+    - the TCP bytes read by the server match the bytes the client wrote.
+    The console output is printed, for the throughput numbers.
+
+    Build and run: make -C firmware/test/host iperf
+    A host iperf 2.x peer can be used against the servers started by
+    "iperf_host serve", which runs until interrupted.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "tcpip/src/tcpip_private.h"
+#undef vsnprintf
+
+#define HOST_SOCKETS            16
+#define HOST_UDP_TX_SIZE        512         // stack default UDP TX buffer
+#define HOST_CONSOLE_SIZE       16384
+#define HOST_IDLE_TMO           30          // s, scenario limit
+
+typedef enum
+{
+    HOST_SKT_FREE = 0,
+    HOST_SKT_TCP,
+    HOST_SKT_UDP,
+}HOST_SKT_TYPE;
+
+typedef struct
+{
+    HOST_SKT_TYPE   type;
+    bool            server;
+    bool            connecting;     // TCP client connect issued
+    bool            connected;
+    bool            wasDisconnected;
+    bool            closing;        // TCP: closed with data still in the TX FIFO
+    int             fd;             // TCP: connection; UDP: socket
+    int             listenFd;       // TCP server
+    uint16_t        localPort;      // TCP server
+    struct sockaddr_in  remote;     // TCP client: server; UDP: destination
+    uint8_t*        txBuff;
+    uint32_t        txSize;
+    uint32_t        txLen;
+    uint32_t        rxSize;
+    // UDP current datagram
+    uint8_t         rxBuff[0x10000];
+    uint32_t        rxLen;
+    uint32_t        rxOffset;
+    struct sockaddr_in  source;
+}HOST_SKT;
+
+static HOST_SKT         hostSkt[HOST_SOCKETS];
+
+// stack manager
+static tcpipModuleSignalHandler hostHandler;
+static uint32_t         hostTaskRate;       // ms
+static bool             hostAsync;
+
+// console
+static const SYS_CMD_DESCRIPTOR* hostCmdTbl;
+static int              hostCmdCount;
+static char             hostConsole[HOST_CONSOLE_SIZE];
+static size_t           hostConsoleLen;
+static bool             hostErrors;
+
+// transferred TCP bytes
+static uint64_t         hostTcpTx;
+static uint64_t         hostTcpRx;
+
+static volatile sig_atomic_t hostStop;
+
+static uint64_t _NsGet(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// drops the l length modifiers
+int _HostVsnprintf(char* buff, size_t size, const char* fmt, va_list args)
+{
+    char hostFmt[256];
+    size_t ix, jx;
+    bool spec = false;
+
+    for(ix = 0, jx = 0; fmt[ix] != 0 && jx < sizeof(hostFmt) - 1; ix++)
+    {
+        if(fmt[ix] == '%')
+        {
+            spec = !spec;
+        }
+        else if(spec && fmt[ix] == 'l')
+        {
+            continue;
+        }
+        else if(spec && strchr("0123456789.-+ #", fmt[ix]) == 0)
+        {
+            spec = false;
+        }
+        hostFmt[jx++] = fmt[ix];
+    }
+    hostFmt[jx] = 0;
+
+    return vsnprintf(buff, size, hostFmt, args);
+}
+
+static void _ConsoleMsg(const void* cmdIoParam, const char* str)
+{
+    size_t len = strlen(str);
+
+    fputs(str, stdout);
+    if(hostConsoleLen + len < sizeof(hostConsole))
+    {
+        memcpy(hostConsole + hostConsoleLen, str, len + 1);
+        hostConsoleLen += len;
+    }
+}
+
+static void _ConsolePrint(const void* cmdIoParam, const char* format, ...)
+{
+    char buff[256];
+    va_list args;
+
+    va_start(args, format);
+    _HostVsnprintf(buff, sizeof(buff), format, args);
+    va_end(args);
+    _ConsoleMsg(cmdIoParam, buff);
+}
+
+static const SYS_CMD_API hostCmdApi =
+{
+    .msg = _ConsoleMsg,
+    .print = _ConsolePrint,
+};
+
+static const SYS_CMD_DEVICE_NODE hostCmdIO =
+{
+    .pCmdApi = &hostCmdApi,
+    .cmdIoParam = 0,
+};
+
+bool SYS_CMD_ADDGRP(const SYS_CMD_DESCRIPTOR* pCmdTbl, int nCmds, const char* groupName, const char* menuStr)
+{
+    hostCmdTbl = pCmdTbl;
+    hostCmdCount = nCmds;
+    return true;
+}
+
+// the SYS_ERROR output of the stack
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void)
+{
+    return SYS_ERROR_ERROR;
+}
+
+SYS_MODULE_INDEX SYS_DEBUG_ConsoleInstanceGet(void)
+{
+    return SYS_CONSOLE_INDEX_0;
+}
+
+void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char* format, ...)
+{
+    hostErrors = true;
+}
+
+uint64_t SYS_TIME_Counter64Get(void)
+{
+    return _NsGet() / 1000;
+}
+
+uint32_t SYS_TIME_FrequencyGet(void)
+{
+    return 1000000;
+}
+
+tcpipSignalHandle _TCPIPStackSignalHandlerRegister(TCPIP_STACK_MODULE modId, tcpipModuleSignalHandler signalHandler, int16_t asyncTmoMs)
+{
+    hostHandler = signalHandler;
+    hostTaskRate = asyncTmoMs;
+    return &hostHandler;
+}
+
+void _TCPIPStackSignalHandlerDeregister(tcpipSignalHandle handle)
+{
+    hostHandler = 0;
+}
+
+TCPIP_MODULE_SIGNAL _TCPIPStackModuleSignalGet(TCPIP_STACK_MODULE modId, TCPIP_MODULE_SIGNAL clrMask)
+{
+    TCPIP_MODULE_SIGNAL sigs = hostAsync ? TCPIP_MODULE_SIGNAL_ASYNC : 0;
+
+    if((clrMask & TCPIP_MODULE_SIGNAL_ASYNC) != 0)
+    {
+        hostAsync = false;
+    }
+    return sigs;
+}
+
+bool _TCPIPStackModuleSignalRequest(TCPIP_STACK_MODULE modId, TCPIP_MODULE_SIGNAL signal, bool noMgrAlert)
+{
+    if((signal & TCPIP_MODULE_SIGNAL_ASYNC) != 0)
+    {
+        hostAsync = true;
+    }
+    return true;
+}
+
+// the only interface is the loopback
+TCPIP_NET_HANDLE TCPIP_STACK_NetDefaultGet(void)
+{
+    return hostSkt;
+}
+
+uint32_t TCPIP_STACK_NetAddress(TCPIP_NET_HANDLE netH)
+{
+    return htonl(INADDR_LOOPBACK);
+}
+
+bool TCPIP_Helper_StringToIPAddress(const char* str, IPV4_ADDR* IPAddress)
+{
+    struct in_addr addr;
+
+    if(str == 0 || inet_pton(AF_INET, str, &addr) != 1)
+    {
+        return false;
+    }
+    IPAddress->Val = addr.s_addr;
+    return true;
+}
+
+static int _SocketAlloc(HOST_SKT_TYPE type)
+{
+    int ix;
+
+    for(ix = 0; ix < HOST_SOCKETS; ix++)
+    {
+        if(hostSkt[ix].type == HOST_SKT_FREE && !hostSkt[ix].closing)
+        {
+            memset(hostSkt + ix, 0, sizeof(*hostSkt));
+            hostSkt[ix].type = type;
+            hostSkt[ix].fd = hostSkt[ix].listenFd = -1;
+            return ix;
+        }
+    }
+    return INVALID_SOCKET;
+}
+
+static HOST_SKT* _SocketGet(int16_t skt, HOST_SKT_TYPE type)
+{
+    if(skt < 0 || skt >= HOST_SOCKETS || hostSkt[skt].type != type)
+    {
+        return 0;
+    }
+    return hostSkt + skt;
+}
+
+static int _FdOpen(int sockType, uint16_t localPort)
+{
+    struct sockaddr_in local;
+    int fd = socket(AF_INET, sockType, 0);
+    int on = 1;
+
+    if(fd < 0)
+    {
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    if(localPort != 0)
+    {
+        memset(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_port = htons(localPort);
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        if(bind(fd, (struct sockaddr*)&local, sizeof(local)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+static void _FdBuffSet(int fd, int option, uint32_t size)
+{
+    int val = (int)size;
+
+    if(fd >= 0 && size != 0)
+    {
+        setsockopt(fd, SOL_SOCKET, option, &val, sizeof(val));
+    }
+}
+
+// TCP
+
+// moves the TX FIFO into the host socket
+static void _TcpDrain(HOST_SKT* pSkt)
+{
+    ssize_t nBytes;
+
+    if(pSkt->fd < 0 || !pSkt->connected || pSkt->txLen == 0)
+    {
+        return;
+    }
+
+    nBytes = send(pSkt->fd, pSkt->txBuff, pSkt->txLen, MSG_NOSIGNAL);
+    if(nBytes > 0)
+    {
+        memmove(pSkt->txBuff, pSkt->txBuff + nBytes, pSkt->txLen - nBytes);
+        pSkt->txLen -= nBytes;
+        hostTcpTx += nBytes;
+    }
+    else if(nBytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+        pSkt->connected = false;
+        pSkt->wasDisconnected = true;
+        pSkt->txLen = 0;
+    }
+}
+
+static void _TcpRelease(HOST_SKT* pSkt)
+{
+    if(pSkt->fd >= 0)
+    {
+        close(pSkt->fd);
+    }
+    if(pSkt->listenFd >= 0)
+    {
+        close(pSkt->listenFd);
+    }
+    free(pSkt->txBuff);
+    memset(pSkt, 0, sizeof(*pSkt));
+    pSkt->fd = pSkt->listenFd = -1;
+}
+
+static bool _TcpTxBuffSet(HOST_SKT* pSkt, uint32_t size)
+{
+    uint8_t* pBuff;
+
+    if(size < pSkt->txLen)
+    {
+        return false;
+    }
+    pBuff = realloc(pSkt->txBuff, size);
+    if(pBuff == 0)
+    {
+        return false;
+    }
+    pSkt->txBuff = pBuff;
+    pSkt->txSize = size;
+    return true;
+}
+
+TCP_SOCKET TCPIP_TCP_ServerOpen(IP_ADDRESS_TYPE addType, TCP_PORT localPort, IP_MULTI_ADDRESS* localAddress)
+{
+    int skt = _SocketAlloc(HOST_SKT_TCP);
+    HOST_SKT* pSkt;
+    int ix;
+
+    if(skt == INVALID_SOCKET)
+    {
+        return INVALID_SOCKET;
+    }
+    pSkt = hostSkt + skt;
+    pSkt->server = true;
+    pSkt->localPort = localPort;
+    // as in the stack, the server sockets of a port take the next connection in turn
+    for(ix = 0; ix < HOST_SOCKETS; ix++)
+    {
+        if(ix != skt && hostSkt[ix].type == HOST_SKT_TCP && hostSkt[ix].server && hostSkt[ix].localPort == localPort)
+        {
+            pSkt->listenFd = dup(hostSkt[ix].listenFd);
+            break;
+        }
+    }
+    if(ix == HOST_SOCKETS && ((pSkt->listenFd = _FdOpen(SOCK_STREAM, localPort)) < 0 || listen(pSkt->listenFd, 4) != 0))
+    {
+        _TcpRelease(pSkt);
+        return INVALID_SOCKET;
+    }
+    if(pSkt->listenFd < 0 || !_TcpTxBuffSet(pSkt, TCPIP_IPERF_TX_BUFFER_SIZE))
+    {
+        _TcpRelease(pSkt);
+        return INVALID_SOCKET;
+    }
+    return skt;
+}
+
+TCP_SOCKET TCPIP_TCP_ClientOpen(IP_ADDRESS_TYPE addType, TCP_PORT remotePort, IP_MULTI_ADDRESS* remoteAddress)
+{
+    int skt = _SocketAlloc(HOST_SKT_TCP);
+    HOST_SKT* pSkt;
+
+    if(skt == INVALID_SOCKET)
+    {
+        return INVALID_SOCKET;
+    }
+    pSkt = hostSkt + skt;
+    pSkt->remote.sin_family = AF_INET;
+    pSkt->remote.sin_port = htons(remotePort);
+    pSkt->remote.sin_addr.s_addr = remoteAddress->v4Add.Val;
+    if((pSkt->fd = _FdOpen(SOCK_STREAM, 0)) < 0 || !_TcpTxBuffSet(pSkt, TCPIP_IPERF_TX_BUFFER_SIZE))
+    {
+        _TcpRelease(pSkt);
+        return INVALID_SOCKET;
+    }
+    // the connect is issued by the stack loop, after the buffer options are set
+    return skt;
+}
+
+bool TCPIP_TCP_OptionsSet(TCP_SOCKET hTCP, TCP_SOCKET_OPTION option, void* optParam)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+    uint32_t size = (uint16_t)(uintptr_t)optParam;
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+
+    switch(option)
+    {
+        case TCP_OPTION_RX_BUFF:
+            pSkt->rxSize = size;
+            _FdBuffSet(pSkt->server ? pSkt->listenFd : pSkt->fd, SO_RCVBUF, size);
+            return true;
+
+        case TCP_OPTION_TX_BUFF:
+            _FdBuffSet(pSkt->server ? pSkt->listenFd : pSkt->fd, SO_SNDBUF, size);
+            return _TcpTxBuffSet(pSkt, size);
+
+        default:
+            return false;
+    }
+}
+
+bool TCPIP_TCP_OptionsGet(TCP_SOCKET hTCP, TCP_SOCKET_OPTION option, void* optParam)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+
+    switch(option)
+    {
+        case TCP_OPTION_RX_BUFF:
+            *(uint16_t*)optParam = (uint16_t)pSkt->rxSize;
+            return true;
+
+        case TCP_OPTION_TX_BUFF:
+            *(uint16_t*)optParam = (uint16_t)pSkt->txSize;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool TCPIP_TCP_IsConnected(TCP_SOCKET hTCP)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+    socklen_t len = sizeof(int);
+    int err = 0;
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+
+    if(pSkt->server && pSkt->fd < 0)
+    {
+        if((pSkt->fd = accept(pSkt->listenFd, 0, 0)) >= 0)
+        {
+            fcntl(pSkt->fd, F_SETFL, fcntl(pSkt->fd, F_GETFL) | O_NONBLOCK);
+            pSkt->connected = true;
+        }
+    }
+    else if(!pSkt->server && !pSkt->connecting)
+    {
+        pSkt->connecting = true;
+        if(connect(pSkt->fd, (struct sockaddr*)&pSkt->remote, sizeof(pSkt->remote)) == 0)
+        {
+            pSkt->connected = true;
+        }
+    }
+    else if(!pSkt->server && !pSkt->connected && !pSkt->wasDisconnected)
+    {
+        if(connect(pSkt->fd, (struct sockaddr*)&pSkt->remote, sizeof(pSkt->remote)) == 0 || errno == EISCONN)
+        {
+            pSkt->connected = true;
+        }
+        else if(errno != EINPROGRESS && errno != EALREADY)
+        {
+            getsockopt(pSkt->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+            pSkt->wasDisconnected = true;
+        }
+    }
+
+    return pSkt->connected;
+}
+
+bool TCPIP_TCP_WasDisconnected(TCP_SOCKET hTCP)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+    bool disconnected;
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    disconnected = pSkt->wasDisconnected;
+    pSkt->wasDisconnected = false;
+    return disconnected;
+}
+
+bool TCPIP_TCP_SocketInfoGet(TCP_SOCKET hTCP, TCP_SOCKET_INFO* pInfo)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+    struct sockaddr_in peer;
+    socklen_t len = sizeof(peer);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    memset(pInfo, 0, sizeof(*pInfo));
+    if(pSkt->fd >= 0 && getpeername(pSkt->fd, (struct sockaddr*)&peer, &len) == 0)
+    {
+        pInfo->remoteIPaddress.v4Add.Val = peer.sin_addr.s_addr;
+        pInfo->remotePort = ntohs(peer.sin_port);
+    }
+    return true;
+}
+
+uint16_t TCPIP_TCP_PutIsReady(TCP_SOCKET hTCP)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+    uint32_t avlbl;
+
+    if(pSkt == 0 || !pSkt->connected)
+    {
+        return 0;
+    }
+    _TcpDrain(pSkt);
+    avlbl = pSkt->txSize - pSkt->txLen;
+    return avlbl > 0xffff ? 0xffff : avlbl;
+}
+
+uint16_t TCPIP_TCP_ArrayPut(TCP_SOCKET hTCP, const uint8_t* Data, uint16_t Len)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+    uint32_t nBytes;
+
+    if(pSkt == 0 || !pSkt->connected)
+    {
+        return 0;
+    }
+    nBytes = pSkt->txSize - pSkt->txLen;
+    nBytes = Len < nBytes ? Len : nBytes;
+    memcpy(pSkt->txBuff + pSkt->txLen, Data, nBytes);
+    pSkt->txLen += nBytes;
+    return nBytes;
+}
+
+bool TCPIP_TCP_Flush(TCP_SOCKET hTCP)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    _TcpDrain(pSkt);
+    return true;
+}
+
+uint16_t TCPIP_TCP_Discard(TCP_SOCKET hTCP)
+{
+    static uint8_t rxScratch[0xffff];
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+    ssize_t nBytes;
+
+    if(pSkt == 0 || pSkt->fd < 0 || !pSkt->connected)
+    {
+        return 0;
+    }
+
+    nBytes = recv(pSkt->fd, rxScratch, sizeof(rxScratch), 0);
+    if(nBytes > 0)
+    {
+        hostTcpRx += nBytes;
+        return (uint16_t)nBytes;
+    }
+    if(nBytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+    {   // remote closed
+        pSkt->connected = false;
+        pSkt->wasDisconnected = true;
+    }
+    return 0;
+}
+
+bool TCPIP_TCP_Disconnect(TCP_SOCKET hTCP)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    if(pSkt->fd >= 0)
+    {
+        close(pSkt->fd);
+        pSkt->fd = -1;
+    }
+    // a server socket goes back to listening
+    pSkt->connected = pSkt->wasDisconnected = false;
+    pSkt->txLen = 0;
+    return true;
+}
+
+bool TCPIP_TCP_Close(TCP_SOCKET hTCP)
+{
+    HOST_SKT* pSkt = _SocketGet(hTCP, HOST_SKT_TCP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    if(pSkt->connected && pSkt->txLen != 0)
+    {   // graceful close: the stack loop sends the rest, then releases it
+        pSkt->type = HOST_SKT_FREE;
+        pSkt->closing = true;
+        return true;
+    }
+    _TcpRelease(pSkt);
+    return true;
+}
+
+// UDP
+
+static bool _UdpOpen(int skt, uint16_t localPort)
+{
+    HOST_SKT* pSkt = hostSkt + skt;
+
+    pSkt->txSize = HOST_UDP_TX_SIZE;
+    pSkt->txBuff = malloc(0x10000);
+    pSkt->fd = _FdOpen(SOCK_DGRAM, localPort);
+    if(pSkt->txBuff == 0 || pSkt->fd < 0)
+    {
+        TCPIP_UDP_Close(skt);
+        return false;
+    }
+    return true;
+}
+
+UDP_SOCKET TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE addType, UDP_PORT localPort, IP_MULTI_ADDRESS* localAddress)
+{
+    int skt = _SocketAlloc(HOST_SKT_UDP);
+
+    if(skt == INVALID_SOCKET || !_UdpOpen(skt, localPort))
+    {
+        return INVALID_SOCKET;
+    }
+    hostSkt[skt].server = true;
+    return skt;
+}
+
+UDP_SOCKET TCPIP_UDP_ClientOpen(IP_ADDRESS_TYPE addType, UDP_PORT remotePort, IP_MULTI_ADDRESS* remoteAddress)
+{
+    int skt = _SocketAlloc(HOST_SKT_UDP);
+
+    if(skt == INVALID_SOCKET || !_UdpOpen(skt, 0))
+    {
+        return INVALID_SOCKET;
+    }
+    hostSkt[skt].remote.sin_family = AF_INET;
+    hostSkt[skt].remote.sin_port = htons(remotePort);
+    hostSkt[skt].remote.sin_addr.s_addr = remoteAddress->v4Add.Val;
+    return skt;
+}
+
+bool TCPIP_UDP_Close(UDP_SOCKET hUDP)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    if(pSkt->fd >= 0)
+    {
+        close(pSkt->fd);
+    }
+    free(pSkt->txBuff);
+    memset(pSkt, 0, sizeof(*pSkt));
+    pSkt->fd = pSkt->listenFd = -1;
+    return true;
+}
+
+bool TCPIP_UDP_OptionsSet(UDP_SOCKET hUDP, UDP_SOCKET_OPTION option, void* optParam)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    if(option == UDP_OPTION_TX_BUFF)
+    {
+        pSkt->txSize = (uint16_t)(uintptr_t)optParam;
+    }
+    // the RX/TX queue limits are the host socket buffers
+    return true;
+}
+
+bool TCPIP_UDP_DestinationIPAddressSet(UDP_SOCKET hUDP, IP_ADDRESS_TYPE addType, IP_MULTI_ADDRESS* remoteAddress)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    pSkt->remote.sin_family = AF_INET;
+    pSkt->remote.sin_addr.s_addr = remoteAddress->v4Add.Val;
+    return true;
+}
+
+bool TCPIP_UDP_DestinationPortSet(UDP_SOCKET s, UDP_PORT remotePort)
+{
+    HOST_SKT* pSkt = _SocketGet(s, HOST_SKT_UDP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    pSkt->remote.sin_port = htons(remotePort);
+    return true;
+}
+
+uint16_t TCPIP_UDP_GetIsReady(UDP_SOCKET hUDP)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+    socklen_t len = sizeof(pSkt->source);
+    ssize_t nBytes;
+
+    if(pSkt == 0)
+    {
+        return 0;
+    }
+    if(pSkt->rxOffset == pSkt->rxLen)
+    {
+        nBytes = recvfrom(pSkt->fd, pSkt->rxBuff, sizeof(pSkt->rxBuff), 0, (struct sockaddr*)&pSkt->source, &len);
+        pSkt->rxLen = nBytes > 0 ? nBytes : 0;
+        pSkt->rxOffset = 0;
+    }
+    return pSkt->rxLen - pSkt->rxOffset;
+}
+
+uint16_t TCPIP_UDP_ArrayGet(UDP_SOCKET hUDP, uint8_t* cData, uint16_t wDataLen)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+    uint32_t nBytes;
+
+    if(pSkt == 0)
+    {
+        return 0;
+    }
+    nBytes = pSkt->rxLen - pSkt->rxOffset;
+    nBytes = wDataLen < nBytes ? wDataLen : nBytes;
+    if(cData != 0)
+    {
+        memcpy(cData, pSkt->rxBuff + pSkt->rxOffset, nBytes);
+    }
+    pSkt->rxOffset += nBytes;
+    return nBytes;
+}
+
+uint16_t TCPIP_UDP_Discard(UDP_SOCKET hUDP)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+    uint16_t nBytes;
+
+    if(pSkt == 0)
+    {
+        return 0;
+    }
+    nBytes = pSkt->rxLen - pSkt->rxOffset;
+    pSkt->rxLen = pSkt->rxOffset = 0;
+    return nBytes;
+}
+
+bool TCPIP_UDP_SocketInfoGet(UDP_SOCKET hUDP, UDP_SOCKET_INFO* pInfo)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+
+    if(pSkt == 0)
+    {
+        return false;
+    }
+    memset(pInfo, 0, sizeof(*pInfo));
+    pInfo->sourceIPaddress.v4Add.Val = pSkt->source.sin_addr.s_addr;
+    pInfo->remotePort = ntohs(pSkt->source.sin_port);
+    pInfo->remoteIPaddress.v4Add.Val = pSkt->remote.sin_addr.s_addr;
+    return true;
+}
+
+uint16_t TCPIP_UDP_TxPutIsReady(UDP_SOCKET hUDP, unsigned short count)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+
+    if(pSkt == 0)
+    {
+        return 0;
+    }
+    if(pSkt->txSize < count)
+    {   // the stack allocates a larger buffer
+        pSkt->txSize = count;
+    }
+    return pSkt->txSize - pSkt->txLen;
+}
+
+uint16_t TCPIP_UDP_PutIsReady(UDP_SOCKET hUDP)
+{
+    return TCPIP_UDP_TxPutIsReady(hUDP, 0);
+}
+
+uint16_t TCPIP_UDP_ArrayPut(UDP_SOCKET hUDP, const uint8_t* cData, uint16_t wDataLen)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+    uint32_t nBytes;
+
+    if(pSkt == 0)
+    {
+        return 0;
+    }
+    nBytes = pSkt->txSize - pSkt->txLen;
+    nBytes = wDataLen < nBytes ? wDataLen : nBytes;
+    memcpy(pSkt->txBuff + pSkt->txLen, cData, nBytes);
+    pSkt->txLen += nBytes;
+    return nBytes;
+}
+
+uint16_t TCPIP_UDP_Flush(UDP_SOCKET hUDP)
+{
+    HOST_SKT* pSkt = _SocketGet(hUDP, HOST_SKT_UDP);
+    ssize_t nBytes;
+
+    if(pSkt == 0 || pSkt->txLen == 0)
+    {
+        return 0;
+    }
+    nBytes = sendto(pSkt->fd, pSkt->txBuff, pSkt->txLen, 0, (struct sockaddr*)&pSkt->remote, sizeof(pSkt->remote));
+    pSkt->txLen = 0;
+    return nBytes > 0 ? nBytes : 0;
+}
+
+// stack loop
+
+static void _StackRun(uint64_t ms)
+{
+    uint64_t end = _NsGet() + ms * 1000000;
+    uint64_t nextTmo = 0;
+    uint64_t now;
+    int ix;
+
+    while((now = _NsGet()) < end && !hostStop)
+    {
+        for(ix = 0; ix < HOST_SOCKETS; ix++)
+        {
+            if(hostSkt[ix].type == HOST_SKT_TCP)
+            {
+                _TcpDrain(hostSkt + ix);
+            }
+            else if(hostSkt[ix].closing)
+            {
+                _TcpDrain(hostSkt + ix);
+                if(hostSkt[ix].txLen == 0 || !hostSkt[ix].connected)
+                {
+                    _TcpRelease(hostSkt + ix);
+                }
+            }
+        }
+
+        if(hostHandler != 0 && (hostAsync || now >= nextTmo))
+        {
+            (*hostHandler)();
+            nextTmo = now + (uint64_t)hostTaskRate * 1000000;
+        }
+        else if(!hostAsync)
+        {
+            usleep(1000);
+        }
+    }
+}
+
+// runs the stack until no session transfers data
+static bool _StackIdleWait(void)
+{
+    uint64_t end = _NsGet() + (uint64_t)HOST_IDLE_TMO * 1000000000;
+    int ix;
+    bool closing;
+
+    do
+    {
+        _StackRun(50);
+        for(ix = 0, closing = false; ix < HOST_SOCKETS; ix++)
+        {
+            closing |= hostSkt[ix].closing;
+        }
+    } while((hostAsync || closing) && _NsGet() < end && !hostStop);
+
+    // let the servers see the close
+    _StackRun(100);
+    return !hostAsync;
+}
+
+static void _CommandRun(const char* cmdLine)
+{
+    char line[128];
+    char* argv[16];
+    int argc = 0, ix;
+    char* tok;
+
+    printf("> %s\n", cmdLine);
+    strncpy(line, cmdLine, sizeof(line) - 1);
+    line[sizeof(line) - 1] = 0;
+    for(tok = strtok(line, " "); tok != 0 && argc < 16; tok = strtok(0, " "))
+    {
+        argv[argc++] = tok;
+    }
+
+    for(ix = 0; ix < hostCmdCount; ix++)
+    {
+        if(argc != 0 && strcmp(argv[0], hostCmdTbl[ix].cmdStr) == 0)
+        {
+            (*hostCmdTbl[ix].cmdFnc)((SYS_CMD_DEVICE_NODE*)&hostCmdIO, argc, argv);
+            return;
+        }
+    }
+    printf("unknown command: %s\n", cmdLine);
+    hostErrors = true;
+}
+
+// runs the console commands, then waits for the sessions to end
+// expect lists the console lines that must be printed, 0 terminated;
+// a line starting with '!' must not be printed
+static bool _Scenario(const char* name, const char* const* cmds, const char* const* expect)
+{
+    uint64_t tcpTx = hostTcpTx, tcpRx = hostTcpRx;
+    uint32_t missing = 0;
+    bool idle;
+
+    printf("--- %s\n", name);
+    hostConsoleLen = 0;
+    hostConsole[0] = 0;
+    for(; *cmds != 0; cmds++)
+    {
+        _CommandRun(*cmds);
+        _StackRun(100);
+    }
+    idle = _StackIdleWait();
+
+    for(; *expect != 0; expect++)
+    {
+        if(**expect == '!' && strstr(hostConsole, *expect + 1) != 0)
+        {
+            printf("unexpected: \"%s\"\n", *expect + 1);
+            missing++;
+        }
+        else if(**expect != '!' && strstr(hostConsole, *expect) == 0)
+        {
+            printf("missing: \"%s\"\n", *expect);
+            missing++;
+        }
+    }
+
+    tcpTx = hostTcpTx - tcpTx;
+    tcpRx = hostTcpRx - tcpRx;
+    printf("%-28s %s: TCP %llu bytes sent, %llu received, %u console mismatches%s\n", name,
+            (idle && missing == 0 && tcpTx == tcpRx) ? "PASS" : "FAIL", (unsigned long long)tcpTx,
+            (unsigned long long)tcpRx, missing, idle ? "" : ", not idle");
+    return idle && missing == 0 && tcpTx == tcpRx;
+}
+
+static void _StopHandler(int sig)
+{
+    hostStop = 1;
+}
+
+int main(int argc, char** argv)
+{
+    static const char* const srvCmds[] = {"iperf -s -P 2 -i 1", "iperf -s -u -i 1", 0};
+    static const char* const srvExpect[] = {"TCP server listening on port 5001", "UDP server listening on port 5001", 0};
+
+    static const char* const tcpCmds[] = {"iperf -c 127.0.0.1 -t 3 -i 1", 0};
+    static const char* const tcpExpect[] = {"connected with 127.0.0.1 port 5001", "local port 5001 connected with 127.0.0.1",
+                                            "  2.0-  3.0 sec", "  0.0-  3.0 sec", 0};
+
+    static const char* const parCmds[] = {"iperf -c 127.0.0.1 -t 2 -P 2", 0};
+    static const char* const parExpect[] = {"[SUM]   0.0-", "![SUM]   0.0-  0.0 sec", 0};
+
+    static const char* const winCmds[] = {"iperf -c 127.0.0.1 -t 2 -w 64K", 0};
+    static const char* const winExpect[] = {"iperf: window size 65536 too large, using 65535 bytes",
+                                            "client connecting to port 5001, window size: 65535 bytes", "  0.0-  2.0 sec", 0};
+
+    static const char* const lenCmds[] = {"iperf -c 127.0.0.1 -t 2 -l 64K", 0};
+    static const char* const lenExpect[] = {"iperf: buffer length 65536 too large, using 65535 bytes", "  0.0-  2.0 sec", 0};
+
+    static const char* const udpCmds[] = {"iperf -c 127.0.0.1 -u -b 100M -t 3 -i 1", 0};
+    static const char* const udpExpect[] = {"UDP client sending to port 5001, 1470 byte datagrams", "Server Report:", "lost ", 0};
+
+    static const char* const udpLenCmds[] = {"iperf -c 127.0.0.1 -u -b 10M -t 1 -l 64K", 0};
+    static const char* const udpLenExpect[] = {"iperf: buffer length 65536 too large, using 1472 bytes",
+                                               "UDP client sending to port 5001, 1472 byte datagrams", "Server Report:", 0};
+
+    static const char* const stopCmds[] = {"iperfk", 0};
+    static const char* const stopExpect[] = {"iperf: 3 session(s) stopped", 0};
+
+    TCPIP_STACK_MODULE_CTRL stackCtrl = {.stackAction = TCPIP_STACK_ACTION_INIT};
+    bool pass = true;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    signal(SIGINT, _StopHandler);
+    signal(SIGTERM, _StopHandler);
+
+    if(!TCPIP_IPERF_Initialize(&stackCtrl, 0) || hostCmdTbl == 0)
+    {
+        printf("FAILED: iperf initialization\n");
+        return 1;
+    }
+
+    pass &= _Scenario("servers", srvCmds, srvExpect);
+    if((argc > 1) && (strcmp(argv[1], "serve") == 0))
+    {   // for a host iperf peer
+        while(!hostStop)
+        {
+            _StackRun(1000);
+        }
+    }
+    else
+    {
+        pass &= _Scenario("TCP loopback", tcpCmds, tcpExpect);
+        pass &= _Scenario("TCP 2 streams", parCmds, parExpect);
+        pass &= _Scenario("TCP -w 64K", winCmds, winExpect);
+        pass &= _Scenario("TCP -l 64K", lenCmds, lenExpect);
+        pass &= _Scenario("UDP loopback 100 Mbit/s", udpCmds, udpExpect);
+        pass &= _Scenario("UDP -l 64K", udpLenCmds, udpLenExpect);
+    }
+    pass &= _Scenario("stop", stopCmds, stopExpect);
+
+    stackCtrl.stackAction = TCPIP_STACK_ACTION_DEINIT;
+    TCPIP_IPERF_Deinitialize(&stackCtrl);
+    pass &= !hostErrors && hostHandler == 0;
+
+    printf("%s\n", pass ? "ALL PASS" : "FAILED");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+  SYS_RING host stress test
+
+  Summary:
+    Threaded producer/consumer test of system/ring/sys_ring.h.
+
+  Description:
+    A producer thread stands for the interrupt handler and a consumer thread
+    for the task. On a multi-core host both run in parallel, which is a harder
+    test of the index publication than the single core PIC32MZ; on a single
+    core host they interleave through preemption at arbitrary points.
+    Checked for each run:
+    - every element is received exactly once and in order,
+    - multi-word elements are never seen half written,
+    - the ring dropCount equals the puts the producer saw rejected,
+    - the semaphore wake up path loses no element.
+
+    Build and run: make -C firmware/test/host ring
+*******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system/ring/sys_ring.h"
+
+typedef struct
+{
+    uint32_t seq;
+    uint32_t inv;       // ~seq
+    uint32_t pad[2];    // seq again, checks the whole copy
+} RING_ELEM;
+
+typedef struct
+{
+    SYS_RING    ring;
+    uint32_t    nElems;         // elements to transfer
+    bool        useSem;         // consumer sleeps on the ring semaphore
+    bool        byteElems;      // 1 byte elements, as the BLE UART ring
+    uint32_t    rejected;       // puts rejected, seen by the producer
+    uint32_t    errors;
+    sem_t       wakeSem;
+    volatile bool producerDone;
+} RING_TEST;
+
+static void* _Producer(void* arg)
+{
+    RING_TEST* pTest = (RING_TEST*)arg;
+    RING_ELEM elem;
+    uint8_t byte;
+    uint32_t seq;
+
+    for (seq = 0; seq < pTest->nElems; )
+    {
+        bool ok;
+
+        if (pTest->byteElems)
+        {
+            byte = (uint8_t)seq;
+            ok = SYS_RING_PutISR(&pTest->ring, &byte);
+        }
+        else
+        {
+            elem.seq = seq;
+            elem.inv = ~seq;
+            elem.pad[0] = elem.pad[1] = seq;
+            ok = SYS_RING_PutISR(&pTest->ring, &elem);
+        }
+
+        if (ok)
+        {
+            seq++;
+        }
+        else
+        {   // ring full: the ISR would drop the element, retry to keep the sequence
+            pTest->rejected++;
+            sched_yield();
+        }
+    }
+
+    pTest->producerDone = true;
+    if (pTest->useSem)
+    {
+        sem_post(&pTest->wakeSem);
+    }
+    return NULL;
+}
+
+static void* _Consumer(void* arg)
+{
+    RING_TEST* pTest = (RING_TEST*)arg;
+    RING_ELEM elem;
+    uint8_t byte;
+    uint32_t expected = 0;
+
+    while (expected < pTest->nElems)
+    {
+        bool got;
+
+        if (pTest->byteElems)
+        {
+            got = SYS_RING_Get(&pTest->ring, &byte);
+            if (got && byte != (uint8_t)expected)
+            {
+                pTest->errors++;
+            }
+        }
+        else
+        {
+            got = SYS_RING_Get(&pTest->ring, &elem);
+            if (got && (elem.seq != expected || elem.inv != ~expected || elem.pad[0] != expected || elem.pad[1] != expected))
+            {
+                pTest->errors++;
+            }
+        }
+
+        if (got)
+        {
+            expected++;
+        }
+        else if (pTest->useSem)
+        {   // the producer posts after every put, so the wait cannot miss one
+            sem_wait(&pTest->wakeSem);
+        }
+        else
+        {   // lets the producer run on a single core host
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static bool _RunTest(const char* name, uint32_t nElems, uint16_t ringSize, bool byteElems, bool useSem)
+{
+    static RING_TEST test;
+    static uint8_t storage[1024 * sizeof(RING_ELEM)];
+    pthread_t prodThread, consThread;
+    bool pass;
+
+    test = (RING_TEST){0};
+    test.nElems = nElems;
+    test.useSem = useSem;
+    test.byteElems = byteElems;
+    sem_init(&test.wakeSem, 0, 0);
+
+    if (!SYS_RING_Initialize(&test.ring, storage, byteElems ? 1 : sizeof(RING_ELEM), ringSize, useSem ? &test.wakeSem : NULL))
+    {
+        printf("%-28s FAIL: init\n", name);
+        return false;
+    }
+
+    pthread_create(&consThread, NULL, _Consumer, &test);
+    pthread_create(&prodThread, NULL, _Producer, &test);
+    pthread_join(prodThread, NULL);
+    pthread_join(consThread, NULL);
+
+    pass = test.errors == 0 && test.ring.dropCount == test.rejected && SYS_RING_Count(&test.ring) == 0;
+    printf("%-28s %s: %u elements, ring %u, %u full rejects, dropCount %u, %u errors\n", name, pass ? "PASS" : "FAIL",
+            nElems, ringSize, test.rejected, test.ring.dropCount, test.errors);
+    sem_destroy(&test.wakeSem);
+    return pass;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t nElems = argc > 1 ? strtoul(argv[1], NULL, 0) : 20000000;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    bool pass = true;
+    SYS_RING ring;
+    uint8_t buff[8];
+
+    // parameter checks
+    pass &= !SYS_RING_Initialize(&ring, buff, 1, 6, NULL);
+    pass &= !SYS_RING_Initialize(&ring, buff, 0, 8, NULL);
+    pass &= SYS_RING_Initialize(&ring, buff, 1, 8, NULL);
+    printf("%-28s %s\n", "initialize checks", pass ? "PASS" : "FAIL");
+
+    pass &= _RunTest("16 byte elems, ring 16", nElems, 16, false, false);
+    pass &= _RunTest("16 byte elems, ring 1024", nElems, 1024, false, false);
+    pass &= _RunTest("1 byte elems, ring 256", nElems, 256, true, false);
+    pass &= _RunTest("16 byte elems, ring 2", nElems / 4, 2, false, false);
+    pass &= _RunTest("semaphore wake up, ring 16", nElems / 4, 16, false, true);
+
+    printf("%s\n", pass ? "ALL PASS" : "FAILED");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+  Host configuration stub
+
+  Summary:
+    Configuration options for the sources compiled by the host tests.
+
+  Description:
+    Stands in for config/default/configuration.h, which pulls in the device
+    headers. The values match the firmware configuration unless noted; the
+    tests may override them on the command line.
+*******************************************************************************/
+
+#ifndef CONFIGURATION_HOST_STUB_H
+#define CONFIGURATION_HOST_STUB_H
+
+/* TIME System Service Configuration Options */
+#define SYS_TIME_INDEX_0                            (0)
+#ifndef SYS_TIME_MAX_TIMERS
+#define SYS_TIME_MAX_TIMERS                         (32)
+#endif
+#ifndef SYS_TIME_WHEEL_TICK_SHIFT
+#define SYS_TIME_WHEEL_TICK_SHIFT                   (14)
+#endif
+#define SYS_TIME_HW_COUNTER_WIDTH                   (32)
+#define SYS_TIME_HW_COUNTER_PERIOD                  (4294967295U)
+#define SYS_TIME_HW_COUNTER_HALF_PERIOD             (SYS_TIME_HW_COUNTER_PERIOD>>1)
+#define SYS_TIME_CPU_CLOCK_FREQUENCY                (200000000)
+#define SYS_TIME_COMPARE_UPDATE_EXECUTION_CYCLES    (620)
+
+/* Debug System Service Configuration Options */
+#define SYS_DEBUG_ENABLE
+#define SYS_DEBUG_GLOBAL_ERROR_LEVEL       SYS_ERROR_DEBUG
+#define SYS_DEBUG_USE_CONSOLE
+#define SYS_CONSOLE_INDEX_0                       0
+#define SYS_CONSOLE_DEVICE_MAX_INSTANCES   			1
+#define SYS_CONSOLE_PRINT_BUFFER_SIZE        		256
+#define SYS_CMD_DEVICE_MAX_INSTANCES       SYS_CONSOLE_DEVICE_MAX_INSTANCES
+
+/*** TCP Configuration ***/
+#define TCPIP_TCP_MAX_SEG_SIZE_TX		        	1460
+#ifndef TCPIP_TCP_SOCKET_DEFAULT_TX_SIZE
+#define TCPIP_TCP_SOCKET_DEFAULT_TX_SIZE			2048
+#endif
+#ifndef TCPIP_TCP_SOCKET_DEFAULT_RX_SIZE
+#define TCPIP_TCP_SOCKET_DEFAULT_RX_SIZE			2920
+#endif
+#define TCPIP_TCP_DYNAMIC_OPTIONS             			true
+#define TCPIP_TCP_AUTOTUNE_MAX_RX_SIZE			8760
+#define TCPIP_TCP_AUTOTUNE_MEM_BUDGET			16384
+#define TCPIP_TCP_START_TIMEOUT_VAL		        	1000
+#define TCPIP_TCP_MIN_RTO					250
+#ifndef TCPIP_TCP_SACK_SUPPORT
+#define TCPIP_TCP_SACK_SUPPORT				true
+#endif
+#define TCPIP_TCP_DELAYED_ACK_TIMEOUT		    		100
+#define TCPIP_TCP_FIN_WAIT_2_TIMEOUT		    		5000
+#define TCPIP_TCP_KEEP_ALIVE_TIMEOUT		    		10000
+#define TCPIP_TCP_CLOSE_WAIT_TIMEOUT		    		0
+#define TCPIP_TCP_MAX_RETRIES		            		5
+#define TCPIP_TCP_MAX_UNACKED_KEEP_ALIVES			6
+#define TCPIP_TCP_MAX_SYN_RETRIES		        	3
+#define TCPIP_TCP_AUTO_TRANSMIT_TIMEOUT_VAL			40
+#define TCPIP_TCP_WINDOW_UPDATE_TIMEOUT_VAL			200
+#define TCPIP_TCP_MAX_SOCKETS		                10
+#define TCPIP_TCP_TASK_TICK_RATE		        	5
+#define TCPIP_TCP_MSL_TIMEOUT		        	    0
+#define TCPIP_TCP_QUIET_TIME		        	    0
+#define TCPIP_TCP_COMMANDS   false
+#define TCPIP_TCP_EXTERN_PACKET_PROCESS   false
+#define TCPIP_TCP_DISABLE_CRYPTO_USAGE		        	    false
+
+/*** IPv4 Configuration ***/
+#define TCPIP_IPV4_EXTERN_PACKET_PROCESS   false
+#define TCPIP_IPV4_COMMANDS false
+#define TCPIP_IPV4_FORWARDING_ENABLE    false
+
+/*** ICMPv4 Client Configuration ***/
+#define TCPIP_STACK_USE_ICMP_CLIENT
+#define TCPIP_ICMP_CLIENT_USER_NOTIFICATION   true
+#define TCPIP_ICMP_ECHO_REQUEST_TIMEOUT        500
+#define TCPIP_ICMP_TASK_TICK_RATE              33
+#define TCPIP_ICMP_COMMAND_ENABLE              false
+
+/*** DHCP Server Configuration ***/
+#define TCPIP_STACK_USE_DHCP_SERVER
+#define TCPIP_DHCP_SERVER_LISTEN_PORT               67
+#define TCPIP_DHCPS_TASK_PROCESS_RATE                     	200
+#define TCPIP_DHCPS_MAX_NUMBER_INSTANCES					1
+#define TCPIP_DHCPS_LEASE_ENTRIES_DEFAULT                   15
+#define TCPIP_DHCPS_LEASE_SOLVED_ENTRY_TMO                  1200
+#define TCPIP_DHCPS_LEASE_REMOVED_BEFORE_ACK                5
+#define TCPIP_DHCP_SERVER_DELETE_OLD_ENTRIES              	true
+#define TCPIP_DHCPS_LEASE_DURATION	TCPIP_DHCPS_LEASE_SOLVED_ENTRY_TMO
+#define TCPIP_DHCPS_LEASE_PERSIST_ENTRIES                   TCPIP_DHCPS_LEASE_ENTRIES_DEFAULT
+#define TCPIP_DHCPS_LEASE_PERSIST_DELAY                     1000
+
+/*** UDP Configuration ***/
+#define TCPIP_UDP_MAX_SOCKETS		                	10
+#define TCPIP_UDP_SOCKET_DEFAULT_TX_SIZE		    	512
+#define TCPIP_UDP_SOCKET_DEFAULT_TX_QUEUE_LIMIT    	 	3
+#define TCPIP_UDP_SOCKET_DEFAULT_RX_QUEUE_LIMIT			3
+#define TCPIP_UDP_USE_POOL_BUFFERS   false
+#define TCPIP_UDP_USE_TX_CHECKSUM             			true
+#define TCPIP_UDP_USE_RX_CHECKSUM             			true
+#define TCPIP_UDP_COMMANDS   false
+#define TCPIP_UDP_EXTERN_PACKET_PROCESS   false
+
+/*** iPerf Configuration ***/
+#define TCPIP_STACK_USE_IPERF
+#define TCPIP_IPERF_MAX_INSTANCES               6       // 4 on the target; room for the loopback servers
+#define TCPIP_IPERF_TASK_RATE                   20
+#define TCPIP_IPERF_TX_BUFFER_SIZE              4096
+#define TCPIP_IPERF_RX_BUFFER_SIZE              4096
+#define TCPIP_IPERF_UDP_RX_QUEUE_LIMIT          8
+#define TCPIP_IPERF_UDP_TX_QUEUE_LIMIT          4
+#define TCPIP_IPERF_CONNECT_TMO                 5000
+#define TCPIP_IPERF_IDLE_TMO                    10000
+
+/*** TCPIP Heap Configuration ***/
+#define TCPIP_STACK_USE_EXTERNAL_HEAP
+#define TCPIP_STACK_MALLOC_FUNC                     malloc
+#define TCPIP_STACK_CALLOC_FUNC                     calloc
+#define TCPIP_STACK_FREE_FUNC                       free
+#define TCPIP_STACK_HEAP_USE_FLAGS                   TCPIP_STACK_HEAP_FLAG_NONE
+#define TCPIP_STACK_HEAP_USAGE_CONFIG                TCPIP_STACK_HEAP_USE_DEFAULT
+#define TCPIP_STACK_SUPPORTED_HEAPS                  1
+
+/* TCPIP Stack Configuration; the modules the host tests compile */
+#define TCPIP_STACK_USE_IPV4
+#define TCPIP_STACK_USE_TCP
+#define TCPIP_STACK_USE_UDP
+#define TCPIP_STACK_TICK_RATE		        		5
+#define TCPIP_STACK_ALIAS_INTERFACE_SUPPORT   false
+#define TCPIP_PACKET_LOG_ENABLE     0
+#define TCPIP_STACK_DOWN_OPERATION   true
+#define TCPIP_STACK_IF_UP_DOWN_OPERATION   true
+#define TCPIP_STACK_MAC_DOWN_OPERATION  true
+#define TCPIP_STACK_INTERFACE_CHANGE_SIGNALING   false
+#define TCPIP_STACK_EXTERN_PACKET_PROCESS   false
+
+#endif // CONFIGURATION_HOST_STUB_H
@@ -0,0 +1,96 @@
+/*******************************************************************************
+  Host OSAL stub
+
+  Summary:
+    Minimal POSIX mapping of the OSAL calls used by the host tests.
+
+  Description:
+    Only the semaphore, mutex and critical section calls used by the
+    modules under test are provided; the sources under test are compiled
+    unchanged. The critical sections are empty: the tests that run the
+    TCP/IP stack call it from a single thread.
+*******************************************************************************/
+
+#ifndef OSAL_HOST_STUB_H
+#define OSAL_HOST_STUB_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+typedef enum
+{
+    OSAL_RESULT_NOT_IMPLEMENTED = -1,
+    OSAL_RESULT_FALSE = 0,
+    OSAL_RESULT_TRUE = 1
+} OSAL_RESULT;
+
+#define OSAL_WAIT_FOREVER       (uint16_t)0xFFFF
+
+typedef enum
+{
+    OSAL_SEM_TYPE_BINARY,
+    OSAL_SEM_TYPE_COUNTING
+} OSAL_SEM_TYPE;
+
+typedef enum
+{
+    OSAL_CRIT_TYPE_LOW,
+    OSAL_CRIT_TYPE_HIGH
+} OSAL_CRIT_TYPE;
+
+typedef uint32_t OSAL_CRITSECT_DATA_TYPE;
+
+typedef sem_t OSAL_SEM_HANDLE_TYPE;
+typedef pthread_mutex_t OSAL_MUTEX_HANDLE_TYPE;
+
+#define OSAL_MUTEX_DECLARE(mutexID)     OSAL_MUTEX_HANDLE_TYPE mutexID
+
+#define OSAL_SEM_Post(sem)      sem_post(sem)
+#define OSAL_SEM_PostISR(sem)   sem_post(sem)
+
+static inline OSAL_RESULT OSAL_SEM_Create(OSAL_SEM_HANDLE_TYPE* semID, OSAL_SEM_TYPE type, uint8_t maxCount, uint8_t initialCount)
+{
+    return sem_init(semID, 0, initialCount) == 0 ? OSAL_RESULT_TRUE : OSAL_RESULT_FALSE;
+}
+
+static inline OSAL_RESULT OSAL_SEM_Delete(OSAL_SEM_HANDLE_TYPE* semID)
+{
+    return sem_destroy(semID) == 0 ? OSAL_RESULT_TRUE : OSAL_RESULT_FALSE;
+}
+
+static inline OSAL_RESULT OSAL_SEM_Pend(OSAL_SEM_HANDLE_TYPE* semID, uint16_t waitMS)
+{
+    return sem_wait(semID) == 0 ? OSAL_RESULT_TRUE : OSAL_RESULT_FALSE;
+}
+
+static inline OSAL_CRITSECT_DATA_TYPE OSAL_CRIT_Enter(OSAL_CRIT_TYPE severity)
+{
+    return 0;
+}
+
+static inline void OSAL_CRIT_Leave(OSAL_CRIT_TYPE severity, OSAL_CRITSECT_DATA_TYPE status)
+{
+}
+
+static inline OSAL_RESULT OSAL_MUTEX_Create(OSAL_MUTEX_HANDLE_TYPE* mutexID)
+{
+    return pthread_mutex_init(mutexID, NULL) == 0 ? OSAL_RESULT_TRUE : OSAL_RESULT_FALSE;
+}
+
+static inline OSAL_RESULT OSAL_MUTEX_Delete(OSAL_MUTEX_HANDLE_TYPE* mutexID)
+{
+    return pthread_mutex_destroy(mutexID) == 0 ? OSAL_RESULT_TRUE : OSAL_RESULT_FALSE;
+}
+
+static inline OSAL_RESULT OSAL_MUTEX_Lock(OSAL_MUTEX_HANDLE_TYPE* mutexID, uint16_t waitMS)
+{
+    return pthread_mutex_lock(mutexID) == 0 ? OSAL_RESULT_TRUE : OSAL_RESULT_FALSE;
+}
+
+static inline OSAL_RESULT OSAL_MUTEX_Unlock(OSAL_MUTEX_HANDLE_TYPE* mutexID)
+{
+    return pthread_mutex_unlock(mutexID) == 0 ? OSAL_RESULT_TRUE : OSAL_RESULT_FALSE;
+}
+
+#endif // OSAL_HOST_STUB_H
@@ -0,0 +1,36 @@
+/*******************************************************************************
+  Host interrupt system service stub
+
+  Summary:
+    Interrupt control calls for the host tests.
+
+  Description:
+    The host tests run the interrupt handlers synchronously from the test
+    thread, so there is nothing to mask.
+*******************************************************************************/
+
+#ifndef SYS_INT_HOST_STUB_H
+#define SYS_INT_HOST_STUB_H
+
+#include <stdbool.h>
+
+typedef int INT_SOURCE;
+
+static inline bool SYS_INT_Disable(void)
+{
+    return true;
+}
+
+static inline void SYS_INT_Restore(bool state)
+{
+}
+
+static inline void SYS_INT_SourceDisable(INT_SOURCE source)
+{
+}
+
+static inline void SYS_INT_SourceEnable(INT_SOURCE source)
+{
+}
+
+#endif // SYS_INT_HOST_STUB_H
@@ -0,0 +1,67 @@
+/*******************************************************************************
+  TCP/IP stack private header stub
+
+  Summary:
+    Stands in for library/tcpip/src/tcpip_private.h for the modules the host
+    tests compile unchanged.
+
+  Description:
+    Includes the real stack headers, in the order of tcpip_private.h, less
+    the device and system headers the host cannot build: the configuration
+    is the host stub and only the managers of the modules under test are
+    included. The stack manager, packet and system calls those modules make
+    are implemented by the test.
+*******************************************************************************/
+
+#ifndef _TCPIP_PRIVATE_HOST_STUB_H_
+#define _TCPIP_PRIVATE_HOST_STUB_H_
+
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+#include "toolchain_specifics.h"
+#include "configuration.h"
+#include "system/debug/sys_debug.h"
+#include "system/sys_random_h2_adapter.h"
+#include "system/sys_time_h2_adapter.h"
+#include "system/command/sys_command.h"
+
+#include "osal/osal.h"
+
+#include "tcpip/src/common/helpers.h"
+
+#define _TCPIP_STACK_INTERFACE_CHANGE_SIGNALING     0
+#define _TCPIP_STACK_ALIAS_INTERFACE_SUPPORT        0
+
+#include "tcpip/tcpip.h"
+
+#include "tcpip/src/tcpip_types.h"
+#include "tcpip/src/link_list.h"
+#include "tcpip/src/tcpip_heap_alloc.h"
+
+#include "tcpip/tcpip_mac_object.h"
+
+#include "tcpip/src/tcpip_manager_control.h"
+
+#include "tcpip/src/ipv4_manager.h"
+#include "tcpip/src/icmp_manager.h"
+#include "tcpip/src/dhcps_manager.h"
+#include "tcpip/src/tcp_manager.h"
+#include "tcpip/src/udp_manager.h"
+#include "tcpip/src/iperf_manager.h"
+#include "tcpip/src/tcpip_packet.h"
+#include "tcpip/src/tcpip_helpers_private.h"
+#include "tcpip/src/oahash.h"
+#include "tcpip/src/hash_fnv.h"
+#include "tcpip/src/tcpip_notify.h"
+
+// the target long is 32 bits: the console formats print uint32_t with %lu
+int                 _HostVsnprintf(char* buff, size_t size, const char* fmt, va_list args);
+#define vsnprintf   _HostVsnprintf
+
+#endif // _TCPIP_PRIVATE_HOST_STUB_H_
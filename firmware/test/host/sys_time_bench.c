@@ -0,0 +1,332 @@
+/*******************************************************************************
+  SYS_TIME host benchmark
+
+  Summary:
+    Insert, cancel and expire cost of system/time/src/sys_time.c at scale.
+
+  Description:
+    sys_time.c is compiled unchanged against a simulated 32-bit core timer.
+    The simulation raises the compare interrupt exactly when the counter
+    reaches the compare value and runs the handler synchronously, so the
+    expire cost is the time spent in the interrupt per expired timer.
+
+    For each timer count N, every round:
+    - registers N single shot callbacks of 1 ms to 10 s (insert),
+    - destroys a random half of them (cancel),
+    - runs the counter until the rest have expired (expire).
+    Checked for each run:
+    - every live timer fires once, never early and at most the compare
+      margin late, cancelled timers never fire,
+    - periodic timers keep their phase across the counter roll over.
+
+    Build and run: make -C firmware/test/host time
+    The insert/cancel/expire runs against an older sys_time.c, whose
+    periodic timers drift and so fail the phase check:
+        make -C firmware/test/host time-base BASE=<git revision>
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "system/time/sys_time.h"
+
+#define BENCH_TIMER_FREQUENCY   (SYS_TIME_CPU_CLOCK_FREQUENCY / 2)  // core timer runs at SYSCLK/2
+#define BENCH_LATE_MAX          ((SYS_TIME_COMPARE_UPDATE_EXECUTION_CYCLES / 2) + 2)    // compare margin, counts
+#define BENCH_OPS_PER_COUNT     (256 * 1024)
+
+typedef struct
+{
+    uint64_t        due;        // simulated counter value the timer is due at
+    uint32_t        period;     // counts, 0 for single shot
+    uint32_t        fired;
+    bool            cancelled;
+    SYS_TIME_HANDLE handle;
+} BENCH_TIMER;
+
+// simulated core timer
+static uint32_t hwCount;
+static uint32_t hwCompare;
+static uint64_t simTime;
+static SYS_TIME_PLIB_CALLBACK hwCallback;
+
+static uint64_t isrNs;
+static uint32_t errors;
+static uint32_t randState = 0x12345678;
+
+static BENCH_TIMER benchTimers[SYS_TIME_MAX_TIMERS];
+
+static void _HwCallbackSet(SYS_TIME_PLIB_CALLBACK callback, uintptr_t context)
+{
+    hwCallback = callback;
+}
+
+static void _HwStart(void)
+{
+}
+
+static void _HwStop(void)
+{
+}
+
+static uint32_t _HwFrequencyGet(void)
+{
+    return BENCH_TIMER_FREQUENCY;
+}
+
+static void _HwCompareSet(uint32_t compare)
+{
+    hwCompare = compare;
+}
+
+static uint32_t _HwCounterGet(void)
+{
+    return hwCount;
+}
+
+static const SYS_TIME_PLIB_INTERFACE benchTimePlib =
+{
+    .timerCallbackSet = _HwCallbackSet,
+    .timerStart = _HwStart,
+    .timerStop = _HwStop,
+    .timerFrequencyGet = _HwFrequencyGet,
+    .timerPeriodSet = NULL,
+    .timerCompareSet = _HwCompareSet,
+    .timerCounterGet = _HwCounterGet,
+};
+
+static const SYS_TIME_INIT benchTimeInit =
+{
+    .timePlib = &benchTimePlib,
+    .hwTimerIntNum = 0,
+};
+
+static uint64_t _NsGet(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t _Rand(void)
+{
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+
+// runs the counter, raising the compare interrupt on every match
+static void _HwAdvance(uint64_t counts)
+{
+    uint64_t step;
+    uint64_t t0;
+
+    while (counts != 0)
+    {
+        step = (uint32_t)(hwCompare - hwCount);
+        if (step == 0)
+        {
+            step = 1ULL << 32;
+        }
+        if (step > counts)
+        {
+            hwCount += (uint32_t)counts;
+            simTime += counts;
+            return;
+        }
+
+        hwCount += (uint32_t)step;
+        simTime += step;
+        counts -= step;
+
+        t0 = _NsGet();
+        hwCallback(0, 0);
+        isrNs += _NsGet() - t0;
+    }
+}
+
+static void _TimerCallback(uintptr_t context)
+{
+    BENCH_TIMER* pTmr = &benchTimers[context];
+
+    if (pTmr->cancelled || simTime < pTmr->due || simTime > pTmr->due + BENCH_LATE_MAX)
+    {
+        errors++;
+    }
+    pTmr->fired++;
+    pTmr->due += pTmr->period;
+}
+
+static SYS_MODULE_OBJ _TimeInit(void)
+{
+    hwCount = 0;
+    hwCompare = 0;
+    simTime = 0;
+    return SYS_TIME_Initialize(SYS_TIME_INDEX_0, (const SYS_MODULE_INIT*)&benchTimeInit);
+}
+
+static bool _Register(uint32_t ix, uint32_t us, SYS_TIME_CALLBACK_TYPE type)
+{
+    BENCH_TIMER* pTmr = &benchTimers[ix];
+
+    pTmr->due = simTime + SYS_TIME_USToCount(us);
+    pTmr->period = (type == SYS_TIME_PERIODIC) ? SYS_TIME_USToCount(us) : 0;
+    pTmr->fired = 0;
+    pTmr->cancelled = false;
+    pTmr->handle = SYS_TIME_CallbackRegisterUS(_TimerCallback, ix, us, type);
+
+    return pTmr->handle != SYS_TIME_HANDLE_INVALID;
+}
+
+static bool _RunScale(uint32_t nTimers)
+{
+    static uint32_t order[SYS_TIME_MAX_TIMERS];
+    uint32_t rounds = (BENCH_OPS_PER_COUNT + nTimers - 1) / nTimers;
+    uint64_t insertNs = 0, cancelNs = 0;
+    uint32_t nCancel = nTimers / 2;
+    uint32_t round, ix, jx, tmp;
+    uint32_t failed = 0;
+    SYS_MODULE_OBJ obj;
+    uint64_t t0;
+    bool pass;
+
+    errors = 0;
+    isrNs = 0;
+    for (round = 0; round < rounds; round++)
+    {
+        obj = _TimeInit();
+
+        t0 = _NsGet();
+        for (ix = 0; ix < nTimers; ix++)
+        {
+            if (!_Register(ix, 1000 + _Rand() % 10000000, SYS_TIME_SINGLE))
+            {
+                failed++;
+            }
+        }
+        insertNs += _NsGet() - t0;
+
+        for (ix = 0; ix < nTimers; ix++)
+        {
+            order[ix] = ix;
+        }
+        for (ix = nTimers - 1; ix > 0; ix--)
+        {
+            jx = _Rand() % (ix + 1);
+            tmp = order[ix];
+            order[ix] = order[jx];
+            order[jx] = tmp;
+        }
+        for (ix = 0; ix < nCancel; ix++)
+        {
+            benchTimers[order[ix]].cancelled = true;
+        }
+
+        t0 = _NsGet();
+        for (ix = 0; ix < nCancel; ix++)
+        {
+            if (SYS_TIME_TimerDestroy(benchTimers[order[ix]].handle) != SYS_TIME_SUCCESS)
+            {
+                failed++;
+            }
+        }
+        cancelNs += _NsGet() - t0;
+
+        _HwAdvance(SYS_TIME_USToCount(10001000 + 1000));
+
+        for (ix = 0; ix < nTimers; ix++)
+        {
+            if (benchTimers[ix].fired != (benchTimers[ix].cancelled ? 0 : 1))
+            {
+                failed++;
+            }
+        }
+
+        SYS_TIME_Deinitialize(obj);
+    }
+
+    pass = (failed == 0) && (errors == 0);
+    printf("%5u timers %s: insert %6.1f ns, cancel %6.1f ns, expire %6.1f ns, %u rounds\n", nTimers, pass ? "PASS" : "FAIL",
+            (double)insertNs / ((uint64_t)rounds * nTimers), (double)cancelNs / ((uint64_t)rounds * nCancel),
+            (double)isrNs / ((uint64_t)rounds * (nTimers - nCancel)), rounds);
+    return pass;
+}
+
+// periodic and single shot timers running across the 32-bit counter roll over
+static bool _RunPeriodic(void)
+{
+    uint32_t nPeriodic = SYS_TIME_MAX_TIMERS / 2;
+    uint32_t nSingle = SYS_TIME_MAX_TIMERS - nPeriodic;
+    uint64_t start, end;
+    uint32_t failed = 0;
+    SYS_MODULE_OBJ obj;
+    uint32_t ix;
+    bool pass;
+
+    errors = 0;
+    obj = _TimeInit();
+
+    // start 2 s before the counter rolls over
+    _HwAdvance(0xFFFFFFFFULL - SYS_TIME_USToCount(2000000));
+    start = simTime;
+    for (ix = 0; ix < nPeriodic; ix++)
+    {
+        failed += !_Register(ix, 1000 + _Rand() % 100000, SYS_TIME_PERIODIC);
+    }
+    for (; ix < nPeriodic + nSingle; ix++)
+    {
+        failed += !_Register(ix, 1000 + _Rand() % 4000000, SYS_TIME_SINGLE);
+    }
+
+    while (simTime - start < SYS_TIME_USToCount(5000000))
+    {
+        _HwAdvance(1 + _Rand() % SYS_TIME_USToCount(3000));
+    }
+    end = simTime;
+
+    for (ix = 0; ix < nPeriodic; ix++)
+    {
+        // fired at start + k * period for every k >= 1 up to end
+        if (benchTimers[ix].fired != (end - start) / benchTimers[ix].period)
+        {
+            failed++;
+        }
+    }
+    for (; ix < nPeriodic + nSingle; ix++)
+    {
+        failed += (benchTimers[ix].fired != 1);
+    }
+
+    SYS_TIME_Deinitialize(obj);
+
+    pass = (failed == 0) && (errors == 0);
+    printf("%-28s %s: %u periodic, %u single, %u failed, %u errors\n", "periodic across roll over", pass ? "PASS" : "FAIL",
+            nPeriodic, nSingle, failed, errors);
+    return pass;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t nTimers;
+    bool pass = true;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    // "scale" skips the periodic check, see the description
+    if ((argc < 2) || (strcmp(argv[1], "scale") != 0))
+    {
+        pass &= _RunPeriodic();
+    }
+    for (nTimers = 32; nTimers <= SYS_TIME_MAX_TIMERS; nTimers *= 4)
+    {
+        pass &= _RunScale(nTimers);
+    }
+
+    printf("%s\n", pass ? "ALL PASS" : "FAILED");
+    return pass ? 0 : 1;
+}
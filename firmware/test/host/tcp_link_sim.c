@@ -0,0 +1,1042 @@
+/*******************************************************************************
+  TCP lossy link host simulation
+
+  Summary:
+    Goodput of library/tcpip/src/tcp.c over a simulated lossy link.
+
+  Description:
+    tcp.c and tcpip_helpers.c are compiled unchanged. A client and a server
+    socket of the stack talk to each other over a simulated link, in
+    simulated time:
+    - a frame is serialized at the link rate and arrives after the one-way
+      delay; frames are dropped at random with the loss rate, in both
+      directions, as with a netem qdisc on each side,
+    - the TCP task runs every TCPIP_TCP_TASK_TICK_RATE ms and as soon as
+      a frame arrives, as the stack manager runs it,
+    - a transmitted packet is acknowledged once the stack call that sent it
+      returns, as the MAC driver would.
+    The client sends a byte pattern for SIM_RUN_MS, the server reads it as
+    fast as it arrives. For each loss rate the goodput, the retransmission
+    timeouts and the fast retransmissions of the client are averaged over
+    SIM_SEEDS loss patterns.
+    The burst loss runs use a SIM_BURST_WINDOW window, about the link's
+    bandwidth-delay product, and drop frames in bursts: a burst starts with
+    the loss rate, lasts 4 frames on average and drops every other frame on
+    average, so a window often has several holes. They run with SACK and
+    with the SACK-permitted option stripped from the SYNs on the link, and
+    SACK has to give at least SIM_BURST_SACK_GAIN percent more goodput.
+    Checked for each run:
+    - the server reads the pattern in order and uncorrupted,
+    - the connection stays up.
+
+    "rpc" runs request/response exchanges over the lossless link instead:
+    the client writes a header and a body, the server answers the same way
+    once the whole request is in. The round trip latency is compared for
+    the default socket, TCP_OPTION_DELAYED_ACK_TMO 0, TCP_OPTION_QUICK_ACK
+    and TCP_OPTION_CORK with TCPIP_TCP_Flush. It also checks that data
+    written to a corked socket after a flush is held back.
+
+    Build and run: make -C firmware/test/host tcp
+    The tcp target runs the loss sweep with and without
+    TCPIP_TCP_SACK_SUPPORT, then the server RX buffer autotuning on and off,
+    then the RPC latency.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TCPIP_THIS_MODULE_ID    TCPIP_MODULE_TCP
+
+#include "tcpip/src/tcpip_private.h"
+#include "crypto/crypto.h"
+#undef vsnprintf
+
+#define SIM_LINK_RATE           20000000    // bit/s
+#define SIM_LINK_DELAY          5000        // us, one way
+#define SIM_RUN_MS              20000       // transfer time of a run
+#define SIM_CONNECT_MS          2000
+#define SIM_SEEDS               5
+#define SIM_CLIENT_TX_SIZE      8760        // as iperf -w; the sender is not the limit
+#define SIM_FRAME_SIZE          1600
+#define SIM_SERVER_PORT         5001
+#define SIM_PATTERN_PERIOD      251         // prime, not a divisor of any buffer size
+#define SIM_BURST_WINDOW        23360       // 16 segments
+#define SIM_BURST_SACK_GAIN     10          // %
+
+// TCP option kinds, RFC 793 and RFC 2018
+#define SIM_TCP_OPT_END         0
+#define SIM_TCP_OPT_NOP         1
+#define SIM_TCP_OPT_SACK_PERM   4
+#define SIM_RPC_EXCHANGES       100
+#define SIM_RPC_HEADER_SIZE     16
+#define SIM_RPC_REQUEST_SIZE    200         // body
+#define SIM_RPC_REPLY_SIZE      1000        // body
+#define SIM_RPC_TMO_MS          1000        // per exchange
+#define SIM_CORK_FLUSHED_SIZE   4000        // more than the server RX window
+#define SIM_CORK_HELD_SIZE      100
+
+typedef enum
+{
+    SIM_RPC_DEFAULT,
+    SIM_RPC_NO_DELAYED_ACK,
+    SIM_RPC_QUICK_ACK,
+    SIM_RPC_CORK,
+}SIM_RPC_MODE;
+
+typedef struct _SIM_FRAME
+{
+    struct _SIM_FRAME*  next;
+    uint64_t            arrival;    // us
+    uint16_t            len;        // IPv4 header + TCP segment
+    uint32_t            data[SIM_FRAME_SIZE / 4];
+}SIM_FRAME;
+
+typedef struct
+{
+    SIM_FRAME*          head;
+    SIM_FRAME*          tail;
+    uint64_t            freeTime;   // us, the link is serializing until then
+    bool                inBurst;    // burst loss mode: dropping frames
+}SIM_LINK;
+
+// a received frame, as the MAC driver passes it to the stack
+typedef struct
+{
+    TCPIP_MAC_PACKET        pkt;
+    TCPIP_MAC_DATA_SEGMENT  seg;
+    uint32_t                data[SIM_FRAME_SIZE / 4];
+}SIM_RX_PACKET;
+
+typedef struct
+{
+    uint64_t            rxBytes;
+    uint32_t            rtoCount;
+    uint32_t            fastRtxCount;
+    uint32_t            rxSize;     // server RX buffer size at the end
+    uint32_t            srtt;       // client smoothed RTT at the end, ms
+    uint32_t            rto;        // client retransmission timeout at the end, ms
+    uint32_t            errors;
+}SIM_RESULT;
+
+// simulated time, us
+static uint64_t         simTime;
+static uint64_t         simTickTime;
+
+// link; 0: to the server, 1: to the client
+static SIM_LINK         simLink[2];
+static uint32_t         simLossPpm;
+static uint32_t         simRandState;
+static bool             simBurstLoss;       // simLossPpm starts a loss burst
+static bool             simSackStrip;       // the link removes SACK-permitted from the SYNs
+static uint16_t         simWindow;          // server RX and client TX buffer; 0 for the defaults
+static double           simGoodput;         // kbit/s, of the last _RunAveraged
+
+// stack
+static TCPIP_NET_IF     simNetIf;
+static tcpipModuleSignalHandler simHandler;
+static uint32_t         simTaskRate;        // ms
+static TCPIP_MODULE_SIGNAL simSignals;
+static TCPIP_MAC_PACKET* simRxHead;
+static TCPIP_MAC_PACKET* simRxTail;
+static TCPIP_MAC_PACKET* simTxDone;         // transmitted, to be acknowledged
+
+// application
+static TCP_SOCKET       simServer;
+static TCP_SOCKET       simClient;
+static uint64_t         simTxOffset;
+static uint64_t         simRxOffset;
+static uint32_t         simErrors;
+
+// request/response
+static SIM_RPC_MODE     simRpcMode;
+static uint64_t         simRpcStart;        // us, 0 if no request pending
+static uint32_t         simRpcCount;
+static uint64_t         simRpcTotal;        // us
+static uint64_t         simRpcMax;          // us
+
+static uint32_t _Rand(void)
+{
+    simRandState ^= simRandState << 13;
+    simRandState ^= simRandState >> 17;
+    simRandState ^= simRandState << 5;
+    return simRandState;
+}
+
+// system services
+uint64_t SYS_TIME_Counter64Get(void)
+{
+    return simTime;
+}
+
+uint32_t SYS_TIME_FrequencyGet(void)
+{
+    return 1000000;
+}
+
+uint32_t SYS_TMR_TickCountGet(void)
+{
+    return (uint32_t)(simTime / 1000);
+}
+
+uint32_t SYS_TMR_TickCounterFrequencyGet(void)
+{
+    return 1000;
+}
+
+uint32_t SYS_RANDOM_CryptoGet(void)
+{
+    return _Rand();
+}
+
+size_t SYS_RANDOM_CryptoBlockGet(void* buffer, size_t size)
+{
+    uint8_t* pB = (uint8_t*)buffer;
+    size_t ix;
+
+    for(ix = 0; ix < size; ix++)
+    {
+        pB[ix] = (uint8_t)_Rand();
+    }
+    return size;
+}
+
+// the sequence number hash; any mix will do here
+int CRYPT_MD5_Initialize(CRYPT_MD5_CTX* md5)
+{
+    memset(md5, 0, sizeof(*md5));
+    return 0;
+}
+
+int CRYPT_MD5_DataAdd(CRYPT_MD5_CTX* md5, const unsigned char* input, unsigned int sz)
+{
+    uint32_t* pHash = (uint32_t*)md5;
+
+    while(sz--)
+    {
+        pHash[0] = (pHash[0] ^ *input++) * 16777619u;
+    }
+    return 0;
+}
+
+int CRYPT_MD5_Finalize(CRYPT_MD5_CTX* md5, unsigned char* digest)
+{
+    uint32_t hash = *(uint32_t*)md5;
+    int ix;
+
+    for(ix = 0; ix < 16; ix += 4)
+    {
+        memcpy(digest + ix, &hash, 4);
+        hash = hash * 16777619u + 1;
+    }
+    return 0;
+}
+
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void)
+{
+    return SYS_ERROR_ERROR;
+}
+
+SYS_MODULE_INDEX SYS_DEBUG_ConsoleInstanceGet(void)
+{
+    return SYS_CONSOLE_INDEX_0;
+}
+
+void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    simErrors++;
+}
+
+int _HostVsnprintf(char* buff, size_t size, const char* fmt, va_list args)
+{
+    return vsnprintf(buff, size, fmt, args);
+}
+
+// heap
+static void* _HeapMalloc(TCPIP_STACK_HEAP_HANDLE heapH, size_t nBytes)
+{
+    return malloc(nBytes);
+}
+
+static void* _HeapCalloc(TCPIP_STACK_HEAP_HANDLE heapH, size_t nElems, size_t elemSize)
+{
+    return calloc(nElems, elemSize);
+}
+
+static size_t _HeapFree(TCPIP_STACK_HEAP_HANDLE heapH, const void* pBuff)
+{
+    free((void*)pBuff);
+    return 0;
+}
+
+static const TCPIP_HEAP_OBJECT simHeap =
+{
+    .TCPIP_HEAP_Malloc = _HeapMalloc,
+    .TCPIP_HEAP_Calloc = _HeapCalloc,
+    .TCPIP_HEAP_Free = _HeapFree,
+};
+
+// stack manager; the single interface holds both sockets
+tcpipSignalHandle _TCPIPStackSignalHandlerRegister(TCPIP_STACK_MODULE modId, tcpipModuleSignalHandler signalHandler, int16_t asyncTmoMs)
+{
+    simHandler = signalHandler;
+    simTaskRate = asyncTmoMs;
+    return &simHandler;
+}
+
+void _TCPIPStackSignalHandlerDeregister(tcpipSignalHandle handle)
+{
+    simHandler = 0;
+}
+
+TCPIP_MODULE_SIGNAL _TCPIPStackModuleSignalGet(TCPIP_STACK_MODULE modId, TCPIP_MODULE_SIGNAL clrMask)
+{
+    TCPIP_MODULE_SIGNAL sigs = simSignals;
+
+    simSignals &= ~clrMask;
+    return sigs;
+}
+
+TCPIP_MAC_PACKET* _TCPIPStackModuleRxExtract(TCPIP_STACK_MODULE modId)
+{
+    TCPIP_MAC_PACKET* pPkt = simRxHead;
+
+    if(pPkt != 0)
+    {
+        if((simRxHead = pPkt->next) == 0)
+        {
+            simRxTail = 0;
+        }
+        pPkt->next = 0;
+    }
+    return pPkt;
+}
+
+TCPIP_NET_HANDLE TCPIP_STACK_NetDefaultGet(void)
+{
+    return &simNetIf;
+}
+
+int TCPIP_STACK_NetIxGet(TCPIP_NET_IF* pNetIf)
+{
+    return 0;
+}
+
+TCPIP_NET_IF* TCPIP_STACK_IPAddToNet(IPV4_ADDR* pIpAddress, bool useDefault)
+{
+    return (pIpAddress != 0 && pIpAddress->Val == simNetIf.netIPAddr.Val) || useDefault ? &simNetIf : 0;
+}
+
+// packets, laid out as by tcpip_packet.c, without the MAC header
+TCPIP_MAC_PACKET* _TCPIP_PKT_SocketAlloc(uint16_t pktLen, uint16_t tHdrLen, uint16_t payloadLen, TCPIP_MAC_PACKET_FLAGS flags)
+{
+    uint16_t pktUpLen = ((pktLen + 7) >> 3) << 3;
+    uint16_t loadLen = sizeof(IPV4_HEADER) + tHdrLen + payloadLen;
+    TCPIP_MAC_PACKET* pPkt = (TCPIP_MAC_PACKET*)calloc(1, pktUpLen + sizeof(TCPIP_MAC_DATA_SEGMENT) + loadLen);
+    TCPIP_MAC_DATA_SEGMENT* pSeg;
+
+    if(pPkt != 0)
+    {
+        pSeg = (TCPIP_MAC_DATA_SEGMENT*)((uint8_t*)pPkt + pktUpLen);
+        pSeg->segBuffer = pSeg->segLoad = (uint8_t*)(pSeg + 1);
+        pSeg->segSize = pSeg->segAllocSize = loadLen;
+        pSeg->segFlags = TCPIP_MAC_SEG_FLAG_STATIC;
+        pPkt->pDSeg = pSeg;
+        pPkt->pMacLayer = pPkt->pNetLayer = pSeg->segLoad;
+        pPkt->pTransportLayer = pPkt->pNetLayer + sizeof(IPV4_HEADER);
+        pPkt->pktFlags = flags;
+    }
+    return pPkt;
+}
+
+void _TCPIP_PKT_PacketFree(TCPIP_MAC_PACKET* pPkt)
+{
+    free(pPkt);
+}
+
+void _TCPIP_PKT_PacketAcknowledge(TCPIP_MAC_PACKET* pPkt, TCPIP_MAC_PKT_ACK_RES ackRes, TCPIP_STACK_MODULE moduleId)
+{
+    if(ackRes != TCPIP_MAC_PKT_ACK_NONE)
+    {
+        pPkt->ackRes = ackRes;
+    }
+
+    if((*pPkt->ackFunc)(pPkt, pPkt->ackParam))
+    {
+        pPkt->pktFlags &= ~TCPIP_MAC_PKT_FLAG_QUEUED;
+    }
+}
+
+// same as tcpip_packet.c
+TCPIP_MAC_DATA_SEGMENT* TCPIP_PKT_DataSegmentGet(TCPIP_MAC_PACKET* pPkt, const uint8_t* dataAddress, bool srchTransport)
+{
+    TCPIP_MAC_DATA_SEGMENT  *pStartSeg, *pSeg;
+
+    pStartSeg = 0;
+
+    if(srchTransport)
+    {
+        for(pSeg = pPkt->pDSeg; pSeg != 0; pSeg = pSeg->next)
+        {
+            if(pSeg->segLoad <= pPkt->pTransportLayer && pPkt->pTransportLayer <= pSeg->segLoad + pSeg->segSize)
+            {
+                if(pPkt->pTransportLayer <= dataAddress && dataAddress <= pSeg->segLoad + pSeg->segSize)
+                {
+                    return pSeg;
+                }
+
+                pStartSeg = pSeg->next;
+                break;
+            }
+        }
+    }
+    else
+    {
+        pStartSeg = pPkt->pDSeg;
+    }
+
+    for(pSeg = pStartSeg; pSeg != 0; pSeg = pSeg->next)
+    {
+        if(pSeg->segLoad <= dataAddress && dataAddress <= pSeg->segLoad + pSeg->segSize)
+        {
+            return pSeg;
+        }
+    }
+
+    return 0;
+}
+
+static bool _RxPacketAck(TCPIP_MAC_PACKET* pPkt, const void* param)
+{
+    free(pPkt);
+    return false;
+}
+
+// IPv4 and the link
+bool TCPIP_IPV4_IsFragmentationEnabled(void)
+{
+    return false;
+}
+
+int TCPIP_IPV4_MaxDatagramDataSizeGet(TCPIP_NET_HANDLE netH)
+{
+    return 1500 - sizeof(IPV4_HEADER);
+}
+
+TCPIP_NET_HANDLE TCPIP_IPV4_SelectSourceInterface(TCPIP_NET_HANDLE netH, const IPV4_ADDR* pDestAddress, IPV4_ADDR* pSrcAddress, bool srcSet)
+{
+    if(!srcSet)
+    {
+        pSrcAddress->Val = simNetIf.netIPAddr.Val;
+    }
+    return &simNetIf;
+}
+
+void TCPIP_IPV4_PacketFormatTx(IPV4_PACKET* pPkt, uint8_t protocol, uint16_t ipLoadLen, TCPIP_IPV4_PACKET_PARAMS* pParams)
+{
+    IPV4_HEADER* pHdr = (IPV4_HEADER*)pPkt->macPkt.pNetLayer;
+
+    memset(pHdr, 0, sizeof(*pHdr));
+    pHdr->Version = 4;
+    pHdr->IHL = sizeof(*pHdr) >> 2;
+    pHdr->TotalLength = TCPIP_Helper_htons(sizeof(*pHdr) + ipLoadLen);
+    pHdr->TimeToLive = pParams->ttl;
+    pHdr->Protocol = protocol;
+    pHdr->SourceAddress.Val = pPkt->srcAddress.Val;
+    pHdr->DestAddress.Val = pPkt->destAddress.Val;
+}
+
+// random loss, or loss in bursts
+static bool _LinkDrop(SIM_LINK* pLink)
+{
+    if(!simBurstLoss)
+    {
+        return _Rand() % 1000000 < simLossPpm;
+    }
+
+    if(pLink->inBurst)
+    {
+        pLink->inBurst = _Rand() % 4 != 0;
+    }
+    else
+    {
+        pLink->inBurst = _Rand() % 1000000 < simLossPpm;
+    }
+
+    return pLink->inBurst && (_Rand() & 1) != 0;
+}
+
+// turns the SACK-permitted option of a SYN into 2 NOPs, as a middlebox would
+static void _SackPermittedStrip(TCP_HEADER* pHdr)
+{
+    uint8_t* pOpt = (uint8_t*)(pHdr + 1);
+    uint8_t* pEnd = (uint8_t*)pHdr + (pHdr->DataOffset.Val << 2);
+    uint16_t oldVal, newVal;
+
+    while(pOpt + 1 < pEnd && *pOpt != SIM_TCP_OPT_END)
+    {
+        if(*pOpt == SIM_TCP_OPT_NOP)
+        {
+            pOpt++;
+            continue;
+        }
+
+        if(*pOpt == SIM_TCP_OPT_SACK_PERM && ((pOpt - (uint8_t*)pHdr) & 1) == 0)
+        {
+            memcpy(&oldVal, pOpt, sizeof(oldVal));
+            pOpt[0] = pOpt[1] = SIM_TCP_OPT_NOP;
+            memcpy(&newVal, pOpt, sizeof(newVal));
+            pHdr->Checksum = TCPIP_Helper_ChecksumUpdate16(pHdr->Checksum, oldVal, newVal);
+            return;
+        }
+        pOpt += pOpt[1] < 2 ? 2 : pOpt[1];
+    }
+}
+
+// copies the frame into the link queue; drops it with the loss rate
+bool TCPIP_IPV4_PacketTransmit(IPV4_PACKET* pPkt)
+{
+    TCPIP_MAC_PACKET* pMacPkt = &pPkt->macPkt;
+    IPV4_HEADER* pHdr = (IPV4_HEADER*)pMacPkt->pNetLayer;
+    uint16_t tcpLen = TCPIP_Helper_ntohs(pHdr->TotalLength) - sizeof(*pHdr);
+    TCP_HEADER* pTcpHdr = (TCP_HEADER*)pMacPkt->pTransportLayer;
+    uint8_t* pCopy = pMacPkt->pTransportLayer;
+    SIM_LINK* pLink;
+    SIM_FRAME* pFrame;
+
+    pLink = &simLink[pTcpHdr->SourcePort == TCPIP_Helper_htons(SIM_SERVER_PORT) ? 1 : 0];
+    if(pLink->freeTime < simTime)
+    {
+        pLink->freeTime = simTime;
+    }
+    pLink->freeTime += (uint64_t)(sizeof(*pHdr) + tcpLen) * 8 * 1000000 / SIM_LINK_RATE;
+
+    if(!_LinkDrop(pLink))
+    {
+        pFrame = (SIM_FRAME*)malloc(sizeof(*pFrame));
+        pFrame->next = 0;
+        pFrame->arrival = pLink->freeTime + SIM_LINK_DELAY;
+        pFrame->len = sizeof(*pHdr) + tcpLen;
+        memcpy(pFrame->data, pHdr, sizeof(*pHdr));
+        TCPIP_Helper_PacketCopy(pMacPkt, (uint8_t*)pFrame->data + sizeof(*pHdr), &pCopy, tcpLen, true);
+        if(simSackStrip && (pTcpHdr->Flags.bits.flagSYN) != 0)
+        {
+            _SackPermittedStrip((TCP_HEADER*)((uint8_t*)pFrame->data + sizeof(*pHdr)));
+        }
+        if(pLink->tail == 0)
+        {
+            pLink->head = pFrame;
+        }
+        else
+        {
+            pLink->tail->next = pFrame;
+        }
+        pLink->tail = pFrame;
+    }
+
+    pMacPkt->next = simTxDone;
+    simTxDone = pMacPkt;
+    return true;
+}
+
+static void _TxAcknowledge(void)
+{
+    TCPIP_MAC_PACKET* pPkt;
+
+    while((pPkt = simTxDone) != 0)
+    {
+        simTxDone = pPkt->next;
+        pPkt->next = 0;
+        _TCPIP_PKT_PacketAcknowledge(pPkt, TCPIP_MAC_PKT_ACK_TX_OK, TCPIP_MODULE_TCP);
+    }
+}
+
+// moves the frames that arrived by now to the stack RX queue
+static void _LinkDeliver(SIM_LINK* pLink)
+{
+    SIM_FRAME* pFrame;
+    SIM_RX_PACKET* pRx;
+
+    while((pFrame = pLink->head) != 0 && pFrame->arrival <= simTime)
+    {
+        if((pLink->head = pFrame->next) == 0)
+        {
+            pLink->tail = 0;
+        }
+
+        pRx = (SIM_RX_PACKET*)calloc(1, sizeof(*pRx));
+        memcpy(pRx->data, pFrame->data, pFrame->len);
+        pRx->seg.segBuffer = pRx->seg.segLoad = (uint8_t*)pRx->data;
+        pRx->seg.segSize = pRx->seg.segAllocSize = sizeof(pRx->data);
+        pRx->seg.segLen = pFrame->len - sizeof(IPV4_HEADER);
+        pRx->pkt.pDSeg = &pRx->seg;
+        pRx->pkt.pMacLayer = pRx->pkt.pNetLayer = (uint8_t*)pRx->data;
+        pRx->pkt.pTransportLayer = pRx->pkt.pNetLayer + sizeof(IPV4_HEADER);
+        pRx->pkt.totTransportLen = pFrame->len - sizeof(IPV4_HEADER);
+        pRx->pkt.pktFlags = TCPIP_MAC_PKT_FLAG_IPV4;
+        pRx->pkt.pktIf = &simNetIf;
+        pRx->pkt.ackFunc = _RxPacketAck;
+        free(pFrame);
+
+        if(simRxTail == 0)
+        {
+            simRxHead = &pRx->pkt;
+        }
+        else
+        {
+            simRxTail->next = &pRx->pkt;
+        }
+        simRxTail = &pRx->pkt;
+        simSignals |= TCPIP_MODULE_SIGNAL_RX_PENDING;
+    }
+}
+
+static void _LinkFlush(void)
+{
+    SIM_FRAME* pFrame;
+    int ix;
+
+    for(ix = 0; ix < 2; ix++)
+    {
+        while((pFrame = simLink[ix].head) != 0)
+        {
+            simLink[ix].head = pFrame->next;
+            free(pFrame);
+        }
+        simLink[ix].tail = 0;
+        simLink[ix].freeTime = 0;
+        simLink[ix].inBurst = false;
+    }
+}
+
+// the client writes the pattern, the server reads and checks it
+static void _AppRun(void)
+{
+    uint8_t buff[1024];
+    uint16_t avlbl, len, ix;
+
+    while((avlbl = TCPIP_TCP_PutIsReady(simClient)) != 0)
+    {
+        len = avlbl < sizeof(buff) ? avlbl : sizeof(buff);
+        for(ix = 0; ix < len; ix++)
+        {
+            buff[ix] = (uint8_t)((simTxOffset + ix) % SIM_PATTERN_PERIOD);
+        }
+        len = TCPIP_TCP_ArrayPut(simClient, buff, len);
+        simTxOffset += len;
+        if(len == 0)
+        {
+            break;
+        }
+    }
+    _TxAcknowledge();
+
+    while((len = TCPIP_TCP_ArrayGet(simServer, buff, sizeof(buff))) != 0)
+    {
+        for(ix = 0; ix < len; ix++)
+        {
+            if(buff[ix] != (uint8_t)((simRxOffset + ix) % SIM_PATTERN_PERIOD))
+            {
+                simErrors++;
+                break;
+            }
+        }
+        simRxOffset += len;
+    }
+    _TxAcknowledge();
+}
+
+// advances to the next tick or frame arrival and runs the TCP task
+static void _StackStep(void)
+{
+    uint64_t next = simTickTime;
+    int ix;
+
+    for(ix = 0; ix < 2; ix++)
+    {
+        if(simLink[ix].head != 0 && simLink[ix].head->arrival < next)
+        {
+            next = simLink[ix].head->arrival;
+        }
+    }
+    simTime = next;
+
+    _LinkDeliver(&simLink[0]);
+    _LinkDeliver(&simLink[1]);
+    if(simTime >= simTickTime)
+    {
+        simSignals |= TCPIP_MODULE_SIGNAL_TMO;
+        simTickTime += simTaskRate * 1000;
+    }
+
+    (*simHandler)();
+    _TxAcknowledge();
+}
+
+// opens the server and the client sockets and connects them over the lossless link
+static void _Connect(bool autotune)
+{
+    IP_MULTI_ADDRESS addr = {.v4Add = simNetIf.netIPAddr};
+    uint64_t endTime;
+
+    simLossPpm = 0;
+    simServer = TCPIP_TCP_ServerOpen(IP_ADDRESS_TYPE_IPV4, SIM_SERVER_PORT, 0);
+    TCPIP_TCP_OptionsSet(simServer, TCP_OPTION_RX_AUTOTUNE, (void*)autotune);
+    simClient = TCPIP_TCP_ClientOpen(IP_ADDRESS_TYPE_IPV4, SIM_SERVER_PORT, &addr);
+    TCPIP_TCP_OptionsSet(simClient, TCP_OPTION_TX_BUFF, (void*)SIM_CLIENT_TX_SIZE);
+    if(simWindow != 0)
+    {
+        TCPIP_TCP_OptionsSet(simServer, TCP_OPTION_RX_BUFF, (void*)(uintptr_t)simWindow);
+        TCPIP_TCP_OptionsSet(simClient, TCP_OPTION_TX_BUFF, (void*)(uintptr_t)simWindow);
+    }
+
+    endTime = simTime + SIM_CONNECT_MS * 1000;
+    while(simTime < endTime && !(TCPIP_TCP_IsConnected(simClient) && TCPIP_TCP_IsConnected(simServer)))
+    {
+        _StackStep();
+    }
+}
+
+static void _Disconnect(void)
+{
+    TCPIP_TCP_Abort(simClient, true);
+    TCPIP_TCP_Abort(simServer, true);
+    _TxAcknowledge();
+    _LinkFlush();
+}
+
+static bool _Run(uint32_t lossPpm, uint32_t seed, bool autotune, SIM_RESULT* pRes)
+{
+    TCP_SOCKET_INFO info;
+    uint64_t endTime;
+
+    memset(pRes, 0, sizeof(*pRes));
+    simRandState = seed;
+    simErrors = 0;
+    simTxOffset = simRxOffset = 0;
+
+    _Connect(autotune);
+
+    simLossPpm = lossPpm;
+    endTime = simTime + SIM_RUN_MS * 1000;
+    while(simTime < endTime && TCPIP_TCP_IsConnected(simClient) && TCPIP_TCP_IsConnected(simServer))
+    {
+        _AppRun();
+        _StackStep();
+    }
+
+    if(simTime < endTime)
+    {   // connection lost
+        pRes->errors++;
+    }
+
+    pRes->rxBytes = simRxOffset;
+    if(TCPIP_TCP_SocketInfoGet(simClient, &info))
+    {
+        pRes->rtoCount = info.rtoCount;
+        pRes->fastRtxCount = info.fastRtxCount;
+        pRes->srtt = info.srtt;
+        pRes->rto = info.rto;
+    }
+    if(TCPIP_TCP_SocketInfoGet(simServer, &info))
+    {
+        pRes->rxSize = info.rxSize;
+    }
+    pRes->errors += simErrors;
+
+    _Disconnect();
+
+    return pRes->errors == 0;
+}
+
+static bool _RunAveraged(const char* name, uint32_t lossPpm, bool autotune)
+{
+    SIM_RESULT res, sum;
+    uint32_t seed;
+    bool pass = true;
+
+    memset(&sum, 0, sizeof(sum));
+    for(seed = 1; seed <= SIM_SEEDS; seed++)
+    {
+        pass &= _Run(lossPpm, seed * 0x9e3779b9u, autotune, &res);
+        sum.rxBytes += res.rxBytes;
+        sum.rtoCount += res.rtoCount;
+        sum.fastRtxCount += res.fastRtxCount;
+        sum.rxSize += res.rxSize;
+        sum.srtt += res.srtt;
+        sum.rto += res.rto;
+        sum.errors += res.errors;
+    }
+
+    simGoodput = (double)sum.rxBytes * 8 / SIM_RUN_MS / SIM_SEEDS;
+    printf("%-28s %s: %6.0f kbit/s, %5.1f RTO, %6.1f fast rtx, RX buffer %u, SRTT/RTO %u/%u ms, %u errors\n", name, pass ? "PASS" : "FAIL",
+            (double)sum.rxBytes * 8 / SIM_RUN_MS / SIM_SEEDS, (double)sum.rtoCount / SIM_SEEDS,
+            (double)sum.fastRtxCount / SIM_SEEDS, sum.rxSize / SIM_SEEDS, sum.srtt / SIM_SEEDS, sum.rto / SIM_SEEDS, sum.errors);
+    return pass;
+}
+
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+// burst loss over a window of about the bandwidth-delay product, with and without SACK
+static bool _BurstCompare(void)
+{
+    static const uint32_t burstPpm[] = {10000, 20000, 30000};
+    double sackKbps, noSackKbps;
+    char name[32];
+    uint32_t ix;
+    bool pass = true;
+
+    simBurstLoss = true;
+    simWindow = SIM_BURST_WINDOW;
+    for(ix = 0; ix < sizeof(burstPpm) / sizeof(*burstPpm); ix++)
+    {
+        snprintf(name, sizeof(name), "burst %.1f%%, no SACK", (double)burstPpm[ix] / 10000);
+        simSackStrip = true;
+        pass &= _RunAveraged(name, burstPpm[ix], false);
+        noSackKbps = simGoodput;
+
+        snprintf(name, sizeof(name), "burst %.1f%%, SACK", (double)burstPpm[ix] / 10000);
+        simSackStrip = false;
+        pass &= _RunAveraged(name, burstPpm[ix], false);
+        sackKbps = simGoodput;
+
+        if(sackKbps * 100 < noSackKbps * (100 + SIM_BURST_SACK_GAIN))
+        {
+            printf("SACK gain %.0f%%, less than %u%%\n", (sackKbps / noSackKbps - 1) * 100, SIM_BURST_SACK_GAIN);
+            pass = false;
+        }
+    }
+    simBurstLoss = false;
+    simWindow = 0;
+
+    return pass;
+}
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+
+// writes a message as an RPC library would: the header, then the body
+static void _RpcWrite(TCP_SOCKET skt, uint16_t bodySize)
+{
+    uint8_t buff[SIM_RPC_REPLY_SIZE];
+
+    memset(buff, 0x5a, sizeof(buff));
+    if(TCPIP_TCP_ArrayPut(skt, buff, SIM_RPC_HEADER_SIZE) != SIM_RPC_HEADER_SIZE || TCPIP_TCP_ArrayPut(skt, buff, bodySize) != bodySize)
+    {
+        simErrors++;
+    }
+
+    if(simRpcMode == SIM_RPC_CORK)
+    {
+        TCPIP_TCP_Flush(skt);
+    }
+    else if(simRpcMode == SIM_RPC_QUICK_ACK)
+    {   // the answer, header and body, is expected right away
+        TCPIP_TCP_OptionsSet(skt, TCP_OPTION_QUICK_ACK, (void*)2);
+    }
+}
+
+// the server answers a complete request; the client times the exchange and starts the next one
+static void _RpcAppRun(void)
+{
+    uint8_t buff[SIM_RPC_HEADER_SIZE + SIM_RPC_REPLY_SIZE];
+    uint64_t latency;
+
+    if(TCPIP_TCP_GetIsReady(simServer) >= SIM_RPC_HEADER_SIZE + SIM_RPC_REQUEST_SIZE)
+    {
+        TCPIP_TCP_ArrayGet(simServer, buff, SIM_RPC_HEADER_SIZE + SIM_RPC_REQUEST_SIZE);
+        _RpcWrite(simServer, SIM_RPC_REPLY_SIZE);
+    }
+
+    if(simRpcStart != 0 && TCPIP_TCP_GetIsReady(simClient) >= SIM_RPC_HEADER_SIZE + SIM_RPC_REPLY_SIZE)
+    {
+        TCPIP_TCP_ArrayGet(simClient, buff, sizeof(buff));
+        latency = simTime - simRpcStart;
+        simRpcTotal += latency;
+        if(latency > simRpcMax)
+        {
+            simRpcMax = latency;
+        }
+        simRpcStart = 0;
+        simRpcCount++;
+    }
+
+    if(simRpcStart == 0 && simRpcCount < SIM_RPC_EXCHANGES)
+    {
+        simRpcStart = simTime;
+        _RpcWrite(simClient, SIM_RPC_REQUEST_SIZE);
+    }
+    _TxAcknowledge();
+}
+
+static bool _RpcRun(const char* name, SIM_RPC_MODE mode, double* pAvgMs)
+{
+    uint64_t endTime;
+    bool pass;
+
+    simErrors = 0;
+    simRpcMode = mode;
+    simRpcStart = simRpcTotal = simRpcMax = 0;
+    simRpcCount = 0;
+
+    _Connect(true);
+    switch(mode)
+    {
+        case SIM_RPC_NO_DELAYED_ACK:
+            TCPIP_TCP_OptionsSet(simClient, TCP_OPTION_DELAYED_ACK_TMO, (void*)0);
+            TCPIP_TCP_OptionsSet(simServer, TCP_OPTION_DELAYED_ACK_TMO, (void*)0);
+            break;
+
+        case SIM_RPC_QUICK_ACK:
+            // the server waits for the first request
+            TCPIP_TCP_OptionsSet(simServer, TCP_OPTION_QUICK_ACK, (void*)2);
+            break;
+
+        case SIM_RPC_CORK:
+            TCPIP_TCP_OptionsSet(simClient, TCP_OPTION_CORK, (void*)true);
+            TCPIP_TCP_OptionsSet(simServer, TCP_OPTION_CORK, (void*)true);
+            break;
+
+        default:
+            break;
+    }
+
+    endTime = simTime + (uint64_t)SIM_RPC_EXCHANGES * SIM_RPC_TMO_MS * 1000;
+    while(simTime < endTime && simRpcCount < SIM_RPC_EXCHANGES && TCPIP_TCP_IsConnected(simClient) && TCPIP_TCP_IsConnected(simServer))
+    {
+        _RpcAppRun();
+        _StackStep();
+    }
+
+    pass = simRpcCount == SIM_RPC_EXCHANGES && simErrors == 0;
+    *pAvgMs = simRpcCount != 0 ? (double)simRpcTotal / simRpcCount / 1000 : 0;
+    printf("%-28s %s: %6.1f ms average, %6.1f ms max, %u exchanges, %u errors\n", name, pass ? "PASS" : "FAIL",
+            *pAvgMs, (double)simRpcMax / 1000, simRpcCount, simErrors);
+
+    _Disconnect();
+    return pass;
+}
+
+// runs the stack and the server reads for the given time; returns the bytes read
+static uint32_t _ServerDrain(uint32_t ms)
+{
+    uint8_t buff[1024];
+    uint64_t endTime = simTime + ms * 1000;
+    uint32_t rxLen = 0;
+
+    while(simTime < endTime)
+    {
+        rxLen += TCPIP_TCP_ArrayGet(simServer, buff, sizeof(buff));
+        _TxAcknowledge();
+        _StackStep();
+    }
+    return rxLen;
+}
+
+// data written to a corked socket after a flush stays there until the next flush
+static bool _CorkCheck(void)
+{
+    uint8_t buff[SIM_CORK_FLUSHED_SIZE];
+    uint32_t flushedLen, uncorkedLen;
+    bool pass;
+
+    simErrors = 0;
+    _Connect(false);    // part of the flushed data waits for the window
+
+    memset(buff, 0x5a, sizeof(buff));
+    TCPIP_TCP_OptionsSet(simClient, TCP_OPTION_CORK, (void*)true);
+    TCPIP_TCP_ArrayPut(simClient, buff, SIM_CORK_FLUSHED_SIZE);
+    TCPIP_TCP_Flush(simClient);
+    TCPIP_TCP_ArrayPut(simClient, buff, SIM_CORK_HELD_SIZE);
+    flushedLen = _ServerDrain(200);
+
+    TCPIP_TCP_OptionsSet(simClient, TCP_OPTION_CORK, (void*)false);
+    uncorkedLen = _ServerDrain(200);
+
+    pass = flushedLen == SIM_CORK_FLUSHED_SIZE && uncorkedLen == SIM_CORK_HELD_SIZE && simErrors == 0;
+    printf("%-28s %s: %u bytes flushed, %u after uncork\n", "cork, write after flush", pass ? "PASS" : "FAIL", flushedLen, uncorkedLen);
+
+    _Disconnect();
+    return pass;
+}
+
+static bool _RpcCompare(void)
+{
+    double defAvg, noDelayAvg, quickAvg, corkAvg;
+    bool pass = true;
+
+    printf("RPC: %u byte header, %u byte request, %u byte reply\n", SIM_RPC_HEADER_SIZE, SIM_RPC_REQUEST_SIZE, SIM_RPC_REPLY_SIZE);
+    pass &= _RpcRun("default", SIM_RPC_DEFAULT, &defAvg);
+    pass &= _RpcRun("delayed ACK timeout 0", SIM_RPC_NO_DELAYED_ACK, &noDelayAvg);
+    pass &= _RpcRun("quick ACK", SIM_RPC_QUICK_ACK, &quickAvg);
+    pass &= _RpcRun("cork + flush", SIM_RPC_CORK, &corkAvg);
+
+    // each option must beat the default socket
+    if(noDelayAvg >= defAvg || quickAvg >= defAvg || corkAvg >= defAvg)
+    {
+        printf("no latency gain over the default socket\n");
+        pass = false;
+    }
+
+    return _CorkCheck() && pass;
+}
+
+int main(int argc, char** argv)
+{
+    static const uint32_t lossPpm[] = {0, 10000, 20000, 30000, 50000};
+    TCPIP_STACK_MODULE_CTRL stackCtrl = {.memH = &simHeap, .stackAction = TCPIP_STACK_ACTION_INIT, .pNetIf = &simNetIf};
+    TCPIP_TCP_MODULE_CONFIG tcpConfig = {TCPIP_TCP_MAX_SOCKETS, TCPIP_TCP_SOCKET_DEFAULT_TX_SIZE, TCPIP_TCP_SOCKET_DEFAULT_RX_SIZE};
+    char name[32];
+    uint32_t ix;
+    bool pass = true;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    simNetIf.netIPAddr.v[0] = 10;
+    simNetIf.netIPAddr.v[3] = 1;
+    simNetIf.netMask.Val = 0x00ffffff;
+    simNetIf.Flags.bInterfaceEnabled = 1;
+    if(!TCPIP_TCP_Initialize(&stackCtrl, &tcpConfig))
+    {
+        printf("TCP initialization failed\n");
+        return 1;
+    }
+    simTickTime = simTaskRate * 1000;
+
+    if(argc >= 2 && strcmp(argv[1], "rpc") == 0)
+    {
+        pass = _RpcCompare();
+        TCPIP_TCP_Deinitialize(&stackCtrl);
+        printf("%s\n", pass ? "ALL PASS" : "FAILED");
+        return pass ? 0 : 1;
+    }
+
+    printf("link %u kbit/s, RTT %u ms, SACK %s, TX/RX buffer %u/%u\n", SIM_LINK_RATE / 1000, 2 * SIM_LINK_DELAY / 1000,
+            TCPIP_TCP_SACK_SUPPORT ? "on" : "off", SIM_CLIENT_TX_SIZE, TCPIP_TCP_SOCKET_DEFAULT_RX_SIZE);
+    for(ix = 0; ix < sizeof(lossPpm) / sizeof(*lossPpm); ix++)
+    {
+        snprintf(name, sizeof(name), "loss %u%%", lossPpm[ix] / 10000);
+        pass &= _RunAveraged(name, lossPpm[ix], true);
+    }
+
+    // "loss" runs the sweep only
+    if((argc < 2) || (strcmp(argv[1], "loss") != 0))
+    {
+        pass &= _RunAveraged("autotune off, loss 0%", 0, false);
+        pass &= _RunAveraged("autotune on, loss 0%", 0, true);
+        pass &= _RunAveraged("autotune off, loss 1%", 10000, false);
+        pass &= _RunAveraged("autotune on, loss 1%", 10000, true);
+#if (TCPIP_TCP_SACK_SUPPORT != 0)
+        pass &= _BurstCompare();
+#endif  // (TCPIP_TCP_SACK_SUPPORT != 0)
+    }
+
+    TCPIP_TCP_Deinitialize(&stackCtrl);
+
+    printf("%s\n", pass ? "ALL PASS" : "FAILED");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,450 @@
+/*******************************************************************************
+  UDP demultiplexing host test
+
+  Summary:
+    Port hash checks and datagram demultiplexing cost of
+    library/tcpip/src/udp.c.
+
+  Description:
+    udp.c and oahash.c are compiled unchanged. Datagrams are passed to the
+    UDP task as the stack manager would, already through IPv4.
+    Checked:
+    - a port displaced in the hash by a colliding port is found again
+      after the colliding port is unbound, and binding it once more
+      does not create a second hash entry: bind A, bind B (colliding),
+      unbind A, bind B again. The datagram to B goes to the lowest
+      socket index bound to B.
+    - a datagram to an unbound port is dropped and the sockets still get
+      their own datagrams.
+    Measured, versus the number of bound sockets:
+    - the time to demultiplex a datagram to a bound port (the datagram is
+      queued, then discarded by the socket user),
+    - the time to drop a datagram to an unbound port.
+
+    Build and run: make -C firmware/test/host udp
+    udp-base runs the benchmark against udp.c of an older revision, for
+    comparison: make -C firmware/test/host udp-base BASE=<rev>
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define TCPIP_THIS_MODULE_ID    TCPIP_MODULE_UDP
+
+#include "tcpip/src/tcpip_private.h"
+#include "tcpip/src/udp_private.h"
+#undef vsnprintf
+
+#define DEMUX_SOCKETS           32          // sockets the module is initialized with
+#define DEMUX_ITERATIONS        200000
+#define DEMUX_BASE_PORT         1024
+#define DEMUX_PORT_STRIDE       7
+#define DEMUX_UNBOUND_PORT      9
+#define DEMUX_PAYLOAD           32
+
+// a received datagram, as IPv4 passes it to UDP
+typedef struct
+{
+    TCPIP_MAC_PACKET        pkt;
+    TCPIP_MAC_DATA_SEGMENT  seg;
+    uint32_t                data[(sizeof(IPV4_HEADER) + sizeof(UDP_HEADER) + DEMUX_PAYLOAD + 3) / 4];
+}DEMUX_RX_PACKET;
+
+static TCPIP_NET_IF     demuxNetIf;
+static TCPIP_MODULE_SIGNAL demuxSignals;
+static TCPIP_MAC_PACKET* demuxRxPkt;
+static DEMUX_RX_PACKET  demuxRx;
+static uint32_t         demuxAckRes[TCPIP_MAC_PKT_ACK_LINK_DOWN + 1 - TCPIP_MAC_PKT_ACK_IP_REJECT_ERR];
+static uint32_t         demuxErrors;
+
+// system services
+uint32_t SYS_TMR_TickCountGet(void)
+{
+    return 0;
+}
+
+uint32_t SYS_TMR_TickCounterFrequencyGet(void)
+{
+    return 1000;
+}
+
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void)
+{
+    return SYS_ERROR_ERROR;
+}
+
+SYS_MODULE_INDEX SYS_DEBUG_ConsoleInstanceGet(void)
+{
+    return SYS_CONSOLE_INDEX_0;
+}
+
+void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    demuxErrors++;
+}
+
+int _HostVsnprintf(char* buff, size_t size, const char* fmt, va_list args)
+{
+    return vsnprintf(buff, size, fmt, args);
+}
+
+// heap
+static void* _HeapMalloc(TCPIP_STACK_HEAP_HANDLE heapH, size_t nBytes)
+{
+    return malloc(nBytes);
+}
+
+static void* _HeapCalloc(TCPIP_STACK_HEAP_HANDLE heapH, size_t nElems, size_t elemSize)
+{
+    return calloc(nElems, elemSize);
+}
+
+static size_t _HeapFree(TCPIP_STACK_HEAP_HANDLE heapH, const void* pBuff)
+{
+    free((void*)pBuff);
+    return 0;
+}
+
+static const TCPIP_HEAP_OBJECT demuxHeap =
+{
+    .TCPIP_HEAP_Malloc = _HeapMalloc,
+    .TCPIP_HEAP_Calloc = _HeapCalloc,
+    .TCPIP_HEAP_Free = _HeapFree,
+};
+
+// stack manager
+static tcpipModuleSignalHandler demuxHandler;
+
+tcpipSignalHandle _TCPIPStackSignalHandlerRegister(TCPIP_STACK_MODULE modId, tcpipModuleSignalHandler signalHandler, int16_t asyncTmoMs)
+{
+    demuxHandler = signalHandler;
+    return &demuxHandler;
+}
+
+void _TCPIPStackSignalHandlerDeregister(tcpipSignalHandle handle)
+{
+    demuxHandler = 0;
+}
+
+TCPIP_MODULE_SIGNAL _TCPIPStackModuleSignalGet(TCPIP_STACK_MODULE modId, TCPIP_MODULE_SIGNAL clrMask)
+{
+    TCPIP_MODULE_SIGNAL sigs = demuxSignals;
+
+    demuxSignals &= ~clrMask;
+    return sigs;
+}
+
+TCPIP_MAC_PACKET* _TCPIPStackModuleRxExtract(TCPIP_STACK_MODULE modId)
+{
+    TCPIP_MAC_PACKET* pPkt = demuxRxPkt;
+
+    demuxRxPkt = 0;
+    return pPkt;
+}
+
+TCPIP_NET_HANDLE TCPIP_STACK_NetDefaultGet(void)
+{
+    return &demuxNetIf;
+}
+
+int TCPIP_STACK_NetIxGet(TCPIP_NET_IF* pNetIf)
+{
+    return 0;
+}
+
+TCPIP_NET_IF* TCPIP_STACK_IPAddToNet(IPV4_ADDR* pIpAddress, bool useDefault)
+{
+    return &demuxNetIf;
+}
+
+bool TCPIP_STACK_IsBcastAddress(TCPIP_NET_IF* pNetIf, const IPV4_ADDR* pIpAddress)
+{
+    return pIpAddress->Val == 0xffffffff;
+}
+
+uint32_t TCPIP_STACK_NetAddressBcast(TCPIP_NET_HANDLE netH)
+{
+    return 0xffffffff;
+}
+
+void _TCPIPStackInsertRxPacket(TCPIP_NET_IF* pNetIf, TCPIP_MAC_PACKET* pRxPkt, bool signal)
+{
+}
+
+// IPv4; nothing is transmitted here
+TCPIP_NET_HANDLE TCPIP_IPV4_SelectSourceInterface(TCPIP_NET_HANDLE netH, const IPV4_ADDR* pDestAddress, IPV4_ADDR* pSrcAddress, bool srcSet)
+{
+    return 0;
+}
+
+void TCPIP_IPV4_PacketFormatTx(IPV4_PACKET* pPkt, uint8_t protocol, uint16_t ipLoadLen, TCPIP_IPV4_PACKET_PARAMS* pParams)
+{
+}
+
+bool TCPIP_IPV4_PacketTransmit(IPV4_PACKET* pPkt)
+{
+    return false;
+}
+
+// packets
+void _TCPIP_PKT_PacketAcknowledge(TCPIP_MAC_PACKET* pPkt, TCPIP_MAC_PKT_ACK_RES ackRes, TCPIP_STACK_MODULE moduleId)
+{
+    if(ackRes != TCPIP_MAC_PKT_ACK_NONE)
+    {
+        pPkt->ackRes = ackRes;
+    }
+
+    if((*pPkt->ackFunc)(pPkt, pPkt->ackParam))
+    {
+        pPkt->pktFlags &= ~TCPIP_MAC_PKT_FLAG_QUEUED;
+    }
+}
+
+void _TCPIP_PKT_PacketFree(TCPIP_MAC_PACKET* pPkt)
+{
+    free(pPkt);
+}
+
+TCPIP_MAC_PACKET* _TCPIP_PKT_SocketAlloc(uint16_t pktLen, uint16_t tHdrLen, uint16_t payloadLen, TCPIP_MAC_PACKET_FLAGS flags)
+{
+    return 0;
+}
+
+// the datagrams are single segment
+TCPIP_MAC_DATA_SEGMENT* TCPIP_PKT_DataSegmentGet(TCPIP_MAC_PACKET* pPkt, const uint8_t* dataAddress, bool srchTransport)
+{
+    return pPkt->pDSeg;
+}
+
+static bool _RxPacketAck(TCPIP_MAC_PACKET* pPkt, const void* param)
+{
+    int ackIx = (int)pPkt->ackRes - TCPIP_MAC_PKT_ACK_IP_REJECT_ERR;
+
+    if(0 <= ackIx && ackIx < sizeof(demuxAckRes) / sizeof(*demuxAckRes))
+    {
+        demuxAckRes[ackIx]++;
+    }
+    return false;
+}
+
+static uint32_t _AckCount(TCPIP_MAC_PKT_ACK_RES ackRes)
+{
+    return demuxAckRes[(int)ackRes - TCPIP_MAC_PKT_ACK_IP_REJECT_ERR];
+}
+
+// passes a datagram to destPort to the UDP task
+static void _Deliver(UDP_PORT destPort)
+{
+    IPV4_HEADER* pIpHdr = (IPV4_HEADER*)demuxRx.data;
+    UDP_HEADER* pUdpHdr = (UDP_HEADER*)(pIpHdr + 1);
+    uint16_t udpLen = sizeof(UDP_HEADER) + DEMUX_PAYLOAD;
+
+    memset(pIpHdr, 0, sizeof(*pIpHdr));
+    pIpHdr->Version = 4;
+    pIpHdr->IHL = sizeof(*pIpHdr) >> 2;
+    pIpHdr->TotalLength = TCPIP_Helper_htons(sizeof(*pIpHdr) + udpLen);
+    pIpHdr->Protocol = IP_PROT_UDP;
+    pIpHdr->SourceAddress.Val = 0x0201a8c0;     // 192.168.1.2
+    pIpHdr->DestAddress.Val = demuxNetIf.netIPAddr.Val;
+    pUdpHdr->SourcePort = TCPIP_Helper_htons(40000);
+    pUdpHdr->DestinationPort = TCPIP_Helper_htons(destPort);
+    pUdpHdr->Length = TCPIP_Helper_htons(udpLen);
+    pUdpHdr->Checksum = 0;
+
+    demuxRx.seg.segBuffer = demuxRx.seg.segLoad = (uint8_t*)demuxRx.data;
+    demuxRx.seg.segSize = demuxRx.seg.segAllocSize = sizeof(demuxRx.data);
+    demuxRx.seg.segLen = udpLen;
+    demuxRx.pkt.pDSeg = &demuxRx.seg;
+    demuxRx.pkt.pMacLayer = demuxRx.pkt.pNetLayer = (uint8_t*)pIpHdr;
+    demuxRx.pkt.pTransportLayer = (uint8_t*)pUdpHdr;
+    demuxRx.pkt.totTransportLen = udpLen;
+    demuxRx.pkt.pktFlags = TCPIP_MAC_PKT_FLAG_IPV4;
+    demuxRx.pkt.pktIf = &demuxNetIf;
+    demuxRx.pkt.ackFunc = _RxPacketAck;
+    demuxRx.pkt.ackRes = TCPIP_MAC_PKT_ACK_NONE;
+    demuxRx.pkt.next = 0;
+
+    demuxRxPkt = &demuxRx.pkt;
+    demuxSignals |= TCPIP_MODULE_SIGNAL_RX_PENDING;
+    (*demuxHandler)();
+}
+
+// the socket that got the last datagram, if any
+static UDP_SOCKET _Receiver(const UDP_SOCKET* pSkts, int nSkts)
+{
+    int ix;
+
+    for(ix = 0; ix < nSkts; ix++)
+    {
+        if(TCPIP_UDP_GetIsReady(pSkts[ix]) != 0)
+        {
+            TCPIP_UDP_Discard(pSkts[ix]);
+            return pSkts[ix];
+        }
+    }
+    return INVALID_UDP_SOCKET;
+}
+
+static void _Check(bool cond, const char* what)
+{
+    if(!cond)
+    {
+        printf("FAIL: %s\n", what);
+        demuxErrors++;
+    }
+}
+
+// bind A, bind B colliding with A, unbind A, bind B again
+static void _CollisionTest(void)
+{
+    UDP_PORT portA = DEMUX_BASE_PORT;
+    UDP_PORT portB = portA + UDP_PORT_HASH_ENTRIES(DEMUX_SOCKETS);  // same bucket as A
+    UDP_PORT portC = portA + 5;                                     // clear of A and B
+    UDP_SOCKET sktA, sktB, sktC, sktB2;
+    UDP_SOCKET skts[4];
+
+    sktA = TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE_IPV4, portA, 0);
+    sktB = TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE_IPV4, portB, 0);
+    TCPIP_UDP_Close(sktA);
+    // take the freed socket slot so that the new B socket has the higher index
+    sktC = TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE_IPV4, portC, 0);
+    sktB2 = TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE_IPV4, portB, 0);
+    _Check(sktB != INVALID_UDP_SOCKET && sktC != INVALID_UDP_SOCKET && sktB2 != INVALID_UDP_SOCKET, "open");
+    _Check(sktB < sktB2, "socket order");
+
+    skts[0] = sktB;
+    skts[1] = sktC;
+    skts[2] = sktB2;
+
+    _Deliver(portB);
+    _Check(_Receiver(skts, 3) == sktB, "B datagram to the lowest B socket");
+    _Deliver(portC);
+    _Check(_Receiver(skts, 3) == sktC, "C datagram");
+    _Deliver(portA);
+    _Check(_Receiver(skts, 3) == INVALID_UDP_SOCKET && _AckCount(TCPIP_MAC_PKT_ACK_PROTO_DEST_ERR) == 1, "A datagram dropped");
+
+    TCPIP_UDP_Close(sktB);
+    _Deliver(portB);
+    _Check(_Receiver(skts + 1, 2) == sktB2, "B datagram to the remaining B socket");
+
+    TCPIP_UDP_Close(sktB2);
+    _Deliver(portB);
+    _Check(_Receiver(skts + 1, 1) == INVALID_UDP_SOCKET && _AckCount(TCPIP_MAC_PKT_ACK_PROTO_DEST_ERR) == 2, "B datagram dropped");
+
+    // A again, where B used to be found
+    sktA = TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE_IPV4, portA, 0);
+    skts[0] = sktA;
+    _Deliver(portA);
+    _Check(_Receiver(skts, 2) == sktA, "A datagram after rebind");
+
+    TCPIP_UDP_Close(sktA);
+    TCPIP_UDP_Close(sktC);
+
+    printf("port hash collision: %s\n", demuxErrors == 0 ? "ok" : "FAILED");
+}
+
+static double _Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void _DemuxBench(void)
+{
+    static const int nBound[] = {1, 2, 4, 8, 16, 32};
+    UDP_SOCKET skts[DEMUX_SOCKETS];
+    UDP_PORT hitPort;
+    int nOpen, benchIx, iter;
+    double start, hitNs, missNs;
+    uint32_t dropped;
+
+    printf("\nsockets  hit ns/datagram  miss ns/datagram\n");
+    nOpen = 0;
+    for(benchIx = 0; benchIx < sizeof(nBound) / sizeof(*nBound); benchIx++)
+    {
+        for(; nOpen < nBound[benchIx]; nOpen++)
+        {
+            skts[nOpen] = TCPIP_UDP_ServerOpen(IP_ADDRESS_TYPE_IPV4, DEMUX_BASE_PORT + nOpen * DEMUX_PORT_STRIDE, 0);
+            _Check(skts[nOpen] != INVALID_UDP_SOCKET, "bench open");
+        }
+
+        // the last socket opened: the one the old array scan reaches last
+        hitPort = DEMUX_BASE_PORT + (nOpen - 1) * DEMUX_PORT_STRIDE;
+        start = _Now();
+        for(iter = 0; iter < DEMUX_ITERATIONS; iter++)
+        {
+            _Deliver(hitPort);
+            if(TCPIP_UDP_GetIsReady(skts[nOpen - 1]) == 0)
+            {
+                demuxErrors++;
+            }
+            TCPIP_UDP_Discard(skts[nOpen - 1]);
+        }
+        hitNs = (_Now() - start) / DEMUX_ITERATIONS;
+
+        dropped = _AckCount(TCPIP_MAC_PKT_ACK_PROTO_DEST_ERR);
+        start = _Now();
+        for(iter = 0; iter < DEMUX_ITERATIONS; iter++)
+        {
+            _Deliver(DEMUX_UNBOUND_PORT);
+        }
+        missNs = (_Now() - start) / DEMUX_ITERATIONS;
+        _Check(_AckCount(TCPIP_MAC_PKT_ACK_PROTO_DEST_ERR) - dropped == DEMUX_ITERATIONS, "bench miss dropped");
+
+        printf("%7d  %15.1f  %16.1f\n", nOpen, hitNs, missNs);
+    }
+
+    while(nOpen)
+    {
+        TCPIP_UDP_Close(skts[--nOpen]);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    TCPIP_STACK_MODULE_CTRL stackCtrl;
+    TCPIP_UDP_MODULE_CONFIG udpConfig;
+
+    demuxNetIf.netIPAddr.Val = 0x0101a8c0;      // 192.168.1.1
+    demuxNetIf.netMask.Val = 0x00ffffff;
+    demuxNetIf.Flags.bInterfaceEnabled = 1;
+
+    memset(&stackCtrl, 0, sizeof(stackCtrl));
+    stackCtrl.memH = (TCPIP_STACK_HEAP_HANDLE)&demuxHeap;
+    stackCtrl.stackAction = TCPIP_STACK_ACTION_INIT;
+    memset(&udpConfig, 0, sizeof(udpConfig));
+    udpConfig.nSockets = DEMUX_SOCKETS;
+    udpConfig.sktTxBuffSize = 512;
+
+    if(!TCPIP_UDP_Initialize(&stackCtrl, &udpConfig))
+    {
+        printf("FAIL: UDP initialization\n");
+        return 1;
+    }
+
+    if(argc < 2 || strcmp(argv[1], "bench") != 0)
+    {
+        _CollisionTest();
+    }
+    _DemuxBench();
+
+    TCPIP_UDP_Deinitialize(&stackCtrl);
+
+    if(demuxErrors != 0)
+    {
+        printf("FAILED: %u errors\n", demuxErrors);
+        return 1;
+    }
+    return 0;
+}